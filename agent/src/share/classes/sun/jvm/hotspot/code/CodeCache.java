@@ -32,12 +32,12 @@ import sun.jvm.hotspot.types.*;
 import sun.jvm.hotspot.utilities.*;
 
 public class CodeCache {
-  private static AddressField       heapField;
+  private static GrowableArray<CodeHeap> heapArray;
+  private static AddressField       lowBoundField;
+  private static AddressField       highBoundField;
   private static AddressField       scavengeRootNMethodsField;
   private static VirtualConstructor virtualConstructor;
 
-  private CodeHeap heap;
-
   static {
     VM.registerVMInitializedObserver(new Observer() {
         public void update(Observable o, Object data) {
@@ -49,7 +49,12 @@ public class CodeCache {
   private static synchronized void initialize(TypeDataBase db) {
     Type type = db.lookupType("CodeCache");
 
-    heapField = type.getAddressField("_heap");
+    // Get array of CodeHeaps
+    AddressField heapsField = type.getAddressField("_heaps");
+    heapArray = GrowableArray.create(heapsField.getValue(), new StaticBaseConstructor<CodeHeap>(CodeHeap.class));
+
+    lowBoundField = type.getAddressField("_low_bound");
+    highBoundField = type.getAddressField("_high_bound");
     scavengeRootNMethodsField = type.getAddressField("_scavenge_root_nmethods");
 
     virtualConstructor = new VirtualConstructor(db);
@@ -67,16 +72,12 @@ public class CodeCache {
     }
   }
 
-  public CodeCache() {
-    heap = (CodeHeap) VMObjectFactory.newObject(CodeHeap.class, heapField.getValue());
-  }
-
   public NMethod scavengeRootMethods() {
     return (NMethod) VMObjectFactory.newObject(NMethod.class, scavengeRootNMethodsField.getValue());
   }
 
   public boolean contains(Address p) {
-    return getHeap().contains(p);
+    return getHeapForAddress(p) != null;
   }
 
   /** When VM.getVM().isDebugging() returns true, this behaves like
@@ -97,14 +98,18 @@ public class CodeCache {
 
   public CodeBlob findBlobUnsafe(Address start) {
     CodeBlob result = null;
+    CodeHeap containing_heap = getHeapForAddress(start);
+    if (containing_heap == null) {
+      return null;
+    }
 
     try {
-      result = (CodeBlob) virtualConstructor.instantiateWrapperFor(getHeap().findStart(start));
+      result = (CodeBlob) virtualConstructor.instantiateWrapperFor(containing_heap.findStart(start));
     }
     catch (WrongTypeException wte) {
       Address cbAddr = null;
       try {
-        cbAddr = getHeap().findStart(start);
+        cbAddr = containing_heap.findStart(start);
       }
       catch (Exception findEx) {
         findEx.printStackTrace();
@@ -167,11 +172,41 @@ public class CodeCache {
   }
 
   public void iterate(CodeCacheVisitor visitor) {
-    CodeHeap heap = getHeap();
+    visitor.prologue(lowBound(), highBound());
+    for (int i = 0; i < heapArray.length(); ++i) {
+      iterateHeap(heapArray.at(i), visitor);
+    }
+    visitor.epilogue();
+  }
+
+  //--------------------------------------------------------------------------------
+  // Internals only below this point
+  //
+
+  private Address lowBound() {
+    return lowBoundField.getValue();
+  }
+
+  private Address highBound() {
+    return highBoundField.getValue();
+  }
+
+  private CodeHeap getHeapForAddress(Address addr) {
+    if (addr == null) {
+      return null;
+    }
+    for (int i = 0; i < heapArray.length(); ++i) {
+      if (heapArray.at(i).contains(addr)) {
+        return heapArray.at(i);
+      }
+    }
+    return null;
+  }
+
+  private void iterateHeap(CodeHeap heap, CodeCacheVisitor visitor) {
     Address ptr = heap.begin();
     Address end = heap.end();
 
-    visitor.prologue(ptr, end);
     CodeBlob lastBlob = null;
     while (ptr != null && ptr.lessThan(end)) {
       try {
@@ -193,14 +228,5 @@ public class CodeCache {
       }
       ptr = next;
     }
-    visitor.epilogue();
-  }
-
-  //--------------------------------------------------------------------------------
-  // Internals only below this point
-  //
-
-  private CodeHeap getHeap() {
-    return heap;
   }
 }
@@ -73,6 +73,8 @@ define_pd_global(bool, RewriteFrequentPairs, true);
 
 define_pd_global(bool, UseMembar,            false);
 
+define_pd_global(bool, ThreadLocalHandshakes, false);
+
 define_pd_global(bool, PreserveFramePointer, false);
 
 // GC Ergo Flags
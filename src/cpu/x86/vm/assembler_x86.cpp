@@ -276,7 +276,8 @@ void Assembler::emit_arith(int op1, int op2, Register dst, Register src) {
 void Assembler::emit_operand(Register reg, Register base, Register index,
                              Address::ScaleFactor scale, int disp,
                              RelocationHolder const& rspec,
-                             int rip_relative_correction) {
+                             int rip_relative_correction,
+                             int disp8_scale) {
   relocInfo::relocType rtype = (relocInfo::relocType) rspec.type();
 
   // Encode the registers as needed in the fields they are used in
@@ -285,6 +286,10 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
   int indexenc = index->is_valid() ? encode(index) << 3 : 0;
   int baseenc = base->is_valid() ? encode(base) : 0;
 
+  // EVEX encoded instructions scale an 8-bit displacement by disp8_scale.
+  bool disp_is8bit = (disp % disp8_scale == 0) && is8bit(disp / disp8_scale);
+  int disp8 = disp / disp8_scale;
+
   if (base->is_valid()) {
     if (index->is_valid()) {
       assert(scale != Address::no_scale, "inconsistent address");
@@ -296,13 +301,13 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
         assert(index != rsp, "illegal addressing mode");
         emit_int8(0x04 | regenc);
         emit_int8(scale << 6 | indexenc | baseenc);
-      } else if (is8bit(disp) && rtype == relocInfo::none) {
+      } else if (disp_is8bit && rtype == relocInfo::none) {
         // [base + index*scale + imm8]
         // [01 reg 100][ss index base] imm8
         assert(index != rsp, "illegal addressing mode");
         emit_int8(0x44 | regenc);
         emit_int8(scale << 6 | indexenc | baseenc);
-        emit_int8(disp & 0xFF);
+        emit_int8(disp8 & 0xFF);
       } else {
         // [base + index*scale + disp32]
         // [10 reg 100][ss index base] disp32
@@ -318,12 +323,12 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
         // [00 reg 100][00 100 100]
         emit_int8(0x04 | regenc);
         emit_int8(0x24);
-      } else if (is8bit(disp) && rtype == relocInfo::none) {
+      } else if (disp_is8bit && rtype == relocInfo::none) {
         // [rsp + imm8]
         // [01 reg 100][00 100 100] disp8
         emit_int8(0x44 | regenc);
         emit_int8(0x24);
-        emit_int8(disp & 0xFF);
+        emit_int8(disp8 & 0xFF);
       } else {
         // [rsp + imm32]
         // [10 reg 100][00 100 100] disp32
@@ -339,11 +344,11 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
         // [base]
         // [00 reg base]
         emit_int8(0x00 | regenc | baseenc);
-      } else if (is8bit(disp) && rtype == relocInfo::none) {
+      } else if (disp_is8bit && rtype == relocInfo::none) {
         // [base + disp8]
         // [01 reg base] disp8
         emit_int8(0x40 | regenc | baseenc);
-        emit_int8(disp & 0xFF);
+        emit_int8(disp8 & 0xFF);
       } else {
         // [base + disp32]
         // [10 reg base] disp32
@@ -860,6 +865,13 @@ void Assembler::emit_operand(XMMRegister reg, Address adr) {
                adr._rspec);
 }
 
+void Assembler::emit_evex_operand(XMMRegister reg, Address adr, int disp8_scale) {
+  // locate_operand() does not decode EVEX prefixes
+  assert(adr._rspec.type() == relocInfo::none, "no relocation for EVEX operands");
+  emit_operand(as_Register(reg->encoding() & 7), adr._base, adr._index, adr._scale, adr._disp,
+               adr._rspec, 0, disp8_scale);
+}
+
 // MMX operations
 void Assembler::emit_operand(MMXRegister reg, Address adr) {
   assert(!adr.base_needs_rex() && !adr.index_needs_rex(), "no extended registers");
@@ -2418,6 +2430,14 @@ void Assembler::pmovzxbw(XMMRegister dst, XMMRegister src) {
   emit_int8((unsigned char)(0xC0 | encode));
 }
 
+void Assembler::vpmovzxwd(XMMRegister dst, Address src, bool vector256) {
+  assert(VM_Version::supports_avx() && !vector256 || VM_Version::supports_avx2(), "256 bit integer vectors requires AVX2");
+  InstructionMark im(this);
+  vex_prefix(src, 0, dst->encoding(), VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector256);
+  emit_int8(0x33);
+  emit_operand(dst, src);
+}
+
 // generic
 void Assembler::pop(Register dst) {
   int encode = prefix_and_encode(dst->encoding());
@@ -3809,6 +3829,16 @@ void Assembler::vinsertf128h(XMMRegister dst, Address src) {
   emit_int8(0x01);
 }
 
+void Assembler::vextractf128h(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_avx(), "");
+  bool vector256 = true;
+  int encode = vex_prefix_and_encode(src, xnoreg, dst, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x19);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // 0x01 - extract from upper 128 bits
+  emit_int8(0x01);
+}
+
 void Assembler::vextractf128h(Address dst, XMMRegister src) {
   assert(VM_Version::supports_avx(), "");
   InstructionMark im(this);
@@ -3847,6 +3877,16 @@ void Assembler::vinserti128h(XMMRegister dst, Address src) {
   emit_int8(0x01);
 }
 
+void Assembler::vextracti128h(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_avx2(), "");
+  bool vector256 = true;
+  int encode = vex_prefix_and_encode(src, xnoreg, dst, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x39);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // 0x01 - extract from upper 128 bits
+  emit_int8(0x01);
+}
+
 void Assembler::vextracti128h(Address dst, XMMRegister src) {
   assert(VM_Version::supports_avx2(), "");
   InstructionMark im(this);
@@ -3894,6 +3934,238 @@ void Assembler::vzeroupper() {
   emit_int8(0x77);
 }
 
+// AVX-512 instructions
+
+// Full vector memory operands scale the 8-bit displacement by the vector size
+static int evex_vector_size(int vector_len) {
+  return 16 << vector_len;
+}
+
+void Assembler::evmovdqul(XMMRegister dst, XMMRegister src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  emit_evex_arith(0x6F, dst, xnoreg, src, VEX_SIMD_F3, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evmovdqul(XMMRegister dst, Address src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  InstructionMark im(this);
+  evex_prefix(src, 0, dst->encoding(), VEX_SIMD_F3, VEX_OPCODE_0F, false, vector_len);
+  emit_int8(0x6F);
+  emit_evex_operand(dst, src, evex_vector_size(vector_len));
+}
+
+void Assembler::evmovdqul(Address dst, XMMRegister src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  InstructionMark im(this);
+  evex_prefix(dst, 0, src->encoding(), VEX_SIMD_F3, VEX_OPCODE_0F, false, vector_len);
+  emit_int8(0x7F);
+  emit_evex_operand(src, dst, evex_vector_size(vector_len));
+}
+
+void Assembler::evpmovzxwd(XMMRegister dst, Address src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  InstructionMark im(this);
+  evex_prefix(src, 0, dst->encoding(), VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector_len);
+  emit_int8(0x33);
+  // The source is half as wide as the destination
+  emit_evex_operand(dst, src, evex_vector_size(vector_len) / 2);
+}
+
+void Assembler::evpbroadcastd(XMMRegister dst, XMMRegister src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  emit_evex_arith(0x58, dst, xnoreg, src, VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector_len);
+}
+
+void Assembler::evpbroadcastq(XMMRegister dst, XMMRegister src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  emit_evex_arith(0x59, dst, xnoreg, src, VEX_SIMD_66, VEX_OPCODE_0F_38, true, vector_len);
+}
+
+void Assembler::evpbroadcastd(XMMRegister dst, Register src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  int encode = evex_prefix_and_encode(dst->encoding(), 0, src->encoding(),
+                                      VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector_len);
+  emit_int8(0x7C);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
+void Assembler::evpbroadcastq(XMMRegister dst, Register src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  NOT_LP64(ShouldNotReachHere());
+  int encode = evex_prefix_and_encode(dst->encoding(), 0, src->encoding(),
+                                      VEX_SIMD_66, VEX_OPCODE_0F_38, true, vector_len);
+  emit_int8(0x7C);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
+void Assembler::evbroadcastss(XMMRegister dst, XMMRegister src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  emit_evex_arith(0x18, dst, xnoreg, src, VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector_len);
+}
+
+void Assembler::evbroadcastsd(XMMRegister dst, XMMRegister src, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  assert(vector_len != AVX_128bit, "no 128bit form");
+  emit_evex_arith(0x19, dst, xnoreg, src, VEX_SIMD_66, VEX_OPCODE_0F_38, true, vector_len);
+}
+
+void Assembler::evpaddd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0xFE, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evpaddq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0xD4, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evpsubd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0xFA, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evpsubq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0xFB, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evpmulld(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0x40, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector_len);
+}
+
+void Assembler::evpmullq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  assert(VM_Version::supports_avx512dq(), "requires AVX512DQ");
+  emit_evex_arith(0x40, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F_38, true, vector_len);
+}
+
+void Assembler::evaddps(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0x58, dst, nds, src, VEX_SIMD_NONE, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evaddpd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0x58, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evsubps(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0x5C, dst, nds, src, VEX_SIMD_NONE, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evsubpd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0x5C, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evmulps(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0x59, dst, nds, src, VEX_SIMD_NONE, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evmulpd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0x59, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evdivps(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0x5E, dst, nds, src, VEX_SIMD_NONE, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evdivpd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0x5E, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evpandq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0xDB, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evporq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0xEB, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evpxorq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len) {
+  emit_evex_arith(0xEF, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+// Shifts with an immediate count encode the operation in ModRM.reg
+// and the destination in vvvv: XMM6 is for /6, XMM2 for /2 and XMM4 for /4.
+void Assembler::evpslld(XMMRegister dst, XMMRegister src, int shift, int vector_len) {
+  emit_evex_arith(0x72, xmm6, dst, src, VEX_SIMD_66, VEX_OPCODE_0F, false, vector_len);
+  emit_int8(shift & 0xFF);
+}
+
+void Assembler::evpsllq(XMMRegister dst, XMMRegister src, int shift, int vector_len) {
+  emit_evex_arith(0x73, xmm6, dst, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+  emit_int8(shift & 0xFF);
+}
+
+void Assembler::evpsrld(XMMRegister dst, XMMRegister src, int shift, int vector_len) {
+  emit_evex_arith(0x72, xmm2, dst, src, VEX_SIMD_66, VEX_OPCODE_0F, false, vector_len);
+  emit_int8(shift & 0xFF);
+}
+
+void Assembler::evpsrlq(XMMRegister dst, XMMRegister src, int shift, int vector_len) {
+  emit_evex_arith(0x73, xmm2, dst, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+  emit_int8(shift & 0xFF);
+}
+
+void Assembler::evpsrad(XMMRegister dst, XMMRegister src, int shift, int vector_len) {
+  emit_evex_arith(0x72, xmm4, dst, src, VEX_SIMD_66, VEX_OPCODE_0F, false, vector_len);
+  emit_int8(shift & 0xFF);
+}
+
+void Assembler::evpsraq(XMMRegister dst, XMMRegister src, int shift, int vector_len) {
+  emit_evex_arith(0x72, xmm4, dst, src, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+  emit_int8(shift & 0xFF);
+}
+
+void Assembler::evpslld(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len) {
+  emit_evex_arith(0xF2, dst, src, shift, VEX_SIMD_66, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evpsllq(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len) {
+  emit_evex_arith(0xF3, dst, src, shift, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evpsrld(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len) {
+  emit_evex_arith(0xD2, dst, src, shift, VEX_SIMD_66, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evpsrlq(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len) {
+  emit_evex_arith(0xD3, dst, src, shift, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::evpsrad(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len) {
+  emit_evex_arith(0xE2, dst, src, shift, VEX_SIMD_66, VEX_OPCODE_0F, false, vector_len);
+}
+
+void Assembler::evpsraq(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len) {
+  emit_evex_arith(0xE2, dst, src, shift, VEX_SIMD_66, VEX_OPCODE_0F, true, vector_len);
+}
+
+void Assembler::vinserti64x4(XMMRegister dst, XMMRegister nds, XMMRegister src, int imm8) {
+  assert(imm8 == 0 || imm8 == 1, "either the low or the high half");
+  emit_evex_arith(0x3A, dst, nds, src, VEX_SIMD_66, VEX_OPCODE_0F_3A, true, AVX_512bit);
+  emit_int8(imm8);
+}
+
+void Assembler::vinserti64x4(XMMRegister dst, Address src, int imm8) {
+  assert(imm8 == 0 || imm8 == 1, "either the low or the high half");
+  InstructionMark im(this);
+  int dst_enc = dst->encoding();
+  evex_prefix(src, dst_enc, dst_enc, VEX_SIMD_66, VEX_OPCODE_0F_3A, true, AVX_512bit);
+  emit_int8(0x3A);
+  emit_evex_operand(dst, src, 32);
+  emit_int8(imm8);
+}
+
+void Assembler::vextracti64x4(XMMRegister dst, XMMRegister src, int imm8) {
+  assert(imm8 == 0 || imm8 == 1, "either the low or the high half");
+  // swap src<->dst for encoding
+  emit_evex_arith(0x3B, src, xnoreg, dst, VEX_SIMD_66, VEX_OPCODE_0F_3A, true, AVX_512bit);
+  emit_int8(imm8);
+}
+
+void Assembler::vextracti64x4(Address dst, XMMRegister src, int imm8) {
+  assert(imm8 == 0 || imm8 == 1, "either the low or the high half");
+  InstructionMark im(this);
+  evex_prefix(dst, 0, src->encoding(), VEX_SIMD_66, VEX_OPCODE_0F_3A, true, AVX_512bit);
+  emit_int8(0x3B);
+  emit_evex_operand(src, dst, 32);
+  emit_int8(imm8);
+}
+
 
 #ifndef _LP64
 // 32bit only pieces of the assembler
@@ -4439,6 +4711,7 @@ void Assembler::vex_prefix(Address adr, int nds_enc, int xreg_enc, VexSimdPrefix
 }
 
 int Assembler::vex_prefix_and_encode(int dst_enc, int nds_enc, int src_enc, VexSimdPrefix pre, VexOpcode opc, bool vex_w, bool vector256) {
+  assert(dst_enc < 16 && nds_enc < 16 && src_enc < 16, "xmm16-31 need an EVEX prefix");
   bool vex_r = (dst_enc >= 8);
   bool vex_b = (src_enc >= 8);
   bool vex_x = false;
@@ -4447,6 +4720,47 @@ int Assembler::vex_prefix_and_encode(int dst_enc, int nds_enc, int src_enc, VexS
 }
 
 
+// The 4 bytes EVEX prefix: 0x62, P0 = [R X B R' 0 0 m m], P1 = [W v v v v 1 p p],
+// P2 = [z L' L b V' a a a]. R, X, B, R', vvvv and V' are stored inverted.
+void Assembler::evex_prefix(bool vex_r, bool vex_b, bool vex_x, bool evex_r, bool evex_v, int nds_enc, VexSimdPrefix pre, VexOpcode opc, bool vex_w, int vector_len) {
+  assert(VM_Version::supports_evex(), "");
+  assert(vector_len == AVX_512bit || VM_Version::supports_avx512vl(), "requires AVX512VL");
+  prefix(EVEX_4bytes);
+
+  int byte1 = (vex_r ? VEX_R : 0) | (vex_x ? VEX_X : 0) | (vex_b ? VEX_B : 0) | (evex_r ? EVEX_Rb : 0);
+  byte1 = (~byte1) & 0xF0;
+  byte1 |= opc;
+  emit_int8(byte1);
+
+  int byte2 = ((~nds_enc) & 0xf) << 3;
+  byte2 |= (vex_w ? VEX_W : 0) | 0x04 | pre;
+  emit_int8(byte2);
+
+  // no zeroing, broadcast, rounding control nor opmask register (k0)
+  int byte3 = (vector_len << 5) | (evex_v ? 0 : EVEX_Vb);
+  emit_int8(byte3);
+}
+
+void Assembler::evex_prefix(Address adr, int nds_enc, int xreg_enc, VexSimdPrefix pre, VexOpcode opc, bool vex_w, int vector_len) {
+  bool vex_r = (xreg_enc & 8) != 0;
+  bool vex_b = adr.base_needs_rex();
+  bool vex_x = adr.index_needs_rex();
+  bool evex_r = (xreg_enc >= 16);
+  bool evex_v = (nds_enc >= 16);
+  evex_prefix(vex_r, vex_b, vex_x, evex_r, evex_v, nds_enc, pre, opc, vex_w, vector_len);
+}
+
+int Assembler::evex_prefix_and_encode(int dst_enc, int nds_enc, int src_enc, VexSimdPrefix pre, VexOpcode opc, bool vex_w, int vector_len) {
+  bool vex_r = (dst_enc & 8) != 0;
+  bool vex_b = (src_enc & 8) != 0;
+  // X extends the ModRM.rm register when it is not a memory operand
+  bool vex_x = (src_enc >= 16);
+  bool evex_r = (dst_enc >= 16);
+  bool evex_v = (nds_enc >= 16);
+  evex_prefix(vex_r, vex_b, vex_x, evex_r, evex_v, nds_enc, pre, opc, vex_w, vector_len);
+  return (((dst_enc & 7) << 3) | (src_enc & 7));
+}
+
 void Assembler::simd_prefix(XMMRegister xreg, XMMRegister nds, Address adr, VexSimdPrefix pre, VexOpcode opc, bool rex_w, bool vector256) {
   if (UseAVX > 0) {
     int xreg_enc = xreg->encoding();
@@ -4513,6 +4827,14 @@ void Assembler::emit_vex_arith(int opcode, XMMRegister dst, XMMRegister nds,
   emit_int8((unsigned char)(0xC0 | encode));
 }
 
+void Assembler::emit_evex_arith(int opcode, XMMRegister dst, XMMRegister nds,
+                                XMMRegister src, VexSimdPrefix pre, VexOpcode opc,
+                                bool vex_w, int vector_len) {
+  int encode = evex_prefix_and_encode(dst, nds, src, pre, opc, vex_w, vector_len);
+  emit_int8(opcode);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
 #ifndef _LP64
 
 void Assembler::incl(Register dst) {
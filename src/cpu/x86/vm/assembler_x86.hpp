@@ -502,7 +502,8 @@ class Assembler : public AbstractAssembler  {
     REX_WRXB   = 0x4F,
 
     VEX_3bytes = 0xC4,
-    VEX_2bytes = 0xC5
+    VEX_2bytes = 0xC5,
+    EVEX_4bytes = 0x62
   };
 
   enum VexPrefix {
@@ -512,6 +513,18 @@ class Assembler : public AbstractAssembler  {
     VEX_W = 0x80
   };
 
+  enum EvexPrefix {
+    EVEX_Rb = 0x10,  // high bit of the ModRM.reg register (xmm16-31)
+    EVEX_Vb = 0x08   // high bit of the vvvv register (xmm16-31)
+  };
+
+  // Vector length of AVX and EVEX encoded instructions
+  enum AvxVectorLen {
+    AVX_128bit = 0x0,
+    AVX_256bit = 0x1,
+    AVX_512bit = 0x2
+  };
+
   enum VexSimdPrefix {
     VEX_SIMD_NONE = 0x0,
     VEX_SIMD_66   = 0x1,
@@ -630,6 +643,27 @@ private:
     return vex_prefix_and_encode(dst_enc, nds_enc, src_enc, pre, opc, false, vector256);
   }
 
+  // EVEX prefix of AVX-512 instructions, no opmask register is used.
+  void evex_prefix(bool vex_r, bool vex_b, bool vex_x, bool evex_r, bool evex_v,
+                   int nds_enc, VexSimdPrefix pre, VexOpcode opc,
+                   bool vex_w, int vector_len);
+
+  void evex_prefix(Address adr, int nds_enc, int xreg_enc,
+                   VexSimdPrefix pre, VexOpcode opc,
+                   bool vex_w, int vector_len);
+
+  int  evex_prefix_and_encode(int dst_enc, int nds_enc, int src_enc,
+                              VexSimdPrefix pre, VexOpcode opc,
+                              bool vex_w, int vector_len);
+
+  int  evex_prefix_and_encode(XMMRegister dst, XMMRegister nds, XMMRegister src,
+                              VexSimdPrefix pre, VexOpcode opc,
+                              bool vex_w, int vector_len) {
+    int nds_enc = nds->is_valid() ? nds->encoding() : 0;
+    return evex_prefix_and_encode(dst->encoding(), nds_enc, src->encoding(),
+                                  pre, opc, vex_w, vector_len);
+  }
+
   void simd_prefix(XMMRegister xreg, XMMRegister nds, Address adr,
                    VexSimdPrefix pre, VexOpcode opc = VEX_OPCODE_0F,
                    bool rex_w = false, bool vector256 = false);
@@ -699,12 +733,20 @@ private:
                       Address src, VexSimdPrefix pre, bool vector256);
   void emit_vex_arith(int opcode, XMMRegister dst, XMMRegister nds,
                       XMMRegister src, VexSimdPrefix pre, bool vector256);
+  void emit_evex_arith(int opcode, XMMRegister dst, XMMRegister nds,
+                       XMMRegister src, VexSimdPrefix pre, VexOpcode opc,
+                       bool vex_w, int vector_len);
+
+  // Memory operand of an EVEX encoded instruction, an 8-bit displacement
+  // is scaled by the size of the memory operand (compressed disp8*N).
+  void emit_evex_operand(XMMRegister reg, Address adr, int disp8_scale);
 
   void emit_operand(Register reg,
                     Register base, Register index, Address::ScaleFactor scale,
                     int disp,
                     RelocationHolder const& rspec,
-                    int rip_relative_correction = 0);
+                    int rip_relative_correction = 0,
+                    int disp8_scale = 1);
 
   void emit_operand(Register reg, Address adr, int rip_relative_correction = 0);
 
@@ -1488,6 +1530,9 @@ private:
   void pmovzxbw(XMMRegister dst, XMMRegister src);
   void pmovzxbw(XMMRegister dst, Address src);
 
+  // Zero extend packed words to doublewords
+  void vpmovzxwd(XMMRegister dst, Address src, bool vector256);
+
 #ifndef _LP64 // no 32bit push/pop on amd64
   void popl(Address dst);
 #endif
@@ -1861,6 +1906,10 @@ private:
   void vextractf128h(Address dst, XMMRegister src);
   void vextracti128h(Address dst, XMMRegister src);
 
+  // Copy high 128bit of YMM registers into low 128bit of XMM registers.
+  void vextractf128h(XMMRegister dst, XMMRegister src);
+  void vextracti128h(XMMRegister dst, XMMRegister src);
+
   // duplicate 4-bytes integer data from src into 8 locations in dest
   void vpbroadcastd(XMMRegister dst, XMMRegister src);
 
@@ -1868,6 +1917,70 @@ private:
   void pclmulqdq(XMMRegister dst, XMMRegister src, int mask);
   void vpclmulqdq(XMMRegister dst, XMMRegister nds, XMMRegister src, int mask);
 
+  //====================AVX-512 (EVEX encoded)================================
+  // The vector_len of these instructions is AVX_512bit unless the cpu
+  // supports AVX512VL. xmm16-xmm31 can only be used with them.
+
+  // Move unaligned packed integer values
+  void evmovdqul(XMMRegister dst, XMMRegister src, int vector_len);
+  void evmovdqul(XMMRegister dst, Address src, int vector_len);
+  void evmovdqul(Address dst, XMMRegister src, int vector_len);
+
+  // Zero extend packed words to doublewords
+  void evpmovzxwd(XMMRegister dst, Address src, int vector_len);
+
+  // Duplicate an element of src into all elements of dst
+  void evpbroadcastd(XMMRegister dst, XMMRegister src, int vector_len);
+  void evpbroadcastq(XMMRegister dst, XMMRegister src, int vector_len);
+  void evpbroadcastd(XMMRegister dst, Register src, int vector_len);
+  void evpbroadcastq(XMMRegister dst, Register src, int vector_len);
+  void evbroadcastss(XMMRegister dst, XMMRegister src, int vector_len);
+  void evbroadcastsd(XMMRegister dst, XMMRegister src, int vector_len);
+
+  // Packed integer arithmetic
+  void evpaddd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evpaddq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evpsubd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evpsubq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evpmulld(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evpmullq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len); // AVX512DQ
+
+  // Packed floating-point arithmetic
+  void evaddps(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evaddpd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evsubps(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evsubpd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evmulps(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evmulpd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evdivps(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evdivpd(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+
+  // Bitwise logical operations on packed quadwords
+  void evpandq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evporq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+  void evpxorq(XMMRegister dst, XMMRegister nds, XMMRegister src, int vector_len);
+
+  // Shift packed integers, the count is in the low quadword of shift
+  void evpslld(XMMRegister dst, XMMRegister src, int shift, int vector_len);
+  void evpsllq(XMMRegister dst, XMMRegister src, int shift, int vector_len);
+  void evpsrld(XMMRegister dst, XMMRegister src, int shift, int vector_len);
+  void evpsrlq(XMMRegister dst, XMMRegister src, int shift, int vector_len);
+  void evpsrad(XMMRegister dst, XMMRegister src, int shift, int vector_len);
+  void evpsraq(XMMRegister dst, XMMRegister src, int shift, int vector_len);
+  void evpslld(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len);
+  void evpsllq(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len);
+  void evpsrld(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len);
+  void evpsrlq(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len);
+  void evpsrad(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len);
+  void evpsraq(XMMRegister dst, XMMRegister src, XMMRegister shift, int vector_len);
+
+  // Copy 256bit between YMM registers and the low (imm8 == 0) or
+  // high (imm8 == 1) half of ZMM registers or memory.
+  void vinserti64x4(XMMRegister dst, XMMRegister nds, XMMRegister src, int imm8);
+  void vinserti64x4(XMMRegister dst, Address src, int imm8);
+  void vextracti64x4(XMMRegister dst, XMMRegister src, int imm8);
+  void vextracti64x4(Address dst, XMMRegister src, int imm8);
+
   // AVX instruction which is used to clear upper 128 bits of YMM registers and
   // to avoid transaction penalty between AVX and SSE states. There is no
   // penalty if legacy SSE instructions are encoded using VEX prefix because
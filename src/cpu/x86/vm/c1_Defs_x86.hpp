@@ -41,7 +41,11 @@ enum {
 enum {
   pd_nof_cpu_regs_frame_map = RegisterImpl::number_of_registers,       // number of registers used during code emission
   pd_nof_fpu_regs_frame_map = FloatRegisterImpl::number_of_registers,  // number of registers used during code emission
+#ifdef _LP64
+  pd_nof_xmm_regs_frame_map = 16,    // number of registers used during code emission, xmm16-31 need EVEX
+#else
   pd_nof_xmm_regs_frame_map = XMMRegisterImpl::number_of_registers,    // number of registers used during code emission
+#endif // _LP64
 
 #ifdef _LP64
   #define UNALLOCATED 4    // rsp, rbp, r15, r10
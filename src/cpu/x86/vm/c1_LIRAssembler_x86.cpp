@@ -607,6 +607,13 @@ void LIR_Assembler::return_op(LIR_Opr result) {
   AddressLiteral polling_page(os::get_polling_page() + (SafepointPollOffset % os::vm_page_size()),
                               relocInfo::poll_return_type);
 
+#ifdef _LP64
+  if (ThreadLocalHandshakes) {
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::polling_page_offset()));
+    __ relocate(relocInfo::poll_return_type);
+    __ testl(rax, Address(rscratch1, 0));
+  } else
+#endif // _LP64
   if (Assembler::is_polling_page_far()) {
     __ lea(rscratch1, polling_page);
     __ relocate(relocInfo::poll_return_type);
@@ -623,6 +630,16 @@ int LIR_Assembler::safepoint_poll(LIR_Opr tmp, CodeEmitInfo* info) {
                               relocInfo::poll_type);
   guarantee(info != NULL, "Shouldn't be NULL");
   int offset = __ offset();
+#ifdef _LP64
+  if (ThreadLocalHandshakes) {
+    // The poll word of the thread points to a readable page unless a
+    // safepoint or a handshake is pending.
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::polling_page_offset()));
+    offset = __ offset();
+    add_debug_info_for_branch(info);
+    __ testl(rax, Address(rscratch1, 0));
+  } else
+#endif // _LP64
   if (Assembler::is_polling_page_far()) {
     __ lea(rscratch1, polling_page);
     offset = __ offset();
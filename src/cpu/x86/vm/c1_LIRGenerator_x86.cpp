@@ -1011,6 +1011,54 @@ void LIRGenerator::do_update_CRC32(Intrinsic* x) {
   }
 }
 
+// String.hashCode(), String.equals(Object) and String.compareTo(String)
+// call the String stubs with their receiver and argument.
+void LIRGenerator::do_String_intrinsic(Intrinsic* x) {
+  assert(UseStringIntrinsicStubs, "need the String stubs");
+  address entry = NULL;
+  switch (x->id()) {
+    case vmIntrinsics::_stringHashCode: entry = StubRoutines::stringHashCode();  break;
+    case vmIntrinsics::_equals:         entry = StubRoutines::stringEquals();    break;
+    case vmIntrinsics::_compareTo:      entry = StubRoutines::stringCompareTo(); break;
+    default:                            ShouldNotReachHere();
+  }
+  assert(entry != NULL, "stub must be generated");
+  int nargs = x->number_of_arguments();
+
+  // Make all state_for calls early since they can emit code
+  CodeEmitInfo* rcvr_info = NULL;
+  if (x->needs_null_check()) {
+    rcvr_info = state_for(x);
+  }
+  // String.equals(null) is false, but String.compareTo(null) throws
+  CodeEmitInfo* arg_info = NULL;
+  if (x->id() == vmIntrinsics::_compareTo && x->arg_needs_null_check(1)) {
+    arg_info = state_for(x);
+  }
+  LIR_Opr result = rlock_result(x);
+
+  BasicTypeList signature(nargs);
+  LIR_OprList* args = new LIR_OprList(nargs);
+  for (int i = 0; i < nargs; i++) {
+    LIRItem arg(x->argument_at(i), this);
+    arg.load_item();
+    CodeEmitInfo* info = (i == 0) ? rcvr_info : arg_info;
+    if (info != NULL) {
+      __ null_check(arg.result(), info);
+    }
+    signature.append(T_OBJECT);
+    args->append(arg.result());
+  }
+  CallingConvention* cc = frame_map()->c_calling_convention(&signature);
+  const LIR_Opr result_reg = result_register_for(x->type());
+  for (int i = 0; i < nargs; i++) {
+    __ move(args->at(i), cc->at(i));
+  }
+
+  __ call_runtime_leaf(entry, getThreadTemp(), result_reg, cc->args());
+  __ move(result_reg, result);
+}
+
 // _i2l, _i2f, _i2d, _l2i, _l2f, _l2d, _f2i, _f2l, _f2d, _d2i, _d2l, _d2f
 // _i2b, _i2c, _i2s
 LIR_Opr fixed_register_for(BasicType type) {
@@ -76,6 +76,9 @@ define_pd_global(bool, UseMembar,            true);
 define_pd_global(bool, UseMembar,            false);
 #endif
 
+// Thread-local polls are implemented in the 64-bit interpreter and compilers
+define_pd_global(bool, ThreadLocalHandshakes, LP64_ONLY(true) NOT_LP64(false));
+
 // GC Ergo Flags
 define_pd_global(uintx, CMSYoungGenPerWorker, 64*M);  // default max size of CMS young gen, per GC worker thread
 
@@ -7040,6 +7040,219 @@ void MacroAssembler::char_arrays_equals(bool is_array_equ, Register ary1, Regist
   }
 }
 
+// Computes h = 31 * h + ary[i] over the cnt chars at ary, starting with
+// h = 0. With AVX2 (AVX-512) lane j of a vector of 8 (16) ints sums up the
+// chars at the positions equal to j modulo the number of lanes, and every
+// step multiplies the lanes by 31 to the number of lanes. At the end lane
+// j is weighted with 31^(lanes - 1 - j) and the lanes are added up. The
+// chars which do not fill a vector are hashed one at a time.
+void MacroAssembler::string_hash_code(Register ary, Register cnt, Register result, Register tmp,
+                                      XMMRegister vec1, XMMRegister vec2,
+                                      XMMRegister vec3, XMMRegister vec4) {
+  ShortBranchVerifier sbv(this);
+  assert_different_registers(ary, cnt, result, tmp);
+  Label SCALAR, SCALAR_LOOP, DONE;
+
+  xorl(result, result);
+
+  if (UseAVX >= 2) {
+    Label WIDE_LOOP, FOLD, REDUCE;
+    bool wide = UseAVX > 2;
+    int lanes = wide ? 16 : 8;
+    int stride = lanes * sizeof(jchar);
+    // The table holds 31^15 .. 31^0 followed by 31^8, 31^16 and 31^32.
+    Address lane_powers(tmp, (16 - lanes) * BytesPerInt);
+    Address lanes_power(tmp, (wide ? 17 : 16) * BytesPerInt);
+    Address twice_lanes_power(tmp, (wide ? 18 : 17) * BytesPerInt);
+
+    cmpl(cnt, 2 * lanes);
+    jcc(Assembler::less, SCALAR);
+    lea(tmp, ExternalAddress(StubRoutines::x86::string_hash_powers_addr()));
+
+    // Two accumulators hide the latency of the multiplications, the
+    // second one takes the chars following those of the first one.
+    movdl(vec3, twice_lanes_power);
+    if (wide) {
+      evpbroadcastd(vec3, vec3, AVX_512bit);
+      evpmovzxwd(vec1, Address(ary, 0), AVX_512bit);
+      evpmovzxwd(vec2, Address(ary, stride), AVX_512bit);
+    } else {
+      vpbroadcastd(vec3, vec3);
+      vpmovzxwd(vec1, Address(ary, 0), true);
+      vpmovzxwd(vec2, Address(ary, stride), true);
+    }
+    addptr(ary, 2 * stride);
+    subl(cnt, 2 * lanes);
+
+    bind(WIDE_LOOP);
+    cmpl(cnt, 2 * lanes);
+    jccb(Assembler::less, FOLD);
+    if (wide) {
+      evpmulld(vec1, vec1, vec3, AVX_512bit);
+      evpmovzxwd(vec4, Address(ary, 0), AVX_512bit);
+      evpaddd(vec1, vec1, vec4, AVX_512bit);
+      evpmulld(vec2, vec2, vec3, AVX_512bit);
+      evpmovzxwd(vec4, Address(ary, stride), AVX_512bit);
+      evpaddd(vec2, vec2, vec4, AVX_512bit);
+    } else {
+      vpmulld(vec1, vec1, vec3, true);
+      vpmovzxwd(vec4, Address(ary, 0), true);
+      vpaddd(vec1, vec1, vec4, true);
+      vpmulld(vec2, vec2, vec3, true);
+      vpmovzxwd(vec4, Address(ary, stride), true);
+      vpaddd(vec2, vec2, vec4, true);
+    }
+    addptr(ary, 2 * stride);
+    subl(cnt, 2 * lanes);
+    jmpb(WIDE_LOOP);
+
+    // Combine the accumulators and take one more vector if there is one.
+    bind(FOLD);
+    movdl(vec3, lanes_power);
+    if (wide) {
+      evpbroadcastd(vec3, vec3, AVX_512bit);
+      evpmulld(vec1, vec1, vec3, AVX_512bit);
+      evpaddd(vec1, vec1, vec2, AVX_512bit);
+    } else {
+      vpbroadcastd(vec3, vec3);
+      vpmulld(vec1, vec1, vec3, true);
+      vpaddd(vec1, vec1, vec2, true);
+    }
+    cmpl(cnt, lanes);
+    jccb(Assembler::less, REDUCE);
+    if (wide) {
+      evpmulld(vec1, vec1, vec3, AVX_512bit);
+      evpmovzxwd(vec4, Address(ary, 0), AVX_512bit);
+      evpaddd(vec1, vec1, vec4, AVX_512bit);
+    } else {
+      vpmulld(vec1, vec1, vec3, true);
+      vpmovzxwd(vec4, Address(ary, 0), true);
+      vpaddd(vec1, vec1, vec4, true);
+    }
+    addptr(ary, stride);
+    subl(cnt, lanes);
+
+    bind(REDUCE);
+    if (wide) {
+      evmovdqul(vec2, lane_powers, AVX_512bit);
+      evpmulld(vec1, vec1, vec2, AVX_512bit);
+      vextracti64x4(vec2, vec1, 1);
+      vpaddd(vec1, vec1, vec2, true);
+    } else {
+      vpmulld(vec1, vec1, lane_powers, true);
+    }
+    vextracti128h(vec2, vec1);
+    vpaddd(vec1, vec1, vec2, false);
+    pshufd(vec2, vec1, 0x4E);
+    vpaddd(vec1, vec1, vec2, false);
+    pshufd(vec2, vec1, 0xB1);
+    vpaddd(vec1, vec1, vec2, false);
+    movdl(result, vec1);
+
+    // clean upper bits of YMM registers
+    vpxor(vec1, vec1);
+    vpxor(vec2, vec2);
+    vpxor(vec3, vec3);
+    vpxor(vec4, vec4);
+  }
+
+  bind(SCALAR);
+  testl(cnt, cnt);
+  jccb(Assembler::zero, DONE);
+  bind(SCALAR_LOOP);
+  imull(result, result, 31);
+  load_unsigned_short(tmp, Address(ary, 0));
+  addl(result, tmp);
+  addptr(ary, 2);
+  decrementl(cnt);
+  jccb(Assembler::notZero, SCALAR_LOOP);
+  bind(DONE);
+}
+
+#ifdef _LP64
+// Find the first byte at which the memory at a and b differs. bytes holds
+// the number of bytes to compare, the offset of the first mismatch or -1
+// is returned in result.
+void MacroAssembler::vectorized_mismatch(Register a, Register b, Register bytes,
+                                         Register result, Register tmp1, Register tmp2,
+                                         XMMRegister vec1, XMMRegister vec2) {
+  assert_different_registers(a, b, bytes, result, tmp1, tmp2);
+  Label COMPARE_WORDS, WORD_MISMATCH, COMPARE_BYTES, BYTE_LOOP, EQUAL, DONE;
+
+  xorl(result, result);  // offset of the next bytes to compare
+
+  if (UseAVX >= 2 || UseSSE42Intrinsics) {
+    // Compare 32-byte (AVX2) or 16-byte (SSE4.2) vectors. The words of a
+    // vector which differs are compared again to locate the mismatch.
+    Label COMPARE_VECTORS;
+    int stride = (UseAVX >= 2) ? 32 : 16;
+
+    lea(tmp1, Address(result, stride));
+    cmpq(tmp1, bytes);
+    jcc(Assembler::greater, COMPARE_WORDS);
+
+    bind(COMPARE_VECTORS);
+    if (UseAVX >= 2) {
+      vmovdqu(vec1, Address(a, result, Address::times_1));
+      vmovdqu(vec2, Address(b, result, Address::times_1));
+      vpxor(vec1, vec2);
+      vptest(vec1, vec1);
+    } else {
+      movdqu(vec1, Address(a, result, Address::times_1));
+      movdqu(vec2, Address(b, result, Address::times_1));
+      pxor(vec1, vec2);
+      ptest(vec1, vec1);
+    }
+    jcc(Assembler::notZero, COMPARE_WORDS);
+    addq(result, stride);
+    lea(tmp1, Address(result, stride));
+    cmpq(tmp1, bytes);
+    jcc(Assembler::lessEqual, COMPARE_VECTORS);
+  }
+
+  // Compare 8-byte words
+  bind(COMPARE_WORDS);
+  lea(tmp1, Address(result, 8));
+  cmpq(tmp1, bytes);
+  jccb(Assembler::greater, COMPARE_BYTES);
+  movq(tmp1, Address(a, result, Address::times_1));
+  xorq(tmp1, Address(b, result, Address::times_1));
+  jccb(Assembler::notZero, WORD_MISMATCH);
+  addq(result, 8);
+  jmpb(COMPARE_WORDS);
+
+  bind(WORD_MISMATCH);
+  // The lowest set bit of the difference is in the first differing byte
+  bsfq(tmp1, tmp1);
+  shrq(tmp1, LogBitsPerByte);
+  addq(result, tmp1);
+  jmpb(DONE);
+
+  // Compare the trailing bytes
+  bind(COMPARE_BYTES);
+  cmpq(result, bytes);
+  jccb(Assembler::greaterEqual, EQUAL);
+  bind(BYTE_LOOP);
+  movzbl(tmp1, Address(a, result, Address::times_1));
+  movzbl(tmp2, Address(b, result, Address::times_1));
+  cmpl(tmp1, tmp2);
+  jccb(Assembler::notEqual, DONE);
+  incrementq(result);
+  cmpq(result, bytes);
+  jccb(Assembler::less, BYTE_LOOP);
+
+  bind(EQUAL);
+  movptr(result, (int32_t)-1);
+
+  bind(DONE);
+  if (UseAVX >= 2) {
+    // clean upper bits of YMM registers
+    vpxor(vec1, vec1);
+    vpxor(vec2, vec2);
+  }
+}
+#endif // _LP64
+
 void MacroAssembler::generate_fill(BasicType t, bool aligned,
                                    Register to, Register value, Register count,
                                    Register rtmp, XMMRegister xtmp) {
@@ -7148,15 +7361,23 @@ void MacroAssembler::generate_fill(BasicType t, bool aligned,
       if (UseAVX >= 2 && UseUnalignedLoadStores) {
         // Fill 64-byte chunks
         Label L_fill_64_bytes_loop, L_check_fill_32_bytes;
-        vpbroadcastd(xtmp, xtmp);
+        if (UseAVX > 2) {
+          evpbroadcastd(xtmp, xtmp, Assembler::AVX_512bit);
+        } else {
+          vpbroadcastd(xtmp, xtmp);
+        }
 
         subl(count, 16 << shift);
         jcc(Assembler::less, L_check_fill_32_bytes);
         align(16);
 
         BIND(L_fill_64_bytes_loop);
-        vmovdqu(Address(to, 0), xtmp);
-        vmovdqu(Address(to, 32), xtmp);
+        if (UseAVX > 2) {
+          evmovdqul(Address(to, 0), xtmp, Assembler::AVX_512bit);
+        } else {
+          vmovdqu(Address(to, 0), xtmp);
+          vmovdqu(Address(to, 32), xtmp);
+        }
         addptr(to, 64);
         subl(count, 16 << shift);
         jcc(Assembler::greaterEqual, L_fill_64_bytes_loop);
@@ -7169,7 +7390,7 @@ void MacroAssembler::generate_fill(BasicType t, bool aligned,
         subl(count, 8 << shift);
 
         BIND(L_check_fill_8_bytes);
-        // clean upper bits of YMM registers
+        // clean upper bits of YMM/ZMM registers
         movdl(xtmp, value);
         pshufd(xtmp, xtmp, 0);
       } else {
@@ -1216,6 +1216,18 @@ public:
                           Register limit, Register result, Register chr,
                           XMMRegister vec1, XMMRegister vec2);
 
+  // Hash char[] the way String.hashCode() does.
+  void string_hash_code(Register ary, Register cnt, Register result, Register tmp,
+                        XMMRegister vec1, XMMRegister vec2,
+                        XMMRegister vec3, XMMRegister vec4);
+
+#ifdef _LP64
+  // Find the first differing byte of two memory ranges.
+  void vectorized_mismatch(Register a, Register b, Register bytes,
+                           Register result, Register tmp1, Register tmp2,
+                           XMMRegister vec1, XMMRegister vec2);
+#endif
+
   // Fill primitive arrays
   void generate_fill(BasicType t, bool aligned,
                      Register to, Register value, Register count,
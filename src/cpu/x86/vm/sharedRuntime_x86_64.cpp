@@ -142,9 +142,14 @@ OopMap* RegisterSaver::save_live_registers(MacroAssembler* masm, int additional_
 #ifdef COMPILER2
   if (save_vectors) {
     assert(UseAVX > 0, "256bit vectors are supported only with AVX");
-    assert(MaxVectorSize == 32, "only 256bit vectors are supported now");
+    assert(MaxVectorSize <= 64, "only 256bit and 512bit vectors are supported now");
     // Save upper half of YMM registes
     vect_words = 16 * 16 / wordSize;
+    if (MaxVectorSize > 32) {
+      assert(UseAVX > 2, "512bit vectors are supported only with EVEX");
+      // Save upper half of ZMM registers and the whole ZMM16-ZMM31
+      vect_words += (16 * 32 + 16 * 64) / wordSize;
+    }
     additional_frame_words += vect_words;
   }
 #else
@@ -172,7 +177,7 @@ OopMap* RegisterSaver::save_live_registers(MacroAssembler* masm, int additional_
   __ push_CPU_state(); // Push a multiple of 16 bytes
 
   if (vect_words > 0) {
-    assert(vect_words*wordSize == 256, "");
+    assert(vect_words*wordSize == 256 || vect_words*wordSize == 1792, "");
     __ subptr(rsp, 256); // Save upper half of YMM registes
     __ vextractf128h(Address(rsp,  0),xmm0);
     __ vextractf128h(Address(rsp, 16),xmm1);
@@ -191,6 +196,15 @@ OopMap* RegisterSaver::save_live_registers(MacroAssembler* masm, int additional_
     __ vextractf128h(Address(rsp,224),xmm14);
     __ vextractf128h(Address(rsp,240),xmm15);
   }
+  if (vect_words*wordSize > 256) {
+    __ subptr(rsp, 1536); // Save upper half of ZMM registers and ZMM16-ZMM31
+    for (int n = 0; n < 16; n++) {
+      __ vextracti64x4(Address(rsp, n*32), as_XMMRegister(n), 1);
+    }
+    for (int n = 16; n < 32; n++) {
+      __ evmovdqul(Address(rsp, 512 + (n-16)*64), as_XMMRegister(n), Assembler::AVX_512bit);
+    }
+  }
   if (frame::arg_reg_save_area_bytes != 0) {
     // Allocate argument register save area
     __ subptr(rsp, frame::arg_reg_save_area_bytes);
@@ -286,24 +300,23 @@ void RegisterSaver::restore_live_registers(MacroAssembler* masm, bool restore_ve
   if (restore_vectors) {
     // Restore upper half of YMM registes.
     assert(UseAVX > 0, "256bit vectors are supported only with AVX");
-    assert(MaxVectorSize == 32, "only 256bit vectors are supported now");
-    __ vinsertf128h(xmm0, Address(rsp,  0));
-    __ vinsertf128h(xmm1, Address(rsp, 16));
-    __ vinsertf128h(xmm2, Address(rsp, 32));
-    __ vinsertf128h(xmm3, Address(rsp, 48));
-    __ vinsertf128h(xmm4, Address(rsp, 64));
-    __ vinsertf128h(xmm5, Address(rsp, 80));
-    __ vinsertf128h(xmm6, Address(rsp, 96));
-    __ vinsertf128h(xmm7, Address(rsp,112));
-    __ vinsertf128h(xmm8, Address(rsp,128));
-    __ vinsertf128h(xmm9, Address(rsp,144));
-    __ vinsertf128h(xmm10, Address(rsp,160));
-    __ vinsertf128h(xmm11, Address(rsp,176));
-    __ vinsertf128h(xmm12, Address(rsp,192));
-    __ vinsertf128h(xmm13, Address(rsp,208));
-    __ vinsertf128h(xmm14, Address(rsp,224));
-    __ vinsertf128h(xmm15, Address(rsp,240));
-    __ addptr(rsp, 256);
+    assert(MaxVectorSize <= 64, "only 256bit and 512bit vectors are supported now");
+    // The ZMM registers were saved below the YMM halves. VEX encoded
+    // instructions clear the upper half of ZMM registers, so restore the
+    // YMM halves first.
+    int zmm_bytes = (MaxVectorSize > 32) ? 1536 : 0;
+    for (int n = 0; n < 16; n++) {
+      __ vinsertf128h(as_XMMRegister(n), Address(rsp, zmm_bytes + n*16));
+    }
+    if (zmm_bytes > 0) {
+      for (int n = 0; n < 16; n++) {
+        __ vinserti64x4(as_XMMRegister(n), Address(rsp, n*32), 1);
+      }
+      for (int n = 16; n < 32; n++) {
+        __ evmovdqul(as_XMMRegister(n), Address(rsp, 512 + (n-16)*64), Assembler::AVX_512bit);
+      }
+    }
+    __ addptr(rsp, zmm_bytes + 256);
   }
 #else
   assert(!restore_vectors, "vectors are generated only by C2");
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "asm/macroAssembler.hpp"
 #include "asm/macroAssembler.inline.hpp"
+#include "classfile/javaClasses.hpp"
 #include "interpreter/interpreter.hpp"
 #include "nativeInst_x86.hpp"
 #include "oops/instanceOop.hpp"
@@ -2935,6 +2936,172 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  // Loads the char[] of the String str, the array may replace str.
+  void load_string_value(Register str, Register ary, Register cnt) {
+    __ movptr(ary, Address(str, java_lang_String::value_offset_in_bytes()));
+    __ movl(cnt, Address(ary, arrayOopDesc::length_offset_in_bytes()));
+    __ lea(ary, Address(ary, arrayOopDesc::base_offset_in_bytes(T_CHAR)));
+  }
+
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   rsp(4)   - String str
+   *
+   * Ouput:
+   *       rax   - int str.hashCode()
+   */
+  address generate_stringHashCode() {
+    assert(UseStringIntrinsicStubs, "not needed");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "stringHashCode");
+
+    address start = __ pc();
+
+    const Register str    = rcx;
+    const Register ary    = rsi;
+    const Register cnt    = rdi;
+    const Register tmp    = rdx;
+    const Register result = rax;
+    Label L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+    __ push(rsi);
+    __ push(rdi);
+
+    __ movptr(str, Address(rbp, 8 + 0));
+
+    // A hash of zero is computed every time, as in String.hashCode().
+    __ movl(result, Address(str, java_lang_String::hash_offset_in_bytes()));
+    __ testl(result, result);
+    __ jcc(Assembler::notZero, L_done);
+    load_string_value(str, ary, cnt);
+    __ testl(cnt, cnt);
+    __ jcc(Assembler::zero, L_done);
+
+    __ string_hash_code(ary, cnt, result, tmp, xmm0, xmm1, xmm2, xmm3);
+    __ movl(Address(str, java_lang_String::hash_offset_in_bytes()), result);
+
+    __ bind(L_done);
+    __ pop(rdi);
+    __ pop(rsi);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   rsp(4)   - String str1
+   *   rsp(8)   - Object obj, may be NULL
+   *
+   * Ouput:
+   *       rax   - int str1.equals(obj)
+   */
+  address generate_stringEquals() {
+    assert(UseStringIntrinsicStubs, "not needed");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "stringEquals");
+
+    address start = __ pc();
+
+    // The strings are replaced by their arrays.
+    const Register str1   = rdi;
+    const Register str2   = rsi;
+    const Register cnt    = rcx;
+    const Register chr    = rbx;
+    const Register result = rax;
+    Label L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+    __ push(rsi);
+    __ push(rdi);
+    __ push(rbx);
+
+    __ movptr(str1, Address(rbp, 8 + 0));
+    __ movptr(str2, Address(rbp, 8 + 4));
+
+    __ movl(result, 1);
+    __ cmpptr(str1, str2);
+    __ jcc(Assembler::equal, L_done);
+    __ xorl(result, result);
+    __ testptr(str2, str2);
+    __ jcc(Assembler::zero, L_done);
+    // String is final, so obj is a String if it has the klass of str1.
+    __ movptr(chr, Address(str1, oopDesc::klass_offset_in_bytes()));
+    __ cmpptr(chr, Address(str2, oopDesc::klass_offset_in_bytes()));
+    __ jcc(Assembler::notEqual, L_done);
+
+    load_string_value(str1, str1, cnt);
+    load_string_value(str2, str2, chr);
+    __ cmpl(cnt, chr);
+    __ jcc(Assembler::notEqual, L_done);
+    __ char_arrays_equals(false, str1, str2, cnt, result, chr, xmm0, xmm1);
+
+    __ bind(L_done);
+    __ pop(rbx);
+    __ pop(rdi);
+    __ pop(rsi);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   rsp(4)   - String str1
+   *   rsp(8)   - String str2, not NULL
+   *
+   * Ouput:
+   *       rax   - int str1.compareTo(str2)
+   */
+  address generate_stringCompareTo() {
+    assert(UseStringIntrinsicStubs, "not needed");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "stringCompareTo");
+
+    address start = __ pc();
+
+    // The registers of the string_compare rule in x86_32.ad,
+    // pcmpestri uses rax, rcx and rdx.
+    const Register str1   = rdi;
+    const Register str2   = rsi;
+    const Register cnt1   = rcx;
+    const Register cnt2   = rdx;
+    const Register result = rax;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+    __ push(rsi);
+    __ push(rdi);
+
+    __ movptr(str1, Address(rbp, 8 + 0));
+    __ movptr(str2, Address(rbp, 8 + 4));
+
+    load_string_value(str1, str1, cnt1);
+    load_string_value(str2, str2, cnt2);
+    __ string_compare(str1, str2, cnt1, cnt2, result, xmm0);
+
+    __ pop(rdi);
+    __ pop(rsi);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
   // Safefetch stubs.
   void generate_safefetch(const char* name, int size, address* entry,
                           address* fault_pc, address* continuation_pc) {
@@ -3188,6 +3355,13 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_ghash_processBlocks = generate_ghash_processBlocks();
     }
 
+    // The stubs know the layout of String without offset and count.
+    if (UseStringIntrinsicStubs && !java_lang_String::has_offset_field()) {
+      StubRoutines::_stringHashCode  = generate_stringHashCode();
+      StubRoutines::_stringEquals    = generate_stringEquals();
+      StubRoutines::_stringCompareTo = generate_stringCompareTo();
+    }
+
     // Safefetch stubs.
     generate_safefetch("SafeFetch32", sizeof(int), &StubRoutines::_safefetch32_entry,
                                                    &StubRoutines::_safefetch32_fault_pc,
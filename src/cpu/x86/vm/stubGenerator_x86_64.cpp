@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "asm/macroAssembler.hpp"
 #include "asm/macroAssembler.inline.hpp"
+#include "classfile/javaClasses.hpp"
 #include "interpreter/interpreter.hpp"
 #include "nativeInst_x86.hpp"
 #include "oops/instanceOop.hpp"
@@ -1294,7 +1295,10 @@ class StubGenerator: public StubCodeGenerator {
       Label L_end;
       // Copy 64-bytes per iteration
       __ BIND(L_loop);
-      if (UseAVX >= 2) {
+      if (UseAVX > 2) {
+        __ evmovdqul(xmm0, Address(end_from, qword_count, Address::times_8, -56), Assembler::AVX_512bit);
+        __ evmovdqul(Address(end_to, qword_count, Address::times_8, -56), xmm0, Assembler::AVX_512bit);
+      } else if (UseAVX == 2) {
         __ vmovdqu(xmm0, Address(end_from, qword_count, Address::times_8, -56));
         __ vmovdqu(Address(end_to, qword_count, Address::times_8, -56), xmm0);
         __ vmovdqu(xmm1, Address(end_from, qword_count, Address::times_8, -24));
@@ -1327,7 +1331,7 @@ class StubGenerator: public StubCodeGenerator {
       __ addptr(qword_count, 4);
       __ BIND(L_end);
       if (UseAVX >= 2) {
-        // clean upper bits of YMM registers
+        // clean upper bits of YMM/ZMM registers
         __ vpxor(xmm0, xmm0);
         __ vpxor(xmm1, xmm1);
       }
@@ -1371,7 +1375,10 @@ class StubGenerator: public StubCodeGenerator {
       Label L_end;
       // Copy 64-bytes per iteration
       __ BIND(L_loop);
-      if (UseAVX >= 2) {
+      if (UseAVX > 2) {
+        __ evmovdqul(xmm0, Address(from, qword_count, Address::times_8, 0), Assembler::AVX_512bit);
+        __ evmovdqul(Address(dest, qword_count, Address::times_8, 0), xmm0, Assembler::AVX_512bit);
+      } else if (UseAVX == 2) {
         __ vmovdqu(xmm0, Address(from, qword_count, Address::times_8, 32));
         __ vmovdqu(Address(dest, qword_count, Address::times_8, 32), xmm0);
         __ vmovdqu(xmm1, Address(from, qword_count, Address::times_8,  0));
@@ -1405,7 +1412,7 @@ class StubGenerator: public StubCodeGenerator {
       __ subptr(qword_count, 4);
       __ BIND(L_end);
       if (UseAVX >= 2) {
-        // clean upper bits of YMM registers
+        // clean upper bits of YMM/ZMM registers
         __ vpxor(xmm0, xmm0);
         __ vpxor(xmm1, xmm1);
       }
@@ -3848,6 +3855,216 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  // Loads the char[] of the String str, the array may replace str.
+  void load_string_value(Register str, Register ary, Register cnt) {
+    __ load_heap_oop(ary, Address(str, java_lang_String::value_offset_in_bytes()));
+    __ movl(cnt, Address(ary, arrayOopDesc::length_offset_in_bytes()));
+    __ lea(ary, Address(ary, arrayOopDesc::base_offset_in_bytes(T_CHAR)));
+  }
+
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - String str
+   *
+   * Ouput:
+   *       rax   - int str.hashCode()
+   */
+  address generate_stringHashCode() {
+    assert(UseStringIntrinsicStubs, "not needed");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "stringHashCode");
+
+    address start = __ pc();
+
+    const Register str    = c_rarg0;
+    const Register ary    = r8;
+    const Register cnt    = r9;
+    const Register tmp    = r11;
+    const Register result = rax;
+    assert_different_registers(str, ary, cnt, tmp, result);
+    Label L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    // A hash of zero is computed every time, as in String.hashCode().
+    __ movl(result, Address(str, java_lang_String::hash_offset_in_bytes()));
+    __ testl(result, result);
+    __ jcc(Assembler::notZero, L_done);
+    load_string_value(str, ary, cnt);
+    __ testl(cnt, cnt);
+    __ jcc(Assembler::zero, L_done);
+
+    __ string_hash_code(ary, cnt, result, tmp, xmm0, xmm1, xmm2, xmm3);
+    __ movl(Address(str, java_lang_String::hash_offset_in_bytes()), result);
+
+    __ bind(L_done);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - String str1
+   *   c_rarg1   - Object obj, may be NULL
+   *
+   * Ouput:
+   *       rax   - int str1.equals(obj)
+   */
+  address generate_stringEquals() {
+    assert(UseStringIntrinsicStubs, "not needed");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "stringEquals");
+
+    address start = __ pc();
+
+    const Register str1   = c_rarg0;
+    const Register str2   = c_rarg1;
+    const Register ary1   = r8;
+    const Register ary2   = r9;
+    const Register cnt    = r10;
+    const Register chr    = r11;
+    const Register result = rax;
+    assert_different_registers(str1, str2, ary1, ary2, cnt, chr, result);
+    Label L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ movl(result, 1);
+    __ cmpptr(str1, str2);
+    __ jcc(Assembler::equal, L_done);
+    __ xorl(result, result);
+    __ testptr(str2, str2);
+    __ jcc(Assembler::zero, L_done);
+    // String is final, so obj is a String if it has the klass of str1.
+    if (UseCompressedClassPointers) {
+      __ movl(chr, Address(str1, oopDesc::klass_offset_in_bytes()));
+      __ cmpl(chr, Address(str2, oopDesc::klass_offset_in_bytes()));
+    } else {
+      __ movptr(chr, Address(str1, oopDesc::klass_offset_in_bytes()));
+      __ cmpptr(chr, Address(str2, oopDesc::klass_offset_in_bytes()));
+    }
+    __ jcc(Assembler::notEqual, L_done);
+
+    load_string_value(str1, ary1, cnt);
+    load_string_value(str2, ary2, chr);
+    __ cmpl(cnt, chr);
+    __ jcc(Assembler::notEqual, L_done);
+    __ char_arrays_equals(false, ary1, ary2, cnt, result, chr, xmm0, xmm1);
+
+    __ bind(L_done);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - String str1
+   *   c_rarg1   - String str2, not NULL
+   *
+   * Ouput:
+   *       rax   - int str1.compareTo(str2)
+   */
+  address generate_stringCompareTo() {
+    assert(UseStringIntrinsicStubs, "not needed");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "stringCompareTo");
+
+    address start = __ pc();
+
+    // The registers of the string_compare rule in x86_64.ad,
+    // pcmpestri uses rax, rcx and rdx.
+    const Register str1   = rdi;
+    const Register str2   = rsi;
+    const Register cnt1   = rcx;
+    const Register cnt2   = rdx;
+    const Register result = rax;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+#ifdef _WIN64
+    __ push(rsi);
+    __ push(rdi);
+    __ movptr(str1, c_rarg0);
+    __ movptr(str2, c_rarg1);
+#else
+    assert(str1 == c_rarg0 && str2 == c_rarg1, "arguments in place");
+#endif
+
+    load_string_value(str1, str1, cnt1);
+    load_string_value(str2, str2, cnt2);
+    __ string_compare(str1, str2, cnt1, cnt2, result, xmm0);
+
+#ifdef _WIN64
+    __ pop(rdi);
+    __ pop(rsi);
+#endif
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *    c_rarg0   - a address
+   *    c_rarg1   - b address
+   *    c_rarg2   - number of elements
+   *    c_rarg3   - log2 of the element size
+   *
+   *  Output:
+   *    rax       - index of the first mismatching element or -1
+   */
+  address generate_vectorizedMismatch() {
+    assert(UseVectorizedMismatchIntrinsic, "not needed");
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "vectorizedMismatch");
+
+    address start = __ pc();
+    // Win64: rcx, rdx, r8, r9 (c_rarg0, c_rarg1, ...)
+    // Unix:  rdi, rsi, rdx, rcx (c_rarg0, c_rarg1, ...)
+    const Register a      = r10;
+    const Register b      = r11;
+    const Register bytes  = r8;
+    const Register result = rax;
+    const Register tmp    = r9;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ movptr(a, c_rarg0);
+    __ movptr(b, c_rarg1);
+    __ movl(bytes, c_rarg2);
+    __ movl(rcx, c_rarg3);  // the shift count must be in cl
+    __ shlq(bytes);         // number of bytes
+
+    __ vectorized_mismatch(a, b, bytes, result, tmp, rdx, xmm0, xmm1);
+
+    __ sarq(result);        // index of the element, -1 stays -1
+
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
 
   /**
    *  Arguments:
@@ -4260,6 +4477,16 @@ class StubGenerator: public StubCodeGenerator {
     generate_safefetch("SafeFetchN", sizeof(intptr_t), &StubRoutines::_safefetchN_entry,
                                                        &StubRoutines::_safefetchN_fault_pc,
                                                        &StubRoutines::_safefetchN_continuation_pc);
+    // The stubs know the layout of String without offset and count.
+    if (UseStringIntrinsicStubs && !java_lang_String::has_offset_field()) {
+      StubRoutines::_stringHashCode  = generate_stringHashCode();
+      StubRoutines::_stringEquals    = generate_stringEquals();
+      StubRoutines::_stringCompareTo = generate_stringCompareTo();
+    }
+    if (UseVectorizedMismatchIntrinsic) {
+      StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
+    }
+
 #ifdef COMPILER2
     if (UseMultiplyToLenIntrinsic) {
       StubRoutines::_multiplyToLen = generate_multiplyToLen();
@@ -130,3 +130,16 @@ juint StubRoutines::x86::_crc_table[] =
     0x5d681b02UL, 0x2a6f2b94UL, 0xb40bbe37UL, 0xc30c8ea1UL, 0x5a05df1bUL,
     0x2d02ef8dUL
 };
+
+/**
+ *  Powers of 31 for MacroAssembler::string_hash_code(): the weights
+ *  31^15 .. 31^0 of the vector lanes, followed by 31^8, 31^16 and 31^32.
+ */
+juint StubRoutines::x86::_string_hash_powers[] =
+{
+    0xe191dddfUL, 0x59db6a41UL, 0xe1ddc99fUL, 0xee830681UL,
+    0x07b1a55fUL, 0x94e4b2c1UL, 0xf449711fUL, 0x94446f01UL,
+    0x67e12cdfUL, 0x34e63b41UL, 0x01b4d89fUL, 0x000e1781UL,
+    0x0000745fUL, 0x000003c1UL, 0x0000001fUL, 0x00000001UL,
+    0x94446f01UL, 0x50a9de01UL, 0x7dd7bc01UL
+};
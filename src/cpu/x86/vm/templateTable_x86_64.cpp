@@ -1734,7 +1734,7 @@ void TemplateTable::branch(bool is_jsr, bool is_wide) {
   // eax: return bci for jsr's, unused otherwise
   // ebx: target bytecode
   // r13: target bcp
-  __ dispatch_only(vtos);
+  __ dispatch_only(vtos, true);
 
   if (UseLoopCounter) {
     if (ProfileInterpreter) {
@@ -2086,6 +2086,18 @@ void TemplateTable::_return(TosState state) {
   // Narrow result if state is itos but result type is smaller.
   // Need to narrow in the return bytecode rather than in generate_return_entry
   // since compiled code callers expect the result to already be narrowed.
+  if (ThreadLocalHandshakes && _desc->bytecode() != Bytecodes::_return_register_finalizer) {
+    Label no_safepoint;
+    NOT_PRODUCT(__ block_comment("Thread-local safepoint poll"));
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::polling_page_offset()));
+    __ testb(rscratch1, SafepointSynchronize::poll_bit());
+    __ jcc(Assembler::zero, no_safepoint);
+    __ push(state);
+    __ call_VM(noreg, CAST_FROM_FN_PTR(address, InterpreterRuntime::at_safepoint));
+    __ pop(state);
+    __ bind(no_safepoint);
+  }
+
   if (state == itos) {
     __ narrow(rax);
   }
@@ -56,7 +56,7 @@ address VM_Version::_cpuinfo_segv_addr = 0;
 address VM_Version::_cpuinfo_cont_addr = 0;
 
 static BufferBlob* stub_blob;
-static const int stub_size = 600;
+static const int stub_size = 1000;
 
 extern "C" {
   typedef void (*get_cpu_info_stub_t)(void*);
@@ -80,6 +80,7 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
 
     Label detect_486, cpu486, detect_586, std_cpuid1, std_cpuid4;
     Label sef_cpuid, ext_cpuid, ext_cpuid1, ext_cpuid5, ext_cpuid7, done;
+    Label legacy_setup, start_simd_check, legacy_save_restore;
 
     StubCodeMark mark(this, "VM_Version", "get_cpu_info_stub");
 #   define __ _masm->
@@ -241,7 +242,7 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     //
     __ andl(rcx, 0x18000000); // cpuid1 bits osxsave | avx
     __ cmpl(rcx, 0x18000000);
-    __ jccb(Assembler::notEqual, sef_cpuid); // jump if AVX is not supported
+    __ jcc(Assembler::notEqual, sef_cpuid); // jump if AVX is not supported
 
     //
     // XCR0, XFEATURE_ENABLED_MASK register
@@ -254,17 +255,54 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
 
     __ andl(rax, 0x6); // xcr0 bits sse | ymm
     __ cmpl(rax, 0x6);
-    __ jccb(Assembler::notEqual, sef_cpuid); // jump if AVX is not supported
+    __ jcc(Assembler::notEqual, sef_cpuid); // jump if AVX is not supported
 
     //
-    // Some OSs have a bug when upper 128bits of YMM
+    // Some OSs have a bug when upper 128/256bits of YMM/ZMM
     // registers are not restored after a signal processing.
     // Generate SEGV here (reference through NULL)
-    // and check upper YMM bits after it.
+    // and check upper YMM/ZMM bits after it.
     //
-    VM_Version::set_avx_cpuFeatures(); // Enable temporary to pass asserts
     intx saved_useavx = UseAVX;
     intx saved_usesse = UseSSE;
+
+    //
+    // The ZMM registers are checked only if the OS has enabled the opmask
+    // and the full ZMM state in XCR0 and the CPU supports AVX512F.
+    // Keep the cpuid(0x7) ebx value, it is checked again after the signal.
+    //
+    __ movl(rax, Address(rsi, 0));
+    __ andl(rax, 0xE0); // xcr0 bits opmask | zmm512 | zmm32
+    __ cmpl(rax, 0xE0);
+    __ jcc(Assembler::notEqual, legacy_setup);
+    __ movl(rax, 7);
+    __ cmpl(rax, Address(rbp, in_bytes(VM_Version::std_cpuid0_offset()))); // Is cpuid(0x7) supported?
+    __ jcc(Assembler::greater, legacy_setup);
+    __ xorl(rcx, rcx);
+    __ cpuid();
+    __ lea(rsi, Address(rbp, in_bytes(VM_Version::sef_cpuid7_offset())));
+    __ movl(Address(rsi, 4), rbx);
+    __ testl(rbx, 0x10000); // cpuid7 ebx bit avx512f
+    __ jcc(Assembler::zero, legacy_setup);
+
+    VM_Version::set_evex_cpuFeatures(); // Enable temporary to pass asserts
+    UseAVX = 3;
+    UseSSE = 2;
+
+    // load value into all 64 bytes of zmm7 register
+    __ movl(rcx, VM_Version::ymm_test_value());
+    __ movdl(xmm0, rcx);
+    __ evpbroadcastd(xmm0, xmm0, Assembler::AVX_512bit);
+    __ evmovdqul(xmm7, xmm0, Assembler::AVX_512bit);
+#ifdef _LP64
+    __ evmovdqul(xmm8, xmm0, Assembler::AVX_512bit);
+    __ evmovdqul(xmm15, xmm0, Assembler::AVX_512bit);
+    __ evmovdqul(xmm31, xmm0, Assembler::AVX_512bit);
+#endif
+    __ jmp(start_simd_check);
+
+    __ bind(legacy_setup);
+    VM_Version::set_avx_cpuFeatures(); // Enable temporary to pass asserts
     UseAVX = 1;
     UseSSE = 2;
 
@@ -280,6 +318,7 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ vmovdqu(xmm15, xmm0);
 #endif
 
+    __ bind(start_simd_check);
     __ xorl(rsi, rsi);
     VM_Version::set_cpuinfo_segv_addr( __ pc() );
     // Generate SEGV
@@ -295,6 +334,26 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ vmovdqu(Address(rsi, 96), xmm15);
 #endif
 
+    // Save the ZMM registers too if they were loaded above.
+    __ movl(rax, Address(rbp, in_bytes(VM_Version::xem_xcr0_offset())));
+    __ andl(rax, 0xE0);
+    __ cmpl(rax, 0xE0);
+    __ jcc(Assembler::notEqual, legacy_save_restore);
+    __ movl(rax, Address(rbp, in_bytes(VM_Version::sef_cpuid7_offset()) + 4));
+    __ testl(rax, 0x10000);
+    __ jcc(Assembler::zero, legacy_save_restore);
+
+    VM_Version::set_evex_cpuFeatures(); // Enable temporary to pass asserts
+    UseAVX = 3;
+    __ lea(rsi, Address(rbp, in_bytes(VM_Version::zmm_save_offset())));
+    __ evmovdqul(Address(rsi,   0), xmm0, Assembler::AVX_512bit);
+    __ evmovdqul(Address(rsi,  64), xmm7, Assembler::AVX_512bit);
+#ifdef _LP64
+    __ evmovdqul(Address(rsi, 128), xmm8, Assembler::AVX_512bit);
+    __ evmovdqul(Address(rsi, 192), xmm31, Assembler::AVX_512bit);
+#endif
+
+    __ bind(legacy_save_restore);
     VM_Version::clean_cpuFeatures();
     UseAVX = saved_useavx;
     UseSSE = saved_usesse;
@@ -481,6 +540,19 @@ void VM_Version::get_processor_features() {
   if (UseSSE < 1)
     _cpuFeatures &= ~CPU_SSE;
 
+#ifndef _LP64
+  // The 32-bit VM does not generate EVEX encoded code.
+  if (UseAVX > 2) UseAVX=2;
+#endif
+
+  if (UseAVX < 3) {
+    _cpuFeatures &= ~CPU_AVX512F;
+    _cpuFeatures &= ~CPU_AVX512DQ;
+    _cpuFeatures &= ~CPU_AVX512CD;
+    _cpuFeatures &= ~CPU_AVX512BW;
+    _cpuFeatures &= ~CPU_AVX512VL;
+  }
+
   if (UseAVX < 2)
     _cpuFeatures &= ~CPU_AVX2;
 
@@ -495,8 +567,8 @@ void VM_Version::get_processor_features() {
     _cpuFeatures &= ~CPU_HT;
   }
 
-  char buf[256];
-  jio_snprintf(buf, sizeof(buf), "(%u cores per cpu, %u threads per core) family %d model %d stepping %d%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
+  char buf[512];
+  jio_snprintf(buf, sizeof(buf), "(%u cores per cpu, %u threads per core) family %d model %d stepping %d%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
                cores_per_cpu(), threads_per_core(),
                cpu_family(), _model, _stepping,
                (supports_cmov() ? ", cmov" : ""),
@@ -512,6 +584,11 @@ void VM_Version::get_processor_features() {
                (supports_popcnt() ? ", popcnt" : ""),
                (supports_avx()    ? ", avx" : ""),
                (supports_avx2()   ? ", avx2" : ""),
+               (supports_evex()   ? ", avx512f" : ""),
+               (supports_avx512cd() ? ", avx512cd" : ""),
+               (supports_avx512dq() ? ", avx512dq" : ""),
+               (supports_avx512bw() ? ", avx512bw" : ""),
+               (supports_avx512vl() ? ", avx512vl" : ""),
                (supports_aes()    ? ", aes" : ""),
                (supports_clmul()  ? ", clmul" : ""),
                (supports_erms()   ? ", erms" : ""),
@@ -543,8 +620,10 @@ void VM_Version::get_processor_features() {
   if (!supports_sse ()) // Drop to 0 if no SSE  support
     UseSSE = 0;
 
-  if (UseAVX > 2) UseAVX=2;
+  if (UseAVX > 3) UseAVX=3;
   if (UseAVX < 0) UseAVX=0;
+  if (!supports_evex()) // Drop to 2 if no AVX-512 support
+    UseAVX = MIN2((intx)2,UseAVX);
   if (!supports_avx2()) // Drop to 1 if no AVX2 support
     UseAVX = MIN2((intx)1,UseAVX);
   if (!supports_avx ()) // Drop to 0 if no AVX  support
@@ -606,6 +685,26 @@ void VM_Version::get_processor_features() {
     FLAG_SET_DEFAULT(UseCRC32Intrinsics, false);
   }
 
+  // String.hashCode() is vectorized with AVX2 and AVX-512, the other
+  // String stubs reuse the string code of C2.
+  if (UseAVX >= 2 && os_supports_avx_vectors()) {
+    if (FLAG_IS_DEFAULT(UseStringIntrinsicStubs)) {
+      UseStringIntrinsicStubs = true;
+    }
+  }
+
+#ifdef _LP64
+  if (FLAG_IS_DEFAULT(UseVectorizedMismatchIntrinsic)) {
+    UseVectorizedMismatchIntrinsic = true;
+  }
+#else
+  if (UseVectorizedMismatchIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedMismatchIntrinsic))
+      warning("vectorizedMismatch intrinsic is not available on this platform");
+    FLAG_SET_DEFAULT(UseVectorizedMismatchIntrinsic, false);
+  }
+#endif
+
   // GHASH/GCM intrinsics
   if (UseCLMUL && (UseSSE > 2)) {
     if (FLAG_IS_DEFAULT(UseGHASHIntrinsics)) {
@@ -693,12 +792,20 @@ void VM_Version::get_processor_features() {
       FLAG_SET_DEFAULT(UseFPUForSpilling, false);
     }
   }
+  if (UseAVX > 2 && FLAG_IS_DEFAULT(MaxVectorSize)) {
+    // Use the full width of the ZMM registers
+    FLAG_SET_DEFAULT(MaxVectorSize, 64);
+  }
   if (MaxVectorSize > 0) {
     if (!is_power_of_2(MaxVectorSize)) {
       warning("MaxVectorSize must be a power of 2");
-      FLAG_SET_DEFAULT(MaxVectorSize, 32);
+      FLAG_SET_DEFAULT(MaxVectorSize, 64);
+    }
+    if (MaxVectorSize > 64) {
+      FLAG_SET_DEFAULT(MaxVectorSize, 64);
     }
-    if (MaxVectorSize > 32) {
+    if (MaxVectorSize > 32 && (UseAVX < 3 || !os_supports_avx_vectors())) {
+      // 64 bytes vectors (in ZMM) are only supported with AVX-512
       FLAG_SET_DEFAULT(MaxVectorSize, 32);
     }
     if (MaxVectorSize > 16 && (UseAVX == 0 || !os_supports_avx_vectors())) {
@@ -721,6 +828,17 @@ void VM_Version::get_processor_features() {
         }
         tty->cr();
       }
+      if (supports_evex()) {
+        tty->print_cr("State of ZMM registers after signal handle:");
+        const char* zmm_name[4] = {"0", "7", "8", "31"};
+        for (int i = 0; i < nreg; i++) {
+          tty->print("ZMM%s:", zmm_name[i]);
+          for (int j = 15; j >=0; j--) {
+            tty->print(" %x", _cpuid_info.zmm_save[i*16 + j]);
+          }
+          tty->cr();
+        }
+      }
     }
 #endif
   }
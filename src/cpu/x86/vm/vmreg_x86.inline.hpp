@@ -39,7 +39,7 @@ inline VMReg FloatRegisterImpl::as_VMReg() {
 }
 
 inline VMReg XMMRegisterImpl::as_VMReg() {
-  return VMRegImpl::as_VMReg((encoding() << 3) + ConcreteRegisterImpl::max_fpr);
+  return VMRegImpl::as_VMReg((encoding() * XMMRegisterImpl::max_slots_per_register) + ConcreteRegisterImpl::max_fpr);
 }
 
 
@@ -75,7 +75,7 @@ inline FloatRegister VMRegImpl::as_FloatRegister() {
 inline XMMRegister VMRegImpl::as_XMMRegister() {
   assert( is_XMMRegister() && is_even(value()), "must be" );
   // Yuk
-  return ::as_XMMRegister((value() - ConcreteRegisterImpl::max_fpr) >> 3);
+  return ::as_XMMRegister((value() - ConcreteRegisterImpl::max_fpr) / XMMRegisterImpl::max_slots_per_register);
 }
 
 inline   bool VMRegImpl::is_concrete() {
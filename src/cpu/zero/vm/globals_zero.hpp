@@ -55,6 +55,8 @@ define_pd_global(bool,  RewriteFrequentPairs, true);
 
 define_pd_global(bool,  UseMembar,            true);
 
+define_pd_global(bool, ThreadLocalHandshakes, false);
+
 // GC Ergo Flags
 define_pd_global(uintx, CMSYoungGenPerWorker, 16*M);  // default max size of CMS young gen, per GC worker thread
 
@@ -36,6 +36,7 @@
 #include "interpreter/bytecode.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/compilationPolicy.hpp"
+#include "runtime/stubRoutines.hpp"
 #include "utilities/bitMap.inline.hpp"
 
 class BlockListBuilder VALUE_OBJ_CLASS_SPEC {
@@ -3644,6 +3645,19 @@ bool GraphBuilder::try_inline_intrinsics(ciMethod* callee) {
       preserves_state = true;
       break;
 
+    case vmIntrinsics::_stringHashCode:
+      if (StubRoutines::stringHashCode() == NULL) return false;
+      preserves_state = true;
+      break;
+    case vmIntrinsics::_equals:
+      if (StubRoutines::stringEquals() == NULL) return false;
+      preserves_state = true;
+      break;
+    case vmIntrinsics::_compareTo:
+      if (StubRoutines::stringCompareTo() == NULL) return false;
+      preserves_state = true;
+      break;
+
     case vmIntrinsics::_loadFence :
     case vmIntrinsics::_storeFence:
     case vmIntrinsics::_fullFence :
@@ -3180,6 +3180,12 @@ void LIRGenerator::do_Intrinsic(Intrinsic* x) {
     do_update_CRC32(x);
     break;
 
+  case vmIntrinsics::_stringHashCode:
+  case vmIntrinsics::_equals:
+  case vmIntrinsics::_compareTo:
+    do_String_intrinsic(x);
+    break;
+
   default: ShouldNotReachHere(); break;
   }
 }
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classFileStream.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "classfile/classLoaderExt.hpp"
+#include "classfile/sharedPathsMiscInfo.hpp"
+#include "memory/filemap.hpp"
+#include "memory/metadataFactory.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+int ClassLoaderExt::_ext_class_paths_start = max_jint;
+int ClassLoaderExt::_app_class_paths_start = max_jint;
+
+// Appends the jar and zip files of the extension directories to the given
+// stream, in the order sun.misc.Launcher$ExtClassLoader lists them.
+static void add_ext_jars(stringStream* st, const char* ext_dirs) {
+  const char separator = os::path_separator()[0];
+  const char file_separator = *os::file_separator();
+  const char* dir_start = ext_dirs;
+  while (*dir_start != '\0') {
+    const char* dir_end = strchr(dir_start, separator);
+    size_t dir_len = (dir_end == NULL) ? strlen(dir_start) : (size_t)(dir_end - dir_start);
+    char* dir_name = NEW_RESOURCE_ARRAY(char, dir_len + 1);
+    strncpy(dir_name, dir_start, dir_len);
+    dir_name[dir_len] = '\0';
+
+    DIR* dir = (dir_len == 0) ? NULL : os::opendir(dir_name);
+    if (dir != NULL) {
+      struct dirent* entry;
+      while ((entry = os::readdir(dir)) != NULL) {
+        const char* name = entry->d_name;
+        const char* ext = name + strlen(name) - 4;
+        if (ext > name &&
+            (os::file_name_strcmp(ext, ".jar") == 0 ||
+             os::file_name_strcmp(ext, ".zip") == 0)) {
+          if (st->size() > 0) {
+            st->put(separator);
+          }
+          st->print_raw(dir_name);
+          if (dir_name[dir_len - 1] != file_separator) {
+            st->put(file_separator);
+          }
+          st->print_raw(name);
+        }
+      }
+      os::closedir(dir);
+    }
+
+    if (dir_end == NULL) {
+      break;
+    }
+    dir_start = dir_end + 1;
+  }
+}
+
+void ClassLoaderExt::setup_search_paths() {
+  if (!UseAppCDS) {
+    return;
+  }
+  ResourceMark rm;
+
+  // The extension loader is the parent of the application loader, so its
+  // jars come first: a class found in both is archived from the extension
+  // class path, just as it would be loaded at run time.
+  const char* ext_dirs = Arguments::get_ext_dirs();
+  if (ext_dirs == NULL) {
+    ext_dirs = "";
+  }
+  _shared_paths_misc_info->add_ext_dirs(ext_dirs);
+  _ext_class_paths_start = num_classpath_entries();
+  stringStream ext_jars;
+  add_ext_jars(&ext_jars, ext_dirs);
+  if (ext_jars.size() > 0) {
+    trace_class_path(tty, "[Extension loader class path=", ext_jars.as_string());
+    setup_search_path(ext_jars.as_string());
+  }
+
+  const char* app_class_path = Arguments::get_appclasspath();
+  if (app_class_path == NULL) {
+    app_class_path = "";
+  }
+  _shared_paths_misc_info->add_app_classpath(app_class_path);
+  _app_class_paths_start = num_classpath_entries();
+  if (app_class_path[0] != '\0') {
+    trace_class_path(tty, "[Application loader class path=", app_class_path);
+    setup_search_path(app_class_path);
+  }
+}
+
+// Returns true if the manifest has a main or per-entry attribute whose
+// name, ignoring case, is the given name or, if suffix is set, ends with it.
+static bool has_manifest_attribute(const char* manifest, const char* name, bool suffix) {
+  size_t name_len = strlen(name);
+  const char* line = manifest;
+  while (*line != '\0') {
+    const char* end = line + strcspn(line, "\r\n");
+    // Continuation lines start with a space.
+    const char* colon = (*line == ' ') ? NULL : (const char*)memchr(line, ':', end - line);
+    if (colon != NULL) {
+      size_t len = colon - line;
+      if (len == name_len || (suffix && len > name_len)) {
+        if (strncasecmp(colon - name_len, name, name_len) == 0) {
+          return true;
+        }
+      }
+    }
+    line = end + strspn(end, "\r\n");
+  }
+  return false;
+}
+
+void ClassLoaderExt::process_jar_manifest(ClassPathEntry* cpe, SharedClassPathEntry* ent, TRAPS) {
+  ResourceMark rm(THREAD);
+  ClassFileStream* stream = cpe->open_stream("META-INF/MANIFEST.MF", CHECK);
+  if (stream == NULL || stream->length() == 0) {
+    return;
+  }
+  int size = stream->length();
+  char* manifest = NEW_RESOURCE_ARRAY(char, size + 1);
+  memcpy(manifest, stream->buffer(), size);
+  manifest[size] = '\0';
+
+  if (has_manifest_attribute(manifest, "Class-Path", false)) {
+    // The class loaders would search the referenced jars right after this
+    // one, which the archive cannot reproduce.
+    ClassLoader::exit_with_path_failure("Class-Path attribute in the manifest is not supported with UseAppCDS",
+                                        cpe->name());
+  }
+  if (has_manifest_attribute(manifest, "-Digest", true)) {
+    // Only signed jars carry per-entry digests in their manifest.
+    ent->_is_signed = true;
+    if (TraceClassPaths) {
+      tty->print_cr("[Signed JAR file %s is not archived]", cpe->name());
+    }
+    return;
+  }
+
+  ClassLoaderData* loader_data = ClassLoaderData::the_null_class_loader_data();
+  Array<u1>* buf = MetadataFactory::new_array<u1>(loader_data, size, CHECK);
+  memcpy(buf->adr_at(0), stream->buffer(), size);
+  ent->_manifest = buf;
+}
@@ -26,27 +26,60 @@
 #define SHARE_VM_CLASSFILE_CLASSLOADEREXT_HPP
 
 #include "classfile/classLoader.hpp"
+#include "memory/filemap.hpp"
 
 class ClassLoaderExt: public ClassLoader { // AllStatic
+  // With UseAppCDS the extension and the application class paths are
+  // appended to the boot class path while dumping, so that their classes
+  // are loaded by ClassLoader::load_classfile(). Shared class path indices
+  // from _ext_class_paths_start on belong to the extension class path, and
+  // those from _app_class_paths_start on to the application class path. At
+  // run time both are restored from the archive header.
+  static int _ext_class_paths_start;
+  static int _app_class_paths_start;
+
 public:
 
   class Context {
+    const char* _class_name;
     const char* _file_name;
   public:
     Context(const char* class_name, const char* file_name, TRAPS) {
+      _class_name = class_name;
       _file_name = file_name;
     }
 
     bool check(ClassFileStream* stream, const int classpath_index) {
+#if INCLUDE_CDS
+      if (stream != NULL && DumpSharedSpaces &&
+          !is_boot_class_path_index(classpath_index) &&
+          classpath_index < FileMapInfo::get_number_of_share_classpaths() &&
+          FileMapInfo::shared_classpath(classpath_index)->is_signed()) {
+        // The code source of a signed class cannot be recreated from the
+        // archive, so it is left to its class loader at run time.
+        tty->print_cr("Preload Warning: Skipping %s from signed JAR file %s",
+                      _class_name, FileMapInfo::shared_classpath_name(classpath_index));
+        return false;
+      }
+#endif
       return true;
     }
 
     bool should_verify(int classpath_index) {
-      return false;
+      // The extension and application classes are verified as if their
+      // own class loaders had loaded them.
+      return !is_boot_class_path_index(classpath_index) && BytecodeVerificationRemote;
     }
 
     instanceKlassHandle record_result(const int classpath_index,
                                       ClassPathEntry* e, instanceKlassHandle result, TRAPS) {
+      if (!is_boot_class_path_index(classpath_index)) {
+        // The packages of the extension and application classes are defined
+        // by their own class loaders when the classes are loaded at run time.
+        assert(DumpSharedSpaces, "only while dumping");
+        result->set_shared_classpath_index(classpath_index);
+        return result;
+      }
       if (ClassLoader::add_package(_file_name, classpath_index, THREAD)) {
         if (DumpSharedSpaces) {
           result->set_shared_classpath_index(classpath_index);
@@ -58,6 +91,27 @@ public:
     }
   };
 
+  static int ext_class_paths_start() { return _ext_class_paths_start; }
+  static int app_class_paths_start() { return _app_class_paths_start; }
+  static void set_class_paths_start(int ext_start, int app_start) {
+    _ext_class_paths_start = ext_start;
+    _app_class_paths_start = app_start;
+  }
+
+  static bool is_boot_class_path_index(int index) {
+    CDS_ONLY(return index < _ext_class_paths_start;)
+    NOT_CDS(return true;)
+  }
+  static bool is_ext_class_path_index(int index) {
+    return index >= _ext_class_paths_start && index < _app_class_paths_start;
+  }
+  static bool is_app_class_path_index(int index) {
+    return index >= _app_class_paths_start;
+  }
+
+  // Records the manifest of an extension or application jar in its shared
+  // class path entry, and whether the jar is signed.
+  static void process_jar_manifest(ClassPathEntry* cpe, SharedClassPathEntry* ent, TRAPS) NOT_CDS_RETURN;
 
   static void add_class_path_entry(const char* path, bool check_for_duplicates,
                                    ClassPathEntry* new_entry) {
@@ -66,7 +120,7 @@ public:
   static void append_boot_classpath(ClassPathEntry* new_entry) {
     ClassLoader::add_to_list(new_entry);
   }
-  static void setup_search_paths() {}
+  static void setup_search_paths() NOT_CDS_RETURN;
 
   static void init_lookup_cache(TRAPS) {}
   static void copy_lookup_cache_to_archive(char** top, char* end) {}
@@ -415,6 +415,16 @@ Klass* Dictionary::find_shared_class(int index, unsigned int hash,
   return (entry != NULL) ? entry->klass() : (Klass*)NULL;
 }
 
+// Variant of find_shared_class returning the entry. While dumping it also
+// finds the classes loaded by the null class loader in the main dictionary.
+
+DictionaryEntry* Dictionary::find_shared_entry(int index, unsigned int hash,
+                                               Symbol* name) {
+  assert (index == index_for(name, NULL), "incorrect index?");
+
+  return get_entry(index, hash, name, NULL);
+}
+
 
 void Dictionary::add_protection_domain(int index, unsigned int hash,
                                        instanceKlassHandle klass,
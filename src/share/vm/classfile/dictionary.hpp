@@ -85,6 +85,7 @@ public:
                       Symbol* name, ClassLoaderData* loader_data);
 
   Klass* find_shared_class(int index, unsigned int hash, Symbol* name);
+  DictionaryEntry* find_shared_entry(int index, unsigned int hash, Symbol* name);
 
   // Compiler support
   Klass* try_get_next_class();
@@ -25,6 +25,7 @@
 #ifndef SHARE_VM_CLASSFILE_SHAREDCLASSUTIL_HPP
 #define SHARE_VM_CLASSFILE_SHAREDCLASSUTIL_HPP
 
+#include "classfile/classLoaderExt.hpp"
 #include "classfile/sharedPathsMiscInfo.hpp"
 #include "memory/filemap.hpp"
 
@@ -52,17 +53,34 @@ public:
   }
 
   static void update_shared_classpath(ClassPathEntry *cpe,
+                                      int index,
                                       SharedClassPathEntry* ent,
                                       time_t timestamp,
                                       long filesize, TRAPS) {
     ent->_timestamp = timestamp;
     ent->_filesize  = filesize;
+    ent->_manifest  = NULL;
+    ent->_is_signed = false;
+    if (!ClassLoaderExt::is_boot_class_path_index(index)) {
+      ClassLoaderExt::process_jar_manifest(cpe, ent, THREAD);
+    }
   }
 
   static void initialize(TRAPS) {}
 
   inline static bool is_shared_boot_class(Klass* klass) {
-    return (klass->_shared_class_path_index >= 0);
+    return (klass->_shared_class_path_index >= 0 &&
+            ClassLoaderExt::is_boot_class_path_index(klass->_shared_class_path_index));
+  }
+
+  inline static bool is_shared_ext_class(Klass* klass) {
+    return (klass->_shared_class_path_index >= 0 &&
+            ClassLoaderExt::is_ext_class_path_index(klass->_shared_class_path_index));
+  }
+
+  inline static bool is_shared_app_class(Klass* klass) {
+    return (klass->_shared_class_path_index >= 0 &&
+            ClassLoaderExt::is_app_class_path_index(klass->_shared_class_path_index));
   }
 };
 
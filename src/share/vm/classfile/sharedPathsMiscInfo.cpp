@@ -114,6 +114,24 @@ bool SharedPathsMiscInfo::check(jint type, const char* path) {
       return fail("[BOOT classpath mismatch, actual: -Dsun.boot.class.path=", Arguments::get_sysclasspath());
     }
     break;
+  case EXT:
+    // The archived extension and application classes are only used with
+    // UseAppCDS, the boot classes of the archive do not depend on them.
+    if (UseAppCDS && strcmp(path, Arguments::get_ext_dirs()) != 0) {
+      return fail("[EXT dirs mismatch, actual: -Djava.ext.dirs=", Arguments::get_ext_dirs());
+    }
+    break;
+  case APP:
+    if (UseAppCDS) {
+      const char* app_class_path = Arguments::get_appclasspath();
+      size_t len = strlen(path);
+      if (app_class_path == NULL || strncmp(path, app_class_path, len) != 0 ||
+          (len > 0 && app_class_path[len] != '\0' &&
+           app_class_path[len] != os::path_separator()[0])) {
+        return fail("[APP classpath mismatch, actual: -Djava.class.path=", app_class_path);
+      }
+    }
+    break;
   case NON_EXIST: // fall-through
   case REQUIRED:
     {
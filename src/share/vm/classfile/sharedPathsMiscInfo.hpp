@@ -33,6 +33,9 @@
 //
 // + The values of Arguments::get_sysclasspath() used during dumping.
 //
+// + With UseAppCDS, the extension directories and the application class path
+//   used during dumping.
+//
 // + The meta-index file(s) used during dumping (incl modification time and size)
 //
 // + The class path elements specified during dumping but did not exist --
@@ -123,6 +126,16 @@ public:
   void add_boot_classpath(const char* path) {
     add_path(path, BOOT);
   }
+
+  // The extension directories must be the same at run time
+  void add_ext_dirs(const char* path) {
+    add_path(path, EXT);
+  }
+
+  // The application class path at run time must start with this path
+  void add_app_classpath(const char* path) {
+    add_path(path, APP);
+  }
   int write_jint(jint num) {
     write(&num, sizeof(num));
     return 0;
@@ -144,7 +157,9 @@ public:
   enum {
     BOOT      = 1,
     NON_EXIST = 2,
-    REQUIRED  = 3
+    REQUIRED  = 3,
+    EXT       = 4,
+    APP       = 5
   };
 
   virtual const char* type_name(int type) {
@@ -152,6 +167,8 @@ public:
     case BOOT:      return "BOOT";
     case NON_EXIST: return "NON_EXIST";
     case REQUIRED:  return "REQUIRED";
+    case EXT:       return "EXT";
+    case APP:       return "APP";
     default:        ShouldNotReachHere(); return "?";
     }
   }
@@ -167,6 +184,12 @@ public:
     case REQUIRED:
       out->print("Expecting that file %s must exist and is not altered", path);
       break;
+    case EXT:
+      out->print("Expecting -Djava.ext.dirs=%s", path);
+      break;
+    case APP:
+      out->print("Expecting -Djava.class.path=%s", path);
+      break;
     default:
       ShouldNotReachHere();
     }
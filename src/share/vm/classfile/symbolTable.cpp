@@ -31,11 +31,14 @@
 #include "memory/allocation.inline.hpp"
 #include "memory/filemap.hpp"
 #include "memory/gcLocker.inline.hpp"
+#include "memory/metaspaceShared.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/oop.inline2.hpp"
+#include "runtime/interfaceSupport.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "utilities/hashtable.inline.hpp"
 #if INCLUDE_ALL_GCS
+#include "gc_implementation/g1/g1CollectedHeap.hpp"
 #include "gc_implementation/g1/g1SATBCardTableModRefBS.hpp"
 #include "gc_implementation/g1/g1StringDedup.hpp"
 #endif
@@ -47,10 +50,15 @@ PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 // the number of buckets a thread claims
 const int ClaimChunkSize = 32;
 
+// the number of buckets the service thread processes before it checks
+// for a safepoint
+const int ConcurrentChunkSize = 128;
+
 SymbolTable* SymbolTable::_the_table = NULL;
 // Static arena for symbols that are not deallocated
 Arena* SymbolTable::_arena = NULL;
 bool SymbolTable::_needs_rehashing = false;
+volatile bool SymbolTable::_has_work = false;
 
 Symbol* SymbolTable::allocate_symbol(const u1* name, int len, bool c_heap, TRAPS) {
   assert (len <= Symbol::max_length(), "should be checked by caller");
@@ -82,9 +90,9 @@ void SymbolTable::initialize_symbols(int arena_alloc_size) {
 
 // Call function for all symbols in the symbol table.
 void SymbolTable::symbols_do(SymbolClosure *cl) {
-  const int n = the_table()->table_size();
+  const int n = the_table()->live_bucket_count();
   for (int i = 0; i < n; i++) {
-    for (HashtableEntry<Symbol*, mtSymbol>* p = the_table()->bucket(i);
+    for (HashtableEntry<Symbol*, mtSymbol>* p = the_table()->live_bucket(i);
          p != NULL;
          p = p->next()) {
       cl->do_symbol(p->literal_addr());
@@ -98,8 +106,8 @@ volatile int SymbolTable::_parallel_claimed_idx = 0;
 
 void SymbolTable::buckets_unlink(int start_idx, int end_idx, BucketUnlinkContext* context, size_t* memory_total) {
   for (int i = start_idx; i < end_idx; ++i) {
-    HashtableEntry<Symbol*, mtSymbol>** p = the_table()->bucket_addr(i);
-    HashtableEntry<Symbol*, mtSymbol>* entry = the_table()->bucket(i);
+    HashtableEntry<Symbol*, mtSymbol>** p = the_table()->live_bucket_addr(i);
+    HashtableEntry<Symbol*, mtSymbol>* entry = *p;
     while (entry != NULL) {
       // Shared entries are normally at the end of the bucket and if we run into
       // a shared entry, then there is nothing more to remove. However, if we
@@ -132,7 +140,7 @@ void SymbolTable::buckets_unlink(int start_idx, int end_idx, BucketUnlinkContext
 void SymbolTable::unlink(int* processed, int* removed) {
   size_t memory_total = 0;
   BucketUnlinkContext context;
-  buckets_unlink(0, the_table()->table_size(), &context, &memory_total);
+  buckets_unlink(0, the_table()->live_bucket_count(), &context, &memory_total);
   _the_table->bulk_free_entries(&context);
   *processed = context._num_processed;
   *removed = context._num_removed;
@@ -148,7 +156,7 @@ void SymbolTable::unlink(int* processed, int* removed) {
 }
 
 void SymbolTable::possibly_parallel_unlink(int* processed, int* removed) {
-  const int limit = the_table()->table_size();
+  const int limit = the_table()->live_bucket_count();
 
   size_t memory_total = 0;
 
@@ -185,8 +193,11 @@ void SymbolTable::rehash_table() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   // This should never happen with -Xshare:dump but it might in testing mode.
   if (DumpSharedSpaces) return;
+  // Wait until the service thread has finished growing the table and the
+  // old entries have been freed.
+  if (the_table()->is_growing() || the_table()->has_retired()) return;
   // Create a new symbol table
-  SymbolTable* new_table = new SymbolTable();
+  SymbolTable* new_table = new SymbolTable(the_table()->table_size());
 
   the_table()->move_to(new_table);
 
@@ -207,9 +218,9 @@ Symbol* SymbolTable::lookup(int index, const char* name,
     count++;  // count all entries in this bucket, not just ones with same hash
     if (e->hash() == hash) {
       Symbol* sym = e->literal();
-      if (sym->equals(name, len)) {
-        // something is referencing this symbol now.
-        sym->increment_refcount();
+      // something is referencing this symbol now, unless the service
+      // thread is removing it.
+      if (sym->equals(name, len) && sym->try_increment_refcount()) {
         return sym;
       }
     }
@@ -232,15 +243,13 @@ unsigned int SymbolTable::hash_symbol(const char* s, int len) {
 // We take care not to be blocking while holding the
 // SymbolTable_lock. Otherwise, the system might deadlock, since the
 // symboltable is used during compilation (VM_thread) The lock free
-// synchronization is simplified by the fact that we do not delete
-// entries in the symbol table during normal execution (only during
-// safepoints).
+// synchronization is simplified by the fact that entries removed
+// during normal execution are only freed at the next safepoint.
 
 Symbol* SymbolTable::lookup(const char* name, int len, TRAPS) {
   unsigned int hashValue = hash_symbol(name, len);
-  int index = the_table()->hash_to_index(hashValue);
-
-  Symbol* s = the_table()->lookup(index, name, len, hashValue);
+  int index;
+  Symbol* s = table_for_hash(hashValue, &index)->lookup(index, name, len, hashValue);
 
   // Found
   if (s != NULL) return s;
@@ -249,7 +258,7 @@ Symbol* SymbolTable::lookup(const char* name, int len, TRAPS) {
   MutexLocker ml(SymbolTable_lock, THREAD);
 
   // Otherwise, add to symbol to table
-  return the_table()->basic_add(index, (u1*)name, len, hashValue, true, CHECK_NULL);
+  return the_table()->basic_add((u1*)name, len, hashValue, true, CHECK_NULL);
 }
 
 Symbol* SymbolTable::lookup(const Symbol* sym, int begin, int end, TRAPS) {
@@ -263,8 +272,7 @@ Symbol* SymbolTable::lookup(const Symbol* sym, int begin, int end, TRAPS) {
     name = (char*)sym->base() + begin;
     len = end - begin;
     hashValue = hash_symbol(name, len);
-    index = the_table()->hash_to_index(hashValue);
-    Symbol* s = the_table()->lookup(index, name, len, hashValue);
+    Symbol* s = table_for_hash(hashValue, &index)->lookup(index, name, len, hashValue);
 
     // Found
     if (s != NULL) return s;
@@ -288,15 +296,14 @@ Symbol* SymbolTable::lookup(const Symbol* sym, int begin, int end, TRAPS) {
   // Grab SymbolTable_lock first.
   MutexLocker ml(SymbolTable_lock, THREAD);
 
-  return the_table()->basic_add(index, (u1*)buffer, len, hashValue, true, CHECK_NULL);
+  return the_table()->basic_add((u1*)buffer, len, hashValue, true, CHECK_NULL);
 }
 
 Symbol* SymbolTable::lookup_only(const char* name, int len,
                                    unsigned int& hash) {
   hash = hash_symbol(name, len);
-  int index = the_table()->hash_to_index(hash);
-
-  Symbol* s = the_table()->lookup(index, name, len, hash);
+  int index;
+  Symbol* s = table_for_hash(hash, &index)->lookup(index, name, len, hash);
   return s;
 }
 
@@ -305,9 +312,10 @@ Symbol* SymbolTable::lookup_only(const char* name, int len,
 // Do not increment the reference count to keep this alive
 Symbol** SymbolTable::lookup_symbol_addr(Symbol* sym){
   unsigned int hash = hash_symbol((char*)sym->bytes(), sym->utf8_length());
-  int index = the_table()->hash_to_index(hash);
+  int index;
+  SymbolTable* table = table_for_hash(hash, &index);
 
-  for (HashtableEntry<Symbol*, mtSymbol>* e = the_table()->bucket(index); e != NULL; e = e->next()) {
+  for (HashtableEntry<Symbol*, mtSymbol>* e = table->bucket(index); e != NULL; e = e->next()) {
     if (e->hash() == hash) {
       Symbol* literal_sym = e->literal();
       if (sym == literal_sym) {
@@ -365,9 +373,8 @@ void SymbolTable::add(ClassLoaderData* loader_data, constantPoolHandle cp,
   if (!added) {
     // do it the hard way
     for (int i=0; i<names_count; i++) {
-      int index = table->hash_to_index(hashValues[i]);
       bool c_heap = !loader_data->is_the_null_class_loader_data();
-      Symbol* sym = table->basic_add(index, (u1*)names[i], lengths[i], hashValues[i], c_heap, CHECK);
+      Symbol* sym = table->basic_add((u1*)names[i], lengths[i], hashValues[i], c_heap, CHECK);
       cp->symbol_at_put(cp_indices[i], sym);
     }
   }
@@ -383,11 +390,10 @@ Symbol* SymbolTable::new_permanent_symbol(const char* name, TRAPS) {
   MutexLocker ml(SymbolTable_lock, THREAD);
 
   SymbolTable* table = the_table();
-  int index = table->hash_to_index(hash);
-  return table->basic_add(index, (u1*)name, (int)strlen(name), hash, false, THREAD);
+  return table->basic_add((u1*)name, (int)strlen(name), hash, false, THREAD);
 }
 
-Symbol* SymbolTable::basic_add(int index_arg, u1 *name, int len,
+Symbol* SymbolTable::basic_add(u1 *name, int len,
                                unsigned int hashValue_arg, bool c_heap, TRAPS) {
   assert(!Universe::heap()->is_in_reserved(name),
          "proposed name of symbol must be stable");
@@ -402,20 +408,20 @@ Symbol* SymbolTable::basic_add(int index_arg, u1 *name, int len,
   No_Safepoint_Verifier nsv;
 
   // Check if the symbol table has been rehashed, if so, need to recalculate
-  // the hash value and index.
+  // the hash value.
   unsigned int hashValue;
-  int index;
   if (use_alternate_hashcode()) {
     hashValue = hash_symbol((const char*)name, len);
-    index = hash_to_index(hashValue);
   } else {
     hashValue = hashValue_arg;
-    index = index_arg;
   }
+  // The bucket may have been copied to a grown table since the lookup.
+  int index;
+  SymbolTable* table = (SymbolTable*)table_for(hashValue, &index);
 
   // Since look-up was done lock-free, we need to check if another
   // thread beat us in the race to insert the symbol.
-  Symbol* test = lookup(index, (char*)name, len, hashValue);
+  Symbol* test = table->lookup(index, (char*)name, len, hashValue);
   if (test != NULL) {
     // A race occurred and another thread introduced the symbol.
     assert(test->refcount() != 0, "lookup should have incremented the count");
@@ -426,8 +432,9 @@ Symbol* SymbolTable::basic_add(int index_arg, u1 *name, int len,
   Symbol* sym = allocate_symbol(name, len, c_heap, CHECK_NULL);
   assert(sym->equals((char*)name, len), "symbol must be properly initialized");
 
-  HashtableEntry<Symbol*, mtSymbol>* entry = new_entry(hashValue, sym);
-  add_entry(index, entry);
+  HashtableEntry<Symbol*, mtSymbol>* entry = table->new_entry(hashValue, sym);
+  table->add_entry(index, entry);
+  check_concurrent_work();
   return sym;
 }
 
@@ -461,8 +468,9 @@ bool SymbolTable::basic_add(ClassLoaderData* loader_data, constantPoolHandle cp,
     }
     // Since look-up was done lock-free, we need to check if another
     // thread beat us in the race to insert the symbol.
-    int index = hash_to_index(hashValue);
-    Symbol* test = lookup(index, names[i], lengths[i], hashValue);
+    int index;
+    SymbolTable* table = (SymbolTable*)table_for(hashValue, &index);
+    Symbol* test = table->lookup(index, names[i], lengths[i], hashValue);
     if (test != NULL) {
       // A race occurred and another thread introduced the symbol, this one
       // will be dropped and collected. Use test instead.
@@ -474,24 +482,128 @@ bool SymbolTable::basic_add(ClassLoaderData* loader_data, constantPoolHandle cp,
       bool c_heap = !loader_data->is_the_null_class_loader_data();
       Symbol* sym = allocate_symbol((const u1*)names[i], lengths[i], c_heap, CHECK_(false));
       assert(sym->equals(names[i], lengths[i]), "symbol must be properly initialized");  // why wouldn't it be???
-      HashtableEntry<Symbol*, mtSymbol>* entry = new_entry(hashValue, sym);
-      add_entry(index, entry);
+      HashtableEntry<Symbol*, mtSymbol>* entry = table->new_entry(hashValue, sym);
+      table->add_entry(index, entry);
       cp->symbol_at_put(cp_indices[i], sym);
     }
   }
+  check_concurrent_work();
   return true;
 }
 
+// Wake up the service thread if the table should grow. Called with the
+// SymbolTable_lock held.
+void SymbolTable::check_concurrent_work() {
+  if (ConcurrentStringSymbolTableWork && !DumpSharedSpaces &&
+      !_has_work && the_table()->should_grow()) {
+    _has_work = true;
+    MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+    Service_lock->notify_all();
+  }
+}
+
+// Remove the symbols nobody refers to any more. Lookups do not take the
+// SymbolTable_lock, so a symbol is first marked dead, which keeps lookups
+// from taking a new reference, and is freed with its entry at the next
+// safepoint.
+void SymbolTable::remove_unreferenced_symbols(JavaThread* jt) {
+  int removed = 0;
+  int i = 0;
+  for (;;) {
+    {
+      MutexLocker ml(SymbolTable_lock, jt);
+      SymbolTable* table = the_table();
+      const int limit = table->live_bucket_count();
+      if (i >= limit) {
+        break;
+      }
+      const int end = MIN2(limit, i + ConcurrentChunkSize);
+      for (; i < end; i++) {
+        HashtableEntry<Symbol*, mtSymbol>** p = table->live_bucket_addr(i);
+        HashtableEntry<Symbol*, mtSymbol>* entry = *p;
+        while (entry != NULL) {
+          // See buckets_unlink().
+          if (entry->is_shared() && !use_alternate_hashcode()) {
+            break;
+          }
+          Symbol* s = entry->literal();
+          if (s->refcount() == 0 && s->try_mark_dead()) {
+            table->retire_entry(p, entry);
+            removed++;
+          } else {
+            p = entry->next_addr();
+          }
+          entry = (HashtableEntry<Symbol*, mtSymbol>*)HashtableEntry<Symbol*, mtSymbol>::make_ptr(*p);
+        }
+      }
+    }
+    if (SafepointSynchronize::do_call_back()) {
+      ThreadBlockInVM tbivm(jt);
+    }
+  }
+  Atomic::add(removed, &_symbols_removed);
+  if (PrintGCDetails && Verbose && WizardMode) {
+    gclog_or_tty->print_cr("[Symbols removed concurrently: %d]", removed);
+  }
+}
+
+void SymbolTable::grow(JavaThread* jt) {
+  {
+    MutexLocker ml(SymbolTable_lock, jt);
+    // Alternate hashing replaces the table at a safepoint, and the entries
+    // removed since then may not have been freed yet.
+    if (!the_table()->should_grow()) {
+      return;
+    }
+    the_table()->start_growing(new SymbolTable(the_table()->table_size() * 2));
+  }
+  for (;;) {
+    {
+      MutexLocker ml(SymbolTable_lock, jt);
+      if (!the_table()->copy_next_buckets(ConcurrentChunkSize)) {
+        OrderAccess::release_store_ptr(&_the_table, the_table()->finish_growing());
+        break;
+      }
+    }
+    if (SafepointSynchronize::do_call_back()) {
+      ThreadBlockInVM tbivm(jt);
+    }
+  }
+  if (PrintGCDetails && Verbose) {
+    gclog_or_tty->print_cr("[SymbolTable grown to %d buckets]", the_table()->table_size());
+  }
+}
+
+void SymbolTable::do_concurrent_work(JavaThread* jt) {
+  _has_work = false;
+  // Only grow if the table is still too full without the unreferenced
+  // symbols.
+  remove_unreferenced_symbols(jt);
+  grow(jt);
+}
+
+void SymbolTable::delete_dead_symbol(Symbol* sym) {
+  assert(sym->is_dead(), "only symbols removed by the service thread");
+  delete sym;
+}
+
+void SymbolTable::free_retired() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (the_table()->has_retired()) {
+    the_table()->purge_retired(delete_dead_symbol);
+  }
+}
+
 
 void SymbolTable::verify() {
-  for (int i = 0; i < the_table()->table_size(); ++i) {
-    HashtableEntry<Symbol*, mtSymbol>* p = the_table()->bucket(i);
+  for (int i = 0; i < the_table()->live_bucket_count(); ++i) {
+    HashtableEntry<Symbol*, mtSymbol>* p = the_table()->live_bucket(i);
     for ( ; p != NULL; p = p->next()) {
       Symbol* s = (Symbol*)(p->literal());
       guarantee(s != NULL, "symbol is NULL");
       unsigned int h = hash_symbol((char*)s->bytes(), s->utf8_length());
       guarantee(p->hash() == h, "broken hash in symbol table entry");
-      guarantee(the_table()->hash_to_index(h) == i,
+      guarantee(the_table()->is_live_bucket_for(i, h),
                 "wrong index in symbol table");
     }
   }
@@ -523,8 +635,8 @@ void SymbolTable::print_histogram() {
   int out_of_range = 0;
   int memory_total = 0;
   int count = 0;
-  for (i = 0; i < the_table()->table_size(); i++) {
-    HashtableEntry<Symbol*, mtSymbol>* p = the_table()->bucket(i);
+  for (i = 0; i < the_table()->live_bucket_count(); i++) {
+    HashtableEntry<Symbol*, mtSymbol>* p = the_table()->live_bucket(i);
     for ( ; p != NULL; p = p->next()) {
       memory_total += p->literal()->size();
       count++;
@@ -555,7 +667,7 @@ void SymbolTable::print_histogram() {
   tty->print_cr("%8s %5d", "Total  ", total);
   tty->print_cr("%8s %5d", "Maximum", max_symbols);
   tty->print_cr("%8s %3.2f", "Average",
-          ((float) total / (float) the_table()->table_size()));
+          ((float) total / (float) the_table()->live_bucket_count()));
   tty->print_cr("%s", "Histogram:");
   tty->print_cr(" %s %29s", "Length", "Number chains that length");
   for (i = 0; i < results_length; i++) {
@@ -584,9 +696,9 @@ void SymbolTable::print_histogram() {
 }
 
 void SymbolTable::print() {
-  for (int i = 0; i < the_table()->table_size(); ++i) {
-    HashtableEntry<Symbol*, mtSymbol>** p = the_table()->bucket_addr(i);
-    HashtableEntry<Symbol*, mtSymbol>* entry = the_table()->bucket(i);
+  for (int i = 0; i < the_table()->live_bucket_count(); ++i) {
+    HashtableEntry<Symbol*, mtSymbol>** p = the_table()->live_bucket_addr(i);
+    HashtableEntry<Symbol*, mtSymbol>* entry = *p;
     if (entry != NULL) {
       while (entry != NULL) {
         tty->print(PTR_FORMAT " ", entry->literal());
@@ -645,9 +757,14 @@ class StableMemoryChecker : public StackObj {
 StringTable* StringTable::_the_table = NULL;
 
 bool StringTable::_needs_rehashing = false;
+volatile bool StringTable::_has_work = false;
 
 volatile int StringTable::_parallel_claimed_idx = 0;
 
+juint  StringTable::_shared_bucket_count = 0;
+juint* StringTable::_shared_buckets = NULL;
+juint* StringTable::_shared_entries = NULL;
+
 // Pick hashing algorithm
 unsigned int StringTable::hash_string(const jchar* s, int len) {
   return use_alternate_hashcode() ? AltHashing::murmur3_32(seed(), s, len) :
@@ -673,7 +790,29 @@ oop StringTable::lookup(int index, jchar* name,
 }
 
 
-oop StringTable::basic_add(int index_arg, Handle string, jchar* name,
+// The shared table is hashed with java_lang_String::hash_code() even if the
+// table of the other strings has been rehashed.
+oop StringTable::lookup_shared(jchar* name, int len, unsigned int hash) {
+  if (_shared_bucket_count == 0) {
+    return NULL;
+  }
+  if (use_alternate_hashcode()) {
+    hash = java_lang_String::hash_code(name, len);
+  }
+  juint index = hash % _shared_bucket_count;
+  for (juint i = _shared_buckets[index]; i < _shared_buckets[index + 1]; i++) {
+    if (_shared_entries[2 * i] == hash) {
+      oop string = oopDesc::decode_heap_oop_not_null((narrowOop)_shared_entries[2 * i + 1]);
+      if (java_lang_String::equals(string, name, len)) {
+        return string;
+      }
+    }
+  }
+  return NULL;
+}
+
+
+oop StringTable::basic_add(Handle string, jchar* name,
                            int len, unsigned int hashValue_arg, TRAPS) {
 
   assert(java_lang_String::equals(string(), name, len),
@@ -682,31 +821,82 @@ oop StringTable::basic_add(int index_arg, Handle string, jchar* name,
   No_Safepoint_Verifier nsv;
 
   // Check if the symbol table has been rehashed, if so, need to recalculate
-  // the hash value and index before second lookup.
+  // the hash value before second lookup.
   unsigned int hashValue;
-  int index;
   if (use_alternate_hashcode()) {
     hashValue = hash_string(name, len);
-    index = hash_to_index(hashValue);
   } else {
     hashValue = hashValue_arg;
-    index = index_arg;
   }
+  // The bucket may have been copied to a grown table since the lookup.
+  int index;
+  StringTable* table = (StringTable*)table_for(hashValue, &index);
 
   // Since look-up was done lock-free, we need to check if another
   // thread beat us in the race to insert the symbol.
 
-  oop test = lookup(index, name, len, hashValue); // calls lookup(u1*, int)
+  oop test = table->lookup(index, name, len, hashValue); // calls lookup(u1*, int)
   if (test != NULL) {
     // Entry already added
     return test;
   }
 
-  HashtableEntry<oop, mtSymbol>* entry = new_entry(hashValue, string());
-  add_entry(index, entry);
+  HashtableEntry<oop, mtSymbol>* entry = table->new_entry(hashValue, string());
+  table->add_entry(index, entry);
+  check_concurrent_work();
   return string();
 }
 
+// Wake up the service thread if the table should grow. Called with the
+// StringTable_lock held.
+void StringTable::check_concurrent_work() {
+  if (ConcurrentStringSymbolTableWork && !DumpSharedSpaces &&
+      !_has_work && the_table()->should_grow()) {
+    _has_work = true;
+    MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+    Service_lock->notify_all();
+  }
+}
+
+// Interned strings are still removed by the garbage collector, since only
+// the collector knows which of them are reachable.
+void StringTable::grow(JavaThread* jt) {
+  {
+    MutexLocker ml(StringTable_lock, jt);
+    if (!the_table()->should_grow()) {
+      return;
+    }
+    the_table()->start_growing(new StringTable(the_table()->table_size() * 2));
+  }
+  for (;;) {
+    {
+      MutexLocker ml(StringTable_lock, jt);
+      if (!the_table()->copy_next_buckets(ConcurrentChunkSize)) {
+        OrderAccess::release_store_ptr(&_the_table, the_table()->finish_growing());
+        break;
+      }
+    }
+    if (SafepointSynchronize::do_call_back()) {
+      ThreadBlockInVM tbivm(jt);
+    }
+  }
+  if (PrintGCDetails && Verbose) {
+    gclog_or_tty->print_cr("[StringTable grown to %d buckets]", the_table()->table_size());
+  }
+}
+
+void StringTable::do_concurrent_work(JavaThread* jt) {
+  _has_work = false;
+  grow(jt);
+}
+
+void StringTable::free_retired() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (the_table()->has_retired()) {
+    the_table()->purge_retired(NULL);
+  }
+}
+
 
 oop StringTable::lookup(Symbol* symbol) {
   ResourceMark rm;
@@ -729,8 +919,13 @@ static void ensure_string_alive(oop string) {
 
 oop StringTable::lookup(jchar* name, int len) {
   unsigned int hash = hash_string(name, len);
-  int index = the_table()->hash_to_index(hash);
-  oop string = the_table()->lookup(index, name, len, hash);
+  // Archived strings are always live.
+  oop string = lookup_shared(name, len, hash);
+  if (string != NULL) {
+    return string;
+  }
+  int index;
+  string = table_for_hash(hash, &index)->lookup(index, name, len, hash);
 
   ensure_string_alive(string);
 
@@ -741,8 +936,12 @@ oop StringTable::lookup(jchar* name, int len) {
 oop StringTable::intern(Handle string_or_null, jchar* name,
                         int len, TRAPS) {
   unsigned int hashValue = hash_string(name, len);
-  int index = the_table()->hash_to_index(hashValue);
-  oop found_string = the_table()->lookup(index, name, len, hashValue);
+  oop found_string = lookup_shared(name, len, hashValue);
+  if (found_string != NULL) {
+    return found_string;
+  }
+  int index;
+  found_string = table_for_hash(hashValue, &index)->lookup(index, name, len, hashValue);
 
   // Found
   if (found_string != NULL) {
@@ -777,7 +976,7 @@ oop StringTable::intern(Handle string_or_null, jchar* name,
   {
     MutexLocker ml(StringTable_lock, THREAD);
     // Otherwise, add to symbol to table
-    added_or_found = the_table()->basic_add(index, string, name, len,
+    added_or_found = the_table()->basic_add(string, name, len,
                                   hashValue, CHECK_NULL);
   }
 
@@ -822,7 +1021,7 @@ oop StringTable::intern(const char* utf8_string, TRAPS) {
 
 void StringTable::unlink_or_oops_do(BoolObjectClosure* is_alive, OopClosure* f, int* processed, int* removed) {
   BucketUnlinkContext context;
-  buckets_unlink_or_oops_do(is_alive, f, 0, the_table()->table_size(), &context);
+  buckets_unlink_or_oops_do(is_alive, f, 0, the_table()->live_bucket_count(), &context);
   _the_table->bulk_free_entries(&context);
   *processed = context._num_processed;
   *removed = context._num_removed;
@@ -832,7 +1031,7 @@ void StringTable::possibly_parallel_unlink_or_oops_do(BoolObjectClosure* is_aliv
   // Readers of the table are unlocked, so we should only be removing
   // entries at a safepoint.
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
-  const int limit = the_table()->table_size();
+  const int limit = the_table()->live_bucket_count();
 
   BucketUnlinkContext context;
   for (;;) {
@@ -852,7 +1051,7 @@ void StringTable::possibly_parallel_unlink_or_oops_do(BoolObjectClosure* is_aliv
 }
 
 void StringTable::buckets_oops_do(OopClosure* f, int start_idx, int end_idx) {
-  const int limit = the_table()->table_size();
+  const int limit = the_table()->live_bucket_count();
 
   assert(0 <= start_idx && start_idx <= limit,
          err_msg("start_idx (" INT32_FORMAT ") is out of bounds", start_idx));
@@ -863,7 +1062,7 @@ void StringTable::buckets_oops_do(OopClosure* f, int start_idx, int end_idx) {
                  start_idx, end_idx));
 
   for (int i = start_idx; i < end_idx; i += 1) {
-    HashtableEntry<oop, mtSymbol>* entry = the_table()->bucket(i);
+    HashtableEntry<oop, mtSymbol>* entry = the_table()->live_bucket(i);
     while (entry != NULL) {
       assert(!entry->is_shared(), "CDS not used for the StringTable");
 
@@ -875,7 +1074,7 @@ void StringTable::buckets_oops_do(OopClosure* f, int start_idx, int end_idx) {
 }
 
 void StringTable::buckets_unlink_or_oops_do(BoolObjectClosure* is_alive, OopClosure* f, int start_idx, int end_idx, BucketUnlinkContext* context) {
-  const int limit = the_table()->table_size();
+  const int limit = the_table()->live_bucket_count();
 
   assert(0 <= start_idx && start_idx <= limit,
          err_msg("start_idx (" INT32_FORMAT ") is out of bounds", start_idx));
@@ -886,8 +1085,8 @@ void StringTable::buckets_unlink_or_oops_do(BoolObjectClosure* is_alive, OopClos
                  start_idx, end_idx));
 
   for (int i = start_idx; i < end_idx; ++i) {
-    HashtableEntry<oop, mtSymbol>** p = the_table()->bucket_addr(i);
-    HashtableEntry<oop, mtSymbol>* entry = the_table()->bucket(i);
+    HashtableEntry<oop, mtSymbol>** p = the_table()->live_bucket_addr(i);
+    HashtableEntry<oop, mtSymbol>* entry = *p;
     while (entry != NULL) {
       assert(!entry->is_shared(), "CDS not used for the StringTable");
 
@@ -907,11 +1106,11 @@ void StringTable::buckets_unlink_or_oops_do(BoolObjectClosure* is_alive, OopClos
 }
 
 void StringTable::oops_do(OopClosure* f) {
-  buckets_oops_do(f, 0, the_table()->table_size());
+  buckets_oops_do(f, 0, the_table()->live_bucket_count());
 }
 
 void StringTable::possibly_parallel_oops_do(OopClosure* f) {
-  const int limit = the_table()->table_size();
+  const int limit = the_table()->live_bucket_count();
 
   for (;;) {
     // Grab next set of buckets to scan
@@ -926,17 +1125,167 @@ void StringTable::possibly_parallel_oops_do(OopClosure* f) {
   }
 }
 
+#if INCLUDE_CDS && INCLUDE_ALL_GCS
+// Strings with larger arrays are not archived, so that every object fits
+// into an empty region.
+static bool is_archivable(oop string) {
+  return (size_t)java_lang_String::value(string)->size() <= HeapRegion::GrainWords / 2;
+}
+
+// Returns the offset, in words from the bottom of the archive regions, at
+// which an object of the given size is placed when the objects before it
+// end at 'used'. Objects do not cross region boundaries; if 'bottom' is
+// given, the tail of a region that cannot take the object is filled with
+// a dummy object. Such a tail is never smaller than a dummy object.
+static size_t archive_object_offset(size_t used, size_t word_size, HeapWord* bottom) {
+  size_t left = HeapRegion::GrainWords - used % HeapRegion::GrainWords;
+  if (word_size != left && word_size + CollectedHeap::min_fill_size() > left) {
+    if (bottom != NULL) {
+      CollectedHeap::fill_with_object(bottom + used, left);
+    }
+    used += left;
+  }
+  return used;
+}
+
+// The strings are archived at the top of the G1 heap, where the hp region
+// of the archive is mapped at run time. Each string is copied along with
+// its char array, and its hash field is set.
+MemRegion StringTable::archive_strings(char** top, char* end) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  ResourceMark rm;
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  StringTable* table = the_table();
+
+  // Lay out the objects to find the number of regions needed.
+  size_t used = 0;
+  int count = 0;
+  for (int i = 0; i < table->table_size(); i++) {
+    for (HashtableEntry<oop, mtSymbol>* p = table->bucket(i); p != NULL; p = p->next()) {
+      oop string = p->literal();
+      if (is_archivable(string)) {
+        size_t value_size = java_lang_String::value(string)->size();
+        used = archive_object_offset(used, value_size, NULL) + value_size;
+        used = archive_object_offset(used, string->size(), NULL) + string->size();
+        count++;
+      }
+    }
+  }
+  if (count == 0) {
+    return MemRegion();
+  }
+
+  HeapWord* bottom = g1h->reserved_region().end() - align_size_up(used, HeapRegion::GrainWords);
+  MemRegion archived(bottom, used);
+  if (!g1h->alloc_archive_regions(archived)) {
+    warning("Unable to allocate the heap regions for the archived strings");
+    return MemRegion();
+  }
+
+  GrowableArray<juint>* entries = new GrowableArray<juint>(2 * count);
+  used = 0;
+  for (int i = 0; i < table->table_size(); i++) {
+    for (HashtableEntry<oop, mtSymbol>* p = table->bucket(i); p != NULL; p = p->next()) {
+      oop string = p->literal();
+      if (!is_archivable(string)) {
+        continue;
+      }
+      typeArrayOop value = java_lang_String::value(string);
+      used = archive_object_offset(used, value->size(), bottom);
+      oop archived_value = (oop)(bottom + used);
+      Copy::aligned_disjoint_words((HeapWord*)value, (HeapWord*)archived_value, value->size());
+      archived_value->set_mark(markOopDesc::prototype());
+      used += value->size();
+
+      used = archive_object_offset(used, string->size(), bottom);
+      oop archived_string = (oop)(bottom + used);
+      Copy::aligned_disjoint_words((HeapWord*)string, (HeapWord*)archived_string, string->size());
+      archived_string->set_mark(markOopDesc::prototype());
+      archived_string->obj_field_put_raw(java_lang_String::value_offset_in_bytes(), archived_value);
+      unsigned int hash = java_lang_String::hash_code(string);
+      if (java_lang_String::has_hash_field()) {
+        java_lang_String::set_hash(archived_string, hash);
+      }
+      used += string->size();
+
+      entries->append(hash);
+      entries->append((juint)oopDesc::encode_heap_oop_not_null(archived_string));
+    }
+  }
+  assert(archived.end() == bottom + used, "layout must not change");
+  g1h->fill_archive_regions(archived);
+
+  // Write the bucket count, the start of each bucket and the entries.
+  juint bucket_count = (juint)count / 2 + 1;
+  size_t bytes = align_size_up((2 + bucket_count + 2 * count) * sizeof(juint), sizeof(intptr_t));
+  if (*top + bytes > end) {
+    report_out_of_shared_space(SharedMiscData);
+  }
+  juint* header = (juint*)(*top);
+  juint* buckets = header + 1;
+  juint* shared_entries = buckets + bucket_count + 1;
+  header[0] = bucket_count;
+  memset(buckets, 0, (bucket_count + 1) * sizeof(juint));
+  for (int i = 0; i < count; i++) {
+    buckets[entries->at(2 * i) % bucket_count + 1]++;
+  }
+  for (juint b = 0; b < bucket_count; b++) {
+    buckets[b + 1] += buckets[b];
+  }
+  juint* next = NEW_RESOURCE_ARRAY(juint, bucket_count);
+  memcpy(next, buckets, bucket_count * sizeof(juint));
+  for (int i = 0; i < count; i++) {
+    juint hash = entries->at(2 * i);
+    juint k = next[hash % bucket_count]++;
+    shared_entries[2 * k] = hash;
+    shared_entries[2 * k + 1] = entries->at(2 * i + 1);
+  }
+  *top += bytes;
+
+  if (PrintSharedSpaces) {
+    tty->print_cr("Archived %d interned strings in " SIZE_FORMAT " bytes at " PTR_FORMAT,
+                  count, archived.byte_size(), p2i(bottom));
+  }
+  return archived;
+}
+#endif // INCLUDE_CDS && INCLUDE_ALL_GCS
+
+MemRegion StringTable::copy_shared_strings(char** top, char* end) {
+  intptr_t* plen = (intptr_t*)(*top);
+  *top += sizeof(*plen);
+
+  MemRegion archived;
+#if INCLUDE_CDS && INCLUDE_ALL_GCS
+  if (MetaspaceShared::is_heap_object_archiving_allowed()) {
+    archived = archive_strings(top, end);
+  }
+#endif
+  *plen = (char*)(*top) - (char*)plen - sizeof(*plen);
+  return archived;
+}
+
+char* StringTable::restore_shared_table(char* buffer) {
+  intptr_t len = *(intptr_t*)buffer;
+  buffer += sizeof(intptr_t);
+  if (len > 0 && MetaspaceShared::archive_heap_region_mapped()) {
+    _shared_bucket_count = *(juint*)buffer;
+    _shared_buckets = (juint*)buffer + 1;
+    _shared_entries = _shared_buckets + _shared_bucket_count + 1;
+  }
+  return buffer + len;
+}
+
 // This verification is part of Universe::verify() and needs to be quick.
 // See StringTable::verify_and_compare() below for exhaustive verification.
 void StringTable::verify() {
-  for (int i = 0; i < the_table()->table_size(); ++i) {
-    HashtableEntry<oop, mtSymbol>* p = the_table()->bucket(i);
+  for (int i = 0; i < the_table()->live_bucket_count(); ++i) {
+    HashtableEntry<oop, mtSymbol>* p = the_table()->live_bucket(i);
     for ( ; p != NULL; p = p->next()) {
       oop s = p->literal();
       guarantee(s != NULL, "interned string is NULL");
       unsigned int h = java_lang_String::hash_string(s);
       guarantee(p->hash() == h, "broken hash in string table entry");
-      guarantee(the_table()->hash_to_index(h) == i,
+      guarantee(the_table()->is_live_bucket_for(i, h),
                 "wrong index in string table");
     }
   }
@@ -1007,11 +1356,10 @@ StringTable::VerifyRetTypes StringTable::verify_entry(int bkt, int e_cnt,
     ret = _verify_fail_continue;
   }
 
-  if (the_table()->hash_to_index(h) != bkt) {
+  if (!the_table()->is_live_bucket_for(bkt, h)) {
     if (mesg_mode == _verify_with_mesgs) {
       tty->print_cr("ERROR: wrong index value for entry @ bucket[%d][%d], "
-                    "str_hash=%d, hash_to_index=%d", bkt, e_cnt, h,
-                    the_table()->hash_to_index(h));
+                    "str_hash=%d", bkt, e_cnt, h);
     }
     ret = _verify_fail_continue;
   }
@@ -1040,8 +1388,8 @@ int StringTable::verify_and_compare_entries() {
   int  fail_cnt = 0;
 
   // first, verify all the entries individually:
-  for (int bkt = 0; bkt < the_table()->table_size(); bkt++) {
-    HashtableEntry<oop, mtSymbol>* e_ptr = the_table()->bucket(bkt);
+  for (int bkt = 0; bkt < the_table()->live_bucket_count(); bkt++) {
+    HashtableEntry<oop, mtSymbol>* e_ptr = the_table()->live_bucket(bkt);
     for (int e_cnt = 0; e_ptr != NULL; e_ptr = e_ptr->next(), e_cnt++) {
       VerifyRetTypes ret = verify_entry(bkt, e_cnt, e_ptr, _verify_with_mesgs);
       if (ret != _verify_pass) {
@@ -1060,8 +1408,8 @@ int StringTable::verify_and_compare_entries() {
   bool need_entry_verify = (fail_cnt != 0);
 
   // second, verify all entries relative to each other:
-  for (int bkt1 = 0; bkt1 < the_table()->table_size(); bkt1++) {
-    HashtableEntry<oop, mtSymbol>* e_ptr1 = the_table()->bucket(bkt1);
+  for (int bkt1 = 0; bkt1 < the_table()->live_bucket_count(); bkt1++) {
+    HashtableEntry<oop, mtSymbol>* e_ptr1 = the_table()->live_bucket(bkt1);
     for (int e_cnt1 = 0; e_ptr1 != NULL; e_ptr1 = e_ptr1->next(), e_cnt1++) {
       if (need_entry_verify) {
         VerifyRetTypes ret = verify_entry(bkt1, e_cnt1, e_ptr1,
@@ -1072,8 +1420,8 @@ int StringTable::verify_and_compare_entries() {
         }
       }
 
-      for (int bkt2 = bkt1; bkt2 < the_table()->table_size(); bkt2++) {
-        HashtableEntry<oop, mtSymbol>* e_ptr2 = the_table()->bucket(bkt2);
+      for (int bkt2 = bkt1; bkt2 < the_table()->live_bucket_count(); bkt2++) {
+        HashtableEntry<oop, mtSymbol>* e_ptr2 = the_table()->live_bucket(bkt2);
         int e_cnt2;
         for (e_cnt2 = 0; e_ptr2 != NULL; e_ptr2 = e_ptr2->next(), e_cnt2++) {
           if (bkt1 == bkt2 && e_cnt2 <= e_cnt1) {
@@ -1109,7 +1457,10 @@ void StringTable::rehash_table() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   // This should never happen with -Xshare:dump but it might in testing mode.
   if (DumpSharedSpaces) return;
-  StringTable* new_table = new StringTable();
+  // Wait until the service thread has finished growing the table and the
+  // old entries have been freed.
+  if (the_table()->is_growing() || the_table()->has_retired()) return;
+  StringTable* new_table = new StringTable(the_table()->table_size());
 
   // Rehash the table
   the_table()->move_to(new_table);
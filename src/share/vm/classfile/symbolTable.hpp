@@ -26,7 +26,9 @@
 #define SHARE_VM_CLASSFILE_SYMBOLTABLE_HPP
 
 #include "memory/allocation.inline.hpp"
+#include "memory/memRegion.hpp"
 #include "oops/symbol.hpp"
+#include "runtime/orderAccess.inline.hpp"
 #include "utilities/hashtable.hpp"
 
 // The symbol table holds all Symbol*s and corresponding interned strings.
@@ -34,7 +36,10 @@
 //
 // The interned strings are created lazily.
 //
-// It is implemented as an open hash table with a fixed number of buckets.
+// Both tables are ConcurrentHashtables: lookups do not take a lock, and the
+// service thread grows a table once its chains get too long. The service
+// thread also removes unreferenced symbols. Interned strings are removed
+// by the garbage collector, which knows whether they are still reachable.
 //
 // %note:
 //  - symbolTableEntrys are allocated in blocks to reduce the space overhead.
@@ -74,7 +79,7 @@ class TempNewSymbol : public StackObj {
   operator Symbol*()                             { return _temp; }
 };
 
-class SymbolTable : public RehashableHashtable<Symbol*, mtSymbol> {
+class SymbolTable : public ConcurrentHashtable<Symbol*, mtSymbol> {
   friend class VMStructs;
   friend class ClassFileParser;
 
@@ -85,6 +90,9 @@ private:
   // Set if one bucket is out of balance due to hash algorithm deficiency
   static bool _needs_rehashing;
 
+  // Set when the service thread should grow the table
+  static volatile bool _has_work;
+
   // For statistics
   static int _symbols_removed;
   static int _symbols_counted;
@@ -92,7 +100,7 @@ private:
   Symbol* allocate_symbol(const u1* name, int len, bool c_heap, TRAPS); // Assumes no characters larger than 0x7F
 
   // Adding elements
-  Symbol* basic_add(int index, u1* name, int len, unsigned int hashValue,
+  Symbol* basic_add(u1* name, int len, unsigned int hashValue,
                     bool c_heap, TRAPS);
   bool basic_add(ClassLoaderData* loader_data,
                  constantPoolHandle cp, int names_count,
@@ -109,11 +117,16 @@ private:
 
   Symbol* lookup(int index, const char* name, int len, unsigned int hash);
 
-  SymbolTable()
-    : RehashableHashtable<Symbol*, mtSymbol>(SymbolTableSize, sizeof (HashtableEntry<Symbol*, mtSymbol>)) {}
+  // The table and bucket index for the hash, see ConcurrentHashtable.
+  static SymbolTable* table_for_hash(unsigned int hash, int* index) {
+    return (SymbolTable*)the_table()->table_for(hash, index);
+  }
+
+  SymbolTable(int table_size)
+    : ConcurrentHashtable<Symbol*, mtSymbol>(table_size, sizeof (HashtableEntry<Symbol*, mtSymbol>)) {}
 
   SymbolTable(HashtableBucket<mtSymbol>* t, int number_of_entries)
-    : RehashableHashtable<Symbol*, mtSymbol>(SymbolTableSize, sizeof (HashtableEntry<Symbol*, mtSymbol>), t,
+    : ConcurrentHashtable<Symbol*, mtSymbol>(SymbolTableSize, sizeof (HashtableEntry<Symbol*, mtSymbol>), t,
                 number_of_entries) {}
 
   // Arena for permanent symbols (null class loader) that are never unloaded
@@ -129,6 +142,12 @@ private:
   // context to be freed later.
   // This allows multiple threads to work on the table at once.
   static void buckets_unlink(int start_idx, int end_idx, BucketUnlinkContext* context, size_t* memory_total);
+
+  // Concurrent work
+  static void check_concurrent_work();
+  static void remove_unreferenced_symbols(JavaThread* jt);
+  static void grow(JavaThread* jt);
+  static void delete_dead_symbol(Symbol* sym);
 public:
   enum {
     symbol_alloc_batch_size = 8,
@@ -137,14 +156,16 @@ public:
   };
 
   // The symbol table
-  static SymbolTable* the_table() { return _the_table; }
+  static SymbolTable* the_table() {
+    return (SymbolTable*)OrderAccess::load_ptr_acquire(&_the_table);
+  }
 
   // Size of one bucket in the string table.  Used when checking for rollover.
   static uint bucket_size() { return sizeof(HashtableBucket<mtSymbol>); }
 
   static void create_table() {
     assert(_the_table == NULL, "One symbol table allowed.");
-    _the_table = new SymbolTable();
+    _the_table = new SymbolTable((int)SymbolTableSize);
     initialize_symbols(symbol_alloc_arena_size);
   }
 
@@ -253,9 +274,16 @@ public:
   // Parallel chunked scanning
   static void clear_parallel_claimed_index() { _parallel_claimed_idx = 0; }
   static int parallel_claimed_index()        { return _parallel_claimed_idx; }
+
+  // Concurrent work done by the service thread
+  static bool has_work()                { return _has_work; }
+  static void do_concurrent_work(JavaThread* jt);
+  // Free the entries and symbols removed concurrently, at a safepoint
+  static bool has_retired()             { return the_table()->has_retired(); }
+  static void free_retired();
 };
 
-class StringTable : public RehashableHashtable<oop, mtSymbol> {
+class StringTable : public ConcurrentHashtable<oop, mtSymbol> {
   friend class VMStructs;
 
 private:
@@ -265,15 +293,34 @@ private:
   // Set if one bucket is out of balance due to hash algorithm deficiency
   static bool _needs_rehashing;
 
+  // Set when the service thread should grow the table
+  static volatile bool _has_work;
+
   // Claimed high water mark for parallel chunked scanning
   static volatile int _parallel_claimed_idx;
 
+  // The interned strings archived in the hp region of the CDS archive. Their
+  // read-only table maps the java_lang_String::hash_code() of a string to its
+  // compressed oop; the entries of bucket b are in the range
+  // [_shared_buckets[b], _shared_buckets[b + 1]) of _shared_entries.
+  static juint  _shared_bucket_count;
+  static juint* _shared_buckets;
+  static juint* _shared_entries;  // pairs of hash and narrowOop
+
+  static oop lookup_shared(jchar* chars, int length, unsigned int hashValue);
+  static MemRegion archive_strings(char** top, char* end);
+
   static oop intern(Handle string_or_null, jchar* chars, int length, TRAPS);
-  oop basic_add(int index, Handle string_or_null, jchar* name, int len,
+  oop basic_add(Handle string_or_null, jchar* name, int len,
                 unsigned int hashValue, TRAPS);
 
   oop lookup(int index, jchar* chars, int length, unsigned int hashValue);
 
+  // The table and bucket index for the hash, see ConcurrentHashtable.
+  static StringTable* table_for_hash(unsigned int hash, int* index) {
+    return (StringTable*)the_table()->table_for(hash, index);
+  }
+
   // Apply the give oop closure to the entries to the buckets
   // in the range [start_idx, end_idx).
   static void buckets_oops_do(OopClosure* f, int start_idx, int end_idx);
@@ -285,22 +332,28 @@ private:
   // This allows multiple threads to work on the table at once.
   static void buckets_unlink_or_oops_do(BoolObjectClosure* is_alive, OopClosure* f, int start_idx, int end_idx, BucketUnlinkContext* context);
 
-  StringTable() : RehashableHashtable<oop, mtSymbol>((int)StringTableSize,
+  StringTable(int table_size) : ConcurrentHashtable<oop, mtSymbol>(table_size,
                               sizeof (HashtableEntry<oop, mtSymbol>)) {}
 
   StringTable(HashtableBucket<mtSymbol>* t, int number_of_entries)
-    : RehashableHashtable<oop, mtSymbol>((int)StringTableSize, sizeof (HashtableEntry<oop, mtSymbol>), t,
+    : ConcurrentHashtable<oop, mtSymbol>((int)StringTableSize, sizeof (HashtableEntry<oop, mtSymbol>), t,
                      number_of_entries) {}
+
+  // Concurrent work
+  static void check_concurrent_work();
+  static void grow(JavaThread* jt);
 public:
   // The string table
-  static StringTable* the_table() { return _the_table; }
+  static StringTable* the_table() {
+    return (StringTable*)OrderAccess::load_ptr_acquire(&_the_table);
+  }
 
   // Size of one bucket in the string table.  Used when checking for rollover.
   static uint bucket_size() { return sizeof(HashtableBucket<mtSymbol>); }
 
   static void create_table() {
     assert(_the_table == NULL, "One string table allowed.");
-    _the_table = new StringTable();
+    _the_table = new StringTable((int)StringTableSize);
   }
 
   // GC support
@@ -380,6 +433,13 @@ public:
   static void reverse() {
     the_table()->Hashtable<oop, mtSymbol>::reverse();
   }
+  // Copies the interned strings into archive regions at the top of the Java
+  // heap and writes their table to the misc data region. Returns the range
+  // of the archived objects, which is empty if nothing was archived.
+  static MemRegion copy_shared_strings(char** top, char* end);
+  // Uses the table written by copy_shared_strings() if the archived objects
+  // are mapped. Returns the address following the table.
+  static char* restore_shared_table(char* buffer);
 
   // Rehash the symbol table if it gets out of balance
   static void rehash_table();
@@ -388,5 +448,12 @@ public:
   // Parallel chunked scanning
   static void clear_parallel_claimed_index() { _parallel_claimed_idx = 0; }
   static int parallel_claimed_index() { return _parallel_claimed_idx; }
+
+  // Concurrent work done by the service thread
+  static bool has_work()        { return _has_work; }
+  static void do_concurrent_work(JavaThread* jt);
+  // Free the entries of a replaced table, at a safepoint
+  static bool has_retired()     { return the_table()->has_retired(); }
+  static void free_retired();
 };
 #endif // SHARE_VM_CLASSFILE_SYMBOLTABLE_HPP
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.inline.hpp"
+#include "classfile/classLoaderExt.hpp"
+#include "classfile/dictionary.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/sharedClassUtil.hpp"
+#include "classfile/systemDictionaryShared.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "memory/filemap.hpp"
+#include "memory/metadataFactory.hpp"
+#include "memory/oopFactory.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/objArrayOop.hpp"
+#include "oops/oop.inline.hpp"
+#include "oops/typeArrayOop.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
+
+oop         SystemDictionaryShared::_shared_ext_loader = NULL;
+oop         SystemDictionaryShared::_shared_app_loader = NULL;
+objArrayOop SystemDictionaryShared::_shared_jar_urls = NULL;
+objArrayOop SystemDictionaryShared::_shared_jar_manifests = NULL;
+objArrayOop SystemDictionaryShared::_shared_protection_domains = NULL;
+
+// ----------------------------------------------------------------------------
+// SharedDictionaryEntry
+
+void SharedDictionaryEntry::add_verification_constraint(Symbol* name, Symbol* from_name) {
+  assert(DumpSharedSpaces, "only while dumping");
+  if (_dumptime_constraints == NULL) {
+    _dumptime_constraints = new (ResourceObj::C_HEAP, mtClass) GrowableArray<Symbol*>(8, true, mtClass);
+  }
+  for (int i = 0; i < _dumptime_constraints->length(); i += 2) {
+    if (_dumptime_constraints->at(i) == name &&
+        _dumptime_constraints->at(i + 1) == from_name) {
+      return;
+    }
+  }
+  _dumptime_constraints->append(name);
+  _dumptime_constraints->append(from_name);
+}
+
+void SharedDictionaryEntry::finalize_verification_constraints(TRAPS) {
+  assert(DumpSharedSpaces, "only while dumping");
+  if (_dumptime_constraints != NULL) {
+    int length = _dumptime_constraints->length();
+    ClassLoaderData* loader_data = ClassLoaderData::the_null_class_loader_data();
+    Array<Symbol*>* constraints = MetadataFactory::new_array<Symbol*>(loader_data, length, CHECK);
+    for (int i = 0; i < length; i++) {
+      constraints->at_put(i, _dumptime_constraints->at(i));
+    }
+    delete _dumptime_constraints;
+    _dumptime_constraints = NULL;
+    _verifier_constraints = constraints;
+  }
+}
+
+bool SharedDictionaryEntry::check_verification_constraints(InstanceKlass* k,
+                                                           Handle class_loader,
+                                                           Handle protection_domain,
+                                                           char** message_buffer,
+                                                           TRAPS) {
+  Array<Symbol*>* constraints = _verifier_constraints;
+  if (constraints == NULL) {
+    return true;
+  }
+  for (int i = 0; i < constraints->length(); i += 2) {
+    Symbol* name = constraints->at(i);
+    Symbol* from_name = constraints->at(i + 1);
+    Klass* target = SystemDictionary::resolve_or_fail(name, class_loader,
+                                                      protection_domain, true, CHECK_false);
+    Klass* from = SystemDictionary::resolve_or_fail(from_name, class_loader,
+                                                    protection_domain, true, CHECK_false);
+    if (!from->is_subclass_of(target)) {
+      const char* fmt = "Bad type in shared class %s: %s is not assignable to %s";
+      const char* k_name = k->external_name();
+      const char* from_ext = from_name->as_klass_external_name();
+      const char* name_ext = name->as_klass_external_name();
+      size_t len = strlen(fmt) + strlen(k_name) + strlen(from_ext) + strlen(name_ext);
+      *message_buffer = NEW_RESOURCE_ARRAY(char, len);
+      jio_snprintf(*message_buffer, len, fmt, k_name, from_ext, name_ext);
+      return false;
+    }
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+// SystemDictionaryShared
+
+void SystemDictionaryShared::initialize(TRAPS) {
+  if (!UseSharedSpaces || !UseAppCDS) {
+    return;
+  }
+  int size = FileMapInfo::get_number_of_share_classpaths();
+  if (ClassLoaderExt::ext_class_paths_start() >= size) {
+    // The archive has boot classes only.
+    return;
+  }
+
+  for (oop loader = java_system_loader(); loader != NULL;
+       loader = java_lang_ClassLoader::parent(loader)) {
+    Symbol* name = loader->klass()->name();
+    if (name == vmSymbols::sun_misc_Launcher_AppClassLoader() && _shared_app_loader == NULL) {
+      _shared_app_loader = loader;
+    } else if (name == vmSymbols::sun_misc_Launcher_ExtClassLoader() && _shared_ext_loader == NULL) {
+      _shared_ext_loader = loader;
+    }
+  }
+
+  _shared_jar_urls = oopFactory::new_objArray(SystemDictionary::Object_klass(), size, CHECK);
+  _shared_jar_manifests = oopFactory::new_objArray(SystemDictionary::Object_klass(), size, CHECK);
+  _shared_protection_domains = oopFactory::new_objArray(SystemDictionary::Object_klass(), size, CHECK);
+}
+
+void SystemDictionaryShared::roots_oops_do(OopClosure* blk) {
+  oops_do(blk);
+}
+
+void SystemDictionaryShared::oops_do(OopClosure* f) {
+  f->do_oop(&_shared_ext_loader);
+  f->do_oop(&_shared_app_loader);
+  f->do_oop((oop*)&_shared_jar_urls);
+  f->do_oop((oop*)&_shared_jar_manifests);
+  f->do_oop((oop*)&_shared_protection_domains);
+}
+
+SharedDictionaryEntry* SystemDictionaryShared::find_shared_entry(Dictionary* dict,
+                                                                 Symbol* class_name) {
+  unsigned int d_hash = dict->compute_hash(class_name, NULL);
+  int d_index = dict->hash_to_index(d_hash);
+  return (SharedDictionaryEntry*)dict->find_shared_entry(d_index, d_hash, class_name);
+}
+
+// Allocates an instance of the class and runs the constructor with the
+// given signature. The receiver is added to args.
+static Handle construct_new_instance(Klass* k, Symbol* signature,
+                                     JavaCallArguments* args, TRAPS) {
+  InstanceKlass* ik = InstanceKlass::cast(k);
+  ik->initialize(CHECK_NH);
+  Handle obj = ik->allocate_instance_handle(CHECK_NH);
+  args->set_receiver(obj);
+  JavaValue result(T_VOID);
+  JavaCalls::call_special(&result, KlassHandle(THREAD, ik),
+                          vmSymbols::object_initializer_name(),
+                          signature, args, CHECK_NH);
+  return obj;
+}
+
+// Stores obj at index unless another thread got there first, and returns
+// the object that ends up in the array.
+static Handle set_if_absent(objArrayOop* array_addr, int index, Handle obj, TRAPS) {
+  MutexLocker mu(SystemDictionary_lock, THREAD);
+  oop existing = (*array_addr)->obj_at(index);
+  if (existing != NULL) {
+    return Handle(THREAD, existing);
+  }
+  (*array_addr)->obj_at_put(index, obj());
+  return obj;
+}
+
+// The code source URL of a jar, as created by sun.misc.Launcher.
+Handle SystemDictionaryShared::get_shared_jar_url(int index, TRAPS) {
+  Handle url(THREAD, _shared_jar_urls->obj_at(index));
+  if (url.is_null()) {
+    Handle path = java_lang_String::create_from_str(FileMapInfo::shared_classpath_name(index), CHECK_NH);
+    JavaCallArguments file_args;
+    file_args.push_oop(path);
+    Handle file = construct_new_instance(SystemDictionary::File_klass(),
+                                         vmSymbols::string_void_signature(),
+                                         &file_args, CHECK_NH);
+    JavaValue result(T_OBJECT);
+    JavaCalls::call_static(&result, KlassHandle(THREAD, SystemDictionary::sun_misc_Launcher_klass()),
+                           vmSymbols::getFileURL_name(), vmSymbols::getFileURL_signature(),
+                           file, CHECK_NH);
+    url = set_if_absent(&_shared_jar_urls, index, Handle(THREAD, (oop)result.get_jobject()), THREAD);
+  }
+  return url;
+}
+
+// The manifest of a jar, recreated from the bytes archived while dumping.
+Handle SystemDictionaryShared::get_shared_jar_manifest(int index, TRAPS) {
+  Handle manifest(THREAD, _shared_jar_manifests->obj_at(index));
+  if (manifest.is_null()) {
+    Array<u1>* src = FileMapInfo::shared_classpath(index)->manifest();
+    if (src == NULL) {
+      return manifest;
+    }
+    int size = src->length();
+    typeArrayOop buf = oopFactory::new_byteArray(size, CHECK_NH);
+    typeArrayHandle bufhandle(THREAD, buf);
+    memcpy(bufhandle->byte_at_addr(0), src->adr_at(0), size);
+
+    JavaCallArguments stream_args;
+    stream_args.push_oop(bufhandle);
+    Handle stream = construct_new_instance(SystemDictionary::ByteArrayInputStream_klass(),
+                                           vmSymbols::byte_array_void_signature(),
+                                           &stream_args, CHECK_NH);
+    JavaCallArguments manifest_args;
+    manifest_args.push_oop(stream);
+    Handle m = construct_new_instance(SystemDictionary::Jar_Manifest_klass(),
+                                      vmSymbols::input_stream_void_signature(),
+                                      &manifest_args, CHECK_NH);
+    manifest = set_if_absent(&_shared_jar_manifests, index, m, THREAD);
+  }
+  return manifest;
+}
+
+// The protection domain the class loader assigns to the classes of a jar.
+Handle SystemDictionaryShared::get_shared_protection_domain(Handle class_loader,
+                                                            int index, Handle url,
+                                                            TRAPS) {
+  Handle pd(THREAD, _shared_protection_domains->obj_at(index));
+  if (pd.is_null()) {
+    JavaCallArguments cs_args;
+    cs_args.push_oop(url);
+    cs_args.push_oop(Handle()); // no code signers, signed jars are not archived
+    Handle cs = construct_new_instance(SystemDictionary::CodeSource_klass(),
+                                       vmSymbols::url_code_signer_array_void_signature(),
+                                       &cs_args, CHECK_NH);
+    JavaValue result(T_OBJECT);
+    JavaCalls::call_virtual(&result, class_loader,
+                            KlassHandle(THREAD, SystemDictionary::SecureClassLoader_klass()),
+                            vmSymbols::getProtectionDomain_name(),
+                            vmSymbols::getProtectionDomain_signature(),
+                            cs, CHECK_NH);
+    pd = set_if_absent(&_shared_protection_domains, index, Handle(THREAD, (oop)result.get_jobject()), THREAD);
+  }
+  return pd;
+}
+
+// Defines the package of the class the way URLClassLoader.defineClass()
+// does before defining a class from a jar.
+void SystemDictionaryShared::define_shared_package(Symbol* class_name,
+                                                   Handle class_loader,
+                                                   Handle manifest,
+                                                   Handle url,
+                                                   TRAPS) {
+  ResourceMark rm(THREAD);
+  const char* name = class_name->as_C_string();
+  const char* last_slash = strrchr(name, '/');
+  if (last_slash == NULL) {
+    // unnamed package
+    return;
+  }
+  int len = last_slash - name;
+  char* pkgname = NEW_RESOURCE_ARRAY(char, len + 1);
+  strncpy(pkgname, name, len);
+  pkgname[len] = '\0';
+  Handle pkgname_string = java_lang_String::create_from_str(pkgname, CHECK);
+  pkgname_string = java_lang_String::externalize_classname(pkgname_string, CHECK);
+
+  JavaValue result(T_VOID);
+  JavaCallArguments args(class_loader);
+  args.push_oop(pkgname_string);
+  args.push_oop(manifest);
+  args.push_oop(url);
+  JavaCalls::call_special(&result, KlassHandle(THREAD, SystemDictionary::URLClassLoader_klass()),
+                          vmSymbols::definePackageInternal_name(),
+                          vmSymbols::definePackageInternal_signature(),
+                          &args, CHECK);
+}
+
+instanceKlassHandle SystemDictionaryShared::load_shared_class_for_loader(instanceKlassHandle ik,
+                                                                         Handle class_loader,
+                                                                         TRAPS) {
+  instanceKlassHandle nh = instanceKlassHandle(); // null Handle
+  int index = ik->shared_classpath_index();
+  Handle url = get_shared_jar_url(index, CHECK_(nh));
+  Handle manifest = get_shared_jar_manifest(index, CHECK_(nh));
+  Handle protection_domain = get_shared_protection_domain(class_loader, index, url, CHECK_(nh));
+  define_shared_package(ik->name(), class_loader, manifest, url, CHECK_(nh));
+
+  instanceKlassHandle k = load_shared_class(ik, class_loader, protection_domain, CHECK_(nh));
+  if (k.not_null()) {
+    k = find_or_define_instance_class(k->name(), class_loader, k, CHECK_(nh));
+  }
+  return k;
+}
+
+instanceKlassHandle SystemDictionaryShared::find_or_load_shared_class(
+                 Symbol* class_name, Handle class_loader, TRAPS) {
+  instanceKlassHandle nh = instanceKlassHandle(); // null Handle
+  if (!UseSharedSpaces || !UseAppCDS || shared_dictionary() == NULL ||
+      _shared_jar_urls == NULL || class_loader.is_null()) {
+    return nh;
+  }
+  bool is_app = (class_loader() == _shared_app_loader);
+  bool is_ext = (class_loader() == _shared_ext_loader);
+  if (!is_app && !is_ext) {
+    return nh;
+  }
+
+  SharedDictionaryEntry* entry = find_shared_entry(shared_dictionary(), class_name);
+  if (entry == NULL) {
+    return nh;
+  }
+  instanceKlassHandle ik(THREAD, entry->klass());
+  if (is_app ? !SharedClassUtil::is_shared_app_class(ik()) :
+               !SharedClassUtil::is_shared_ext_class(ik())) {
+    return nh;
+  }
+
+  ClassLoaderData* loader_data = register_loader(class_loader, CHECK_(nh));
+  unsigned int d_hash = dictionary()->compute_hash(class_name, loader_data);
+  int d_index = dictionary()->hash_to_index(d_hash);
+  {
+    MutexLocker mu(SystemDictionary_lock, THREAD);
+    if (entry->_load_state == SharedDictionaryEntry::loading &&
+        entry->_loading_thread == THREAD) {
+      // Asked for the class again while setting it up; leave it to the
+      // class loader.
+      return nh;
+    }
+    while (entry->_load_state == SharedDictionaryEntry::loading) {
+      SystemDictionary_lock->wait();
+    }
+    Klass* check = find_class(d_index, d_hash, class_name, loader_data);
+    if (check != NULL) {
+      return instanceKlassHandle(THREAD, check);
+    }
+    if (entry->_load_state != SharedDictionaryEntry::not_loaded) {
+      // An earlier attempt has failed; the class loader defines the class
+      // from its class file instead.
+      return nh;
+    }
+    entry->_load_state = SharedDictionaryEntry::loading;
+    entry->_loading_thread = THREAD;
+  }
+
+  instanceKlassHandle k = load_shared_class_for_loader(ik, class_loader, THREAD);
+
+  {
+    MutexLocker mu(SystemDictionary_lock, THREAD);
+    entry->_load_state = (k.not_null() && !HAS_PENDING_EXCEPTION) ?
+                         SharedDictionaryEntry::loaded : SharedDictionaryEntry::load_failed;
+    entry->_loading_thread = NULL;
+    SystemDictionary_lock->notify_all();
+  }
+  if (HAS_PENDING_EXCEPTION) {
+    return nh;
+  }
+  return k;
+}
+
+void SystemDictionaryShared::add_verification_dependency(Klass* k, Symbol* accessor_clsname,
+                                                         Symbol* target_clsname) {
+  assert(DumpSharedSpaces, "only while dumping");
+  if (!SharedClassUtil::is_shared_ext_class(k) && !SharedClassUtil::is_shared_app_class(k)) {
+    return;
+  }
+  SharedDictionaryEntry* entry = find_shared_entry(dictionary(), k->name());
+  assert(entry != NULL && entry->klass() == k, "class must be in the dictionary");
+  entry->add_verification_constraint(target_clsname, accessor_clsname);
+}
+
+void SystemDictionaryShared::finalize_verification_constraints_for(Klass* k) {
+  SharedDictionaryEntry* entry = find_shared_entry(dictionary(), k->name());
+  if (entry != NULL && entry->klass() == k) {
+    EXCEPTION_MARK; // The allocation should never fail, but would exit the VM on error.
+    entry->finalize_verification_constraints(THREAD);
+  }
+}
+
+void SystemDictionaryShared::finalize_verification_dependencies() {
+  assert(DumpSharedSpaces, "only while dumping");
+  dictionary()->classes_do(finalize_verification_constraints_for);
+}
+
+bool SystemDictionaryShared::check_verification_dependencies(Klass* k, Handle class_loader,
+                                                             Handle protection_domain,
+                                                             char** message_buffer, TRAPS) {
+  if (shared_dictionary() == NULL ||
+      (!SharedClassUtil::is_shared_ext_class(k) && !SharedClassUtil::is_shared_app_class(k))) {
+    return true;
+  }
+  SharedDictionaryEntry* entry = find_shared_entry(shared_dictionary(), k->name());
+  assert(entry != NULL && entry->klass() == k, "class must be in the shared dictionary");
+  return entry->check_verification_constraints(InstanceKlass::cast(k), class_loader,
+                                               protection_domain, message_buffer, THREAD);
+}
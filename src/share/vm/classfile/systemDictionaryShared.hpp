@@ -28,37 +28,116 @@
 
 #include "classfile/dictionary.hpp"
 #include "classfile/systemDictionary.hpp"
+#include "utilities/growableArray.hpp"
+
+// With UseAppCDS the shared dictionary also holds the classes of the
+// extension and application class paths, which were loaded by the null
+// class loader while dumping. Their entries record the verification
+// constraints that depend on the class loader, and whether the class has
+// been taken out of the archive at run time.
+class SharedDictionaryEntry : public DictionaryEntry {
+  friend class SystemDictionaryShared;
+ public:
+  enum LoadState {
+    not_loaded,
+    loading,
+    loaded,
+    load_failed
+  };
+
+ private:
+  // Pairs of class names (name, from_name) meaning that the class from_name
+  // must be assignable to the class name. Collected in the C heap while
+  // dumping and moved to the read-only space before the archive is written.
+  GrowableArray<Symbol*>* _dumptime_constraints;
+  Array<Symbol*>*         _verifier_constraints;
+
+  // A shared class can be loaded once only. _loading_thread is the thread
+  // which is loading it while _load_state is loading.
+  int                     _load_state;
+  Thread*                 _loading_thread;
+
+ public:
+  void initialize() {
+    _dumptime_constraints = NULL;
+    _verifier_constraints = NULL;
+    _load_state = not_loaded;
+    _loading_thread = NULL;
+  }
+
+  void add_verification_constraint(Symbol* name, Symbol* from_name);
+  void finalize_verification_constraints(TRAPS);
+  bool check_verification_constraints(InstanceKlass* k, Handle class_loader,
+                                      Handle protection_domain,
+                                      char** message_buffer, TRAPS);
+};
 
 class SystemDictionaryShared: public SystemDictionary {
+private:
+  // The class loaders set up by sun.misc.Launcher for the extension and the
+  // application class paths. Only these load classes from the archive.
+  static oop _shared_ext_loader;
+  static oop _shared_app_loader;
+
+  // The code source URL, the manifest and the protection domain of each
+  // shared class path entry, created when its first class is loaded.
+  static objArrayOop _shared_jar_urls;
+  static objArrayOop _shared_jar_manifests;
+  static objArrayOop _shared_protection_domains;
+
+  static SharedDictionaryEntry* find_shared_entry(Dictionary* dict, Symbol* class_name);
+
+  static Handle get_shared_jar_url(int index, TRAPS);
+  static Handle get_shared_jar_manifest(int index, TRAPS);
+  static Handle get_shared_protection_domain(Handle class_loader, int index,
+                                             Handle url, TRAPS);
+  static void define_shared_package(Symbol* class_name, Handle class_loader,
+                                    Handle manifest, Handle url, TRAPS);
+  static instanceKlassHandle load_shared_class_for_loader(instanceKlassHandle ik,
+                                                          Handle class_loader,
+                                                          TRAPS);
+  static void finalize_verification_constraints_for(Klass* k);
+
 public:
-  static void initialize(TRAPS) {}
+  static bool is_app_class_loader(Handle class_loader) {
+    return (class_loader.not_null() &&
+            class_loader->klass()->name() == vmSymbols::sun_misc_Launcher_AppClassLoader());
+  }
+
+  static void initialize(TRAPS) NOT_CDS_RETURN;
+  // Loads an extension or application class from the archive on behalf of
+  // JVM_FindLoadedClass, which is called before the class loader searches
+  // its class path.
   static instanceKlassHandle find_or_load_shared_class(Symbol* class_name,
                                                        Handle class_loader,
-                                                       TRAPS) {
-    return instanceKlassHandle();
-  }
-  static void roots_oops_do(OopClosure* blk) {}
-  static void oops_do(OopClosure* f) {}
+                                                       TRAPS) NOT_CDS_RETURN_(instanceKlassHandle());
+  static void roots_oops_do(OopClosure* blk) NOT_CDS_RETURN;
+  static void oops_do(OopClosure* f) NOT_CDS_RETURN;
   static bool is_sharing_possible(ClassLoaderData* loader_data) {
     oop class_loader = loader_data->class_loader();
-    return (class_loader == NULL);
+    return (class_loader == NULL ||
+            (UseAppCDS && (SystemDictionary::is_ext_class_loader(class_loader) ||
+                           is_app_class_loader(class_loader))));
   }
 
   static size_t dictionary_entry_size() {
-    return sizeof(DictionaryEntry);
+    return sizeof(SharedDictionaryEntry);
+  }
+  static void init_shared_dictionary_entry(Klass* k, DictionaryEntry* entry) {
+    ((SharedDictionaryEntry*)entry)->initialize();
   }
-  static void init_shared_dictionary_entry(Klass* k, DictionaryEntry* entry) {}
 
-  // The (non-application) CDS implementation supports only classes in the boot
-  // class loader, which ensures that the verification dependencies are the same
-  // during archive creation time and runtime. Thus we can do the dependency checks
-  // entirely during archive creation time.
+  // The boot classes of the archive are resolved by the same class loader
+  // while dumping and at run time, so the verifier checks their assignability
+  // entirely while dumping. The extension and application classes are
+  // resolved by other class loaders at run time, so the constraints that
+  // involve them are recorded and checked again when the class is linked.
   static void add_verification_dependency(Klass* k, Symbol* accessor_clsname,
-                                          Symbol* target_clsname) {}
-  static void finalize_verification_dependencies() {}
+                                          Symbol* target_clsname) NOT_CDS_RETURN;
+  static void finalize_verification_dependencies() NOT_CDS_RETURN;
   static bool check_verification_dependencies(Klass* k, Handle class_loader,
                                               Handle protection_domain,
-                                              char** message_buffer, TRAPS) {return true;}
+                                              char** message_buffer, TRAPS) NOT_CDS_RETURN_(true);
 };
 
 #endif // SHARE_VM_CLASSFILE_SYSTEMDICTIONARYSHARED_HPP
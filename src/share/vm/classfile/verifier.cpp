@@ -94,6 +94,11 @@ static void* verify_byte_codes_fn() {
 // Methods in Verifier
 
 bool Verifier::should_verify_for(oop class_loader, bool should_verify_class) {
+  if (DumpSharedSpaces) {
+    // The boot loader defines all classes while dumping, should_verify_class
+    // tells the classes of the extension and application class paths apart.
+    return should_verify_class ? BytecodeVerificationRemote : BytecodeVerificationLocal;
+  }
   return (class_loader == NULL || !should_verify_class) ?
     BytecodeVerificationLocal : BytecodeVerificationRemote;
 }
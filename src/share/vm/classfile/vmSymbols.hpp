@@ -788,12 +788,27 @@
                                                                                                                         \
   do_intrinsic(_equalsC,                  java_util_Arrays,       equals_name,    equalsC_signature,             F_S)   \
    do_signature(equalsC_signature,                               "([C[C)Z")                                             \
+  do_intrinsic(_equalsB,                  java_util_Arrays,       equals_name,    equalsB_signature,             F_S)   \
+   do_signature(equalsB_signature,                               "([B[B)Z")                                             \
+  do_intrinsic(_equalsZ,                  java_util_Arrays,       equals_name,    equalsZ_signature,             F_S)   \
+   do_signature(equalsZ_signature,                               "([Z[Z)Z")                                             \
+  do_intrinsic(_equalsS,                  java_util_Arrays,       equals_name,    equalsS_signature,             F_S)   \
+   do_signature(equalsS_signature,                               "([S[S)Z")                                             \
+  do_intrinsic(_equalsI,                  java_util_Arrays,       equals_name,    equalsI_signature,             F_S)   \
+   do_signature(equalsI_signature,                               "([I[I)Z")                                             \
+  do_intrinsic(_equalsJ,                  java_util_Arrays,       equals_name,    equalsJ_signature,             F_S)   \
+   do_signature(equalsJ_signature,                               "([J[J)Z")                                             \
+  do_intrinsic(_equalsF,                  java_util_Arrays,       equals_name,    equalsF_signature,             F_S)   \
+   do_signature(equalsF_signature,                               "([F[F)Z")                                             \
+  do_intrinsic(_equalsD,                  java_util_Arrays,       equals_name,    equalsD_signature,             F_S)   \
+   do_signature(equalsD_signature,                               "([D[D)Z")                                             \
                                                                                                                         \
   do_intrinsic(_compareTo,                java_lang_String,       compareTo_name, string_int_signature,          F_R)   \
    do_name(     compareTo_name,                                  "compareTo")                                           \
   do_intrinsic(_indexOf,                  java_lang_String,       indexOf_name, string_int_signature,            F_R)   \
    do_name(     indexOf_name,                                    "indexOf")                                             \
   do_intrinsic(_equals,                   java_lang_String,       equals_name, object_boolean_signature,         F_R)   \
+  do_intrinsic(_stringHashCode,           java_lang_String,       hashCode_name, void_int_signature,             F_R)   \
                                                                                                                         \
   do_class(java_nio_Buffer,               "java/nio/Buffer")                                                            \
   do_intrinsic(_checkIndex,               java_nio_Buffer,        checkIndex_name, int_int_signature,            F_R)   \
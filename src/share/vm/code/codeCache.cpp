@@ -118,7 +118,9 @@ class CodeBlob_sizes {
 
 // CodeCache implementation
 
-CodeHeap * CodeCache::_heap = new CodeHeap();
+GrowableArray<CodeHeap*>* CodeCache::_heaps = new(ResourceObj::C_HEAP, mtCode) GrowableArray<CodeHeap*> (CodeBlobType::All, true);
+address CodeCache::_low_bound = NULL;
+address CodeCache::_high_bound = NULL;
 int CodeCache::_number_of_blobs = 0;
 int CodeCache::_number_of_adapters = 0;
 int CodeCache::_number_of_nmethods = 0;
@@ -128,15 +130,76 @@ nmethod* CodeCache::_scavenge_root_nmethods = NULL;
 
 int CodeCache::_codemem_full_count = 0;
 
-CodeBlob* CodeCache::first() {
+#define FOR_ALL_HEAPS(index) for (int index = 0; index < _heaps->length(); ++index)
+
+CodeHeap* CodeCache::get_code_heap(const void* cb) {
+  // NMT can walk the stack before the code heaps are created
+  if (_heaps == NULL) return NULL;
+  FOR_ALL_HEAPS(i) {
+    CodeHeap* heap = _heaps->at(i);
+    if (heap->contains(cb)) {
+      return heap;
+    }
+  }
+  return NULL;
+}
+
+CodeHeap* CodeCache::get_code_heap(int code_blob_type) {
+  FOR_ALL_HEAPS(i) {
+    CodeHeap* heap = _heaps->at(i);
+    if (heap->accepts(code_blob_type)) {
+      return heap;
+    }
+  }
+  return NULL;
+}
+
+bool CodeCache::heap_available(int code_blob_type) {
+  if (!SegmentedCodeCache) {
+    // No segmentation: use a single code heap
+    return code_blob_type == CodeBlobType::All;
+  } else if (code_blob_type == CodeBlobType::MethodProfiled) {
+    // Profiled code is only generated by the tiered compilation policy
+    return TieredCompilation && TieredStopAtLevel > CompLevel_simple;
+  }
+  return code_blob_type < CodeBlobType::All;
+}
+
+CodeBlob* CodeCache::first_blob(int index, bool method_heaps_only) {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (CodeBlob*)_heap->first();
+  for (int i = index; i < _heaps->length(); i++) {
+    CodeHeap* heap = _heaps->at(i);
+    if (method_heaps_only && !is_method_heap(heap)) {
+      continue;
+    }
+    CodeBlob* cb = (CodeBlob*)heap->first();
+    if (cb != NULL) {
+      return cb;
+    }
+  }
+  return NULL;
+}
+
+CodeBlob* CodeCache::next_blob(CodeBlob* cb, bool method_heaps_only) {
+  assert_locked_or_safepoint(CodeCache_lock);
+  FOR_ALL_HEAPS(i) {
+    CodeHeap* heap = _heaps->at(i);
+    if (heap->contains(cb)) {
+      CodeBlob* next = (CodeBlob*)heap->next(cb);
+      return (next != NULL) ? next : first_blob(i + 1, method_heaps_only);
+    }
+  }
+  ShouldNotReachHere();
+  return NULL;
+}
+
+CodeBlob* CodeCache::first() {
+  return first_blob(0, false);
 }
 
 
 CodeBlob* CodeCache::next(CodeBlob* cb) {
-  assert_locked_or_safepoint(CodeCache_lock);
-  return (CodeBlob*)_heap->next(cb);
+  return next_blob(cb, false);
 }
 
 
@@ -155,25 +218,43 @@ nmethod* CodeCache::alive_nmethod(CodeBlob* cb) {
 
 nmethod* CodeCache::first_nmethod() {
   assert_locked_or_safepoint(CodeCache_lock);
-  CodeBlob* cb = first();
+  CodeBlob* cb = first_blob(0, true);
   while (cb != NULL && !cb->is_nmethod()) {
-    cb = next(cb);
+    cb = next_blob(cb, true);
   }
   return (nmethod*)cb;
 }
 
 nmethod* CodeCache::next_nmethod (CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
-  cb = next(cb);
+  cb = next_blob(cb, true);
   while (cb != NULL && !cb->is_nmethod()) {
-    cb = next(cb);
+    cb = next_blob(cb, true);
   }
   return (nmethod*)cb;
 }
 
-static size_t maxCodeCacheUsed = 0;
+// Allocates a block in the given heap, expanding the heap if necessary.
+static CodeBlob* allocate_in_heap(CodeHeap* heap, int size, bool is_critical) {
+  while (true) {
+    CodeBlob* cb = (CodeBlob*)heap->allocate(size, is_critical);
+    if (cb != NULL) {
+      return cb;
+    }
+    if (!heap->expand_by(CodeCacheExpansionSize)) {
+      // Expansion failed
+      return NULL;
+    }
+    if (PrintCodeCacheExtension) {
+      ResourceMark rm;
+      tty->print_cr("%s extended to [" INTPTR_FORMAT ", " INTPTR_FORMAT "] (" SSIZE_FORMAT " bytes)",
+                    heap->name(), (intptr_t)heap->low_boundary(), (intptr_t)heap->high(),
+                    (address)heap->high() - (address)heap->low_boundary());
+    }
+  }
+}
 
-CodeBlob* CodeCache::allocate(int size, bool is_critical) {
+CodeBlob* CodeCache::allocate(int size, int code_blob_type, bool is_critical) {
   // Do not seize the CodeCache lock here--if the caller has not
   // already done so, we are going to lose bigtime, since the code
   // cache will contain a garbage CodeBlob until the caller can
@@ -181,24 +262,24 @@ CodeBlob* CodeCache::allocate(int size, bool is_critical) {
   // instantiating.
   guarantee(size >= 0, "allocation request must be reasonable");
   assert_locked_or_safepoint(CodeCache_lock);
-  CodeBlob* cb = NULL;
+  CodeHeap* heap = get_code_heap(code_blob_type);
+  assert(heap != NULL, "no code heap for this CodeBlobType");
   _number_of_blobs++;
-  while (true) {
-    cb = (CodeBlob*)_heap->allocate(size, is_critical);
-    if (cb != NULL) break;
-    if (!_heap->expand_by(CodeCacheExpansionSize)) {
-      // Expansion failed
-      return NULL;
-    }
-    if (PrintCodeCacheExtension) {
-      ResourceMark rm;
-      tty->print_cr("code cache extended to [" INTPTR_FORMAT ", " INTPTR_FORMAT "] (" SSIZE_FORMAT " bytes)",
-                    (intptr_t)_heap->low_boundary(), (intptr_t)_heap->high(),
-                    (address)_heap->high() - (address)_heap->low_boundary());
+  CodeBlob* cb = allocate_in_heap(heap, size, is_critical);
+  if (cb == NULL && SegmentedCodeCache) {
+    // Fallback solution: try to store the code in one of the method heaps.
+    // The sweeper looks at the free ratio of each method heap, so the heap
+    // that ran full still gets cleaned up.
+    for (int type = CodeBlobType::MethodNonProfiled; cb == NULL && type <= CodeBlobType::MethodProfiled; type++) {
+      CodeHeap* other = get_code_heap(type);
+      if (other != NULL && other != heap) {
+        cb = allocate_in_heap(other, size, is_critical);
+      }
     }
   }
-  maxCodeCacheUsed = MAX2(maxCodeCacheUsed, ((address)_heap->high_boundary() -
-                          (address)_heap->low_boundary()) - unallocated_capacity());
+  if (cb == NULL) {
+    return NULL;
+  }
   verify_if_often();
   print_trace("allocation", cb, size);
   return cb;
@@ -220,7 +301,7 @@ void CodeCache::free(CodeBlob* cb) {
   }
   _number_of_blobs--;
 
-  _heap->deallocate(cb);
+  get_code_heap(cb)->deallocate(cb);
 
   verify_if_often();
   assert(_number_of_blobs >= 0, "sanity check");
@@ -260,7 +341,7 @@ void CodeCache::flush() {
 
 bool CodeCache::contains(void *p) {
   // It should be ok to call contains without holding a lock
-  return _heap->contains(p);
+  return get_code_heap(p) != NULL;
 }
 
 
@@ -304,13 +385,14 @@ void CodeCache::alive_nmethods_do(void f(nmethod* nm)) {
   }
 }
 
+// All CodeHeaps use the same segment size
 int CodeCache::alignment_unit() {
-  return (int)_heap->alignment_unit();
+  return (int)_heaps->first()->alignment_unit();
 }
 
 
 int CodeCache::alignment_offset() {
-  return (int)_heap->alignment_offset();
+  return (int)_heaps->first()->alignment_offset();
 }
 
 
@@ -578,23 +660,183 @@ void CodeCache::verify_oops() {
 
 address CodeCache::first_address() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (address)_heap->low_boundary();
+  return low_bound();
 }
 
 
 address CodeCache::last_address() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (address)_heap->high();
+  return high();
+}
+
+address CodeCache::high() {
+  address result = NULL;
+  FOR_ALL_HEAPS(i) {
+    result = MAX2(result, (address)_heaps->at(i)->high());
+  }
+  return result;
+}
+
+size_t CodeCache::capacity() {
+  size_t cap = 0;
+  FOR_ALL_HEAPS(i) {
+    cap += _heaps->at(i)->capacity();
+  }
+  return cap;
+}
+
+size_t CodeCache::max_capacity() {
+  size_t max_cap = 0;
+  FOR_ALL_HEAPS(i) {
+    max_cap += _heaps->at(i)->max_capacity();
+  }
+  return max_cap;
+}
+
+size_t CodeCache::unallocated_capacity() {
+  size_t unallocated_cap = 0;
+  FOR_ALL_HEAPS(i) {
+    unallocated_cap += _heaps->at(i)->unallocated_capacity();
+  }
+  return unallocated_cap;
+}
+
+size_t CodeCache::unallocated_capacity(int code_blob_type) {
+  CodeHeap* heap = get_code_heap(code_blob_type);
+  return (heap != NULL) ? heap->unallocated_capacity() : 0;
+}
+
+static double heap_reverse_free_ratio(CodeHeap* heap) {
+  // Avoid division by 0 when the free space drops below CodeCacheMinimumFreeSpace
+  double unallocated_capacity = MAX2((double)heap->unallocated_capacity() - CodeCacheMinimumFreeSpace, 1.0);
+  double max_capacity = (double)heap->max_capacity();
+  return max_capacity / unallocated_capacity;
 }
 
 /**
  * Returns the reverse free ratio. E.g., if 25% (1/4) of the code cache
  * is free, reverse_free_ratio() returns 4.
  */
-double CodeCache::reverse_free_ratio() {
-  double unallocated_capacity = (double)(CodeCache::unallocated_capacity() - CodeCacheMinimumFreeSpace);
-  double max_capacity = (double)CodeCache::max_capacity();
-  return max_capacity / unallocated_capacity;
+double CodeCache::reverse_free_ratio(int code_blob_type) {
+  if (code_blob_type == CodeBlobType::All && SegmentedCodeCache) {
+    double ratio = 0.0;
+    FOR_ALL_HEAPS(i) {
+      CodeHeap* heap = _heaps->at(i);
+      if (is_method_heap(heap)) {
+        ratio = MAX2(ratio, heap_reverse_free_ratio(heap));
+      }
+    }
+    return ratio;
+  }
+  CodeHeap* heap = get_code_heap(code_blob_type);
+  assert(heap != NULL, "no code heap for this CodeBlobType");
+  return heap_reverse_free_ratio(heap);
+}
+
+ReservedCodeSpace CodeCache::reserve_heap_memory(size_t size) {
+  // Determine alignment
+  size_t page_size = os::vm_page_size();
+  if (os::can_execute_large_page_memory()) {
+    page_size = os::page_size_for_region_unaligned(size, 8);
+  }
+  const size_t granularity = os::vm_allocation_granularity();
+  const size_t r_align = MAX2(page_size, granularity);
+  const size_t r_size = align_size_up(size, r_align);
+  const size_t rs_align = page_size == (size_t) os::vm_page_size() ? 0 :
+    MAX2(page_size, granularity);
+
+  ReservedCodeSpace rs(r_size, rs_align, rs_align > 0);
+  if (!rs.is_reserved()) {
+    vm_exit_during_initialization("Could not reserve enough space for code cache");
+  }
+
+  // Initialize the bounds of the whole code cache
+  _low_bound = (address)rs.base();
+  _high_bound = _low_bound + rs.size();
+  return rs;
+}
+
+void CodeCache::add_heap(ReservedSpace rs, const char* name, int code_blob_type) {
+  // Check if heap is needed
+  if (!heap_available(code_blob_type)) {
+    return;
+  }
+
+  CodeHeap* heap = new CodeHeap(name, code_blob_type);
+  size_t size_initial = round_to(MIN2((size_t)InitialCodeCacheSize, rs.size()), os::vm_page_size());
+  if (!heap->reserve(rs, size_initial, CodeCacheSegmentSize)) {
+    vm_exit_during_initialization(err_msg("Could not reserve enough space for %s", name));
+  }
+  _heaps->append(heap);
+
+  // Register the CodeHeap
+  MemoryService::add_code_heap_memory_pool(heap, name);
+}
+
+void CodeCache::initialize_heaps() {
+  ReservedCodeSpace rs = reserve_heap_memory(ReservedCodeCacheSize);
+
+  if (!SegmentedCodeCache) {
+    // Use a single code heap for all types of code
+    add_heap(rs, "Code Cache", CodeBlobType::All);
+    return;
+  }
+
+  // The heaps are split at the alignment of the reservation so that
+  // large pages are not shared by two heaps.
+  const size_t alignment = MAX2(MAX2(rs.alignment(), (size_t)os::vm_page_size()),
+                                (size_t)os::vm_allocation_granularity());
+  const bool has_profiled_heap = heap_available(CodeBlobType::MethodProfiled);
+
+  // A size of 0 is determined ergonomically: the non-nmethod heap gets an
+  // eighth of the code cache up to 8M, the method heaps share the rest.
+  size_t non_nmethod_size = NonNMethodCodeHeapSize;
+  size_t profiled_size = has_profiled_heap ? ProfiledCodeHeapSize : 0;
+  size_t non_profiled_size = NonProfiledCodeHeapSize;
+  if (non_nmethod_size == 0) {
+    non_nmethod_size = MIN2(rs.size() / 8, (size_t)8*M);
+  }
+  non_nmethod_size = align_size_up(non_nmethod_size, alignment);
+  profiled_size = align_size_up(profiled_size, alignment);
+  non_profiled_size = align_size_up(non_profiled_size, alignment);
+
+  if (non_nmethod_size + profiled_size + non_profiled_size > rs.size()) {
+    vm_exit_during_initialization(err_msg("Invalid code heap sizes: "
+        "NonNMethodCodeHeapSize (" SIZE_FORMAT "K) + ProfiledCodeHeapSize (" SIZE_FORMAT "K) + "
+        "NonProfiledCodeHeapSize (" SIZE_FORMAT "K) must not exceed ReservedCodeCacheSize (" SIZE_FORMAT "K)",
+        non_nmethod_size/K, profiled_size/K, non_profiled_size/K, rs.size()/K));
+  }
+
+  // Distribute the remaining space among the method heaps that were not sized explicitly
+  size_t left = rs.size() - non_nmethod_size - profiled_size - non_profiled_size;
+  if (has_profiled_heap && profiled_size == 0 && non_profiled_size == 0) {
+    profiled_size = align_size_down(left / 2, alignment);
+    non_profiled_size = left - profiled_size;
+  } else if (has_profiled_heap && profiled_size == 0) {
+    profiled_size = left;
+  } else {
+    non_profiled_size += left;
+  }
+
+  const size_t min_size = align_size_up(CodeCacheMinimumFreeSpace, alignment) + alignment;
+  if (non_nmethod_size < min_size || non_profiled_size < min_size ||
+      (has_profiled_heap && profiled_size < min_size)) {
+    vm_exit_during_initialization(err_msg("Invalid code heap sizes: each code heap must be at least " SIZE_FORMAT "K", min_size/K));
+  }
+
+  FLAG_SET_ERGO(uintx, NonNMethodCodeHeapSize, non_nmethod_size);
+  FLAG_SET_ERGO(uintx, ProfiledCodeHeapSize, profiled_size);
+  FLAG_SET_ERGO(uintx, NonProfiledCodeHeapSize, non_profiled_size);
+
+  // Profiled nmethods | non-nmethods | non-profiled nmethods
+  ReservedSpace profiled_space     = rs.first_part(profiled_size, alignment);
+  ReservedSpace rest               = rs.last_part(profiled_size, alignment);
+  ReservedSpace non_method_space   = rest.first_part(non_nmethod_size, alignment);
+  ReservedSpace non_profiled_space = rest.last_part(non_nmethod_size, alignment);
+
+  add_heap(non_method_space, "CodeHeap 'non-nmethods'", CodeBlobType::NonNMethod);
+  add_heap(profiled_space, "CodeHeap 'profiled nmethods'", CodeBlobType::MethodProfiled);
+  add_heap(non_profiled_space, "CodeHeap 'non-profiled nmethods'", CodeBlobType::MethodNonProfiled);
 }
 
 void icache_init();
@@ -611,11 +853,7 @@ void CodeCache::initialize() {
   CodeCacheExpansionSize = round_to(CodeCacheExpansionSize, os::vm_page_size());
   InitialCodeCacheSize = round_to(InitialCodeCacheSize, os::vm_page_size());
   ReservedCodeCacheSize = round_to(ReservedCodeCacheSize, os::vm_page_size());
-  if (!_heap->reserve(ReservedCodeCacheSize, InitialCodeCacheSize, CodeCacheSegmentSize)) {
-    vm_exit_during_initialization("Could not reserve enough space for code cache");
-  }
-
-  MemoryService::add_code_heap_memory_pool(_heap);
+  initialize_heaps();
 
   // Initialize ICache flush mechanism
   // This service is needed for os::register_code_area
@@ -624,7 +862,7 @@ void CodeCache::initialize() {
   // Give OS a chance to register generated code area.
   // This is used on Windows 64 bit platforms to register
   // Structured Exception Handlers for our generated code.
-  os::register_code_area(_heap->low_boundary(), _heap->high_boundary());
+  os::register_code_area((char*)low_bound(), (char*)high_bound());
 }
 
 
@@ -769,7 +1007,9 @@ void CodeCache::make_marked_nmethods_not_entrant() {
 }
 
 void CodeCache::verify() {
-  _heap->verify();
+  FOR_ALL_HEAPS(i) {
+    _heaps->at(i)->verify();
+  }
   FOR_ALL_ALIVE_BLOBS(p) {
     p->verify();
   }
@@ -798,7 +1038,9 @@ void CodeCache::report_codemem_full() {
 
 void CodeCache::verify_if_often() {
   if (VerifyCodeCacheOften) {
-    _heap->verify();
+    FOR_ALL_HEAPS(i) {
+      _heaps->at(i)->verify();
+    }
   }
 }
 
@@ -970,17 +1212,28 @@ void CodeCache::print() {
 }
 
 void CodeCache::print_summary(outputStream* st, bool detailed) {
-  size_t total = (_heap->high_boundary() - _heap->low_boundary());
-  st->print_cr("CodeCache: size=" SIZE_FORMAT "Kb used=" SIZE_FORMAT
-               "Kb max_used=" SIZE_FORMAT "Kb free=" SIZE_FORMAT "Kb",
-               total/K, (total - unallocated_capacity())/K,
-               maxCodeCacheUsed/K, unallocated_capacity()/K);
+  FOR_ALL_HEAPS(i) {
+    CodeHeap* heap = _heaps->at(i);
+    size_t total = (heap->high_boundary() - heap->low_boundary());
+    if (SegmentedCodeCache) {
+      st->print("%s:", heap->name());
+    } else {
+      st->print("CodeCache:");
+    }
+    st->print_cr(" size=" SIZE_FORMAT "Kb used=" SIZE_FORMAT
+                 "Kb max_used=" SIZE_FORMAT "Kb free=" SIZE_FORMAT "Kb",
+                 total/K, (total - heap->unallocated_capacity())/K,
+                 heap->max_allocated_capacity()/K, heap->unallocated_capacity()/K);
+
+    if (detailed) {
+      st->print_cr(" bounds [" INTPTR_FORMAT ", " INTPTR_FORMAT ", " INTPTR_FORMAT "]",
+                   p2i(heap->low_boundary()),
+                   p2i(heap->high()),
+                   p2i(heap->high_boundary()));
+    }
+  }
 
   if (detailed) {
-    st->print_cr(" bounds [" INTPTR_FORMAT ", " INTPTR_FORMAT ", " INTPTR_FORMAT "]",
-                 p2i(_heap->low_boundary()),
-                 p2i(_heap->high()),
-                 p2i(_heap->high_boundary()));
     st->print_cr(" total_blobs=" UINT32_FORMAT " nmethods=" UINT32_FORMAT
                  " adapters=" UINT32_FORMAT,
                  nof_blobs(), nof_nmethods(), nof_adapters());
@@ -30,6 +30,8 @@
 #include "memory/heap.hpp"
 #include "oops/instanceKlass.hpp"
 #include "oops/oopsHierarchy.hpp"
+#include "runtime/virtualspace.hpp"
+#include "utilities/growableArray.hpp"
 
 // The CodeCache implements the code cache for various pieces of generated
 // code, e.g., compiled java methods, runtime stubs, transition frames, etc.
@@ -39,6 +41,19 @@
 //   - Each CodeBlob occupies one chunk of memory.
 //   - Like the offset table in oldspace the zone has at table for
 //     locating a method given a addess of an instruction.
+//
+// Code cache segmentation:
+//   With SegmentedCodeCache the code cache is split into separate
+//   CodeHeaps, one for each CodeBlobType:
+//   - Non-nmethods: adapters, runtime stubs, buffers and the interpreter
+//   - Profiled nmethods: code compiled at tier 2 and 3
+//   - Non-profiled nmethods: code compiled at tier 1 and 4, and native wrappers
+//   The heaps are carved out of one contiguous reservation, with the
+//   non-nmethod heap in the middle, so that the whole code cache still lies
+//   within [low_bound(), high_bound()). Keeping the short-lived profiled code
+//   apart from the long-lived optimized code reduces fragmentation, and the
+//   sweeper only has to walk the method heaps. Without segmentation there
+//   is a single CodeHeap for CodeBlobType::All.
 
 class OopClosure;
 class DepChange;
@@ -46,11 +61,13 @@ class DepChange;
 class CodeCache : AllStatic {
   friend class VMStructs;
  private:
-  // CodeHeap is malloc()'ed at startup and never deleted during shutdown,
+  // CodeHeaps are malloc()'ed at startup and never deleted during shutdown,
   // so that the generated assembly code is always there when it's needed.
   // This may cause memory leak, but is necessary, for now. See 4423824,
   // 4422213 or 4436291 for details.
-  static CodeHeap * _heap;
+  static GrowableArray<CodeHeap*>* _heaps;
+  static address _low_bound;                 // Lower bound of the whole code cache
+  static address _high_bound;                // Upper bound of the whole code cache
   static int _number_of_blobs;
   static int _number_of_adapters;
   static int _number_of_nmethods;
@@ -69,6 +86,20 @@ class CodeCache : AllStatic {
   static void prune_scavenge_root_nmethods();
   static void unlink_scavenge_root_nmethod(nmethod* nm, nmethod* prev);
 
+  // CodeHeap management
+  static void initialize_heaps();                              // Initializes the CodeHeaps
+  static ReservedCodeSpace reserve_heap_memory(size_t size);   // Reserves one contiguous chunk of memory for the CodeHeaps
+  static void add_heap(ReservedSpace rs, const char* name, int code_blob_type);
+  static CodeHeap* get_code_heap(const void* cb);              // Returns the CodeHeap for the given CodeBlob
+  static CodeHeap* get_code_heap(int code_blob_type);          // Returns the CodeHeap for the given CodeBlobType
+  static bool heap_available(int code_blob_type);              // Returns whether a heap for the CodeBlobType is needed
+
+  // Iteration over the CodeHeaps. If method_heaps_only is set, the
+  // NonNMethod heap is skipped.
+  static bool is_method_heap(CodeHeap* heap)  { return heap->code_blob_type() != CodeBlobType::NonNMethod; }
+  static CodeBlob* first_blob(int index, bool method_heaps_only); // first blob in the heaps starting at index
+  static CodeBlob* next_blob(CodeBlob* cb, bool method_heaps_only); // blob following cb, possibly in a later heap
+
  public:
 
   // Initialization
@@ -77,7 +108,7 @@ class CodeCache : AllStatic {
   static void report_codemem_full();
 
   // Allocation/administration
-  static CodeBlob* allocate(int size, bool is_critical = false); // allocates a new CodeBlob
+  static CodeBlob* allocate(int size, int code_blob_type, bool is_critical = false); // allocates a new CodeBlob
   static void commit(CodeBlob* cb);                 // called when the allocated CodeBlob has been filled
   static int alignment_unit();                      // guaranteed alignment of all CodeBlobs
   static int alignment_offset();                    // guaranteed offset of first CodeBlob byte within alignment unit (i.e., allocation header)
@@ -97,9 +128,10 @@ class CodeCache : AllStatic {
   // what you are doing)
   static CodeBlob* find_blob_unsafe(void* start) {
     // NMT can walk the stack before code cache is created
-    if (_heap == NULL) return NULL;
+    CodeHeap* heap = get_code_heap(start);
+    if (heap == NULL) return NULL;
 
-    CodeBlob* result = (CodeBlob*)_heap->find_start(start);
+    CodeBlob* result = (CodeBlob*)heap->find_start(start);
     // this assert is too strong because the heap code will return the
     // heapblock containing start. That block can often be larger than
     // the codeBlob itself. If you look up an address that is within
@@ -124,6 +156,7 @@ class CodeCache : AllStatic {
   static CodeBlob* next (CodeBlob* cb);
   static CodeBlob* alive(CodeBlob *cb);
   static nmethod* alive_nmethod(CodeBlob *cb);
+  // Iterate only over the method heaps, so the NonNMethod heap is skipped
   static nmethod* first_nmethod();
   static nmethod* next_nmethod (CodeBlob* cb);
   static int       nof_blobs()                 { return _number_of_blobs; }
@@ -160,17 +193,39 @@ class CodeCache : AllStatic {
   static void log_state(outputStream* st);
 
   // The full limits of the codeCache
-  static address  low_bound()                    { return (address) _heap->low_boundary(); }
-  static address  high_bound()                   { return (address) _heap->high_boundary(); }
-  static address  high()                         { return (address) _heap->high(); }
+  static address  low_bound()                    { return _low_bound; }
+  static address  high_bound()                   { return _high_bound; }
+  static address  high();                        // highest committed address of all CodeHeaps
 
   // Profiling
   static address first_address();                // first address used for CodeBlobs
   static address last_address();                 // last  address used for CodeBlobs
-  static size_t  capacity()                      { return _heap->capacity(); }
-  static size_t  max_capacity()                  { return _heap->max_capacity(); }
-  static size_t  unallocated_capacity()          { return _heap->unallocated_capacity(); }
-  static double  reverse_free_ratio();
+  static size_t  capacity();
+  static size_t  max_capacity();
+  static size_t  unallocated_capacity();
+  static size_t  unallocated_capacity(int code_blob_type);
+  // The reverse free ratio of the CodeHeap for code_blob_type. For
+  // CodeBlobType::All the largest ratio of the method heaps is returned,
+  // i.e., that of the fullest heap holding nmethods.
+  static double  reverse_free_ratio(int code_blob_type = CodeBlobType::All);
+
+  // Returns the CodeBlobType for the given compilation level
+  static int get_code_blob_type(int comp_level) {
+    if (!SegmentedCodeCache) {
+      return CodeBlobType::All;
+    }
+    if (comp_level == CompLevel_limited_profile ||
+        comp_level == CompLevel_full_profile) {
+      // Profiled methods
+      return CodeBlobType::MethodProfiled;
+    }
+    // Non profiled methods, including native wrappers (CompLevel_none)
+    return CodeBlobType::MethodNonProfiled;
+  }
+  // Returns the CodeBlobType of the CodeHeap holding the given CodeBlob
+  static int get_code_blob_type(CodeBlob* cb) {
+    return get_code_heap(cb)->code_blob_type();
+  }
 
   static bool needs_cache_clean()                { return _needs_cache_clean; }
   static void set_needs_cache_clean(bool v)      { _needs_cache_clean = v;    }
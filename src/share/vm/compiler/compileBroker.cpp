@@ -1784,16 +1784,19 @@ void CompileBroker::compiler_thread_loop() {
     // We need this HandleMark to avoid leaking VM handles.
     HandleMark hm(thread);
 
-    if (CodeCache::unallocated_capacity() < CodeCacheMinimumFreeSpace) {
-      // the code cache is really full
-      handle_full_code_cache();
-    }
-
     CompileTask* task = queue->get();
     if (task == NULL) {
       continue;
     }
 
+    // With a segmented code cache, look at the CodeHeap the
+    // compilation allocates its nmethod in rather than the total.
+    int code_blob_type = CodeCache::get_code_blob_type(task->comp_level());
+    if (CodeCache::unallocated_capacity(code_blob_type) < CodeCacheMinimumFreeSpace) {
+      // the code cache is really full
+      handle_full_code_cache();
+    }
+
     // Give compiler threads an extra quanta.  They tend to be bursty and
     // this helps the compiler to finish up the job.
     if( CompilerThreadHintNoPreempt )
@@ -148,9 +148,25 @@ CompactibleFreeListSpace::CompactibleFreeListSpace(BlockOffsetSharedArray* bs,
   }
   check_free_list_consistency();
 
+  _par_batch_pool = NULL;
+  _par_batch_pool_size = 0;
+  _par_batch_pool_top = 0;
+  for (size_t i = 0; i < IndexSetSize; i++) {
+    _par_batches[i] = NULL;
+  }
+  reset_par_lab_stats();
+
   // Initialize locks for parallel case.
 
   if (CollectedHeap::use_parallel_gc_threads()) {
+    if (CMSParPromoteSharedBatches > 0) {
+      _par_batch_pool_size = (uint)ParallelGCThreads * ParBatchesPerWorker;
+      _par_batch_pool = NEW_C_HEAP_ARRAY(ParBatch, _par_batch_pool_size, mtGC);
+      for (uint i = 0; i < _par_batch_pool_size; i++) {
+        _par_batch_pool[i]._blocks.initialize();
+        _par_batch_pool[i]._next = NULL;
+      }
+    }
     for (size_t i = IndexSetStart; i < IndexSetSize; i += IndexSetStride) {
       _indexedFreeListParLocks[i] = new Mutex(Mutex::leaf - 1, // == ExpandHeap_lock - 1
                                               "a freelist par lock",
@@ -2246,6 +2262,72 @@ bool CompactibleFreeListSpace::coalOverPopulated(size_t size) {
   }
 }
 
+// The lock protecting the free list of chunks of "size" against the
+// other threads of a parallel sweep.
+Mutex* CompactibleFreeListSpace::par_lock_for_size(size_t size) {
+  assert(CollectedHeap::use_parallel_gc_threads(),
+         "the exact free list locks only exist with parallel GC threads");
+  if (size < SmallForDictionary) {
+    return _indexedFreeListParLocks[size];
+  }
+  return parDictionaryAllocLock();
+}
+
+bool CompactibleFreeListSpace::par_coalOverPopulated(size_t size) {
+  MutexLockerEx x(par_lock_for_size(size), Mutex::_no_safepoint_check_flag);
+  return coalOverPopulated(size);
+}
+
+// The indexed free lists are updated directly rather than through
+// removeFreeChunkFromFreeLists() and addChunkToFreeLists(), whose lock
+// checks and free list verification assume that the whole space is
+// locked.
+void CompactibleFreeListSpace::par_removeFreeChunkFromFreeLists(FreeChunk* fc,
+                                                                bool coalesced) {
+  size_t size = fc->size();
+  MutexLockerEx x(par_lock_for_size(size), Mutex::_no_safepoint_check_flag);
+  if (coalesced) {
+    coalDeath(size);
+  }
+  if (size < SmallForDictionary) {
+    _bt.verify_single_block((HeapWord*)fc, size);
+    _indexedFreeList[size].remove_chunk(fc);
+  } else {
+    removeChunkFromDictionary(fc);
+  }
+}
+
+void CompactibleFreeListSpace::par_addChunkAndRepairOffsetTable(HeapWord* chunk,
+                                                                size_t size,
+                                                                bool coalesced) {
+  assert(chunk != NULL && is_in_reserved(chunk), "Not in this space!");
+  MutexLockerEx x(par_lock_for_size(size), Mutex::_no_safepoint_check_flag);
+  if (coalesced) {
+    coalBirth(size);
+    // repair BOT
+    _bt.single_block(chunk, size);
+  }
+  _bt.verify_single_block(chunk, size);
+  FreeChunk* fc = (FreeChunk*) chunk;
+  fc->set_size(size);
+  debug_only(fc->mangleFreed(size));
+  if (size < SmallForDictionary) {
+    _bt.verify_not_unallocated(chunk, size);
+    if (_adaptive_freelists) {
+      _indexedFreeList[size].return_chunk_at_tail(fc);
+    } else {
+      _indexedFreeList[size].return_chunk_at_head(fc);
+    }
+  } else {
+    returnChunkToDictionary(fc);
+  }
+}
+
+bool CompactibleFreeListSpace::par_verify_chunk_in_free_list(FreeChunk* fc) {
+  MutexLockerEx x(par_lock_for_size(fc->size()), Mutex::_no_safepoint_check_flag);
+  return verify_chunk_in_free_list(fc);
+}
+
 void CompactibleFreeListSpace::smallCoalBirth(size_t size) {
   assert(size < SmallForDictionary, "Size too large for indexed list");
   AdaptiveFreeList<FreeChunk> *fl = &_indexedFreeList[size];
@@ -2591,6 +2673,20 @@ void CompactibleFreeListSpace::printFLCensus(size_t sweep_count) const {
      x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x,   \
      x }
 
+// Locks one of the locks of the global pool like MutexLockerEx without
+// safepoint check, counting whether another GC worker held it.
+class CFLSParLocker : public StackObj {
+  Mutex* _lock;
+ public:
+  CFLSParLocker(Mutex* lock, volatile jint* contentions) : _lock(lock) {
+    if (!_lock->try_lock()) {
+      Atomic::inc(contentions);
+      _lock->lock_without_safepoint_check();
+    }
+  }
+  ~CFLSParLocker() { _lock->unlock(); }
+};
+
 // Initialize with default setting of CMSParPromoteBlocksToClaim, _not_
 // OldPLABSize, whose static default is different; if overridden at the
 // command-line, this will get reinitialized via a call to
@@ -2601,7 +2697,9 @@ size_t CFLS_LAB::_global_num_blocks[]  = VECTOR_257(0);
 uint   CFLS_LAB::_global_num_workers[] = VECTOR_257(0);
 
 CFLS_LAB::CFLS_LAB(CompactibleFreeListSpace* cfls) :
-  _cfls(cfls)
+  _cfls(cfls),
+  _num_refills(0),
+  _num_batch_refills(0)
 {
   assert(CompactibleFreeListSpace::IndexSetSize == 257, "Modify VECTOR_257() macro above");
   for (size_t i = CompactibleFreeListSpace::IndexSetStart;
@@ -2629,8 +2727,8 @@ HeapWord* CFLS_LAB::alloc(size_t word_sz) {
   assert(word_sz == _cfls->adjustObjectSize(word_sz), "Error");
   if (word_sz >=  CompactibleFreeListSpace::IndexSetSize) {
     // This locking manages sync with other large object allocations.
-    MutexLockerEx x(_cfls->parDictionaryAllocLock(),
-                    Mutex::_no_safepoint_check_flag);
+    CFLSParLocker x(_cfls->parDictionaryAllocLock(),
+                    &_cfls->_par_lock_contentions);
     res = _cfls->getChunkFromDictionaryExact(word_sz);
     if (res == NULL) return NULL;
   } else {
@@ -2679,7 +2777,13 @@ void CFLS_LAB::get_from_global_pool(size_t word_sz, AdaptiveFreeList<FreeChunk>*
     n_blks = MIN2(n_blks, CMSOldPLABMax);
   }
   assert(n_blks > 0, "Error");
-  _cfls->par_get_chunk_of_blocks(word_sz, n_blks, fl);
+  _num_refills++;
+  if (_cfls->par_get_batch(word_sz, fl)) {
+    // Another worker took these for us, no need to lock the global pool.
+    _num_batch_refills++;
+  } else {
+    _cfls->par_get_chunk_of_blocks(word_sz, n_blks, fl);
+  }
   // Update stats table entry for this block size
   _num_blocks[word_sz] += fl->count();
 }
@@ -2748,6 +2852,10 @@ void CFLS_LAB::retire(int tid) {
       _num_blocks[i]         = 0;
     }
   }
+  _cfls->_par_lab_refills += _num_refills;
+  _cfls->_par_lab_batch_refills += _num_batch_refills;
+  _num_refills = 0;
+  _num_batch_refills = 0;
 }
 
 // Used by par_get_chunk_of_blocks() for the chunks from the
@@ -2771,8 +2879,8 @@ bool CompactibleFreeListSpace:: par_get_chunk_of_blocks_IFL(size_t word_sz, size
       AdaptiveFreeList<FreeChunk> fl_for_cur_sz;  // Empty.
       fl_for_cur_sz.set_size(cur_sz);
       {
-        MutexLockerEx x(_indexedFreeListParLocks[cur_sz],
-                        Mutex::_no_safepoint_check_flag);
+        CFLSParLocker x(_indexedFreeListParLocks[cur_sz],
+                        &_par_lock_contentions);
         AdaptiveFreeList<FreeChunk>* gfl = &_indexedFreeList[cur_sz];
         if (gfl->count() != 0) {
           // nn is the number of chunks of size cur_sz that
@@ -2832,8 +2940,8 @@ bool CompactibleFreeListSpace:: par_get_chunk_of_blocks_IFL(size_t word_sz, size
         }
         // Update birth stats for this block size.
         size_t num = fl->count();
-        MutexLockerEx x(_indexedFreeListParLocks[word_sz],
-                        Mutex::_no_safepoint_check_flag);
+        CFLSParLocker x(_indexedFreeListParLocks[word_sz],
+                        &_par_lock_contentions);
         ssize_t births = _indexedFreeList[word_sz].split_births() + num;
         _indexedFreeList[word_sz].set_split_births(births);
         return true;
@@ -2849,8 +2957,7 @@ FreeChunk* CompactibleFreeListSpace::get_n_way_chunk_to_split(size_t word_sz, si
   FreeChunk* rem_fc = NULL;
   size_t rem;
   {
-    MutexLockerEx x(parDictionaryAllocLock(),
-                    Mutex::_no_safepoint_check_flag);
+    CFLSParLocker x(parDictionaryAllocLock(), &_par_lock_contentions);
     while (n > 0) {
       fc = dictionary()->get_chunk(MAX2(n * word_sz, _dictionary->min_size()),
                                   FreeBlockDictionary<FreeChunk>::atLeast);
@@ -2916,8 +3023,7 @@ FreeChunk* CompactibleFreeListSpace::get_n_way_chunk_to_split(size_t word_sz, si
     }
   }
   if (rem_fc != NULL) {
-    MutexLockerEx x(_indexedFreeListParLocks[rem],
-                    Mutex::_no_safepoint_check_flag);
+    CFLSParLocker x(_indexedFreeListParLocks[rem], &_par_lock_contentions);
     _bt.verify_not_unallocated((HeapWord*)rem_fc, rem_fc->size());
     _indexedFreeList[rem].return_chunk_at_head(rem_fc);
     smallSplitBirth(rem);
@@ -2975,8 +3081,7 @@ void CompactibleFreeListSpace:: par_get_chunk_of_blocks_dictionary(size_t word_s
   assert((ssize_t)n > 0 && (ssize_t)n == fl->count(), "Incorrect number of blocks");
   {
     // Update the stats for this block size.
-    MutexLockerEx x(_indexedFreeListParLocks[word_sz],
-                    Mutex::_no_safepoint_check_flag);
+    CFLSParLocker x(_indexedFreeListParLocks[word_sz], &_par_lock_contentions);
     const ssize_t births = _indexedFreeList[word_sz].split_births() + n;
     _indexedFreeList[word_sz].set_split_births(births);
     // ssize_t new_surplus = _indexedFreeList[word_sz].surplus() + n;
@@ -2992,13 +3097,81 @@ void CompactibleFreeListSpace:: par_get_chunk_of_blocks(size_t word_sz, size_t n
   assert(word_sz < CompactibleFreeListSpace::IndexSetSize,
          "Precondition");
 
-  if (par_get_chunk_of_blocks_IFL(word_sz, n, fl)) {
-    // Got it
-    return;
+  // Take blocks for some other workers too while holding the locks, they
+  // get them through the batches without locking.
+  size_t n_claim = n;
+  if (_par_batch_pool_top < (jint)_par_batch_pool_size) {
+    n_claim = n * (1 + CMSParPromoteSharedBatches);
+  }
+
+  if (!par_get_chunk_of_blocks_IFL(word_sz, n_claim, fl)) {
+    // Otherwise, we'll split a block from the dictionary.
+    par_get_chunk_of_blocks_dictionary(word_sz, n_claim, fl);
   }
+  par_share_blocks(word_sz, n, fl);
+}
 
-  // Otherwise, we'll split a block from the dictionary.
-  par_get_chunk_of_blocks_dictionary(word_sz, n, fl);
+CompactibleFreeListSpace::ParBatch* CompactibleFreeListSpace::new_par_batch() {
+  if (_par_batch_pool_top >= (jint)_par_batch_pool_size) {
+    return NULL;
+  }
+  jint index = Atomic::add(1, &_par_batch_pool_top) - 1;
+  if (index >= (jint)_par_batch_pool_size) {
+    return NULL;
+  }
+  ParBatch* batch = &_par_batch_pool[index];
+  batch->_blocks.reset();
+  return batch;
+}
+
+void CompactibleFreeListSpace::par_share_blocks(size_t word_sz, size_t n, AdaptiveFreeList<FreeChunk>* fl) {
+  while ((size_t)fl->count() >= 2 * n) {
+    ParBatch* batch = new_par_batch();
+    if (batch == NULL) {
+      // Out of descriptors, the refilling LAB keeps the rest.
+      return;
+    }
+    batch->_blocks.set_size(word_sz);
+    fl->getFirstNChunksFromList(n, &batch->_blocks);
+    ParBatch* volatile* top = &_par_batches[word_sz];
+    ParBatch* cur_top = *top;
+    while (true) {
+      batch->_next = cur_top;
+      ParBatch* result = (ParBatch*)Atomic::cmpxchg_ptr(batch, top, cur_top);
+      if (result == cur_top) {
+        break;
+      }
+      cur_top = result;
+    }
+  }
+}
+
+// Lock-free.  A batch is never pushed again within a scavenge, so a
+// successful CAS of the top cannot have missed a pop and push of it.
+bool CompactibleFreeListSpace::par_get_batch(size_t word_sz, AdaptiveFreeList<FreeChunk>* fl) {
+  assert(fl->count() == 0, "Precondition.");
+  ParBatch* volatile* top = &_par_batches[word_sz];
+  ParBatch* batch = *top;
+  while (batch != NULL) {
+    ParBatch* result = (ParBatch*)Atomic::cmpxchg_ptr(batch->_next, top, batch);
+    if (result == batch) {
+      fl->prepend(&batch->_blocks);
+      return true;
+    }
+    batch = result;
+  }
+  return false;
+}
+
+void CompactibleFreeListSpace::par_return_batches() {
+  assert(SafepointSynchronize::is_at_safepoint(), "world should be stopped");
+  for (size_t i = IndexSetStart; i < IndexSetSize; i += IndexSetStride) {
+    for (ParBatch* batch = _par_batches[i]; batch != NULL; batch = batch->_next) {
+      _indexedFreeList[i].prepend(&batch->_blocks);
+    }
+    _par_batches[i] = NULL;
+  }
+  _par_batch_pool_top = 0;
 }
 
 // Set up the space's par_seq_tasks structure for work claiming
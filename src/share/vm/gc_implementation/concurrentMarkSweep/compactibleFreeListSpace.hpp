@@ -74,6 +74,8 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   friend class CMSCollector;
   // Local alloc buffer for promotion into this space.
   friend class CFLS_LAB;
+  // Parallel sweepers serialize on the parDictionaryAllocLock.
+  friend class SweepClosure;
 
   // "Size" of chunks of work (executed during parallel remark phases
   // of CMS collection); this probably belongs in CMSCollector, although
@@ -166,6 +168,39 @@ class CompactibleFreeListSpace: public CompactibleSpace {
 
   // Locks protecting the exact lists during par promotion allocation.
   Mutex* _indexedFreeListParLocks[IndexSetSize];
+  // The one of the locks above, or the parDictionaryAllocLock, that
+  // protects the free list of chunks of the given size.
+  Mutex* par_lock_for_size(size_t size);
+
+  // Batches of blocks of one size that a CFLS_LAB refill took from the
+  // exact lists or the dictionary on behalf of the other GC worker
+  // threads.  They are kept on per-size lock-free stacks, so that a refill
+  // can take a whole batch with a single CAS instead of the locks above.
+  // The batch descriptors are handed out from a pool and are not reused
+  // within a scavenge, so popping does not suffer from ABA.  The blocks
+  // left over are returned to the exact lists once the LABs are retired.
+  class ParBatch VALUE_OBJ_CLASS_SPEC {
+   public:
+    FreeList<FreeChunk> _blocks;
+    ParBatch*           _next;
+  };
+  enum { ParBatchesPerWorker = 64 };
+  ParBatch*          _par_batch_pool;
+  uint               _par_batch_pool_size;
+  volatile jint      _par_batch_pool_top;
+  ParBatch* volatile _par_batches[IndexSetSize];
+
+  // Contention statistics of the CFLS_LAB refills of the current
+  // scavenge, collected into CMSStats at its end.
+  size_t        _par_lab_refills;
+  size_t        _par_lab_batch_refills;
+  volatile jint _par_lock_contentions;
+
+  ParBatch* new_par_batch();
+  // Move all but "n" of the blocks on "fl" to batches of "n" blocks.
+  void par_share_blocks(size_t word_sz, size_t n, AdaptiveFreeList<FreeChunk>* fl);
+  // Take a batch of blocks of size "word_sz" onto the empty "fl".
+  bool par_get_batch(size_t word_sz, AdaptiveFreeList<FreeChunk>* fl);
 
   // Attempt to obtain up to "n" blocks of the size "word_sz" (which is
   // required to be smaller than "IndexSetSize".)  If successful,
@@ -322,6 +357,20 @@ class CompactibleFreeListSpace: public CompactibleSpace {
 
   void set_collector(CMSCollector* collector) { _collector = collector; }
 
+  // Return the blocks of the batches nobody took to the exact lists.
+  // Called with the world stopped after the CFLS_LABs are retired.
+  void par_return_batches();
+
+  // Refill statistics of the promotion LABs since the last reset.
+  size_t par_lab_refills() const       { return _par_lab_refills; }
+  size_t par_lab_batch_refills() const { return _par_lab_batch_refills; }
+  size_t par_lock_contentions() const  { return (size_t)_par_lock_contentions; }
+  void reset_par_lab_stats() {
+    _par_lab_refills = 0;
+    _par_lab_batch_refills = 0;
+    _par_lock_contentions = 0;
+  }
+
   // Support for parallelization of rescan and marking
   const size_t rescan_task_size()  const { return _rescan_task_size;  }
   const size_t marking_task_size() const { return _marking_task_size; }
@@ -572,6 +621,19 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   // Return true if the count of free chunks is greater
   // than the desired number of free chunks.
   bool coalOverPopulated(size_t size);
+  // As above, for the threads of a parallel sweep.
+  bool par_coalOverPopulated(size_t size);
+
+  // The free list updates of the threads of a parallel sweep.  Each
+  // takes only the lock of the list for the chunk's size: the indexed
+  // free list lock, as CFLS_LAB does, or the parDictionaryAllocLock.
+  // Remove a free chunk, recording a coalesce death if "coalesced".
+  void par_removeFreeChunkFromFreeLists(FreeChunk* fc, bool coalesced);
+  // Add a chunk, repairing the BOT and recording a coalesce birth if
+  // "coalesced".
+  void par_addChunkAndRepairOffsetTable(HeapWord* chunk, size_t size,
+                                        bool coalesced);
+  bool par_verify_chunk_in_free_list(FreeChunk* fc);
 
 // Record (for each size):
 //
@@ -660,6 +722,11 @@ class CFLS_LAB : public CHeapObj<mtGC> {
   static uint   _global_num_workers[CompactibleFreeListSpace::IndexSetSize];
   size_t        _num_blocks        [CompactibleFreeListSpace::IndexSetSize];
 
+  // Refills of this LAB since it was last retired, and how many of them
+  // were satisfied with a batch shared by another worker.
+  size_t        _num_refills;
+  size_t        _num_batch_refills;
+
   // Internal work method
   void get_from_global_pool(size_t word_sz, AdaptiveFreeList<FreeChunk>* fl);
 
@@ -225,6 +225,11 @@ ConcurrentMarkSweepGeneration::ConcurrentMarkSweepGeneration(
       "CompactibleFreeListSpace allocation failure");
   }
   _cmsSpace->_gen = this;
+  if (UseNUMA) {
+    // Promotion and scanning reach the old gen from all nodes, so its
+    // pages are interleaved rather than placed by first touch.
+    os::numa_make_global((char*)bottom, pointer_delta(end, bottom, sizeof(char)));
+  }
 
   _gc_stats = new CMSGCStats();
 
@@ -366,6 +371,9 @@ CMSStats::CMSStats(ConcurrentMarkSweepGeneration* cms_gen, unsigned int alpha):
   _gc0_duration = 0.0;
   _gc0_period = 0.0;
   _gc0_promoted = 0;
+  _gc0_lab_refills = 0;
+  _gc0_lab_batch_refills = 0;
+  _gc0_lab_contended_locks = 0;
 
   _cms_duration = 0.0;
   _cms_period = 0.0;
@@ -524,6 +532,9 @@ void CMSStats::print_on(outputStream *st) const {
   st->print(" gc0_alpha=%d,cms_alpha=%d", _gc0_alpha, _cms_alpha);
   st->print(",gc0_dur=%g,gc0_per=%g,gc0_promo=" SIZE_FORMAT,
                gc0_duration(), gc0_period(), gc0_promoted());
+  st->print(",gc0_lab_refills=" SIZE_FORMAT ",gc0_lab_batch_refills=" SIZE_FORMAT
+            ",gc0_lab_contended=" SIZE_FORMAT,
+            gc0_lab_refills(), gc0_lab_batch_refills(), gc0_lab_contended_locks());
   st->print(",cms_dur=%g,cms_dur_per_mb=%g,cms_per=%g,cms_alloc=" SIZE_FORMAT,
             cms_duration(), cms_duration_per_mb(),
             cms_period(), cms_allocated());
@@ -1462,6 +1473,9 @@ ConcurrentMarkSweepGeneration::
 par_promote_alloc_done(int thread_num) {
   CMSParGCThreadState* ps = _par_gc_thread_states[thread_num];
   ps->lab.retire(thread_num);
+  // Give back the blocks of shared batches no LAB took.  Only the
+  // first call finds any.
+  _cmsSpace->par_return_batches();
 }
 
 void
@@ -3498,8 +3512,12 @@ void ConcurrentMarkSweepGeneration::shrink(size_t bytes) {
 
 bool ConcurrentMarkSweepGeneration::grow_by(size_t bytes) {
   assert_locked_or_safepoint(Heap_lock);
+  char* old_high = _virtual_space.high();
   bool result = _virtual_space.expand_by(bytes);
   if (result) {
+    if (UseNUMA) {
+      os::numa_make_global(old_high, pointer_delta(_virtual_space.high(), old_high, sizeof(char)));
+    }
     size_t new_word_size =
       heap_word_size(_virtual_space.committed_size());
     MemRegion mr(_cmsSpace->bottom(), new_word_size);
@@ -3895,7 +3913,9 @@ class CMSConcMarkingTerminator: public ParallelTaskTerminator {
   // "collector" is the CMS collector associated with this task terminator.
   // "yield" indicates whether we need the gang as a whole to yield.
   CMSConcMarkingTerminator(int n_threads, TaskQueueSetSuper* queue_set, CMSCollector* collector) :
-    ParallelTaskTerminator(n_threads, queue_set),
+    // The yield() below must keep being called to yield to a foreground
+    // collection, so the threads may not block.
+    ParallelTaskTerminator(n_threads, queue_set, false /* can_block */),
     _collector(collector) { }
 
   void set_task(CMSConcMarkingTask* task) {
@@ -4715,6 +4735,11 @@ size_t CMSCollector::preclean_work(bool clean_refs, bool clean_survivor) {
     rp->preclean_discovered_references(
           rp->is_alive_non_header(), &keep_alive, &complete_trace, &yield_cl,
           gc_timer, _gc_tracer_cm->gc_id());
+    if (PrecleanFinalReferents) {
+      rp->preclean_final_referents(
+            rp->is_alive_non_header(), &keep_alive, &complete_trace, &yield_cl,
+            gc_timer, _gc_tracer_cm->gc_id());
+    }
   }
 
   if (clean_survivor) {  // preclean the active survivor space(s)
@@ -6506,6 +6531,241 @@ void ConcurrentMarkSweepGeneration::rotate_debug_collection_type() {
   }
 }
 
+// MT Concurrent Sweeping Task
+//
+// The swept part of the space is divided into address ranges that
+// start and end at block boundaries, computed up front while the
+// coordinator holds the free list and bit map locks.  The workers
+// claim the ranges in turn and sweep each with a SweepClosure of its
+// own; the coordinator holds the locks on their behalf, and the free
+// list updates of the workers are serialized by the
+// parDictionaryAllocLock.  A free run spanning a seam between two
+// ranges is returned to the free lists as two chunks, which are
+// coalesced by the coordinator once all the ranges have been swept.
+class CMSParSweepTask: public YieldingFlexibleGangTask {
+  CMSCollector*                  _collector;
+  ConcurrentMarkSweepGeneration* _gen;
+  bool                           _asynch;
+  // The ranges are [_boundaries[i], _boundaries[i + 1]).
+  HeapWord**                     _boundaries;
+  uint                           _n_ranges;
+  char                           _pad_front[64];   // padding to ...
+  volatile jint                  _next_range;      // ... avoid sharing cache line
+  char                           _pad_back[64];
+  // The ends of the free range returned at the start of each range,
+  // and the starts of those returned at the end of each range.
+  HeapWord**                     _leading_free_range_end;
+  HeapWord**                     _trailing_free_range;
+
+  // Re-sweep the two free chunks [left, seam) and [seam, right_end)
+  // if both are still there; returns the start of the chunk ending at
+  // right_end afterwards.
+  HeapWord* coalesce_at_seam(HeapWord* left, HeapWord* seam,
+                             HeapWord* right_end);
+
+ public:
+  // Number of ranges per worker, for some load balancing.
+  enum { RangesPerWorker = 4 };
+
+  CMSParSweepTask(CMSCollector* collector,
+                  ConcurrentMarkSweepGeneration* gen,
+                  bool asynch,
+                  HeapWord** boundaries,
+                  uint n_ranges):
+    YieldingFlexibleGangTask("Concurrent sweeping done multi-threaded"),
+    _collector(collector),
+    _gen(gen),
+    _asynch(asynch),
+    _boundaries(boundaries),
+    _n_ranges(n_ranges),
+    _next_range(0)
+  {
+    _leading_free_range_end = NEW_C_HEAP_ARRAY(HeapWord*, n_ranges, mtGC);
+    _trailing_free_range = NEW_C_HEAP_ARRAY(HeapWord*, n_ranges, mtGC);
+    for (uint i = 0; i < n_ranges; i++) {
+      _leading_free_range_end[i] = NULL;
+      _trailing_free_range[i] = NULL;
+    }
+  }
+
+  ~CMSParSweepTask() {
+    FREE_C_HEAP_ARRAY(HeapWord*, _leading_free_range_end, mtGC);
+    FREE_C_HEAP_ARRAY(HeapWord*, _trailing_free_range, mtGC);
+  }
+
+  void work(uint worker_id);
+  virtual void coordinator_yield();  // stuff done by coordinator
+
+  // Coalesce the free chunks on either side of each seam; done by
+  // the coordinator after the task has completed.
+  void coalesce_at_seams();
+};
+
+void CMSParSweepTask::work(uint worker_id) {
+  elapsedTimer _timer;
+  _timer.start();
+  uint n_swept = 0;
+  jint i;
+  while ((i = Atomic::add(1, &_next_range) - 1) < (jint)_n_ranges) {
+    MemRegion span(_boundaries[i], _boundaries[i + 1]);
+    SweepClosure cl(_collector, _gen, &_collector->_markBitMap, span,
+                    CMSYield && _asynch, this);
+    // As in blk_iterate_careful(), the closure steps to the end of the
+    // space once it has reached its limit.
+    HeapWord* cur = span.start();
+    HeapWord* end = _gen->cmsSpace()->end();
+    while (cur < end) {
+      cur += cl.do_blk_careful(cur);
+    }
+    _leading_free_range_end[i] = cl.leadingFreeRangeEnd();
+    _trailing_free_range[i] = cl.trailingFreeRange();
+    n_swept++;
+  }
+  _timer.stop();
+  if (PrintCMSStatistics != 0) {
+    gclog_or_tty->print_cr("Finished sweeping %u ranges in %dth thread: %3.3f sec",
+      n_swept, worker_id, _timer.seconds());
+  }
+}
+
+void CMSParSweepTask::coordinator_yield() {
+  assert(ConcurrentMarkSweepThread::cms_thread_has_cms_token(),
+         "CMS thread should hold CMS token");
+  // First give up the locks, then yield, then re-lock; as in
+  // SweepClosure::do_yield_work().
+  Mutex* bit_map_lock = _collector->bitMapLock();
+  Mutex* freelist_lock = _gen->freelistLock();
+  assert_lock_strong(bit_map_lock);
+  assert_lock_strong(freelist_lock);
+  bit_map_lock->unlock();
+  freelist_lock->unlock();
+  ConcurrentMarkSweepThread::desynchronize(true);
+  ConcurrentMarkSweepThread::acknowledge_yield_request();
+  _collector->stopTimer();
+  GCPauseTimer p(_collector->size_policy()->concurrent_timer_ptr());
+  if (PrintCMSStatistics != 0) {
+    _collector->incrementYields();
+  }
+  _collector->icms_wait();
+
+  // See the comment in CMSConcMarkingTask::coordinator_yield()
+  for (unsigned i = 0; i < CMSCoordinatorYieldSleepCount &&
+                       ConcurrentMarkSweepThread::should_yield() &&
+                       !CMSCollector::foregroundGCIsActive(); ++i) {
+    os::sleep(Thread::current(), 1, false);
+    ConcurrentMarkSweepThread::acknowledge_yield_request();
+  }
+
+  ConcurrentMarkSweepThread::synchronize(true);
+  freelist_lock->lock();
+  bit_map_lock->lock_without_safepoint_check();
+  _collector->startTimer();
+}
+
+HeapWord* CMSParSweepTask::coalesce_at_seam(HeapWord* left, HeapWord* seam,
+                                            HeapWord* right_end) {
+  // A worker may have yielded after returning either chunk, and a
+  // young collection may have allocated from it since.
+  FreeChunk* lfc = (FreeChunk*)left;
+  FreeChunk* rfc = (FreeChunk*)seam;
+  if (!lfc->is_free() || lfc->cantCoalesce() ||
+      lfc->size() != pointer_delta(seam, left) ||
+      !rfc->is_free() || rfc->cantCoalesce() ||
+      rfc->size() != pointer_delta(right_end, seam)) {
+    return seam;
+  }
+  SweepClosure cl(_collector, _gen, &_collector->_markBitMap,
+                  MemRegion(left, right_end), false /* should_yield */,
+                  NULL /* task */);
+  HeapWord* cur = left;
+  HeapWord* end = _gen->cmsSpace()->end();
+  while (cur < end) {
+    cur += cl.do_blk_careful(cur);
+  }
+  return cl.trailingFreeRange();
+}
+
+void CMSParSweepTask::coalesce_at_seams() {
+  assert(completed(), "Should have swept all the ranges");
+  HeapWord* left = _trailing_free_range[0];
+  for (uint i = 1; i < _n_ranges; i++) {
+    HeapWord* seam = _boundaries[i];
+    HeapWord* right_end = _leading_free_range_end[i];
+    if (left != NULL && right_end != NULL) {
+      HeapWord* coalesced = coalesce_at_seam(left, seam, right_end);
+      if (_trailing_free_range[i] == seam) {
+        // The range was a single free run, which now starts
+        // at the coalesced chunk.
+        _trailing_free_range[i] = coalesced;
+      }
+    }
+    left = _trailing_free_range[i];
+  }
+}
+
+void CMSCollector::do_sweeping_mt(ConcurrentMarkSweepGeneration* gen,
+                                  bool asynch) {
+  assert(conc_workers() != NULL, "precondition");
+  CompactibleFreeListSpace* sp = gen->cmsSpace();
+  HeapWord* const bottom = sp->bottom();
+  HeapWord* const limit = sp->sweep_limit();
+
+  int num_workers = AdaptiveSizePolicy::calc_active_conc_workers(
+                                       conc_workers()->total_workers(),
+                                       conc_workers()->active_workers(),
+                                       Threads::number_of_non_daemon_threads());
+  conc_workers()->set_active_workers(num_workers);
+
+  // Do not split the space into ranges smaller than a marking task.
+  size_t sweep_words = pointer_delta(limit, bottom);
+  uint n_ranges = (uint)MIN2((size_t)num_workers * CMSParSweepTask::RangesPerWorker,
+                             sweep_words / sp->marking_task_size());
+  n_ranges = MAX2(n_ranges, 1U);
+  size_t range_words = sweep_words / n_ranges;
+
+  // Move each nominal boundary up to the next block start.  No block
+  // can change while we hold the free list lock, but a block may
+  // have been allocated by a mutator and not yet be initialized,
+  // which the Printezis bits let us step over.
+  HeapWord** boundaries = NEW_C_HEAP_ARRAY(HeapWord*, n_ranges + 1, mtGC);
+  uint n = 0;
+  boundaries[0] = bottom;
+  for (uint i = 1; i < n_ranges; i++) {
+    HeapWord* nominal = bottom + i * range_words;
+    HeapWord* blk = sp->block_start_careful(nominal);
+    while (blk < nominal) {
+      size_t sz = sp->block_size_no_stall(blk, this);
+      if (sz == 0) {
+        // Leave out this boundary.
+        blk = NULL;
+        break;
+      }
+      blk += sz;
+    }
+    if (blk != NULL && blk > boundaries[n] && blk < limit) {
+      boundaries[++n] = blk;
+    }
+  }
+  boundaries[++n] = limit;
+
+  NOT_PRODUCT(
+    sp->initializeIndexedFreeListArrayReturnedBytes();
+    sp->dictionary()->initialize_dict_returned_bytes();
+  )
+  {
+    CMSParSweepTask tsk(this, gen, asynch, boundaries, n);
+    conc_workers()->start_task(&tsk);
+    while (tsk.yielded()) {
+      tsk.coordinator_yield();
+      conc_workers()->continue_task(&tsk);
+    }
+    assert(tsk.completed(), "Inconsistency");
+    tsk.coalesce_at_seams();
+  }
+  debug_only(sp->verifyFreeLists());
+  FREE_C_HEAP_ARRAY(HeapWord*, boundaries, mtGC);
+}
+
 void CMSCollector::sweepWork(ConcurrentMarkSweepGeneration* gen,
   bool asynch) {
   // We iterate over the space(s) underlying this generation,
@@ -6548,7 +6808,12 @@ void CMSCollector::sweepWork(ConcurrentMarkSweepGeneration* gen,
                                       _intra_sweep_estimate.padded_average());
   gen->setNearLargestChunk();
 
-  {
+  // The parallel sweepers lock the exact free lists individually; those
+  // locks only exist with parallel GC threads (not with -XX:-UseParNewGC).
+  if (CMSParallelSweepEnabled && CMSConcurrentMTEnabled &&
+      conc_workers() != NULL && CollectedHeap::use_parallel_gc_threads()) {
+    do_sweeping_mt(gen, asynch);
+  } else {
     SweepClosure sweepClosure(this, gen, &_markBitMap,
                             CMSYield && asynch);
     gen->cmsSpace()->blk_iterate_careful(&sweepClosure);
@@ -8176,8 +8441,12 @@ SweepClosure::SweepClosure(CMSCollector* collector,
   _collector(collector),
   _g(g),
   _sp(g->cmsSpace()),
+  _start(g->used_region().start()),
   _limit(_sp->sweep_limit()),
   _freelistLock(_sp->freelistLock()),
+  _task(NULL),
+  _leadingFreeRangeEnd(NULL),
+  _trailingFreeRange(NULL),
   _bitMap(bitMap),
   _yield(should_yield),
   _inFreeRange(false),           // No free range at beginning of sweep
@@ -8205,6 +8474,47 @@ SweepClosure::SweepClosure(CMSCollector* collector,
   }
 }
 
+SweepClosure::SweepClosure(CMSCollector* collector,
+                           ConcurrentMarkSweepGeneration* g,
+                           CMSBitMap* bitMap, MemRegion span,
+                           bool should_yield,
+                           YieldingFlexibleGangTask* task) :
+  _collector(collector),
+  _g(g),
+  _sp(g->cmsSpace()),
+  _start(span.start()),
+  _limit(span.end()),
+  _freelistLock(_sp->freelistLock()),
+  _task(task),
+  _leadingFreeRangeEnd(NULL),
+  _trailingFreeRange(NULL),
+  _bitMap(bitMap),
+  _yield(should_yield),
+  _inFreeRange(false),           // No free range at beginning of sweep
+  _freeRangeInFreeLists(false),  // No free range at beginning of sweep
+  _lastFreeRangeCoalesced(false),
+  _freeFinger(span.start())
+{
+  // The returned bytes are shared by all the ranges of a sweep, and
+  // are reset by the caller.
+  NOT_PRODUCT(
+    _numObjectsFreed = 0;
+    _numWordsFreed   = 0;
+    _numObjectsLive = 0;
+    _numWordsLive = 0;
+    _numObjectsAlreadyFree = 0;
+    _numWordsAlreadyFree = 0;
+    _last_fc = NULL;
+  )
+  assert(_start >= _sp->bottom() && _start <= _limit,
+         "sweep _start out of bounds");
+  assert(_limit <= _sp->end(), "sweep _limit out of bounds");
+  if (CMSTraceSweeper) {
+    gclog_or_tty->print_cr("\n====================\nStarting new sweep of ["
+                           PTR_FORMAT "," PTR_FORMAT ")", _start, _limit);
+  }
+}
+
 void SweepClosure::print_on(outputStream* st) const {
   tty->print_cr("_sp = [" PTR_FORMAT "," PTR_FORMAT ")",
                 _sp->bottom(), _sp->end());
@@ -8221,7 +8531,10 @@ void SweepClosure::print_on(outputStream* st) const {
 // you may need to review this code to see if it needs to be
 // enabled in product mode.
 SweepClosure::~SweepClosure() {
-  assert_lock_strong(_freelistLock);
+  // The coordinator holds the free list lock for the parallel sweepers.
+  if (_task == NULL) {
+    assert_lock_strong(_freelistLock);
+  }
   assert(_limit >= _sp->bottom() && _limit <= _sp->end(),
          "sweep _limit out of bounds");
   if (inFreeRange()) {
@@ -8276,7 +8589,7 @@ void SweepClosure::initialize_free_range(HeapWord* freeFinger,
       FreeChunk* fc = (FreeChunk*) freeFinger;
       assert(fc->is_free(), "A chunk on the free list should be free.");
       assert(fc->size() > 0, "Free range should have a size");
-      assert(_sp->verify_chunk_in_free_list(fc), "Chunk is not in free lists");
+      assert(verify_chunk_in_free_list(fc), "Chunk is not in free lists");
     }
   }
 }
@@ -8350,7 +8663,7 @@ size_t SweepClosure::do_blk_careful(HeapWord* addr) {
     // Chunk that is already free
     res = fc->size();
     do_already_free_chunk(fc);
-    debug_only(_sp->verifyFreeLists());
+    debug_only(verify_free_lists());
     // If we flush the chunk at hand in lookahead_and_flush()
     // and it's coalesced with a preceding chunk, then the
     // process of "mangling" the payload of the coalesced block
@@ -8369,7 +8682,7 @@ size_t SweepClosure::do_blk_careful(HeapWord* addr) {
   } else if (!_bitMap->isMarked(addr)) {
     // Chunk is fresh garbage
     res = do_garbage_chunk(fc);
-    debug_only(_sp->verifyFreeLists());
+    debug_only(verify_free_lists());
     NOT_PRODUCT(
       _numObjectsFreed++;
       _numWordsFreed += res;
@@ -8377,7 +8690,7 @@ size_t SweepClosure::do_blk_careful(HeapWord* addr) {
   } else {
     // Chunk that is alive.
     res = do_live_chunk(fc);
-    debug_only(_sp->verifyFreeLists());
+    debug_only(verify_free_lists());
     NOT_PRODUCT(
         _numObjectsLive++;
         _numWordsLive += res;
@@ -8434,7 +8747,7 @@ void SweepClosure::do_already_free_chunk(FreeChunk* fc) {
   // Chunks that cannot be coalesced are not in the
   // free lists.
   if (CMSTestInFreeList && !fc->cantCoalesce()) {
-    assert(_sp->verify_chunk_in_free_list(fc),
+    assert(verify_chunk_in_free_list(fc),
       "free chunk should be in free lists");
   }
   // a chunk that is already free, should not have been
@@ -8481,7 +8794,7 @@ void SweepClosure::do_already_free_chunk(FreeChunk* fc) {
           gclog_or_tty->print("  -- pick up free block 0x%x (%d)\n", fc, size);
         }
         // remove it from the free lists
-        _sp->removeFreeChunkFromFreeLists(fc);
+        remove_free_chunk(fc, false);
         set_lastFreeRangeCoalesced(true);
         // If the chunk is being coalesced and the current free range is
         // in the free lists, remove the current free range so that it
@@ -8492,10 +8805,10 @@ void SweepClosure::do_already_free_chunk(FreeChunk* fc) {
           assert(ffc->size() == pointer_delta(addr, freeFinger()),
             "Size of free range is inconsistent with chunk size.");
           if (CMSTestInFreeList) {
-            assert(_sp->verify_chunk_in_free_list(ffc),
+            assert(verify_chunk_in_free_list(ffc),
               "free range is not in free lists");
           }
-          _sp->removeFreeChunkFromFreeLists(ffc);
+          remove_free_chunk(ffc, false);
           set_freeRangeInFreeLists(false);
         }
       }
@@ -8551,10 +8864,10 @@ size_t SweepClosure::do_garbage_chunk(FreeChunk* fc) {
         assert(ffc->size() == pointer_delta(addr, freeFinger()),
           "Size of free range is inconsistent with chunk size.");
         if (CMSTestInFreeList) {
-          assert(_sp->verify_chunk_in_free_list(ffc),
+          assert(verify_chunk_in_free_list(ffc),
             "free range is not in free lists");
         }
-        _sp->removeFreeChunkFromFreeLists(ffc);
+        remove_free_chunk(ffc, false);
         set_freeRangeInFreeLists(false);
       }
       set_lastFreeRangeCoalesced(true);
@@ -8629,7 +8942,7 @@ void SweepClosure::do_post_free_or_garbage_chunk(FreeChunk* fc,
   assert(_sp->adaptive_freelists(), "Should only be used in this case.");
   assert((HeapWord*)fc <= _limit, "sweep invariant");
   if (CMSTestInFreeList && fcInFreeLists) {
-    assert(_sp->verify_chunk_in_free_list(fc), "free chunk is not in free lists");
+    assert(verify_chunk_in_free_list(fc), "free chunk is not in free lists");
   }
 
   if (CMSTraceSweeper) {
@@ -8641,32 +8954,36 @@ void SweepClosure::do_post_free_or_garbage_chunk(FreeChunk* fc,
   bool coalesce = false;
   const size_t left  = pointer_delta(fc_addr, freeFinger());
   const size_t right = chunkSize;
-  switch (FLSCoalescePolicy) {
-    // numeric value forms a coalition aggressiveness metric
-    case 0:  { // never coalesce
-      coalesce = false;
-      break;
-    }
-    case 1: { // coalesce if left & right chunks on overpopulated lists
-      coalesce = _sp->coalOverPopulated(left) &&
-                 _sp->coalOverPopulated(right);
-      break;
-    }
-    case 2: { // coalesce if left chunk on overpopulated list (default)
-      coalesce = _sp->coalOverPopulated(left);
-      break;
-    }
-    case 3: { // coalesce if left OR right chunk on overpopulated list
-      coalesce = _sp->coalOverPopulated(left) ||
-                 _sp->coalOverPopulated(right);
-      break;
-    }
-    case 4: { // always coalesce
-      coalesce = true;
-      break;
+  // The policy only matters if there is a free range to coalesce with;
+  // a parallel sweeper would needlessly look up the census otherwise.
+  if (inFreeRange()) {
+    switch (FLSCoalescePolicy) {
+      // numeric value forms a coalition aggressiveness metric
+      case 0:  { // never coalesce
+        coalesce = false;
+        break;
+      }
+      case 1: { // coalesce if left & right chunks on overpopulated lists
+        coalesce = coal_over_populated(left) &&
+                   coal_over_populated(right);
+        break;
+      }
+      case 2: { // coalesce if left chunk on overpopulated list (default)
+        coalesce = coal_over_populated(left);
+        break;
+      }
+      case 3: { // coalesce if left OR right chunk on overpopulated list
+        coalesce = coal_over_populated(left) ||
+                   coal_over_populated(right);
+        break;
+      }
+      case 4: { // always coalesce
+        coalesce = true;
+        break;
+      }
+      default:
+       ShouldNotReachHere();
     }
-    default:
-     ShouldNotReachHere();
   }
 
   // Should the current free range be coalesced?
@@ -8684,18 +9001,16 @@ void SweepClosure::do_post_free_or_garbage_chunk(FreeChunk* fc,
       assert(ffc->size() == pointer_delta(fc_addr, freeFinger()),
         "Size of free range is inconsistent with chunk size.");
       if (CMSTestInFreeList) {
-        assert(_sp->verify_chunk_in_free_list(ffc),
+        assert(verify_chunk_in_free_list(ffc),
           "Chunk is not in free lists");
       }
-      _sp->coalDeath(ffc->size());
-      _sp->removeFreeChunkFromFreeLists(ffc);
+      remove_free_chunk(ffc, true);
       set_freeRangeInFreeLists(false);
     }
     if (fcInFreeLists) {
-      _sp->coalDeath(chunkSize);
       assert(fc->size() == chunkSize,
         "The chunk has the wrong size or is not in the free lists");
-      _sp->removeFreeChunkFromFreeLists(fc);
+      remove_free_chunk(fc, true);
     }
     set_lastFreeRangeCoalesced(true);
     print_free_block_coalesced(fc);
@@ -8754,11 +9069,19 @@ void SweepClosure::flush_cur_free_chunk(HeapWord* chunk, size_t size) {
   assert(inFreeRange(), "Should only be called if currently in a free range.");
   assert(size > 0,
     "A zero sized chunk cannot be added to the free lists.");
+  // Remember the free ranges at the ends of the range being swept,
+  // a parallel sweep coalesces them with those of the neighbours.
+  if (chunk == _start) {
+    _leadingFreeRangeEnd = chunk + size;
+  }
+  if (chunk + size >= _limit) {
+    _trailingFreeRange = chunk;
+  }
   if (!freeRangeInFreeLists()) {
     if (CMSTestInFreeList) {
       FreeChunk* fc = (FreeChunk*) chunk;
       fc->set_size(size);
-      assert(!_sp->verify_chunk_in_free_list(fc),
+      assert(!verify_chunk_in_free_list(fc),
         "chunk should not be in free lists yet");
     }
     if (CMSTraceSweeper) {
@@ -8770,11 +9093,7 @@ void SweepClosure::flush_cur_free_chunk(HeapWord* chunk, size_t size) {
     // was removed so add it back.
     // If the current free range was coalesced, then the death
     // of the free range was recorded.  Record a birth now.
-    if (lastFreeRangeCoalesced()) {
-      _sp->coalBirth(size);
-    }
-    _sp->addChunkAndRepairOffsetTable(chunk, size,
-            lastFreeRangeCoalesced());
+    add_chunk(chunk, size, lastFreeRangeCoalesced());
   } else if (CMSTraceSweeper) {
     gclog_or_tty->print_cr("Already in free list: nothing to flush");
   }
@@ -8795,6 +9114,13 @@ void SweepClosure::do_yield_work(HeapWord* addr) {
     flush_cur_free_chunk(freeFinger(), pointer_delta(addr, freeFinger()));
   }
 
+  if (_task != NULL) {
+    // A parallel sweeper: the coordinator gives up the locks
+    // once all the workers have yielded.
+    _task->yield();
+    return;
+  }
+
   // First give up the locks, then yield, then re-lock.
   // We should probably use a constructor/destructor idiom to
   // do this unlock/lock or modify the MutexUnlocker class to
@@ -8844,6 +9170,50 @@ void SweepClosure::print_free_block_coalesced(FreeChunk* fc) const {
   }
 }
 
+bool SweepClosure::coal_over_populated(size_t size) const {
+  if (_task != NULL) {
+    return _sp->par_coalOverPopulated(size);
+  }
+  return _sp->coalOverPopulated(size);
+}
+
+void SweepClosure::remove_free_chunk(FreeChunk* fc, bool coalesced) {
+  if (_task != NULL) {
+    _sp->par_removeFreeChunkFromFreeLists(fc, coalesced);
+    return;
+  }
+  if (coalesced) {
+    _sp->coalDeath(fc->size());
+  }
+  _sp->removeFreeChunkFromFreeLists(fc);
+}
+
+void SweepClosure::add_chunk(HeapWord* chunk, size_t size, bool coalesced) {
+  if (_task != NULL) {
+    _sp->par_addChunkAndRepairOffsetTable(chunk, size, coalesced);
+    return;
+  }
+  if (coalesced) {
+    _sp->coalBirth(size);
+  }
+  _sp->addChunkAndRepairOffsetTable(chunk, size, coalesced);
+}
+
+bool SweepClosure::verify_chunk_in_free_list(FreeChunk* fc) const {
+  if (_task != NULL) {
+    return _sp->par_verify_chunk_in_free_list(fc);
+  }
+  return _sp->verify_chunk_in_free_list(fc);
+}
+
+void SweepClosure::verify_free_lists() const {
+  // The other threads of a parallel sweep update the free lists
+  // concurrently; they are verified once the sweep task is done.
+  if (_task == NULL) {
+    _sp->verifyFreeLists();
+  }
+}
+
 // CMSIsAliveClosure
 bool CMSIsAliveClosure::do_object_b(oop obj) {
   HeapWord* addr = (HeapWord*)obj;
@@ -354,6 +354,9 @@ class CMSStats VALUE_OBJ_CLASS_SPEC {
   double _gc0_duration;
   double _gc0_period;
   size_t _gc0_promoted;         // bytes promoted per gc0
+  size_t _gc0_lab_refills;      // promotion LAB refills in the last gc0
+  size_t _gc0_lab_batch_refills; // of which were served by a shared batch
+  size_t _gc0_lab_contended_locks; // free list locks found held in the last gc0
   double _cms_duration;
   double _cms_duration_pre_sweep; // time from initiation to start of sweep
   double _cms_duration_per_mb;
@@ -424,6 +427,9 @@ class CMSStats VALUE_OBJ_CLASS_SPEC {
   double gc0_period() const     { return _gc0_period; }
   double gc0_duration() const   { return _gc0_duration; }
   size_t gc0_promoted() const   { return _gc0_promoted; }
+  size_t gc0_lab_refills() const { return _gc0_lab_refills; }
+  size_t gc0_lab_batch_refills() const { return _gc0_lab_batch_refills; }
+  size_t gc0_lab_contended_locks() const { return _gc0_lab_contended_locks; }
   double cms_period() const          { return _cms_period; }
   double cms_duration() const        { return _cms_duration; }
   double cms_duration_per_mb() const { return _cms_duration_per_mb; }
@@ -520,6 +526,7 @@ class CMSCollector: public CHeapObj<mtGC> {
   friend class CMSParInitialMarkTask;
   friend class CMSParRemarkTask;
   friend class CMSConcMarkingTask;
+  friend class CMSParSweepTask;
   friend class CMSRefProcTaskProxy;
   friend class CMSRefProcTaskExecutor;
   friend class ScanMarkedObjectsAgainCarefullyClosure;  // for sampling eden
@@ -828,6 +835,8 @@ class CMSCollector: public CHeapObj<mtGC> {
 
   // concurrent sweeping work
   void sweepWork(ConcurrentMarkSweepGeneration* gen, bool asynch);
+  // multi-threaded sweeping of the space of "gen" by address ranges
+  void do_sweeping_mt(ConcurrentMarkSweepGeneration* gen, bool asynch);
 
   // (concurrent) resetting of support data structures
   void reset(bool asynch);
@@ -1736,14 +1745,27 @@ class SurvivorSpacePrecleanClosure: public ObjectClosureCareful {
 // _lastFreeRangeCoalesced is true if the LHC consists of more than one chunk.
 // _freeRangeInFreeLists is true if the LHC is in the free lists.
 // _freeFinger is the address of the current LHC
+//
+// A parallel sweep runs one SweepClosure per address range; see
+// CMSParSweepTask.  Each range starts and ends at a block boundary,
+// and the closure remembers the free ranges it returned at either end
+// of its range so that they can be coalesced across the seams later.
 class SweepClosure: public BlkClosureCareful {
   CMSCollector*                  _collector;  // collector doing the work
   ConcurrentMarkSweepGeneration* _g;    // Generation being swept
   CompactibleFreeListSpace*      _sp;   // Space being swept
+  HeapWord* const                _start;// the address at which the sweep starts
   HeapWord*                      _limit;// the address at or above which the sweep should stop
                                         // because we do not expect newly garbage blocks
                                         // eligible for sweeping past that address.
   Mutex*                         _freelistLock; // Free list lock (in space)
+  YieldingFlexibleGangTask*      _task;         // Parallel sweep task, if any
+  HeapWord*                      _leadingFreeRangeEnd;
+                                        // End of the free range returned
+                                        // that started at _start, if any
+  HeapWord*                      _trailingFreeRange;
+                                        // Start of the free range returned
+                                        // that ended at _limit, if any
   CMSBitMap*                     _bitMap;       // Marking bit map (in
                                                 // generation)
   bool                           _inFreeRange;  // Indicates if we are in the
@@ -1821,12 +1843,29 @@ class SweepClosure: public BlkClosureCareful {
 
   // Debugging/Printing
   void print_free_block_coalesced(FreeChunk* fc) const;
+  // Whether chunks of "size" should be coalesced, see coalOverPopulated().
+  bool coal_over_populated(size_t size) const;
+  // Free list updates; those of a parallel sweep lock the list of the
+  // chunk's size only, see CompactibleFreeListSpace::par_*().
+  void remove_free_chunk(FreeChunk* fc, bool coalesced);
+  void add_chunk(HeapWord* chunk, size_t size, bool coalesced);
+  // Free list verification.
+  bool verify_chunk_in_free_list(FreeChunk* fc) const;
+  void verify_free_lists() const;
 
  public:
   SweepClosure(CMSCollector* collector, ConcurrentMarkSweepGeneration* g,
                CMSBitMap* bitMap, bool should_yield);
+  // Sweep only the blocks in "span", which must start at a block
+  // boundary.  "task" is the parallel sweep task this is a worker of.
+  SweepClosure(CMSCollector* collector, ConcurrentMarkSweepGeneration* g,
+               CMSBitMap* bitMap, MemRegion span, bool should_yield,
+               YieldingFlexibleGangTask* task);
   ~SweepClosure() PRODUCT_RETURN;
 
+  HeapWord*    leadingFreeRangeEnd() const { return _leadingFreeRangeEnd; }
+  HeapWord*    trailingFreeRange() const   { return _trailingFreeRange; }
+
   size_t       do_blk_careful(HeapWord* addr);
   void         print() const { print_on(tty); }
   void         print_on(outputStream *st) const;
@@ -340,6 +340,20 @@ inline void CMSStats::record_gc0_end(size_t cms_gen_bytes_used) {
   _cms_gen->reset_direct_allocated_words();
   _cms_allocated = AdaptiveWeightedAverage::exp_avg(_cms_allocated,
     allocated_bytes, _gc0_alpha);
+
+  // Refills of the promotion LABs and contention on the free list locks.
+  CompactibleFreeListSpace* cfls = _cms_gen->cmsSpace();
+  _gc0_lab_refills = cfls->par_lab_refills();
+  _gc0_lab_batch_refills = cfls->par_lab_batch_refills();
+  _gc0_lab_contended_locks = cfls->par_lock_contentions();
+  cfls->reset_par_lab_stats();
+  if (PrintOldPLAB && _gc0_lab_refills > 0) {
+    gclog_or_tty->print_cr("[CMS promotion LAB refills: " SIZE_FORMAT
+                           ", from shared batches: " SIZE_FORMAT
+                           ", contended free list locks: " SIZE_FORMAT "]",
+                           _gc0_lab_refills, _gc0_lab_batch_refills,
+                           _gc0_lab_contended_locks);
+  }
 }
 
 inline void CMSStats::record_cms_begin() {
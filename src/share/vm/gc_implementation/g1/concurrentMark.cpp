@@ -42,6 +42,7 @@
 #include "gc_implementation/shared/gcTimer.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcTraceTime.hpp"
+#include "gc_implementation/shared/suspendibleThreadSet.hpp"
 #include "memory/allocation.hpp"
 #include "memory/genOopClosures.inline.hpp"
 #include "memory/referencePolicy.hpp"
@@ -567,6 +568,7 @@ ConcurrentMark::ConcurrentMark(G1CollectedHeap* g1h, G1RegionToSpaceMapper* prev
   _total_rs_scrub_time(0.0),
 
   _parallel_workers(NULL),
+  _remark_worker_estimator(new GCWorkerEstimator("G1 remark")),
 
   _count_card_bitmaps(NULL),
   _count_marked_bytes(NULL),
@@ -1290,6 +1292,71 @@ void ConcurrentMark::markFromRoots() {
   print_stats();
 }
 
+// Marks the objects the fields of a finalizable referent point to and
+// pushes them on the global mark stack. The referent itself is left
+// unmarked, so that remark still finds it dead and enqueues its Reference.
+class G1CMPushReferentFieldsClosure : public ExtendedOopClosure {
+  ConcurrentMark*  _cm;
+  G1CollectedHeap* _g1h;
+  bool             _pushed;
+
+  template <class T> void do_oop_work(T* p) {
+    oop obj = oopDesc::load_decode_heap_oop(p);
+    if (obj == NULL || !_g1h->is_in_g1_reserved(obj) || _cm->has_overflown()) {
+      return;
+    }
+    HeapRegion* hr = _g1h->heap_region_containing_raw(obj);
+    if ((HeapWord*)obj < hr->next_top_at_mark_start() &&
+        !_cm->nextMarkBitMap()->isMarked((HeapWord*)obj) &&
+        _cm->par_mark_and_count(obj, obj->size(), hr, 0 /* worker_id */)) {
+      _cm->mark_stack_push(obj);
+      _pushed = true;
+    }
+  }
+
+public:
+  G1CMPushReferentFieldsClosure(ConcurrentMark* cm) :
+    _cm(cm), _g1h(G1CollectedHeap::heap()), _pushed(false) { }
+
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+
+  bool pushed() const { return _pushed; }
+};
+
+class G1CMNoopVoidClosure : public VoidClosure {
+public:
+  virtual void do_void() { }
+};
+
+// Asked between two discovered lists, where it is safe to let a pause
+// run: the lists are updated by evacuation pauses.
+class G1CMPrecleanYieldClosure : public YieldClosure {
+  ConcurrentMark* _cm;
+public:
+  G1CMPrecleanYieldClosure(ConcurrentMark* cm) : _cm(cm) { }
+
+  virtual bool should_return() {
+    if (SuspendibleThreadSet::should_yield()) {
+      SuspendibleThreadSet::yield();
+    }
+    return _cm->has_aborted() || _cm->has_overflown();
+  }
+};
+
+bool ConcurrentMark::preclean_final_referents() {
+  SuspendibleThreadSetJoiner sts;
+  ReferenceProcessor* rp = _g1h->ref_processor_cm();
+
+  G1CMPushReferentFieldsClosure push_fields(this);
+  G1CMNoopVoidClosure           noop;
+  G1CMPrecleanYieldClosure      yield_cl(this);
+
+  rp->preclean_final_referents(rp->is_alive_non_header(), &push_fields, &noop,
+                               &yield_cl, NULL, concurrent_gc_id());
+  return push_fields.pushed();
+}
+
 void ConcurrentMark::checkpointRootsFinal(bool clear_all_soft_refs) {
   // world is stopped at this checkpoint
   assert(SafepointSynchronize::is_at_safepoint(),
@@ -2103,6 +2170,12 @@ void ConcurrentMark::cleanup() {
   }
   g1h->check_gc_time_stamps();
 
+  if (g1h->periodic_cycle_in_progress()) {
+    // The heap is shrunk below, so hand the regions freed above to the
+    // free list now instead of concurrently after the pause.
+    completeCleanup();
+  }
+
   if (!cleanup_list_is_empty()) {
     // The cleanup list is not empty, so we'll have to process it
     // concurrently. Notify anyone else that might be wanting free
@@ -2136,6 +2209,11 @@ void ConcurrentMark::cleanup() {
   // and sort the regions.
   g1h->g1_policy()->record_concurrent_mark_cleanup_end((int)n_workers);
 
+  if (g1h->periodic_cycle_in_progress()) {
+    // Give back the memory of the regions freed by this cycle.
+    g1h->shrink_if_necessary_after_cleanup();
+  }
+
   // Statistics.
   double end = os::elapsedTime();
   _cleanup_times.add((end - start) * 1000.0);
@@ -2756,13 +2834,18 @@ void ConcurrentMark::checkpointRootsFinalWork() {
 
   if (G1CollectedHeap::use_parallel_gc_threads()) {
     G1CollectedHeap::StrongRootsScope srs(g1h);
-    // this is remark, so we'll use up all active threads
-    uint active_workers = g1h->workers()->active_workers();
-    if (active_workers == 0) {
-      assert(active_workers > 0, "Should have been set earlier");
-      active_workers = (uint) ParallelGCThreads;
-      g1h->workers()->set_active_workers(active_workers);
-    }
+    // The work of the remark is the thread stacks, the completed SATB
+    // buffers and the global mark stack.
+    size_t work_words = AdaptiveSizePolicy::root_set_words() +
+      JavaThread::satb_mark_queue_set().completed_buffers_num() * G1SATBBufferSize +
+      (size_t) _markStack.size();
+    uint active_workers =
+      AdaptiveSizePolicy::calc_active_workers(g1h->workers()->total_workers(),
+                                              g1h->workers()->active_workers(),
+                                              Threads::number_of_non_daemon_threads(),
+                                              _remark_worker_estimator,
+                                              work_words);
+    g1h->workers()->set_active_workers(active_workers);
     set_concurrency_and_phase(active_workers, false /* concurrent */);
     // Leave _parallel_marking_threads at it's
     // value originally calculated in the ConcurrentMark
@@ -2774,7 +2857,10 @@ void ConcurrentMark::checkpointRootsFinalWork() {
     // active_workers will be fewer. The extra ones will just bail out
     // immediately.
     g1h->set_par_threads(active_workers);
+    double start_sec = os::elapsedTime();
     g1h->workers()->run_task(&remarkTask);
+    _remark_worker_estimator->sample(work_words, active_workers,
+                                     (os::elapsedTime() - start_sec) * MILLIUNITS);
     g1h->set_par_threads(0);
   } else {
     G1CollectedHeap::StrongRootsScope srs(g1h);
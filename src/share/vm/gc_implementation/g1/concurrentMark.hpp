@@ -381,6 +381,8 @@ class ConcurrentMark: public CHeapObj<mtGC> {
   friend class G1CMRefProcTaskExecutor;
   friend class G1CMKeepAliveAndDrainClosure;
   friend class G1CMDrainMarkingStackClosure;
+  friend class G1CMPushReferentFieldsClosure;
+  friend class G1CMPrecleanYieldClosure;
 
 protected:
   ConcurrentMarkThread* _cmThread;   // the thread doing the work
@@ -477,6 +479,9 @@ protected:
 
   FlexibleWorkGang* _parallel_workers;
 
+  // Chooses the number of workers of the remark pause.
+  GCWorkerEstimator* _remark_worker_estimator;
+
   ForceOverflowSettings _force_overflow_conc;
   ForceOverflowSettings _force_overflow_stw;
 
@@ -767,6 +772,11 @@ public:
   // Do concurrent phase of marking, to a tentative transitive closure.
   void markFromRoots();
 
+  // Concurrently marks what the referents of the discovered FinalReferences
+  // refer to, see ReferenceProcessor::preclean_final_referents(). Returns
+  // true if objects were pushed that markFromRoots() still has to trace.
+  bool preclean_final_referents();
+
   void checkpointRootsFinal(bool clear_all_soft_refs);
   void checkpointRootsFinalWork();
   void cleanup();
@@ -136,6 +136,12 @@ void ConcurrentMarkThread::run() {
         if (!cm()->has_aborted()) {
           _cm->markFromRoots();
         }
+        // Trace from the finalizable referents now rather than in the
+        // remark pause, which then only has to mark the referents.
+        if (!cm()->has_aborted() && PrecleanFinalReferents &&
+            _cm->preclean_final_referents() && !cm()->has_aborted()) {
+          _cm->markFromRoots();
+        }
 
         double mark_end_time = os::elapsedVTime();
         double mark_end_sec = os::elapsedTime();
@@ -29,14 +29,29 @@
 #include "gc_implementation/g1/heapRegion.inline.hpp"
 #include "gc_implementation/g1/heapRegionSet.inline.hpp"
 
+G1DefaultAllocator::G1DefaultAllocator(G1CollectedHeap* heap) :
+  G1Allocator(heap), _retained_old_gc_alloc_region(NULL) {
+  uint length = num_alloc_regions();
+  _mutator_alloc_regions = NEW_C_HEAP_ARRAY(MutatorAllocRegion, length, mtGC);
+  _survivor_gc_alloc_regions = NEW_C_HEAP_ARRAY(SurvivorGCAllocRegion, length, mtGC);
+  for (uint i = 0; i < length; i++) {
+    ::new(_mutator_alloc_regions + i) MutatorAllocRegion(i);
+    ::new(_survivor_gc_alloc_regions + i) SurvivorGCAllocRegion(i);
+  }
+}
+
 void G1DefaultAllocator::init_mutator_alloc_region() {
-  assert(_mutator_alloc_region.get() == NULL, "pre-condition");
-  _mutator_alloc_region.init();
+  for (uint i = 0; i < num_alloc_regions(); i++) {
+    assert(_mutator_alloc_regions[i].get() == NULL, "pre-condition");
+    _mutator_alloc_regions[i].init();
+  }
 }
 
 void G1DefaultAllocator::release_mutator_alloc_region() {
-  _mutator_alloc_region.release();
-  assert(_mutator_alloc_region.get() == NULL, "post-condition");
+  for (uint i = 0; i < num_alloc_regions(); i++) {
+    _mutator_alloc_regions[i].release();
+    assert(_mutator_alloc_regions[i].get() == NULL, "post-condition");
+  }
 }
 
 void G1Allocator::reuse_retained_old_region(EvacuationInfo& evacuation_info,
@@ -76,7 +91,9 @@ void G1Allocator::reuse_retained_old_region(EvacuationInfo& evacuation_info,
 void G1DefaultAllocator::init_gc_alloc_regions(EvacuationInfo& evacuation_info) {
   assert_at_safepoint(true /* should_be_vm_thread */);
 
-  _survivor_gc_alloc_region.init();
+  for (uint i = 0; i < num_alloc_regions(); i++) {
+    _survivor_gc_alloc_regions[i].init();
+  }
   _old_gc_alloc_region.init();
   reuse_retained_old_region(evacuation_info,
                             &_old_gc_alloc_region,
@@ -85,9 +102,13 @@ void G1DefaultAllocator::init_gc_alloc_regions(EvacuationInfo& evacuation_info)
 
 void G1DefaultAllocator::release_gc_alloc_regions(uint no_of_gc_workers, EvacuationInfo& evacuation_info) {
   AllocationContext_t context = AllocationContext::current();
-  evacuation_info.set_allocation_regions(survivor_gc_alloc_region(context)->count() +
+  uint survivor_region_count = 0;
+  for (uint i = 0; i < num_alloc_regions(); i++) {
+    survivor_region_count += survivor_gc_alloc_region(context, i)->count();
+    survivor_gc_alloc_region(context, i)->release();
+  }
+  evacuation_info.set_allocation_regions(survivor_region_count +
                                          old_gc_alloc_region(context)->count());
-  survivor_gc_alloc_region(context)->release();
   // If we have an old GC alloc region to release, we'll save it in
   // _retained_old_gc_alloc_region. If we don't
   // _retained_old_gc_alloc_region will become NULL. This is what we
@@ -105,7 +126,9 @@ void G1DefaultAllocator::release_gc_alloc_regions(uint no_of_gc_workers, Evacuat
 }
 
 void G1DefaultAllocator::abandon_gc_alloc_regions() {
-  assert(survivor_gc_alloc_region(AllocationContext::current())->get() == NULL, "pre-condition");
+  for (uint i = 0; i < num_alloc_regions(); i++) {
+    assert(survivor_gc_alloc_region(AllocationContext::current(), i)->get() == NULL, "pre-condition");
+  }
   assert(old_gc_alloc_region(AllocationContext::current())->get() == NULL, "pre-condition");
   _retained_old_gc_alloc_region = NULL;
 }
@@ -115,14 +138,15 @@ G1ParGCAllocBuffer::G1ParGCAllocBuffer(size_t gclab_word_size) :
 
 HeapWord* G1ParGCAllocator::allocate_direct_or_new_plab(InCSetState dest,
                                                         size_t word_sz,
-                                                        AllocationContext_t context) {
+                                                        AllocationContext_t context,
+                                                        uint node_index) {
   size_t gclab_word_size = _g1h->desired_plab_sz(dest);
   if (word_sz * 100 < gclab_word_size * ParallelGCBufferWastePct) {
-    G1ParGCAllocBuffer* alloc_buf = alloc_buffer(dest, context);
+    G1ParGCAllocBuffer* alloc_buf = alloc_buffer(dest, context, node_index);
     add_to_alloc_buffer_waste(alloc_buf->words_remaining());
     alloc_buf->retire(false /* end_of_gc */, false /* retain */);
 
-    HeapWord* buf = _g1h->par_allocate_during_gc(dest, gclab_word_size, context);
+    HeapWord* buf = _g1h->par_allocate_during_gc(dest, gclab_word_size, context, node_index);
     if (buf == NULL) {
       return NULL; // Let caller handle allocation failure.
     }
@@ -134,25 +158,47 @@ HeapWord* G1ParGCAllocator::allocate_direct_or_new_plab(InCSetState dest,
     assert(obj != NULL, "buffer was definitely big enough...");
     return obj;
   } else {
-    return _g1h->par_allocate_during_gc(dest, word_sz, context);
+    return _g1h->par_allocate_during_gc(dest, word_sz, context, node_index);
   }
 }
 
 G1DefaultParGCAllocator::G1DefaultParGCAllocator(G1CollectedHeap* g1h) :
-  G1ParGCAllocator(g1h),
-  _surviving_alloc_buffer(g1h->desired_plab_sz(InCSetState::Young)),
-  _tenured_alloc_buffer(g1h->desired_plab_sz(InCSetState::Old)) {
+  G1ParGCAllocator(g1h) {
   for (uint state = 0; state < InCSetState::Num; state++) {
     _alloc_buffers[state] = NULL;
+    _num_alloc_buffers[state] = 0;
+  }
+  _num_alloc_buffers[InCSetState::Young] = g1h->allocator()->num_alloc_regions();
+  _num_alloc_buffers[InCSetState::Old] = 1;
+
+  for (uint state = 0; state < InCSetState::Num; state++) {
+    uint length = _num_alloc_buffers[state];
+    if (length == 0) {
+      continue;
+    }
+    size_t word_sz = g1h->desired_plab_sz((InCSetState::in_cset_state_t)state);
+    _alloc_buffers[state] = NEW_C_HEAP_ARRAY(G1ParGCAllocBuffer*, length, mtGC);
+    for (uint i = 0; i < length; i++) {
+      _alloc_buffers[state][i] = new G1ParGCAllocBuffer(word_sz);
+    }
+  }
+}
+
+G1DefaultParGCAllocator::~G1DefaultParGCAllocator() {
+  for (uint state = 0; state < InCSetState::Num; state++) {
+    if (_alloc_buffers[state] != NULL) {
+      for (uint i = 0; i < _num_alloc_buffers[state]; i++) {
+        delete _alloc_buffers[state][i];
+      }
+      FREE_C_HEAP_ARRAY(G1ParGCAllocBuffer*, _alloc_buffers[state], mtGC);
+    }
   }
-  _alloc_buffers[InCSetState::Young] = &_surviving_alloc_buffer;
-  _alloc_buffers[InCSetState::Old]  = &_tenured_alloc_buffer;
 }
 
 void G1DefaultParGCAllocator::retire_alloc_buffers() {
   for (uint state = 0; state < InCSetState::Num; state++) {
-    G1ParGCAllocBuffer* const buf = _alloc_buffers[state];
-    if (buf != NULL) {
+    for (uint i = 0; i < _num_alloc_buffers[state]; i++) {
+      G1ParGCAllocBuffer* const buf = _alloc_buffers[state][i];
       add_to_alloc_buffer_waste(buf->words_remaining());
       buf->flush_stats_and_retire(_g1h->alloc_buffer_stats(state),
                                   true /* end_of_gc */,
@@ -28,6 +28,7 @@
 #include "gc_implementation/g1/g1AllocationContext.hpp"
 #include "gc_implementation/g1/g1AllocRegion.hpp"
 #include "gc_implementation/g1/g1InCSetState.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/shared/parGCAllocBuffer.hpp"
 
 // Base class for G1 allocators.
@@ -35,17 +36,26 @@ class G1Allocator : public CHeapObj<mtGC> {
   friend class VMStructs;
 protected:
   G1CollectedHeap* _g1h;
+  G1NUMA* _numa;
 
   // Outside of GC pauses, the number of bytes used in all regions other
-  // than the current allocation region.
+  // than the current allocation regions.
   size_t _summary_bytes_used;
 
 public:
    G1Allocator(G1CollectedHeap* heap) :
-     _g1h(heap), _summary_bytes_used(0) { }
+     _g1h(heap), _numa(G1NUMA::numa()), _summary_bytes_used(0) { }
 
    static G1Allocator* create_allocator(G1CollectedHeap* g1h);
 
+   // There is one mutator and one survivor alloc region per active
+   // NUMA node.
+   uint num_alloc_regions() const { return _numa->num_active_nodes(); }
+
+   // The index of the NUMA node the current thread runs on; used to
+   // select the alloc region to allocate into.
+   uint current_node_index() const { return _numa->index_of_current_thread(); }
+
    virtual void init_mutator_alloc_region() = 0;
    virtual void release_mutator_alloc_region() = 0;
 
@@ -53,8 +63,8 @@ public:
    virtual void release_gc_alloc_regions(uint no_of_gc_workers, EvacuationInfo& evacuation_info) = 0;
    virtual void abandon_gc_alloc_regions() = 0;
 
-   virtual MutatorAllocRegion*    mutator_alloc_region(AllocationContext_t context) = 0;
-   virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context) = 0;
+   virtual MutatorAllocRegion*    mutator_alloc_region(AllocationContext_t context, uint node_index) = 0;
+   virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context, uint node_index) = 0;
    virtual OldGCAllocRegion*      old_gc_alloc_region(AllocationContext_t context) = 0;
    virtual size_t                 used() = 0;
    virtual bool                   is_retained_old_region(HeapRegion* hr) = 0;
@@ -92,12 +102,13 @@ public:
 // The default allocator for G1.
 class G1DefaultAllocator : public G1Allocator {
 protected:
-  // Alloc region used to satisfy mutator allocation requests.
-  MutatorAllocRegion _mutator_alloc_region;
+  // Alloc regions used to satisfy mutator allocation requests, one
+  // per NUMA node.
+  MutatorAllocRegion* _mutator_alloc_regions;
 
-  // Alloc region used to satisfy allocation requests by the GC for
-  // survivor objects.
-  SurvivorGCAllocRegion _survivor_gc_alloc_region;
+  // Alloc regions used to satisfy allocation requests by the GC for
+  // survivor objects, one per NUMA node.
+  SurvivorGCAllocRegion* _survivor_gc_alloc_regions;
 
   // Alloc region used to satisfy allocation requests by the GC for
   // old objects.
@@ -105,7 +116,7 @@ protected:
 
   HeapRegion* _retained_old_gc_alloc_region;
 public:
-  G1DefaultAllocator(G1CollectedHeap* heap) : G1Allocator(heap), _retained_old_gc_alloc_region(NULL) { }
+  G1DefaultAllocator(G1CollectedHeap* heap);
 
   virtual void init_mutator_alloc_region();
   virtual void release_mutator_alloc_region();
@@ -118,12 +129,14 @@ public:
     return _retained_old_gc_alloc_region == hr;
   }
 
-  virtual MutatorAllocRegion* mutator_alloc_region(AllocationContext_t context) {
-    return &_mutator_alloc_region;
+  virtual MutatorAllocRegion* mutator_alloc_region(AllocationContext_t context, uint node_index) {
+    assert(node_index < num_alloc_regions(), err_msg("Invalid node index %u", node_index));
+    return &_mutator_alloc_regions[node_index];
   }
 
-  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context) {
-    return &_survivor_gc_alloc_region;
+  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context, uint node_index) {
+    assert(node_index < num_alloc_regions(), err_msg("Invalid node index %u", node_index));
+    return &_survivor_gc_alloc_regions[node_index];
   }
 
   virtual OldGCAllocRegion* old_gc_alloc_region(AllocationContext_t context) {
@@ -135,10 +148,12 @@ public:
            "Should be owned on this thread's behalf.");
     size_t result = _summary_bytes_used;
 
-    // Read only once in case it is set to NULL concurrently
-    HeapRegion* hr = mutator_alloc_region(AllocationContext::current())->get();
-    if (hr != NULL) {
-      result += hr->used();
+    for (uint i = 0; i < num_alloc_regions(); i++) {
+      // Read only once in case it is set to NULL concurrently
+      HeapRegion* hr = mutator_alloc_region(AllocationContext::current(), i)->get();
+      if (hr != NULL) {
+        result += hr->used();
+      }
     }
     return result;
   }
@@ -187,7 +202,8 @@ protected:
   void add_to_undo_waste(size_t waste)         { _undo_waste += waste; }
 
   virtual void retire_alloc_buffers() = 0;
-  virtual G1ParGCAllocBuffer* alloc_buffer(InCSetState dest, AllocationContext_t context) = 0;
+  virtual G1ParGCAllocBuffer* alloc_buffer(InCSetState dest, AllocationContext_t context,
+                                           uint node_index) = 0;
 
   // Calculate the survivor space object alignment in bytes. Returns that or 0 if
   // there are no restrictions on survivor alignment.
@@ -208,6 +224,7 @@ public:
     _g1h(g1h), _survivor_alignment_bytes(calc_survivor_alignment_bytes()),
     _alloc_buffer_waste(0), _undo_waste(0) {
   }
+  virtual ~G1ParGCAllocator() { }
 
   static G1ParGCAllocator* create_allocator(G1CollectedHeap* g1h);
 
@@ -216,17 +233,20 @@ public:
 
   // Allocate word_sz words in dest, either directly into the regions or by
   // allocating a new PLAB. Returns the address of the allocated memory, NULL if
-  // not successful.
+  // not successful. Survivor space is taken from the NUMA node with the
+  // given index.
   HeapWord* allocate_direct_or_new_plab(InCSetState dest,
                                         size_t word_sz,
-                                        AllocationContext_t context);
+                                        AllocationContext_t context,
+                                        uint node_index);
 
   // Allocate word_sz words in the PLAB of dest.  Returns the address of the
   // allocated memory, NULL if not successful.
   HeapWord* plab_allocate(InCSetState dest,
                           size_t word_sz,
-                          AllocationContext_t context) {
-    G1ParGCAllocBuffer* buffer = alloc_buffer(dest, context);
+                          AllocationContext_t context,
+                          uint node_index) {
+    G1ParGCAllocBuffer* buffer = alloc_buffer(dest, context, node_index);
     if (_survivor_alignment_bytes == 0) {
       return buffer->allocate(word_sz);
     } else {
@@ -235,19 +255,21 @@ public:
   }
 
   HeapWord* allocate(InCSetState dest, size_t word_sz,
-                     AllocationContext_t context) {
-    HeapWord* const obj = plab_allocate(dest, word_sz, context);
+                     AllocationContext_t context, uint node_index) {
+    HeapWord* const obj = plab_allocate(dest, word_sz, context, node_index);
     if (obj != NULL) {
       return obj;
     }
-    return allocate_direct_or_new_plab(dest, word_sz, context);
+    return allocate_direct_or_new_plab(dest, word_sz, context, node_index);
   }
 
-  void undo_allocation(InCSetState dest, HeapWord* obj, size_t word_sz, AllocationContext_t context) {
-    if (alloc_buffer(dest, context)->contains(obj)) {
-      assert(alloc_buffer(dest, context)->contains(obj + word_sz - 1),
+  void undo_allocation(InCSetState dest, HeapWord* obj, size_t word_sz,
+                       AllocationContext_t context, uint node_index) {
+    G1ParGCAllocBuffer* buffer = alloc_buffer(dest, context, node_index);
+    if (buffer->contains(obj)) {
+      assert(buffer->contains(obj + word_sz - 1),
              "should contain whole object");
-      alloc_buffer(dest, context)->undo_allocation(obj, word_sz);
+      buffer->undo_allocation(obj, word_sz);
     } else {
       CollectedHeap::fill_with_object(obj, word_sz);
       add_to_undo_waste(word_sz);
@@ -256,19 +278,25 @@ public:
 };
 
 class G1DefaultParGCAllocator : public G1ParGCAllocator {
-  G1ParGCAllocBuffer  _surviving_alloc_buffer;
-  G1ParGCAllocBuffer  _tenured_alloc_buffer;
-  G1ParGCAllocBuffer* _alloc_buffers[InCSetState::Num];
+  // The PLABs of each destination. There is one survivor PLAB per NUMA
+  // node and a single tenured PLAB, as the old GC alloc region is
+  // shared by all nodes.
+  G1ParGCAllocBuffer** _alloc_buffers[InCSetState::Num];
+  uint _num_alloc_buffers[InCSetState::Num];
 
 public:
   G1DefaultParGCAllocator(G1CollectedHeap* g1h);
+  virtual ~G1DefaultParGCAllocator();
 
-  virtual G1ParGCAllocBuffer* alloc_buffer(InCSetState dest, AllocationContext_t context) {
+  virtual G1ParGCAllocBuffer* alloc_buffer(InCSetState dest, AllocationContext_t context,
+                                           uint node_index) {
     assert(dest.is_valid(),
            err_msg("Allocation buffer index out-of-bounds: " CSETSTATE_FORMAT, dest.value()));
     assert(_alloc_buffers[dest.value()] != NULL,
            err_msg("Allocation buffer is NULL: " CSETSTATE_FORMAT, dest.value()));
-    return _alloc_buffers[dest.value()];
+    uint index = (_num_alloc_buffers[dest.value()] > 1) ? node_index : 0;
+    assert(index < _num_alloc_buffers[dest.value()], err_msg("Invalid node index %u", node_index));
+    return _alloc_buffers[dest.value()][index];
   }
 
   virtual void retire_alloc_buffers() ;
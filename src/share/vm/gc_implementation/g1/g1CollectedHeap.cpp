@@ -65,6 +65,7 @@
 #include "memory/referenceProcessor.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/oop.pcgc.inline.hpp"
+#include "runtime/init.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/vmThread.hpp"
 
@@ -509,7 +510,7 @@ G1CollectedHeap* G1CollectedHeap::_g1h;
 // Private methods.
 
 HeapRegion*
-G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
+G1CollectedHeap::new_region_try_secondary_free_list(bool is_old, uint node_index) {
   MutexLockerEx x(SecondaryFreeList_lock, Mutex::_no_safepoint_check_flag);
   while (!_secondary_free_list.is_empty() || free_regions_coming()) {
     if (!_secondary_free_list.is_empty()) {
@@ -525,7 +526,7 @@ G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
 
       assert(_hrm.num_free_regions() > 0, "if the secondary_free_list was not "
              "empty we should have moved at least one entry to the free_list");
-      HeapRegion* res = _hrm.allocate_free_region(is_old);
+      HeapRegion* res = _hrm.allocate_free_region(is_old, node_index);
       if (G1ConcRegionFreeingVerbose) {
         gclog_or_tty->print_cr("G1ConcRegionFreeing [region alloc] : "
                                "allocated " HR_FORMAT " from secondary_free_list",
@@ -547,7 +548,8 @@ G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
   return NULL;
 }
 
-HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_expand) {
+HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_expand,
+                                        uint node_index) {
   assert(!isHumongous(word_size) || word_size <= HeapRegion::GrainWords,
          "the only time we use this to allocate a humongous region is "
          "when we are allocating a single humongous region");
@@ -559,21 +561,21 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_e
         gclog_or_tty->print_cr("G1ConcRegionFreeing [region alloc] : "
                                "forced to look at the secondary_free_list");
       }
-      res = new_region_try_secondary_free_list(is_old);
+      res = new_region_try_secondary_free_list(is_old, node_index);
       if (res != NULL) {
         return res;
       }
     }
   }
 
-  res = _hrm.allocate_free_region(is_old);
+  res = _hrm.allocate_free_region(is_old, node_index);
 
   if (res == NULL) {
     if (G1ConcRegionFreeingVerbose) {
       gclog_or_tty->print_cr("G1ConcRegionFreeing [region alloc] : "
                              "res == NULL, trying the secondary_free_list");
     }
-    res = new_region_try_secondary_free_list(is_old);
+    res = new_region_try_secondary_free_list(is_old, node_index);
   }
   if (res == NULL && do_expand && _expand_heap_after_alloc_failure) {
     // Currently, only attempts to allocate GC alloc regions set
@@ -592,7 +594,7 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_e
       // always expand the heap by an amount aligned to the heap
       // region size, the free list should in theory not be empty.
       // In either case allocate_free_region() will check for NULL.
-      res = _hrm.allocate_free_region(is_old);
+      res = _hrm.allocate_free_region(is_old, node_index);
     } else {
       _expand_heap_after_alloc_failure = false;
     }
@@ -891,6 +893,7 @@ G1CollectedHeap::mem_allocate(size_t word_size,
 
 HeapWord* G1CollectedHeap::attempt_allocation_slow(size_t word_size,
                                                    AllocationContext_t context,
+                                                   uint node_index,
                                                    uint* gc_count_before_ret,
                                                    uint* gclocker_retry_count_ret) {
   // Make sure you read the note in attempt_allocation_humongous().
@@ -907,28 +910,29 @@ HeapWord* G1CollectedHeap::attempt_allocation_slow(size_t word_size,
   // fails to perform the allocation. b) is the only case when we'll
   // return NULL.
   HeapWord* result = NULL;
+  MutatorAllocRegion* alloc_region = _allocator->mutator_alloc_region(context, node_index);
   for (int try_count = 1; /* we'll return */; try_count += 1) {
     bool should_try_gc;
     uint gc_count_before;
 
     {
       MutexLockerEx x(Heap_lock);
-      result = _allocator->mutator_alloc_region(context)->attempt_allocation_locked(word_size,
-                                                                                    false /* bot_updates */);
+      result = alloc_region->attempt_allocation_locked(word_size,
+                                                       false /* bot_updates */);
       if (result != NULL) {
         return result;
       }
 
       // If we reach here, attempt_allocation_locked() above failed to
       // allocate a new region. So the mutator alloc region should be NULL.
-      assert(_allocator->mutator_alloc_region(context)->get() == NULL, "only way to get here");
+      assert(alloc_region->get() == NULL, "only way to get here");
 
       if (GC_locker::is_active_and_needs_gc()) {
         if (g1_policy()->can_expand_young_list()) {
           // No need for an ergo verbose message here,
           // can_expand_young_list() does this when it returns true.
-          result = _allocator->mutator_alloc_region(context)->attempt_allocation_force(word_size,
-                                                                                       false /* bot_updates */);
+          result = alloc_region->attempt_allocation_force(word_size,
+                                                          false /* bot_updates */);
           if (result != NULL) {
             return result;
           }
@@ -988,8 +992,8 @@ HeapWord* G1CollectedHeap::attempt_allocation_slow(size_t word_size,
     // first attempt (without holding the Heap_lock) here and the
     // follow-on attempt will be at the start of the next loop
     // iteration (after taking the Heap_lock).
-    result = _allocator->mutator_alloc_region(context)->attempt_allocation(word_size,
-                                                                           false /* bot_updates */);
+    result = alloc_region->attempt_allocation(word_size,
+                                              false /* bot_updates */);
     if (result != NULL) {
       return result;
     }
@@ -1128,13 +1132,14 @@ HeapWord* G1CollectedHeap::attempt_allocation_at_safepoint(size_t word_size,
                                                            AllocationContext_t context,
                                                            bool expect_null_mutator_alloc_region) {
   assert_at_safepoint(true /* should_be_vm_thread */);
-  assert(_allocator->mutator_alloc_region(context)->get() == NULL ||
-                                             !expect_null_mutator_alloc_region,
+  MutatorAllocRegion* alloc_region =
+    _allocator->mutator_alloc_region(context, _allocator->current_node_index());
+  assert(alloc_region->get() == NULL || !expect_null_mutator_alloc_region,
          "the current alloc region was unexpectedly found to be non-NULL");
 
   if (!isHumongous(word_size)) {
-    return _allocator->mutator_alloc_region(context)->attempt_allocation_locked(word_size,
-                                                      false /* bot_updates */);
+    return alloc_region->attempt_allocation_locked(word_size,
+                                                   false /* bot_updates */);
   } else {
     HeapWord* result = humongous_obj_allocate(word_size, context);
     if (result != NULL && g1_policy()->need_to_start_conc_mark("STW humongous allocation")) {
@@ -1234,7 +1239,7 @@ public:
       }
     } else if (hr->continuesHumongous()) {
       _hr_printer->post_compaction(hr, G1HRPrinter::ContinuesHumongous);
-    } else if (hr->is_old()) {
+    } else if (hr->is_old() || hr->is_archive()) {
       _hr_printer->post_compaction(hr, G1HRPrinter::Old);
     } else {
       ShouldNotReachHere();
@@ -1359,8 +1364,10 @@ bool G1CollectedHeap::do_collection(bool explicit_gc,
       // G1CollectedHeap::ref_processing_init() about
       // how reference processing currently works in G1.
 
-      // Temporarily make discovery by the STW ref processor single threaded (non-MT).
-      ReferenceProcessorMTDiscoveryMutator stw_rp_disc_ser(ref_processor_stw(), false);
+      // Temporarily make discovery by the STW ref processor single threaded (non-MT),
+      // unless the full gc marks in parallel.
+      ReferenceProcessorMTDiscoveryMutator stw_rp_disc_ser(ref_processor_stw(),
+                                                           G1MarkSweep::use_parallel_full_gc());
 
       // Temporarily clear the STW ref processor's _is_alive_non_header field.
       ReferenceProcessorIsAliveMutator stw_rp_is_alive_null(ref_processor_stw(), NULL);
@@ -1644,6 +1651,93 @@ resize_if_necessary_after_full_collection(size_t word_size) {
   }
 }
 
+void G1CollectedHeap::shrink_if_necessary_after_cleanup() {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+  assert(_periodic_cycle_in_progress, "only shrink after a periodic cycle");
+  _periodic_cycle_in_progress = false;
+
+  const size_t capacity_after_cleanup = capacity();
+  const size_t used_after_cleanup = used();
+
+  // Same as the maximum desired capacity after a Full GC above.
+  const double maximum_free_percentage = (double) MaxHeapFreeRatio / 100.0;
+  const double minimum_used_percentage = 1.0 - maximum_free_percentage;
+  const size_t min_heap_size = collector_policy()->min_heap_byte_size();
+  const size_t max_heap_size = collector_policy()->max_heap_byte_size();
+
+  double maximum_desired_capacity_d =
+    MIN2((double) used_after_cleanup / minimum_used_percentage,
+         (double) max_heap_size);
+  size_t maximum_desired_capacity =
+    MAX2((size_t) maximum_desired_capacity_d, min_heap_size);
+
+  if (capacity_after_cleanup <= maximum_desired_capacity) {
+    return;
+  }
+
+  size_t shrink_bytes = capacity_after_cleanup - maximum_desired_capacity;
+  ergo_verbose4(ErgoHeapSizing,
+                "attempt heap shrinking",
+                ergo_format_reason("capacity higher than "
+                                   "max desired capacity after Cleanup")
+                ergo_format_byte("capacity")
+                ergo_format_byte("occupancy")
+                ergo_format_byte_perc("max desired capacity"),
+                capacity_after_cleanup, used_after_cleanup,
+                maximum_desired_capacity, (double) MaxHeapFreeRatio);
+
+  // Unlike at the end of a Full GC the mutator alloc region is still
+  // active. Retire it so that the used bytes are accounted for when
+  // the free list is rebuilt, and make sure that the regions freed
+  // by this cycle are on the free list before it is torn down.
+  _allocator->release_mutator_alloc_region();
+  append_secondary_free_list_if_not_empty_with_lock();
+
+  shrink(shrink_bytes);
+
+  _allocator->init_mutator_alloc_region();
+}
+
+bool G1CollectedHeap::should_start_periodic_gc() {
+  if (G1PeriodicGCInterval == 0) {
+    return false;
+  }
+
+  // A cycle that is already in progress gives memory back when it
+  // completes.
+  if (concurrent_mark()->cmThread()->during_cycle()) {
+    return false;
+  }
+
+  if (millis_since_last_gc() < (jlong) G1PeriodicGCInterval) {
+    return false;
+  }
+
+  // Do not disturb a machine that is busy with other work.
+  if (G1PeriodicGCSystemLoadThreshold > 0) {
+    double recent_load;
+    if (os::loadavg(&recent_load, 1) != -1 &&
+        recent_load > (double) G1PeriodicGCSystemLoadThreshold) {
+      ergo_verbose2(ErgoConcCycles,
+                    "do not request periodic collection",
+                    ergo_format_reason("system load above threshold")
+                    ergo_format_double("system load")
+                    ergo_format_double("threshold"),
+                    recent_load, (double) G1PeriodicGCSystemLoadThreshold);
+      return false;
+    }
+  }
+  return true;
+}
+
+jlong G1CollectedHeap::periodic_gc_wait_millis() {
+  assert(G1PeriodicGCInterval > 0, "periodic collections are disabled");
+  jlong remaining = (jlong) G1PeriodicGCInterval - millis_since_last_gc();
+  // If the collection is overdue but could not be started, check again
+  // after another full interval.
+  return remaining > 0 ? remaining : (jlong) G1PeriodicGCInterval;
+}
+
 
 HeapWord*
 G1CollectedHeap::satisfy_failed_allocation(size_t word_size,
@@ -1786,6 +1880,61 @@ bool G1CollectedHeap::expand(size_t expand_bytes) {
   return regions_to_expand > 0;
 }
 
+bool G1CollectedHeap::alloc_archive_regions(MemRegion range) {
+  assert(!is_init_completed() || SafepointSynchronize::is_at_safepoint(),
+         "only during VM initialization or CDS dumping");
+  MutexLockerEx x(SafepointSynchronize::is_at_safepoint() ? NULL : Heap_lock);
+
+  if (range.is_empty() || !_hrm.reserved().contains(range) ||
+      !is_size_aligned((size_t)range.start(), HeapRegion::GrainBytes)) {
+    return false;
+  }
+  uint first = addr_to_region(range.start());
+  uint last = addr_to_region(range.last());
+  if (!_hrm.allocate_regions_at(first, last - first + 1)) {
+    return false;
+  }
+  g1_policy()->record_new_heap_size(num_regions());
+
+  for (uint i = first; i <= last; i++) {
+    HeapRegion* hr = region_at(i);
+    assert(hr->is_empty(), "sanity");
+    hr->set_archive();
+    _hr_printer.alloc(hr, G1HRPrinter::Old);
+  }
+  return true;
+}
+
+void G1CollectedHeap::fill_archive_regions(MemRegion range) {
+  MutexLockerEx x(SafepointSynchronize::is_at_safepoint() ? NULL : Heap_lock);
+
+  // Allocating the objects in place sets up the block offset tables.
+  HeapWord* p = range.start();
+  while (p < range.end()) {
+    size_t word_size = oop(p)->size();
+    HeapRegion* hr = heap_region_containing_raw(p);
+    assert(hr->is_archive(), "must be an archive region");
+    HeapWord* obj = hr->allocate(word_size);
+    guarantee(obj == p, err_msg("archived object " PTR_FORMAT " crosses a region boundary", p2i(p)));
+    p += word_size;
+  }
+  assert(p == range.end(), "the range must be parsable");
+  _allocator->increase_used(range.byte_size());
+}
+
+void G1CollectedHeap::dealloc_archive_regions(MemRegion range) {
+  MutexLockerEx x(SafepointSynchronize::is_at_safepoint() ? NULL : Heap_lock);
+
+  uint first = addr_to_region(range.start());
+  uint last = addr_to_region(range.last());
+  for (uint i = first; i <= last; i++) {
+    HeapRegion* hr = region_at(i);
+    assert(hr->is_archive() && hr->is_empty(), "must be an empty archive region");
+    hr->hr_clear(false /* par */, true /* clear_space */);
+    _hrm.insert_into_free_list(hr);
+  }
+}
+
 void G1CollectedHeap::shrink_helper(size_t shrink_bytes) {
   size_t aligned_shrink_bytes =
     ReservedSpace::page_align_size_down(shrink_bytes);
@@ -1859,6 +2008,7 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
   _humongous_reclaim_candidates(),
   _has_humongous_reclaim_candidates(false),
   _free_regions_coming(false),
+  _periodic_cycle_in_progress(false),
   _young_list(new YoungList(this)),
   _gc_time_stamp(0),
   _survivor_plab_stats(YoungPLABSize, PLABWeight),
@@ -1880,6 +2030,8 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
 
   _g1h = this;
 
+  _numa = G1NUMA::create();
+  _evac_worker_estimator = new GCWorkerEstimator("G1 evacuation");
   _allocator = G1Allocator::create_allocator(_g1h);
   _humongous_object_threshold_in_words = HeapRegion::GrainWords / 2;
 
@@ -1998,10 +2150,12 @@ jint G1CollectedHeap::initialize() {
   // Carve out the G1 part of the heap.
 
   ReservedSpace g1_rs = heap_rs.first_part(max_byte_size);
+  size_t page_size = UseLargePages ? os::large_page_size() : os::vm_page_size();
+  _numa->set_region_info(HeapRegion::GrainBytes, page_size);
   G1RegionToSpaceMapper* heap_storage =
     G1RegionToSpaceMapper::create_mapper(g1_rs,
                                          g1_rs.size(),
-                                         UseLargePages ? os::large_page_size() : os::vm_page_size(),
+                                         page_size,
                                          HeapRegion::GrainBytes,
                                          1,
                                          mtJavaHeap);
@@ -2333,6 +2487,7 @@ bool G1CollectedHeap::should_do_concurrent_full_gc(GCCause::Cause cause) {
     case GCCause::_gc_locker:               return GCLockerInvokesConcurrent;
     case GCCause::_java_lang_system_gc:     return ExplicitGCInvokesConcurrent;
     case GCCause::_g1_humongous_allocation: return true;
+    case GCCause::_g1_periodic_collection:  return G1PeriodicGCInvokesConcurrent;
     case GCCause::_update_allocation_context_stats_inc: return true;
     case GCCause::_wb_conc_mark:            return true;
     default:                                return false;
@@ -2859,7 +3014,7 @@ void G1CollectedHeap::collection_set_iterate_from(HeapRegion* r,
 
 HeapRegion* G1CollectedHeap::next_compaction_region(const HeapRegion* from) const {
   HeapRegion* result = _hrm.next_region_in_heap(from);
-  while (result != NULL && result->isHumongous()) {
+  while (result != NULL && (result->isHumongous() || result->is_archive())) {
     result = _hrm.next_region_in_heap(result);
   }
   return result;
@@ -2910,7 +3065,8 @@ size_t G1CollectedHeap::unsafe_max_tlab_alloc(Thread* ignored) const {
   // since we can't allow tlabs to grow big enough to accommodate
   // humongous objects.
 
-  HeapRegion* hr = _allocator->mutator_alloc_region(AllocationContext::current())->get();
+  HeapRegion* hr = _allocator->mutator_alloc_region(AllocationContext::current(),
+                                                    _allocator->current_node_index())->get();
   size_t max_tlab = max_tlab_size() * wordSize;
   if (hr == NULL) {
     return max_tlab;
@@ -2924,8 +3080,14 @@ size_t G1CollectedHeap::max_capacity() const {
 }
 
 jlong G1CollectedHeap::millis_since_last_gc() {
-  // assert(false, "NYI");
-  return 0;
+  jlong now = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  jlong ret_val = now - g1_policy()->collection_pause_end_millis();
+  // javaTimeNanos() is only monotonic if the platform time source is.
+  if (ret_val < 0) {
+    NOT_PRODUCT(warning("time warp: " INT64_FORMAT, (int64_t) ret_val);)
+    return 0;
+  }
+  return ret_val;
 }
 
 void G1CollectedHeap::prepare_for_verify() {
@@ -3462,6 +3624,13 @@ void G1CollectedHeap::print_on(outputStream* st) const {
   st->print("%u survivors (" SIZE_FORMAT "K)", survivor_regions,
             (size_t) survivor_regions * HeapRegion::GrainBytes / K);
   st->cr();
+  if (_numa->is_enabled()) {
+    // The per node sizes as of the last recalculation by G1MonitoringSupport.
+    for (uint i = 0; i < _numa->num_active_nodes(); i++) {
+      st->print_cr("  numa node %d: committed " SIZE_FORMAT "K, used " SIZE_FORMAT "K",
+                   _numa->numa_id(i), _g1mm->node_committed(i) / K, _g1mm->node_used(i) / K);
+    }
+  }
   MetaspaceAux::print_on(st);
 }
 
@@ -3995,15 +4164,21 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
       // full collection counter.
       increment_old_marking_cycles_started();
       register_concurrent_cycle_start(_gc_timer_stw->gc_start());
+      _periodic_cycle_in_progress = (gc_cause() == GCCause::_g1_periodic_collection);
     }
 
     _gc_tracer_stw->report_yc_type(yc_type());
 
     TraceCPUTime tcpu(G1Log::finer(), true, gclog_or_tty);
 
+    // The work of the pause is its collection set and the thread stacks.
+    size_t work_words = g1_policy()->estimated_cset_words() +
+                        AdaptiveSizePolicy::root_set_words();
     uint active_workers = AdaptiveSizePolicy::calc_active_workers(workers()->total_workers(),
                                                                   workers()->active_workers(),
-                                                                  Threads::number_of_non_daemon_threads());
+                                                                  Threads::number_of_non_daemon_threads(),
+                                                                  _evac_worker_estimator,
+                                                                  work_words);
     assert(UseDynamicNumberOfGCThreads ||
            active_workers == workers()->total_workers(),
            "If not dynamic should be using all the  workers");
@@ -4836,8 +5011,8 @@ public:
     _process_strings(process_strings), _strings_processed(0), _strings_removed(0),
     _process_symbols(process_symbols), _symbols_processed(0), _symbols_removed(0) {
 
-    _initial_string_table_size = StringTable::the_table()->table_size();
-    _initial_symbol_table_size = SymbolTable::the_table()->table_size();
+    _initial_string_table_size = StringTable::the_table()->live_bucket_count();
+    _initial_symbol_table_size = SymbolTable::the_table()->live_bucket_count();
     if (process_strings) {
       StringTable::clear_parallel_claimed_index();
     }
@@ -5826,6 +6001,9 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
 
   double par_time_ms = (end_par_time_sec - start_par_time_sec) * 1000.0;
   phase_times->record_par_time(par_time_ms);
+  _evac_worker_estimator->sample((size_t) g1_policy()->cset_region_length() * HeapRegion::GrainWords +
+                                 AdaptiveSizePolicy::root_set_words(),
+                                 n_workers, par_time_ms);
 
   double code_root_fixup_time_ms =
         (os::elapsedTime() - end_par_time_sec) * 1000.0;
@@ -6597,8 +6775,8 @@ public:
       // We ignore free regions, we'll empty the free list afterwards.
       // We ignore young regions, we'll empty the young list afterwards.
       // We ignore humongous regions, we're not tearing down the
-      // humongous regions set.
-      assert(r->is_free() || r->is_young() || r->isHumongous(),
+      // humongous regions set. Archive regions are in no set.
+      assert(r->is_free() || r->is_young() || r->isHumongous() || r->is_archive(),
              "it cannot be another type");
     }
     return false;
@@ -6657,6 +6835,8 @@ public:
 
       if (r->isHumongous()) {
         // We ignore humongous regions, we left the humongous set unchanged
+      } else if (r->is_archive()) {
+        // Archive regions are never compacted and are in no set
       } else {
         // Objects that were compacted would have ended up on regions
         // that were previously old or free.
@@ -6707,7 +6887,8 @@ bool G1CollectedHeap::is_in_closed_subset(const void* p) const {
 // Methods for the mutator alloc region
 
 HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
-                                                      bool force) {
+                                                      bool force,
+                                                      uint node_index) {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
   assert(!force || g1_policy()->can_expand_young_list(),
          "if force is true we should be able to expand the young list");
@@ -6715,7 +6896,8 @@ HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
   if (force || !young_list_full) {
     HeapRegion* new_alloc_region = new_region(word_size,
                                               false /* is_old */,
-                                              false /* do_expand */);
+                                              false /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       set_region_short_lived_locked(new_alloc_region);
       _hr_printer.alloc(new_alloc_region, G1HRPrinter::Eden, young_list_full);
@@ -6760,14 +6942,16 @@ void G1CollectedHeap::set_par_threads() {
 
 HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size,
                                                  uint count,
-                                                 InCSetState dest) {
+                                                 InCSetState dest,
+                                                 uint node_index) {
   assert(FreeList_lock->owned_by_self(), "pre-condition");
 
   if (count < g1_policy()->max_regions(dest)) {
     const bool is_survivor = (dest.is_young());
     HeapRegion* new_alloc_region = new_region(word_size,
                                               !is_survivor,
-                                              true /* do_expand */);
+                                              true /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       // We really only need to do this for old regions given that we
       // should never scan survivors. But it doesn't hurt to do it
@@ -6839,6 +7023,8 @@ public:
     } else if (hr->is_old()) {
       assert(hr->containing_set() == _old_set, err_msg("Heap region %u is old but not in the old set.", hr->hrm_index()));
       _old_count.increment(1u, hr->capacity());
+    } else if (hr->is_archive()) {
+      assert(hr->containing_set() == NULL, err_msg("Heap region %u is an archive region but in a set.", hr->hrm_index()));
     } else {
       ShouldNotReachHere();
     }
@@ -34,6 +34,7 @@
 #include "gc_implementation/g1/g1HRPrinter.hpp"
 #include "gc_implementation/g1/g1InCSetState.hpp"
 #include "gc_implementation/g1/g1MonitoringSupport.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1SATBCardTableModRefBS.hpp"
 #include "gc_implementation/g1/g1YCTypes.hpp"
 #include "gc_implementation/g1/heapRegionManager.hpp"
@@ -263,6 +264,9 @@ private:
   // The sequence of all heap regions in the heap.
   HeapRegionManager _hrm;
 
+  // The NUMA nodes the heap regions and alloc regions are spread over.
+  G1NUMA* _numa;
+
   // Class that handles the different kinds of allocations.
   G1Allocator* _allocator;
 
@@ -342,6 +346,7 @@ private:
   // (a) cause == _gc_locker and +GCLockerInvokesConcurrent, or
   // (b) cause == _java_lang_system_gc and +ExplicitGCInvokesConcurrent.
   // (c) cause == _g1_humongous_allocation
+  // (d) cause == _g1_periodic_collection and +G1PeriodicGCInvokesConcurrent.
   bool should_do_concurrent_full_gc(GCCause::Cause cause);
 
   // Keeps track of how many "old marking cycles" (i.e., Full GCs or
@@ -456,14 +461,16 @@ protected:
   // check whether there's anything available on the
   // secondary_free_list and/or wait for more regions to appear on
   // that list, if _free_regions_coming is set.
-  HeapRegion* new_region_try_secondary_free_list(bool is_old);
+  HeapRegion* new_region_try_secondary_free_list(bool is_old, uint node_index);
 
   // Try to allocate a single non-humongous HeapRegion sufficient for
   // an allocation of the given word_size. If do_expand is true,
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. If the region is to be used as an old region or for a
-  // humongous object, set is_old to true. If not, to false.
-  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand);
+  // humongous object, set is_old to true. If not, to false. A region
+  // bound to the NUMA node with the given index is preferred.
+  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -532,6 +539,7 @@ protected:
   // pause. This should only be used for non-humongous allocations.
   HeapWord* attempt_allocation_slow(size_t word_size,
                                     AllocationContext_t context,
+                                    uint node_index,
                                     uint* gc_count_before_ret,
                                     uint* gclocker_retry_count_ret);
 
@@ -559,16 +567,19 @@ protected:
   // allocation region, either by picking one or expanding the
   // heap, and then allocate a block of the given size. The block
   // may not be a humongous - it must fit into a single heap region.
+  // Survivor space is allocated on the NUMA node with the given index.
   inline HeapWord* par_allocate_during_gc(InCSetState dest,
                                           size_t word_size,
-                                          AllocationContext_t context);
+                                          AllocationContext_t context,
+                                          uint node_index);
   // Ensure that no further allocations can happen in "r", bearing in mind
   // that parallel threads might be attempting allocations.
   void par_allocate_remaining_space(HeapRegion* r);
 
   // Allocation attempt during GC for a survivor object / PLAB.
   inline HeapWord* survivor_attempt_allocation(size_t word_size,
-                                               AllocationContext_t context);
+                                               AllocationContext_t context,
+                                               uint node_index);
 
   // Allocation attempt during GC for an old object / PLAB.
   inline HeapWord* old_attempt_allocation(size_t word_size,
@@ -577,13 +588,14 @@ protected:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force,
+                                       uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   HeapRegion* new_gc_alloc_region(size_t word_size, uint count,
-                                  InCSetState dest);
+                                  InCSetState dest, uint node_index);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, InCSetState dest);
 
@@ -635,6 +647,10 @@ public:
     return _allocator;
   }
 
+  G1NUMA* numa() const {
+    return _numa;
+  }
+
   G1MonitoringSupport* g1mm() {
     assert(_g1mm != NULL, "should have been initialized");
     return _g1mm;
@@ -646,6 +662,25 @@ public:
   // (Rounds up to a HeapRegion boundary.)
   bool expand(size_t expand_bytes);
 
+  // Support for the Java heap objects archived by CDS. They are mapped
+  // into archive regions, see HeapRegionType::is_archive(), which are
+  // never collected and whose objects never move. The archived objects
+  // only refer to other archived objects.
+
+  // Claims the regions covering the given range as archive regions. The
+  // range must start at a region boundary. Returns false if one of the
+  // regions is in use. Only called during VM initialization, or at a
+  // safepoint when the archive is dumped.
+  bool alloc_archive_regions(MemRegion range);
+
+  // Records the objects mapped into the range in the block offset tables
+  // of the archive regions and accounts for them as used.
+  void fill_archive_regions(MemRegion range);
+
+  // Returns the regions claimed by alloc_archive_regions() to the free
+  // list when the objects could not be mapped.
+  void dealloc_archive_regions(MemRegion range);
+
   // Returns the PLAB statistics for a given destination.
   inline PLABStats* alloc_buffer_stats(InCSetState dest);
 
@@ -958,6 +993,9 @@ protected:
   G1OldTracer* _gc_tracer_cm;
   G1NewTracer* _gc_tracer_stw;
 
+  // Chooses the number of workers of an evacuation pause.
+  GCWorkerEstimator* _evac_worker_estimator;
+
   // During reference object discovery, the _is_alive_non_header
   // closure (if non-null) is applied to the referent object to
   // determine whether the referent is live. If so then the
@@ -996,6 +1034,10 @@ protected:
 
   volatile bool _free_regions_coming;
 
+  // True if the current concurrent cycle was started by a periodic
+  // collection (see G1PeriodicGCInterval).
+  bool _periodic_cycle_in_progress;
+
 public:
 
   void set_refine_cte_cl_concurrency(bool concurrent);
@@ -1472,6 +1514,25 @@ public:
 
   virtual jlong millis_since_last_gc();
 
+  bool periodic_cycle_in_progress() const {
+    return _periodic_cycle_in_progress;
+  }
+
+  // Shrink the heap if necessary at the end of the Cleanup pause of a
+  // concurrent cycle started by a periodic collection, so that the
+  // memory of the regions freed by that cycle can be given back
+  // without a Full GC.
+  void shrink_if_necessary_after_cleanup();
+
+  // Returns true if the heap has been idle for G1PeriodicGCInterval
+  // milliseconds and a periodic collection should be started. Called
+  // by the service thread.
+  bool should_start_periodic_gc();
+
+  // The number of milliseconds until should_start_periodic_gc() should
+  // be checked again.
+  jlong periodic_gc_wait_millis();
+
 
   // Convenience function to be used in situations where the heap type can be
   // asserted to be this type.
@@ -94,6 +94,7 @@ G1CollectorPolicy::G1CollectorPolicy() :
 
   _alloc_rate_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
   _prev_collection_pause_end_ms(0.0),
+  _collection_pause_end_millis(os::javaTimeNanos() / NANOSECS_PER_MILLISEC),
   _rs_length_diff_seq(new TruncatedSeq(TruncatedSeqLength)),
   _cost_per_card_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
   _young_cards_per_entry_ratio_seq(new TruncatedSeq(TruncatedSeqLength)),
@@ -811,6 +812,7 @@ void G1CollectorPolicy::record_full_collection_end() {
   _trace_gen1_time_data.record_full_collection(full_gc_time_ms);
 
   update_recent_gc_times(end_sec, full_gc_time_ms);
+  _collection_pause_end_millis = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
 
   _g1->clear_full_collection();
 
@@ -967,6 +969,8 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
   bool last_pause_included_initial_mark = false;
   bool update_stats = !_g1->evacuation_failed();
 
+  _collection_pause_end_millis = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+
 #ifndef PRODUCT
   if (G1YoungSurvRateVerbose) {
     gclog_or_tty->cr();
@@ -1928,6 +1932,15 @@ uint G1CollectorPolicy::calc_min_old_cset_length() {
   return (uint) result;
 }
 
+size_t G1CollectorPolicy::estimated_cset_words() {
+  uint regions = _g1->young_list()->length();
+  if (!gcs_are_young()) {
+    regions += MIN2(calc_min_old_cset_length(),
+                    _collectionSetChooser->remaining_regions());
+  }
+  return (size_t) regions * HeapRegion::GrainWords;
+}
+
 uint G1CollectorPolicy::calc_max_old_cset_length() {
   // The max old CSet region bound is based on the threshold expressed
   // as a percentage of the heap size. I.e., it should bound the
@@ -233,6 +233,9 @@ private:
   TruncatedSeq* _alloc_rate_ms_seq;
   double        _prev_collection_pause_end_ms;
 
+  // Used to detect that the application has been idle.
+  jlong         _collection_pause_end_millis;
+
   TruncatedSeq* _rs_length_diff_seq;
   TruncatedSeq* _cost_per_card_ms_seq;
   TruncatedSeq* _young_cards_per_entry_ratio_seq;
@@ -649,6 +652,11 @@ public:
 
   G1GCPhaseTimes* phase_times() const { return _phase_times; }
 
+  // The size of the collection set of the coming pause, as far as it
+  // is known before it is chosen: the young regions, and for a mixed
+  // pause the minimum number of old regions.
+  size_t estimated_cset_words();
+
   // Check the current value of the young list RSet lengths and
   // compare it against the last prediction. If the current value is
   // higher, recalculate the young list target length prediction.
@@ -683,6 +691,12 @@ public:
   void record_full_collection_start();
   void record_full_collection_end();
 
+  // The time (in ms, see os::javaTimeNanos()) at which the last young
+  // or full collection ended.
+  jlong collection_pause_end_millis() const {
+    return _collection_pause_end_millis;
+  }
+
   // Must currently be called while the world is stopped.
   void record_concurrent_mark_init_end(double mark_init_elapsed_time_ms);
 
@@ -31,8 +31,10 @@
 #include "code/icBuffer.hpp"
 #include "gc_implementation/g1/g1Log.hpp"
 #include "gc_implementation/g1/g1MarkSweep.hpp"
+#include "gc_implementation/g1/g1ParMarkSweep.hpp"
 #include "gc_implementation/g1/g1RootProcessor.hpp"
 #include "gc_implementation/g1/g1StringDedup.hpp"
+#include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "gc_implementation/shared/gcHeapSummary.hpp"
 #include "gc_implementation/shared/gcTimer.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
@@ -55,6 +57,8 @@
 
 class HeapRegion;
 
+G1ParMarkSweep* G1MarkSweep::_par_mark_sweep = NULL;
+
 void G1MarkSweep::invoke_at_safepoint(ReferenceProcessor* rp,
                                       bool clear_all_softrefs) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
@@ -82,6 +86,10 @@ void G1MarkSweep::invoke_at_safepoint(ReferenceProcessor* rp,
 
   allocate_stacks();
 
+  if (use_parallel_full_gc()) {
+    setup_par_mark_sweep();
+  }
+
   // We should save the marks of the currently locked biased monitors.
   // The marking doesn't preserve the marks of biased objects.
   BiasedLocking::preserve_marks();
@@ -98,6 +106,9 @@ void G1MarkSweep::invoke_at_safepoint(ReferenceProcessor* rp,
   mark_sweep_phase4();
 
   GenMarkSweep::restore_marks();
+  if (_par_mark_sweep != NULL) {
+    _par_mark_sweep->restore_marks();
+  }
   BiasedLocking::restore_marks();
   GenMarkSweep::deallocate_stacks();
 
@@ -121,6 +132,27 @@ void G1MarkSweep::allocate_stacks() {
   GenMarkSweep::_preserved_count = 0;
 }
 
+void G1MarkSweep::setup_par_mark_sweep() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  FlexibleWorkGang* workers = g1h->workers();
+
+  // The per-worker state, including the marking stacks, is kept around
+  // between collections.
+  if (_par_mark_sweep == NULL) {
+    _par_mark_sweep = new G1ParMarkSweep(g1h, workers->total_workers());
+  }
+
+  uint n_workers =
+    AdaptiveSizePolicy::calc_active_workers(workers->total_workers(),
+                                            workers->active_workers(),
+                                            Threads::number_of_non_daemon_threads());
+  assert(UseDynamicNumberOfGCThreads ||
+         n_workers == workers->total_workers(),
+         "If not dynamic should be using all the workers");
+  workers->set_active_workers(n_workers);
+  _par_mark_sweep->set_n_workers(n_workers);
+}
+
 void G1MarkSweep::mark_sweep_phase1(bool& marked_for_unloading,
                                     bool clear_all_softrefs) {
   // Recursively traverse all live objects and mark them
@@ -132,34 +164,38 @@ void G1MarkSweep::mark_sweep_phase1(bool& marked_for_unloading,
   // Need cleared claim bits for the roots processing
   ClassLoaderDataGraph::clear_claimed_marks();
 
-  MarkingCodeBlobClosure follow_code_closure(&GenMarkSweep::follow_root_closure, !CodeBlobToOopClosure::FixRelocations);
-  {
-    G1RootProcessor root_processor(g1h);
-    if (ClassUnloading) {
-      root_processor.process_strong_roots(&GenMarkSweep::follow_root_closure,
-                                          &GenMarkSweep::follow_cld_closure,
-                                          &follow_code_closure);
-    } else {
-      root_processor.process_all_roots_no_string_table(
-                                          &GenMarkSweep::follow_root_closure,
-                                          &GenMarkSweep::follow_cld_closure,
-                                          &follow_code_closure);
-    }
-  }
-
   // Process reference objects found during marking
   ReferenceProcessor* rp = GenMarkSweep::ref_processor();
   assert(rp == g1h->ref_processor_stw(), "Sanity");
 
-  rp->setup_policy(clear_all_softrefs);
-  const ReferenceProcessorStats& stats =
-    rp->process_discovered_references(&GenMarkSweep::is_alive,
-                                      &GenMarkSweep::keep_alive,
-                                      &GenMarkSweep::follow_stack_closure,
-                                      NULL,
-                                      gc_timer(),
-                                      gc_tracer()->gc_id());
-  gc_tracer()->report_gc_reference_stats(stats);
+  if (_par_mark_sweep != NULL) {
+    _par_mark_sweep->mark_live_objects(rp, clear_all_softrefs);
+  } else {
+    MarkingCodeBlobClosure follow_code_closure(&GenMarkSweep::follow_root_closure, !CodeBlobToOopClosure::FixRelocations);
+    {
+      G1RootProcessor root_processor(g1h);
+      if (ClassUnloading) {
+        root_processor.process_strong_roots(&GenMarkSweep::follow_root_closure,
+                                            &GenMarkSweep::follow_cld_closure,
+                                            &follow_code_closure);
+      } else {
+        root_processor.process_all_roots_no_string_table(
+                                            &GenMarkSweep::follow_root_closure,
+                                            &GenMarkSweep::follow_cld_closure,
+                                            &follow_code_closure);
+      }
+    }
+
+    rp->setup_policy(clear_all_softrefs);
+    const ReferenceProcessorStats& stats =
+      rp->process_discovered_references(&GenMarkSweep::is_alive,
+                                        &GenMarkSweep::keep_alive,
+                                        &GenMarkSweep::follow_stack_closure,
+                                        NULL,
+                                        gc_timer(),
+                                        gc_tracer()->gc_id());
+    gc_tracer()->report_gc_reference_stats(stats);
+  }
 
 
   // This is the point where the entire marking should have completed.
@@ -216,26 +252,35 @@ void G1MarkSweep::mark_sweep_phase2() {
   GCTraceTime tm("phase 2", G1Log::fine() && Verbose, true, gc_timer(), gc_tracer()->gc_id());
   GenMarkSweep::trace("2");
 
-  prepare_compaction();
+  if (_par_mark_sweep != NULL) {
+    _par_mark_sweep->prepare_compaction();
+  } else {
+    prepare_compaction();
+  }
 }
 
-class G1AdjustPointersClosure: public HeapRegionClosure {
- public:
-  bool doHeapRegion(HeapRegion* r) {
-    if (r->isHumongous()) {
-      if (r->startsHumongous()) {
-        // We must adjust the pointers on the single H object.
-        oop obj = oop(r->bottom());
-        // point all the oops to the new location
+bool G1AdjustPointersClosure::doHeapRegion(HeapRegion* r) {
+  if (r->isHumongous()) {
+    if (r->startsHumongous()) {
+      // We must adjust the pointers on the single H object.
+      oop obj = oop(r->bottom());
+      // point all the oops to the new location
+      obj->adjust_pointers();
+    }
+  } else if (r->is_archive()) {
+    // Only the marked archive objects have been forwarded.
+    for (HeapWord* p = r->bottom(); p < r->top(); p += oop(p)->size()) {
+      oop obj = oop(p);
+      if (obj->is_gc_marked()) {
         obj->adjust_pointers();
       }
-    } else {
-      // This really ought to be "as_CompactibleSpace"...
-      r->adjust_pointers();
     }
-    return false;
+  } else {
+    // This really ought to be "as_CompactibleSpace"...
+    r->adjust_pointers();
   }
-};
+  return false;
+}
 
 void G1MarkSweep::mark_sweep_phase3() {
   G1CollectedHeap* g1h = G1CollectedHeap::heap();
@@ -247,6 +292,11 @@ void G1MarkSweep::mark_sweep_phase3() {
   // Need cleared claim bits for the roots processing
   ClassLoaderDataGraph::clear_claimed_marks();
 
+  if (_par_mark_sweep != NULL) {
+    _par_mark_sweep->adjust_pointers();
+    return;
+  }
+
   CodeBlobToOopClosure adjust_code_closure(&GenMarkSweep::adjust_pointer_closure, CodeBlobToOopClosure::FixRelocations);
   {
     G1RootProcessor root_processor(g1h);
@@ -272,27 +322,29 @@ void G1MarkSweep::mark_sweep_phase3() {
   g1h->heap_region_iterate(&blk);
 }
 
-class G1SpaceCompactClosure: public HeapRegionClosure {
-public:
-  G1SpaceCompactClosure() {}
-
-  bool doHeapRegion(HeapRegion* hr) {
-    if (hr->isHumongous()) {
-      if (hr->startsHumongous()) {
-        oop obj = oop(hr->bottom());
-        if (obj->is_gc_marked()) {
-          obj->init_mark();
-        } else {
-          assert(hr->is_empty(), "Should have been cleared in phase 2.");
-        }
-        hr->reset_during_compaction();
+bool G1SpaceCompactClosure::doHeapRegion(HeapRegion* hr) {
+  if (hr->isHumongous()) {
+    if (hr->startsHumongous()) {
+      oop obj = oop(hr->bottom());
+      if (obj->is_gc_marked()) {
+        obj->init_mark();
+      } else {
+        assert(hr->is_empty(), "Should have been cleared in phase 2.");
       }
-    } else {
-      hr->compact();
+      hr->reset_during_compaction();
     }
-    return false;
+  } else if (hr->is_archive()) {
+    for (HeapWord* p = hr->bottom(); p < hr->top(); p += oop(p)->size()) {
+      oop obj = oop(p);
+      if (obj->is_gc_marked()) {
+        obj->init_mark();
+      }
+    }
+  } else {
+    hr->compact();
   }
-};
+  return false;
+}
 
 void G1MarkSweep::mark_sweep_phase4() {
   // All pointers are now adjusted, move objects accordingly
@@ -306,6 +358,11 @@ void G1MarkSweep::mark_sweep_phase4() {
   GCTraceTime tm("phase 4", G1Log::fine() && Verbose, true, gc_timer(), gc_tracer()->gc_id());
   GenMarkSweep::trace("4");
 
+  if (_par_mark_sweep != NULL) {
+    _par_mark_sweep->compact();
+    return;
+  }
+
   G1SpaceCompactClosure blk;
   g1h->heap_region_iterate(&blk);
 
@@ -327,7 +384,7 @@ void G1PrepareCompactClosure::free_humongous_region(HeapRegion* hr) {
   hr->set_containing_set(NULL);
   _humongous_regions_removed.increment(1u, hr->capacity());
 
-  _g1h->free_humongous_region(hr, &dummy_free_list, false /* par */);
+  _g1h->free_humongous_region(hr, &dummy_free_list, _par);
   prepare_for_compaction(hr, end);
   dummy_free_list.remove_all();
 }
@@ -370,6 +427,16 @@ bool G1PrepareCompactClosure::doHeapRegion(HeapRegion* hr) {
     } else {
       assert(hr->continuesHumongous(), "Invalid humongous.");
     }
+  } else if (hr->is_archive()) {
+    // The objects of archive regions never move. Like live humongous
+    // objects, the marked ones are forwarded to themselves. Unmarked
+    // objects are kept as well since the archive may still hand them out.
+    for (HeapWord* p = hr->bottom(); p < hr->top(); p += oop(p)->size()) {
+      oop obj = oop(p);
+      if (obj->is_gc_marked()) {
+        obj->forward_to(obj);
+      }
+    }
   } else {
     prepare_for_compaction(hr, hr->end());
   }
@@ -35,6 +35,7 @@
 #include "runtime/timer.hpp"
 #include "utilities/growableArray.hpp"
 
+class G1ParMarkSweep;
 class ReferenceProcessor;
 
 // G1MarkSweep takes care of global mark-compact garbage collection for a
@@ -43,6 +44,9 @@ class ReferenceProcessor;
 // compaction.
 //
 // Class unloading will only occur when a full gc is invoked.
+//
+// With -XX:+G1ParallelFullGC the phases are executed by the G1 work
+// gang, see G1ParMarkSweep.
 class G1PrepareCompactClosure;
 
 class G1MarkSweep : AllStatic {
@@ -57,7 +61,16 @@ class G1MarkSweep : AllStatic {
   static STWGCTimer* gc_timer() { return GenMarkSweep::_gc_timer; }
   static SerialOldTracer* gc_tracer() { return GenMarkSweep::_gc_tracer; }
 
+  // Whether the phases of the full gc are executed by the G1 work gang.
+  static bool use_parallel_full_gc() {
+    return G1ParallelFullGC && G1CollectedHeap::use_parallel_gc_threads();
+  }
+
  private:
+  // State of the parallel full gc, allocated by the first parallel
+  // full gc; NULL if not in use.
+  static G1ParMarkSweep* _par_mark_sweep;
+
 
   // Mark live objects
   static void mark_sweep_phase1(bool& marked_for_deopt,
@@ -70,6 +83,7 @@ class G1MarkSweep : AllStatic {
   static void mark_sweep_phase4();
 
   static void allocate_stacks();
+  static void setup_par_mark_sweep();
   static void prepare_compaction();
   static void prepare_compaction_work(G1PrepareCompactClosure* blk);
 };
@@ -80,6 +94,8 @@ class G1PrepareCompactClosure : public HeapRegionClosure {
   ModRefBarrierSet* _mrbs;
   CompactPoint _cp;
   HeapRegionSetCount _humongous_regions_removed;
+  // Whether regions are claimed by several threads in parallel.
+  bool _par;
 
   virtual void prepare_for_compaction(HeapRegion* hr, HeapWord* end);
   void prepare_for_compaction_work(CompactPoint* cp, HeapRegion* hr, HeapWord* end);
@@ -87,13 +103,26 @@ class G1PrepareCompactClosure : public HeapRegionClosure {
   bool is_cp_initialized() const { return _cp.space != NULL; }
 
  public:
-  G1PrepareCompactClosure() :
+  G1PrepareCompactClosure(bool par = false) :
     _g1h(G1CollectedHeap::heap()),
     _mrbs(_g1h->g1_barrier_set()),
-    _humongous_regions_removed() { }
+    _humongous_regions_removed(),
+    _par(par) { }
 
   void update_sets();
   bool doHeapRegion(HeapRegion* hr);
 };
 
+class G1AdjustPointersClosure: public HeapRegionClosure {
+ public:
+  bool doHeapRegion(HeapRegion* r);
+};
+
+class G1SpaceCompactClosure: public HeapRegionClosure {
+ public:
+  G1SpaceCompactClosure() {}
+
+  bool doHeapRegion(HeapRegion* hr);
+};
+
 #endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1MARKSWEEP_HPP
@@ -89,7 +89,14 @@ G1MonitoringSupport::G1MonitoringSupport(G1CollectedHeap* g1h) :
   _young_gen_committed(0),
   _eden_committed(0),       _eden_used(0),
   _survivor_committed(0),   _survivor_used(0),
-  _old_committed(0),        _old_used(0) {
+  _old_committed(0),        _old_used(0),
+  _node_committed(NULL),    _node_used(NULL) {
+
+  G1NUMA* numa = g1h->numa();
+  if (numa->is_enabled()) {
+    _node_committed = NEW_C_HEAP_ARRAY(size_t, numa->num_active_nodes(), mtGC);
+    _node_used = NEW_C_HEAP_ARRAY(size_t, numa->num_active_nodes(), mtGC);
+  }
 
   _overall_reserved = g1h->max_capacity();
   recalculate_sizes();
@@ -229,6 +236,46 @@ void G1MonitoringSupport::recalculate_sizes() {
   // should hold.
   assert(_survivor_used <= _survivor_committed, "post-condition");
   assert(_old_used <= _old_committed, "post-condition");
+
+  recalculate_node_sizes();
+}
+
+class G1NodeSizesClosure : public HeapRegionClosure {
+  size_t* _committed;
+  size_t* _used;
+
+public:
+  G1NodeSizesClosure(size_t* committed, size_t* used) :
+    _committed(committed), _used(used) { }
+
+  bool doHeapRegion(HeapRegion* hr) {
+    _committed[hr->node_index()] += HeapRegion::GrainBytes;
+    _used[hr->node_index()] += hr->used();
+    return false;
+  }
+};
+
+void G1MonitoringSupport::recalculate_node_sizes() {
+  if (_node_committed == NULL) {
+    return;
+  }
+  uint num_nodes = g1h()->numa()->num_active_nodes();
+  for (uint i = 0; i < num_nodes; i++) {
+    _node_committed[i] = 0;
+    _node_used[i] = 0;
+  }
+  G1NodeSizesClosure cl(_node_committed, _node_used);
+  g1h()->heap_region_iterate(&cl);
+}
+
+size_t G1MonitoringSupport::node_committed(uint node_index) {
+  assert(_node_committed != NULL, "only available with NUMA");
+  return _node_committed[node_index];
+}
+
+size_t G1MonitoringSupport::node_used(uint node_index) {
+  assert(_node_used != NULL, "only available with NUMA");
+  return _node_used[node_index];
 }
 
 void G1MonitoringSupport::recalculate_eden_size() {
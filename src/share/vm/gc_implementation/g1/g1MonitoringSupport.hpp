@@ -157,8 +157,16 @@ class G1MonitoringSupport : public CHeapObj<mtGC> {
   size_t _old_committed;
   size_t _old_used;
 
+  // The committed and used bytes of the regions preferring each NUMA
+  // node, only maintained if G1NUMA is enabled.
+  size_t* _node_committed;
+  size_t* _node_used;
+
   G1CollectedHeap* g1h() { return _g1h; }
 
+  // Recalculate the per node sizes.
+  void recalculate_node_sizes();
+
   // It returns x - y if x > y, 0 otherwise.
   // As described in the comment above, some of the inputs to the
   // calculations we have to do are obtained concurrently and hence
@@ -241,6 +249,9 @@ class G1MonitoringSupport : public CHeapObj<mtGC> {
   size_t old_gen_max()                { return overall_reserved();    }
   size_t old_space_committed()        { return _old_committed;        }
   size_t old_space_used()             { return _old_used;             }
+
+  size_t node_committed(uint node_index);
+  size_t node_used(uint node_index);
 };
 
 class G1GenerationCounters: public GenerationCounters {
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+
+// G1NUMA maps the NUMA nodes of the machine to a dense range of node
+// indexes [0, num_active_nodes()) which the rest of G1 uses to keep
+// per-node data, e.g. the mutator alloc regions of G1Allocator.
+//
+// Every heap region has a preferred node that is derived from its index,
+// and the memory of a region is bound to that node when it is committed.
+// Without UseNUMA, or on a single node machine, there is a single node
+// index 0 and no memory is bound.
+class G1NUMA: public CHeapObj<mtGC> {
+  // The node id of the node with the given index.
+  int*  _node_ids;
+  uint  _num_active_node_ids;
+
+  // Maps a node id to its index, UnknownNodeIndex if the node id is
+  // not active.
+  uint* _node_id_to_index_map;
+  int   _len_node_id_to_index_map;
+
+  // The region size and the page size of the heap. If a page spans
+  // several regions, all of those regions prefer the same node.
+  size_t _region_size;
+  size_t _page_size;
+
+  static G1NUMA* _inst;
+
+  G1NUMA();
+  void initialize(bool use_numa);
+  void initialize_without_numa();
+
+  size_t region_size() const { return _region_size; }
+  size_t page_size() const   { return _page_size; }
+
+ public:
+  static const uint UnknownNodeIndex = UINT_MAX;
+  static const uint AnyNodeIndex = UnknownNodeIndex - 1;
+
+  static G1NUMA* numa() { return _inst; }
+  static G1NUMA* create();
+
+  ~G1NUMA();
+
+  // Set the heap region size and the page size of the heap. Must be
+  // called before the first region is committed.
+  void set_region_info(size_t region_size, size_t page_size);
+
+  // Whether heap regions are bound to and allocated per node.
+  bool is_enabled() const { return num_active_nodes() > 1; }
+
+  uint num_active_nodes() const { return _num_active_node_ids; }
+
+  bool is_valid_node_index(uint node_index) const {
+    return node_index < num_active_nodes();
+  }
+
+  // The node id of the node with the given index.
+  int numa_id(uint node_index) const;
+
+  // The index of the node with the given id, UnknownNodeIndex if the
+  // node is not active.
+  uint index_of_node_id(int node_id) const;
+
+  // The index of the node the current thread is running on.
+  uint index_of_current_thread() const;
+
+  // The index of the node the memory of the region with the given
+  // index is bound to.
+  uint preferred_node_index_for_index(uint region_index) const;
+
+  // Bind the memory of the region with the given index, starting at
+  // aligned_address, to the preferred node of that region.
+  void request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index);
+
+  // The number of free regions to look at when searching the free list
+  // for a region on a given node.
+  uint max_search_depth() const;
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
@@ -36,6 +36,7 @@ class DirtyCardToOopClosure;
 class CMBitMap;
 class CMMarkStack;
 class G1ParScanThreadState;
+class G1ParMarkSweepThreadState;
 class CMTask;
 class ReferenceProcessor;
 
@@ -195,6 +196,20 @@ public:
   virtual void do_oop(narrowOop* p) { do_oop_nv(p); }
 };
 
+// Closure used by the parallel full GC to mark and push the objects
+// referenced from the roots and from already marked objects.
+class G1ParMarkSweepMarkClosure : public MetadataAwareOopClosure {
+private:
+  G1ParMarkSweepThreadState* _pms_state;
+public:
+  G1ParMarkSweepMarkClosure(G1ParMarkSweepThreadState* pms_state,
+                            ReferenceProcessor* rp) :
+    MetadataAwareOopClosure(rp), _pms_state(pms_state) { }
+  template <class T> void do_oop_nv(T* p);
+  virtual void do_oop(      oop* p) { do_oop_nv(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_nv(p); }
+};
+
 // Closure that applies the given two closures in sequence.
 // Used by the RSet refinement code (when updating RSets
 // during an evacuation pause) to record cards containing
@@ -28,6 +28,7 @@
 #include "gc_implementation/g1/concurrentMark.inline.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.hpp"
 #include "gc_implementation/g1/g1OopClosures.hpp"
+#include "gc_implementation/g1/g1ParMarkSweep.inline.hpp"
 #include "gc_implementation/g1/g1ParScanThreadState.inline.hpp"
 #include "gc_implementation/g1/g1RemSet.hpp"
 #include "gc_implementation/g1/g1RemSet.inline.hpp"
@@ -134,6 +135,11 @@ inline void G1RootRegionScanClosure::do_oop_nv(T* p) {
   }
 }
 
+template <class T>
+inline void G1ParMarkSweepMarkClosure::do_oop_nv(T* p) {
+  _pms_state->mark_and_push(p);
+}
+
 template <class T>
 inline void G1Mux2Closure::do_oop_nv(T* p) {
   // Apply first closure; then apply the second.
@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "code/codeCache.hpp"
+#include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1MarkSweep.hpp"
+#include "gc_implementation/g1/g1OopClosures.inline.hpp"
+#include "gc_implementation/g1/g1ParMarkSweep.inline.hpp"
+#include "gc_implementation/g1/g1RootProcessor.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
+#include "gc_implementation/g1/heapRegion.inline.hpp"
+#include "gc_implementation/shared/gcTimer.hpp"
+#include "gc_implementation/shared/gcTrace.hpp"
+#include "memory/genMarkSweep.hpp"
+#include "memory/referenceProcessor.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/jniHandles.hpp"
+#include "utilities/stack.inline.hpp"
+#include "utilities/workgroup.hpp"
+
+G1ParMarkSweepThreadState::G1ParMarkSweepThreadState(uint worker_id,
+                                                     ReferenceProcessor* rp) :
+  _worker_id(worker_id),
+  _mark_closure(this, rp),
+  _mark_cld_closure(&_mark_closure),
+  _compaction_regions(new (ResourceObj::C_HEAP, mtGC) GrowableArray<HeapRegion*>(16, true, mtGC)) {
+  _marking_stack.initialize();
+  _objarray_stack.initialize();
+}
+
+G1ParMarkSweepThreadState::~G1ParMarkSweepThreadState() {
+  delete _compaction_regions;
+}
+
+void G1ParMarkSweepThreadState::preserve_mark(oop obj, markOop mark) {
+  _preserved_oop_stack.push(obj);
+  _preserved_mark_stack.push(mark);
+}
+
+void G1ParMarkSweepThreadState::drain_stacks() {
+  do {
+    // Drain the overflow stack first, to allow stealing from the marking stack.
+    oop obj;
+    while (_marking_stack.pop_overflow(obj)) {
+      follow_object(obj);
+    }
+    while (_marking_stack.pop_local(obj)) {
+      follow_object(obj);
+    }
+
+    // Process ObjArrays one at a time to avoid marking stack bloat.
+    ObjArrayTask task;
+    if (_objarray_stack.pop_overflow(task) || _objarray_stack.pop_local(task)) {
+      follow_array(objArrayOop(task.obj()), task.index());
+    }
+  } while (!marking_stacks_empty());
+}
+
+void G1ParMarkSweepThreadState::complete_marking(G1PMSMarkQueueSet* mark_queues,
+                                                 G1PMSObjArrayQueueSet* objarray_queues,
+                                                 ParallelTaskTerminator* terminator) {
+  int random_seed = 17;
+  oop obj;
+  ObjArrayTask task;
+  do {
+    drain_stacks();
+    while (objarray_queues->steal(_worker_id, &random_seed, task)) {
+      follow_array(objArrayOop(task.obj()), task.index());
+      drain_stacks();
+    }
+    while (mark_queues->steal(_worker_id, &random_seed, obj)) {
+      follow_object(obj);
+      drain_stacks();
+    }
+  } while (!terminator->offer_termination());
+
+  assert(marking_stacks_empty(), "Marking should have completed");
+}
+
+void G1ParMarkSweepThreadState::adjust_marks() {
+  assert(_preserved_oop_stack.size() == _preserved_mark_stack.size(),
+         "inconsistent preserved oop stacks");
+
+  StackIterator<oop, mtGC> iter(_preserved_oop_stack);
+  while (!iter.is_empty()) {
+    oop* p = iter.next_addr();
+    MarkSweep::adjust_pointer(p);
+  }
+}
+
+void G1ParMarkSweepThreadState::restore_marks() {
+  assert(_preserved_oop_stack.size() == _preserved_mark_stack.size(),
+         "inconsistent preserved oop stacks");
+
+  while (!_preserved_oop_stack.is_empty()) {
+    oop obj       = _preserved_oop_stack.pop();
+    markOop mark  = _preserved_mark_stack.pop();
+    obj->set_mark(mark);
+  }
+}
+
+G1ParMarkSweep::G1ParMarkSweep(G1CollectedHeap* g1h, uint max_workers) :
+  _g1h(g1h),
+  _max_workers(max_workers),
+  _n_workers(max_workers),
+  _mark_queues(max_workers),
+  _objarray_queues(max_workers) {
+  assert(max_workers > 0, "must have at least one worker");
+
+  _states = NEW_C_HEAP_ARRAY(G1ParMarkSweepThreadState*, max_workers, mtGC);
+  for (uint i = 0; i < max_workers; i++) {
+    _states[i] = new G1ParMarkSweepThreadState(i, g1h->ref_processor_stw());
+    _mark_queues.register_queue(i, &_states[i]->_marking_stack);
+    _objarray_queues.register_queue(i, &_states[i]->_objarray_stack);
+  }
+}
+
+void G1ParMarkSweep::set_n_workers(uint n_workers) {
+  assert(n_workers > 0 && n_workers <= _max_workers,
+         err_msg("invalid number of workers: %u", n_workers));
+  _n_workers = n_workers;
+}
+
+// Phase 1: marking.
+
+class G1ParMarkSweepMarkTask : public AbstractGangTask {
+  G1ParMarkSweep*         _pms;
+  G1RootProcessor*        _root_processor;
+  ParallelTaskTerminator* _terminator;
+
+ public:
+  G1ParMarkSweepMarkTask(G1ParMarkSweep* pms,
+                         G1RootProcessor* root_processor,
+                         ParallelTaskTerminator* terminator) :
+    AbstractGangTask("G1 Parallel Full GC Marking"),
+    _pms(pms),
+    _root_processor(root_processor),
+    _terminator(terminator) { }
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    HandleMark   hm;
+
+    G1ParMarkSweepThreadState* pms_state = _pms->state(worker_id);
+    MarkingCodeBlobClosure follow_code_closure(pms_state->mark_closure(),
+                                               !CodeBlobToOopClosure::FixRelocations);
+    if (ClassUnloading) {
+      _root_processor->process_strong_roots(pms_state->mark_closure(),
+                                            pms_state->mark_cld_closure(),
+                                            &follow_code_closure);
+    } else {
+      _root_processor->process_all_roots_no_string_table(
+                                            pms_state->mark_closure(),
+                                            pms_state->mark_cld_closure(),
+                                            &follow_code_closure);
+    }
+
+    pms_state->complete_marking(_pms->mark_queues(),
+                                _pms->objarray_queues(),
+                                _terminator);
+  }
+};
+
+// Drains the marking stacks of a single thread. Used as the complete_gc
+// closure of reference processing when it runs on the VM thread.
+class G1ParMarkSweepDrainClosure : public VoidClosure {
+  G1ParMarkSweepThreadState* _pms_state;
+ public:
+  G1ParMarkSweepDrainClosure(G1ParMarkSweepThreadState* pms_state) :
+    _pms_state(pms_state) { }
+
+  void do_void() {
+    _pms_state->drain_stacks();
+  }
+};
+
+// Completes the marking in parallel, stealing from the other workers.
+// Used as the complete_gc closure of multi-threaded reference processing.
+class G1ParMarkSweepCompleteMarkingClosure : public VoidClosure {
+  G1ParMarkSweep*            _pms;
+  G1ParMarkSweepThreadState* _pms_state;
+  ParallelTaskTerminator*    _terminator;
+ public:
+  G1ParMarkSweepCompleteMarkingClosure(G1ParMarkSweep* pms,
+                                       G1ParMarkSweepThreadState* pms_state,
+                                       ParallelTaskTerminator* terminator) :
+    _pms(pms), _pms_state(pms_state), _terminator(terminator) { }
+
+  void do_void() {
+    _pms_state->complete_marking(_pms->mark_queues(),
+                                 _pms->objarray_queues(),
+                                 _terminator);
+  }
+};
+
+class G1ParMarkSweepRefProcTaskExecutor : public AbstractRefProcTaskExecutor {
+  G1ParMarkSweep* _pms;
+  G1CollectedHeap* _g1h;
+
+ public:
+  G1ParMarkSweepRefProcTaskExecutor(G1ParMarkSweep* pms, G1CollectedHeap* g1h) :
+    _pms(pms), _g1h(g1h) { }
+
+  // Executes the given task using the G1 work gang.
+  virtual void execute(ProcessTask& task);
+  virtual void execute(EnqueueTask& task);
+};
+
+class G1ParMarkSweepRefProcTaskProxy : public AbstractGangTask {
+  typedef AbstractRefProcTaskExecutor::ProcessTask ProcessTask;
+  ProcessTask&            _proc_task;
+  G1ParMarkSweep*         _pms;
+  ParallelTaskTerminator* _terminator;
+
+ public:
+  G1ParMarkSweepRefProcTaskProxy(ProcessTask& proc_task,
+                                 G1ParMarkSweep* pms,
+                                 ParallelTaskTerminator* terminator) :
+    AbstractGangTask("G1 Parallel Full GC Process reference objects"),
+    _proc_task(proc_task),
+    _pms(pms),
+    _terminator(terminator) { }
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    HandleMark   hm;
+
+    G1ParMarkSweepThreadState* pms_state = _pms->state(worker_id);
+    G1ParMarkSweepCompleteMarkingClosure complete_gc(_pms, pms_state, _terminator);
+    _proc_task.work(worker_id, GenMarkSweep::is_alive, *pms_state->mark_closure(), complete_gc);
+  }
+};
+
+class G1ParMarkSweepRefEnqueueTaskProxy : public AbstractGangTask {
+  typedef AbstractRefProcTaskExecutor::EnqueueTask EnqueueTask;
+  EnqueueTask& _enq_task;
+
+ public:
+  G1ParMarkSweepRefEnqueueTaskProxy(EnqueueTask& enq_task) :
+    AbstractGangTask("G1 Parallel Full GC Enqueue reference objects"),
+    _enq_task(enq_task) { }
+
+  void work(uint worker_id) {
+    _enq_task.work(worker_id);
+  }
+};
+
+void G1ParMarkSweepRefProcTaskExecutor::execute(ProcessTask& proc_task) {
+  uint n_workers = _pms->n_workers();
+  ParallelTaskTerminator terminator((int)n_workers, _pms->mark_queues());
+  G1ParMarkSweepRefProcTaskProxy proc_task_proxy(proc_task, _pms, &terminator);
+
+  _g1h->set_par_threads(n_workers);
+  _g1h->workers()->run_task(&proc_task_proxy);
+  _g1h->set_par_threads(0);
+}
+
+void G1ParMarkSweepRefProcTaskExecutor::execute(EnqueueTask& enq_task) {
+  G1ParMarkSweepRefEnqueueTaskProxy enq_task_proxy(enq_task);
+
+  _g1h->set_par_threads(_pms->n_workers());
+  _g1h->workers()->run_task(&enq_task_proxy);
+  _g1h->set_par_threads(0);
+}
+
+void G1ParMarkSweep::mark_live_objects(ReferenceProcessor* rp,
+                                       bool clear_all_softrefs) {
+  // Reference discovery is multi-threaded during the parallel full gc.
+  assert(rp->discovery_is_mt(), "Sanity");
+
+  _g1h->set_par_threads(_n_workers);
+  {
+    G1RootProcessor root_processor(_g1h);
+    root_processor.set_num_workers(_n_workers);
+    ParallelTaskTerminator terminator((int)_n_workers, &_mark_queues);
+    G1ParMarkSweepMarkTask mark_task(this, &root_processor, &terminator);
+    _g1h->workers()->run_task(&mark_task);
+  }
+  _g1h->set_par_threads(0);
+
+  process_references(rp, clear_all_softrefs);
+}
+
+void G1ParMarkSweep::process_references(ReferenceProcessor* rp,
+                                        bool clear_all_softrefs) {
+  // The serial parts of reference processing run on the VM thread,
+  // using the state of worker 0.
+  G1ParMarkSweepThreadState* serial_state = state(0);
+  G1ParMarkSweepDrainClosure drain_serial(serial_state);
+
+  G1ParMarkSweepRefProcTaskExecutor par_task_executor(this, _g1h);
+  AbstractRefProcTaskExecutor* task_executor = NULL;
+  if (rp->processing_is_mt()) {
+    rp->set_active_mt_degree(_n_workers);
+    task_executor = &par_task_executor;
+  }
+
+  rp->setup_policy(clear_all_softrefs);
+  const ReferenceProcessorStats& stats =
+    rp->process_discovered_references(&GenMarkSweep::is_alive,
+                                      serial_state->mark_closure(),
+                                      &drain_serial,
+                                      task_executor,
+                                      G1MarkSweep::gc_timer(),
+                                      G1MarkSweep::gc_tracer()->gc_id());
+  G1MarkSweep::gc_tracer()->report_gc_reference_stats(stats);
+
+#ifdef ASSERT
+  for (uint i = 0; i < _n_workers; i++) {
+    assert(state(i)->marking_stacks_empty(), "Marking should have completed");
+  }
+#endif
+}
+
+// Phase 2: computing the new addresses.
+
+class G1ParPrepareCompactClosure : public G1PrepareCompactClosure {
+  G1ParMarkSweepThreadState* _pms_state;
+  HeapRegion* _last_compaction_region;
+
+ protected:
+  virtual void prepare_for_compaction(HeapRegion* hr, HeapWord* end) {
+    // Chain the regions of this worker in claim order so that
+    // CompactibleSpace::forward() only moves objects into regions
+    // this worker compacts itself.
+    if (_last_compaction_region != NULL) {
+      _last_compaction_region->set_next_compaction_space(hr);
+    }
+    _last_compaction_region = hr;
+    _pms_state->compaction_regions()->append(hr);
+
+    G1PrepareCompactClosure::prepare_for_compaction(hr, end);
+  }
+
+ public:
+  G1ParPrepareCompactClosure(G1ParMarkSweepThreadState* pms_state) :
+    G1PrepareCompactClosure(true /* par */),
+    _pms_state(pms_state),
+    _last_compaction_region(NULL) { }
+
+  bool doHeapRegion(HeapRegion* hr) {
+    if (hr->is_archive()) {
+      G1PrepareCompactClosure::doHeapRegion(hr);
+      // Archive objects stay in place, but the marked ones still need
+      // to be reset in phase 4.
+      _pms_state->compaction_regions()->append(hr);
+      return false;
+    }
+    if (!hr->startsHumongous()) {
+      return G1PrepareCompactClosure::doHeapRegion(hr);
+    }
+
+    if (oop(hr->bottom())->is_gc_marked()) {
+      G1PrepareCompactClosure::doHeapRegion(hr);
+      // Live humongous objects stay in place, but the start region
+      // still needs to be reset in phase 4.
+      _pms_state->compaction_regions()->append(hr);
+    } else {
+      // The "continues humongous" regions were claimed together with
+      // the start region and become ordinary free regions once the
+      // object is freed, so prepare them here as well, in the same
+      // order as the serial heap walk would.
+      uint first_index = hr->hrm_index() + 1;
+      uint last_index = hr->last_hc_index();
+      G1PrepareCompactClosure::doHeapRegion(hr);
+      for (uint i = first_index; i < last_index; i++) {
+        HeapRegion* chr = _g1h->region_at(i);
+        assert(!chr->isHumongous(), "should have been freed");
+        prepare_for_compaction(chr, chr->end());
+      }
+    }
+    return false;
+  }
+};
+
+class G1ParMarkSweepPrepareCompactTask : public AbstractGangTask {
+  G1ParMarkSweep*  _pms;
+  G1CollectedHeap* _g1h;
+
+ public:
+  G1ParMarkSweepPrepareCompactTask(G1ParMarkSweep* pms, G1CollectedHeap* g1h) :
+    AbstractGangTask("G1 Parallel Full GC Prepare Compaction"),
+    _pms(pms),
+    _g1h(g1h) { }
+
+  void work(uint worker_id) {
+    G1ParMarkSweepThreadState* pms_state = _pms->state(worker_id);
+    assert(pms_state->compaction_regions()->is_empty(), "Sanity");
+
+    G1ParPrepareCompactClosure blk(pms_state);
+    _g1h->heap_region_par_iterate_chunked(&blk, worker_id,
+                                          _pms->n_workers(),
+                                          HeapRegion::ParPrepareCompactClaimValue);
+    blk.update_sets();
+  }
+};
+
+void G1ParMarkSweep::prepare_compaction() {
+  assert(_g1h->check_heap_region_claim_values(HeapRegion::InitialClaimValue),
+         "sanity check");
+
+  G1ParMarkSweepPrepareCompactTask prepare_task(this, _g1h);
+  _g1h->set_par_threads(_n_workers);
+  _g1h->workers()->run_task(&prepare_task);
+  _g1h->set_par_threads(0);
+
+  assert(_g1h->check_heap_region_claim_values(HeapRegion::ParPrepareCompactClaimValue),
+         "sanity check");
+}
+
+// Phase 3: adjusting the pointers.
+
+class G1ParMarkSweepAdjustPointersTask : public AbstractGangTask {
+  G1ParMarkSweep*  _pms;
+  G1CollectedHeap* _g1h;
+  G1RootProcessor* _root_processor;
+
+ public:
+  G1ParMarkSweepAdjustPointersTask(G1ParMarkSweep* pms,
+                                   G1CollectedHeap* g1h,
+                                   G1RootProcessor* root_processor) :
+    AbstractGangTask("G1 Parallel Full GC Adjust Pointers"),
+    _pms(pms),
+    _g1h(g1h),
+    _root_processor(root_processor) { }
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    HandleMark   hm;
+
+    CodeBlobToOopClosure adjust_code_closure(&GenMarkSweep::adjust_pointer_closure,
+                                             CodeBlobToOopClosure::FixRelocations);
+    _root_processor->process_all_roots(&GenMarkSweep::adjust_pointer_closure,
+                                       &GenMarkSweep::adjust_cld_closure,
+                                       &adjust_code_closure);
+
+    _pms->state(worker_id)->adjust_marks();
+
+    G1AdjustPointersClosure blk;
+    _g1h->heap_region_par_iterate_chunked(&blk, worker_id,
+                                          _pms->n_workers(),
+                                          HeapRegion::ParAdjustPointersClaimValue);
+  }
+};
+
+void G1ParMarkSweep::adjust_pointers() {
+  _g1h->set_par_threads(_n_workers);
+  {
+    G1RootProcessor root_processor(_g1h);
+    root_processor.set_num_workers(_n_workers);
+    G1ParMarkSweepAdjustPointersTask adjust_task(this, _g1h, &root_processor);
+    _g1h->workers()->run_task(&adjust_task);
+  }
+  _g1h->set_par_threads(0);
+
+  assert(_g1h->check_heap_region_claim_values(HeapRegion::ParAdjustPointersClaimValue),
+         "sanity check");
+  _g1h->reset_heap_region_claim_values();
+
+  assert(GenMarkSweep::ref_processor() == _g1h->ref_processor_stw(), "Sanity");
+  _g1h->ref_processor_stw()->weak_oops_do(&GenMarkSweep::adjust_pointer_closure);
+
+  // Now adjust pointers in remaining weak roots.  (All of which should
+  // have been cleared if they pointed to non-surviving objects.)
+  JNIHandles::weak_oops_do(&GenMarkSweep::adjust_pointer_closure);
+
+  if (G1StringDedup::is_enabled()) {
+    G1StringDedup::oops_do(&GenMarkSweep::adjust_pointer_closure);
+  }
+
+  GenMarkSweep::adjust_marks();
+}
+
+// Phase 4: moving the objects.
+
+class G1ParMarkSweepCompactTask : public AbstractGangTask {
+  G1ParMarkSweep* _pms;
+
+ public:
+  G1ParMarkSweepCompactTask(G1ParMarkSweep* pms) :
+    AbstractGangTask("G1 Parallel Full GC Compaction"),
+    _pms(pms) { }
+
+  void work(uint worker_id) {
+    GrowableArray<HeapRegion*>* regions = _pms->state(worker_id)->compaction_regions();
+    G1SpaceCompactClosure blk;
+    for (int i = 0; i < regions->length(); i++) {
+      HeapRegion* hr = regions->at(i);
+      blk.doHeapRegion(hr);
+      // Back to compacting in heap order for the serial full gc.
+      hr->set_next_compaction_space(NULL);
+    }
+    regions->clear();
+  }
+};
+
+void G1ParMarkSweep::compact() {
+  G1ParMarkSweepCompactTask compact_task(this);
+  _g1h->set_par_threads(_n_workers);
+  _g1h->workers()->run_task(&compact_task);
+  _g1h->set_par_threads(0);
+}
+
+void G1ParMarkSweep::restore_marks() {
+  for (uint i = 0; i < _n_workers; i++) {
+    state(i)->restore_marks();
+  }
+}
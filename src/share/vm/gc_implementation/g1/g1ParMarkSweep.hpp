@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1PARMARKSWEEP_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1PARMARKSWEEP_HPP
+
+#include "gc_implementation/g1/g1OopClosures.hpp"
+#include "memory/allocation.hpp"
+#include "memory/iterator.hpp"
+#include "oops/markOop.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/stack.hpp"
+#include "utilities/taskqueue.hpp"
+
+class G1CollectedHeap;
+class HeapRegion;
+class ReferenceProcessor;
+
+// G1ParMarkSweep is the parallel counterpart of the serial G1MarkSweep
+// phases. It runs the same four-phase pointer forwarding algorithm, but
+// splits each phase across the G1 work gang:
+//
+// - phase 1 marks the live objects using per-worker marking stacks with
+//   work stealing, and processes the discovered references;
+// - phase 2 claims regions in parallel. Every worker slides the live
+//   objects of the regions it claimed into a private chain of those same
+//   regions, so the compaction point never crosses into regions owned by
+//   another worker;
+// - phase 3 adjusts the roots and the region contents in parallel;
+// - phase 4 lets every worker compact its own chain of regions.
+//
+// Since the destination of every object is a region claimed by the same
+// worker, and earlier in that worker's chain, no synchronization between
+// the workers is needed during compaction.
+
+typedef OverflowTaskQueue<oop, mtGC>                 G1PMSMarkQueue;
+typedef GenericTaskQueueSet<G1PMSMarkQueue, mtGC>     G1PMSMarkQueueSet;
+
+typedef OverflowTaskQueue<ObjArrayTask, mtGC>        G1PMSObjArrayQueue;
+typedef GenericTaskQueueSet<G1PMSObjArrayQueue, mtGC> G1PMSObjArrayQueueSet;
+
+// Per-worker state of the parallel full GC.
+class G1ParMarkSweepThreadState : public CHeapObj<mtGC> {
+  friend class G1ParMarkSweep;
+
+  uint _worker_id;
+
+  // Marking stacks; the queues are registered with the task queue sets
+  // of the owning G1ParMarkSweep so that other workers can steal from them.
+  G1PMSMarkQueue     _marking_stack;
+  G1PMSObjArrayQueue _objarray_stack;
+
+  // Mark words that have to be restored after compaction.
+  Stack<oop, mtGC>     _preserved_oop_stack;
+  Stack<markOop, mtGC> _preserved_mark_stack;
+
+  G1ParMarkSweepMarkClosure _mark_closure;
+  CLDToOopClosure           _mark_cld_closure;
+
+  // The regions this worker compacts in phase 4, in the order they were
+  // claimed in phase 2.
+  GrowableArray<HeapRegion*>* _compaction_regions;
+
+  void preserve_mark(oop obj, markOop mark);
+
+  inline void push_objarray(oop obj, size_t index);
+  inline void follow_array(objArrayOop array, int index);
+  inline void follow_object(oop obj);
+
+ public:
+  G1ParMarkSweepThreadState(uint worker_id, ReferenceProcessor* rp);
+  ~G1ParMarkSweepThreadState();
+
+  uint worker_id() const { return _worker_id; }
+
+  G1ParMarkSweepMarkClosure* mark_closure()     { return &_mark_closure; }
+  CLDToOopClosure*           mark_cld_closure() { return &_mark_cld_closure; }
+
+  // Marks the object if it is not already marked, returning whether this
+  // thread did the marking.
+  inline bool par_mark_object(oop obj);
+
+  template <class T> inline void mark_and_push(T* p);
+
+  // Empties the local marking stacks.
+  void drain_stacks();
+
+  // Empties the local marking stacks and steals work from the other
+  // workers until all marking stacks are empty.
+  void complete_marking(G1PMSMarkQueueSet* mark_queues,
+                        G1PMSObjArrayQueueSet* objarray_queues,
+                        ParallelTaskTerminator* terminator);
+
+  bool marking_stacks_empty() const {
+    return _marking_stack.is_empty() && _objarray_stack.is_empty();
+  }
+
+  GrowableArray<HeapRegion*>* compaction_regions() { return _compaction_regions; }
+
+  void adjust_marks();
+  void restore_marks();
+};
+
+class G1ParMarkSweep : public CHeapObj<mtGC> {
+  G1CollectedHeap* _g1h;
+
+  // The number of thread states; the maximum number of workers.
+  uint _max_workers;
+  // The number of workers used by the current collection.
+  uint _n_workers;
+
+  G1ParMarkSweepThreadState** _states;
+  G1PMSMarkQueueSet           _mark_queues;
+  G1PMSObjArrayQueueSet       _objarray_queues;
+
+  void process_references(ReferenceProcessor* rp, bool clear_all_softrefs);
+
+ public:
+  G1ParMarkSweep(G1CollectedHeap* g1h, uint max_workers);
+
+  uint n_workers() const { return _n_workers; }
+  void set_n_workers(uint n_workers);
+
+  G1ParMarkSweepThreadState* state(uint worker_id) const {
+    assert(worker_id < _max_workers, "worker id out of bounds");
+    return _states[worker_id];
+  }
+
+  G1PMSMarkQueueSet*     mark_queues()     { return &_mark_queues; }
+  G1PMSObjArrayQueueSet* objarray_queues() { return &_objarray_queues; }
+
+  // Marks the live objects and processes the discovered references.
+  void mark_live_objects(ReferenceProcessor* rp, bool clear_all_softrefs);
+  // Calculates the new addresses of the live objects.
+  void prepare_compaction();
+  // Adjusts the pointers in the roots and in the heap.
+  void adjust_pointers();
+  // Moves the live objects to their new locations.
+  void compact();
+  // Restores the mark words preserved during marking.
+  void restore_marks();
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1PARMARKSWEEP_HPP
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1PARMARKSWEEP_INLINE_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1PARMARKSWEEP_INLINE_HPP
+
+#include "gc_implementation/g1/g1ParMarkSweep.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
+#include "oops/objArrayOop.hpp"
+#include "oops/oop.inline.hpp"
+#include "utilities/taskqueue.hpp"
+
+inline bool G1ParMarkSweepThreadState::par_mark_object(oop obj) {
+  markOop mark = obj->mark();
+  if (mark->is_marked()) {
+    return false;
+  }
+
+  if (G1StringDedup::is_enabled()) {
+    // We must enqueue the object before it is marked as we otherwise
+    // can't read the object's age. Two workers racing for the same
+    // string may both enqueue it, which the deduplication thread
+    // tolerates.
+    G1StringDedup::enqueue_from_mark(obj, _worker_id);
+  }
+
+  // Only the marking threads modify mark words at this point, so a
+  // failed CAS means that another worker marked the object.
+  markOop marked = markOopDesc::prototype()->set_marked();
+  if (obj->cas_set_mark(marked, mark) != mark) {
+    return false;
+  }
+
+  // some marks may contain information we need to preserve so we store them away
+  // and overwrite the mark.  We'll restore it at the end of the collection.
+  if (mark->must_be_preserved(obj)) {
+    preserve_mark(obj, mark);
+  }
+  return true;
+}
+
+template <class T>
+inline void G1ParMarkSweepThreadState::mark_and_push(T* p) {
+  T heap_oop = oopDesc::load_heap_oop(p);
+  if (!oopDesc::is_null(heap_oop)) {
+    oop obj = oopDesc::decode_heap_oop_not_null(heap_oop);
+    if (par_mark_object(obj)) {
+      _marking_stack.push(obj);
+    }
+  }
+}
+
+inline void G1ParMarkSweepThreadState::push_objarray(oop obj, size_t index) {
+  ObjArrayTask task(obj, index);
+  assert(task.is_valid(), "bad ObjArrayTask");
+  _objarray_stack.push(task);
+}
+
+inline void G1ParMarkSweepThreadState::follow_array(objArrayOop array, int index) {
+  const size_t len = size_t(array->length());
+  const size_t beg_index = size_t(index);
+  assert(beg_index < len || len == 0, "index too large");
+
+  const size_t stride = MIN2(len - beg_index, ObjArrayMarkingStride);
+  const size_t end_index = beg_index + stride;
+
+  // Push the continuation first so that other workers can steal it
+  // while we scan this chunk.
+  if (end_index < len) {
+    push_objarray(array, end_index);
+  }
+
+  array->oop_iterate_range(&_mark_closure, (int)beg_index, (int)end_index);
+}
+
+inline void G1ParMarkSweepThreadState::follow_object(oop obj) {
+  if (obj->is_objArray()) {
+    follow_array(objArrayOop(obj), 0);
+  } else {
+    obj->oop_iterate(&_mark_closure);
+  }
+}
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1PARMARKSWEEP_INLINE_HPP
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc_implementation/g1/g1BiasedArray.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1RegionToSpaceMapper.hpp"
 #include "memory/allocation.inline.hpp"
 #include "runtime/virtualspace.hpp"
@@ -38,7 +39,8 @@ G1RegionToSpaceMapper::G1RegionToSpaceMapper(ReservedSpace rs,
   _storage(rs, used_size, page_size),
   _region_granularity(region_granularity),
   _listener(NULL),
-  _commit_map() {
+  _commit_map(),
+  _memory_type(type) {
   guarantee(is_power_of_2(page_size), "must be");
   guarantee(is_power_of_2(region_granularity), "must be");
 
@@ -68,6 +70,10 @@ class G1RegionsLargerThanCommitSizeMapper : public G1RegionToSpaceMapper {
 
   virtual void commit_regions(uint start_idx, size_t num_regions) {
     bool zero_filled = _storage.commit((size_t)start_idx * _pages_per_region, num_regions * _pages_per_region);
+    for (uint i = start_idx; i < start_idx + num_regions; i++) {
+      char* address = (char*)reserved().start() + (size_t)i * _region_granularity;
+      numa_request_on_node(address, _region_granularity, i);
+    }
     _commit_map.set_range(start_idx, start_idx + num_regions);
     fire_on_commit(start_idx, num_regions, zero_filled);
   }
@@ -119,6 +125,9 @@ class G1RegionsSmallerThanCommitSizeMapper : public G1RegionToSpaceMapper {
       bool zero_filled = false;
       if (old_refcount == 0) {
         zero_filled = _storage.commit(idx, 1);
+        // All regions of the page prefer the same node.
+        size_t commit_size = _regions_per_page * _region_granularity;
+        numa_request_on_node((char*)reserved().start() + idx * commit_size, commit_size, i);
       }
       _refcounts.set_by_index(idx, old_refcount + 1);
       _commit_map.set_bit(i);
@@ -141,6 +150,12 @@ class G1RegionsSmallerThanCommitSizeMapper : public G1RegionToSpaceMapper {
   }
 };
 
+void G1RegionToSpaceMapper::numa_request_on_node(char* address, size_t size_in_bytes, uint region_idx) {
+  if (_memory_type == mtJavaHeap) {
+    G1NUMA::numa()->request_memory_on_node(address, size_in_bytes, region_idx);
+  }
+}
+
 void G1RegionToSpaceMapper::fire_on_commit(uint start_idx, size_t num_regions, bool zero_filled) {
   if (_listener != NULL) {
     _listener->on_commit(start_idx, num_regions, zero_filled);
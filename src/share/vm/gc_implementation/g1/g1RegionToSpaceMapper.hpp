@@ -51,9 +51,15 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
   // Mapping management
   BitMap _commit_map;
 
+  MemoryType _memory_type;
+
   G1RegionToSpaceMapper(ReservedSpace rs, size_t used_size, size_t page_size, size_t region_granularity, MemoryType type);
 
   void fire_on_commit(uint start_idx, size_t num_regions, bool zero_filled);
+
+  // Binds freshly committed Java heap memory to the preferred NUMA node
+  // of the region with the given index, before it is first touched.
+  void numa_request_on_node(char* address, size_t size_in_bytes, uint region_idx);
  public:
   MemRegion reserved() { return _storage.reserved(); }
 
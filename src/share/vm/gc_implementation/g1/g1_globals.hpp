@@ -289,6 +289,22 @@
           "An upper bound for the number of old CSet regions expressed "    \
           "as a percentage of the heap size.")                              \
                                                                             \
+  product(bool, G1ParallelFullGC, false,                                    \
+          "Use the G1 parallel GC worker threads for full collections")     \
+                                                                            \
+  product(uintx, G1PeriodicGCInterval, 0,                                   \
+          "Number of milliseconds after the last collection after "         \
+          "which a concurrent cycle is started to give unused memory "      \
+          "back to the operating system. 0 turns this off.")                \
+                                                                            \
+  product(bool, G1PeriodicGCInvokesConcurrent, true,                        \
+          "Whether a periodic collection is a concurrent cycle instead "    \
+          "of a full collection")                                           \
+                                                                            \
+  product(uintx, G1PeriodicGCSystemLoadThreshold, 0,                        \
+          "Do not start a periodic collection while the one minute "        \
+          "system load average is above this value. 0 turns this off.")     \
+                                                                            \
   experimental(ccstr, G1LogLevel, NULL,                                     \
           "Log level for G1 logging: fine, finer, finest")                  \
                                                                             \
@@ -54,6 +54,7 @@ class FilterIntoCSClosure;
 class FilterOutOfRegionClosure;
 class G1CMOopClosure;
 class G1RootRegionScanClosure;
+class G1ParMarkSweepMarkClosure;
 
 // Specialized oop closures from g1RemSet.cpp
 class G1Mux2Closure;
@@ -72,6 +73,7 @@ class G1UpdateRSOrPushRefOopClosure;
       f(FilterOutOfRegionClosure,_nv)                   \
       f(G1CMOopClosure,_nv)                             \
       f(G1RootRegionScanClosure,_nv)                    \
+      f(G1ParMarkSweepMarkClosure,_nv)                  \
       f(G1Mux2Closure,_nv)                              \
       f(G1TriggerClosure,_nv)                           \
       f(G1InvokeIfNotTriggeredClosure,_nv)              \
@@ -26,6 +26,7 @@
 #include "code/nmethod.hpp"
 #include "gc_implementation/g1/g1BlockOffsetTable.inline.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1OopClosures.inline.hpp"
 #include "gc_implementation/g1/heapRegion.inline.hpp"
 #include "gc_implementation/g1/heapRegionBounds.inline.hpp"
@@ -271,6 +272,7 @@ HeapRegion::HeapRegion(uint hrm_index,
                        MemRegion mr) :
     G1OffsetTableContigSpace(sharedOffsetArray, mr),
     _hrm_index(hrm_index),
+    _node_index(G1NUMA::numa()->preferred_node_index_for_index(hrm_index)),
     _allocation_context(AllocationContext::system()),
     _humongous_start_region(NULL),
     _in_collection_set(false),
@@ -304,6 +306,12 @@ void HeapRegion::initialize(MemRegion mr, bool clear_space, bool mangle_space) {
 }
 
 CompactibleSpace* HeapRegion::next_compaction_space() const {
+  // The parallel full GC chains the regions each worker compacts into;
+  // otherwise the regions are compacted in heap order.
+  CompactibleSpace* next = CompactibleSpace::next_compaction_space();
+  if (next != NULL) {
+    return next;
+  }
   return G1CollectedHeap::heap()->next_compaction_region(this);
 }
 
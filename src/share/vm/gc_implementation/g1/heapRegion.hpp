@@ -215,6 +215,9 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // The index of this region in the heap region sequence.
   uint  _hrm_index;
 
+  // The index of the NUMA node the memory of this region is bound to.
+  uint  _node_index;
+
   AllocationContext_t _allocation_context;
 
   HeapRegionType _type;
@@ -332,16 +335,19 @@ class HeapRegion: public G1OffsetTableContigSpace {
   static void setup_heap_region_size(size_t initial_heap_size, size_t max_heap_size);
 
   enum ClaimValues {
-    InitialClaimValue          = 0,
-    FinalCountClaimValue       = 1,
-    NoteEndClaimValue          = 2,
-    ScrubRemSetClaimValue      = 3,
-    ParVerifyClaimValue        = 4,
-    RebuildRSClaimValue        = 5,
-    ParEvacFailureClaimValue   = 6,
-    AggregateCountClaimValue   = 7,
-    VerifyCountClaimValue      = 8,
-    ParMarkRootClaimValue      = 9
+    InitialClaimValue           = 0,
+    FinalCountClaimValue        = 1,
+    NoteEndClaimValue           = 2,
+    ScrubRemSetClaimValue       = 3,
+    ParVerifyClaimValue         = 4,
+    RebuildRSClaimValue         = 5,
+    ParEvacFailureClaimValue    = 6,
+    AggregateCountClaimValue    = 7,
+    VerifyCountClaimValue       = 8,
+    ParMarkRootClaimValue       = 9,
+    ParPrepareCompactClaimValue = 10,
+    ParAdjustPointersClaimValue = 11,
+    HeapDumpClaimValue          = 12
   };
 
   // All allocated blocks are occupied by objects in a HeapRegion
@@ -358,6 +364,9 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // sequence, otherwise -1.
   uint hrm_index() const { return _hrm_index; }
 
+  // The index of the NUMA node this region is bound to, see G1NUMA.
+  uint node_index() const { return _node_index; }
+
   // The number of bytes marked live in the region in the last marking phase.
   size_t marked_bytes()    { return _prev_marked_bytes; }
   size_t live_bytes() {
@@ -418,6 +427,8 @@ class HeapRegion: public G1OffsetTableContigSpace {
 
   bool is_old() const { return _type.is_old(); }
 
+  bool is_archive() const { return _type.is_archive(); }
+
   // For a humongous region, region in which it starts.
   HeapRegion* humongous_start_region() const {
     return _humongous_start_region;
@@ -675,6 +686,8 @@ class HeapRegion: public G1OffsetTableContigSpace {
 
   void set_old() { _type.set_old(); }
 
+  void set_archive() { _type.set_archive(); }
+
   // Determine if an object has been allocated since the last
   // mark performed by the collector. This returns true iff the object
   // is within the unmarked area of the region.
@@ -139,7 +139,9 @@ inline HeapWord* HeapRegion::allocate_no_bot_updates(size_t word_size) {
 
 inline void HeapRegion::note_start_of_marking() {
   _next_marked_bytes = 0;
-  _next_top_at_mark_start = top();
+  // The objects of an archive region are always live. Keeping NTAMS at
+  // the bottom makes marking treat them as allocated during marking.
+  _next_top_at_mark_start = is_archive() ? bottom() : top();
 }
 
 inline void HeapRegion::note_end_of_marking() {
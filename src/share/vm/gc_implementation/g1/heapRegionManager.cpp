@@ -190,6 +190,24 @@ uint HeapRegionManager::expand_at(uint start, uint num_regions) {
   return expanded;
 }
 
+bool HeapRegionManager::allocate_regions_at(uint start, uint num_regions) {
+  uint end = start + num_regions;
+  assert(end <= max_length(), "regions out of range");
+  for (uint i = start; i < end; i++) {
+    if (is_available(i) && !at(i)->is_free()) {
+      return false;
+    }
+  }
+  for (uint i = start; i < end; i++) {
+    if (!is_available(i)) {
+      make_regions_available(i);
+    }
+  }
+  verify_optional();
+  allocate_free_regions_starting_at(start, num_regions);
+  return true;
+}
+
 uint HeapRegionManager::find_contiguous(size_t num, bool empty_only) {
   uint found = 0;
   size_t length_found = 0;
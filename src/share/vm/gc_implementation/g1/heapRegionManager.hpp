@@ -26,6 +26,7 @@
 #define SHARE_VM_GC_IMPLEMENTATION_G1_HEAPREGIONMANAGER_HPP
 
 #include "gc_implementation/g1/g1BiasedArray.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1RegionToSpaceMapper.hpp"
 #include "gc_implementation/g1/heapRegionSet.hpp"
 #include "services/memoryUsage.hpp"
@@ -163,8 +164,17 @@ public:
     _free_list.add_ordered(list);
   }
 
-  HeapRegion* allocate_free_region(bool is_old) {
-    HeapRegion* hr = _free_list.remove_region(is_old);
+  // Allocate a free region, preferably one bound to the given NUMA
+  // node.
+  HeapRegion* allocate_free_region(bool is_old, uint requested_node_index) {
+    HeapRegion* hr = NULL;
+    G1NUMA* numa = G1NUMA::numa();
+    if (numa->is_enabled() && numa->is_valid_node_index(requested_node_index)) {
+      hr = _free_list.remove_region_with_node_index(is_old, requested_node_index);
+    }
+    if (hr == NULL) {
+      hr = _free_list.remove_region(is_old);
+    }
 
     if (hr != NULL) {
       assert(hr->next() == NULL, "Single region should not have next");
@@ -213,6 +223,11 @@ public:
   // this.
   uint expand_at(uint start, uint num_regions);
 
+  // Makes sure that the regions from start to start+num_regions-1 are
+  // committed and removes them from the free list. Returns false, without
+  // changing anything, if any of these regions is already in use.
+  bool allocate_regions_at(uint start, uint num_regions);
+
   // Find a contiguous set of empty regions of length num. Returns the start index of
   // that set, or G1_NO_HRM_INDEX.
   uint find_contiguous_only_empty(size_t num) { return find_contiguous(num, true); }
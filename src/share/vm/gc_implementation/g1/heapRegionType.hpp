@@ -53,6 +53,8 @@ private:
   // 0010 1 [ 5] Humongous Continues
   //
   // 01000 [ 8] Old
+  //
+  // 10000 [16] Archive
   typedef enum {
     FreeTag       = 0,
 
@@ -64,7 +66,9 @@ private:
     HumStartsTag  = HumMask,
     HumContTag    = HumMask + 1,
 
-    OldTag        = 8
+    OldTag        = 8,
+
+    ArchiveTag    = 16
   } Tag;
 
   volatile Tag _tag;
@@ -110,6 +114,10 @@ public:
 
   bool is_old() const { return get() == OldTag; }
 
+  // Archive regions hold the objects mapped from the CDS archive. They
+  // are never collected, and the objects in them never move.
+  bool is_archive() const { return get() == ArchiveTag; }
+
   // Setters
 
   void set_free() { set(FreeTag); }
@@ -123,6 +131,8 @@ public:
 
   void set_old() { set(OldTag); }
 
+  void set_archive() { set_from(ArchiveTag, FreeTag); }
+
   // Misc
 
   const char* get_str() const;
@@ -551,8 +551,9 @@ void ParEvacuateFollowersClosure::do_void() {
 
     // We have no local work, attempt to steal from other threads.
 
-    // attempt to steal work from promoted.
-    if (task_queues()->steal(par_scan_state()->thread_num(),
+    // attempt to steal work from promoted, preferring the same node.
+    if (par_gen()->steal_from_same_node(par_scan_state()->thread_num(), obj_to_scan) ||
+        task_queues()->steal(par_scan_state()->thread_num(),
                              par_scan_state()->hash_seed(),
                              obj_to_scan)) {
       bool res = work_q->push(obj_to_scan);
@@ -611,6 +612,10 @@ void ParNewGenTask::work(uint worker_id) {
 
   par_scan_state.set_young_old_boundary(_young_old_boundary);
 
+  if (UseNUMA) {
+    _gen->set_worker_lgrp_id(worker_id, os::numa_get_group_id());
+  }
+
   KlassScanClosure klass_scan_closure(&par_scan_state.to_space_root_closure(),
                                       gch->rem_set()->klass_rem_set());
   CLDToKlassAndOopClosure cld_scan_closure(&klass_scan_closure,
@@ -659,6 +664,14 @@ ParNewGeneration(ReservedSpace rs, size_t initial_byte_size, int level)
   for (uint i2 = 0; i2 < ParallelGCThreads; i2++)
     _task_queues->queue(i2)->initialize();
 
+  _worker_lgrp_ids = NULL;
+  if (UseNUMA) {
+    _worker_lgrp_ids = NEW_C_HEAP_ARRAY(int, ParallelGCThreads, mtGC);
+    for (uint i = 0; i < ParallelGCThreads; i++) {
+      _worker_lgrp_ids[i] = -1;
+    }
+  }
+
   _overflow_stacks = NULL;
   if (ParGCUseLocalOverflow) {
 
@@ -981,6 +994,13 @@ void ParNewGeneration::collect(bool   full,
                                          *to(), *this, *_next_gen, *task_queues(),
                                          _overflow_stacks, desired_plab_sz(), _term);
 
+  if (UseNUMA) {
+    // Workers that do not take part must not be stolen from by node.
+    for (uint i = 0; i < ParallelGCThreads; i++) {
+      _worker_lgrp_ids[i] = -1;
+    }
+  }
+
   ParNewGenTask tsk(this, _next_gen, reserved().end(), &thread_state_set);
   gch->set_par_threads(n_workers);
   gch->rem_set()->prepare_for_younger_refs_iterate(true);
@@ -1479,6 +1499,21 @@ void ParNewGeneration::push_on_overflow_list(oop from_space_obj, ParScanThreadSt
   }
 }
 
+bool ParNewGeneration::steal_from_same_node(uint queue_num, oop& obj) {
+  if (_worker_lgrp_ids == NULL || _worker_lgrp_ids[queue_num] == -1) {
+    return false;
+  }
+  int lgrp_id = _worker_lgrp_ids[queue_num];
+  for (uint i = 1; i < ParallelGCThreads; i++) {
+    uint victim = (queue_num + i) % ParallelGCThreads;
+    if (_worker_lgrp_ids[victim] == lgrp_id &&
+        task_queues()->queue(victim)->pop_global(obj)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool ParNewGeneration::take_from_overflow_list(ParScanThreadState* par_scan_state) {
   bool res;
 
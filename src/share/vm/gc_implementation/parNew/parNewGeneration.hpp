@@ -320,6 +320,10 @@ class ParNewGeneration: public DefNewGeneration {
   // Per-worker-thread local overflow stacks
   Stack<oop, mtGC>* _overflow_stacks;
 
+  // With UseNUMA, the node each worker ran on at the start of the
+  // collection, -1 if unknown.
+  int* _worker_lgrp_ids;
+
   // Desired size of survivor space plab's
   PLABStats _plab_stats;
 
@@ -423,6 +427,16 @@ class ParNewGeneration: public DefNewGeneration {
     return _task_queues;
   }
 
+  void set_worker_lgrp_id(uint worker_id, int lgrp_id) {
+    assert(_worker_lgrp_ids != NULL, "only with UseNUMA");
+    _worker_lgrp_ids[worker_id] = lgrp_id;
+  }
+
+  // Try to steal a task from the workers running on the same node as the
+  // worker with queue "queue_num": what they copied is still in the
+  // caches of that node.
+  bool steal_from_same_node(uint queue_num, oop& obj);
+
   PLABStats* plab_stats() {
     return &_plab_stats;
   }
@@ -26,10 +26,14 @@
 #include "gc_implementation/parallelScavenge/cardTableExtension.hpp"
 #include "gc_implementation/parallelScavenge/gcTaskManager.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
+#include "gc_implementation/parallelScavenge/psPromotionManager.inline.hpp"
+#include "gc_implementation/parallelScavenge/psScavenge.inline.hpp"
 #include "gc_implementation/parallelScavenge/psTasks.hpp"
 #include "gc_implementation/parallelScavenge/psYoungGen.hpp"
+#include "oops/objArrayOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/oop.psgc.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/prefetch.inline.hpp"
 
 // Checks an individual oop for missing precise marks. Mark
@@ -120,6 +124,34 @@ class CheckForPreciseMarks : public OopClosure {
   virtual void do_oop(narrowOop* p) { CheckForPreciseMarks::do_oop_work(p); }
 };
 
+// Returns the start of the object containing addr. Looking up the start
+// of an object array that spans many stripes walks the start array back
+// over all of them, so the last object found is remembered in *cached.
+static inline HeapWord* object_start_cached(ObjectStartArray* start_array,
+                                            HeapWord* addr,
+                                            HeapWord** cached) {
+  HeapWord* obj = *cached;
+  if (obj == NULL || addr < obj || addr >= obj + oop(obj)->size()) {
+    obj = start_array->object_start(addr);
+    *cached = obj;
+  }
+  return obj;
+}
+
+// Pushes the elements of the object array that lie in [start, end).
+template <class T>
+static void push_array_slice(PSPromotionManager* pm, objArrayOop a,
+                             HeapWord* start, HeapWord* end) {
+  T* const base = (T*)a->base();
+  T* p = MAX2(base, (T*)start);
+  T* const q = MIN2(base + a->length(), (T*)end);
+  for (; p < q; p++) {
+    if (PSScavenge::should_scavenge(p)) {
+      pm->claim_or_forward_depth(p);
+    }
+  }
+}
+
 // We get passed the space_top value to prevent us from traversing into
 // the old_gen promotion labs, which cannot be safely parsed.
 
@@ -133,34 +165,34 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
                                                     MutableSpace* sp,
                                                     HeapWord* space_top,
                                                     PSPromotionManager* pm,
-                                                    uint stripe_number,
-                                                    uint stripe_total) {
+                                                    volatile jint* stripe_claim) {
   int ssize = 128; // Naked constant!  Work unit = 64k.
-  int dirty_card_count = 0;
+  size_t stripes_scanned = 0;
+  size_t dirty_cards = 0;
+  size_t objects_scanned = 0;
+  size_t array_slices_scanned = 0;
 
   // It is a waste to get here if empty.
   assert(sp->bottom() < sp->top(), "Should not be called if empty");
   oop* sp_top = (oop*)space_top;
   jbyte* start_card = byte_for(sp->bottom());
   jbyte* end_card   = byte_for(sp_top - 1) + 1;
-  oop* last_scanned = NULL; // Prevent scanning objects more than once
-  // The width of the stripe ssize*stripe_total must be
-  // consistent with the number of stripes so that the complete slice
-  // is covered.
-  size_t slice_width = ssize * stripe_total;
-  for (jbyte* slice = start_card; slice < end_card; slice += slice_width) {
-    jbyte* worker_start_card = slice + stripe_number * ssize;
-    if (worker_start_card >= end_card)
-      return; // We're done.
-
-    jbyte* worker_end_card = worker_start_card + ssize;
-    if (worker_end_card > end_card)
-      worker_end_card = end_card;
+  const uint stripe_total = (uint)((end_card - start_card + ssize - 1) / ssize);
+  HeapWord* cached_object = NULL;
+
+  for (uint stripe_number = (uint)(Atomic::add(1, stripe_claim) - 1);
+       stripe_number < stripe_total;
+       stripe_number = (uint)(Atomic::add(1, stripe_claim) - 1)) {
+    stripes_scanned++;
+    jbyte* worker_start_card = start_card + stripe_number * ssize;
+    jbyte* worker_end_card = MIN2(worker_start_card + ssize, end_card);
 
     // We do not want to scan objects more than once. In order to accomplish
     // this, we assert that any object with an object head inside our 'slice'
     // belongs to us. We may need to extend the range of scanned cards if the
-    // last object continues into the next 'slice'.
+    // last object continues into the next 'slice'. Object arrays are the
+    // exception: their elements are card marked precisely, so every stripe
+    // scans the elements on its own dirty cards.
     //
     // Note! ending cards are exclusive!
     HeapWord* slice_start = addr_for(worker_start_card);
@@ -176,30 +208,40 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
     }
 #endif
 
-    // If there are not objects starting within the chunk, skip it.
+    // If there are not objects starting within the chunk, it is covered by
+    // an object starting in an earlier one. Unless that is an object array
+    // with dirty cards in the chunk, skip it.
     if (!start_array->object_starts_in_range(slice_start, slice_end)) {
-      continue;
+      jbyte* card = worker_start_card;
+      while (card < worker_end_card && card_is_clean(*card)) {
+        card++;
+      }
+      if (card == worker_end_card ||
+          !oop(object_start_cached(start_array, slice_start, &cached_object))->is_objArray()) {
+        continue;
+      }
     }
     // Update our beginning addr
-    HeapWord* first_object = start_array->object_start(slice_start);
-    debug_only(oop* first_object_within_slice = (oop*) first_object;)
-    if (first_object < slice_start) {
+    oop* last_scanned = NULL; // Prevent scanning objects more than once
+    HeapWord* first_object = object_start_cached(start_array, slice_start, &cached_object);
+    if (first_object < slice_start && !oop(first_object)->is_objArray()) {
       last_scanned = (oop*)(first_object + oop(first_object)->size());
-      debug_only(first_object_within_slice = last_scanned;)
       worker_start_card = byte_for(last_scanned);
     }
 
     // Update the ending addr
     if (slice_end < (HeapWord*)sp_top) {
       // The subtraction is important! An object may start precisely at slice_end.
-      HeapWord* last_object = start_array->object_start(slice_end - 1);
-      slice_end = last_object + oop(last_object)->size();
-      // worker_end_card is exclusive, so bump it one past the end of last_object's
-      // covered span.
-      worker_end_card = byte_for(slice_end) + 1;
-
-      if (worker_end_card > end_card)
-        worker_end_card = end_card;
+      HeapWord* last_object = object_start_cached(start_array, slice_end - 1, &cached_object);
+      if (!oop(last_object)->is_objArray()) {
+        slice_end = last_object + oop(last_object)->size();
+        // worker_end_card is exclusive, so bump it one past the end of last_object's
+        // covered span.
+        worker_end_card = byte_for(slice_end) + 1;
+
+        if (worker_end_card > end_card)
+          worker_end_card = end_card;
+      }
     }
 
     assert(slice_end <= (HeapWord*)sp_top, "Last object in slice crosses space boundary");
@@ -229,34 +271,29 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
           // an object has more than one dirty card, separated by a clean card,
           // we will attempt to scan it twice. The test against "last_scanned"
           // prevents the redundant object scan, but it does not prevent newly
-          // marked cards from being cleaned.
-          HeapWord* last_object_in_dirty_region = start_array->object_start(addr_for(current_card)-1);
-          size_t size_of_last_object = oop(last_object_in_dirty_region)->size();
-          HeapWord* end_of_last_object = last_object_in_dirty_region + size_of_last_object;
-          jbyte* ending_card_of_last_object = byte_for(end_of_last_object);
-          assert(ending_card_of_last_object <= worker_end_card, "ending_card_of_last_object is greater than worker_end_card");
-          if (ending_card_of_last_object > current_card) {
-            // This means the object spans the next complete card.
-            // We need to bump the current_card to ending_card_of_last_object
-            current_card = ending_card_of_last_object;
+          // marked cards from being cleaned. Object arrays are only scanned
+          // on their dirty cards, so the run is not extended for them.
+          HeapWord* last_object_in_dirty_region =
+            object_start_cached(start_array, addr_for(current_card)-1, &cached_object);
+          if (!oop(last_object_in_dirty_region)->is_objArray()) {
+            size_t size_of_last_object = oop(last_object_in_dirty_region)->size();
+            HeapWord* end_of_last_object = last_object_in_dirty_region + size_of_last_object;
+            jbyte* ending_card_of_last_object = byte_for(end_of_last_object);
+            assert(ending_card_of_last_object <= worker_end_card, "ending_card_of_last_object is greater than worker_end_card");
+            if (ending_card_of_last_object > current_card) {
+              // This means the object spans the next complete card.
+              // We need to bump the current_card to ending_card_of_last_object
+              current_card = ending_card_of_last_object;
+            }
           }
         }
       }
       jbyte* following_clean_card = current_card;
 
       if (first_unclean_card < worker_end_card) {
-        oop* p = (oop*) start_array->object_start(addr_for(first_unclean_card));
-        assert((HeapWord*)p <= addr_for(first_unclean_card), "checking");
-        // "p" should always be >= "last_scanned" because newly GC dirtied
-        // cards are no longer scanned again (see comment at end
-        // of loop on the increment of "current_card").  Test that
-        // hypothesis before removing this code.
-        // If this code is removed, deal with the first time through
-        // the loop when the last_scanned is the object starting in
-        // the previous slice.
-        assert((p >= last_scanned) ||
-               (last_scanned == first_object_within_slice),
-               "Should no longer be possible");
+        HeapWord* dirty_start = addr_for(first_unclean_card);
+        oop* p = (oop*) object_start_cached(start_array, dirty_start, &cached_object);
+        assert((HeapWord*)p <= dirty_start, "checking");
         if (p < last_scanned) {
           // Avoid scanning more than once; this can happen because
           // newgen cards set by GC may a different set than the
@@ -271,6 +308,7 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
         } else if (to > sp_top) {
           to = sp_top;
         }
+        dirty_cards += following_clean_card - first_unclean_card;
 
         // we know which cards to scan, now clear them
         if (first_unclean_card <= worker_start_card+1)
@@ -282,27 +320,36 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
           *first_unclean_card++ = clean_card;
         }
 
+        // scan all objects in the range, and the part of the object
+        // arrays in it. An object array that continues after the range
+        // may have more dirty cards, so it is not skipped by last_scanned.
         const int interval = PrefetchScanIntervalInBytes;
-        // scan all objects in the range
-        if (interval != 0) {
-          while (p < to) {
+        oop* partial_array = NULL;
+        while (p < to) {
+          if (interval != 0) {
             Prefetch::write(p, interval);
-            oop m = oop(p);
-            assert(m->is_oop_or_null(), "check for header");
-            m->push_contents(pm);
-            p += m->size();
           }
-          pm->drain_stacks_cond_depth();
-        } else {
-          while (p < to) {
-            oop m = oop(p);
-            assert(m->is_oop_or_null(), "check for header");
+          oop m = oop(p);
+          assert(m->is_oop_or_null(), "check for header");
+          size_t size = m->size();
+          if (m->is_objArray() &&
+              ((HeapWord*)p < dirty_start || (HeapWord*)(p + size) > (HeapWord*)to)) {
+            if (UseCompressedOops) {
+              push_array_slice<narrowOop>(pm, objArrayOop(m), dirty_start, (HeapWord*)to);
+            } else {
+              push_array_slice<oop>(pm, objArrayOop(m), dirty_start, (HeapWord*)to);
+            }
+            array_slices_scanned++;
+            partial_array = ((HeapWord*)(p + size) > (HeapWord*)to) ? p : NULL;
+          } else {
             m->push_contents(pm);
-            p += m->size();
+            objects_scanned++;
+            partial_array = NULL;
           }
-          pm->drain_stacks_cond_depth();
+          p = (oop*)((HeapWord*)p + size);
         }
-        last_scanned = p;
+        pm->drain_stacks_cond_depth();
+        last_scanned = (partial_array != NULL) ? partial_array : p;
       }
       // "current_card" is still the "following_clean_card" or
       // the current_card is >= the worker_end_card so the
@@ -318,6 +365,9 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
       current_card++;
     }
   }
+
+  pm->record_old_to_young_scan(stripes_scanned, dirty_cards,
+                               objects_scanned, array_slices_scanned);
 }
 
 // This should be called before a scavenge.
@@ -60,12 +60,13 @@ class CardTableExtension : public CardTableModRefBS {
   // BarrierSet::Name kind() { return BarrierSet::CardTableExtension; }
 
   // Scavenge support
+  // Scans the dirty cards of the stripes claimed from the shared counter
+  // stripe_claim, see OldToYoungRootsTask.
   void scavenge_contents_parallel(ObjectStartArray* start_array,
                                   MutableSpace* sp,
                                   HeapWord* space_top,
                                   PSPromotionManager* pm,
-                                  uint stripe_number,
-                                  uint stripe_total);
+                                  volatile jint* stripe_claim);
 
   // Verification
   static void verify_all_young_refs_imprecise();
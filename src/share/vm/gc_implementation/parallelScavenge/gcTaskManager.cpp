@@ -25,9 +25,11 @@
 #include "precompiled.hpp"
 #include "gc_implementation/parallelScavenge/gcTaskManager.hpp"
 #include "gc_implementation/parallelScavenge/gcTaskThread.hpp"
+#include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.inline.hpp"
@@ -407,6 +409,17 @@ void GCTaskManager::initialize() {
   _noop_task = NoopGCTask::create_on_c_heap();
   _idle_inactive_task = WaitForBarrierGCTask::create_on_c_heap();
   _resource_flag = NEW_C_HEAP_ARRAY(bool, workers(), mtGC);
+  // One lock free queue per worker and the shared one.
+  _deques = new GCTaskDequeSet(workers() + 1);
+  for (uint q = 0; q <= workers(); q += 1) {
+    GCTaskDeque* deque = new GCTaskDeque();
+    deque->initialize();
+    _deques->register_queue(q, deque);
+  }
+  _unclaimed_tasks = 0;
+  _outstanding_tasks = 0;
+  _lock_free_claim = NEW_C_HEAP_ARRAY(bool, workers(), mtGC);
+  _steal_seed = NEW_C_HEAP_ARRAY(int, workers(), mtGC);
   {
     // Set up worker threads.
     //     Distribute the workers among the available processors,
@@ -435,6 +448,8 @@ void GCTaskManager::initialize() {
   set_unblocked();
   for (uint w = 0; w < workers(); w += 1) {
     set_resource_flag(w, false);
+    _lock_free_claim[w] = false;
+    _steal_seed[w] = 17 + w;
   }
   reset_delivered_tasks();
   reset_completed_tasks();
@@ -449,6 +464,7 @@ void GCTaskManager::initialize() {
 GCTaskManager::~GCTaskManager() {
   assert(busy_workers() == 0, "still have busy workers");
   assert(queue()->is_empty(), "still have queued work");
+  assert(!has_outstanding_lock_free_tasks(), "still have lock free work");
   NoopGCTask::destroy(_noop_task);
   _noop_task = NULL;
   WaitForBarrierGCTask::destroy(_idle_inactive_task);
@@ -465,6 +481,21 @@ GCTaskManager::~GCTaskManager() {
     FREE_C_HEAP_ARRAY(bool, _resource_flag, mtGC);
     _resource_flag = NULL;
   }
+  if (_deques != NULL) {
+    for (uint q = 0; q <= workers(); q += 1) {
+      delete deque(q);
+    }
+    delete _deques;
+    _deques = NULL;
+  }
+  if (_lock_free_claim != NULL) {
+    FREE_C_HEAP_ARRAY(bool, _lock_free_claim, mtGC);
+    _lock_free_claim = NULL;
+  }
+  if (_steal_seed != NULL) {
+    FREE_C_HEAP_ARRAY(int, _steal_seed, mtGC);
+    _steal_seed = NULL;
+  }
   if (queue() != NULL) {
     GCTaskQueue* unsynchronized_queue = queue()->unsynchronized_queue();
     GCTaskQueue::destroy(unsynchronized_queue);
@@ -482,7 +513,21 @@ void GCTaskManager::set_active_gang() {
     AdaptiveSizePolicy::calc_active_workers(workers(),
                                  active_workers(),
                                  Threads::number_of_non_daemon_threads());
+  report_active_gang();
+}
+
+void GCTaskManager::set_active_gang(const GCWorkerEstimator* estimator,
+                                    size_t work_words) {
+  _active_workers =
+    AdaptiveSizePolicy::calc_active_workers(workers(),
+                                 active_workers(),
+                                 Threads::number_of_non_daemon_threads(),
+                                 estimator,
+                                 work_words);
+  report_active_gang();
+}
 
+void GCTaskManager::report_active_gang() {
   assert(!all_workers_active() || active_workers() == ParallelGCThreads,
          err_msg("all_workers_active() is  incorrect: "
                  "active %d  ParallelGCThreads %d", active_workers(),
@@ -615,6 +660,9 @@ void GCTaskManager::add_list(GCTaskQueue* list) {
   if (TraceGCTaskManager) {
     tty->print_cr("GCTaskManager::add_list(%u)", list->length());
   }
+  if (UseGCTaskStealing) {
+    add_lock_free(list);
+  }
   queue()->enqueue(list);
   // Notify with the lock held to avoid missed notifies.
   if (TraceGCTaskManager) {
@@ -633,13 +681,25 @@ void GCTaskManager::add_list(GCTaskQueue* list) {
 // and then loops to find more work.
 
 GCTask* GCTaskManager::get_task(uint which) {
-  GCTask* result = NULL;
+  GCTask* result = claim_lock_free_task(which);
+  if (result != NULL) {
+    return result;
+  }
   // Grab the queue lock.
   MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
   // Wait while the queue is block or
   // there is nothing to do, except maybe release resources.
-  while (is_blocked() ||
+  // Tasks on the lock free queues go first.
+  while (has_lock_free_tasks() || is_blocked() ||
          (queue()->is_empty() && !should_release_resources(which))) {
+    if (has_lock_free_tasks()) {
+      MutexUnlockerEx mul(monitor(), Mutex::_no_safepoint_check_flag);
+      result = claim_lock_free_task(which);
+      if (result != NULL) {
+        return result;
+      }
+      continue;
+    }
     if (TraceGCTaskManager) {
       tty->print_cr("GCTaskManager::get_task(%u)"
                     "  blocked: %s"
@@ -684,11 +744,80 @@ GCTask* GCTaskManager::get_task(uint which) {
     increment_busy_workers();
     increment_delivered_tasks();
   }
+  _lock_free_claim[which] = false;
   return result;
   // Release monitor().
 }
 
+void GCTaskManager::add_lock_free(GCTaskQueue* list) {
+  assert(queue()->own_lock(), "don't own the lock");
+  // Tasks added behind queued or blocked tasks have to wait for them.
+  if (is_blocked() || !queue()->is_empty()) {
+    return;
+  }
+  while (!list->is_empty() && list->peek()->is_ordinary_task()) {
+    GCTask* task = list->peek();
+    GCTaskDeque* q = shared_deque();
+    if (UseGCTaskAffinity && task->affinity() < workers()) {
+      q = deque(task->affinity());
+    }
+    // Count the task first, so that it is never claimed uncounted.
+    Atomic::inc(&_outstanding_tasks);
+    Atomic::inc(&_unclaimed_tasks);
+    if (!q->push(task)) {
+      // The rest is handed out under the monitor.
+      Atomic::dec(&_unclaimed_tasks);
+      Atomic::dec(&_outstanding_tasks);
+      break;
+    }
+    list->dequeue();
+  }
+}
+
+GCTask* GCTaskManager::claim_lock_free_task(uint which) {
+  GCTask* result = NULL;
+  while (has_lock_free_tasks()) {
+    if (deque(which)->pop_global(result) ||
+        shared_deque()->pop_global(result) ||
+        _deques->steal(which, &_steal_seed[which], result)) {
+      Atomic::dec(&_unclaimed_tasks);
+      _lock_free_claim[which] = true;
+      if (TraceGCTaskManager) {
+        tty->print_cr("GCTaskManager::claim_lock_free_task(%u) => " INTPTR_FORMAT " [%s]",
+                      which, result, result->name());
+      }
+      return result;
+    }
+    // A task is being pushed or has just been claimed.
+    SpinPause();
+  }
+  return NULL;
+}
+
+void GCTaskManager::note_lock_free_completion(uint which) {
+  if (TraceGCTaskManager) {
+    tty->print_cr("GCTaskManager::note_lock_free_completion(%u)", which);
+  }
+  if (Atomic::add(-1, &_outstanding_tasks) == 0) {
+    // Wake up a barrier task waiting for the lock free tasks.
+    MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
+    if (busy_workers() == 0 && queue()->is_empty() &&
+        !has_outstanding_lock_free_tasks()) {
+      increment_emptied_queue();
+      NotifyDoneClosure* ndc = notify_done_closure();
+      if (ndc != NULL) {
+        ndc->notify(this);
+      }
+    }
+    (void) monitor()->notify_all();
+  }
+}
+
 void GCTaskManager::note_completion(uint which) {
+  if (_lock_free_claim[which]) {
+    note_lock_free_completion(which);
+    return;
+  }
   MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
   if (TraceGCTaskManager) {
     tty->print_cr("GCTaskManager::note_completion(%u)", which);
@@ -702,7 +831,8 @@ void GCTaskManager::note_completion(uint which) {
   }
   increment_completed_tasks();
   uint active = decrement_busy_workers();
-  if ((active == 0) && (queue()->is_empty())) {
+  if ((active == 0) && (queue()->is_empty()) &&
+      !has_outstanding_lock_free_tasks()) {
     increment_emptied_queue();
     if (TraceGCTaskManager) {
       tty->print_cr("    GCTaskManager::note_completion(%u) done", which);
@@ -928,7 +1058,8 @@ void BarrierGCTask::do_it_internal(GCTaskManager* manager, uint which) {
   // Wait for this to be the only busy worker.
   assert(manager->monitor()->owned_by_self(), "don't own the lock");
   assert(manager->is_blocked(), "manager isn't blocked");
-  while (manager->busy_workers() > 1) {
+  while (manager->busy_workers() > 1 ||
+         manager->has_outstanding_lock_free_tasks()) {
     if (TraceGCTaskManager) {
       tty->print_cr("BarrierGCTask::do_it(%u) waiting on %u workers",
                     which, manager->busy_workers());
@@ -1143,3 +1274,57 @@ void MonitorSupply::release(Monitor* instance) {
     // release lock().
   }
 }
+
+#ifndef PRODUCT
+
+// A task that only counts its executions.
+class CountingGCTask : public GCTask {
+ private:
+  volatile jint* _count;
+ public:
+  CountingGCTask(volatile jint* count) : GCTask(), _count(count) { }
+  virtual char* name() { return (char *)"counting task"; }
+  void do_it(GCTaskManager* manager, uint which) {
+    Atomic::inc(_count);
+  }
+};
+
+// Runs rounds of tasks through the manager and returns the average time
+// in ns from handing out a task to the completion of its round.
+static jlong dispatch_latency(GCTaskManager* manager, uint tasks, uint rounds) {
+  volatile jint count = 0;
+  jlong start = os::javaTimeNanos();
+  for (uint r = 0; r < rounds; r++) {
+    ResourceMark rm;
+    GCTaskQueue* q = GCTaskQueue::create();
+    for (uint i = 0; i < tasks; i++) {
+      q->enqueue(new CountingGCTask(&count));
+    }
+    manager->execute_and_wait(q);
+  }
+  jlong elapsed = os::javaTimeNanos() - start;
+  assert(count == (jint)(tasks * rounds),
+         err_msg("executed %d of %u tasks", count, tasks * rounds));
+  return elapsed / (tasks * rounds);
+}
+
+// Compares the dispatch latency of the monitor and the lock free queues.
+void TestGCTaskManager_test() {
+  GCTaskManager* manager = ParallelScavengeHeap::gc_task_manager();
+  const bool saved = UseGCTaskStealing;
+  const uint tasks = 8 * ParallelGCThreads;
+  const uint rounds = 100;
+
+  UseGCTaskStealing = false;
+  jlong locked = dispatch_latency(manager, tasks, rounds);
+  UseGCTaskStealing = true;
+  jlong lock_free = dispatch_latency(manager, tasks, rounds);
+  UseGCTaskStealing = saved;
+
+  assert(!manager->has_outstanding_lock_free_tasks(), "lock free tasks left");
+  tty->print_cr("  GCTaskManager dispatch latency: monitor " JLONG_FORMAT
+                " ns, lock free " JLONG_FORMAT " ns per task",
+                locked, lock_free);
+}
+
+#endif
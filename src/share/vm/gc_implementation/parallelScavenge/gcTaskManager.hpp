@@ -27,6 +27,7 @@
 
 #include "runtime/mutex.hpp"
 #include "utilities/growableArray.hpp"
+#include "utilities/taskqueue.hpp"
 
 //
 // The GCTaskManager is a queue of GCTasks, and accessors
@@ -54,6 +55,7 @@ class GCTaskThread;
 class Mutex;
 class Monitor;
 class ThreadClosure;
+class GCWorkerEstimator;
 
 // The abstract base GCTask.
 class GCTask : public ResourceObj {
@@ -173,6 +175,10 @@ public:
   GCTask* dequeue();
   //     Dequeue one task, preferring one with affinity.
   GCTask* dequeue(uint affinity);
+  //     The task dequeue() would return next, without removing it.
+  GCTask* peek() const {
+    return remove_end();
+  }
 protected:
   // Constructor. Clients use factory, but there might be subclasses.
   GCTaskQueue(bool on_c_heap);
@@ -354,6 +360,27 @@ protected:
 // For PSScavenge and ParCompactionManager the GC threads are
 // held in the GCTaskThread** _thread array in GCTaskManager.
 
+// Lock free dispatch (UseGCTaskStealing)
+//
+//  Handing out every task under the monitor makes the GC threads
+// queue up on it when there are many of them.  With UseGCTaskStealing
+// the ordinary tasks at the head of a list added to an otherwise idle
+// GCTaskManager are pushed on GenericTaskQueues instead, and the GC
+// threads claim them with a CAS.  Tasks without affinity go to one
+// shared queue that is taken from its oldest end, so that they are
+// still handed out in the order in which they were added; the stealing
+// tasks rely on this to be claimed last.  With UseGCTaskAffinity a
+// task with affinity goes to the queue of its worker, and other
+// workers steal it once the shared queue is empty, which is no weaker
+// than GCTaskQueue::dequeue(affinity).
+//  The barrier, noop and idle tasks, and everything added after one of
+// them, are handed out under the monitor as before, but only once all
+// the tasks on the lock free queues have been claimed.  A barrier task
+// also waits for the completion of the lock free tasks.
+
+typedef GenericTaskQueue<GCTask*, mtGC, 1024> GCTaskDeque;
+typedef GenericTaskQueueSet<GCTaskDeque, mtGC> GCTaskDequeSet;
+
 
 class GCTaskManager : public CHeapObj<mtGC> {
  friend class ParCompactionManager;
@@ -382,6 +409,11 @@ private:
   uint                      _noop_tasks;        // Count of noop tasks.
   WaitForBarrierGCTask*     _idle_inactive_task;// Task for inactive workers
   volatile uint             _idle_workers;      // Number of idled workers
+  GCTaskDequeSet*           _deques;            // Lock free task queues.
+  volatile jint             _unclaimed_tasks;   // Tasks on the _deques.
+  volatile jint             _outstanding_tasks; // Lock free tasks not completed.
+  bool*                     _lock_free_claim;   // Per worker: task is lock free.
+  int*                      _steal_seed;        // Per worker: steal seed.
 public:
   // Factory create and destroy methods.
   static GCTaskManager* create(uint workers) {
@@ -421,6 +453,14 @@ public:
   GCTask* get_task(uint which);
   //     Note the completion of a task by the argument worker.
   void note_completion(uint which);
+  //     Are there tasks on the lock free queues?
+  bool has_lock_free_tasks() const {
+    return _unclaimed_tasks > 0;
+  }
+  //     Are lock free tasks waiting or running?
+  bool has_outstanding_lock_free_tasks() const {
+    return _outstanding_tasks > 0;
+  }
   //     Is the queue blocked from handing out new tasks?
   bool is_blocked() const {
     return (blocking_worker() != sentinel_worker());
@@ -468,6 +508,9 @@ protected:
   }
   // Sets the number of threads that will be used in a collection
   void set_active_gang();
+  // Same, but for a collection with the given work, see GCWorkerEstimator.
+  void set_active_gang(const GCWorkerEstimator* estimator, size_t work_words);
+  void report_active_gang();
 
   NotifyDoneClosure* notify_done_closure() const {
     return _ndc;
@@ -483,6 +526,22 @@ protected:
   void set_thread(uint which, GCTaskThread* value);
   bool resource_flag(uint which);
   void set_resource_flag(uint which, bool value);
+  //     The lock free queue of the argument worker, or the shared one.
+  GCTaskDeque* deque(uint which) const {
+    assert(which <= workers(), "index out of bounds");
+    return _deques->queue(which);
+  }
+  GCTaskDeque* shared_deque() const {
+    return deque(workers());
+  }
+  // Lock free dispatch.
+  //     Move the ordinary tasks at the head of the list to the lock
+  //     free queues.
+  void add_lock_free(GCTaskQueue* list);
+  //     Claim a task from the lock free queues, or return NULL.
+  GCTask* claim_lock_free_task(uint which);
+  //     Note the completion of a lock free task.
+  void note_lock_free_completion(uint which);
   // Modifier methods with some semantics.
   //     Is any worker blocking handing out new tasks?
   uint blocking_worker() const {
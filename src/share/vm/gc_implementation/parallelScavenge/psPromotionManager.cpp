@@ -92,6 +92,12 @@ bool PSPromotionManager::post_scavenge(YoungGCTracer& gc_tracer) {
   bool promotion_failure_occurred = false;
 
   TASKQUEUE_STATS_ONLY(if (PrintGCDetails && ParallelGCVerbose) print_stats());
+  if (PrintGCDetails) {
+    print_old_to_young_scan_stats();
+  }
+  if (PrintGCDetails && ParallelGCVerbose) {
+    print_termination_stats();
+  }
   for (uint i = 0; i < ParallelGCThreads + 1; i++) {
     PSPromotionManager* manager = manager_array(i);
     assert(manager->claimed_stack_depth()->is_empty(), "should be empty");
@@ -104,6 +110,36 @@ bool PSPromotionManager::post_scavenge(YoungGCTracer& gc_tracer) {
   return promotion_failure_occurred;
 }
 
+// The per thread histogram of the old-to-young card scanning.
+void PSPromotionManager::print_old_to_young_scan_stats() {
+  gclog_or_tty->print_cr("== Old-to-young card scanning, GC %3d",
+                         Universe::heap()->total_collections());
+  gclog_or_tty->print_cr("thr    stripes dirty cards    objects arr slices");
+  gclog_or_tty->print_cr("--- ---------- ----------- ---------- ----------");
+  for (uint i = 0; i < ParallelGCThreads; ++i) {
+    PSPromotionManager* manager = manager_array(i);
+    gclog_or_tty->print_cr("%3u " SIZE_FORMAT_W(10) " " SIZE_FORMAT_W(11) " "
+                           SIZE_FORMAT_W(10) " " SIZE_FORMAT_W(10), i,
+                           manager->_stripes_scanned, manager->_dirty_cards_scanned,
+                           manager->_objects_scanned, manager->_array_slices_scanned);
+  }
+}
+
+// The per thread time spent offering termination at the end of the
+// stealing phase.
+void PSPromotionManager::print_termination_stats() {
+  gclog_or_tty->print_cr("== Termination, GC %3d",
+                         Universe::heap()->total_collections());
+  gclog_or_tty->print_cr("thr  term (ms)   attempts");
+  gclog_or_tty->print_cr("--- ---------- ----------");
+  for (uint i = 0; i < ParallelGCThreads; ++i) {
+    PSPromotionManager* manager = manager_array(i);
+    gclog_or_tty->print_cr("%3u %10.3f " SIZE_FORMAT_W(10), i,
+                           manager->_termination_time * 1000.0,
+                           manager->_termination_attempts);
+  }
+}
+
 #if TASKQUEUE_STATS
 void
 PSPromotionManager::print_taskqueue_stats(uint i) const {
@@ -198,6 +234,14 @@ void PSPromotionManager::reset() {
 
   _promotion_failed_info.reset();
 
+  _stripes_scanned = 0;
+  _dirty_cards_scanned = 0;
+  _objects_scanned = 0;
+  _array_slices_scanned = 0;
+
+  _termination_time = 0.0;
+  _termination_attempts = 0;
+
   TASKQUEUE_STATS_ONLY(reset_stats());
 }
 
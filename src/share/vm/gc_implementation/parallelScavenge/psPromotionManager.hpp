@@ -91,6 +91,20 @@ class PSPromotionManager VALUE_OBJ_CLASS_SPEC {
 
   PromotionFailedInfo                 _promotion_failed_info;
 
+  // What this thread scanned of the old-to-young card table, see
+  // CardTableExtension::scavenge_contents_parallel().
+  size_t                              _stripes_scanned;
+  size_t                              _dirty_cards_scanned;
+  size_t                              _objects_scanned;
+  size_t                              _array_slices_scanned;
+
+  // Time spent in and number of offers of termination, see StealTask.
+  double                              _termination_time;
+  size_t                              _termination_attempts;
+
+  static void print_old_to_young_scan_stats();
+  static void print_termination_stats();
+
   // Accessors
   static PSOldGen* old_gen()         { return _old_gen; }
   static MutableSpace* young_space() { return _young_space; }
@@ -202,6 +216,19 @@ class PSPromotionManager VALUE_OBJ_CLASS_SPEC {
 
   template <class T> inline void claim_or_forward_depth(T* p);
 
+  void record_old_to_young_scan(size_t stripes, size_t dirty_cards,
+                                size_t objects, size_t array_slices) {
+    _stripes_scanned += stripes;
+    _dirty_cards_scanned += dirty_cards;
+    _objects_scanned += objects;
+    _array_slices_scanned += array_slices;
+  }
+
+  void record_termination(double secs) {
+    _termination_time += secs;
+    _termination_attempts++;
+  }
+
   TASKQUEUE_STATS_ONLY(inline void record_steal(StarTask& p);)
 };
 
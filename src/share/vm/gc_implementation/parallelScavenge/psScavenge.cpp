@@ -72,6 +72,7 @@ ParallelScavengeTracer     PSScavenge::_gc_tracer;
 Stack<markOop, mtGC>       PSScavenge::_preserved_mark_stack;
 Stack<oop, mtGC>           PSScavenge::_preserved_oop_stack;
 CollectorCounters*         PSScavenge::_counters = NULL;
+GCWorkerEstimator*         PSScavenge::_worker_estimator = NULL;
 
 // Define before use
 class PSIsAliveClosure: public BoolObjectClosure {
@@ -383,8 +384,13 @@ bool PSScavenge::invoke_no_policy() {
     // Release all previously held resources
     gc_task_manager()->release_all_resources();
 
-    // Set the number of GC threads to be used in this collection
-    gc_task_manager()->set_active_gang();
+    // Set the number of GC threads to be used in this collection.
+    // The work is the young gen, the thread stacks and the cards of
+    // the old gen.
+    size_t work_words = young_gen->used_in_words() +
+                        AdaptiveSizePolicy::root_set_words() +
+                        old_gen->used_in_words() / CardTableModRefBS::card_size_in_words;
+    gc_task_manager()->set_active_gang(_worker_estimator, work_words);
     gc_task_manager()->task_idle_workers();
     // Get the active number of workers here and use that value
     // throughout the methods.
@@ -401,12 +407,13 @@ bool PSScavenge::invoke_no_policy() {
 
       GCTaskQueue* q = GCTaskQueue::create();
 
+      // The old-to-young tasks claim the stripes of the old gen from here.
+      volatile jint stripe_claim = 0;
       if (!old_gen->object_space()->is_empty()) {
         // There are only old-to-young pointers if there are objects
         // in the old gen.
-        uint stripe_total = active_workers;
-        for(uint i=0; i < stripe_total; i++) {
-          q->enqueue(new OldToYoungRootsTask(old_gen, old_top, i, stripe_total));
+        for(uint i=0; i < active_workers; i++) {
+          q->enqueue(new OldToYoungRootsTask(old_gen, old_top, &stripe_claim));
         }
       }
 
@@ -431,7 +438,10 @@ bool PSScavenge::invoke_no_policy() {
         }
       }
 
+      double start_sec = os::elapsedTime();
       gc_task_manager()->execute_and_wait(q);
+      _worker_estimator->sample(work_words, active_workers,
+                                (os::elapsedTime() - start_sec) * MILLIUNITS);
     }
 
     scavenge_midpoint.update();
@@ -862,4 +872,5 @@ void PSScavenge::initialize() {
   _card_table = (CardTableExtension*)bs;
 
   _counters = new CollectorCounters("PSScavenge", 0);
+  _worker_estimator = new GCWorkerEstimator("PSScavenge");
 }
@@ -82,6 +82,7 @@ class PSScavenge: AllStatic {
   static Stack<markOop, mtGC> _preserved_mark_stack; // List of marks to be restored after failed promotion
   static Stack<oop, mtGC>     _preserved_oop_stack;  // List of oops that need their mark restored.
   static CollectorCounters*   _counters;             // collector performance counters
+  static GCWorkerEstimator*   _worker_estimator;     // chooses the number of GC threads
 
   static void clean_up_failed_promotion();
 
@@ -37,6 +37,7 @@
 #include "oops/oop.inline.hpp"
 #include "oops/oop.psgc.inline.hpp"
 #include "runtime/fprofiler.hpp"
+#include "runtime/os.hpp"
 #include "runtime/thread.hpp"
 #include "runtime/vmThread.hpp"
 #include "services/management.hpp"
@@ -159,7 +160,10 @@ void StealTask::do_it(GCTaskManager* manager, uint which) {
       pm->process_popped_location_depth(p);
       pm->drain_stacks_depth(true);
     } else {
-      if (terminator()->offer_termination()) {
+      double start = os::elapsedTime();
+      bool terminated = terminator()->offer_termination();
+      pm->record_termination(os::elapsedTime() - start);
+      if (terminated) {
         break;
       }
     }
@@ -177,7 +181,6 @@ void OldToYoungRootsTask::do_it(GCTaskManager* manager, uint which) {
     "Should not be called is there is no work");
   assert(_gen != NULL, "Sanity");
   assert(_gen->object_space()->contains(_gen_top) || _gen_top == _gen->object_space()->top(), "Sanity");
-  assert(_stripe_number < ParallelGCThreads, "Sanity");
 
   {
     PSPromotionManager* pm = PSPromotionManager::gc_thread_promotion_manager(which);
@@ -190,8 +193,7 @@ void OldToYoungRootsTask::do_it(GCTaskManager* manager, uint which) {
                                            _gen->object_space(),
                                            _gen_top,
                                            pm,
-                                           _stripe_number,
-                                           _stripe_total);
+                                           _stripe_claim);
 
     // Do the real work
     pm->drain_stacks(false);
@@ -26,6 +26,7 @@
 #include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "gc_interface/gcCause.hpp"
 #include "memory/collectorPolicy.hpp"
+#include "runtime/thread.inline.hpp"
 #include "runtime/timer.hpp"
 #include "utilities/ostream.hpp"
 #include "utilities/workgroup.hpp"
@@ -203,6 +204,40 @@ int AdaptiveSizePolicy::calc_active_workers(uintx total_workers,
   return new_active_workers;
 }
 
+int AdaptiveSizePolicy::calc_active_workers(uintx total_workers,
+                                            uintx active_workers,
+                                            uintx application_workers,
+                                            const GCWorkerEstimator* estimator,
+                                            size_t work_words) {
+  int new_active_workers = calc_active_workers(total_workers,
+                                               active_workers,
+                                               application_workers);
+  if (!UseDynamicNumberOfGCThreads ||
+      (!FLAG_IS_DEFAULT(ParallelGCThreads) && !ForceDynamicNumberOfGCThreads)) {
+    return new_active_workers;
+  }
+  // Unlike the above this is not smoothed: a small pause right after
+  // a large one should not wake up more workers than it can keep busy.
+  uintx min_workers = (total_workers == 1) ? 1 : 2;
+  new_active_workers = estimator->workers_for(work_words,
+                                              MIN2(min_workers, (uintx) new_active_workers),
+                                              new_active_workers);
+  assert(new_active_workers > 0, "Always need at least 1");
+  return new_active_workers;
+}
+
+size_t AdaptiveSizePolicy::root_set_words() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  size_t words = 0;
+  for (JavaThread* thread = Threads::first(); thread != NULL; thread = thread->next()) {
+    if (thread->has_last_Java_frame()) {
+      words += pointer_delta(thread->stack_base(),
+                             (address) thread->last_Java_sp(), HeapWordSize);
+    }
+  }
+  return words;
+}
+
 int AdaptiveSizePolicy::calc_active_conc_workers(uintx total_workers,
                                                  uintx active_workers,
                                                  uintx application_workers) {
@@ -219,6 +254,38 @@ int AdaptiveSizePolicy::calc_active_conc_workers(uintx total_workers,
   }
 }
 
+GCWorkerEstimator::GCWorkerEstimator(const char* phase) :
+  _words_per_ms(AdaptiveSizePolicyWeight), _phase(phase) {
+}
+
+void GCWorkerEstimator::sample(size_t work_words, uint workers, double elapsed_ms) {
+  if (elapsed_ms <= 0.0 || workers == 0) {
+    return;
+  }
+  _words_per_ms.sample((float) (work_words / (elapsed_ms * workers)));
+}
+
+uint GCWorkerEstimator::workers_for(size_t work_words,
+                                    uint min_workers,
+                                    uint max_workers) const {
+  assert(min_workers <= max_workers, "invariant");
+  if (_words_per_ms.count() == 0 || _words_per_ms.average() <= 0.0F) {
+    return max_workers;
+  }
+  double words_per_worker =
+    (double) _words_per_ms.average() * MAX2(DynamicGCThreadsMinWorkMillis, (uintx) 1);
+  double wanted = ceil((double) work_words / words_per_worker);
+  uint result = (uint) MAX2((double) min_workers, MIN2(wanted, (double) max_workers));
+  if (TraceDynamicGCThreads) {
+    gclog_or_tty->print_cr("GCWorkerEstimator::workers_for() %s: "
+                           "work: " SIZE_FORMAT "  words/ms/worker: %.1f  "
+                           "workers: %u (%u..%u)",
+                           _phase, work_words, _words_per_ms.average(),
+                           result, min_workers, max_workers);
+  }
+  return result;
+}
+
 bool AdaptiveSizePolicy::tenuring_threshold_change() const {
   return decrement_tenuring_threshold_for_gc_cost() ||
          increment_tenuring_threshold_for_gc_cost() ||
@@ -38,6 +38,30 @@
 class elapsedTimer;
 class CollectorPolicy;
 
+// GCWorkerEstimator keeps the rate at which a GC worker got through the
+// work of a parallel phase in recent collections, and chooses the
+// number of workers of the next such phase so that each of them gets
+// at least DynamicGCThreadsMinWorkMillis of work. The work of a phase is
+// measured in words, e.g. the size of its collection set plus the size
+// of its root set. Until a rate has been sampled all the workers are
+// used.
+class GCWorkerEstimator : public CHeapObj<mtGC> {
+ private:
+  AdaptiveWeightedAverage _words_per_ms;   // Per worker.
+  const char*             _phase;          // For TraceDynamicGCThreads.
+
+ public:
+  GCWorkerEstimator(const char* phase);
+
+  // Record that the given number of workers got through work_words
+  // of work in elapsed_ms.
+  void sample(size_t work_words, uint workers, double elapsed_ms);
+
+  // The number of workers, between min_workers and max_workers, for
+  // a phase with work_words of work.
+  uint workers_for(size_t work_words, uint min_workers, uint max_workers) const;
+};
+
 class AdaptiveSizePolicy : public CHeapObj<mtGC> {
  friend class GCAdaptivePolicyCounters;
  friend class PSGCAdaptivePolicyCounters;
@@ -362,6 +386,19 @@ class AdaptiveSizePolicy : public CHeapObj<mtGC> {
                                  uintx active_workers,
                                  uintx application_workers);
 
+  // Return number of GC threads to use in the next GC phase, given
+  // the work of that phase. This is calc_active_workers() further
+  // limited by the estimator, if the number of GC threads is dynamic.
+  static int calc_active_workers(uintx total_workers,
+                                 uintx active_workers,
+                                 uintx application_workers,
+                                 const GCWorkerEstimator* estimator,
+                                 size_t work_words);
+
+  // The words of the thread stacks, the largest part of the root set
+  // of a collection. Must be called at a safepoint.
+  static size_t root_set_words();
+
   // Return number of GC threads to use in the next concurrent GC phase.
   static int calc_active_conc_workers(uintx total_workers,
                                       uintx active_workers,
@@ -87,6 +87,11 @@ void GCTracer::report_gc_reference_stats(const ReferenceProcessorStats& rps) con
   send_reference_stats_event(REF_WEAK, rps.weak_count());
   send_reference_stats_event(REF_FINAL, rps.final_count());
   send_reference_stats_event(REF_PHANTOM, rps.phantom_count());
+
+  send_reference_processing_event(REF_SOFT, rps.phase_times(REF_SOFT));
+  send_reference_processing_event(REF_WEAK, rps.phase_times(REF_WEAK));
+  send_reference_processing_event(REF_FINAL, rps.phase_times(REF_FINAL));
+  send_reference_processing_event(REF_PHANTOM, rps.phase_times(REF_PHANTOM));
 }
 
 #if INCLUDE_SERVICES
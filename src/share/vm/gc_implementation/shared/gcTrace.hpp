@@ -46,6 +46,7 @@ class MetaspaceChunkFreeListSummary;
 class MetaspaceSummary;
 class PSHeapSummary;
 class ReferenceProcessorStats;
+class ReferencePhaseTimes;
 class TimePartitions;
 class BoolObjectClosure;
 
@@ -141,6 +142,7 @@ class GCTracer : public ResourceObj {
   void send_meta_space_summary_event(GCWhen::Type when, const MetaspaceSummary& meta_space_summary) const;
   void send_metaspace_chunk_free_list_summary(GCWhen::Type when, Metaspace::MetadataType mdtype, const MetaspaceChunkFreeListSummary& summary) const;
   void send_reference_stats_event(ReferenceType type, size_t count) const;
+  void send_reference_processing_event(ReferenceType type, const ReferencePhaseTimes& times) const;
   void send_phase_events(TimePartitions* time_partitions) const;
 };
 
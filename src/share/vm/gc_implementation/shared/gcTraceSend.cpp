@@ -28,6 +28,7 @@
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcWhen.hpp"
 #include "gc_implementation/shared/copyFailedInfo.hpp"
+#include "memory/referenceProcessorStats.hpp"
 #include "runtime/os.hpp"
 #include "trace/tracing.hpp"
 #include "trace/traceBackend.hpp"
@@ -64,6 +65,19 @@ void GCTracer::send_reference_stats_event(ReferenceType type, size_t count) cons
   }
 }
 
+void GCTracer::send_reference_processing_event(ReferenceType type, const ReferencePhaseTimes& times) const {
+  EventGCReferenceProcessing e;
+  if (e.should_commit()) {
+      e.set_gcId(_shared_gc_info.gc_id().id());
+      e.set_type((u1)type);
+      e.set_workers(times.workers());
+      e.set_phase1(times.phase1());
+      e.set_phase2(times.phase2());
+      e.set_phase3(times.phase3());
+      e.commit();
+  }
+}
+
 void GCTracer::send_metaspace_chunk_free_list_summary(GCWhen::Type when, Metaspace::MetadataType mdtype,
                                                       const MetaspaceChunkFreeListSummary& summary) const {
   EventMetaspaceChunkFreeListSummary e;
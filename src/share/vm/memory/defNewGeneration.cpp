@@ -37,6 +37,7 @@
 #include "memory/genRemSet.hpp"
 #include "memory/generationSpec.hpp"
 #include "memory/iterator.hpp"
+#include "memory/numaEdenSpace.hpp"
 #include "memory/referencePolicy.hpp"
 #include "memory/space.inline.hpp"
 #include "oops/instanceRefKlass.hpp"
@@ -195,6 +196,8 @@ DefNewGeneration::DefNewGeneration(ReservedSpace rs,
 
   if (GenCollectedHeap::heap()->collector_policy()->has_soft_ended_eden()) {
     _eden_space = new ConcEdenSpace(this);
+  } else if (NUMAEdenSpace::should_use()) {
+    _eden_space = new NUMAEdenSpace(this);
   } else {
     _eden_space = new EdenSpace(this);
   }
@@ -494,6 +497,10 @@ size_t DefNewGeneration::contiguous_available() const {
 }
 
 
+bool DefNewGeneration::supports_inline_contig_alloc() const {
+  return eden()->supports_inline_contig_alloc();
+}
+
 HeapWord** DefNewGeneration::top_addr() const { return eden()->top_addr(); }
 HeapWord** DefNewGeneration::end_addr() const { return eden()->end_addr(); }
 
@@ -1080,6 +1087,10 @@ HeapWord* DefNewGeneration::par_allocate(size_t word_size,
   return res;
 }
 
+void DefNewGeneration::ensure_parsability() {
+  eden()->ensure_parsability();
+}
+
 void DefNewGeneration::gc_prologue(bool full) {
   // Ensure that _end and _soft_end are the same in eden space.
   eden()->set_soft_end(eden()->end());
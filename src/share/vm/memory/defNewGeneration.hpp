@@ -232,7 +232,7 @@ protected:
   size_t max_eden_size() const              { return _max_eden_size; }
   size_t max_survivor_size() const          { return _max_survivor_size; }
 
-  bool supports_inline_contig_alloc() const { return true; }
+  bool supports_inline_contig_alloc() const;
   HeapWord** top_addr() const;
   HeapWord** end_addr() const;
 
@@ -282,6 +282,8 @@ protected:
 
   HeapWord* par_allocate(size_t word_size, bool is_tlab);
 
+  virtual void ensure_parsability();
+
   // Prologue & Epilogue
   virtual void gc_prologue(bool full);
   virtual void gc_epilogue(bool full);
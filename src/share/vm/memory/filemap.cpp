@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoader.hpp"
+#include "classfile/classLoaderExt.hpp"
 #include "classfile/sharedClassUtil.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionaryShared.hpp"
@@ -37,6 +38,11 @@
 #include "runtime/os.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/defaultStream.hpp"
+#include "utilities/macros.hpp"
+#if INCLUDE_ALL_GCS
+#include "gc_implementation/g1/g1CollectedHeap.hpp"
+#include "gc_implementation/g1/heapRegion.hpp"
+#endif // INCLUDE_ALL_GCS
 
 # include <sys/stat.h>
 # include <errno.h>
@@ -167,6 +173,20 @@ void FileMapInfo::FileMapHeader::populate(FileMapInfo* mapinfo, size_t alignment
   _classpath_entry_table_size = mapinfo->_classpath_entry_table_size;
   _classpath_entry_table = mapinfo->_classpath_entry_table;
   _classpath_entry_size = mapinfo->_classpath_entry_size;
+  _ext_class_paths_start = MIN2(ClassLoaderExt::ext_class_paths_start(), _classpath_entry_table_size);
+  _app_class_paths_start = MIN2(ClassLoaderExt::app_class_paths_start(), _classpath_entry_table_size);
+
+  // The hp region is only written if heap objects were archived.
+  memset(&_space[MetaspaceShared::hp], 0, sizeof(_space[MetaspaceShared::hp]));
+  _narrow_oop_base = Universe::narrow_oop_base();
+  _narrow_oop_shift = Universe::narrow_oop_shift();
+  _narrow_klass_base = Universe::narrow_klass_base();
+  _narrow_klass_shift = Universe::narrow_klass_shift();
+#if INCLUDE_ALL_GCS
+  _heap_region_size = UseG1GC ? HeapRegion::GrainBytes : 0;
+#else
+  _heap_region_size = 0;
+#endif
 
   // The following fields are for sanity checks for whether this archive
   // will function correctly with this JVM and the bootclasspath it's
@@ -214,7 +234,7 @@ void FileMapInfo::allocate_classpath_entry_table() {
           }
 
           EXCEPTION_MARK; // The following call should never throw, but would exit VM on error.
-          SharedClassUtil::update_shared_classpath(cpe, ent, st.st_mtime, st.st_size, THREAD);
+          SharedClassUtil::update_shared_classpath(cpe, cur_entry, ent, st.st_mtime, st.st_size, THREAD);
         } else {
           ent->_filesize  = -1;
           if (!os::dir_is_empty(name)) {
@@ -295,6 +315,8 @@ bool FileMapInfo::validate_classpath_entry_table() {
   }
 
   _classpath_entry_table_size = _header->_classpath_entry_table_size;
+  ClassLoaderExt::set_class_paths_start(_header->_ext_class_paths_start,
+                                        _header->_app_class_paths_start);
   _validating_classpath_entry_table = false;
   return true;
 }
@@ -331,7 +353,10 @@ bool FileMapInfo::init_from_file(int fd) {
 
   size_t len = lseek(fd, 0, SEEK_END);
   struct FileMapInfo::FileMapHeader::space_info* si =
-    &_header->_space[MetaspaceShared::mc];
+    &_header->_space[MetaspaceShared::hp];
+  if (si->_used == 0) {
+    si = &_header->_space[MetaspaceShared::mc];
+  }
   if (si->_file_offset >= len || len - si->_file_offset < si->_used) {
     fail_continue("The shared archive file has been truncated.");
     return false;
@@ -552,7 +577,7 @@ ReservedSpace FileMapInfo::reserve_shared_memory() {
 }
 
 // Memory map a region in the address space.
-static const char* shared_region_name[] = { "ReadOnly", "ReadWrite", "MiscData", "MiscCode"};
+static const char* shared_region_name[] = { "ReadOnly", "ReadWrite", "MiscData", "MiscCode", "HeapObjects"};
 
 char* FileMapInfo::map_region(int i) {
   struct FileMapInfo::FileMapHeader::space_info* si = &_header->_space[i];
@@ -603,6 +628,67 @@ void FileMapInfo::unmap_region(int i) {
 }
 
 
+// Map the archived Java heap objects into archive regions of the G1 heap,
+// at the address they were laid out for at dump time. The objects are not
+// used if the heap cannot provide these regions, or if the encoding of
+// their compressed oops and klass pointers or the region size differ.
+//
+// The mapping is private but writable: locking and the full collector
+// write the mark words of the objects. Pages stay shared until written.
+bool FileMapInfo::map_heap_region() {
+#if INCLUDE_ALL_GCS
+  struct FileMapInfo::FileMapHeader::space_info* si = &_header->_space[MetaspaceShared::hp];
+  if (si->_used == 0 || !MetaspaceShared::is_heap_object_archiving_allowed()) {
+    return false;
+  }
+  if (_header->_narrow_oop_base != Universe::narrow_oop_base() ||
+      _header->_narrow_oop_shift != Universe::narrow_oop_shift() ||
+      _header->_narrow_klass_base != Universe::narrow_klass_base() ||
+      _header->_narrow_klass_shift != Universe::narrow_klass_shift() ||
+      _header->_heap_region_size != HeapRegion::GrainBytes) {
+    if (PrintSharedSpaces) {
+      tty->print_cr("Archived heap objects are not used: the heap layout differs from dump time.");
+    }
+    return false;
+  }
+
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  MemRegion range((HeapWord*)si->_base, si->_used / HeapWordSize);
+  if (!g1h->alloc_archive_regions(range)) {
+    if (PrintSharedSpaces) {
+      tty->print_cr("Archived heap objects are not used: unable to allocate the heap regions at "
+                    PTR_FORMAT, p2i(si->_base));
+    }
+    return false;
+  }
+
+  size_t size = align_size_up(si->_used, os::vm_page_size());
+  char* base = os::map_memory(_fd, _full_path, si->_file_offset,
+                              si->_base, size, false /* read_only */,
+                              false /* allow_exec */);
+  if (base != NULL && VerifySharedSpaces &&
+      ClassLoader::crc32(0, base, (jint)si->_used) != si->_crc) {
+    // Put ordinary heap memory back in place of the mapping.
+    os::commit_memory_or_exit(base, size, false, "archived heap objects");
+    base = NULL;
+  }
+  if (base == NULL || base != si->_base) {
+    if (PrintSharedSpaces) {
+      tty->print_cr("Archived heap objects are not used: unable to map the %s shared space.",
+                    shared_region_name[MetaspaceShared::hp]);
+    }
+    g1h->dealloc_archive_regions(range);
+    return false;
+  }
+
+  g1h->fill_archive_regions(range);
+  MetaspaceShared::set_archive_heap_region_mapped();
+  return true;
+#else
+  return false;
+#endif // INCLUDE_ALL_GCS
+}
+
 void FileMapInfo::assert_mark(bool check) {
   if (!check) {
     fail_stop("Mark mismatch while restoring from shared file.", NULL);
@@ -724,7 +810,7 @@ bool FileMapInfo::validate_header() {
 // Return:
 // True if the p is within the mapped shared space, otherwise, false.
 bool FileMapInfo::is_in_shared_space(const void* p) {
-  for (int i = 0; i < MetaspaceShared::n_regions; i++) {
+  for (int i = 0; i < MetaspaceShared::n_metadata_regions; i++) {
     if (p >= _header->_space[i]._base &&
         p < _header->_space[i]._base + _header->_space[i]._used) {
       return true;
@@ -736,7 +822,7 @@ bool FileMapInfo::is_in_shared_space(const void* p) {
 
 void FileMapInfo::print_shared_spaces() {
   gclog_or_tty->print_cr("Shared Spaces:");
-  for (int i = 0; i < MetaspaceShared::n_regions; i++) {
+  for (int i = 0; i < MetaspaceShared::n_metadata_regions; i++) {
     struct FileMapInfo::FileMapHeader::space_info* si = &_header->_space[i];
     gclog_or_tty->print("  %s " INTPTR_FORMAT "-" INTPTR_FORMAT,
                         shared_region_name[i],
@@ -749,7 +835,8 @@ void FileMapInfo::stop_sharing_and_unmap(const char* msg) {
   FileMapInfo *map_info = FileMapInfo::current_info();
   if (map_info) {
     map_info->fail_continue(msg);
-    for (int i = 0; i < MetaspaceShared::n_regions; i++) {
+    // The archived heap objects stay mapped, they are part of the Java heap.
+    for (int i = 0; i < MetaspaceShared::n_metadata_regions; i++) {
       if (map_info->_header->_space[i]._base != NULL) {
         map_info->unmap_region(i);
         map_info->_header->_space[i]._base = NULL;
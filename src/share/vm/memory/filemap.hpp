@@ -40,15 +40,24 @@
 static const int JVM_IDENT_MAX = 256;
 
 class Metaspace;
+template <typename T> class Array;
 
 class SharedClassPathEntry VALUE_OBJ_CLASS_SPEC {
 public:
   const char *_name;
   time_t _timestamp;          // jar timestamp,  0 if is directory
   long   _filesize;           // jar file size, -1 if is directory
+  Array<u1>* _manifest;       // manifest of an ext/app jar, NULL otherwise
+  bool   _is_signed;          // ext/app jar whose classes are not archived
   bool is_dir() {
     return _filesize == -1;
   }
+  Array<u1>* manifest() {
+    return _manifest;
+  }
+  bool is_signed() {
+    return _is_signed;
+  }
 };
 
 class FileMapInfo : public CHeapObj<mtInternal> {
@@ -56,7 +65,7 @@ private:
   friend class ManifestStream;
   enum {
     _invalid_version = -1,
-    _current_version = 2
+    _current_version = 4
   };
 
   bool  _file_open;
@@ -102,6 +111,15 @@ public:
       bool   _allow_exec;    // executable code in space?
     } _space[MetaspaceShared::n_regions];
 
+    // The archived heap objects in the hp region contain compressed oops
+    // and klass pointers and must not cross G1 region boundaries, so
+    // they are only used if the following are the same at run time.
+    address _narrow_oop_base;
+    int     _narrow_oop_shift;
+    address _narrow_klass_base;
+    int     _narrow_klass_shift;
+    size_t  _heap_region_size;
+
     // The following fields are all sanity checks for whether this archive
     // will function correctly with this JVM and the bootclasspath it's
     // invoked with.
@@ -135,6 +153,13 @@ public:
     size_t _classpath_entry_size;
     SharedClassPathEntry* _classpath_entry_table;
 
+    // With UseAppCDS the extension and application class paths follow the
+    // boot class path in _classpath_entry_table. These are the indices of
+    // their first entries; both equal _classpath_entry_table_size if the
+    // archive contains boot classes only.
+    int _ext_class_paths_start;
+    int _app_class_paths_start;
+
     virtual bool validate();
     virtual void populate(FileMapInfo* info, size_t alignment);
     int compute_crc();
@@ -186,6 +211,7 @@ public:
   void  write_bytes_aligned(const void* buffer, int count);
   char* map_region(int i);
   void  unmap_region(int i);
+  bool  map_heap_region() NOT_CDS_RETURN_(false);
   bool  verify_region_checksum(int i);
   void  close();
   bool  is_open() { return _file_open; }
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "code/codeBlob.hpp"
 #include "memory/heap.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/os.hpp"
@@ -35,7 +36,8 @@ size_t CodeHeap::header_size() {
 
 // Implementation of Heap
 
-CodeHeap::CodeHeap() {
+CodeHeap::CodeHeap(const char* name, const int code_blob_type)
+  : _name(name), _code_blob_type(code_blob_type) {
   _number_of_committed_segments = 0;
   _number_of_reserved_segments  = 0;
   _segment_size                 = 0;
@@ -43,6 +45,12 @@ CodeHeap::CodeHeap() {
   _next_segment                 = 0;
   _freelist                     = NULL;
   _freelist_segments            = 0;
+  _max_allocated_capacity       = 0;
+}
+
+
+bool CodeHeap::accepts(int code_blob_type) const {
+  return _code_blob_type == CodeBlobType::All || _code_blob_type == code_blob_type;
 }
 
 
@@ -87,30 +95,25 @@ void CodeHeap::on_code_mapping(char* base, size_t size) {
 }
 
 
-bool CodeHeap::reserve(size_t reserved_size, size_t committed_size,
-                       size_t segment_size) {
-  assert(reserved_size >= committed_size, "reserved < committed");
+bool CodeHeap::reserve(ReservedSpace rs, size_t committed_size, size_t segment_size) {
+  assert(rs.size() >= committed_size, "reserved < committed");
   assert(segment_size >= sizeof(FreeBlock), "segment size is too small");
   assert(is_power_of_2(segment_size), "segment_size must be a power of 2");
 
   _segment_size      = segment_size;
   _log2_segment_size = exact_log2(segment_size);
 
-  // Reserve and initialize space for _memory.
+  // Initialize space for _memory. The space has been reserved by the
+  // CodeCache, possibly as a part of a larger reservation.
   size_t page_size = os::vm_page_size();
   if (os::can_execute_large_page_memory()) {
-    page_size = os::page_size_for_region_unaligned(reserved_size, 8);
+    page_size = os::page_size_for_region_unaligned(rs.size(), 8);
   }
 
   const size_t granularity = os::vm_allocation_granularity();
-  const size_t r_align = MAX2(page_size, granularity);
-  const size_t r_size = align_size_up(reserved_size, r_align);
   const size_t c_size = align_size_up(committed_size, page_size);
 
-  const size_t rs_align = page_size == (size_t) os::vm_page_size() ? 0 :
-    MAX2(page_size, granularity);
-  ReservedCodeSpace rs(r_size, rs_align, rs_align > 0);
-  os::trace_page_sizes("code heap", committed_size, reserved_size, page_size,
+  os::trace_page_sizes(_name, committed_size, rs.size(), page_size,
                        rs.base(), rs.size());
   if (!_memory.initialize(rs, c_size)) {
     return false;
@@ -195,6 +198,7 @@ void* CodeHeap::allocate(size_t instance_size, bool is_critical) {
 #ifdef ASSERT
     memset((void *)block->allocated_space(), badCodeHeapNewVal, instance_size);
 #endif
+    _max_allocated_capacity = MAX2(_max_allocated_capacity, allocated_capacity());
     return block->allocated_space();
   }
 
@@ -220,6 +224,7 @@ void* CodeHeap::allocate(size_t instance_size, bool is_critical) {
 #ifdef ASSERT
     memset((void *)b->allocated_space(), badCodeHeapNewVal, instance_size);
 #endif
+    _max_allocated_capacity = MAX2(_max_allocated_capacity, allocated_capacity());
     return b->allocated_space();
   } else {
     return NULL;
@@ -93,6 +93,10 @@ class CodeHeap : public CHeapObj<mtCode> {
   FreeBlock*   _freelist;
   size_t       _freelist_segments;               // No. of segments in freelist
 
+  size_t       _max_allocated_capacity;          // Peak capacity that was allocated during lifetime of the heap
+  const char*  _name;                            // Name of the CodeHeap
+  const int    _code_blob_type;                  // CodeBlobType it contains
+
   // Helper functions
   size_t   size_to_segments(size_t size) const { return (size + _segment_size - 1) >> _log2_segment_size; }
   size_t   segments_to_size(size_t number_of_segments) const { return number_of_segments << _log2_segment_size; }
@@ -122,10 +126,10 @@ class CodeHeap : public CHeapObj<mtCode> {
   void on_code_mapping(char* base, size_t size);
 
  public:
-  CodeHeap();
+  CodeHeap(const char* name, const int code_blob_type);
 
   // Heap extents
-  bool  reserve(size_t reserved_size, size_t committed_size, size_t segment_size);
+  bool  reserve(ReservedSpace rs, size_t committed_size, size_t segment_size);
   void  release();                               // releases all allocated memory
   bool  expand_by(size_t size);                  // expands commited memory by size
   void  shrink_by(size_t size);                  // shrinks commited memory by size
@@ -158,6 +162,13 @@ class CodeHeap : public CHeapObj<mtCode> {
   size_t max_capacity() const;
   size_t allocated_capacity() const;
   size_t unallocated_capacity() const            { return max_capacity() - allocated_capacity(); }
+  size_t max_allocated_capacity() const          { return _max_allocated_capacity; }
+
+  // The CodeBlobType of the code stored in this heap is CodeBlobType::All
+  // if the code cache is not segmented.
+  const char* name() const                       { return _name; }
+  int code_blob_type() const                     { return _code_blob_type; }
+  bool accepts(int code_blob_type) const;        // returns whether code of the given type belongs here
 
 private:
   size_t heap_unallocated_capacity() const;
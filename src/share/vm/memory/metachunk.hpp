@@ -102,7 +102,12 @@ class Metachunk : public Metabase<Metachunk> {
   // Current allocation top.
   MetaWord* _top;
 
-  DEBUG_ONLY(bool _is_tagged_free;)
+  // Set while the chunk is on a free list of the ChunkManager.
+  bool _is_tagged_free;
+
+  // Set while the memory behind the chunk payload has been given back
+  // to the operating system, see ChunkManager::uncommit_chunk().
+  bool _is_uncommitted;
 
   MetaWord* initial_top() const { return (MetaWord*)this + overhead(); }
   MetaWord* top() const         { return _top; }
@@ -138,10 +143,11 @@ class Metachunk : public Metabase<Metachunk> {
   size_t used_word_size() const;
   size_t free_word_size() const;
 
-#ifdef ASSERT
   bool is_tagged_free() { return _is_tagged_free; }
   void set_is_tagged_free(bool v) { _is_tagged_free = v; }
-#endif
+
+  bool is_uncommitted() { return _is_uncommitted; }
+  void set_is_uncommitted(bool v) { _is_uncommitted = v; }
 
   bool contains(const void* ptr) { return bottom() <= ptr && ptr < _top; }
 
@@ -45,6 +45,7 @@
 #include "runtime/orderAccess.inline.hpp"
 #include "services/memTracker.hpp"
 #include "services/memoryService.hpp"
+#include "utilities/bitMap.inline.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/debug.hpp"
 
@@ -112,6 +113,9 @@ class ChunkManager : public CHeapObj<mtInternal> {
   size_t _free_chunks_total;
   size_t _free_chunks_count;
 
+  // Part of _free_chunks_total which has been uncommitted.
+  size_t _free_chunks_uncommitted_words;
+
   void dec_free_chunks_total(size_t v) {
     assert(_free_chunks_count > 0 &&
              _free_chunks_total > 0,
@@ -143,7 +147,7 @@ class ChunkManager : public CHeapObj<mtInternal> {
  public:
 
   ChunkManager(size_t specialized_size, size_t small_size, size_t medium_size)
-      : _free_chunks_total(0), _free_chunks_count(0) {
+      : _free_chunks_total(0), _free_chunks_count(0), _free_chunks_uncommitted_words(0) {
     _free_chunks[SpecializedIndex].set_size(specialized_size);
     _free_chunks[SmallIndex].set_size(small_size);
     _free_chunks[MediumIndex].set_size(medium_size);
@@ -164,6 +168,30 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // of type index.
   void return_chunks(ChunkIndex index, Metachunk* chunks);
 
+  // Add a single chunk, which is not counted by its container, to the
+  // freelist for its size and to the totals.
+  void return_single_chunk(Metachunk* chunk);
+
+  // Chunks smaller than a humongous chunk are placed at a multiple of
+  // their size from the bottom of their VirtualSpaceNode. A free chunk is
+  // merged with its neighbours if all chunks in the surrounding area of a
+  // medium or small chunk are free. Returns the chunk which contains the
+  // given one afterwards.
+  Metachunk* coalesce_free_chunk(Metachunk* chunk);
+
+  // Take a larger free chunk off its list and split it into a chunk of
+  // word_size, which is returned, and free chunks for the rest.
+  Metachunk* split_larger_chunk(size_t word_size);
+
+  // Divide [start, end) of the node into free chunks which are aligned
+  // to their size, and add them to the freelists.
+  void carve_free_chunks(VirtualSpaceNode* node, MetaWord* start, MetaWord* end);
+
+  // The memory of free medium and humongous chunks is returned to the
+  // operating system until the chunk is handed out again.
+  void uncommit_chunk(Metachunk* chunk);
+  bool commit_chunk(Metachunk* chunk);
+
   // Total of the space in the free chunks list
   size_t free_chunks_total_words();
   size_t free_chunks_total_bytes();
@@ -171,6 +199,9 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // Number of chunks in the free chunks list
   size_t free_chunks_count();
 
+  // Uncommitted space in the free chunks list
+  size_t free_chunks_uncommitted_words() const { return _free_chunks_uncommitted_words; }
+
   void inc_free_chunks_total(size_t v, size_t count = 1) {
     Atomic::add_ptr(count, &_free_chunks_count);
     Atomic::add_ptr(v, &_free_chunks_total);
@@ -248,6 +279,10 @@ class ChunkManager : public CHeapObj<mtInternal> {
   void locked_print_sum_free_chunks(outputStream* st);
 
   void print_on(outputStream* st) const;
+
+  // Print the free chunk counts, the uncommitted part and the share of
+  // the free space held in chunks smaller than a medium chunk.
+  void print_fragmentation_on(outputStream* st) const;
 };
 
 // Used to manage the free list of Metablocks (a block corresponds
@@ -296,6 +331,16 @@ class VirtualSpaceNode : public CHeapObj<mtClass> {
   // count of chunks contained in this VirtualSpace
   uintx _container_count;
 
+  // Is this node part of the compressed class space
+  bool _is_class;
+
+  // One bit per smallest chunk size, set where a chunk starts.
+  BitMap _chunk_starts;
+  BitMap::bm_word_t* _chunk_starts_map;
+
+  // Committed memory of free chunks given back to the operating system
+  size_t _uncommitted_words;
+
   // Convenience functions to access the _virtual_space
   char* low()  const { return virtual_space()->low(); }
   char* high() const { return virtual_space()->high(); }
@@ -309,7 +354,8 @@ class VirtualSpaceNode : public CHeapObj<mtClass> {
  public:
 
   VirtualSpaceNode(size_t byte_size);
-  VirtualSpaceNode(ReservedSpace rs) : _top(NULL), _next(NULL), _rs(rs), _container_count(0) {}
+  VirtualSpaceNode(ReservedSpace rs) : _top(NULL), _next(NULL), _rs(rs), _container_count(0),
+                                       _is_class(true), _chunk_starts_map(NULL), _uncommitted_words(0) {}
   ~VirtualSpaceNode();
 
   // Convenience functions for logical bottom and end
@@ -319,10 +365,18 @@ class VirtualSpaceNode : public CHeapObj<mtClass> {
   bool contains(const void* ptr) { return ptr >= low() && ptr < high(); }
 
   size_t reserved_words() const  { return _virtual_space.reserved_size() / BytesPerWord; }
-  size_t committed_words() const { return _virtual_space.actual_committed_size() / BytesPerWord; }
+  size_t committed_words() const {
+    return _virtual_space.actual_committed_size() / BytesPerWord - _uncommitted_words;
+  }
 
   bool is_pre_committed() const { return _virtual_space.special(); }
 
+  bool is_class() const { return _is_class; }
+
+  // The list and the chunk manager this node belongs to
+  VirtualSpaceList* space_list() const;
+  ChunkManager* chunk_manager() const;
+
   // address of next available space in _virtual_space;
   // Accessors
   VirtualSpaceNode* next() { return _next; }
@@ -341,6 +395,29 @@ class VirtualSpaceNode : public CHeapObj<mtClass> {
   MetaWord* top() const { return _top; }
   void inc_top(size_t word_size) { _top += word_size; }
 
+  // Chunk placement relative to the bottom of the node
+  bool is_aligned_in_node(MetaWord* p, size_t word_alignment) const {
+    return is_size_aligned(pointer_delta(p, bottom(), sizeof(MetaWord)), word_alignment);
+  }
+  MetaWord* align_down_in_node(MetaWord* p, size_t word_alignment) const {
+    size_t offset = pointer_delta(p, bottom(), sizeof(MetaWord));
+    return bottom() + align_size_down(offset, word_alignment);
+  }
+  // Words to skip at top so that a chunk of the given size is aligned.
+  size_t padding_words_for(size_t chunk_word_size) const;
+
+  BitMap::idx_t chunk_start_index(MetaWord* p) const;
+  bool is_chunk_start(MetaWord* p) const { return _chunk_starts.at(chunk_start_index(p)); }
+  void set_chunk_start(MetaWord* p)      { _chunk_starts.set_bit(chunk_start_index(p)); }
+  void clear_chunk_start(MetaWord* p)    { _chunk_starts.clear_bit(chunk_start_index(p)); }
+
+  // Uncommit or commit the part of the payload of a free chunk which
+  // covers whole commit granules.  Return the number of words, 0 if
+  // nothing was done.
+  size_t uncommit_chunk(Metachunk* chunk);
+  size_t commit_chunk(Metachunk* chunk);
+  size_t uncommittable_words(Metachunk* chunk) const;
+
   uintx container_count() { return _container_count; }
   void inc_container_count();
   void dec_container_count();
@@ -410,7 +487,8 @@ static bool should_commit_large_pages_when_reserving(size_t bytes) {
 }
 
   // byte_size is the size of the associated virtualspace.
-VirtualSpaceNode::VirtualSpaceNode(size_t bytes) : _top(NULL), _next(NULL), _rs(), _container_count(0) {
+VirtualSpaceNode::VirtualSpaceNode(size_t bytes) : _top(NULL), _next(NULL), _rs(), _container_count(0),
+                                                    _is_class(false), _chunk_starts_map(NULL), _uncommitted_words(0) {
   assert_is_size_aligned(bytes, Metaspace::reserve_alignment());
 
 #if INCLUDE_CDS
@@ -887,6 +965,9 @@ void BlockFreelist::print_on(outputStream* st) const {
 // VirtualSpaceNode methods
 
 VirtualSpaceNode::~VirtualSpaceNode() {
+  if (_chunk_starts_map != NULL) {
+    FREE_C_HEAP_ARRAY(BitMap::bm_word_t, _chunk_starts_map, mtClass);
+  }
   _rs.release();
 #ifdef ASSERT
   size_t word_size = sizeof(*this) / BytesPerWord;
@@ -907,6 +988,95 @@ size_t VirtualSpaceNode::free_words_in_vs() const {
   return pointer_delta(end(), top(), sizeof(MetaWord));
 }
 
+VirtualSpaceList* VirtualSpaceNode::space_list() const {
+  return Metaspace::get_space_list(is_class() ? Metaspace::ClassType : Metaspace::NonClassType);
+}
+
+ChunkManager* VirtualSpaceNode::chunk_manager() const {
+  return Metaspace::get_chunk_manager(is_class() ? Metaspace::ClassType : Metaspace::NonClassType);
+}
+
+size_t VirtualSpaceNode::padding_words_for(size_t chunk_word_size) const {
+  if (chunk_word_size > SpaceManager::medium_chunk_size(is_class())) {
+    // Humongous chunks only keep the alignment to the smallest chunk size.
+    return 0;
+  }
+  assert(is_power_of_2(chunk_word_size),
+         err_msg("Chunk size " SIZE_FORMAT " is not a power of 2", chunk_word_size));
+  size_t offset = pointer_delta(top(), bottom(), sizeof(MetaWord));
+  return align_size_up(offset, chunk_word_size) - offset;
+}
+
+BitMap::idx_t VirtualSpaceNode::chunk_start_index(MetaWord* p) const {
+  size_t smallest = SpaceManager::smallest_chunk_size(is_class());
+  assert(is_aligned_in_node(p, smallest),
+         err_msg(PTR_FORMAT " is not at a chunk boundary", p));
+  return pointer_delta(p, bottom(), sizeof(MetaWord)) / smallest;
+}
+
+// The chunk header stays committed, so that the chunks of the node can
+// still be walked.
+static void uncommittable_range(Metachunk* chunk, char** start, char** end) {
+  *start = (char*)align_ptr_up(chunk->bottom() + Metachunk::overhead(), Metaspace::commit_alignment());
+  *end = (char*)align_ptr_down(chunk->end(), Metaspace::commit_alignment());
+}
+
+size_t VirtualSpaceNode::uncommittable_words(Metachunk* chunk) const {
+  char* start;
+  char* end;
+  uncommittable_range(chunk, &start, &end);
+  return start < end ? pointer_delta(end, start, 1) / BytesPerWord : 0;
+}
+
+size_t VirtualSpaceNode::uncommit_chunk(Metachunk* chunk) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  assert(chunk->is_tagged_free() && !chunk->is_uncommitted(), "Only committed free chunks");
+  assert(!is_pre_committed(), "Pre-committed memory is not uncommitted");
+
+  char* start;
+  char* end;
+  uncommittable_range(chunk, &start, &end);
+  if (start >= end) {
+    return 0;
+  }
+  size_t bytes = pointer_delta(end, start, 1);
+  if (!os::uncommit_memory(start, bytes)) {
+    return 0;
+  }
+
+  size_t words = bytes / BytesPerWord;
+  _uncommitted_words += words;
+  space_list()->dec_committed_words(words);
+  chunk->set_is_uncommitted(true);
+  return words;
+}
+
+size_t VirtualSpaceNode::commit_chunk(Metachunk* chunk) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  assert(chunk->is_uncommitted(), "Only uncommitted chunks");
+
+  char* start;
+  char* end;
+  uncommittable_range(chunk, &start, &end);
+  size_t bytes = pointer_delta(end, start, 1);
+  size_t words = bytes / BytesPerWord;
+
+  // The memory counts against the metaspace limits again.
+  if (!MetaspaceGC::can_expand(words, is_class()) ||
+      MetaspaceGC::allowed_expansion() < words) {
+    return 0;
+  }
+  if (!os::commit_memory(start, bytes, Metaspace::commit_alignment(), false)) {
+    return 0;
+  }
+
+  assert(_uncommitted_words >= words, "Inconsistency");
+  _uncommitted_words -= words;
+  space_list()->inc_committed_words(words);
+  chunk->set_is_uncommitted(false);
+  return words;
+}
+
 // Allocates the chunk from the virtual space only.
 // This interface is also used internally for debugging.  Not all
 // chunks removed here are necessarily used for allocation.
@@ -921,7 +1091,11 @@ Metachunk* VirtualSpaceNode::take_from_committed(size_t chunk_word_size) {
   assert(_virtual_space.committed_size() == _virtual_space.actual_committed_size(),
       "The committed memory doesn't match the expanded memory.");
 
-  if (!is_available(chunk_word_size)) {
+  // Chunks smaller than a humongous chunk are aligned to their size.  The
+  // space skipped for that is added to the freelists as smaller chunks.
+  size_t padding = padding_words_for(chunk_word_size);
+
+  if (!is_available(padding + chunk_word_size)) {
     if (TraceMetadataChunkAllocation) {
       gclog_or_tty->print("VirtualSpaceNode::take_from_committed() not available %d words ", chunk_word_size);
       // Dump some information about the virtual space that is nearly full
@@ -930,11 +1104,18 @@ Metachunk* VirtualSpaceNode::take_from_committed(size_t chunk_word_size) {
     return NULL;
   }
 
+  if (padding > 0) {
+    chunk_manager()->carve_free_chunks(this, chunk_limit, chunk_limit + padding);
+    inc_top(padding);
+    chunk_limit = top();
+  }
+
   // Take the space  (bump top on the current virtual space).
   inc_top(chunk_word_size);
 
   // Initialize the chunk
   Metachunk* result = ::new (chunk_limit) Metachunk(chunk_word_size, this);
+  set_chunk_start(chunk_limit);
   return result;
 }
 
@@ -991,6 +1172,13 @@ bool VirtualSpaceNode::initialize() {
         "Checking that the pre-committed memory was registered by the VirtualSpace");
 
     set_top((MetaWord*)virtual_space()->low());
+
+    BitMap::idx_t bits = reserved_words() / SpaceManager::smallest_chunk_size(is_class());
+    BitMap::idx_t map_words = BitMap::word_align_up(bits) / BitsPerWord;
+    _chunk_starts_map = NEW_C_HEAP_ARRAY(BitMap::bm_word_t, map_words, mtClass);
+    _chunk_starts.set_map(_chunk_starts_map);
+    _chunk_starts.set_size(bits);
+    _chunk_starts.clear();
     set_reserved(MemRegion((HeapWord*)_rs.base(),
                  (HeapWord*)(_rs.base() + _rs.size())));
 
@@ -1085,6 +1273,146 @@ void ChunkManager::remove_chunk(Metachunk* chunk) {
 
   // Chunk is being removed from the chunks free list.
   dec_free_chunks_total(chunk->word_size());
+
+  if (chunk->is_uncommitted()) {
+    // Only happens when the node is purged.
+    _free_chunks_uncommitted_words -= chunk->container()->uncommittable_words(chunk);
+  }
+}
+
+void ChunkManager::return_single_chunk(Metachunk* chunk) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  chunk->set_is_tagged_free(true);
+  ChunkIndex index = list_index(chunk->word_size());
+  if (index != HumongousIndex) {
+    free_chunks(index)->return_chunk_at_head(chunk);
+  } else {
+    humongous_dictionary()->return_chunk(chunk);
+  }
+  inc_free_chunks_total(chunk->word_size());
+}
+
+void ChunkManager::carve_free_chunks(VirtualSpaceNode* node, MetaWord* start, MetaWord* end) {
+  MetaWord* p = start;
+  while (p < end) {
+    // The largest chunk that is aligned at p and fits.
+    ChunkIndex index = MediumIndex;
+    size_t chunk_size = free_chunks(index)->size();
+    while (!node->is_aligned_in_node(p, chunk_size) || p + chunk_size > end) {
+      assert(index > ZeroIndex, "The range should be a multiple of the smallest chunk size");
+      index = (ChunkIndex)(index - 1);
+      chunk_size = free_chunks(index)->size();
+    }
+    Metachunk* chunk = ::new (p) Metachunk(chunk_size, node);
+    node->set_chunk_start(p);
+    return_single_chunk(chunk);
+    p += chunk_size;
+  }
+}
+
+Metachunk* ChunkManager::coalesce_free_chunk(Metachunk* chunk) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  assert(chunk->is_tagged_free(), "Only free chunks are merged");
+
+  VirtualSpaceNode* node = chunk->container();
+  ChunkIndex index = list_index(chunk->word_size());
+
+  // Try the largest area first, so that small chunks are not merged twice.
+  for (int i = (int)MediumIndex; i > (int)index; --i) {
+    size_t merged_size = free_chunks((ChunkIndex)i)->size();
+    MetaWord* start = node->align_down_in_node(chunk->bottom(), merged_size);
+    MetaWord* end = start + merged_size;
+    if (end > node->top() || !node->is_chunk_start(start)) {
+      continue;
+    }
+
+    // Chunks smaller than the area are aligned to their size, so they
+    // cannot cross its end.
+    bool all_free = true;
+    for (MetaWord* p = start; p < end; ) {
+      Metachunk* c = (Metachunk*)p;
+      if (!c->is_tagged_free() || c->word_size() >= merged_size) {
+        all_free = false;
+        break;
+      }
+      p += c->word_size();
+    }
+    if (!all_free) {
+      continue;
+    }
+
+    for (MetaWord* p = start; p < end; ) {
+      Metachunk* c = (Metachunk*)p;
+      p += c->word_size();
+      remove_chunk(c);
+      node->clear_chunk_start((MetaWord*)c);
+    }
+    Metachunk* merged = ::new (start) Metachunk(merged_size, node);
+    node->set_chunk_start(start);
+    return_single_chunk(merged);
+
+    if (TraceMetadataChunkAllocation && Verbose) {
+      gclog_or_tty->print_cr("ChunkManager::coalesce_free_chunk: merged " PTR_FORMAT
+                             " into " PTR_FORMAT " size " SIZE_FORMAT,
+                             chunk, merged, merged_size);
+    }
+    return merged;
+  }
+  return chunk;
+}
+
+Metachunk* ChunkManager::split_larger_chunk(size_t word_size) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  for (int i = (int)list_index(word_size) + 1; i <= (int)MediumIndex; ++i) {
+    Metachunk* larger = free_chunks((ChunkIndex)i)->head();
+    if (larger == NULL || !commit_chunk(larger)) {
+      continue;
+    }
+    remove_chunk(larger);
+
+    VirtualSpaceNode* node = larger->container();
+    MetaWord* end = (MetaWord*)larger->end();
+    Metachunk* chunk = ::new (larger->bottom()) Metachunk(word_size, node);
+    carve_free_chunks(node, chunk->bottom() + word_size, end);
+
+    if (TraceMetadataChunkAllocation && Verbose) {
+      gclog_or_tty->print_cr("ChunkManager::split_larger_chunk: split " PTR_FORMAT
+                             " size " SIZE_FORMAT " for size " SIZE_FORMAT,
+                             chunk, pointer_delta(end, chunk->bottom(), sizeof(MetaWord)),
+                             word_size);
+    }
+    return chunk;
+  }
+  return NULL;
+}
+
+void ChunkManager::uncommit_chunk(Metachunk* chunk) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  if (!MetaspaceUncommitFreeChunks || DumpSharedSpaces) {
+    // The archive is written from the committed metaspace.
+    return;
+  }
+  VirtualSpaceNode* node = chunk->container();
+  if (chunk->is_uncommitted() ||
+      node->is_pre_committed() ||
+      chunk->word_size() < free_chunks(MediumIndex)->size()) {
+    return;
+  }
+  _free_chunks_uncommitted_words += node->uncommit_chunk(chunk);
+}
+
+bool ChunkManager::commit_chunk(Metachunk* chunk) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  if (!chunk->is_uncommitted()) {
+    return true;
+  }
+  size_t words = chunk->container()->commit_chunk(chunk);
+  if (words == 0) {
+    return false;
+  }
+  assert(_free_chunks_uncommitted_words >= words, "About to go negative");
+  _free_chunks_uncommitted_words -= words;
+  return true;
 }
 
 // Walk the list of VirtualSpaceNodes and delete
@@ -1164,20 +1492,12 @@ void VirtualSpaceList::retire_current_virtual_space() {
 }
 
 void VirtualSpaceNode::retire(ChunkManager* chunk_manager) {
-  for (int i = (int)MediumIndex; i >= (int)ZeroIndex; --i) {
-    ChunkIndex index = (ChunkIndex)i;
-    size_t chunk_size = chunk_manager->free_chunks(index)->size();
-
-    while (free_words_in_vs() >= chunk_size) {
-      DEBUG_ONLY(verify_container_count();)
-      Metachunk* chunk = get_chunk_vs(chunk_size);
-      assert(chunk != NULL, "allocation should have been successful");
-
-      chunk_manager->return_chunks(index, chunk);
-      chunk_manager->inc_free_chunks_total(chunk_size);
-      DEBUG_ONLY(verify_container_count();)
-    }
-  }
+  assert_lock_strong(SpaceManager::expand_lock());
+  DEBUG_ONLY(verify_container_count();)
+  MetaWord* limit = end();
+  chunk_manager->carve_free_chunks(this, top(), limit);
+  set_top(limit);
+  DEBUG_ONLY(verify_container_count();)
   assert(free_words_in_vs() == 0, "should be empty now");
 }
 
@@ -1341,7 +1661,8 @@ Metachunk* VirtualSpaceList::get_new_chunk(size_t chunk_word_size, size_t sugges
   // The expand amount is currently only determined by the requested sizes
   // and not how much committed memory is left in the current virtual space.
 
-  size_t min_word_size       = align_size_up(chunk_word_size,              Metaspace::commit_alignment_words());
+  size_t padding             = current_virtual_space()->padding_words_for(chunk_word_size);
+  size_t min_word_size       = align_size_up(padding + chunk_word_size,    Metaspace::commit_alignment_words());
   size_t preferred_word_size = align_size_up(suggested_commit_granularity, Metaspace::commit_alignment_words());
   if (min_word_size >= preferred_word_size) {
     // Can happen when humongous chunks are allocated.
@@ -1830,16 +2151,27 @@ Metachunk* ChunkManager::free_chunks_get(size_t word_size) {
     chunk = free_list->head();
 
     if (chunk == NULL) {
-      return NULL;
-    }
+      // Split a larger free chunk before committing more memory.
+      chunk = split_larger_chunk(word_size);
+      if (chunk == NULL) {
+        return NULL;
+      }
+    } else {
+      if (!commit_chunk(chunk)) {
+        return NULL;
+      }
 
-    // Remove the chunk as the head of the list.
-    free_list->remove_chunk(chunk);
+      // Remove the chunk as the head of the list.
+      free_list->remove_chunk(chunk);
 
-    if (TraceMetadataChunkAllocation && Verbose) {
-      gclog_or_tty->print_cr("ChunkManager::free_chunks_get: free_list "
-                             PTR_FORMAT " head " PTR_FORMAT " size " SIZE_FORMAT,
-                             free_list, chunk, chunk->word_size());
+      if (TraceMetadataChunkAllocation && Verbose) {
+        gclog_or_tty->print_cr("ChunkManager::free_chunks_get: free_list "
+                               PTR_FORMAT " head " PTR_FORMAT " size " SIZE_FORMAT,
+                               free_list, chunk, chunk->word_size());
+      }
+
+      // Chunk is being removed from the chunks free list.
+      dec_free_chunks_total(chunk->word_size());
     }
   } else {
     chunk = humongous_dictionary()->get_chunk(
@@ -1850,6 +2182,11 @@ Metachunk* ChunkManager::free_chunks_get(size_t word_size) {
       return NULL;
     }
 
+    if (!commit_chunk(chunk)) {
+      humongous_dictionary()->return_chunk(chunk);
+      return NULL;
+    }
+
     if (TraceMetadataHumongousAllocation) {
       size_t waste = chunk->word_size() - word_size;
       gclog_or_tty->print_cr("Free list allocate humongous chunk size "
@@ -1857,19 +2194,17 @@ Metachunk* ChunkManager::free_chunks_get(size_t word_size) {
                              " waste " SIZE_FORMAT,
                              chunk->word_size(), word_size, waste);
     }
-  }
 
-  // Chunk is being removed from the chunks free list.
-  dec_free_chunks_total(chunk->word_size());
+    // Chunk is being removed from the chunks free list.
+    dec_free_chunks_total(chunk->word_size());
+  }
 
   // Remove it from the links to this freelist
   chunk->set_next(NULL);
   chunk->set_prev(NULL);
-#ifdef ASSERT
-  // Chunk is no longer on any freelist. Setting to false make container_count_slow()
-  // work.
+  // Chunk is no longer on any freelist. Setting to false keeps it from
+  // being merged and makes container_count_slow() work.
   chunk->set_is_tagged_free(false);
-#endif
   chunk->container()->inc_container_count();
 
   slow_locked_verify();
@@ -1912,6 +2247,22 @@ void ChunkManager::print_on(outputStream* out) const {
   }
 }
 
+void ChunkManager::print_fragmentation_on(outputStream* st) const {
+  size_t small_bytes = size_free_chunks_in_bytes(SpecializedIndex) +
+                       size_free_chunks_in_bytes(SmallIndex);
+  size_t total_bytes = small_bytes +
+                       size_free_chunks_in_bytes(MediumIndex) +
+                       size_free_chunks_in_bytes(HumongousIndex);
+  size_t count = num_free_chunks(SpecializedIndex) + num_free_chunks(SmallIndex) +
+                 num_free_chunks(MediumIndex) + num_free_chunks(HumongousIndex);
+  st->print_cr("free chunks "    SIZE_FORMAT " (" SIZE_FORMAT "K), "
+               "uncommitted "    SIZE_FORMAT "K, "
+               "fragmentation "  SIZE_FORMAT "%%",
+               count, total_bytes/K,
+               free_chunks_uncommitted_words() * BytesPerWord/K,
+               total_bytes == 0 ? 0 : small_bytes * 100 / total_bytes);
+}
+
 // SpaceManager methods
 
 size_t SpaceManager::adjust_initial_chunk_size(size_t requested, bool is_class_space) {
@@ -2266,8 +2617,11 @@ void ChunkManager::return_chunks(ChunkIndex index, Metachunk* chunks) {
     // Capture the next link before it is changed
     // by the call to return_chunk_at_head();
     Metachunk* next = cur->next();
-    DEBUG_ONLY(cur->set_is_tagged_free(true);)
+    cur->set_is_tagged_free(true);
     list->return_chunk_at_head(cur);
+    // Merge it with its free neighbours and give the memory back if the
+    // result is large enough.
+    uncommit_chunk(coalesce_free_chunk(cur));
     cur = next;
   }
 }
@@ -2337,9 +2691,7 @@ SpaceManager::~SpaceManager() {
   Metachunk* humongous_chunks = chunks_in_use(HumongousIndex);
 
   while (humongous_chunks != NULL) {
-#ifdef ASSERT
     humongous_chunks->set_is_tagged_free(true);
-#endif
     if (TraceMetadataChunkAllocation && Verbose) {
       gclog_or_tty->print(PTR_FORMAT " (" SIZE_FORMAT ") ",
                           humongous_chunks,
@@ -2354,6 +2706,7 @@ SpaceManager::~SpaceManager() {
     Metachunk* next_humongous_chunks = humongous_chunks->next();
     humongous_chunks->container()->dec_container_count();
     chunk_manager()->humongous_dictionary()->return_chunk(humongous_chunks);
+    chunk_manager()->uncommit_chunk(humongous_chunks);
     humongous_chunks = next_humongous_chunks;
   }
   if (TraceMetadataChunkAllocation && Verbose) {
@@ -2817,6 +3170,10 @@ void MetaspaceAux::print_on(outputStream* out) {
                 capacity_bytes()/K,
                 committed_bytes()/K,
                 reserved_bytes()/K);
+  if (has_chunk_free_list(nct)) {
+    out->print("                 ");
+    Metaspace::get_chunk_manager(nct)->print_fragmentation_on(out);
+  }
 
   if (Metaspace::using_class_space()) {
     Metaspace::MetadataType ct = Metaspace::ClassType;
@@ -2829,6 +3186,10 @@ void MetaspaceAux::print_on(outputStream* out) {
                   capacity_bytes(ct)/K,
                   committed_bytes(ct)/K,
                   reserved_bytes(ct)/K);
+    if (has_chunk_free_list(ct)) {
+      out->print("                 ");
+      Metaspace::get_chunk_manager(ct)->print_fragmentation_on(out);
+    }
   }
 }
 
@@ -3934,6 +4295,31 @@ class TestVirtualSpaceNodeTest {
       assert(cm.sum_free_chunks() == words_left, "sizes should add up");
     }
 
+    { // A free medium chunk is split and merged again
+      // The node is not part of a VirtualSpaceList.
+      bool uncommit_free_chunks = MetaspaceUncommitFreeChunks;
+      MetaspaceUncommitFreeChunks = false;
+
+      ChunkManager cm(SpecializedChunk, SmallChunk, MediumChunk);
+      VirtualSpaceNode vsn(vsn_test_size_bytes);
+      vsn.initialize();
+      vsn.expand_by(vsn_test_size_words, vsn_test_size_words);
+      vsn.retire(&cm);
+      assert(cm.sum_free_chunks_count() == 4, "should be space for 4 medium chunks");
+
+      Metachunk* chunk = cm.free_chunks_get(SpecializedChunk);
+      assert(chunk != NULL && chunk->word_size() == SpecializedChunk, "should have split a medium chunk");
+      assert(cm.sum_free_chunks_count() == 3 + (MediumChunk / SmallChunk - 1) + (SmallChunk / SpecializedChunk - 1),
+             "rest of the medium chunk should be free");
+      assert(cm.sum_free_chunks() == vsn_test_size_words - SpecializedChunk, "sizes should add up");
+
+      cm.inc_free_chunks_total(SpecializedChunk);
+      cm.return_chunks(SpecializedIndex, chunk);
+      assert(cm.sum_free_chunks_count() == 4, "should have been merged into a medium chunk");
+      assert(cm.sum_free_chunks() == vsn_test_size_words, "sizes should add up");
+
+      MetaspaceUncommitFreeChunks = uncommit_free_chunks;
+    }
   }
 
 #define assert_is_available_positive(word_size) \
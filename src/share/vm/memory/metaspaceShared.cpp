@@ -55,6 +55,7 @@ bool MetaspaceShared::_check_classes_made_progress;
 bool MetaspaceShared::_has_error_classes;
 bool MetaspaceShared::_archive_loading_failed = false;
 bool MetaspaceShared::_remapped_readwrite = false;
+bool MetaspaceShared::_archive_heap_region_mapped = false;
 // Read/write a data stream for restoring/preserving metadata pointers and
 // miscellaneous data from/to the shared archive file.
 
@@ -539,6 +540,8 @@ void VM_PopulateDumpSharedSpace::doit() {
 
   ClassLoaderExt::copy_lookup_cache_to_archive(&md_top, md_end);
 
+  MemRegion heap_region = StringTable::copy_shared_strings(&md_top, md_end);
+
   // Write the other data to the output array.
   WriteClosure wc(md_top, md_end);
   MetaspaceShared::serialize(&wc);
@@ -583,6 +586,10 @@ void VM_PopulateDumpSharedSpace::doit() {
   tty->print_cr(fmt_space, "mc", mc_bytes, mc_t_perc, mc_alloced, mc_u_perc, mc_low);
   tty->print_cr("total   : %9d [100.0%% of total] out of %9d bytes [%4.1f%% used]",
                  total_bytes, total_alloced, total_u_perc);
+  if (!heap_region.is_empty()) {
+    tty->print_cr("hp space: " SIZE_FORMAT_W(9) " bytes of archived heap objects at " PTR_FORMAT,
+                  heap_region.byte_size(), p2i(heap_region.start()));
+  }
 
   // Update the vtable pointers in all of the Klass objects in the
   // heap. They should point to newly generated vtable.
@@ -610,6 +617,11 @@ void VM_PopulateDumpSharedSpace::doit() {
                         pointer_delta(mc_top, _mc_vs.low(), sizeof(char)),
                         SharedMiscCodeSize,
                         true, true);
+  if (!heap_region.is_empty()) {
+    mapinfo->write_region(MetaspaceShared::hp, (char*)heap_region.start(),
+                          heap_region.byte_size(), heap_region.byte_size(),
+                          false, false);
+  }
 
   // Pass 2 - write data.
   mapinfo->open_for_write();
@@ -625,6 +637,11 @@ void VM_PopulateDumpSharedSpace::doit() {
                         pointer_delta(mc_top, _mc_vs.low(), sizeof(char)),
                         SharedMiscCodeSize,
                         true, true);
+  if (!heap_region.is_empty()) {
+    mapinfo->write_region(MetaspaceShared::hp, (char*)heap_region.start(),
+                          heap_region.byte_size(), heap_region.byte_size(),
+                          false, false);
+  }
   mapinfo->close();
 
   memmove(vtbl_list, saved_vtbl, vtbl_list_size * sizeof(void*));
@@ -652,6 +669,17 @@ void MetaspaceShared::link_one_shared_class(Klass* obj, TRAPS) {
   }
 }
 
+void MetaspaceShared::intern_shared_strings(Klass* k, TRAPS) {
+  if (k->oop_is_instance()) {
+    ConstantPool* cp = InstanceKlass::cast(k)->constants();
+    for (int i = 1; i < cp->length(); i++) {
+      if (cp->tag_at(i).is_string() && !cp->is_pseudo_string_at(i)) {
+        StringTable::intern(cp->unresolved_string_at(i), CHECK);
+      }
+    }
+  }
+}
+
 void MetaspaceShared::check_one_shared_class(Klass* k) {
   if (k->oop_is_instance() && InstanceKlass::cast(k)->check_sharing_error_state()) {
     _check_classes_made_progress = true;
@@ -771,6 +799,12 @@ void MetaspaceShared::preload_and_dump(TRAPS) {
   link_and_cleanup_shared_classes(CATCH);
   tty->print_cr("Rewriting and linking classes: done");
 
+  if (is_heap_object_archiving_allowed()) {
+    // The string constants of the shared classes are archived along with
+    // the other interned strings.
+    SystemDictionary::classes_do(intern_shared_strings, CATCH);
+  }
+
   // Create and dump the shared spaces.   Everything so far is loaded
   // with the null class loader.
   ClassLoaderData* loader_data = ClassLoaderData::the_null_class_loader_data();
@@ -1070,6 +1104,11 @@ void MetaspaceShared::initialize_shared_spaces() {
 
   buffer = ClassLoaderExt::restore_lookup_cache_from_archive(buffer);
 
+  // Map the archived interned strings into the Java heap before their
+  // table is set up.
+  mapinfo->map_heap_region();
+  buffer = StringTable::restore_shared_table(buffer);
+
   intptr_t* array = (intptr_t*)buffer;
   ReadClosure rc(&array);
   serialize(&rc);
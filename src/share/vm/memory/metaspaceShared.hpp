@@ -56,6 +56,7 @@ class MetaspaceShared : AllStatic {
   static bool _has_error_classes;
   static bool _archive_loading_failed;
   static bool _remapped_readwrite;
+  static bool _archive_heap_region_mapped;
  public:
   enum {
     vtbl_list_size         = 17,   // number of entries in the shared space vtable list.
@@ -75,7 +76,9 @@ class MetaspaceShared : AllStatic {
     rw = 1,  // read-write shared space in the heap
     md = 2,  // miscellaneous data for initializing tables, etc.
     mc = 3,  // miscellaneous code - vtable replacement.
-    n_regions = 4
+    n_metadata_regions = 4,
+    hp = 4,  // archived Java heap objects, mapped into the Java heap
+    n_regions = 5
   };
 
   // Accessor functions to save shared space created for metadata, which has
@@ -108,6 +111,22 @@ class MetaspaceShared : AllStatic {
     _archive_loading_failed = true;
   }
   static bool map_shared_spaces(FileMapInfo* mapinfo) NOT_CDS_RETURN_(false);
+
+  // Java heap objects are archived in the hp region only with G1, whose
+  // archive regions keep them in place, and only with compressed oops and
+  // class pointers, whose encodings are recorded in the archive.
+  static bool is_heap_object_archiving_allowed() {
+    CDS_ONLY(return UseG1GC && UseCompressedOops && UseCompressedClassPointers;)
+    NOT_CDS(return false;)
+  }
+  // Whether the hp region of the current archive is mapped into the heap.
+  static bool archive_heap_region_mapped() {
+    CDS_ONLY(return _archive_heap_region_mapped;)
+    NOT_CDS(return false;)
+  }
+  static void set_archive_heap_region_mapped() {
+    CDS_ONLY(_archive_heap_region_mapped = true;)
+  }
   static void initialize_shared_spaces() NOT_CDS_RETURN;
 
   // Return true if given address is in the mapped shared space.
@@ -134,6 +153,7 @@ class MetaspaceShared : AllStatic {
   static bool try_link_class(InstanceKlass* ik, TRAPS);
   static void link_one_shared_class(Klass* obj, TRAPS);
   static void check_one_shared_class(Klass* obj);
+  static void intern_shared_strings(Klass* obj, TRAPS);
   static void link_and_cleanup_shared_classes(TRAPS);
 
   static int count_class(const char* classlist_file);
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_interface/collectedHeap.inline.hpp"
+#include "memory/numaEdenSpace.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.inline.hpp"
+
+NUMAEdenSpace::NUMAEdenSpace(DefNewGeneration* gen) :
+  EdenSpace(gen),
+  _chunks(NULL),
+  _node_ids(NULL),
+  _num_chunks(0),
+  _page_size(UseLargePages ? os::large_page_size() : os::vm_page_size()) {
+  size_t num_node_ids = os::numa_get_groups_num();
+  int* node_ids = NEW_C_HEAP_ARRAY(int, MAX2(num_node_ids, (size_t)1), mtGC);
+  uint num_nodes = (uint)os::numa_get_leaf_groups(node_ids, num_node_ids);
+  if (num_nodes == 0) {
+    // No topology information, chunks that are not bound.
+    node_ids[0] = -1;
+    num_nodes = 1;
+  }
+  _num_chunks = (NUMAEdenChunks > 0) ? (uint)NUMAEdenChunks : num_nodes;
+  _node_ids = NEW_C_HEAP_ARRAY(int, _num_chunks, mtGC);
+  for (uint i = 0; i < _num_chunks; i++) {
+    _node_ids[i] = node_ids[i % num_nodes];
+  }
+  FREE_C_HEAP_ARRAY(int, node_ids, mtGC);
+  _chunks = NEW_C_HEAP_ARRAY(Chunk, _num_chunks, mtGC);
+  for (uint i = 0; i < _num_chunks; i++) {
+    _chunks[i]._bottom = NULL;
+    _chunks[i]._top = NULL;
+    _chunks[i]._end = NULL;
+  }
+}
+
+bool NUMAEdenSpace::should_use() {
+  return UseNUMA && (os::numa_get_groups_num() > 1 || NUMAEdenChunks > 1);
+}
+
+void NUMAEdenSpace::initialize(MemRegion mr, bool clear_space, bool mangle_space) {
+  EdenSpace::initialize(mr, clear_space, mangle_space);
+  setup_chunks(clear_space);
+}
+
+void NUMAEdenSpace::setup_chunks(bool clear_space) {
+  size_t chunk_words = pointer_delta(end(), bottom()) / _num_chunks;
+  size_t page_words = _page_size / HeapWordSize;
+  for (uint i = 0; i < _num_chunks; i++) {
+    Chunk* chunk = &_chunks[i];
+    chunk->_bottom = (i == 0) ? bottom() : _chunks[i - 1]._end;
+    if (i == _num_chunks - 1) {
+      chunk->_end = end();
+    } else {
+      // Chunks start on a page, so that each page belongs to one node.
+      chunk->_end = MAX2(chunk->_bottom,
+                         bottom() + align_size_down(chunk_words * (i + 1), page_words));
+    }
+  }
+  set_chunk_tops_from_top();
+
+  MemRegion mr(bottom(), end());
+  if (mr.equals(_last_setup_region)) {
+    return;
+  }
+  _last_setup_region = mr;
+  for (uint i = 0; i < _num_chunks; i++) {
+    Chunk* chunk = &_chunks[i];
+    char* start = (char*)round_to((intptr_t)chunk->_bottom, _page_size);
+    char* end = (char*)round_down((intptr_t)chunk->_end, _page_size);
+    if (end > start && _node_ids[i] != -1) {
+      size_t size = pointer_delta(end, start, sizeof(char));
+      if (clear_space && top() == bottom()) {
+        // Prefer page reallocation to migration.
+        os::free_memory(start, size, _page_size);
+      }
+      os::numa_make_local(start, size, _node_ids[i]);
+    }
+  }
+}
+
+void NUMAEdenSpace::set_chunk_tops_from_top() {
+  for (uint i = 0; i < _num_chunks; i++) {
+    Chunk* chunk = &_chunks[i];
+    chunk->_top = MAX2(chunk->_bottom, MIN2(top(), chunk->_end));
+  }
+
+  // The objects may end just short of the end of a chunk.  Cover that
+  // gap and the start of the next chunk with a filler, since it could
+  // not be filled by itself when a chunk above is allocated from.
+  for (uint i = 0; i < _num_chunks; i++) {
+    Chunk* chunk = &_chunks[i];
+    if (chunk->_bottom < top() && top() < chunk->_end) {
+      if (chunk->free_words() < CollectedHeap::min_fill_size()) {
+        for (uint j = i + 1; j < _num_chunks; j++) {
+          Chunk* next = &_chunks[j];
+          if (next->free_words() > 0) {
+            HeapWord* fill_end = next->_bottom + CollectedHeap::min_fill_size();
+            CollectedHeap::fill_with_object(top(), pointer_delta(fill_end, top()));
+            chunk->_top = chunk->_end;
+            next->_top = fill_end;
+            set_top(fill_end);
+            break;
+          }
+        }
+      }
+      break;
+    }
+  }
+}
+
+void NUMAEdenSpace::clear(bool mangle_space) {
+  EdenSpace::clear(mangle_space);
+  for (uint i = 0; i < _num_chunks; i++) {
+    _chunks[i]._top = _chunks[i]._bottom;
+  }
+}
+
+void NUMAEdenSpace::reset_after_compaction() {
+  EdenSpace::reset_after_compaction();
+  set_chunk_tops_from_top();
+}
+
+size_t NUMAEdenSpace::used() const {
+  size_t used_words = 0;
+  for (uint i = 0; i < _num_chunks; i++) {
+    used_words += _chunks[i].used_words();
+  }
+  return used_words * HeapWordSize;
+}
+
+size_t NUMAEdenSpace::free() const {
+  return capacity() - used();
+}
+
+uint NUMAEdenSpace::chunk_index_for_current_thread() const {
+  Thread* thr = Thread::current();
+  int lgrp_id = thr->lgrp_id();
+  if (lgrp_id == -1 || !os::numa_has_group_homing()) {
+    lgrp_id = os::numa_get_group_id();
+    thr->set_lgrp_id(lgrp_id);
+  }
+  // With NUMAEdenChunks a node may have several chunks. Spread the
+  // threads over them.
+  uint num_local_chunks = 0;
+  for (uint i = 0; i < _num_chunks; i++) {
+    if (_node_ids[i] == lgrp_id) {
+      num_local_chunks++;
+    }
+  }
+  if (num_local_chunks == 0) {
+    return 0;
+  }
+  uint local_index = (juint)thr->_hashStateX % num_local_chunks;
+  for (uint i = 0; i < _num_chunks; i++) {
+    if (_node_ids[i] == lgrp_id) {
+      if (local_index == 0) {
+        return i;
+      }
+      local_index--;
+    }
+  }
+  ShouldNotReachHere();
+  return 0;
+}
+
+void NUMAEdenSpace::update_top(HeapWord* chunk_top) {
+  HeapWord* cur_top = top();
+  while (cur_top < chunk_top) {
+    HeapWord* result = (HeapWord*)Atomic::cmpxchg_ptr(chunk_top, top_addr(), cur_top);
+    if (result == cur_top) {
+      break;
+    }
+    cur_top = result;
+  }
+}
+
+// Lock-free.
+HeapWord* NUMAEdenSpace::par_allocate_in_chunk(Chunk* chunk, size_t word_size) {
+  do {
+    HeapWord* obj = chunk->_top;
+    if (pointer_delta(chunk->_end, obj) < word_size) {
+      return NULL;
+    }
+    HeapWord* new_top = obj + word_size;
+    size_t remainder = pointer_delta(chunk->_end, new_top);
+    if (remainder > 0 && remainder < CollectedHeap::min_fill_size()) {
+      // ensure_parsability() could not fill what is left.
+      return NULL;
+    }
+    HeapWord* result = (HeapWord*)Atomic::cmpxchg_ptr(new_top, &chunk->_top, obj);
+    if (result == obj) {
+      assert(is_aligned(obj) && is_aligned(new_top), "checking alignment");
+      update_top(new_top);
+      return obj;
+    }
+  } while (true);
+}
+
+HeapWord* NUMAEdenSpace::par_allocate(size_t word_size) {
+  uint first = chunk_index_for_current_thread();
+  for (uint i = 0; i < _num_chunks; i++) {
+    HeapWord* obj = par_allocate_in_chunk(&_chunks[(first + i) % _num_chunks], word_size);
+    if (obj != NULL) {
+      return obj;
+    }
+  }
+  return NULL;
+}
+
+HeapWord* NUMAEdenSpace::allocate(size_t word_size) {
+  return par_allocate(word_size);
+}
+
+void NUMAEdenSpace::ensure_parsability() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  for (uint i = 0; i < _num_chunks; i++) {
+    Chunk* chunk = &_chunks[i];
+    if (chunk->_end <= top() && chunk->free_words() > 0) {
+      CollectedHeap::fill_with_objects(chunk->_top, chunk->free_words());
+    }
+  }
+}
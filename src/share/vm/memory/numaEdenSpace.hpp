@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_MEMORY_NUMAEDENSPACE_HPP
+#define SHARE_VM_MEMORY_NUMAEDENSPACE_HPP
+
+#include "memory/space.hpp"
+
+// An eden that is split into one chunk per NUMA node.  The pages of a
+// chunk are bound to its node, and a thread allocates its TLABs and
+// objects from the chunk of the node it runs on, falling back to the
+// other chunks when that one is full.  NUMAEdenChunks overrides the
+// number of chunks, so that several chunks can be tested on one node.
+//
+// The chunks are allocated from independently, so a chunk below the
+// highest one in use may have a gap between its top and its end.  top()
+// is the highest top of all chunks, and ensure_parsability() fills the
+// gaps below it so that the eden can be walked from bottom() to top() at
+// a safepoint.  An allocation never leaves a gap too small to be filled.
+class NUMAEdenSpace : public EdenSpace {
+  class Chunk VALUE_OBJ_CLASS_SPEC {
+   public:
+    HeapWord*          _bottom;
+    HeapWord* volatile _top;
+    HeapWord*          _end;
+
+    size_t used_words() const { return pointer_delta(_top, _bottom); }
+    size_t free_words() const { return pointer_delta(_end, _top); }
+  };
+
+  Chunk*    _chunks;
+  int*      _node_ids;      // The node of each chunk.
+  uint      _num_chunks;
+  size_t    _page_size;
+  MemRegion _last_setup_region;
+
+  uint chunk_index_for_current_thread() const;
+  HeapWord* par_allocate_in_chunk(Chunk* chunk, size_t word_size);
+  // Raise top() to at least the given top of a chunk.
+  void update_top(HeapWord* chunk_top);
+
+  // Split [bottom(), end()) into the chunks and bind their pages.
+  void setup_chunks(bool clear_space);
+  // Set the tops of the chunks for the contiguous objects in
+  // [bottom(), top()).
+  void set_chunk_tops_from_top();
+
+ public:
+  NUMAEdenSpace(DefNewGeneration* gen);
+
+  // Whether the eden of the young generation should be split across the
+  // NUMA nodes, or into NUMAEdenChunks chunks.
+  static bool should_use();
+
+  virtual void initialize(MemRegion mr, bool clear_space, bool mangle_space);
+  void clear(bool mangle_space);
+  virtual void reset_after_compaction();
+
+  // top() - bottom() includes the gaps, these do not.
+  size_t used() const;
+  size_t free() const;
+
+  HeapWord* allocate(size_t word_size);
+  HeapWord* par_allocate(size_t word_size);
+
+  // Allocations are spread over the chunks, there is no single top()
+  // to bump.
+  virtual bool supports_inline_contig_alloc() const { return false; }
+
+  virtual void ensure_parsability();
+};
+
+#endif // SHARE_VM_MEMORY_NUMAEDENSPACE_HPP
@@ -34,6 +34,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/jniHandles.hpp"
+#include "utilities/ticks.inline.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -211,13 +212,16 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
 
   bool trace_time = PrintGCDetails && PrintReferenceGC;
 
+  ReferencePhaseTimes soft_times, weak_times, final_times, phantom_times;
+
   // Soft references
   size_t soft_count = 0;
   {
     GCTraceTime tt("SoftReference", trace_time, false, gc_timer, gc_id);
     soft_count =
       process_discovered_reflist(_discoveredSoftRefs, _current_soft_ref_policy, true,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &soft_times);
   }
 
   update_soft_ref_master_clock();
@@ -228,7 +232,8 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
     GCTraceTime tt("WeakReference", trace_time, false, gc_timer, gc_id);
     weak_count =
       process_discovered_reflist(_discoveredWeakRefs, NULL, true,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &weak_times);
   }
 
   // Final references
@@ -237,7 +242,8 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
     GCTraceTime tt("FinalReference", trace_time, false, gc_timer, gc_id);
     final_count =
       process_discovered_reflist(_discoveredFinalRefs, NULL, false,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &final_times);
   }
 
   // Phantom references
@@ -246,14 +252,18 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
     GCTraceTime tt("PhantomReference", trace_time, false, gc_timer, gc_id);
     phantom_count =
       process_discovered_reflist(_discoveredPhantomRefs, NULL, false,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &phantom_times);
 
     // Process cleaners, but include them in phantom statistics.  We expect
     // Cleaner references to be temporary, and don't want to deal with
     // possible incompatibilities arising from making it more visible.
+    ReferencePhaseTimes cleaner_times;
     phantom_count +=
       process_discovered_reflist(_discoveredCleanerRefs, NULL, true,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &cleaner_times);
+    phantom_times.add(cleaner_times);
   }
 
   // Weak global JNI references. It would make more sense (semantically) to
@@ -269,7 +279,12 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
     process_phaseJNI(is_alive, keep_alive, complete_gc);
   }
 
-  return ReferenceProcessorStats(soft_count, weak_count, final_count, phantom_count);
+  ReferenceProcessorStats stats(soft_count, weak_count, final_count, phantom_count);
+  stats.set_phase_times(REF_SOFT,    soft_times);
+  stats.set_phase_times(REF_WEAK,    weak_times);
+  stats.set_phase_times(REF_FINAL,   final_times);
+  stats.set_phase_times(REF_PHANTOM, phantom_times);
+  return stats;
 }
 
 #ifndef PRODUCT
@@ -888,6 +903,14 @@ void ReferenceProcessor::balance_all_queues() {
   balance_queues(_discoveredCleanerRefs);
 }
 
+uint ReferenceProcessor::ergo_proc_queues(size_t ref_count) const {
+  if (ReferencesPerThread == 0) {
+    return _num_q;
+  }
+  size_t queues = (ref_count + ReferencesPerThread - 1) / ReferencesPerThread;
+  return (uint)MAX2(MIN2(queues, (size_t)_num_q), (size_t)1);
+}
+
 size_t
 ReferenceProcessor::process_discovered_reflist(
   DiscoveredList               refs_lists[],
@@ -896,7 +919,8 @@ ReferenceProcessor::process_discovered_reflist(
   BoolObjectClosure*           is_alive,
   OopClosure*                  keep_alive,
   VoidClosure*                 complete_gc,
-  AbstractRefProcTaskExecutor* task_executor)
+  AbstractRefProcTaskExecutor* task_executor,
+  ReferencePhaseTimes*         phase_times)
 {
   bool mt_processing = task_executor != NULL && _processing_is_mt;
   // If discovery used MT and a dynamic number of GC threads, then
@@ -907,22 +931,32 @@ ReferenceProcessor::process_discovered_reflist(
   // of the test.
   bool must_balance = _discovery_is_mt;
 
-  if ((mt_processing && ParallelRefProcBalancingEnabled) ||
+  size_t total_list_count = total_count(refs_lists);
+
+  // A few references are not worth the synchronization of many workers.
+  // Move them into the queues of as many workers as their number calls
+  // for, the remaining workers only take part in the termination.
+  uint active_num_q = _num_q;
+  if (mt_processing) {
+    _num_q = ergo_proc_queues(total_list_count);
+  }
+
+  if ((mt_processing && (ParallelRefProcBalancingEnabled || _num_q < active_num_q)) ||
       must_balance) {
     balance_queues(refs_lists);
   }
 
-  size_t total_list_count = total_count(refs_lists);
-
   if (PrintReferenceGC && PrintGCDetails) {
     gclog_or_tty->print(", %u refs", total_list_count);
   }
+  phase_times->set_workers(mt_processing ? _num_q : 1);
 
   // Phase 1 (soft refs only):
   // . Traverse the list and remove any SoftReferences whose
   //   referents are not alive, but that should be kept alive for
   //   policy reasons. Keep alive the transitive closure of all
   //   such referents.
+  Ticks start = Ticks::now();
   if (policy != NULL) {
     if (mt_processing) {
       RefProcPhase1Task phase1(*this, refs_lists, policy, true /*marks_oops_alive*/);
@@ -937,6 +971,8 @@ ReferenceProcessor::process_discovered_reflist(
     assert(refs_lists != _discoveredSoftRefs,
            "Policy must be specified for soft references.");
   }
+  Ticks end = Ticks::now();
+  phase_times->add_phase1(end - start);
 
   // Phase 2:
   // . Traverse the list and remove any refs whose referents are alive.
@@ -948,6 +984,9 @@ ReferenceProcessor::process_discovered_reflist(
       process_phase2(refs_lists[i], is_alive, keep_alive, complete_gc);
     }
   }
+  start = end;
+  end = Ticks::now();
+  phase_times->add_phase2(end - start);
 
   // Phase 3:
   // . Traverse the list and process referents as appropriate.
@@ -960,7 +999,11 @@ ReferenceProcessor::process_discovered_reflist(
                      is_alive, keep_alive, complete_gc);
     }
   }
+  start = end;
+  end = Ticks::now();
+  phase_times->add_phase3(end - start);
 
+  _num_q = active_num_q;
   return total_list_count;
 }
 
@@ -1382,6 +1425,44 @@ ReferenceProcessor::preclean_discovered_reflist(DiscoveredList&    refs_list,
   )
 }
 
+void ReferenceProcessor::preclean_final_referents(
+  BoolObjectClosure*  is_alive,
+  ExtendedOopClosure* referent_fields,
+  VoidClosure*        complete_gc,
+  YieldClosure*       yield,
+  GCTimer*            gc_timer,
+  GCId                gc_id) {
+
+  NOT_PRODUCT(verify_ok_to_handle_reflists());
+
+  GCTraceTime tt("Preclean FinalReferents", PrintGCDetails && PrintReferenceGC,
+            false, gc_timer, gc_id);
+  size_t traced = 0;
+  for (uint i = 0; i < _max_num_q; i++) {
+    if (yield->should_return()) {
+      return;
+    }
+    DiscoveredListIterator iter(_discoveredFinalRefs[i], NULL, is_alive);
+    while (iter.has_next()) {
+      iter.load_ptrs(DEBUG_ONLY(true /* allow_null_referent */));
+      if (iter.referent() != NULL && !iter.is_referent_alive() &&
+          java_lang_ref_Reference::next(iter.obj()) == NULL) {
+        // Only the fields: marking the referent itself would make it
+        // look alive and drop the Reference from the list.
+        iter.referent()->oop_iterate(referent_fields);
+        traced++;
+      }
+      iter.next();
+    }
+    // Close the reachable set
+    complete_gc->do_void();
+  }
+
+  if (PrintGCDetails && PrintReferenceGC) {
+    gclog_or_tty->print(", " SIZE_FORMAT " referents", traced);
+  }
+}
+
 const char* ReferenceProcessor::list_name(uint i) {
    assert(i >= 0 && i <= _max_num_q * number_of_subclasses_of_ref(),
           "Out of bounds index");
@@ -289,7 +289,12 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
                                     BoolObjectClosure*           is_alive,
                                     OopClosure*                  keep_alive,
                                     VoidClosure*                 complete_gc,
-                                    AbstractRefProcTaskExecutor* task_executor);
+                                    AbstractRefProcTaskExecutor* task_executor,
+                                    ReferencePhaseTimes*         phase_times);
+
+  // The number of queues the given number of references is spread over
+  // when processing them in parallel.
+  uint ergo_proc_queues(size_t ref_count) const;
 
   void process_phaseJNI(BoolObjectClosure* is_alive,
                         OopClosure*        keep_alive,
@@ -354,6 +359,19 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
                                       GCTimer*           gc_timer,
                                       GCId               gc_id);
 
+  // Trace concurrently from the fields of the referents of the
+  // discovered FinalReferences which are neither alive nor inactive.
+  // Phase 3 keeps these referents alive anyway, so only the referents
+  // themselves are left to be marked in the remark pause. The
+  // referents stay unmarked, so their FinalReferences remain on the
+  // discovered lists. Used by CMS and G1.
+  void preclean_final_referents(BoolObjectClosure*  is_alive,
+                                ExtendedOopClosure* referent_fields,
+                                VoidClosure*        complete_gc,
+                                YieldClosure*       yield,
+                                GCTimer*            gc_timer,
+                                GCId                gc_id);
+
   // Delete entries in the discovered lists that have
   // either a null referent or are not active. Such
   // Reference objects can result from the clearing
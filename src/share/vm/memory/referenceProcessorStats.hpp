@@ -25,10 +25,44 @@
 #ifndef SHARE_VM_MEMORY_REFERENCEPROCESSORSTATS_HPP
 #define SHARE_VM_MEMORY_REFERENCEPROCESSORSTATS_HPP
 
+#include "memory/allocation.hpp"
+#include "memory/referenceType.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/ticks.hpp"
 
 class ReferenceProcessor;
 
+// ReferencePhaseTimes contains the time spent in the three phases of
+// processing the references of one type, and the number of workers the
+// references were handed to.
+class ReferencePhaseTimes VALUE_OBJ_CLASS_SPEC {
+  Tickspan _phase1;
+  Tickspan _phase2;
+  Tickspan _phase3;
+  uint     _workers;
+
+ public:
+  ReferencePhaseTimes() : _phase1(), _phase2(), _phase3(), _workers(0) {}
+
+  void add_phase1(const Tickspan& t) { _phase1 += t; }
+  void add_phase2(const Tickspan& t) { _phase2 += t; }
+  void add_phase3(const Tickspan& t) { _phase3 += t; }
+  void set_workers(uint workers)     { _workers = MAX2(_workers, workers); }
+
+  // Accumulates the times of another list of the same reachability.
+  void add(const ReferencePhaseTimes& other) {
+    add_phase1(other._phase1);
+    add_phase2(other._phase2);
+    add_phase3(other._phase3);
+    set_workers(other._workers);
+  }
+
+  const Tickspan& phase1() const { return _phase1; }
+  const Tickspan& phase2() const { return _phase2; }
+  const Tickspan& phase3() const { return _phase3; }
+  uint workers() const           { return _workers; }
+};
+
 // ReferenceProcessorStats contains statistics about how many references that
 // have been traversed when processing references during garbage collection.
 class ReferenceProcessorStats {
@@ -37,6 +71,10 @@ class ReferenceProcessorStats {
   size_t _final_count;
   size_t _phantom_count;
 
+  // Indexed by ReferenceType - REF_SOFT. Cleaners are included in the
+  // phantom references.
+  ReferencePhaseTimes _phase_times[REF_PHANTOM - REF_SOFT + 1];
+
  public:
   ReferenceProcessorStats() :
     _soft_count(0),
@@ -69,5 +107,15 @@ class ReferenceProcessorStats {
   size_t phantom_count() const {
     return _phantom_count;
   }
+
+  const ReferencePhaseTimes& phase_times(ReferenceType type) const {
+    assert(type >= REF_SOFT && type <= REF_PHANTOM, "invalid reference type");
+    return _phase_times[type - REF_SOFT];
+  }
+
+  void set_phase_times(ReferenceType type, const ReferencePhaseTimes& times) {
+    assert(type >= REF_SOFT && type <= REF_PHANTOM, "invalid reference type");
+    _phase_times[type - REF_SOFT] = times;
+  }
 };
 #endif
@@ -75,6 +75,10 @@ void SharedHeap::set_par_threads(uint t) {
   _n_par_threads = t;
 }
 
+WorkGang* SharedHeap::safepoint_workers() {
+  return _workers;
+}
+
 void SharedHeap::change_strong_roots_parity() {
   // Also set the new collection parity.
   assert(_strong_roots_parity >= 0 && _strong_roots_parity <= 2,
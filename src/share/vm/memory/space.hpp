@@ -721,6 +721,12 @@ class EdenSpace : public ContiguousSpace {
   // Allocation (return NULL if full)
   HeapWord* allocate(size_t word_size);
   HeapWord* par_allocate(size_t word_size);
+
+  // Whether compiled code may allocate by bumping top() directly.
+  virtual bool supports_inline_contig_alloc() const { return true; }
+
+  // Make [bottom(), top()) walkable; called at a safepoint.
+  virtual void ensure_parsability() { }
 };
 
 // Class ConcEdenSpace extends EdenSpace for the sake of safe
@@ -62,7 +62,7 @@ void* Symbol::operator new(size_t sz, int len, ClassLoaderData* loader_data, TRA
 }
 
 void Symbol::operator delete(void *p) {
-  assert(((Symbol*)p)->refcount() == 0, "should not call this");
+  assert(((Symbol*)p)->refcount() == 0 || ((Symbol*)p)->is_dead(), "should not call this");
   FreeHeap(p);
 }
 
@@ -223,6 +223,48 @@ void Symbol::increment_refcount() {
   }
 }
 
+// The reference count occupies the upper half of an aligned 32-bit word,
+// see ATOMIC_SHORT_PAIR, which is updated with a CAS.
+static volatile jint* refcount_word(volatile short* refcount) {
+#ifdef VM_LITTLE_ENDIAN
+  assert((intx(refcount) & 0x03) == 0x02, "wrong alignment");
+  return (volatile jint*)(refcount - 1);
+#else
+  assert((intx(refcount) & 0x03) == 0x00, "wrong alignment");
+  return (volatile jint*)refcount;
+#endif
+}
+
+bool Symbol::try_increment_refcount() {
+  volatile jint* word = refcount_word(&_refcount);
+  while (true) {
+    jint old_word = *word;
+    short count = (short)(old_word >> 16);
+    if (count == dead_refcount) {
+      return false;
+    }
+    if (count < 0) {
+      // Permanent or overflowed, see increment_refcount().
+      return true;
+    }
+    jint new_word = (jint)((juint)old_word + 0x10000);
+    if (Atomic::cmpxchg(new_word, word, old_word) == old_word) {
+      NOT_PRODUCT(Atomic::inc(&_total_count);)
+      return true;
+    }
+  }
+}
+
+bool Symbol::try_mark_dead() {
+  volatile jint* word = refcount_word(&_refcount);
+  jint old_word = *word;
+  if ((short)(old_word >> 16) != 0) {
+    return false;
+  }
+  jint new_word = (jint)(((juint)old_word & 0xffff) | ((juint)(jushort)dead_refcount << 16));
+  return Atomic::cmpxchg(new_word, word, old_word) == old_word;
+}
+
 void Symbol::decrement_refcount() {
   if (_refcount >= 0) {
     Atomic::dec(&_refcount);
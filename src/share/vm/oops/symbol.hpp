@@ -122,7 +122,10 @@ class Symbol : private SymbolBase {
 
   enum {
     // max_symbol_length is constrained by type of _length
-    max_symbol_length = (1 << 16) -1
+    max_symbol_length = (1 << 16) -1,
+    // The reference count of a symbol removed from the SymbolTable while
+    // lock-free readers may still find it. It is deleted at a safepoint.
+    dead_refcount = -2
   };
 
   static int size(int length) {
@@ -160,6 +163,12 @@ class Symbol : private SymbolBase {
   int refcount() const      { return _refcount; }
   void increment_refcount();
   void decrement_refcount();
+  // Used by the SymbolTable lookups: increments the reference count unless
+  // the symbol has been removed concurrently.
+  bool try_increment_refcount();
+  // Marks an unreferenced symbol as removed. Fails if it is referenced.
+  bool try_mark_dead();
+  bool is_dead() const      { return _refcount == dead_refcount; }
 
   int byte_at(int index) const {
     assert(index >=0 && index < _length, "symbol index overflow");
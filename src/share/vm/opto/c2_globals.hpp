@@ -324,6 +324,9 @@
   develop(bool, SuperWordRTDepCheck, false,                                 \
           "Enable runtime dependency checks.")                              \
                                                                             \
+  product(bool, SuperWordReductions, true,                                  \
+          "Enable reductions support in superword.")                        \
+                                                                            \
   notproduct(bool, TraceSuperWord, false,                                   \
           "Trace superword transforms")                                     \
                                                                             \
@@ -544,6 +547,9 @@
   develop(bool, SpecialStringEquals, true,                                  \
           "special version of string equals")                               \
                                                                             \
+  develop(bool, SpecialStringHashCode, true,                                \
+          "special version of string hashCode")                             \
+                                                                            \
   develop(bool, SpecialArraysEquals, true,                                  \
           "special version of Arrays.equals(char[],char[])")                \
                                                                             \
@@ -300,6 +300,14 @@ macro(URShiftVL)
 macro(AndV)
 macro(OrV)
 macro(XorV)
+macro(AddReductionVI)
+macro(AddReductionVL)
+macro(AddReductionVF)
+macro(AddReductionVD)
+macro(MulReductionVI)
+macro(MulReductionVL)
+macro(MulReductionVF)
+macro(MulReductionVD)
 macro(LoadVector)
 macro(StoreVector)
 macro(Pack)
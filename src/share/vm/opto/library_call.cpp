@@ -202,6 +202,7 @@ class LibraryCallKit : public GraphKit {
   bool inline_string_indexOf();
   Node* string_indexOf(Node* string_object, ciTypeArray* target_array, jint offset, jint cache_i, jint md2_i);
   bool inline_string_equals();
+  bool inline_string_hashCode();
   Node* round_double_node(Node* n);
   bool runtime_math(const TypeFunc* call_type, address funcAddr, const char* funcName);
   bool inline_math_native(vmIntrinsics::ID id);
@@ -249,6 +250,8 @@ class LibraryCallKit : public GraphKit {
   bool inline_native_getLength();
   bool inline_array_copyOf(bool is_copyOfRange);
   bool inline_array_equals();
+  bool inline_primitive_array_equals(BasicType elem);
+  Node* fp_element_is_nan(Node* array, Node* index, BasicType elem);
   void copy_to_clone(Node* obj, Node* alloc_obj, Node* obj_size, bool is_array, bool card_mark);
   bool inline_native_clone(bool is_virtual);
   bool inline_native_Reflection_getCallerClass();
@@ -374,7 +377,15 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     case vmIntrinsics::_indexOf:
     case vmIntrinsics::_compareTo:
     case vmIntrinsics::_equals:
+    case vmIntrinsics::_stringHashCode:
     case vmIntrinsics::_equalsC:
+    case vmIntrinsics::_equalsB:
+    case vmIntrinsics::_equalsZ:
+    case vmIntrinsics::_equalsS:
+    case vmIntrinsics::_equalsI:
+    case vmIntrinsics::_equalsJ:
+    case vmIntrinsics::_equalsF:
+    case vmIntrinsics::_equalsD:
     case vmIntrinsics::_getAndAddInt:
     case vmIntrinsics::_getAndAddLong:
     case vmIntrinsics::_getAndSetInt:
@@ -406,10 +417,24 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (!SpecialStringEquals)  return NULL;
     if (!Matcher::match_rule_supported(Op_StrEquals))  return NULL;
     break;
+  case vmIntrinsics::_stringHashCode:
+    if (!SpecialStringHashCode)  return NULL;
+    if (StubRoutines::stringHashCode() == NULL)  return NULL;
+    break;
   case vmIntrinsics::_equalsC:
     if (!SpecialArraysEquals)  return NULL;
     if (!Matcher::match_rule_supported(Op_AryEq))  return NULL;
     break;
+  case vmIntrinsics::_equalsB:
+  case vmIntrinsics::_equalsZ:
+  case vmIntrinsics::_equalsS:
+  case vmIntrinsics::_equalsI:
+  case vmIntrinsics::_equalsJ:
+  case vmIntrinsics::_equalsF:
+  case vmIntrinsics::_equalsD:
+    if (!SpecialArraysEquals)  return NULL;
+    if (StubRoutines::vectorizedMismatch() == NULL)  return NULL;
+    break;
   case vmIntrinsics::_arraycopy:
     if (!InlineArrayCopy)  return NULL;
     break;
@@ -799,6 +824,7 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_compareTo:                return inline_string_compareTo();
   case vmIntrinsics::_indexOf:                  return inline_string_indexOf();
   case vmIntrinsics::_equals:                   return inline_string_equals();
+  case vmIntrinsics::_stringHashCode:           return inline_string_hashCode();
 
   case vmIntrinsics::_getObject:                return inline_unsafe_access(!is_native_ptr, !is_store, T_OBJECT,  !is_volatile, false);
   case vmIntrinsics::_getBoolean:               return inline_unsafe_access(!is_native_ptr, !is_store, T_BOOLEAN, !is_volatile, false);
@@ -898,6 +924,13 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_copyOf:                   return inline_array_copyOf(false);
   case vmIntrinsics::_copyOfRange:              return inline_array_copyOf(true);
   case vmIntrinsics::_equalsC:                  return inline_array_equals();
+  case vmIntrinsics::_equalsB:                  return inline_primitive_array_equals(T_BYTE);
+  case vmIntrinsics::_equalsZ:                  return inline_primitive_array_equals(T_BOOLEAN);
+  case vmIntrinsics::_equalsS:                  return inline_primitive_array_equals(T_SHORT);
+  case vmIntrinsics::_equalsI:                  return inline_primitive_array_equals(T_INT);
+  case vmIntrinsics::_equalsJ:                  return inline_primitive_array_equals(T_LONG);
+  case vmIntrinsics::_equalsF:                  return inline_primitive_array_equals(T_FLOAT);
+  case vmIntrinsics::_equalsD:                  return inline_primitive_array_equals(T_DOUBLE);
   case vmIntrinsics::_clone:                    return inline_native_clone(intrinsic()->is_virtual());
 
   case vmIntrinsics::_isAssignableFrom:         return inline_native_subtype_check();
@@ -1349,6 +1382,59 @@ bool LibraryCallKit::inline_string_equals() {
   return true;
 }
 
+//------------------------------inline_string_hashCode------------------------
+// public int java.lang.String.hashCode()
+//
+// The hash cached in the String is used if it is set, else a stub computes
+// and caches it.
+bool LibraryCallKit::inline_string_hashCode() {
+  Node* receiver = null_check_receiver();
+  if (stopped()) {
+    return true;
+  }
+
+  enum { _cached_path = 1, _stub_path, PATH_LIMIT };
+  RegionNode* result_reg = new (C) RegionNode(PATH_LIMIT);
+  PhiNode*    result_val = new (C) PhiNode(result_reg, TypeInt::INT);
+  PhiNode*    result_io  = new (C) PhiNode(result_reg, Type::ABIO);
+  PhiNode*    result_mem = new (C) PhiNode(result_reg, Type::MEMORY, TypePtr::BOTTOM);
+  record_for_igvn(result_reg);
+
+  Node* hash_adr = basic_plus_adr(receiver, java_lang_String::hash_offset_in_bytes());
+  Node* hash     = make_load(control(), hash_adr, TypeInt::INT, T_INT, MemNode::unordered);
+  Node* cmp_hash = _gvn.transform(new (C) CmpINode(hash, intcon(0)));
+  Node* bol_hash = _gvn.transform(new (C) BoolNode(cmp_hash, BoolTest::ne));
+  Node* cached   = generate_guard(bol_hash, NULL, PROB_LIKELY_MAG(1));
+
+  Node* init_mem = reset_memory();
+  set_all_memory(init_mem);
+  result_reg->init_req(_cached_path, cached != NULL ? cached : top());
+  result_val->init_req(_cached_path, hash);
+  result_io ->init_req(_cached_path, i_o());
+  result_mem->init_req(_cached_path, init_mem);
+
+  if (!stopped()) {
+    Node* call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::stringHashCode_Type(),
+                                   StubRoutines::stringHashCode(), "stringHashCode",
+                                   TypePtr::BOTTOM, receiver);
+    Node* stub_hash = _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+    result_reg->init_req(_stub_path, control());
+    result_val->init_req(_stub_path, stub_hash);
+    result_io ->init_req(_stub_path, i_o());
+    result_mem->init_req(_stub_path, reset_memory());
+  } else {
+    result_reg->init_req(_stub_path, top());
+    result_val->init_req(_stub_path, top());
+    result_io ->init_req(_stub_path, top());
+    result_mem->init_req(_stub_path, top());
+  }
+
+  set_i_o(       _gvn.transform(result_io));
+  set_all_memory(_gvn.transform(result_mem));
+  set_result(result_reg, result_val);
+  return true;
+}
+
 //------------------------------inline_array_equals----------------------------
 bool LibraryCallKit::inline_array_equals() {
   Node* arg1 = argument(0);
@@ -1357,6 +1443,145 @@ bool LibraryCallKit::inline_array_equals() {
   return true;
 }
 
+//------------------------------inline_primitive_array_equals------------------
+// public static boolean java.util.Arrays.equals(byte[] a, byte[] a2)
+// and the same for boolean[], short[], int[], long[], float[] and double[]
+//
+// The contents are compared by the vectorizedMismatch stub. float and
+// double elements are compared by their bits, while Arrays.equals() treats
+// all NaNs as equal. A mismatch between two NaNs deoptimizes.
+bool LibraryCallKit::inline_primitive_array_equals(BasicType elem) {
+  bool is_fp = (elem == T_FLOAT || elem == T_DOUBLE);
+  if (is_fp && too_many_traps(Deoptimization::Reason_intrinsic)) {
+    return false;
+  }
+
+  Node* a = argument(0);
+  Node* b = argument(1);
+
+  enum { _true_path = 1, _false_path, _stub_path, PATH_LIMIT };
+  RegionNode* result_reg = new (C) RegionNode(PATH_LIMIT);
+  PhiNode*    result_val = new (C) PhiNode(result_reg, TypeInt::BOOL);
+  PhiNode*    result_io  = new (C) PhiNode(result_reg, Type::ABIO);
+  PhiNode*    result_mem = new (C) PhiNode(result_reg, Type::MEMORY, TypePtr::BOTTOM);
+  record_for_igvn(result_reg);
+
+  RegionNode* true_reg  = new (C) RegionNode(1);
+  RegionNode* false_reg = new (C) RegionNode(1);
+  record_for_igvn(true_reg);
+  record_for_igvn(false_reg);
+
+  // Set the original stack and the reexecute bit for the interpreter to reexecute
+  // the bytecode that invokes Arrays.equals if deoptimization happens.
+  { PreserveReexecuteState preexecs(this);
+    jvms()->set_should_reexecute(true);
+
+    // The same array, or both null
+    Node* cmp_same = _gvn.transform(new (C) CmpPNode(a, b));
+    Node* bol_same = _gvn.transform(new (C) BoolNode(cmp_same, BoolTest::eq));
+    generate_guard(bol_same, true_reg, PROB_FAIR);
+
+    Node* null_ctl = top();
+    a = null_check_oop(a, &null_ctl);
+    if (null_ctl != top())  false_reg->add_req(null_ctl);
+    null_ctl = top();
+    b = null_check_oop(b, &null_ctl);
+    if (null_ctl != top())  false_reg->add_req(null_ctl);
+
+    Node* length = NULL;
+    if (!stopped()) {
+      length = load_array_length(a);
+      Node* cmp_len = _gvn.transform(new (C) CmpINode(length, load_array_length(b)));
+      Node* bol_len = _gvn.transform(new (C) BoolNode(cmp_len, BoolTest::ne));
+      generate_guard(bol_len, false_reg, PROB_FAIR);
+    }
+
+    Node* init_mem = reset_memory();
+    set_all_memory(init_mem);
+    Node* init_io = i_o();
+    result_reg->init_req(_true_path, _gvn.transform(true_reg));
+    result_val->init_req(_true_path, intcon(1));
+    result_io ->init_req(_true_path, init_io);
+    result_mem->init_req(_true_path, init_mem);
+    result_reg->init_req(_false_path, _gvn.transform(false_reg));
+    result_val->init_req(_false_path, intcon(0));
+    result_io ->init_req(_false_path, init_io);
+    result_mem->init_req(_false_path, init_mem);
+
+    if (!stopped()) {
+      Node* a_start = array_element_address(a, intcon(0), elem);
+      Node* b_start = array_element_address(b, intcon(0), elem);
+      Node* call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::vectorizedMismatch_Type(),
+                                     StubRoutines::vectorizedMismatch(), "vectorizedMismatch",
+                                     TypeAryPtr::get_array_body_type(elem),
+                                     a_start, b_start, length,
+                                     intcon(exact_log2(type2aelembytes(elem))));
+      Node* mismatch = _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+
+      if (is_fp) {
+        Node* cmp_res = _gvn.transform(new (C) CmpINode(mismatch, intcon(0)));
+        Node* bol_res = _gvn.transform(new (C) BoolNode(cmp_res, BoolTest::ge));
+        Node* differ = generate_guard(bol_res, NULL, PROB_FAIR);
+        if (differ != NULL) {
+          Node* equal_ctl = control();
+          set_control(differ);
+          Node* both_nan = _gvn.transform(new (C) AndINode(fp_element_is_nan(a, mismatch, elem),
+                                                           fp_element_is_nan(b, mismatch, elem)));
+          Node* cmp_nan = _gvn.transform(new (C) CmpINode(both_nan, intcon(0)));
+          Node* bol_nan = _gvn.transform(new (C) BoolNode(cmp_nan, BoolTest::eq));
+          { BuildCutout unless(this, bol_nan, PROB_MAX);
+            uncommon_trap(Deoptimization::Reason_intrinsic,
+                          Deoptimization::Action_maybe_recompile);
+          }
+          RegionNode* merge = new (C) RegionNode(3);
+          merge->init_req(1, equal_ctl);
+          merge->init_req(2, control());
+          set_control(_gvn.transform(merge));
+        }
+      }
+
+      // The sign bit is only set if no mismatch was found
+      Node* equal = _gvn.transform(new (C) URShiftINode(mismatch, intcon(31)));
+      result_reg->init_req(_stub_path, control());
+      result_val->init_req(_stub_path, equal);
+      result_io ->init_req(_stub_path, i_o());
+      result_mem->init_req(_stub_path, reset_memory());
+    } else {
+      result_reg->init_req(_stub_path, top());
+      result_val->init_req(_stub_path, top());
+      result_io ->init_req(_stub_path, top());
+      result_mem->init_req(_stub_path, top());
+    }
+  } // original reexecute is set back here
+
+  set_i_o(       _gvn.transform(result_io));
+  set_all_memory(_gvn.transform(result_mem));
+  set_result(result_reg, result_val);
+  return true;
+}
+
+// Returns 1 if the float or double element of the array at index is a NaN,
+// else 0. A NaN has all exponent bits and some of the fraction bits set, so
+// the magnitude of its bits is larger than the bits of infinity.
+Node* LibraryCallKit::fp_element_is_nan(Node* array, Node* index, BasicType elem) {
+  Node* adr = array_element_address(array, index, elem);
+  if (elem == T_FLOAT) {
+    Node* value = make_load(control(), adr, Type::FLOAT, T_FLOAT, MemNode::unordered);
+    Node* bits  = _gvn.transform(new (C) MoveF2INode(value));
+    Node* mag   = _gvn.transform(new (C) AndINode(bits, intcon(max_jint)));
+    Node* diff  = _gvn.transform(new (C) SubINode(intcon(0x7f800000), mag));
+    return _gvn.transform(new (C) URShiftINode(diff, intcon(31)));
+  } else {
+    assert(elem == T_DOUBLE, "only float and double elements");
+    Node* value = make_load(control(), adr, Type::DOUBLE, T_DOUBLE, MemNode::unordered);
+    Node* bits  = _gvn.transform(new (C) MoveD2LNode(value));
+    Node* mag   = _gvn.transform(new (C) AndLNode(bits, longcon(max_jlong)));
+    Node* diff  = _gvn.transform(new (C) SubLNode(longcon(CONST64(0x7ff0000000000000)), mag));
+    Node* sign  = _gvn.transform(new (C) URShiftLNode(diff, intcon(63)));
+    return _gvn.transform(new (C) ConvL2INode(sign));
+  }
+}
+
 // Java version of String.indexOf(constant string)
 // class StringDecl {
 //   StringDecl(char[] ca) {
@@ -34,6 +34,7 @@
 #include "opto/rootnode.hpp"
 #include "opto/runtime.hpp"
 #include "opto/subnode.hpp"
+#include "opto/vectornode.hpp"
 
 //------------------------------is_loop_exit-----------------------------------
 // Given an IfNode, return the loop-exiting projection or NULL if both
@@ -1190,6 +1191,56 @@ bool IdealLoopTree::is_invariant(Node* n) const {
 }
 
 
+//------------------------------mark_reductions--------------------------------
+// Flag the arithmetic nodes which accumulate into a loop phi, e.g. the add
+// of "sum += a[i]", so that SuperWord can turn the unrolled copies into a
+// vector reduction.  This is done before the first unroll: the copies made
+// by unrolling inherit the flag.
+void PhaseIdealLoop::mark_reductions(IdealLoopTree *loop) {
+  CountedLoopNode* loop_head = loop->_head->as_CountedLoop();
+  if (loop_head->unrolled_count() > 1) {
+    return;
+  }
+
+  Node* trip_phi = loop_head->phi();
+  for (DUIterator_Fast imax, i = loop_head->fast_outs(imax); i < imax; i++) {
+    Node* phi = loop_head->fast_out(i);
+    if (!phi->is_Phi() || phi->outcnt() == 0 || phi == trip_phi) {
+      continue;
+    }
+    // For definitions which are loop inclusive and not tripcounts.
+    Node* def_node = phi->in(LoopNode::LoopBackControl);
+    if (def_node == NULL || def_node->is_reduction()) {
+      continue;
+    }
+    Node* n_ctrl = get_ctrl(def_node);
+    if (n_ctrl == NULL || !loop->is_member(get_loop(n_ctrl))) {
+      continue;
+    }
+    // Is there a vector reduction for this operation?
+    int opc = def_node->Opcode();
+    if (opc == ReductionNode::opcode(opc, def_node->bottom_type()->basic_type())) {
+      continue;
+    }
+    // The operation must accumulate into the phi ...
+    if (def_node->in(1) != phi && def_node->in(2) != phi) {
+      continue;
+    }
+    // ... and its result must not be used in the loop other than by the phi.
+    bool ok = true;
+    for (DUIterator_Fast jmax, j = def_node->fast_outs(jmax); j < jmax; j++) {
+      Node* u = def_node->fast_out(j);
+      if (u != phi && loop->is_member(get_loop(ctrl_or_self(u)))) {
+        ok = false;
+        break;
+      }
+    }
+    if (ok) {
+      def_node->add_flag(Node::Flag_is_reduction);
+    }
+  }
+}
+
 //------------------------------do_unroll--------------------------------------
 // Unroll the loop body one step - make each trip do 2 iterations.
 void PhaseIdealLoop::do_unroll( IdealLoopTree *loop, Node_List &old_new, bool adjust_min_trip ) {
@@ -2393,8 +2444,11 @@ bool IdealLoopTree::iteration_split_impl( PhaseIdealLoop *phase, Node_List &old_
     // an even number of trips).  If we are peeling, we might enable some RCE
     // and we'd rather unroll the post-RCE'd loop SO... do not unroll if
     // peeling.
-    if (should_unroll && !should_peel)
+    if (should_unroll && !should_peel) {
+      if (SuperWordReductions)
+        phase->mark_reductions(this);
       phase->do_unroll(this,old_new, true);
+    }
 
     // Adjust the pre-loop limits to align the main body
     // iterations.
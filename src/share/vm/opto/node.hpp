@@ -667,7 +667,8 @@ public:
     Flag_avoid_back_to_back_after    = Flag_avoid_back_to_back_before << 1,
     Flag_has_call                    = Flag_avoid_back_to_back_after << 1,
     Flag_is_expensive                = Flag_has_call << 1,
-    _max_flags = (Flag_is_expensive << 1) - 1 // allow flags combination
+    Flag_is_reduction                = Flag_is_expensive << 1,
+    _max_flags = (Flag_is_reduction << 1) - 1 // allow flags combination
   };
 
 private:
@@ -694,6 +695,10 @@ public:
 
   const jushort flags() const { return _flags; }
 
+  void add_flag(jushort fl) { init_flags(fl); }
+
+  void remove_flag(jushort fl) { clear_flag(fl); }
+
   // Return a dense integer opcode number
   virtual int Opcode() const;
 
@@ -844,6 +849,8 @@ public:
   bool is_macro() const { return (_flags & Flag_is_macro) != 0; }
   // The node is expensive: the best control is set during loop opts
   bool is_expensive() const { return (_flags & Flag_is_expensive) != 0 && in(0) != NULL; }
+  // The node is an arithmetic operation which accumulates into a loop phi
+  bool is_reduction() const { return (_flags & Flag_is_reduction) != 0; }
 
 //----------------- Optimization
 
@@ -2221,7 +2221,17 @@ void Parse::add_safepoint() {
 
   // Create a node for the polling address
   if( add_poll_param ) {
-    Node *polladr = ConPNode::make(C, (address)os::get_polling_page());
+    Node *polladr;
+    if (ThreadLocalHandshakes) {
+      // The poll word of the thread is re-read at every safepoint, the load
+      // must not be commoned or hoisted out of loops.
+      Node* thread = _gvn.transform(new (C) ThreadLocalNode());
+      Node* adr = basic_plus_adr(top(), thread, in_bytes(JavaThread::polling_page_offset()));
+      polladr = make_load(control(), adr, TypeRawPtr::BOTTOM, T_ADDRESS, Compile::AliasIdxRaw,
+                          MemNode::unordered, LoadNode::Pinned);
+    } else {
+      polladr = ConPNode::make(C, (address)os::get_polling_page());
+    }
     sfpnt->init_req(TypeFunc::Parms+0, _gvn.transform(polladr));
   }
 
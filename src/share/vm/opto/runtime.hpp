@@ -315,6 +315,10 @@ private:
 
   static const TypeFunc* updateBytesCRC32_Type();
 
+  static const TypeFunc* stringHashCode_Type();
+
+  static const TypeFunc* vectorizedMismatch_Type();
+
   // leaf on stack replacement interpreter accessor types
   static const TypeFunc* osr_end_Type();
 
@@ -130,6 +130,8 @@ void SuperWord::transform_loop(IdealLoopTree* lpt) {
 // 6) The initial set of pack pairs is seeded with memory references.
 //
 // 7) The set of pack pairs is extended by following use->def and def->use links.
+//    The unrolled copies of a reduction (see PhaseIdealLoop::mark_reductions)
+//    depend on each other and are paired in the order of the chain.
 //
 // 8) The pairs are combined into vector sized packs.
 //
@@ -680,7 +682,7 @@ bool SuperWord::stmts_can_pack(Node* s1, Node* s2, int align) {
   }
 
   if (isomorphic(s1, s2)) {
-    if (independent(s1, s2)) {
+    if (independent(s1, s2) || reduction(s1, s2)) {
       if (!exists_at(s1, 0) && !exists_at(s2, 1)) {
         if (!s1->is_Mem() || are_adjacent_refs(s1, s2)) {
           int s1_align = alignment(s1);
@@ -779,6 +781,20 @@ bool SuperWord::independent_path(Node* shallow, Node* deep, uint dp) {
   return true;
 }
 
+//------------------------------reduction---------------------------
+// Is s1 the reduction which is immediately accumulated into by s2?
+bool SuperWord::reduction(Node* s1, Node* s2) {
+  if (!s1->is_reduction() || !s2->is_reduction()) return false;
+  if (depth(s1) + 1 != depth(s2)) return false;
+  // The reduction chain is ordered, s1 must feed s2.
+  for (DUIterator_Fast imax, i = s1->fast_outs(imax); i < imax; i++) {
+    if (s1->fast_out(i) == s2) {
+      return true;
+    }
+  }
+  return false;
+}
+
 //------------------------------set_alignment---------------------------
 void SuperWord::set_alignment(Node* s1, Node* s2, int align) {
   set_alignment(s1, align);
@@ -899,6 +915,16 @@ bool SuperWord::follow_def_uses(Node_List* p) {
 //---------------------------opnd_positions_match-------------------------
 // Is the use of d1 in u1 at the same operand position as d2 in u2?
 bool SuperWord::opnd_positions_match(Node* d1, Node* u1, Node* d2, Node* u2) {
+  if (u1->is_reduction() && u2->is_reduction()) {
+    // The accumulated value (the loop phi or the previous reduction)
+    // is kept as the first operand of a reduction.
+    if (u1->in(2)->is_Phi() || u1->in(2)->is_reduction()) {
+      u1->swap_edges(1, 2);
+    }
+    if (u2->in(2)->is_Phi() || u2->in(2)->is_reduction()) {
+      u2->swap_edges(1, 2);
+    }
+  }
   uint ct = u1->req();
   if (ct != u2->req()) return false;
   uint i1 = 0;
@@ -1108,6 +1134,11 @@ void SuperWord::filter_packs() {
 // Can code be generated for pack p?
 bool SuperWord::implemented(Node_List* p) {
   Node* p0 = p->at(0);
+  if (p0->is_reduction()) {
+    BasicType bt = p0->bottom_type()->basic_type();
+    return bt == velt_basic_type(p0) &&
+           ReductionNode::implemented(p0->Opcode(), p->size(), bt);
+  }
   return VectorNode::implemented(p0->Opcode(), p->size(), velt_basic_type(p0));
 }
 
@@ -1142,6 +1173,16 @@ bool SuperWord::profitable(Node_List* p) {
     if (!is_vector_use(p0, i))
       return false;
   }
+  if (p0->is_reduction()) {
+    // Reducing a vector costs more than the scalar operations it
+    // replaces, so only reduce vectors which are computed in the loop.
+    Node_List* in_pk = my_pack(p0->in(2));
+    if (in_pk == NULL || in_pk->at(0)->is_Mem()) {
+      return false;
+    }
+    // The result only feeds the next reduction and the loop phi.
+    return true;
+  }
   if (VectorNode::is_shift(p0)) {
     // For now, return false if shift count is vector or not scalar promotion
     // case (different shift counts) because it is not supported yet.
@@ -1445,6 +1486,17 @@ void SuperWord::output() {
         const TypePtr* atyp = n->adr_type();
         vn = StoreVectorNode::make(C, opc, ctl, mem, adr, atyp, val, vlen);
         vlen_in_bytes = vn->as_StoreVector()->memory_size();
+      } else if (n->is_reduction()) {
+        // The scalar input of the first reduction is accumulated into,
+        // the other operands are promoted to a vector.
+        Node* in1 = low_adr->in(1);
+        Node* in2 = vector_opd(p, 2);
+        vn = ReductionNode::make(C, opc, NULL, in1, in2, n->bottom_type()->basic_type());
+        if (in2->is_LoadVector()) {
+          vlen_in_bytes = in2->as_LoadVector()->memory_size();
+        } else {
+          vlen_in_bytes = in2->as_Vector()->length_in_bytes();
+        }
       } else if (n->req() == 3) {
         // Promote operands to vector
         Node* in1 = vector_opd(p, 1);
@@ -1570,6 +1622,8 @@ Node* SuperWord::vector_opd(Node_List* p, int opd_idx) {
 // use with an extract operation.
 void SuperWord::insert_extracts(Node_List* p) {
   if (p->at(0)->is_Store()) return;
+  // A reduction produces a scalar, its uses need no extracts.
+  if (p->at(0)->is_reduction()) return;
   assert(_n_idx_list.is_empty(), "empty (node,index) list");
 
   // Inspect each use of each pack member.  For each use that is
@@ -1616,6 +1670,8 @@ void SuperWord::insert_extracts(Node_List* p) {
 bool SuperWord::is_vector_use(Node* use, int u_idx) {
   Node_List* u_pk = my_pack(use);
   if (u_pk == NULL) return false;
+  // The accumulated value of a reduction stays scalar.
+  if (use->is_reduction() && u_idx == 1) return true;
   Node* def = use->in(u_idx);
   Node_List* d_pk = my_pack(def);
   if (d_pk == NULL) {
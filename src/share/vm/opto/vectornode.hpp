@@ -349,6 +349,101 @@ class XorVNode : public VectorNode {
   virtual int Opcode() const;
 };
 
+//=========================Vector=Reduction=Operations=========================
+
+//------------------------------ReductionNode----------------------------------
+// Reduce the elements of vector "in2" into the scalar "in1".  The elements
+// are combined in order, starting with element 0, so that floating point
+// reductions produce the same result as the scalar loop.
+class ReductionNode : public Node {
+ public:
+  ReductionNode(Node *ctrl, Node* in1, Node* in2) : Node(ctrl, in1, in2) {}
+
+  static ReductionNode* make(Compile* C, int opc, Node *ctrl, Node* n1, Node* n2, BasicType bt);
+  static int  opcode(int opc, BasicType bt);
+  static bool implemented(int opc, uint vlen, BasicType bt);
+};
+
+//------------------------------AddReductionVINode-----------------------------
+// Vector add int as a reduction
+class AddReductionVINode : public ReductionNode {
+ public:
+  AddReductionVINode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
+//------------------------------AddReductionVLNode-----------------------------
+// Vector add long as a reduction
+class AddReductionVLNode : public ReductionNode {
+ public:
+  AddReductionVLNode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeLong::LONG; }
+  virtual uint ideal_reg() const { return Op_RegL; }
+};
+
+//------------------------------AddReductionVFNode-----------------------------
+// Vector add float as a reduction
+class AddReductionVFNode : public ReductionNode {
+ public:
+  AddReductionVFNode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return Type::FLOAT; }
+  virtual uint ideal_reg() const { return Op_RegF; }
+};
+
+//------------------------------AddReductionVDNode-----------------------------
+// Vector add double as a reduction
+class AddReductionVDNode : public ReductionNode {
+ public:
+  AddReductionVDNode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return Type::DOUBLE; }
+  virtual uint ideal_reg() const { return Op_RegD; }
+};
+
+//------------------------------MulReductionVINode-----------------------------
+// Vector multiply int as a reduction
+class MulReductionVINode : public ReductionNode {
+ public:
+  MulReductionVINode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
+//------------------------------MulReductionVLNode-----------------------------
+// Vector multiply long as a reduction
+class MulReductionVLNode : public ReductionNode {
+ public:
+  MulReductionVLNode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeLong::LONG; }
+  virtual uint ideal_reg() const { return Op_RegL; }
+};
+
+//------------------------------MulReductionVFNode-----------------------------
+// Vector multiply float as a reduction
+class MulReductionVFNode : public ReductionNode {
+ public:
+  MulReductionVFNode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return Type::FLOAT; }
+  virtual uint ideal_reg() const { return Op_RegF; }
+};
+
+//------------------------------MulReductionVDNode-----------------------------
+// Vector multiply double as a reduction
+class MulReductionVDNode : public ReductionNode {
+ public:
+  MulReductionVDNode(Node *ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return Type::DOUBLE; }
+  virtual uint ideal_reg() const { return Op_RegD; }
+};
+
 //================================= M E M O R Y ===============================
 
 //------------------------------LoadVectorNode---------------------------------
@@ -5105,6 +5105,7 @@ void TestResourcehash_test();
 void TestChunkedList_test();
 #if INCLUDE_ALL_GCS
 void TestOldFreeSpaceCalculation_test();
+void TestGCTaskManager_test();
 void TestG1BiasedArray_test();
 void TestBufferingOopClosure_test();
 void TestCodeCacheRemSet_test();
@@ -5152,6 +5153,9 @@ void execute_internal_vm_tests() {
     if (UseG1GC) {
       run_unit_test(FreeRegionList_test());
     }
+    if (UseParallelGC) {
+      run_unit_test(TestGCTaskManager_test());
+    }
 #endif
     tty->print_cr("All internal VM tests passed");
   }
@@ -1735,6 +1735,12 @@ void Arguments::set_gc_specific_flags() {
   }
   check_deprecated_gcs();
   check_deprecated_gc_flags();
+  // The number of reference processing workers follows the number of
+  // discovered references, so a few references stay on a single worker.
+  if (FLAG_IS_DEFAULT(ParallelRefProcEnabled) && ReferencesPerThread > 0 &&
+      ParallelGCThreads > 1) {
+    FLAG_SET_ERGO(bool, ParallelRefProcEnabled, true);
+  }
   if (AssumeMP && !UseSerialGC) {
     if (FLAG_IS_DEFAULT(ParallelGCThreads) && ParallelGCThreads == 1) {
       warning("If the number of processors is expected to increase from one, then"
@@ -2316,6 +2322,7 @@ bool Arguments::check_vm_args_consistency() {
   status = status && verify_interval(AdaptiveSizePolicyWeight, 0, 100,
                               "AdaptiveSizePolicyWeight");
   status = status && verify_percentage(ThresholdTolerance, "ThresholdTolerance");
+  status = status && verify_interval(HeapDumpGzipLevel, 0, 9, "HeapDumpGzipLevel");
 
   // Divide by bucket size to prevent a large size from causing rollover when
   // calculating amount of memory needed to be allocated for the String table.
@@ -2325,6 +2332,29 @@ bool Arguments::check_vm_args_consistency() {
   status = status && verify_interval(SymbolTableSize, minimumSymbolTableSize,
     (max_uintx / SymbolTable::bucket_size()), "SymbolTable size");
 
+  if (AsyncDeflateIdleMonitors) {
+    status = status && verify_min_value(AsyncDeflationInterval, 1, "AsyncDeflationInterval");
+    // The service thread scans the monitor blocks; the per-thread in-use
+    // lists can only be walked at safepoints.
+    if (MonitorInUseLists) {
+      warning("-XX:+MonitorInUseLists is disabled by -XX:+AsyncDeflateIdleMonitors");
+      FLAG_SET_DEFAULT(MonitorInUseLists, false);
+    }
+  }
+
+#if !defined(AMD64) || defined(CC_INTERP)
+  // Only the 64-bit x86 template interpreter and compilers poll the
+  // thread-local poll word.
+  if (ThreadLocalHandshakes) {
+    warning("-XX:+ThreadLocalHandshakes is not supported on this platform");
+    FLAG_SET_DEFAULT(ThreadLocalHandshakes, false);
+  }
+#endif
+  if (ThreadLocalHandshakes && !UseCompilerSafepoints) {
+    // Compiled code without polls would never see a handshake.
+    FLAG_SET_DEFAULT(ThreadLocalHandshakes, false);
+  }
+
   {
     // Using "else if" below to avoid printing two error messages if min > max.
     // This will also prevent us from reporting both min>100 and max>100 at the
@@ -4249,10 +4279,11 @@ jint Arguments::adjust_after_os() {
     // platforms when UseNUMA is set to ON. NUMA-aware collectors
     // such as the parallel collector for Linux and Solaris will
     // interleave old gen and survivor spaces on top of NUMA
-    // allocation policy for the eden space.
-    // Non NUMA-aware collectors such as CMS, G1 and Serial-GC on
-    // all platforms and ParallelGC on Windows will interleave all
-    // of the heap spaces across NUMA nodes.
+    // allocation policy for the eden space. The eden of ParNew and
+    // Serial-GC is split into node-local chunks in the same way. G1 on
+    // Linux binds the memory of every heap region to a node when it is
+    // committed. On Windows all of the heap spaces are interleaved
+    // across NUMA nodes.
     if (FLAG_IS_DEFAULT(UseNUMAInterleaving)) {
       FLAG_SET_ERGO(bool, UseNUMAInterleaving, true);
     }
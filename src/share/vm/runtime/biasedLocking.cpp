@@ -27,6 +27,7 @@
 #include "oops/markOop.hpp"
 #include "runtime/basicLock.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/task.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
@@ -503,6 +504,47 @@ public:
 };
 
 
+// Revokes the bias of an object biased toward another live thread with a
+// handshake, so that only the stack of the biaser is walked and the other
+// threads keep running.
+class RevokeOneBias : public HandshakeClosure {
+  Handle _obj;
+  JavaThread* _biased_locker;
+  bool _revoked;
+
+public:
+  RevokeOneBias(Handle obj, JavaThread* biased_locker)
+    : HandshakeClosure("RevokeOneBias")
+    , _obj(obj)
+    , _biased_locker(biased_locker)
+    , _revoked(false) {}
+
+  bool revoked() const { return _revoked; }
+
+  void do_thread(Thread* target) {
+    assert(target == _biased_locker, "wrong thread");
+    oop obj = _obj();
+    markOop mark = obj->mark();
+    markOop prototype_header = obj->klass()->prototype_header();
+    // As long as the bias is valid only the biaser changes the mark word.
+    // Any other state is left to the revocation at a safepoint.
+    if (!mark->has_bias_pattern() ||
+        !prototype_header->has_bias_pattern() ||
+        mark->biased_locker() != _biased_locker ||
+        mark->bias_epoch() != prototype_header->bias_epoch()) {
+      return;
+    }
+    if (TraceBiasedLocking) {
+      tty->print_cr("Revoking bias with a handshake:");
+    }
+    // The biaser is stopped and alive, it is its own requesting thread.
+    revoke_bias(obj, false, false, _biased_locker);
+    _biased_locker->set_cached_monitor_info(NULL);
+    _revoked = true;
+  }
+};
+
+
 class VM_BulkRevokeBias : public VM_RevokeBias {
 private:
   bool _bulk_rebias;
@@ -614,6 +656,16 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
       assert(cond == BIAS_REVOKED, "why not?");
       return cond;
     } else {
+      JavaThread* biaser = mark->biased_locker();
+      if (ThreadLocalHandshakes && biaser != NULL &&
+          prototype_header->bias_epoch() == mark->bias_epoch()) {
+        // Only the biaser has to be stopped to walk its stack.
+        RevokeOneBias revoke(obj, biaser);
+        Handshake::execute(&revoke, biaser);
+        if (revoke.revoked()) {
+          return BIAS_REVOKED;
+        }
+      }
       VM_RevokeBias revoke(&obj, (JavaThread*) THREAD);
       VMThread::execute(&revoke);
       return revoke.status_code();
@@ -640,6 +692,27 @@ void BiasedLocking::revoke(GrowableArray<Handle>* objs) {
 }
 
 
+void BiasedLocking::revoke_in_handshake(GrowableArray<Handle>* objs, JavaThread* biaser) {
+  assert(!SafepointSynchronize::is_at_safepoint(), "must not be called while at safepoint");
+  assert(biaser->is_handshake_safe_for(Thread::current()), "biaser must be stopped");
+  bool revoked = false;
+  for (int i = 0; i < objs->length(); i++) {
+    oop obj = (objs->at(i))();
+    markOop mark = obj->mark();
+    if (mark->has_bias_pattern()) {
+      // The object is locked by the biaser, so the bias is valid and only
+      // the biaser could change the mark word.
+      assert(mark->biased_locker() == biaser, "locked object must be biased toward its owner");
+      revoke_bias(obj, false, false, biaser);
+      revoked = true;
+    }
+  }
+  if (revoked) {
+    biaser->set_cached_monitor_info(NULL);
+  }
+}
+
+
 void BiasedLocking::revoke_at_safepoint(Handle h_obj) {
   assert(SafepointSynchronize::is_at_safepoint(), "must only be called while at safepoint");
   oop obj = h_obj();
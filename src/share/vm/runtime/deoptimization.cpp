@@ -40,6 +40,7 @@
 #include "runtime/biasedLocking.hpp"
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/deoptimization.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/signature.hpp"
@@ -1164,6 +1165,8 @@ void Deoptimization::revoke_biases_of_monitors(JavaThread* thread, frame fr, Reg
 
   if (SafepointSynchronize::is_at_safepoint()) {
     BiasedLocking::revoke_at_safepoint(objects_to_revoke);
+  } else if (thread->is_handshake_safe_for(Thread::current())) {
+    BiasedLocking::revoke_in_handshake(objects_to_revoke, thread);
   } else {
     BiasedLocking::revoke(objects_to_revoke);
   }
@@ -1228,8 +1231,9 @@ void Deoptimization::deoptimize(JavaThread* thread, frame fr, RegisterMap *map)
 
 
 void Deoptimization::deoptimize_frame_internal(JavaThread* thread, intptr_t* id) {
-  assert(thread == Thread::current() || SafepointSynchronize::is_at_safepoint(),
-         "can only deoptimize other thread at a safepoint");
+  assert(thread == Thread::current() || SafepointSynchronize::is_at_safepoint() ||
+         thread->is_handshake_safe_for(Thread::current()),
+         "can only deoptimize other thread at a safepoint or in a handshake");
   // Compute frame and register map based on thread and sp.
   RegisterMap reg_map(thread, UseBiasedLocking);
   frame fr = thread->last_frame();
@@ -1240,9 +1244,22 @@ void Deoptimization::deoptimize_frame_internal(JavaThread* thread, intptr_t* id)
 }
 
 
+class DeoptimizeFrameClosure : public HandshakeClosure {
+  intptr_t* _id;
+ public:
+  DeoptimizeFrameClosure(intptr_t* id) : HandshakeClosure("DeoptimizeFrame"), _id(id) {}
+  void do_thread(Thread* thread) {
+    Deoptimization::deoptimize_frame_internal((JavaThread*)thread, _id);
+  }
+};
+
 void Deoptimization::deoptimize_frame(JavaThread* thread, intptr_t* id) {
   if (thread == Thread::current()) {
     Deoptimization::deoptimize_frame_internal(thread, id);
+  } else if (ThreadLocalHandshakes && Thread::current()->is_Java_thread()) {
+    // Only the thread owning the frame has to be stopped.
+    DeoptimizeFrameClosure deopt(id);
+    Handshake::execute(&deopt, thread);
   } else {
     VM_DeoptimizeFrame deopt(thread, id);
     VMThread::execute(&deopt);
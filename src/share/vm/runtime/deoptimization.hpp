@@ -234,13 +234,13 @@ class Deoptimization : AllStatic {
   static void uncommon_trap_inner(JavaThread* thread, jint unloaded_class_index);
 
   //** Deoptimizes the frame identified by id.
-  // Only called from VMDeoptimizeFrame
+  // Only called from VMDeoptimizeFrame or a handshake
   // @argument thread.     Thread where stub_frame resides.
   // @argument id.         id of frame that should be deoptimized.
   static void deoptimize_frame_internal(JavaThread* thread, intptr_t* id);
 
-  // If thread is not the current thread then execute
-  // VM_DeoptimizeFrame otherwise deoptimize directly.
+  // If thread is not the current thread then deoptimize in a handshake
+  // or execute VM_DeoptimizeFrame, otherwise deoptimize directly.
   static void deoptimize_frame(JavaThread* thread, intptr_t* id);
 
   // Statistics
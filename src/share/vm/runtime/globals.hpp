@@ -573,6 +573,10 @@ class CommandLineFlags {
   product(bool, ForceNUMA, false,                                           \
           "Force NUMA optimizations on single-node/UMA systems")            \
                                                                             \
+  diagnostic(uintx, NUMAEdenChunks, 0,                                      \
+          "Number of chunks of the NUMA eden of DefNew and ParNew, spread "  \
+          "round-robin over the NUMA nodes. 0 means one chunk per node")    \
+                                                                            \
   product(uintx, NUMAChunkResizeWeight, 20,                                 \
           "Percentage (0-100) used to weigh the current sample when "       \
           "computing exponentially decaying average for "                   \
@@ -723,6 +727,14 @@ class CommandLineFlags {
   product(bool, UseCRC32Intrinsics, false,                                  \
           "use intrinsics for java.util.zip.CRC32")                         \
                                                                             \
+  product(bool, UseStringIntrinsicStubs, false,                             \
+          "Use stubs for String.hashCode in C1 and C2, and for "            \
+          "String.equals and String.compareTo in C1")                       \
+                                                                            \
+  product(bool, UseVectorizedMismatchIntrinsic, false,                      \
+          "Enables intrinsification of java.util.Arrays.equals for "        \
+          "primitive arrays")                                               \
+                                                                            \
   develop(bool, TraceCallFixup, false,                                      \
           "Trace all call fixups")                                          \
                                                                             \
@@ -926,6 +938,14 @@ class CommandLineFlags {
           "directory) of the dump file (defaults to java_pid<pid>.hprof "   \
           "in the working directory)")                                      \
                                                                             \
+  manageable(uintx, HeapDumpGzipLevel, 0,                                   \
+          "When non-zero, the heap dump is written as a gzip file using "   \
+          "the given compression level (1-9)")                              \
+                                                                            \
+  product(bool, HeapDumpParallel, false,                                    \
+          "Use the GC worker threads to dump the objects of the heap, if "  \
+          "supported by the garbage collector")                             \
+                                                                            \
   develop(uintx, SegmentedHeapDumpThreshold, 2*G,                           \
           "Generate a segmented heap dump (JAVA PROFILE 1.0.2 format) "     \
           "when the heap usage is larger than this")                        \
@@ -1146,6 +1166,14 @@ class CommandLineFlags {
                                                                             \
   product(bool, MonitorInUseLists, false, "Track Monitors for Deflation")   \
                                                                             \
+  product(bool, AsyncDeflateIdleMonitors, false,                            \
+          "Deflate idle monitors in the service thread instead of at "      \
+          "safepoints. Disables MonitorInUseLists")                         \
+                                                                            \
+  product(intx, AsyncDeflationInterval, 250,                                \
+          "Minimum time in ms between the concurrent deflation passes "     \
+          "of the service thread")                                          \
+                                                                            \
   product(intx, SyncFlags, 0, "(Unsafe, Unstable) Experimental Sync flags") \
                                                                             \
   product(intx, SyncVerbose, 0, "(Unstable)")                               \
@@ -1449,6 +1477,10 @@ class CommandLineFlags {
           "Size of heap (bytes) per GC thread used in calculating the "     \
           "number of GC threads")                                           \
                                                                             \
+  product(uintx, DynamicGCThreadsMinWorkMillis, 1,                          \
+          "Minimum time (ms) of work for each GC thread of a parallel "     \
+          "phase when the number of GC threads is chosen dynamically")      \
+                                                                            \
   product(bool, TraceDynamicGCThreads, false,                               \
           "Trace the dynamic GC thread usage")                              \
                                                                             \
@@ -1585,6 +1617,11 @@ class CommandLineFlags {
           "Number of blocks to attempt to claim when refilling CMS LAB's "  \
           "for parallel GC")                                                \
                                                                             \
+  product(uintx, CMSParPromoteSharedBatches, 2,                             \
+          "Number of additional batches of blocks a CMS LAB refill takes "  \
+          "from the global free lists to hand to other GC worker threads "  \
+          "without locking")                                                \
+                                                                            \
   product(uintx, OldPLABWeight, 50,                                         \
           "Percentage (0-100) used to weight the current sample when "      \
           "computing exponentially decaying average for resizing "          \
@@ -1819,6 +1856,10 @@ class CommandLineFlags {
           "Whether multi-threaded concurrent work enabled "                 \
           "(effective only if ParNewGC)")                                   \
                                                                             \
+  product(bool, CMSParallelSweepEnabled, true,                              \
+          "Whether the sweep is done by the concurrent GC threads in "      \
+          "parallel (effective only if CMSConcurrentMTEnabled)")            \
+                                                                            \
   product(bool, CMSPrecleaningEnabled, true,                                \
           "Whether concurrent precleaning enabled")                         \
                                                                             \
@@ -1937,6 +1978,15 @@ class CommandLineFlags {
   product(bool, ParallelRefProcBalancingEnabled, true,                      \
           "Enable balancing of reference processing queues")                \
                                                                             \
+  product(bool, PrecleanFinalReferents, true,                               \
+          "Concurrently trace from the referents of discovered "            \
+          "FinalReferences before the remark pause of CMS and G1")          \
+                                                                            \
+  product(uintx, ReferencesPerThread, 1000,                                 \
+          "Number of discovered references of a type per worker thread "    \
+          "in parallel reference processing. Zero uses all active "         \
+          "workers")                                                        \
+                                                                            \
   product(uintx, CMSTriggerRatio, 80,                                       \
           "Percentage of MinHeapFreeRatio in CMS generation that is "       \
           "allocated before a CMS collection cycle commences")              \
@@ -2005,6 +2055,10 @@ class CommandLineFlags {
   experimental(uintx, WorkStealingSleepMillis, 1,                           \
           "Sleep time when sleep is used for yields")                       \
                                                                             \
+  product(bool, UseOWSTTaskTerminator, true,                                \
+          "Let only one of the GC threads offering termination spin and "   \
+          "poll for work, and block the others until there is work")        \
+                                                                            \
   experimental(uintx, WorkStealingYieldsBeforeSleep, 5000,                  \
           "Number of yields before a sleep is done during workstealing")    \
                                                                             \
@@ -2332,6 +2386,10 @@ class CommandLineFlags {
   product(bool, UseGCTaskAffinity, false,                                   \
           "Use worker affinity when asking for GCTasks")                    \
                                                                             \
+  product(bool, UseGCTaskStealing, false,                                   \
+          "Hand out the GCTasks of the parallel collectors from lock free " \
+          "task queues instead of under the GCTaskManager monitor")         \
+                                                                            \
   product(uintx, ProcessDistributionStride, 4,                              \
           "Stride through processors when distributing processes")          \
                                                                             \
@@ -2595,6 +2653,10 @@ class CommandLineFlags {
           "Print the break down of clean up tasks performed during "        \
           "safepoint")                                                      \
                                                                             \
+  product(bool, ParallelSafepointCleanup, false,                            \
+          "Perform the safepoint clean up tasks with the GC worker "        \
+          "threads, if the collector has any")                              \
+                                                                            \
   product(bool, Inline, true,                                               \
           "Enable inlining")                                                \
                                                                             \
@@ -3269,6 +3331,10 @@ class CommandLineFlags {
   product(uintx, MaxMetaspaceExpansion, ScaleForWordSize(4*M),              \
           "The maximum expansion of Metaspace without full GC (in bytes)")  \
                                                                             \
+  product(bool, MetaspaceUncommitFreeChunks, true,                          \
+          "Uncommit the memory of free medium and humongous Metaspace "     \
+          "chunks until they are used again")                               \
+                                                                            \
   product(uintx, QueuedAllocationWarningCount, 0,                           \
           "Number of times an allocation that queues behind a GC "          \
           "will retry before printing a warning")                           \
@@ -3328,6 +3394,10 @@ class CommandLineFlags {
           "(Unsafe,Unstable) Number of iterations in safepoint loop "       \
           "before changing safepoint polling page to RO ")                  \
                                                                             \
+  product_pd(bool, ThreadLocalHandshakes,                                   \
+          "Use a poll word per thread so that operations on a single "      \
+          "thread can be executed without a global safepoint")              \
+                                                                            \
   product(intx, SafepointSpinBeforeYield, 2000, "(Unstable)")               \
                                                                             \
   product(bool, PSChunkLargeArrays, true,                                   \
@@ -3386,6 +3456,22 @@ class CommandLineFlags {
   product_pd(uintx, ReservedCodeCacheSize,                                  \
           "Reserved code cache size (in bytes) - maximum code cache size")  \
                                                                             \
+  product(bool, SegmentedCodeCache, false,                                  \
+          "Use a segmented code cache with separate code heaps for "        \
+          "non-nmethods, profiled and non-profiled nmethods")               \
+                                                                            \
+  product(uintx, NonNMethodCodeHeapSize, 0,                                 \
+          "Size of the code heap for non-nmethods (in bytes) if the code "  \
+          "cache is segmented, 0 selects the size ergonomically")           \
+                                                                            \
+  product(uintx, ProfiledCodeHeapSize, 0,                                   \
+          "Size of the code heap for profiled nmethods (in bytes) if the "  \
+          "code cache is segmented, 0 selects the size ergonomically")      \
+                                                                            \
+  product(uintx, NonProfiledCodeHeapSize, 0,                                \
+          "Size of the code heap for non-profiled nmethods (in bytes) if "  \
+          "the code cache is segmented, 0 selects the size ergonomically")  \
+                                                                            \
   product(uintx, CodeCacheMinimumFreeSpace, 500*K,                          \
           "When less than X space left, we stop compiling")                 \
                                                                             \
@@ -3920,10 +4006,14 @@ class CommandLineFlags {
           "Print the DTrace DOF passed to the system for JSDT probes")      \
                                                                             \
   product(uintx, StringTableSize, defaultStringTableSize,                   \
-          "Number of buckets in the interned String table")                 \
+          "Initial number of buckets in the interned String table")         \
                                                                             \
   experimental(uintx, SymbolTableSize, defaultSymbolTableSize,              \
-          "Number of buckets in the JVM internal Symbol table")             \
+          "Initial number of buckets in the JVM internal Symbol table")     \
+                                                                            \
+  product(bool, ConcurrentStringSymbolTableWork, true,                      \
+          "Grow the String and Symbol tables and remove unreferenced "      \
+          "symbols in the service thread")                                  \
                                                                             \
   product(bool, UseStringDeduplication, false,                              \
           "Use string deduplication")                                       \
@@ -3977,6 +4067,10 @@ class CommandLineFlags {
   product(ccstr, ExtraSharedClassListFile, NULL,                            \
           "Extra classlist for building the CDS archive file")              \
                                                                             \
+  product(bool, UseAppCDS, false,                                           \
+          "Archive classes of the extension and application class paths "   \
+          "with -Xshare:dump and load them from the CDS archive")           \
+                                                                            \
   experimental(uintx, ArrayAllocatorMallocLimit,                            \
           SOLARIS_ONLY(64*K) NOT_SOLARIS(max_uintx),                        \
           "Allocation less than this value will be allocated "              \
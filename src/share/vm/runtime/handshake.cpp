@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/vmThread.hpp"
+#include "runtime/vm_operations.hpp"
+
+// Installs the operation for the target and waits until the target has
+// executed it, or until the target is safe and the operation can be
+// executed by the VM thread. The other threads keep running.
+class VM_HandshakeOneThread: public VM_Operation {
+  HandshakeClosure* _op;
+  JavaThread*       _target;
+  bool              _executed;
+
+ public:
+  VM_HandshakeOneThread(HandshakeClosure* op, JavaThread* target) :
+    _op(op), _target(target), _executed(false) {}
+
+  VMOp_Type type() const      { return VMOp_HandshakeOneThread; }
+  Mode evaluation_mode() const { return _no_safepoint; }
+  bool executed() const       { return _executed; }
+
+  void doit();
+};
+
+void VM_HandshakeOneThread::doit() {
+  HandshakeState* state = _target->handshake_state();
+  {
+    MutexLockerEx ml(Threads_lock, Mutex::_no_safepoint_check_flag);
+    if (!Threads::includes(_target)) {
+      return;
+    }
+    state->set_operation(_target, _op);
+  }
+  // Once installed the operation is executed, if need be by the target
+  // itself when it leaves the thread list.
+  _executed = true;
+
+  // The target must see the pending operation when it changes its thread
+  // state, or we must see the new state, see the transitions in
+  // interfaceSupport.hpp.
+  if (!UseMembar) {
+    os::serialize_thread_states();
+  }
+
+  int ncpus = os::processor_count();
+  for (uint iterations = 0; ; iterations++) {
+    {
+      MutexLockerEx ml(Threads_lock, Mutex::_no_safepoint_check_flag);
+      if (!Threads::includes(_target) || state->try_process_by_vm_thread(_target)) {
+        break;
+      }
+    }
+    if (ncpus > 1 && iterations < (uint)SafepointSpinBeforeYield) {
+      SpinPause();
+    } else if (iterations < (uint)SafepointSpinBeforeYield + 100) {
+      os::NakedYield();
+    } else {
+      os::naked_short_sleep(1);
+    }
+  }
+}
+
+// Executes the operation at a safepoint, used when the platform has no
+// thread-local polls.
+class VM_HandshakeFallback: public VM_Operation {
+  HandshakeClosure* _op;
+  JavaThread*       _target;
+  bool              _executed;
+
+ public:
+  VM_HandshakeFallback(HandshakeClosure* op, JavaThread* target) :
+    _op(op), _target(target), _executed(false) {}
+
+  VMOp_Type type() const { return VMOp_HandshakeFallback; }
+  bool executed() const  { return _executed; }
+
+  void doit() {
+    if (Threads::includes(_target)) {
+      ResourceMark rm;
+      HandleMark hm;
+      _op->do_thread(_target);
+      _executed = true;
+    }
+  }
+};
+
+bool Handshake::execute(HandshakeClosure* op, JavaThread* target) {
+  Thread* self = Thread::current();
+  assert(self->is_Java_thread(), "handshakes are requested by Java threads");
+  assert(!Threads_lock->owned_by_self(), "the VM thread needs the Threads_lock");
+
+  if (target == self) {
+    op->do_thread(target);
+    return true;
+  }
+  if (ThreadLocalHandshakes) {
+    VM_HandshakeOneThread handshake(op, target);
+    VMThread::execute(&handshake);
+    return handshake.executed();
+  } else {
+    VM_HandshakeFallback handshake(op, target);
+    VMThread::execute(&handshake);
+    return handshake.executed();
+  }
+}
+
+bool HandshakeState::claim(Thread* thread) {
+  return Atomic::cmpxchg_ptr(thread, &_active_handshaker, NULL) == NULL;
+}
+
+void HandshakeState::release() {
+  OrderAccess::release_store_ptr(&_active_handshaker, NULL);
+}
+
+void HandshakeState::set_operation(JavaThread* target, HandshakeClosure* op) {
+  assert(Thread::current()->is_VM_thread(), "only the VM thread installs operations");
+  assert(_operation == NULL, "only one operation at a time");
+  _operation = op;
+  target->set_handshake_pending();
+  SafepointSynchronize::arm_local_poll(target);
+}
+
+void HandshakeState::clear_operation(JavaThread* target) {
+  _operation = NULL;
+  SafepointSynchronize::disarm_local_poll(target);
+  target->clear_handshake_pending();
+}
+
+void HandshakeState::execute(JavaThread* target) {
+  assert(_active_handshaker == Thread::current(), "must have claimed the operation");
+  {
+    Thread* thread = Thread::current();
+    ResourceMark rm(thread);
+    HandleMark hm(thread);
+    _operation->do_thread(target);
+  }
+  clear_operation(target);
+}
+
+void HandshakeState::process_by_self(JavaThread* target) {
+  assert(target == Thread::current(), "must be the target");
+  if (_processing) {
+    // A thread state transition inside the operation.
+    return;
+  }
+
+  // The operation may walk the stack and take locks.
+  JavaThreadState state = target->thread_state();
+  target->frame_anchor()->make_walkable(target);
+  target->set_thread_state(_thread_in_vm);
+
+  while (!claim(target)) {
+    // The VM thread is executing the operation on our behalf.
+    os::NakedYield();
+  }
+  if (has_operation()) {
+    _processing = true;
+    execute(target);
+    _processing = false;
+  }
+  release();
+
+  target->set_thread_state(state);
+}
+
+bool HandshakeState::try_process_by_vm_thread(JavaThread* target) {
+  assert(Thread::current()->is_VM_thread(), "must be the VM thread");
+  assert(Threads_lock->owned_by_self(), "the target must not exit");
+
+  if (!has_operation()) {
+    return true;
+  }
+  if (!claim(Thread::current())) {
+    // The target is executing the operation.
+    return false;
+  }
+  // The claim is a full fence, the state read below is current. The target
+  // checks for the operation after it leaves a safe state and then waits
+  // until the claim is released.
+  bool done = true;
+  if (has_operation()) {
+    JavaThreadState state = target->thread_state();
+    if (state == _thread_new || SafepointSynchronize::safepoint_safe(target, state)) {
+      execute(target);
+    } else {
+      done = false;
+    }
+  }
+  release();
+  return done;
+}
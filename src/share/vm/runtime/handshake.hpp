@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_RUNTIME_HANDSHAKE_HPP
+#define SHARE_VM_RUNTIME_HANDSHAKE_HPP
+
+#include "memory/allocation.hpp"
+
+class JavaThread;
+class Thread;
+
+// A handshake is an operation executed for a single JavaThread while that
+// thread is stopped, without stopping the other threads of the VM. The
+// operation is executed either by the target thread itself, when it polls
+// or changes its thread state, or by the VM thread on its behalf while the
+// target is blocked or in native code. In both cases the Java frames of the
+// target do not change while the operation runs.
+//
+// With -XX:+ThreadLocalHandshakes every JavaThread has a poll word of its
+// own, which the interpreter and compiled code test at their safepoint
+// polls, so that a single thread can be stopped. Otherwise handshakes are
+// executed at a global safepoint.
+//
+// Handshake operations must not block on locks held by threads waiting for
+// a VM operation, and must not take the Threads_lock.
+class HandshakeClosure : public StackObj {
+  const char* const _name;
+ public:
+  HandshakeClosure(const char* name) : _name(name) {}
+  const char* name() const { return _name; }
+  virtual void do_thread(Thread* thread) = 0;
+};
+
+class Handshake : public AllStatic {
+ public:
+  // Executes the operation for the target thread. Returns false if the
+  // target exited before the operation could be executed.
+  static bool execute(HandshakeClosure* op, JavaThread* target);
+};
+
+// The handshake state of a JavaThread. At most one operation is pending for
+// a thread at any time since operations are installed by the VM thread.
+class HandshakeState VALUE_OBJ_CLASS_SPEC {
+  HandshakeClosure* volatile _operation;
+  // The thread executing the operation, claimed with a CAS so that the VM
+  // thread and the target never execute it at the same time.
+  Thread* volatile           _active_handshaker;
+  // Set while the target executes the operation itself, so that thread state
+  // transitions inside the operation do not process it recursively.
+  bool                       _processing;
+
+  bool claim(Thread* thread);
+  void release();
+  void clear_operation(JavaThread* target);
+  void execute(JavaThread* target);
+
+ public:
+  HandshakeState() : _operation(NULL), _active_handshaker(NULL), _processing(false) {}
+
+  void set_operation(JavaThread* target, HandshakeClosure* op);
+  bool has_operation() const { return _operation != NULL; }
+
+  Thread* active_handshaker() const { return _active_handshaker; }
+
+  // Executes the pending operation, called by the target thread itself.
+  void process_by_self(JavaThread* target);
+  // Executes the pending operation if the target is in a safe state, called
+  // by the VM thread. Returns true once no operation is pending anymore.
+  bool try_process_by_vm_thread(JavaThread* target);
+};
+
+#endif // SHARE_VM_RUNTIME_HANDSHAKE_HPP
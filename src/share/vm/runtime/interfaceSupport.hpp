@@ -149,8 +149,8 @@ class ThreadStateTransition : public StackObj {
       }
     }
 
-    if (SafepointSynchronize::do_call_back()) {
-      SafepointSynchronize::block(thread);
+    if (SafepointSynchronize::do_call_back() || thread->has_handshake()) {
+      SafepointSynchronize::block_if_requested(thread);
     }
     thread->set_thread_state(to);
 
@@ -180,8 +180,8 @@ class ThreadStateTransition : public StackObj {
       }
     }
 
-    if (SafepointSynchronize::do_call_back()) {
-      SafepointSynchronize::block(thread);
+    if (SafepointSynchronize::do_call_back() || thread->has_handshake()) {
+      SafepointSynchronize::block_if_requested(thread);
     }
     thread->set_thread_state(to);
 
@@ -216,7 +216,8 @@ class ThreadStateTransition : public StackObj {
     // We never install asynchronous exceptions when coming (back) in
     // to the runtime from native code because the runtime is not set
     // up to handle exceptions floating around at arbitrary points.
-    if (SafepointSynchronize::do_call_back() || thread->is_suspend_after_native()) {
+    if (SafepointSynchronize::do_call_back() || thread->is_suspend_after_native() ||
+        thread->has_handshake()) {
       JavaThread::check_safepoint_and_suspend_for_native_trans(thread);
 
       // Clear unhandled oops anywhere where we could block, even if we don't.
@@ -315,7 +315,7 @@ bool ObjectMonitor::try_enter(Thread* THREAD) {
   }
 }
 
-void ATTR ObjectMonitor::enter(TRAPS) {
+bool ATTR ObjectMonitor::enter(TRAPS) {
   // The following code is ordered to check the most common cases first
   // and to reduce RTS->RTO cache line upgrades on SPARC and IA32 processors.
   Thread * const Self = THREAD ;
@@ -327,13 +327,13 @@ void ATTR ObjectMonitor::enter(TRAPS) {
      assert (_recursions == 0   , "invariant") ;
      assert (_owner      == Self, "invariant") ;
      // CONSIDER: set or assert OwnerIsThread == 1
-     return ;
+     return true ;
   }
 
   if (cur == Self) {
      // TODO-FIXME: check for integer overflow!  BUGID 6557169.
      _recursions ++ ;
-     return ;
+     return true ;
   }
 
   if (Self->is_lock_owned ((address)cur)) {
@@ -343,7 +343,7 @@ void ATTR ObjectMonitor::enter(TRAPS) {
     // a full-fledged "Thread *".
     _owner = Self ;
     OwnerIsThread = 1 ;
-    return ;
+    return true ;
   }
 
   // We've encountered genuine contention.
@@ -360,7 +360,7 @@ void ATTR ObjectMonitor::enter(TRAPS) {
      assert (_recursions == 0    , "invariant") ;
      assert (((oop)(object()))->mark() == markOopDesc::encode(this), "invariant") ;
      Self->_Stalled = 0 ;
-     return ;
+     return true ;
   }
 
   assert (_owner != Self          , "invariant") ;
@@ -370,12 +370,22 @@ void ATTR ObjectMonitor::enter(TRAPS) {
   assert (!SafepointSynchronize::is_at_safepoint(), "invariant") ;
   assert (jt->thread_state() != _thread_blocked   , "invariant") ;
   assert (this->object() != NULL  , "invariant") ;
-  assert (_count >= 0, "invariant") ;
+  assert (_count >= 0 || AsyncDeflateIdleMonitors, "invariant") ;
 
   // Prevent deflation at STW-time.  See deflate_idle_monitors() and is_busy().
   // Ensure the object-monitor relationship remains stable while there's contention.
   Atomic::inc_ptr(&_count);
 
+  if (is_being_async_deflated()) {
+    // The service thread deflated the monitor before the increment above
+    // could keep it alive. Help it restore the object's header, so that
+    // the caller finds the object unlocked when it inflates it again.
+    install_displaced_markword_in_object();
+    Atomic::dec_ptr(&_count);
+    Self->_Stalled = 0 ;
+    return false ;
+  }
+
   EventJavaMonitorEnter event;
 
   { // Change java thread status to indicate blocked on monitor enter.
@@ -472,6 +482,14 @@ void ATTR ObjectMonitor::enter(TRAPS) {
   }
 
   OM_PERFDATA_OP(ContendedLockAttempts, inc());
+  return true;
+}
+
+void ObjectMonitor::install_displaced_markword_in_object() {
+  oop obj = (oop) object();
+  markOop dmw = header();
+  assert (dmw->is_neutral(), "invariant") ;
+  Atomic::cmpxchg_ptr (dmw, obj->mark_addr(), markOopDesc::encode(this)) ;
 }
 
 
@@ -1390,16 +1408,18 @@ intptr_t ObjectMonitor::complete_exit(TRAPS) {
 
 // reenter() enters a lock and sets recursion count
 // complete_exit/reenter operate as a wait without waiting
-void ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
+bool ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
    Thread * const Self = THREAD;
    assert(Self->is_Java_thread(), "Must be Java thread!");
    JavaThread *jt = (JavaThread *)THREAD;
 
    guarantee(_owner != Self, "reenter already owner");
-   enter (THREAD);       // enter the monitor
+   if (!enter (THREAD)) {  // enter the monitor
+     return false;         // deflated while the thread did not own it
+   }
    guarantee (_recursions == 0, "reenter recursion");
    _recursions = recursions;
-   return;
+   return true;
 }
 
 
@@ -1640,7 +1660,9 @@ void ObjectMonitor::wait(jlong millis, bool interruptible, TRAPS) {
      assert (_owner != Self, "invariant") ;
      ObjectWaiter::TStates v = node.TState ;
      if (v == ObjectWaiter::TS_RUN) {
-         enter (Self) ;
+         // _waiters keeps the monitor from being deflated.
+         DEBUG_ONLY(bool entered =) enter (Self) ;
+         assert (entered, "invariant") ;
      } else {
          guarantee (v == ObjectWaiter::TS_ENTER || v == ObjectWaiter::TS_CXQ, "invariant") ;
          ReenterI (Self, &node) ;
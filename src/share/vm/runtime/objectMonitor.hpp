@@ -74,6 +74,11 @@ class EventJavaMonitorWait;
 // It is also used as RawMonitor by the JVMTI
 
 
+// With AsyncDeflateIdleMonitors the service thread marks a monitor it is
+// about to deflate by installing DEFLATER_MARKER as the owner. A monitor
+// keeps the marker once it has been deflated, so no thread can acquire it.
+#define DEFLATER_MARKER ((void*) -1)
+
 class ObjectMonitor {
  public:
   enum {
@@ -132,6 +137,14 @@ class ObjectMonitor {
   intptr_t  count() const;
   void      set_count(intptr_t count);
   intptr_t  contentions() const ;
+
+  // The service thread has deflated the monitor, or is about to. Entering
+  // threads must retry with the object's header. See
+  // ObjectSynchronizer::deflate_monitor_using_JT().
+  bool      is_being_async_deflated() const                            { return _count < 0; }
+  // Restores the displaced header to the object if the object still refers
+  // to this monitor.
+  void      install_displaced_markword_in_object();
   intptr_t  recursions() const                                         { return _recursions; }
 
   // JVM/DI GetMonitorInfo() needs this
@@ -201,7 +214,9 @@ public:
 #endif
 
   bool      try_enter (TRAPS) ;
-  void      enter(TRAPS);
+  // Returns false if the monitor was deflated concurrently, in which case
+  // the caller has to inflate the object again.
+  bool      enter(TRAPS);
   void      exit(bool not_suspended, TRAPS);
   void      wait(jlong millis, bool interruptable, TRAPS);
   void      notify(TRAPS);
@@ -209,7 +224,7 @@ public:
 
 // Use the following at your own risk
   intptr_t  complete_exit(TRAPS);
-  void      reenter(intptr_t recursions, TRAPS);
+  bool      reenter(intptr_t recursions, TRAPS);
 
  private:
   void      AddWaiter (ObjectWaiter * waiter) ;
@@ -53,7 +53,8 @@ inline intptr_t ObjectMonitor::waiters() const {
 }
 
 inline void* ObjectMonitor::owner() const {
-  return _owner;
+  void* owner = _owner;
+  return owner != DEFLATER_MARKER ? owner : NULL;
 }
 
 inline void ObjectMonitor::clear() {
@@ -98,7 +99,8 @@ inline bool ObjectMonitor::check(TRAPS) {
 
 // return number of threads contending for this monitor
 inline intptr_t ObjectMonitor::contentions() const {
-  return _count;
+  intptr_t count = _count;
+  return count > 0 ? count : 0;
 }
 
 // Do NOT set _count = 0. There is a race such that _count could
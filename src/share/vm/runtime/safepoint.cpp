@@ -53,6 +53,7 @@
 #include "services/runtimeService.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/workgroup.hpp"
 #ifdef TARGET_ARCH_x86
 # include "nativeInst_x86.hpp"
 # include "vmreg_x86.inline.hpp"
@@ -91,6 +92,8 @@ volatile int  SafepointSynchronize::_waiting_to_block = 0;
 volatile int SafepointSynchronize::_safepoint_counter = 0;
 int SafepointSynchronize::_current_jni_active_count = 0;
 long  SafepointSynchronize::_end_of_last_safepoint = 0;
+void* SafepointSynchronize::_poll_armed_value = NULL;
+void* SafepointSynchronize::_poll_disarmed_value = NULL;
 static volatile int PageArmed = 0 ;        // safepoint polling page is RO|RW vs PROT_NONE
 static volatile int TryingToBlock = 0 ;    // proximate value -- for advisory use only
 static bool timeout_error_printed = false;
@@ -200,7 +203,13 @@ void SafepointSynchronize::begin() {
   // Make interpreter safepoint aware
   Interpreter::notice_safepoints();
 
-  if (UseCompilerSafepoints && DeferPollingPageLoopCount < 0) {
+  if (ThreadLocalHandshakes) {
+    // Make the polls of all threads safepoint aware
+    for (JavaThread *cur = Threads::first(); cur != NULL; cur = cur->next()) {
+      arm_local_poll(cur);
+    }
+    OrderAccess::fence();
+  } else if (UseCompilerSafepoints && DeferPollingPageLoopCount < 0) {
     // Make polling safepoint aware
     guarantee (PageArmed == 0, "invariant") ;
     PageArmed = 1 ;
@@ -306,7 +315,8 @@ void SafepointSynchronize::begin() {
       // 9. On windows consider using the return value from SwitchThreadTo()
       //    to drive subsequent spin/SwitchThreadTo()/Sleep(N) decisions.
 
-      if (UseCompilerSafepoints && int(iterations) == DeferPollingPageLoopCount) {
+      if (UseCompilerSafepoints && !ThreadLocalHandshakes &&
+          int(iterations) == DeferPollingPageLoopCount) {
          guarantee (PageArmed == 0, "invariant") ;
          PageArmed = 1 ;
          os::make_polling_page_unreadable();
@@ -437,6 +447,12 @@ void SafepointSynchronize::end() {
     PageArmed = 0 ;
   }
 
+  if (ThreadLocalHandshakes) {
+    for (JavaThread *cur = Threads::first(); cur != NULL; cur = cur->next()) {
+      disarm_local_poll(cur);
+    }
+  }
+
   // Remove safepoint check from interpreter
   Interpreter::ignore_safepoints();
 
@@ -499,53 +515,218 @@ void SafepointSynchronize::end() {
 bool SafepointSynchronize::is_cleanup_needed() {
   // Need a safepoint if some inline cache buffers is non-empty
   if (!InlineCacheBuffer::is_empty()) return true;
+  // or to free the entries removed from the string and symbol tables
+  if (StringTable::has_retired() || SymbolTable::has_retired()) return true;
   return false;
 }
 
 
 
-// Various cleaning tasks that should be done periodically at safepoints
-void SafepointSynchronize::do_cleanup_tasks() {
-  {
-    TraceTime t1("deflating idle monitors", TraceSafepointCleanupTime);
-    ObjectSynchronizer::deflate_idle_monitors();
+// Various cleaning tasks that should be done periodically at safepoints.
+//
+// With ParallelSafepointCleanup the tasks are shared by the GC worker
+// threads of the heap: the workers claim the Java threads one at a time
+// to deflate their monitors and mark the nmethods on their stacks, and
+// each of the remaining tasks is performed by the first worker to claim
+// it. Without workers the VM thread performs all of them.
+class SafepointCleanupTask : public AbstractGangTask {
+ private:
+  SubTasksDone            _subtasks;
+  DeflateMonitorCounters* _counters;      // NULL if the service thread deflates the monitors
+  CodeBlobClosure*        _nmethod_cl;    // NULL if no nmethods need to be marked
+  volatile jint           _next_thread;   // index of the next Java thread to claim
+  bool                    _timing;
+
+  // Deflates the monitors of, and marks the nmethods on the stack of, the
+  // Java threads claimed by this worker.
+  void walk_threads() {
+    bool deflate_thread_local = _counters != NULL && MonitorInUseLists;
+    if (!deflate_thread_local && _nmethod_cl == NULL) {
+      return;
+    }
+    jlong deflate_time = 0;
+    jlong mark_time = 0;
+    jint claimed = Atomic::add(1, &_next_thread) - 1;
+    jint index = 0;
+    for (JavaThread* thread = Threads::first(); thread != NULL; thread = thread->next(), index++) {
+      if (index != claimed) {
+        continue;
+      }
+      jlong start = _timing ? os::javaTimeNanos() : 0;
+      if (deflate_thread_local) {
+        ObjectSynchronizer::deflate_thread_local_monitors(thread, _counters);
+      }
+      jlong mid = _timing ? os::javaTimeNanos() : 0;
+      if (_nmethod_cl != NULL) {
+        thread->nmethods_do(_nmethod_cl);
+      }
+      if (_timing) {
+        deflate_time += mid - start;
+        mark_time += os::javaTimeNanos() - mid;
+      }
+      claimed = Atomic::add(1, &_next_thread) - 1;
+    }
+    if (_timing) {
+      SafepointSynchronize::add_cleanup_task_time(SafepointSynchronize::_cleanup_deflate_idle_monitors, deflate_time);
+      SafepointSynchronize::add_cleanup_task_time(SafepointSynchronize::_cleanup_mark_active_nmethods, mark_time);
+    }
   }
 
-  {
-    TraceTime t2("updating inline caches", TraceSafepointCleanupTime);
-    InlineCacheBuffer::update_inline_caches();
+  bool claim_task(SafepointSynchronize::SafepointCleanupTasks task) {
+    return !_subtasks.is_task_claimed(task);
   }
-  {
-    TraceTime t3("compilation policy safepoint handler", TraceSafepointCleanupTime);
-    CompilationPolicy::policy()->do_safepoint_work();
+
+  void record_time(SafepointSynchronize::SafepointCleanupTasks task, jlong start) {
+    if (_timing) {
+      SafepointSynchronize::add_cleanup_task_time(task, os::javaTimeNanos() - start);
+    }
   }
 
-  {
-    TraceTime t4("mark nmethods", TraceSafepointCleanupTime);
-    NMethodSweeper::mark_active_nmethods();
+ public:
+  SafepointCleanupTask(DeflateMonitorCounters* counters, CodeBlobClosure* nmethod_cl, uint n_threads) :
+    AbstractGangTask("Safepoint Cleanup"),
+    _subtasks(SafepointSynchronize::_cleanup_num_tasks),
+    _counters(counters),
+    _nmethod_cl(nmethod_cl),
+    _next_thread(0),
+    _timing(SafepointSynchronize::is_timing_cleanup_tasks()) {
+    _subtasks.set_n_threads(n_threads);
+  }
+
+  void work(uint worker_id) {
+    walk_threads();
+
+    if (_counters != NULL) {
+      if (!MonitorInUseLists) {
+        // All workers share the scan of the monitor blocks.
+        jlong start = _timing ? os::javaTimeNanos() : 0;
+        ObjectSynchronizer::deflate_monitor_blocks(_counters);
+        record_time(SafepointSynchronize::_cleanup_deflate_idle_monitors, start);
+      } else if (claim_task(SafepointSynchronize::_cleanup_deflate_idle_monitors)) {
+        jlong start = _timing ? os::javaTimeNanos() : 0;
+        ObjectSynchronizer::deflate_global_idle_monitors(_counters);
+        record_time(SafepointSynchronize::_cleanup_deflate_idle_monitors, start);
+      }
+    }
+
+    if (claim_task(SafepointSynchronize::_cleanup_update_inline_caches)) {
+      jlong start = _timing ? os::javaTimeNanos() : 0;
+      InlineCacheBuffer::update_inline_caches();
+      record_time(SafepointSynchronize::_cleanup_update_inline_caches, start);
+    }
+
+    if (claim_task(SafepointSynchronize::_cleanup_compilation_policy)) {
+      jlong start = _timing ? os::javaTimeNanos() : 0;
+      CompilationPolicy::policy()->do_safepoint_work();
+      record_time(SafepointSynchronize::_cleanup_compilation_policy, start);
+    }
+
+    if (claim_task(SafepointSynchronize::_cleanup_symbol_table_rehash)) {
+      // Free what the service thread removed before the safepoint.
+      SymbolTable::free_retired();
+      if (SymbolTable::needs_rehashing()) {
+        jlong start = _timing ? os::javaTimeNanos() : 0;
+        SymbolTable::rehash_table();
+        record_time(SafepointSynchronize::_cleanup_symbol_table_rehash, start);
+      }
+    }
+
+    if (claim_task(SafepointSynchronize::_cleanup_string_table_rehash)) {
+      StringTable::free_retired();
+      if (StringTable::needs_rehashing()) {
+        jlong start = _timing ? os::javaTimeNanos() : 0;
+        StringTable::rehash_table();
+        record_time(SafepointSynchronize::_cleanup_string_table_rehash, start);
+      }
+    }
+
+    if (claim_task(SafepointSynchronize::_cleanup_purge_class_loader_data)) {
+      // CMS delays purging the CLDG until the beginning of the next safepoint and to
+      // make sure concurrent sweep is done
+      jlong start = _timing ? os::javaTimeNanos() : 0;
+      ClassLoaderDataGraph::purge_if_needed();
+      record_time(SafepointSynchronize::_cleanup_purge_class_loader_data, start);
+    }
+
+    _subtasks.all_tasks_completed();
+  }
+};
+
+void SafepointSynchronize::do_cleanup_tasks() {
+  bool timing = is_timing_cleanup_tasks();
+  if (timing) {
+    for (int i = 0; i < _cleanup_num_tasks; i++) {
+      _cleanup_task_time[i] = 0;
+    }
+  }
+
+  DeflateMonitorCounters counters;
+  DeflateMonitorCounters* deflate_counters = NULL;
+  if (AsyncDeflateIdleMonitors) {
+    // The service thread deflates the monitors; only release the monitors
+    // it deflated before this safepoint.
+    jlong start = timing ? os::javaTimeNanos() : 0;
+    ObjectSynchronizer::release_async_deflated_monitors();
+    if (timing) {
+      add_cleanup_task_time(_cleanup_deflate_idle_monitors, os::javaTimeNanos() - start);
+    }
+  } else {
+    deflate_counters = &counters;
+    ObjectSynchronizer::prepare_deflate_idle_monitors(deflate_counters);
   }
+  CodeBlobClosure* nmethod_cl = NMethodSweeper::prepare_mark_active_nmethods();
 
-  if (SymbolTable::needs_rehashing()) {
-    TraceTime t5("rehashing symbol table", TraceSafepointCleanupTime);
-    SymbolTable::rehash_table();
+  WorkGang* workers = Universe::heap()->safepoint_workers();
+  if (ParallelSafepointCleanup && workers != NULL && workers->active_workers() > 1) {
+    _cleanup_workers = workers->active_workers();
+    SafepointCleanupTask task(deflate_counters, nmethod_cl, _cleanup_workers);
+    workers->run_task(&task);
+  } else {
+    _cleanup_workers = 1;
+    SafepointCleanupTask task(deflate_counters, nmethod_cl, 1);
+    task.work(0);
   }
 
-  if (StringTable::needs_rehashing()) {
-    TraceTime t6("rehashing string table", TraceSafepointCleanupTime);
-    StringTable::rehash_table();
+  if (deflate_counters != NULL) {
+    ObjectSynchronizer::finish_deflate_idle_monitors(deflate_counters);
+  }
+  if (nmethod_cl != NULL) {
+    OrderAccess::storestore();
   }
 
   // rotate log files?
   if (UseGCLogFileRotation) {
-    TraceTime t8("rotating gc logs", TraceSafepointCleanupTime);
+    // Only the VM thread may rotate the log.
+    jlong start = timing ? os::javaTimeNanos() : 0;
     gclog_or_tty->rotate_log(false);
+    if (timing) {
+      add_cleanup_task_time(_cleanup_rotate_gc_logs, os::javaTimeNanos() - start);
+    }
   }
 
-  {
-    // CMS delays purging the CLDG until the beginning of the next safepoint and to
-    // make sure concurrent sweep is done
-    TraceTime t7("purging class loader data graph", TraceSafepointCleanupTime);
-    ClassLoaderDataGraph::purge_if_needed();
+  if (TraceSafepointCleanupTime) {
+    for (int i = 0; i < _cleanup_num_tasks; i++) {
+      tty->stamp(PrintGCTimeStamps);
+      tty->print_cr("[%s, %3.7f secs]", cleanup_task_name((SafepointCleanupTasks)i),
+                    (double)_cleanup_task_time[i] / NANOSECS_PER_SEC);
+    }
+    if (_cleanup_workers > 1) {
+      tty->print_cr("[safepoint cleanup performed by %d workers]", _cleanup_workers);
+    }
+  }
+}
+
+const char* SafepointSynchronize::cleanup_task_name(SafepointCleanupTasks task) {
+  switch (task) {
+    case _cleanup_deflate_idle_monitors:   return "deflating idle monitors";
+    case _cleanup_update_inline_caches:    return "updating inline caches";
+    case _cleanup_compilation_policy:      return "compilation policy safepoint handler";
+    case _cleanup_mark_active_nmethods:    return "mark nmethods";
+    case _cleanup_symbol_table_rehash:     return "rehashing symbol table";
+    case _cleanup_string_table_rehash:     return "rehashing string table";
+    case _cleanup_rotate_gc_logs:          return "rotating gc logs";
+    case _cleanup_purge_class_loader_data: return "purging class loader data graph";
+    default: ShouldNotReachHere();         return NULL;
   }
 }
 
@@ -737,6 +918,51 @@ void SafepointSynchronize::block(JavaThread *thread) {
   }
 }
 
+void SafepointSynchronize::block_if_requested(JavaThread *thread) {
+  if (do_call_back()) {
+    block(thread);
+  }
+  if (thread->has_handshake()) {
+    thread->handshake_process_by_self();
+    // The VM thread may have started a safepoint once the operation was
+    // completed.
+    if (do_call_back()) {
+      block(thread);
+    }
+  }
+}
+
+// ------------------------------------------------------------------------------------------------------
+// Thread-local polls
+
+void SafepointSynchronize::initialize_local_polling() {
+  if (!ThreadLocalHandshakes) {
+    return;
+  }
+  // The polling page stays unreadable, an armed poll word points into it.
+  // A disarmed poll word points to a second, readable page.
+  os::make_polling_page_unreadable();
+  size_t page_size = os::vm_page_size();
+  char* good_page = os::reserve_memory(page_size);
+  if (good_page == NULL) {
+    vm_exit_out_of_memory(page_size, OOM_MMAP_ERROR, "thread-local polling page");
+  }
+  os::commit_memory_or_exit(good_page, page_size, false,
+                            "Unable to commit thread-local polling page");
+  _poll_armed_value = (void*)((intptr_t)os::get_polling_page() | poll_bit());
+  _poll_disarmed_value = (void*)good_page;
+}
+
+void SafepointSynchronize::arm_local_poll(JavaThread* thread) {
+  assert(ThreadLocalHandshakes, "sanity");
+  thread->set_polling_page(_poll_armed_value);
+}
+
+void SafepointSynchronize::disarm_local_poll(JavaThread* thread) {
+  assert(ThreadLocalHandshakes, "sanity");
+  thread->set_polling_page(_poll_disarmed_value);
+}
+
 // ------------------------------------------------------------------------------------------------------
 // Exception handlers
 
@@ -744,7 +970,8 @@ void SafepointSynchronize::block(JavaThread *thread) {
 void SafepointSynchronize::handle_polling_page_exception(JavaThread *thread) {
   assert(thread->is_Java_thread(), "polling reference encountered by VM thread");
   assert(thread->thread_state() == _thread_in_Java, "should come from Java code");
-  assert(SafepointSynchronize::is_synchronizing(), "polling encountered outside safepoint synchronization");
+  assert(SafepointSynchronize::is_synchronizing() || thread->has_handshake(),
+         "polling encountered outside safepoint synchronization");
 
   if (ShowSafepointMsgs) {
     tty->print("handle_polling_page_exception: ");
@@ -995,7 +1222,7 @@ void ThreadSafepointState::handle_polling_page_exception() {
     }
 
     // Block the thread
-    SafepointSynchronize::block(thread());
+    SafepointSynchronize::block_if_requested(thread());
 
     // restore oop result, if any
     if (return_oop) {
@@ -1011,7 +1238,7 @@ void ThreadSafepointState::handle_polling_page_exception() {
     assert(real_return_addr == caller_fr.pc(), "must match");
 
     // Block the thread
-    SafepointSynchronize::block(thread());
+    SafepointSynchronize::block_if_requested(thread());
     set_at_poll_safepoint(false);
 
     // If we have a pending async exception deoptimize the frame
@@ -1053,6 +1280,8 @@ julong SafepointSynchronize::_coalesced_vmop_count = 0;
 jlong  SafepointSynchronize::_max_sync_time = 0;
 jlong  SafepointSynchronize::_max_vmop_time = 0;
 float  SafepointSynchronize::_ts_of_current_safepoint = 0.0f;
+volatile jlong SafepointSynchronize::_cleanup_task_time[SafepointSynchronize::_cleanup_num_tasks];
+int    SafepointSynchronize::_cleanup_workers = 1;
 
 static jlong  cleanup_end_time = 0;
 static bool   need_to_track_page_armed_status = false;
@@ -1063,6 +1292,8 @@ static void print_header() {
   tty->print("         vmop                    "
              "[threads: total initially_running wait_to_block]    ");
   tty->print("[time: spin block sync cleanup vmop] ");
+  tty->print("[cleanup tasks in micros: monitors inline_caches policy nmethods "
+             "symbols strings logs cld workers] ");
 
   // no page armed status printed out if it is always armed.
   if (need_to_track_page_armed_status) {
@@ -1173,6 +1404,10 @@ void SafepointSynchronize::update_statistics_on_cleanup_end(jlong end_time) {
 
   // Record how long spent in cleanup tasks.
   spstat->_time_to_do_cleanups = end_time - spstat->_time_to_do_cleanups;
+  for (int i = 0; i < _cleanup_num_tasks; i++) {
+    spstat->_time_of_cleanup_task[i] = _cleanup_task_time[i];
+  }
+  spstat->_nof_cleanup_workers = _cleanup_workers;
 
   cleanup_end_time = end_time;
 }
@@ -1232,6 +1467,13 @@ void SafepointSynchronize::print_statistics() {
                sstats->_time_to_do_cleanups / MICROUNITS,
                sstats->_time_to_exec_vmop / MICROUNITS);
 
+    // "/ MILLIUNITS " is to convert the unit from nanos to micros.
+    tty->print("  [");
+    for (int i = 0; i < _cleanup_num_tasks; i++) {
+      tty->print(INT64_FORMAT_W(9), sstats->_time_of_cleanup_task[i] / MILLIUNITS);
+    }
+    tty->print(INT32_FORMAT_W(8) "    ]  ", sstats->_nof_cleanup_workers);
+
     if (need_to_track_page_armed_status) {
       tty->print(INT32_FORMAT "         ", sstats->_page_armed);
     }
@@ -75,6 +75,20 @@ class SafepointSynchronize : AllStatic {
     _blocking_timeout = 1
   };
 
+  // The tasks of the cleanup phase, see do_cleanup_tasks()
+  enum SafepointCleanupTasks {
+    _cleanup_deflate_idle_monitors = 0,
+    _cleanup_update_inline_caches,
+    _cleanup_compilation_policy,
+    _cleanup_mark_active_nmethods,
+    _cleanup_symbol_table_rehash,
+    _cleanup_string_table_rehash,
+    _cleanup_rotate_gc_logs,
+    _cleanup_purge_class_loader_data,
+    // Leave this one last
+    _cleanup_num_tasks
+  };
+
   typedef struct {
     float  _time_stamp;                        // record when the current safepoint occurs in seconds
     int    _vmop_type;                         // type of VM operation triggers the safepoint
@@ -88,6 +102,9 @@ class SafepointSynchronize : AllStatic {
     jlong  _time_to_do_cleanups;               // total time in millis spent in performing cleanups
     jlong  _time_to_sync;                      // total time in millis spent in getting to _synchronized
     jlong  _time_to_exec_vmop;                 // total time in millis spent in vm operation itself
+    jlong  _time_of_cleanup_task[_cleanup_num_tasks]; // time in nanos spent in each cleanup task,
+                                               // summed over the cleanup workers
+    int    _nof_cleanup_workers;               // number of threads performing the cleanup tasks
   } SafepointStats;
 
  private:
@@ -103,6 +120,12 @@ class SafepointSynchronize : AllStatic {
   // race freedom.
 public:
   static volatile int _safepoint_counter;
+
+  // The values of the thread-local poll word, see ThreadLocalHandshakes.
+  // An armed poll points into the unreadable polling page, a disarmed poll
+  // into a readable page.
+  static void* _poll_armed_value;
+  static void* _poll_disarmed_value;
 private:
   static long       _end_of_last_safepoint;     // Time of last safepoint in milliseconds
 
@@ -116,6 +139,12 @@ private:
   static jlong            _max_vmop_time;            // maximum vm operation time in nanos
   static float            _ts_of_current_safepoint;  // time stamp of current safepoint in seconds
 
+  // The time in nanos spent in each task of the current cleanup phase
+  static volatile jlong   _cleanup_task_time[_cleanup_num_tasks];
+  static int              _cleanup_workers;          // number of threads performing the cleanup
+
+  static const char* cleanup_task_name(SafepointCleanupTasks task);
+
   static void begin_statistics(int nof_threads, int nof_running);
   static void update_statistics_on_spin_end();
   static void update_statistics_on_sync_end(jlong end_time);
@@ -158,6 +187,17 @@ public:
   // Called when a thread volantary blocks
   static void   block(JavaThread *thread);
   static void   signal_thread_at_safepoint()              { _waiting_to_block--; }
+  // Blocks if a safepoint is in progress and executes a pending handshake
+  // operation, called by the thread itself at polls and on transitions.
+  static void   block_if_requested(JavaThread *thread);
+
+  // Thread-local polls
+  static void   initialize_local_polling();
+  static int    poll_bit()                                { return 1; }
+  static void*  poll_armed_value()                        { return _poll_armed_value; }
+  static void*  poll_disarmed_value()                     { return _poll_disarmed_value; }
+  static void   arm_local_poll(JavaThread* thread);
+  static void   disarm_local_poll(JavaThread* thread);
 
   // Exception handling for page polling
   static void handle_polling_page_exception(JavaThread *thread);
@@ -172,6 +212,15 @@ public:
   static bool is_cleanup_needed();
   static void do_cleanup_tasks();
 
+  // Whether the time of the cleanup tasks is measured
+  static bool is_timing_cleanup_tasks() {
+    return PrintSafepointStatistics || TraceSafepointCleanupTime;
+  }
+  // Called by the threads performing the cleanup tasks
+  static void add_cleanup_task_time(SafepointCleanupTasks task, jlong time) {
+    Atomic::add(time, &_cleanup_task_time[task]);
+  }
+
   // debugging
   static void print_state()                                PRODUCT_RETURN;
   static void safepoint_msg(const char* format, ...) ATTRIBUTE_PRINTF(1, 2) PRODUCT_RETURN;
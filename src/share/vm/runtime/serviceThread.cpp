@@ -23,15 +23,21 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/serviceThread.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/synchronizer.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "services/allocationContextService.hpp"
 #include "services/gcNotifier.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticFramework.hpp"
+#include "utilities/macros.hpp"
+#if INCLUDE_ALL_GCS
+#include "gc_implementation/g1/g1CollectedHeap.hpp"
+#endif // INCLUDE_ALL_GCS
 
 ServiceThread* ServiceThread::_instance = NULL;
 
@@ -81,6 +87,28 @@ void ServiceThread::initialize() {
   }
 }
 
+static bool is_g1_periodic_gc_needed() {
+#if INCLUDE_ALL_GCS
+  if (UseG1GC && G1PeriodicGCInterval > 0) {
+    return G1CollectedHeap::heap()->should_start_periodic_gc();
+  }
+#endif // INCLUDE_ALL_GCS
+  return false;
+}
+
+// The number of milliseconds to wait for a notification before the
+// periodic tasks are checked again, 0 if there are none.
+static jlong service_wait_millis() {
+  jlong millis = AsyncDeflateIdleMonitors ? (jlong) AsyncDeflationInterval : 0;
+#if INCLUDE_ALL_GCS
+  if (UseG1GC && G1PeriodicGCInterval > 0) {
+    jlong g1_millis = G1CollectedHeap::heap()->periodic_gc_wait_millis();
+    millis = (millis == 0) ? g1_millis : MIN2(millis, g1_millis);
+  }
+#endif // INCLUDE_ALL_GCS
+  return millis;
+}
+
 void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
   while (true) {
     bool sensors_changed = false;
@@ -88,6 +116,10 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool has_gc_notification_event = false;
     bool has_dcmd_notification_event = false;
     bool acs_notify = false;
+    bool deflate_idle_monitors = false;
+    bool g1_periodic_gc = false;
+    bool string_table_work = false;
+    bool symbol_table_work = false;
     JvmtiDeferredEvent jvmti_event;
     {
       // Need state transition ThreadBlockInVM so that this thread
@@ -105,10 +137,16 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
              !(has_jvmti_events = JvmtiDeferredEventQueue::has_events()) &&
               !(has_gc_notification_event = GCNotifier::has_event()) &&
               !(has_dcmd_notification_event = DCmdFactory::has_pending_jmx_notification()) &&
-             !(acs_notify = AllocationContextService::should_notify())) {
+             !(acs_notify = AllocationContextService::should_notify()) &&
+             !(deflate_idle_monitors = ObjectSynchronizer::is_async_deflation_needed()) &&
+             !(g1_periodic_gc = is_g1_periodic_gc_needed()) &&
+             !(string_table_work = StringTable::has_work()) &&
+             !(symbol_table_work = SymbolTable::has_work())) {
         // wait until one of the sensors has pending requests, or there is a
-        // pending JVMTI event or JMX GC notification to post
-        Service_lock->wait(Mutex::_no_safepoint_check_flag);
+        // pending JVMTI event or JMX GC notification to post, or it is time
+        // to deflate idle monitors, to start a periodic G1 collection or to
+        // grow the string or symbol table
+        Service_lock->wait(Mutex::_no_safepoint_check_flag, service_wait_millis());
       }
 
       if (has_jvmti_events) {
@@ -135,6 +173,22 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if (acs_notify) {
       AllocationContextService::notify(CHECK);
     }
+
+    if (deflate_idle_monitors) {
+      ObjectSynchronizer::deflate_idle_monitors_using_JT();
+    }
+
+    if (g1_periodic_gc) {
+      Universe::heap()->collect(GCCause::_g1_periodic_collection);
+    }
+
+    if (string_table_work) {
+      StringTable::do_concurrent_work(jt);
+    }
+
+    if (symbol_table_work) {
+      SymbolTable::do_concurrent_work(jt);
+    }
   }
 }
 
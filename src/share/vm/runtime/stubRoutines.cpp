@@ -136,6 +136,12 @@ address StubRoutines::_sha512_implCompressMB = NULL;
 address StubRoutines::_updateBytesCRC32 = NULL;
 address StubRoutines::_crc_table_adr = NULL;
 
+address StubRoutines::_stringHashCode = NULL;
+address StubRoutines::_stringEquals = NULL;
+address StubRoutines::_stringCompareTo = NULL;
+
+address StubRoutines::_vectorizedMismatch = NULL;
+
 address StubRoutines::_multiplyToLen = NULL;
 address StubRoutines::_squareToLen = NULL;
 address StubRoutines::_mulAdd = NULL;
@@ -209,6 +209,12 @@ class StubRoutines: AllStatic {
   static address _updateBytesCRC32;
   static address _crc_table_adr;
 
+  static address _stringHashCode;
+  static address _stringEquals;
+  static address _stringCompareTo;
+
+  static address _vectorizedMismatch;
+
   static address _multiplyToLen;
   static address _squareToLen;
   static address _mulAdd;
@@ -372,6 +378,12 @@ class StubRoutines: AllStatic {
   static address updateBytesCRC32()    { return _updateBytesCRC32; }
   static address crc_table_addr()      { return _crc_table_adr; }
 
+  static address stringHashCode()      { return _stringHashCode; }
+  static address stringEquals()        { return _stringEquals; }
+  static address stringCompareTo()     { return _stringCompareTo; }
+
+  static address vectorizedMismatch()  { return _vectorizedMismatch; }
+
   static address multiplyToLen()       {return _multiplyToLen; }
   static address squareToLen()         {return _squareToLen; }
   static address mulAdd()              {return _mulAdd; }
@@ -201,11 +201,23 @@ bool NMethodSweeper::sweep_in_progress() {
 // No need to synchronize access, since 'mark_active_nmethods' is always executed at a
 // safepoint.
 void NMethodSweeper::mark_active_nmethods() {
+  CodeBlobClosure* cl = prepare_mark_active_nmethods();
+  if (cl != NULL) {
+    Threads::nmethods_do(cl);
+    OrderAccess::storestore();
+  }
+}
+
+// Starts a new stack traversal if no sweep is in progress and returns the
+// closure to apply to the nmethods on the thread stacks, or NULL if the stacks
+// need not be scanned. The closures only store to the nmethods they visit, so
+// the parallel safepoint cleanup applies them to different threads at once.
+CodeBlobClosure* NMethodSweeper::prepare_mark_active_nmethods() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be executed at a safepoint");
   // If we do not want to reclaim not-entrant or zombie methods there is no need
   // to scan stacks
   if (!MethodFlushing) {
-    return;
+    return NULL;
   }
 
   // Increase time so that we can estimate when to invoke the sweeper again.
@@ -223,15 +235,14 @@ void NMethodSweeper::mark_active_nmethods() {
     if (PrintMethodFlushing) {
       tty->print_cr("### Sweep: stack traversal %d", _traversals);
     }
-    Threads::nmethods_do(&mark_activation_closure);
+    return &mark_activation_closure;
 
   } else {
     // Only set hotness counter
-    Threads::nmethods_do(&set_hotness_closure);
+    return &set_hotness_closure;
   }
-
-  OrderAccess::storestore();
 }
+
 /**
  * This function invokes the sweeper if at least one of the three conditions is met:
  *    (1) The code cache is getting full
@@ -264,6 +275,8 @@ void NMethodSweeper::possibly_sweep() {
   //                                              15 invocations of 'mark_active_nmethods.
   // Large ReservedCodeCacheSize:   (e.g., 256M + code Cache is 90% full). The formula
   //                                              computes: (256 / 16) - 10 = 6.
+  //
+  // With a segmented code cache, reverse_free_ratio() is that of the fullest method heap.
   if (!_should_sweep) {
     const int time_since_last_sweep = _time_counter - _last_sweep;
     // ReservedCodeCacheSize has an 'unsigned' type. We need a 'signed' type for max_wait_time,
@@ -592,7 +605,9 @@ int NMethodSweeper::process_nmethod(nmethod *nm) {
         // ReservedCodeCacheSize
         int reset_val = hotness_counter_reset_val();
         int time_since_reset = reset_val - nm->hotness_counter();
-        double threshold = -reset_val + (CodeCache::reverse_free_ratio() * NmethodSweepActivity);
+        // With a segmented code cache, only the free space of the code heap
+        // holding the nmethod matters.
+        double threshold = -reset_val + (CodeCache::reverse_free_ratio(CodeCache::get_code_blob_type(nm)) * NmethodSweepActivity);
         // The less free space in the code cache we have - the bigger reverse_free_ratio() is.
         // I.e., 'threshold' increases with lower available space in the code cache and a higher
         // NmethodSweepActivity. If the current hotness counter - which decreases from its initial
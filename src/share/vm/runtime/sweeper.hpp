@@ -26,6 +26,9 @@
 #define SHARE_VM_RUNTIME_SWEEPER_HPP
 
 #include "utilities/ticks.hpp"
+
+class CodeBlobClosure;
+
 // An NmethodSweeper is an incremental cleaner for:
 //    - cleanup inline caches
 //    - reclamation of nmethods
@@ -106,6 +109,7 @@ class NMethodSweeper : public AllStatic {
 #endif
 
   static void mark_active_nmethods();      // Invoked at the end of each safepoint
+  static CodeBlobClosure* prepare_mark_active_nmethods();
   static void possibly_sweep();            // Compiler threads call this to sweep
 
   static int hotness_counter_reset_val();
@@ -257,7 +257,9 @@ void ObjectSynchronizer::slow_enter(Handle obj, BasicLock* lock, TRAPS) {
   // must be non-zero to avoid looking like a re-entrant lock,
   // and must not look locked either.
   lock->set_displaced_header(markOopDesc::unused_mark());
-  ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD)) {
+    // The monitor was deflated concurrently; inflate again.
+  }
 }
 
 // This routine is used to handle interpreter/compiler slow case
@@ -300,9 +302,13 @@ void ObjectSynchronizer::reenter(Handle obj, intptr_t recursion, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD, obj());
-
-  monitor->reenter(recursion, THREAD);
+  while (true) {
+    ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD, obj());
+    if (monitor->reenter(recursion, THREAD)) {
+      return;
+    }
+    // The monitor was deflated concurrently; inflate again.
+  }
 }
 // -----------------------------------------------------------------------------
 // JNI locks on java objects
@@ -315,7 +321,9 @@ void ObjectSynchronizer::jni_enter(Handle obj, TRAPS) { // possible entry from j
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
   THREAD->set_current_pending_monitor_is_from_java(false);
-  ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD)) {
+    // The monitor was deflated concurrently; inflate again.
+  }
   THREAD->set_current_pending_monitor_is_from_java(true);
 }
 
@@ -684,28 +692,37 @@ intptr_t ObjectSynchronizer::FastHashCode (Thread * Self, oop obj) {
     // correctly.
   }
 
-  // Inflate the monitor to set hash code
-  monitor = ObjectSynchronizer::inflate(Self, obj);
-  // Load displaced header and check it has hash code
-  mark = monitor->header();
-  assert (mark->is_neutral(), "invariant") ;
-  hash = mark->hash();
-  if (hash == 0) {
-    hash = get_next_hash(Self, obj);
-    temp = mark->copy_set_hash(hash); // merge hash code into header
-    assert (temp->is_neutral(), "invariant") ;
-    test = (markOop) Atomic::cmpxchg_ptr(temp, monitor, mark);
-    if (test != mark) {
-      // The only update to the header in the monitor (outside GC)
-      // is install the hash code. If someone add new usage of
-      // displaced header, please update this code
-      hash = test->hash();
-      assert (test->is_neutral(), "invariant") ;
-      assert (hash != 0, "Trivial unexpected object/monitor header usage.");
+  while (true) {
+    // Inflate the monitor to set hash code
+    monitor = ObjectSynchronizer::inflate(Self, obj);
+    // Load displaced header and check it has hash code
+    mark = monitor->header();
+    assert (mark->is_neutral(), "invariant") ;
+    hash = mark->hash();
+    if (hash == 0) {
+      hash = get_next_hash(Self, obj);
+      temp = mark->copy_set_hash(hash); // merge hash code into header
+      assert (temp->is_neutral(), "invariant") ;
+      test = (markOop) Atomic::cmpxchg_ptr(temp, monitor, mark);
+      if (test != mark) {
+        // The only update to the header in the monitor (outside GC)
+        // is install the hash code. If someone add new usage of
+        // displaced header, please update this code
+        hash = test->hash();
+        assert (test->is_neutral(), "invariant") ;
+        assert (hash != 0, "Trivial unexpected object/monitor header usage.");
+      }
     }
+    if (monitor->is_being_async_deflated()) {
+      // The service thread may have restored the object's header before
+      // the hash reached the monitor. Make sure the header is restored and
+      // look at it again.
+      monitor->install_displaced_markword_in_object();
+      continue;
+    }
+    // We finally get the hash
+    return hash;
   }
-  // We finally get the hash
-  return hash;
 }
 
 // Deprecated -- use FastHashCode() instead.
@@ -837,7 +854,7 @@ void ObjectSynchronizer::monitors_iterate(MonitorClosure* closure) {
     for (int i = _BLOCKSIZE - 1; i > 0; i--) {
       ObjectMonitor* mid = (ObjectMonitor *)(block + i);
       oop object = (oop)mid->object();
-      if (object != NULL) {
+      if (object != NULL && !mid->is_being_async_deflated()) {
         closure->do_monitor(mid);
       }
     }
@@ -862,7 +879,9 @@ void ObjectSynchronizer::oops_do(OopClosure* f) {
     assert(block->object() == CHAINMARKER, "must be a block header");
     for (int i = 1; i < _BLOCKSIZE; i++) {
       ObjectMonitor* mid = &block[i];
-      if (mid->object() != NULL) {
+      // A monitor deflated by the service thread is no longer associated
+      // with its object, it just has not been freed yet.
+      if (mid->object() != NULL && !mid->is_being_async_deflated()) {
         f->do_oop((oop*)mid->object_addr());
       }
     }
@@ -875,8 +894,9 @@ void ObjectSynchronizer::oops_do(OopClosure* f) {
 // -----------------------
 // Inflation unlinks monitors from the global gFreeList and
 // associates them with objects.  Deflation -- which occurs at
-// STW-time -- disassociates idle monitors from objects.  Such
-// scavenged monitors are returned to the gFreeList.
+// STW-time, or in the service thread with AsyncDeflateIdleMonitors --
+// disassociates idle monitors from objects.  Such scavenged monitors
+// are returned to the gFreeList.
 //
 // The global list is protected by ListLock.  All the critical sections
 // are short and operate in constant-time.
@@ -915,6 +935,13 @@ static void InduceScavenge (Thread * Self, const char * Whence) {
   // of active monitors passes the specified threshold.
   // TODO: assert thread state is reasonable
 
+  if (AsyncDeflateIdleMonitors) {
+    // The service thread picks up the request the next time it checks
+    // whether monitors need to be deflated.
+    ForceMonitorScavenge = 1;
+    return;
+  }
+
   if (ForceMonitorScavenge == 0 && Atomic::xchg (1, &ForceMonitorScavenge) == 0) {
     if (ObjectMonitor::Knob_Verbose) {
       ::printf ("Monitor scavenge - Induced STW @%s (%d)\n", Whence, ForceMonitorScavenge) ;
@@ -1506,101 +1533,381 @@ int ObjectSynchronizer::walk_monitor_list(ObjectMonitor** listheadp,
 
 void ObjectSynchronizer::deflate_idle_monitors() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
-  int nInuse = 0 ;              // currently associated with objects
-  int nInCirculation = 0 ;      // extant
-  int nScavenged = 0 ;          // reclaimed
-  bool deflated = false;
+  DeflateMonitorCounters counters;
+
+  prepare_deflate_idle_monitors(&counters);
+  if (MonitorInUseLists) {
+    for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
+      deflate_thread_local_monitors(cur, &counters);
+    }
+    deflate_global_idle_monitors(&counters);
+  } else {
+    deflate_monitor_blocks(&counters);
+  }
+  finish_deflate_idle_monitors(&counters);
+}
+
+// The cursor into gBlockList of the block scan, see deflate_monitor_blocks()
+static ObjectMonitor* volatile DeflateBlockCursor = NULL;
+
+void ObjectSynchronizer::prepare_deflate_idle_monitors(DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  counters->nInuse = 0;
+  counters->nInCirculation = 0;
+  counters->nScavenged = 0;
+  DeflateBlockCursor = (ObjectMonitor*)OrderAccess::load_ptr_acquire(&gBlockList);
+  TEVENT (deflate_idle_monitors) ;
+}
+
+// Move a working free list of scavenged monitors back to the global free
+// list, and add the counts of the caller to the totals.
+void ObjectSynchronizer::release_deflated_monitors(ObjectMonitor* FreeHead, ObjectMonitor* FreeTail,
+                                                   DeflateMonitorCounters* counters,
+                                                   int nInuse, int nInCirculation, int nScavenged) {
+  Thread::muxAcquire (&ListLock, "scavenge - return") ;
+  if (FreeHead != NULL) {
+     guarantee (FreeTail != NULL && nScavenged > 0, "invariant") ;
+     assert (FreeTail->FreeNext == NULL, "invariant") ;
+     // constant-time list splice - prepend scavenged segment to gFreeList
+     FreeTail->FreeNext = gFreeList ;
+     gFreeList = FreeHead ;
+  }
+  MonitorFreeCount += nScavenged;
+  counters->nInuse += nInuse;
+  counters->nInCirculation += nInCirculation;
+  counters->nScavenged += nScavenged;
+  Thread::muxRelease (&ListLock) ;
+}
+
+// The in-use list of a thread is only changed by the thread itself, which
+// is stopped at the safepoint, so the list is walked without holding
+// ListLock. Several threads may deflate the lists of different threads.
+void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  assert(MonitorInUseLists, "only the in-use lists are scanned per thread");
+
+  if (thread->omInUseList == NULL) {
+    return;
+  }
 
   ObjectMonitor * FreeHead = NULL ;  // Local SLL of scavenged monitors
   ObjectMonitor * FreeTail = NULL ;
 
-  TEVENT (deflate_idle_monitors) ;
+  int nInCirculation = thread->omInUseCount;
+  int deflatedcount = walk_monitor_list(thread->omInUseList_addr(), &FreeHead, &FreeTail);
+  thread->omInUseCount -= deflatedcount;
+  // verifyInUse(thread);
+
+  release_deflated_monitors(FreeHead, FreeTail, counters,
+                            thread->omInUseCount, nInCirculation, deflatedcount);
+}
+
+void ObjectSynchronizer::deflate_global_idle_monitors(DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  assert(MonitorInUseLists, "only the in-use lists are scanned per thread");
+
+  ObjectMonitor * FreeHead = NULL ;  // Local SLL of scavenged monitors
+  ObjectMonitor * FreeTail = NULL ;
+  int nInuse = 0;
+  int nInCirculation = 0;
+  int nScavenged = 0;
+
   // Prevent omFlush from changing mids in Thread dtor's during deflation
   // And in case the vm thread is acquiring a lock during a safepoint
   // See e.g. 6320749
   Thread::muxAcquire (&ListLock, "scavenge - return") ;
+  // For moribund threads, scan gOmInUseList
+  if (gOmInUseList) {
+    nInCirculation = gOmInUseCount;
+    nScavenged = walk_monitor_list((ObjectMonitor **)&gOmInUseList, &FreeHead, &FreeTail);
+    gOmInUseCount -= nScavenged;
+    nInuse = gOmInUseCount;
+  }
+  Thread::muxRelease (&ListLock) ;
 
-  if (MonitorInUseLists) {
-    int inUse = 0;
-    for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
-      nInCirculation+= cur->omInUseCount;
-      int deflatedcount = walk_monitor_list(cur->omInUseList_addr(), &FreeHead, &FreeTail);
-      cur->omInUseCount-= deflatedcount;
-      // verifyInUse(cur);
-      nScavenged += deflatedcount;
-      nInuse += cur->omInUseCount;
-     }
+  release_deflated_monitors(FreeHead, FreeTail, counters, nInuse, nInCirculation, nScavenged);
+}
 
-   // For moribund threads, scan gOmInUseList
-   if (gOmInUseList) {
-     nInCirculation += gOmInUseCount;
-     int deflatedcount = walk_monitor_list((ObjectMonitor **)&gOmInUseList, &FreeHead, &FreeTail);
-     gOmInUseCount-= deflatedcount;
-     nScavenged += deflatedcount;
-     nInuse += gOmInUseCount;
-    }
+// Iterate over all extant monitors and scavenge the idle ones. The blocks
+// are claimed one at a time, so several threads may share the scan. Without
+// MonitorInUseLists omFlush only moves monitors which are not associated
+// with an object, and the scan skips those, so ListLock is only taken to
+// return the scavenged monitors.
+void ObjectSynchronizer::deflate_monitor_blocks(DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  assert(!MonitorInUseLists, "the in-use lists are scanned instead");
 
-  } else {
-    ObjectMonitor* block =
-      (ObjectMonitor*)OrderAccess::load_ptr_acquire(&gBlockList);
-    for (; block != NULL; block = (ObjectMonitor*)next(block)) {
-      // Iterate over all extant monitors - Scavenge all idle monitors.
-      assert(block->object() == CHAINMARKER, "must be a block header");
-      nInCirculation += _BLOCKSIZE;
-      for (int i = 1; i < _BLOCKSIZE; i++) {
-        ObjectMonitor* mid = (ObjectMonitor*)&block[i];
-        oop obj = (oop)mid->object();
-
-        if (obj == NULL) {
-          // The monitor is not associated with an object.
-          // The monitor should either be a thread-specific private
-          // free list or the global free list.
-          // obj == NULL IMPLIES mid->is_busy() == 0
-          guarantee(!mid->is_busy(), "invariant");
-          continue;
-        }
-        deflated = deflate_monitor(mid, obj, &FreeHead, &FreeTail);
+  ObjectMonitor * FreeHead = NULL ;  // Local SLL of scavenged monitors
+  ObjectMonitor * FreeTail = NULL ;
+  int nInuse = 0;
+  int nInCirculation = 0;
+  int nScavenged = 0;
+
+  while (true) {
+    ObjectMonitor* block = DeflateBlockCursor;
+    if (block == NULL) {
+      break;
+    }
+    if (Atomic::cmpxchg_ptr(next(block), &DeflateBlockCursor, block) != block) {
+      continue;
+    }
+    assert(block->object() == CHAINMARKER, "must be a block header");
+    nInCirculation += _BLOCKSIZE;
+    for (int i = 1; i < _BLOCKSIZE; i++) {
+      ObjectMonitor* mid = (ObjectMonitor*)&block[i];
+      oop obj = (oop)mid->object();
+
+      if (obj == NULL) {
+        // The monitor is not associated with an object.
+        // The monitor should either be a thread-specific private
+        // free list or the global free list.
+        // obj == NULL IMPLIES mid->is_busy() == 0
+        guarantee(!mid->is_busy(), "invariant");
+        continue;
+      }
 
-        if (deflated) {
-          mid->FreeNext = NULL;
-          nScavenged++;
-        } else {
-          nInuse++;
-        }
+      if (deflate_monitor(mid, obj, &FreeHead, &FreeTail)) {
+        mid->FreeNext = NULL;
+        nScavenged++;
+      } else {
+        nInuse++;
       }
     }
   }
 
-  MonitorFreeCount += nScavenged;
+  release_deflated_monitors(FreeHead, FreeTail, counters, nInuse, nInCirculation, nScavenged);
+}
+
+void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
 
   // Consider: audit gFreeList to ensure that MonitorFreeCount and list agree.
 
   if (ObjectMonitor::Knob_Verbose) {
     ::printf ("Deflate: InCirc=%d InUse=%d Scavenged=%d ForceMonitorScavenge=%d : pop=%d free=%d\n",
-        nInCirculation, nInuse, nScavenged, ForceMonitorScavenge,
+        counters->nInCirculation, counters->nInuse, counters->nScavenged, ForceMonitorScavenge,
         MonitorPopulation, MonitorFreeCount) ;
     ::fflush(stdout) ;
   }
 
   ForceMonitorScavenge = 0;    // Reset
 
-  // Move the scavenged monitors back to the global free list.
+  OM_PERFDATA_OP(Deflations, inc(counters->nScavenged));
+  OM_PERFDATA_OP(MonExtant, set_value(counters->nInCirculation));
+
+  // TODO: Add objectMonitor leak detection.
+  // Audit/inventory the objectMonitors -- make sure they're all accounted for.
+  GVars.stwRandom = os::random() ;
+  GVars.stwCycle ++ ;
+}
+
+// -----------------------------------------------------------------------------
+// Concurrent deflation
+//
+// With AsyncDeflateIdleMonitors the safepoints leave the monitors alone and
+// the service thread deflates idle monitors while the Java threads run. A
+// monitor is deflated in three steps, each of which may be taken by a single
+// CAS only:
+//
+//   1. The owner is set from NULL to DEFLATER_MARKER. No thread can acquire
+//      the monitor from now on, and none can start to wait() on it.
+//   2. _count is set from 0 to -max_jint. A thread entering the monitor
+//      increments _count before it blocks; if the increment leaves _count
+//      negative the deflater has won, otherwise the deflater's CAS fails.
+//   3. The displaced header is stored back into the object if the object's
+//      mark still refers to the monitor.
+//
+// If step 2 fails, or if the monitor has waiters, the deflater takes the
+// monitor over and exits it, which hands the monitor to a successor in case
+// an entering thread queued up while DEFLATER_MARKER was installed.
+//
+// An entering thread which finds _count negative restores the header on
+// behalf of the deflater and inflates the object again, see
+// ObjectMonitor::enter(). FastHashCode() likewise retries if the hash it
+// installed in the monitor header may not have reached the object.
+//
+// Threads may still refer to a deflated monitor until they reach the next
+// safepoint, so deflated monitors keep their object, header and marker, and
+// are put on gDeflatedList. The cleanup of the next safepoint moves them to
+// gSafeToFreeList, from where the service thread resets them and returns
+// them to the gFreeList. All three lists are protected by ListLock.
+
+static ObjectMonitor * gDeflatedList = NULL ;     // deflated, may still be referenced
+static ObjectMonitor * gDeflatedTail = NULL ;
+static int gDeflatedCount = 0 ;
+static ObjectMonitor * volatile gSafeToFreeList = NULL ;  // deflated before the last safepoint
+static ObjectMonitor * gSafeToFreeTail = NULL ;
+static int gSafeToFreeCount = 0 ;
+static jlong LastAsyncDeflationTime = 0 ;         // millis
+
+bool ObjectSynchronizer::is_async_deflation_needed() {
+  if (!AsyncDeflateIdleMonitors) {
+    return false;
+  }
+  if (gSafeToFreeList != NULL || ForceMonitorScavenge != 0) {
+    return true;
+  }
+  return os::javaTimeMillis() - LastAsyncDeflationTime >= AsyncDeflationInterval &&
+         MonitorPopulation > MonitorFreeCount;
+}
+
+void ObjectSynchronizer::release_async_deflated_monitors() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  assert(AsyncDeflateIdleMonitors, "only used with concurrent deflation");
+
+  // No thread can still refer to the monitors that were deflated before
+  // this safepoint.
+  Thread::muxAcquire (&ListLock, "release_async_deflated_monitors") ;
+  if (gDeflatedList != NULL) {
+    if (gSafeToFreeList == NULL) {
+      gSafeToFreeTail = gDeflatedTail;
+    }
+    gDeflatedTail->FreeNext = gSafeToFreeList;
+    gSafeToFreeList = gDeflatedList;
+    gSafeToFreeCount += gDeflatedCount;
+    gDeflatedList = NULL;
+    gDeflatedTail = NULL;
+    gDeflatedCount = 0;
+  }
+  Thread::muxRelease (&ListLock) ;
+}
+
+// Deflate a single monitor if not in use, without a safepoint.
+// Return true if deflated, false if in use
+bool ObjectSynchronizer::deflate_monitor_using_JT(ObjectMonitor* mid, Thread* Self,
+                                                  ObjectMonitor** FreeHeadp, ObjectMonitor** FreeTailp) {
+  oop obj = (oop) mid->object();
+  if (obj == NULL || mid->is_busy()) {
+    return false;
+  }
+  // Only monitors which are installed in their object may be deflated;
+  // inflate() may not have published the monitor yet.
+  if (obj->mark() != markOopDesc::encode(mid)) {
+    return false;
+  }
+
+  if (Atomic::cmpxchg_ptr (DEFLATER_MARKER, &mid->_owner, NULL) != NULL) {
+    return false;
+  }
+  if (mid->_waiters != 0 ||
+      Atomic::cmpxchg_ptr ((intptr_t) -max_jint, &mid->_count, (intptr_t) 0) != 0) {
+    // The monitor became busy. Exit it on behalf of DEFLATER_MARKER so
+    // that a thread which queued up in the meantime is woken.
+    OrderAccess::release_store_ptr(&mid->_owner, Self);
+    mid->OwnerIsThread = 1;
+    mid->exit(false, Self);
+    return false;
+  }
+
+  // The monitor is deflated; the entering threads now retry with the object.
+  TEVENT (deflate_idle_monitors - async scavenge) ;
+  if (TraceMonitorInflation) {
+    if (obj->is_instance()) {
+      ResourceMark rm;
+      tty->print_cr("Deflating object " INTPTR_FORMAT " , mark " INTPTR_FORMAT " , type %s",
+                    (void *) obj, (intptr_t) mid->header(), obj->klass()->external_name());
+    }
+  }
+  mid->install_displaced_markword_in_object();
+
+  if (*FreeHeadp == NULL) *FreeHeadp = mid;
+  if (*FreeTailp != NULL) {
+    (*FreeTailp)->FreeNext = mid;
+  }
+  mid->FreeNext = NULL;
+  *FreeTailp = mid;
+  return true;
+}
+
+// Return the monitors deflated before the last safepoint to the gFreeList.
+void ObjectSynchronizer::free_async_deflated_monitors() {
+  Thread::muxAcquire (&ListLock, "free_async_deflated_monitors") ;
+  ObjectMonitor * List = gSafeToFreeList ;
+  ObjectMonitor * Tail = gSafeToFreeTail ;
+  int Tally = gSafeToFreeCount ;
+  gSafeToFreeList = NULL ;
+  gSafeToFreeTail = NULL ;
+  gSafeToFreeCount = 0 ;
+  Thread::muxRelease (&ListLock) ;
+
+  if (List == NULL) {
+    return;
+  }
+  for (ObjectMonitor * mid = List ; mid != NULL ; mid = mid->FreeNext) {
+    assert (mid->_owner == DEFLATER_MARKER && mid->_count == -max_jint, "invariant") ;
+    guarantee (mid->_waiters == 0 && mid->_cxq == NULL && mid->_EntryList == NULL, "invariant") ;
+    mid->_header = NULL;
+    mid->_object = NULL;
+    mid->_count = 0;
+    mid->set_owner(NULL);
+  }
+
+  DeflateMonitorCounters counters;
+  counters.nInuse = 0;
+  counters.nInCirculation = 0;
+  counters.nScavenged = 0;
+  release_deflated_monitors(List, Tail, &counters, 0, 0, Tally);
+}
+
+void ObjectSynchronizer::deflate_idle_monitors_using_JT() {
+  assert(AsyncDeflateIdleMonitors, "only used with concurrent deflation");
+  JavaThread* self = JavaThread::current();
+  assert(self->thread_state() == _thread_in_vm, "must be in vm");
+
+  free_async_deflated_monitors();
+
+  ObjectMonitor * FreeHead = NULL ;  // Local SLL of scavenged monitors
+  ObjectMonitor * FreeTail = NULL ;
+  int nInuse = 0;
+  int nInCirculation = 0;
+  int nScavenged = 0;
+
+  ObjectMonitor* block =
+    (ObjectMonitor*)OrderAccess::load_ptr_acquire(&gBlockList);
+  for (; block != NULL; block = (ObjectMonitor*)next(block)) {
+    nInCirculation += _BLOCKSIZE;
+    for (int i = 1; i < _BLOCKSIZE; i++) {
+      ObjectMonitor* mid = (ObjectMonitor*)&block[i];
+      if (mid->object() == NULL) {
+        continue;
+      }
+      if (deflate_monitor_using_JT(mid, self, &FreeHead, &FreeTail)) {
+        nScavenged++;
+      } else {
+        nInuse++;
+      }
+    }
+    // Do not hold up a safepoint for the whole scan. The monitors on the
+    // local list are only published afterwards, so they remain allocated
+    // until the safepoint after that.
+    if (SafepointSynchronize::do_call_back()) {
+      ThreadBlockInVM tbivm(self);
+    }
+  }
+
+  Thread::muxAcquire (&ListLock, "deflate_idle_monitors_using_JT") ;
   if (FreeHead != NULL) {
-     guarantee (FreeTail != NULL && nScavenged > 0, "invariant") ;
-     assert (FreeTail->FreeNext == NULL, "invariant") ;
-     // constant-time list splice - prepend scavenged segment to gFreeList
-     FreeTail->FreeNext = gFreeList ;
-     gFreeList = FreeHead ;
+    if (gDeflatedList == NULL) {
+      gDeflatedTail = FreeTail;
+    }
+    FreeTail->FreeNext = gDeflatedList;
+    gDeflatedList = FreeHead;
+    gDeflatedCount += nScavenged;
   }
   Thread::muxRelease (&ListLock) ;
 
+  if (ObjectMonitor::Knob_Verbose) {
+    ::printf ("Async deflate: InCirc=%d InUse=%d Scavenged=%d ForceMonitorScavenge=%d : pop=%d free=%d\n",
+        nInCirculation, nInuse, nScavenged, ForceMonitorScavenge,
+        MonitorPopulation, MonitorFreeCount) ;
+    ::fflush(stdout) ;
+  }
+
+  ForceMonitorScavenge = 0;    // Reset
+  LastAsyncDeflationTime = os::javaTimeMillis();
+
   OM_PERFDATA_OP(Deflations, inc(nScavenged));
   OM_PERFDATA_OP(MonExtant, set_value(nInCirculation));
-
-  // TODO: Add objectMonitor leak detection.
-  // Audit/inventory the objectMonitors -- make sure they're all accounted for.
-  GVars.stwRandom = os::random() ;
-  GVars.stwCycle ++ ;
 }
 
 // Monitor cleanup on JavaThread::exit
@@ -1708,7 +2015,7 @@ void ObjectSynchronizer::verify() {
     for (int i = 1; i < _BLOCKSIZE; i++) {
       ObjectMonitor* mid = (ObjectMonitor *)(block + i);
       oop object = (oop)mid->object();
-      if (object != NULL) {
+      if (object != NULL && !mid->is_being_async_deflated()) {
         mid->verify();
       }
     }
@@ -34,6 +34,13 @@
 
 class ObjectMonitor;
 
+// The number of monitors seen while deflating idle monitors
+struct DeflateMonitorCounters {
+  int nInuse;           // currently associated with objects
+  int nInCirculation;   // extant
+  int nScavenged;       // reclaimed
+};
+
 class ObjectSynchronizer : AllStatic {
   friend class VMStructs;
  public:
@@ -113,6 +120,23 @@ class ObjectSynchronizer : AllStatic {
   // Basically we deflate all monitors that are not busy.
   // An adaptive profile-based deflation policy could be used if needed
   static void deflate_idle_monitors();
+  // The steps of deflate_idle_monitors(), so that the safepoint cleanup can
+  // share them between worker threads. After prepare, the in-use lists of
+  // the threads and the global list (with MonitorInUseLists), or else the
+  // monitor blocks, are deflated, possibly in parallel, followed by finish.
+  static void prepare_deflate_idle_monitors(DeflateMonitorCounters* counters);
+  static void deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters);
+  static void deflate_global_idle_monitors(DeflateMonitorCounters* counters);
+  static void deflate_monitor_blocks(DeflateMonitorCounters* counters);
+  static void finish_deflate_idle_monitors(DeflateMonitorCounters* counters);
+
+  // Concurrent deflation by the service thread, see AsyncDeflateIdleMonitors
+  static bool is_async_deflation_needed();
+  static void deflate_idle_monitors_using_JT();
+  static bool deflate_monitor_using_JT(ObjectMonitor* mid, Thread* Self,
+                                       ObjectMonitor** FreeHeadp, ObjectMonitor** FreeTailp);
+  // Called at safepoints to allow the reuse of the monitors deflated before
+  static void release_async_deflated_monitors();
   static int walk_monitor_list(ObjectMonitor** listheadp,
                                ObjectMonitor** FreeHeadp,
                                ObjectMonitor** FreeTailp);
@@ -136,6 +160,11 @@ class ObjectSynchronizer : AllStatic {
   static ObjectMonitor * volatile gOmInUseList; // for moribund thread, so monitors they inflated still get scanned
   static int gOmInUseCount;
 
+  static void free_async_deflated_monitors();
+  static void release_deflated_monitors(ObjectMonitor* FreeHead, ObjectMonitor* FreeTail,
+                                        DeflateMonitorCounters* counters,
+                                        int nInuse, int nInCirculation, int nScavenged);
+
 };
 
 // ObjectLocker enforced balanced locking and can never thrown an
@@ -1431,6 +1431,7 @@ void JavaThread::initialize() {
   set_claimed_par_id(UINT_MAX);
 
   set_saved_exception_pc(NULL);
+  _polling_page = SafepointSynchronize::poll_disarmed_value();
   set_threadObj(NULL);
   _anchor.clear();
   set_entry_point(NULL);
@@ -2412,6 +2413,13 @@ void JavaThread::check_safepoint_and_suspend_for_native_trans(JavaThread *thread
     SafepointSynchronize::block(curJT);
   }
 
+  if (curJT->has_handshake()) {
+    curJT->handshake_process_by_self();
+    if (SafepointSynchronize::do_call_back()) {
+      SafepointSynchronize::block(curJT);
+    }
+  }
+
   if (thread->is_deopt_suspend()) {
     thread->clear_deopt_suspend();
     RegisterMap map(thread, false);
@@ -3376,6 +3384,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   jint os_init_2_result = os::init_2();
   if (os_init_2_result != JNI_OK) return os_init_2_result;
 
+  // Set up the thread-local polls, needs the polling page
+  SafepointSynchronize::initialize_local_polling();
+
   jint adjust_after_os_result = Arguments::adjust_after_os();
   if (adjust_after_os_result != JNI_OK) return adjust_after_os_result;
 
@@ -4118,6 +4129,12 @@ void Threads::remove(JavaThread* p) {
 
     assert(includes(p), "p must be present");
 
+    // Complete a pending handshake operation, the VM thread does not find
+    // the thread once it is off the list.
+    if (p->has_handshake()) {
+      p->handshake_process_by_self();
+    }
+
     JavaThread* current = _thread_list;
     JavaThread* prev    = NULL;
 
@@ -31,6 +31,7 @@
 #include "prims/jni.h"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/frame.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/javaFrameAnchor.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -195,7 +196,8 @@ class Thread: public ThreadShadow {
     _deopt_suspend          = 0x10000000U, // thread needs to self suspend for deopt
 
     _has_async_exception    = 0x00000001U, // there is a pending async exception
-    _critical_native_unlock = 0x00000002U  // Must call back to unlock JNI critical lock
+    _critical_native_unlock = 0x00000002U, // Must call back to unlock JNI critical lock
+    _handshake_pending      = 0x00000004U  // a handshake operation is pending for the thread
   };
 
   // various suspension related flags - atomically updated
@@ -860,6 +862,8 @@ class JavaThread: public Thread {
  private:
   ThreadSafepointState *_safepoint_state;        // Holds information about a thread during a safepoint
   address               _saved_exception_pc;     // Saved pc of instruction where last implicit exception happened
+  void* volatile        _polling_page;           // Thread-local poll word, see ThreadLocalHandshakes
+  HandshakeState        _handshake;              // Pending handshake operation
 
   // JavaThread termination support
   enum TerminatedTypes {
@@ -1136,6 +1140,20 @@ class JavaThread: public Thread {
   void clear_deopt_suspend()      { clear_suspend_flag(_deopt_suspend); }
   bool is_deopt_suspend()         { return (_suspend_flags & _deopt_suspend) != 0; }
 
+  // Thread-local handshakes
+  void set_polling_page(void* poll_value)        { _polling_page = poll_value; }
+  void* polling_page() const                     { return _polling_page; }
+  HandshakeState* handshake_state()              { return &_handshake; }
+  void set_handshake_pending()                   { set_suspend_flag(_handshake_pending); }
+  void clear_handshake_pending()                 { clear_suspend_flag(_handshake_pending); }
+  bool has_handshake() const                     { return (_suspend_flags & _handshake_pending) != 0; }
+  void handshake_process_by_self()               { _handshake.process_by_self(this); }
+  // Whether the thread may inspect the stack of this thread, either because
+  // it is this thread or because it executes a handshake operation for it
+  bool is_handshake_safe_for(Thread* thread) const {
+    return this == thread || _handshake.active_handshaker() == thread;
+  }
+
   bool is_external_suspend() const {
     return (_suspend_flags & _external_suspend) != 0;
   }
@@ -1370,6 +1388,7 @@ class JavaThread: public Thread {
   static ByteSize is_method_handle_return_offset() { return byte_offset_of(JavaThread, _is_method_handle_return); }
   static ByteSize stack_guard_state_offset()     { return byte_offset_of(JavaThread, _stack_guard_state   ); }
   static ByteSize suspend_flags_offset()         { return byte_offset_of(JavaThread, _suspend_flags       ); }
+  static ByteSize polling_page_offset()          { return byte_offset_of(JavaThread, _polling_page        ); }
 
   static ByteSize do_not_unlock_if_synchronized_offset() { return byte_offset_of(JavaThread, _do_not_unlock_if_synchronized); }
   static ByteSize should_post_on_exceptions_flag_offset() {
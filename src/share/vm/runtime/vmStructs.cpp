@@ -768,7 +768,9 @@ typedef TwoOopHashtable<Symbol*, mtClass>     SymbolTwoOopHashtable;
   /* CodeCache (NOTE: incomplete) */                                                                                                 \
   /********************************/                                                                                                 \
                                                                                                                                      \
-     static_field(CodeCache,                   _heap,                                         CodeHeap*)                             \
+     static_field(CodeCache,                   _heaps,                                        GrowableArray<CodeHeap*>*)             \
+     static_field(CodeCache,                   _low_bound,                                    address)                               \
+     static_field(CodeCache,                   _high_bound,                                   address)                               \
      static_field(CodeCache,                   _scavenge_root_nmethods,                       nmethod*)                              \
                                                                                                                                      \
   /*******************************/                                                                                                  \
@@ -2004,6 +2006,15 @@ typedef TwoOopHashtable<Symbol*, mtClass>     SymbolTwoOopHashtable;
   declare_c2_type(AndVNode, VectorNode)                                   \
   declare_c2_type(OrVNode, VectorNode)                                    \
   declare_c2_type(XorVNode, VectorNode)                                   \
+  declare_c2_type(ReductionNode, Node)                                    \
+  declare_c2_type(AddReductionVINode, ReductionNode)                      \
+  declare_c2_type(AddReductionVLNode, ReductionNode)                      \
+  declare_c2_type(AddReductionVFNode, ReductionNode)                      \
+  declare_c2_type(AddReductionVDNode, ReductionNode)                      \
+  declare_c2_type(MulReductionVINode, ReductionNode)                      \
+  declare_c2_type(MulReductionVLNode, ReductionNode)                      \
+  declare_c2_type(MulReductionVFNode, ReductionNode)                      \
+  declare_c2_type(MulReductionVDNode, ReductionNode)                      \
   declare_c2_type(LoadVectorNode, LoadNode)                               \
   declare_c2_type(StoreVectorNode, StoreNode)                             \
   declare_c2_type(ReplicateBNode, VectorNode)                             \
@@ -46,6 +46,8 @@
   template(FindDeadlocks)                         \
   template(ForceSafepoint)                        \
   template(ForceAsyncSafepoint)                   \
+  template(HandshakeOneThread)                    \
+  template(HandshakeFallback)                     \
   template(Deoptimize)                            \
   template(DeoptimizeFrame)                       \
   template(DeoptimizeAll)                         \
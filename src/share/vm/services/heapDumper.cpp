@@ -33,15 +33,18 @@
 #include "oops/objArrayKlass.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/reflectionUtils.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/heapDumper.hpp"
+#include "services/heapDumperCompression.hpp"
 #include "services/threadService.hpp"
 #include "utilities/ostream.hpp"
 #include "utilities/macros.hpp"
 #if INCLUDE_ALL_GCS
+#include "gc_implementation/g1/g1CollectedHeap.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #endif // INCLUDE_ALL_GCS
 
@@ -367,11 +370,26 @@ enum {
 };
 
 // Supports I/O operations on a dump file
+//
+// The sub-records of the heap dump are grouped into HPROF_HEAP_DUMP_SEGMENT
+// records. A segment is assembled in the I/O buffer, so its length can be
+// filled in before the segment is written and the dump file is written
+// strictly sequentially. A sub-record which does not fit into the buffer
+// is written as a segment of its own, whose length is known up front.
+//
+// A DumpWriter either writes to the dump file, or, when the heap is dumped
+// by several threads, collects the segments of one dumper thread and
+// appends each completed segment to the dump file of its parent writer.
+// If a compression level is given, every buffer is compressed into a gzip
+// member before it is written.
 
 class DumpWriter : public StackObj {
  private:
   enum {
-    io_buffer_size  = 8*M
+    io_buffer_size  = 8*M,
+    // the buffer size of the writers of the dumper threads
+    segment_buffer_size = 1*M,
+    dump_segment_header_size = 9
   };
 
   int _fd;              // file descriptor (-1 if dump file not open)
@@ -381,7 +399,18 @@ class DumpWriter : public StackObj {
   size_t _size;
   size_t _pos;
 
-  jlong _dump_start;
+  bool _in_dump_segment;     // are we currently in a dump segment?
+  bool _is_huge_sub_record;  // is the current sub-record larger than the buffer?
+  DEBUG_ONLY(size_t _sub_record_left;) // bytes not yet written of the current sub-record
+
+  uint _compression_level;
+  GZipCompressor* _compressor;  // NULL if the dump is not compressed
+  char* _out_buffer;            // holds the compressed buffer
+  size_t _out_size;
+
+  DumpWriter* _parent;      // the writer of the dump file for a dumper thread writer
+  Mutex* _lock;             // serializes the segments of the dumper threads
+  bool _owns_parent_lock;   // set while a dumper thread writes a huge sub-record
 
   char* _error;   // error message when I/O fails
 
@@ -395,35 +424,37 @@ class DumpWriter : public StackObj {
 
   void set_error(const char* error)             { _error = (char*)os::strdup(error); }
 
+  void initialize(size_t buffer_size);
+
+  // records the error and closes the dump file
+  void fail(const char* error);
+
   // all I/O go through this function
   void write_internal(void* s, size_t len);
+  // writes to the dump file of this writer or of the parent writer
+  void write_to_file(const char* s, size_t len);
 
  public:
-  DumpWriter(const char* path);
+  DumpWriter(const char* path, uint compression_level);
+  DumpWriter(DumpWriter* parent);
   ~DumpWriter();
 
   void close();
-  bool is_open() const                  { return file_descriptor() >= 0; }
+  bool is_open() const;
   void flush();
 
-  jlong dump_start() const                      { return _dump_start; }
-  void set_dump_start(jlong pos);
-  julong current_record_length();
-
   // total number of bytes written to the disk
   julong bytes_written() const          { return _bytes_written; }
 
-  // adjust the number of bytes written to disk (used to keep the count
-  // of the number of bytes written in case of rewrites)
-  void adjust_bytes_written(jlong n)    { _bytes_written += n; }
-
-  // number of (buffered) bytes as yet unwritten to the dump file
-  size_t bytes_unwritten() const        { return position(); }
-
   char* error() const                   { return _error; }
 
-  jlong current_offset();
-  void seek_to_offset(jlong pos);
+  // starts a new sub-record of the given total length in a dump segment,
+  // starting a new segment if needed
+  void start_sub_record(u1 tag, u4 len);
+  // ends the current sub-record
+  void end_sub_record();
+  // completes and writes the current dump segment (if any)
+  void finish_dump_segment();
 
   // writer functions
   void write_raw(void* s, size_t len);
@@ -437,10 +468,52 @@ class DumpWriter : public StackObj {
   void write_id(u4 x);
 };
 
-DumpWriter::DumpWriter(const char* path) {
-  // try to allocate an I/O buffer of io_buffer_size. If there isn't
+DumpWriter::DumpWriter(const char* path, uint compression_level) {
+  _fd = -1;
+  _parent = NULL;
+  _compression_level = compression_level;
+  _lock = new Mutex(Mutex::leaf, "HeapDumpWriter_lock", true);
+  initialize(io_buffer_size);
+
+  if (_error == NULL) {
+    _fd = os::create_binary_file(path, false);    // don't replace existing file
+
+    // if the open failed we record the error
+    if (_fd < 0) {
+      _error = (char*)os::strdup(strerror(errno));
+    }
+  }
+}
+
+DumpWriter::DumpWriter(DumpWriter* parent) {
+  _fd = -1;
+  _parent = parent;
+  _compression_level = parent->_compression_level;
+  _lock = NULL;
+  initialize(segment_buffer_size);
+
+  if (_error != NULL) {
+    // without buffers this thread cannot write its part of the dump
+    MutexLockerEx ml(_parent->_lock, Mutex::_no_safepoint_check_flag);
+    _parent->fail(_error);
+  }
+}
+
+void DumpWriter::initialize(size_t buffer_size) {
+  _pos = 0;
+  _error = NULL;
+  _bytes_written = 0L;
+  _in_dump_segment = false;
+  _is_huge_sub_record = false;
+  DEBUG_ONLY(_sub_record_left = 0;)
+  _compressor = NULL;
+  _out_buffer = NULL;
+  _out_size = 0;
+  _owns_parent_lock = false;
+
+  // try to allocate an I/O buffer of buffer_size. If there isn't
   // sufficient memory then reduce size until we can allocate something.
-  _size = io_buffer_size;
+  _size = buffer_size;
   do {
     _buffer = (char*)os::malloc(_size, mtInternal);
     if (_buffer == NULL) {
@@ -448,66 +521,104 @@ DumpWriter::DumpWriter(const char* path) {
     }
   } while (_buffer == NULL && _size > 0);
   assert((_size > 0 && _buffer != NULL) || (_size == 0 && _buffer == NULL), "sanity check");
-  _pos = 0;
-  _error = NULL;
-  _bytes_written = 0L;
-  _dump_start = (jlong)-1;
-  _fd = os::create_binary_file(path, false);    // don't replace existing file
+  if (_buffer == NULL) {
+    set_error("Could not allocate buffer memory");
+    return;
+  }
 
-  // if the open failed we record the error
-  if (_fd < 0) {
-    _error = (char*)os::strdup(strerror(errno));
+  if (_compression_level > 0) {
+    _compressor = new (std::nothrow) GZipCompressor((int)_compression_level);
+    _out_size = GZipCompressor::compressed_size_bound(_size);
+    _out_buffer = (char*)os::malloc(_out_size, mtInternal);
+    if (_compressor == NULL || !_compressor->is_initialized() || _out_buffer == NULL) {
+      set_error("Could not allocate compression buffers");
+    }
   }
 }
 
 DumpWriter::~DumpWriter() {
+  assert(!_in_dump_segment, "dump segment not finished");
   // flush and close dump file
   if (is_open()) {
     close();
   }
   if (_buffer != NULL) os::free(_buffer);
+  if (_out_buffer != NULL) os::free(_out_buffer);
+  if (_compressor != NULL) delete _compressor;
+  if (_lock != NULL) delete _lock;
   if (_error != NULL) os::free(_error);
 }
 
+bool DumpWriter::is_open() const {
+  if (_parent != NULL) {
+    return _error == NULL && _parent->is_open();
+  }
+  return file_descriptor() >= 0;
+}
+
 // closes dump file (if open)
 void DumpWriter::close() {
   // flush and close dump file
   if (is_open()) {
     flush();
+    if (_parent == NULL && is_open()) {
+      ::close(file_descriptor());
+      set_file_descriptor(-1);
+    }
+  }
+}
+
+void DumpWriter::fail(const char* error) {
+  assert(_parent == NULL, "only the writer of the dump file can fail");
+  if (_error == NULL) {
+    set_error(error);
+  }
+  if (file_descriptor() >= 0) {
     ::close(file_descriptor());
     set_file_descriptor(-1);
   }
 }
 
-// sets the dump starting position
-void DumpWriter::set_dump_start(jlong pos) {
-  _dump_start = pos;
-}
+// write to the file, compressing the data first if needed
+void DumpWriter::write_internal(void* s, size_t len) {
+  if (_compressor == NULL) {
+    write_to_file((const char*)s, len);
+    return;
+  }
 
-julong DumpWriter::current_record_length() {
-  if (is_open()) {
-    // calculate the size of the dump record
-    julong dump_end = bytes_written() + bytes_unwritten();
-    assert(dump_end == (size_t)current_offset(), "checking");
-    julong dump_len = dump_end - dump_start() - 4;
-    return dump_len;
+  // Every piece becomes a gzip member of its own. Since the segments
+  // of a dumper thread are written in one piece, the members of the
+  // dumper threads are never interleaved within a segment.
+  const char* pos = (const char*)s;
+  while (len > 0 && is_open()) {
+    size_t n = MIN2(len, buffer_size());
+    size_t out_len = _compressor->compress(pos, n, _out_buffer, _out_size);
+    write_to_file(_out_buffer, out_len);
+    pos += n;
+    len -= n;
   }
-  return 0;
 }
 
-// write directly to the file
-void DumpWriter::write_internal(void* s, size_t len) {
+void DumpWriter::write_to_file(const char* s, size_t len) {
+  if (_parent != NULL) {
+    if (_owns_parent_lock) {
+      _parent->write_to_file(s, len);
+    } else {
+      MutexLockerEx ml(_parent->_lock, Mutex::_no_safepoint_check_flag);
+      _parent->write_to_file(s, len);
+    }
+    return;
+  }
+
   if (is_open()) {
-    const char* pos = (char*)s;
+    const char* pos = s;
     ssize_t n = 0;
     while (len > 0) {
       uint tmp = (uint)MIN2(len, (size_t)UINT_MAX);
       n = ::write(file_descriptor(), pos, tmp);
 
       if (n < 0) {
-        set_error(strerror(errno));
-        ::close(file_descriptor());
-        set_file_descriptor(-1);
+        fail(strerror(errno));
         return;
       }
 
@@ -520,14 +631,17 @@ void DumpWriter::write_internal(void* s, size_t len) {
 
 // write raw bytes
 void DumpWriter::write_raw(void* s, size_t len) {
+  assert(!_in_dump_segment || (_sub_record_left >= len), "sub-record too large");
+  DEBUG_ONLY(if (_in_dump_segment) _sub_record_left -= len;)
+
   if (is_open()) {
     // flush buffer to make room
-    if ((position() + len) >= buffer_size()) {
+    if ((position() + len) > buffer_size()) {
       flush();
     }
 
-    // buffer not available or too big to buffer it
-    if ((buffer() == NULL) || (len >= buffer_size())) {
+    // too big to buffer it
+    if (len > buffer_size()) {
       write_internal(s, len);
     } else {
       // Should optimize this for u1/u2/u4/u8 sizes.
@@ -545,27 +659,57 @@ void DumpWriter::flush() {
   }
 }
 
-jlong DumpWriter::current_offset() {
-  if (is_open()) {
-    // the offset is the file offset plus whatever we have buffered
-    jlong offset = os::current_file_offset(file_descriptor());
-    assert(offset >= 0, "lseek failed");
-    return offset + position();
-  } else {
-    return (jlong)-1;
+void DumpWriter::start_sub_record(u1 tag, u4 len) {
+  if (!_in_dump_segment) {
+    // the segment header has to start at the beginning of the buffer
+    if (position() > 0) {
+      flush();
+    }
+    assert(!is_open() || position() == 0, "must be at the start");
+
+    _is_huge_sub_record = len > buffer_size() - dump_segment_header_size;
+    if (_is_huge_sub_record && _parent != NULL) {
+      // The segment is written in several pieces which must not be
+      // interleaved with the segments of the other dumper threads.
+      _parent->_lock->lock_without_safepoint_check();
+      _owns_parent_lock = true;
+    }
+
+    write_u1(HPROF_HEAP_DUMP_SEGMENT);
+    write_u4(0); // current ticks
+    // the length is fixed up in finish_dump_segment() unless the
+    // segment only holds a huge sub-record
+    write_u4(len);
+    _in_dump_segment = true;
+  } else if (_is_huge_sub_record || (len > buffer_size() - position())) {
+    // the sub-record does not fit into the current segment
+    finish_dump_segment();
+    start_sub_record(tag, len);
+    return;
   }
+
+  DEBUG_ONLY(_sub_record_left = len);
+  write_u1(tag);
 }
 
-void DumpWriter::seek_to_offset(jlong off) {
-  assert(off >= 0, "bad offset");
+void DumpWriter::end_sub_record() {
+  assert(_in_dump_segment, "must be in dump segment");
+  assert(!is_open() || _sub_record_left == 0, "sub-record not written completely");
+}
 
-  // need to flush before seeking
-  flush();
+void DumpWriter::finish_dump_segment() {
+  if (_in_dump_segment) {
+    assert(!is_open() || _sub_record_left == 0, "last sub-record not written completely");
+    if (!_is_huge_sub_record && is_open()) {
+      Bytes::put_Java_u4((address)(buffer() + 5), (u4)(position() - dump_segment_header_size));
+    }
+    flush();
+    _in_dump_segment = false;
 
-  // may be closed due to I/O error
-  if (is_open()) {
-    jlong n = os::seek_to_file_offset(file_descriptor(), off);
-    assert(n >= 0, "lseek failed");
+    if (_owns_parent_lock) {
+      _owns_parent_lock = false;
+      _parent->_lock->unlock();
+    }
   }
 }
 
@@ -633,9 +777,18 @@ class DumperSupport : AllStatic {
   // returns hprof tag for the given basic type
   static hprofTag type2tag(BasicType type);
 
+  // returns the size of the value of a field with the given signature
+  static u4 sig2size(Symbol* sig);
+
   // returns the size of the instance of the given class
   static u4 instance_size(Klass* k);
 
+  // returns the size of the static fields of the given class as they are
+  // dumped, and sets field_count to the number of dumped static fields
+  static u4 get_static_fields_size(InstanceKlass* ik, u2& field_count);
+  // returns the number of instance fields of the given class
+  static u2 get_instance_fields_count(InstanceKlass* ik);
+
   // dump a jfloat
   static void dump_float(DumpWriter* writer, jfloat f);
   // dump a jdouble
@@ -665,15 +818,9 @@ class DumperSupport : AllStatic {
   static void dump_stack_frame(DumpWriter* writer, int frame_serial_num, int class_serial_num, Method* m, int bci);
 
   // check if we need to truncate an array
-  static int calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size);
-
-  // writes a HPROF_HEAP_DUMP_SEGMENT record
-  static void write_dump_header(DumpWriter* writer);
-
-  // fixes up the length of the current dump record
-  static void write_current_dump_record_length(DumpWriter* writer);
+  static int calculate_array_max_length(arrayOop array, short header_size);
 
-  // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
+  // finishes the current dump segment and writes HPROF_HEAP_DUMP_END record
   static void end_of_dump(DumpWriter* writer);
 };
 
@@ -806,6 +953,28 @@ void DumperSupport::dump_field_value(DumpWriter* writer, char type, address addr
   }
 }
 
+// returns the size of the value of a field with the given signature
+u4 DumperSupport::sig2size(Symbol* sig) {
+  switch (sig->byte_at(0)) {
+    case JVM_SIGNATURE_CLASS   :
+    case JVM_SIGNATURE_ARRAY   : return oopSize;
+
+    case JVM_SIGNATURE_BYTE    :
+    case JVM_SIGNATURE_BOOLEAN : return 1;
+
+    case JVM_SIGNATURE_CHAR    :
+    case JVM_SIGNATURE_SHORT   : return 2;
+
+    case JVM_SIGNATURE_INT     :
+    case JVM_SIGNATURE_FLOAT   : return 4;
+
+    case JVM_SIGNATURE_LONG    :
+    case JVM_SIGNATURE_DOUBLE  : return 8;
+
+    default : ShouldNotReachHere(); /* to shut up compiler */ return 0;
+  }
+}
+
 // returns the size of the instance of the given class
 u4 DumperSupport::instance_size(Klass* k) {
   HandleMark hm;
@@ -815,52 +984,41 @@ u4 DumperSupport::instance_size(Klass* k) {
 
   for (FieldStream fld(ikh, false, false); !fld.eos(); fld.next()) {
     if (!fld.access_flags().is_static()) {
-      Symbol* sig = fld.signature();
-      switch (sig->byte_at(0)) {
-        case JVM_SIGNATURE_CLASS   :
-        case JVM_SIGNATURE_ARRAY   : size += oopSize; break;
-
-        case JVM_SIGNATURE_BYTE    :
-        case JVM_SIGNATURE_BOOLEAN : size += 1; break;
-
-        case JVM_SIGNATURE_CHAR    :
-        case JVM_SIGNATURE_SHORT   : size += 2; break;
-
-        case JVM_SIGNATURE_INT     :
-        case JVM_SIGNATURE_FLOAT   : size += 4; break;
-
-        case JVM_SIGNATURE_LONG    :
-        case JVM_SIGNATURE_DOUBLE  : size += 8; break;
-
-        default : ShouldNotReachHere();
-      }
+      size += sig2size(fld.signature());
     }
   }
   return size;
 }
 
-// dumps static fields of the given class
-void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
+// returns the size of the static fields of the given class as they are dumped
+u4 DumperSupport::get_static_fields_size(InstanceKlass* ik, u2& field_count) {
   HandleMark hm;
-  instanceKlassHandle ikh = instanceKlassHandle(Thread::current(), k);
+  instanceKlassHandle ikh = instanceKlassHandle(Thread::current(), ik);
+
+  field_count = 0;
+  u4 size = 0;
 
-  // pass 1 - count the static fields
-  u2 field_count = 0;
   for (FieldStream fldc(ikh, true, true); !fldc.eos(); fldc.next()) {
-    if (fldc.access_flags().is_static()) field_count++;
+    if (fldc.access_flags().is_static()) {
+      field_count++;
+      size += sig2size(fldc.signature());
+    }
   }
+
   // Add in resolved_references which is referenced by the cpCache
   // The resolved_references is an array per InstanceKlass holding the
   // strings and other oops resolved from the constant pool.
   oop resolved_references = ikh->constants()->resolved_references_or_null();
   if (resolved_references != NULL) {
     field_count++;
+    size += sizeof(address);
 
     // Add in the resolved_references of the used previous versions of the class
     // in the case of RedefineClasses
     InstanceKlass* prev = ikh->previous_versions();
     while (prev != NULL && prev->constants()->resolved_references_or_null() != NULL) {
       field_count++;
+      size += sizeof(address);
       prev = prev->previous_versions();
     }
   }
@@ -870,8 +1028,24 @@ void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
   oop init_lock = ikh->init_lock();
   if (init_lock != NULL) {
     field_count++;
+    size += sizeof(address);
   }
 
+  // We write the value itself plus a name and a one byte type tag per field.
+  return size + field_count * (sizeof(address) + 1);
+}
+
+// dumps static fields of the given class
+void DumperSupport::dump_static_fields(DumpWriter* writer, Klass* k) {
+  HandleMark hm;
+  instanceKlassHandle ikh = instanceKlassHandle(Thread::current(), k);
+
+  // pass 1 - count the static fields
+  u2 field_count = 0;
+  get_static_fields_size(ikh(), field_count);
+  oop resolved_references = ikh->constants()->resolved_references_or_null();
+  oop init_lock = ikh->init_lock();
+
   writer->write_u2(field_count);
 
   // pass 2 - dump the field descriptors and raw values
@@ -929,16 +1103,25 @@ void DumperSupport::dump_instance_fields(DumpWriter* writer, oop o) {
   }
 }
 
-// dumps the definition of the instance fields for a given class
-void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k) {
+// returns the number of instance fields of the given class
+u2 DumperSupport::get_instance_fields_count(InstanceKlass* ik) {
   HandleMark hm;
-  instanceKlassHandle ikh = instanceKlassHandle(Thread::current(), k);
+  instanceKlassHandle ikh = instanceKlassHandle(Thread::current(), ik);
 
-  // pass 1 - count the instance fields
   u2 field_count = 0;
   for (FieldStream fldc(ikh, true, true); !fldc.eos(); fldc.next()) {
     if (!fldc.access_flags().is_static()) field_count++;
   }
+  return field_count;
+}
+
+// dumps the definition of the instance fields for a given class
+void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k) {
+  HandleMark hm;
+  instanceKlassHandle ikh = instanceKlassHandle(Thread::current(), k);
+
+  // pass 1 - count the instance fields
+  u2 field_count = get_instance_fields_count(ikh());
 
   writer->write_u2(field_count);
 
@@ -956,8 +1139,10 @@ void DumperSupport::dump_instance_field_descriptors(DumpWriter* writer, Klass* k
 // creates HPROF_GC_INSTANCE_DUMP record for the given object
 void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
   Klass* k = o->klass();
+  u4 is = instance_size(k);
+  u4 size = 1 + sizeof(address) + 4 + sizeof(address) + 4 + is;
 
-  writer->write_u1(HPROF_GC_INSTANCE_DUMP);
+  writer->start_sub_record(HPROF_GC_INSTANCE_DUMP, size);
   writer->write_objectID(o);
   writer->write_u4(STACK_TRACE_ID);
 
@@ -965,10 +1150,12 @@ void DumperSupport::dump_instance(DumpWriter* writer, oop o) {
   writer->write_classID(k);
 
   // number of bytes that follow
-  writer->write_u4(instance_size(k) );
+  writer->write_u4(is);
 
   // field values
   dump_instance_fields(writer, o);
+
+  writer->end_sub_record();
 }
 
 // creates HPROF_GC_CLASS_DUMP record for the given class and each of
@@ -984,7 +1171,13 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
     return;
   }
 
-  writer->write_u1(HPROF_GC_CLASS_DUMP);
+  u2 static_fields_count = 0;
+  u4 static_size = get_static_fields_size(ik, static_fields_count);
+  u2 instance_fields_count = get_instance_fields_count(ik);
+  u4 instance_fields_size = instance_fields_count * (sizeof(address) + 1);
+  u4 size = 1 + sizeof(address) + 4 + 6 * sizeof(address) + 4 + 2 + 2 + static_size + 2 + instance_fields_size;
+
+  writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
 
   // class ID
   writer->write_classID(ik);
@@ -1018,13 +1211,16 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
   // description of instance fields
   dump_instance_field_descriptors(writer, k);
 
+  writer->end_sub_record();
+
   // array classes
   k = klass->array_klass_or_null();
   while (k != NULL) {
     Klass* klass = k;
     assert(klass->oop_is_objArray(), "not an ObjArrayKlass");
 
-    writer->write_u1(HPROF_GC_CLASS_DUMP);
+    u4 size = 1 + sizeof(address) + 4 + 6 * sizeof(address) + 4 + 2 + 2 + 2;
+    writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
     writer->write_classID(klass);
     writer->write_u4(STACK_TRACE_ID);
 
@@ -1044,6 +1240,8 @@ void DumperSupport::dump_class_and_array_classes(DumpWriter* writer, Klass* k) {
     writer->write_u2(0);             // static fields
     writer->write_u2(0);             // instance fields
 
+    writer->end_sub_record();
+
     // get the array class for the next rank
     k = klass->array_klass_or_null();
   }
@@ -1056,7 +1254,8 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
  while (k != NULL) {
     Klass* klass = k;
 
-    writer->write_u1(HPROF_GC_CLASS_DUMP);
+    u4 size = 1 + sizeof(address) + 4 + 6 * sizeof(address) + 4 + 2 + 2 + 2;
+    writer->start_sub_record(HPROF_GC_CLASS_DUMP, size);
     writer->write_classID(klass);
     writer->write_u4(STACK_TRACE_ID);
 
@@ -1076,6 +1275,8 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
     writer->write_u2(0);             // static fields
     writer->write_u2(0);             // instance fields
 
+    writer->end_sub_record();
+
     // get the array class for the next rank
     k = klass->array_klass_or_null();
   }
@@ -1083,7 +1284,7 @@ void DumperSupport::dump_basic_type_array_class(DumpWriter* writer, Klass* k) {
 
 // Hprof uses an u4 as record length field,
 // which means we need to truncate arrays that are too long.
-int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array, short header_size) {
+int DumperSupport::calculate_array_max_length(arrayOop array, short header_size) {
   BasicType type = ArrayKlass::cast(array->klass())->element_type();
   assert(type >= T_BOOLEAN && type <= T_OBJECT, "invalid array element type");
 
@@ -1098,19 +1299,9 @@ int DumperSupport::calculate_array_max_length(DumpWriter* writer, arrayOop array
 
   size_t length_in_bytes = (size_t)length * type_size;
 
-  // Create a new record if the current record is non-empty and the array can't fit.
-  julong current_record_length = writer->current_record_length();
-  if (current_record_length > 0 &&
-      (current_record_length + header_size + length_in_bytes) > max_juint) {
-    write_current_dump_record_length(writer);
-    write_dump_header(writer);
-
-    // We now have an empty record.
-    current_record_length = 0;
-  }
-
-  // Calculate max bytes we can use.
-  uint max_bytes = max_juint - (header_size + current_record_length);
+  // Calculate max bytes we can use. A sub-record which does not fit
+  // into the current dump segment gets a segment of its own.
+  uint max_bytes = max_juint - header_size;
 
   // Array too long for the record?
   // Calculate max length and return it.
@@ -1129,9 +1320,10 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
   // sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID) + sizeof(classID)
   short header_size = 1 + 2 * 4 + 2 * sizeof(address);
 
-  int length = calculate_array_max_length(writer, array, header_size);
+  int length = calculate_array_max_length(array, header_size);
+  u4 size = header_size + length * sizeof(address);
 
-  writer->write_u1(HPROF_GC_OBJ_ARRAY_DUMP);
+  writer->start_sub_record(HPROF_GC_OBJ_ARRAY_DUMP, size);
   writer->write_objectID(array);
   writer->write_u4(STACK_TRACE_ID);
   writer->write_u4(length);
@@ -1145,6 +1337,8 @@ void DumperSupport::dump_object_array(DumpWriter* writer, objArrayOop array) {
     oop o = array->obj_at(index);
     writer->write_objectID(o);
   }
+
+  writer->end_sub_record();
 }
 
 #define WRITE_ARRAY(Array, Type, Size, Length) \
@@ -1157,11 +1351,12 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
   // 2 * sizeof(u1) + 2 * sizeof(u4) + sizeof(objectID)
   short header_size = 2 * 1 + 2 * 4 + sizeof(address);
 
-  int length = calculate_array_max_length(writer, array, header_size);
+  int length = calculate_array_max_length(array, header_size);
   int type_size = type2aelembytes(type);
   u4 length_in_bytes = (u4)length * type_size;
+  u4 size = header_size + length_in_bytes;
 
-  writer->write_u1(HPROF_GC_PRIM_ARRAY_DUMP);
+  writer->start_sub_record(HPROF_GC_PRIM_ARRAY_DUMP, size);
   writer->write_objectID(array);
   writer->write_u4(STACK_TRACE_ID);
   writer->write_u4(length);
@@ -1169,6 +1364,7 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
 
   // nothing to copy
   if (length == 0) {
+    writer->end_sub_record();
     return;
   }
 
@@ -1238,6 +1434,8 @@ void DumperSupport::dump_prim_array(DumpWriter* writer, typeArrayOop array) {
     }
     default : ShouldNotReachHere();
   }
+
+  writer->end_sub_record();
 }
 
 // create a HPROF_FRAME record of the given Method* and bci
@@ -1313,10 +1511,12 @@ void JNILocalsDumper::do_oop(oop* obj_p) {
   // ignore null or deleted handles
   oop o = *obj_p;
   if (o != NULL && o != JNIHandles::deleted_handle()) {
-    writer()->write_u1(HPROF_GC_ROOT_JNI_LOCAL);
+    u4 size = 1 + sizeof(address) + 4 + 4;
+    writer()->start_sub_record(HPROF_GC_ROOT_JNI_LOCAL, size);
     writer()->write_objectID(o);
     writer()->write_u4(_thread_serial_num);
     writer()->write_u4((u4)_frame_num);
+    writer()->end_sub_record();
   }
 }
 
@@ -1344,9 +1544,11 @@ void JNIGlobalsDumper::do_oop(oop* obj_p) {
 
   // we ignore global ref to symbols and other internal objects
   if (o->is_instance() || o->is_objArray() || o->is_typeArray()) {
-    writer()->write_u1(HPROF_GC_ROOT_JNI_GLOBAL);
+    u4 size = 1 + 2 * sizeof(address);
+    writer()->start_sub_record(HPROF_GC_ROOT_JNI_GLOBAL, size);
     writer()->write_objectID(o);
     writer()->write_objectID((oopDesc*)obj_p);      // global ref ID
+    writer()->end_sub_record();
   }
 };
 
@@ -1362,8 +1564,10 @@ class MonitorUsedDumper : public OopClosure {
     _writer = writer;
   }
   void do_oop(oop* obj_p) {
-    writer()->write_u1(HPROF_GC_ROOT_MONITOR_USED);
+    u4 size = 1 + sizeof(address);
+    writer()->start_sub_record(HPROF_GC_ROOT_MONITOR_USED, size);
     writer()->write_objectID(*obj_p);
+    writer()->end_sub_record();
   }
   void do_oop(narrowOop* obj_p) { ShouldNotReachHere(); }
 };
@@ -1382,31 +1586,25 @@ class StickyClassDumper : public KlassClosure {
   void do_klass(Klass* k) {
     if (k->oop_is_instance()) {
       InstanceKlass* ik = InstanceKlass::cast(k);
-        writer()->write_u1(HPROF_GC_ROOT_STICKY_CLASS);
+        u4 size = 1 + sizeof(address);
+        writer()->start_sub_record(HPROF_GC_ROOT_STICKY_CLASS, size);
         writer()->write_classID(ik);
+        writer()->end_sub_record();
       }
     }
 };
 
 
-class VM_HeapDumper;
-
 // Support class using when iterating over the heap.
 
 class HeapObjectDumper : public ObjectClosure {
  private:
-  VM_HeapDumper* _dumper;
   DumpWriter* _writer;
 
-  VM_HeapDumper* dumper()               { return _dumper; }
   DumpWriter* writer()                  { return _writer; }
 
-  // used to indicate that a record has been writen
-  void mark_end_of_record();
-
  public:
-  HeapObjectDumper(VM_HeapDumper* dumper, DumpWriter* writer) {
-    _dumper = dumper;
+  HeapObjectDumper(DumpWriter* writer) {
     _writer = writer;
   }
 
@@ -1428,18 +1626,57 @@ void HeapObjectDumper::do_object(oop o) {
   if (o->is_instance()) {
     // create a HPROF_GC_INSTANCE record for each object
     DumperSupport::dump_instance(writer(), o);
-    mark_end_of_record();
   } else if (o->is_objArray()) {
     // create a HPROF_GC_OBJ_ARRAY_DUMP record for each object array
     DumperSupport::dump_object_array(writer(), objArrayOop(o));
-    mark_end_of_record();
   } else if (o->is_typeArray()) {
     // create a HPROF_GC_PRIM_ARRAY_DUMP record for each type array
     DumperSupport::dump_prim_array(writer(), typeArrayOop(o));
-    mark_end_of_record();
   }
 }
 
+#if INCLUDE_ALL_GCS
+// Gang task used to dump the objects of the G1 heap in parallel. Each
+// worker claims heap regions and dumps their objects through a writer
+// of its own, which appends complete dump segments to the dump file.
+
+class G1HeapDumpRegionClosure : public HeapRegionClosure {
+ private:
+  ObjectClosure* _cl;
+ public:
+  G1HeapDumpRegionClosure(ObjectClosure* cl) : _cl(cl) {}
+  bool doHeapRegion(HeapRegion* r) {
+    if (!r->continuesHumongous()) {
+      r->object_iterate(_cl);
+    }
+    return false;
+  }
+};
+
+class G1HeapDumpTask : public AbstractGangTask {
+ private:
+  DumpWriter* _writer;
+  uint        _n_workers;
+
+ public:
+  G1HeapDumpTask(DumpWriter* writer, uint n_workers) :
+    AbstractGangTask("G1 Heap Dump"),
+    _writer(writer),
+    _n_workers(n_workers) { }
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    HandleMark hm;
+    DumpWriter writer(_writer);
+    HeapObjectDumper obj_dumper(&writer);
+    G1HeapDumpRegionClosure cl(&obj_dumper);
+    G1CollectedHeap::heap()->heap_region_par_iterate_chunked(&cl, worker_id, _n_workers,
+                                                             HeapRegion::HeapDumpClaimValue);
+    writer.finish_dump_segment();
+  }
+};
+#endif // INCLUDE_ALL_GCS
+
 // The VM operation that performs the heap dump
 class VM_HeapDumper : public VM_GC_Operation {
  private:
@@ -1491,6 +1728,10 @@ class VM_HeapDumper : public VM_GC_Operation {
   // HPROF_TRACE and HPROF_FRAME records
   void dump_stack_traces();
 
+  // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP and
+  // HPROF_GC_PRIM_ARRAY_DUMP records
+  void dump_heap_objects();
+
  public:
   VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
@@ -1526,8 +1767,6 @@ class VM_HeapDumper : public VM_GC_Operation {
   }
 
   VMOp_Type type() const { return VMOp_HeapDumper; }
-  // used to mark sub-record boundary
-  void check_segment_length();
   void doit();
 };
 
@@ -1538,72 +1777,13 @@ bool VM_HeapDumper::skip_operation() const {
   return false;
 }
 
- // writes a HPROF_HEAP_DUMP_SEGMENT record
-void DumperSupport::write_dump_header(DumpWriter* writer) {
-  if (writer->is_open()) {
-    writer->write_u1(HPROF_HEAP_DUMP_SEGMENT);
-    writer->write_u4(0); // current ticks
-
-    // record the starting position for the dump (its length will be fixed up later)
-    writer->set_dump_start(writer->current_offset());
-    writer->write_u4(0);
-  }
-}
-
-// fixes up the length of the current dump record
-void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
-  if (writer->is_open()) {
-    julong dump_end = writer->bytes_written() + writer->bytes_unwritten();
-    julong dump_len = writer->current_record_length();
-
-    // record length must fit in a u4
-    if (dump_len > max_juint) {
-      warning("record is too large");
-    }
-
-    // seek to the dump start and fix-up the length
-    assert(writer->dump_start() >= 0, "no dump start recorded");
-    writer->seek_to_offset(writer->dump_start());
-    writer->write_u4((u4)dump_len);
-
-    // adjust the total size written to keep the bytes written correct.
-    writer->adjust_bytes_written(-((jlong) sizeof(u4)));
-
-    // seek to dump end so we can continue
-    writer->seek_to_offset(dump_end);
-
-    // no current dump record
-    writer->set_dump_start((jlong)-1);
-  }
-}
-
-// used on a sub-record boundary to check if we need to start a
-// new segment.
-void VM_HeapDumper::check_segment_length() {
-  if (writer()->is_open()) {
-    julong dump_len = writer()->current_record_length();
-
-    if (dump_len > 2UL*G) {
-      DumperSupport::write_current_dump_record_length(writer());
-      DumperSupport::write_dump_header(writer());
-    }
-  }
-}
-
-// fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
+// finishes the current dump segment and writes HPROF_HEAP_DUMP_END record
 void DumperSupport::end_of_dump(DumpWriter* writer) {
-  if (writer->is_open()) {
-    write_current_dump_record_length(writer);
+  writer->finish_dump_segment();
 
-    writer->write_u1(HPROF_HEAP_DUMP_END);
-    writer->write_u4(0);
-    writer->write_u4(0);
-  }
-}
-
-// marks sub-record boundary
-void HeapObjectDumper::mark_end_of_record() {
-  dumper()->check_segment_length();
+  writer->write_u1(HPROF_HEAP_DUMP_END);
+  writer->write_u4(0);
+  writer->write_u4(0);
 }
 
 // writes a HPROF_LOAD_CLASS record for the class (and each of its
@@ -1693,10 +1873,12 @@ int VM_HeapDumper::do_thread(JavaThread* java_thread, u4 thread_serial_num) {
               oop o = locals->obj_at(slot)();
 
               if (o != NULL) {
-                writer()->write_u1(HPROF_GC_ROOT_JAVA_FRAME);
+                u4 size = 1 + sizeof(address) + 4 + 4;
+                writer()->start_sub_record(HPROF_GC_ROOT_JAVA_FRAME, size);
                 writer()->write_objectID(o);
                 writer()->write_u4(thread_serial_num);
                 writer()->write_u4((u4) (stack_depth + extra_frames));
+                writer()->end_sub_record();
               }
             }
           }
@@ -1744,10 +1926,12 @@ void VM_HeapDumper::do_threads() {
     oop threadObj = thread->threadObj();
     u4 thread_serial_num = i+1;
     u4 stack_serial_num = thread_serial_num + STACK_TRACE_ID;
-    writer()->write_u1(HPROF_GC_ROOT_THREAD_OBJ);
+    u4 size = 1 + sizeof(address) + 4 + 4;
+    writer()->start_sub_record(HPROF_GC_ROOT_THREAD_OBJ, size);
     writer()->write_objectID(threadObj);
     writer()->write_u4(thread_serial_num);  // thread number
     writer()->write_u4(stack_serial_num);   // stack trace serial number
+    writer()->end_sub_record();
     int num_frames = do_thread(thread, thread_serial_num);
     assert(num_frames == _stack_traces[i]->get_stack_depth(),
            "total number of Java frames not matched");
@@ -1772,12 +1956,13 @@ void VM_HeapDumper::do_threads() {
 // unknown object alloc site.
 //
 // Each HPROF_HEAP_DUMP_SEGMENT record has a length followed by sub-records.
-// To allow the heap dump be generated in a single pass we remember the position
-// of the dump length and fix it up after all sub-records have been written.
+// The DumpWriter collects the sub-records of a segment in its buffer and
+// fills in the length before the segment is written, see start_sub_record().
 // To generate the sub-records we iterate over the heap, writing
 // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP, and HPROF_GC_PRIM_ARRAY_DUMP
-// records as we go. Once that is done we write records for some of the GC
-// roots.
+// records as we go. With HeapDumpParallel the G1 heap regions are dumped by
+// the GC worker threads, each of which appends complete segments to the dump
+// file. Once that is done we write records for some of the GC roots.
 
 void VM_HeapDumper::doit() {
 
@@ -1822,44 +2007,33 @@ void VM_HeapDumper::doit() {
   // this must be called after _klass_map is built when iterating the classes above.
   dump_stack_traces();
 
-  // write HPROF_HEAP_DUMP_SEGMENT
-  DumperSupport::write_dump_header(writer());
-
   // Writes HPROF_GC_CLASS_DUMP records
   ClassLoaderDataGraph::classes_do(&do_class_dump);
   Universe::basic_type_classes_do(&do_basic_type_array_class_dump);
-  check_segment_length();
 
   // writes HPROF_GC_INSTANCE_DUMP records.
-  // After each sub-record is written check_segment_length will be invoked
-  // to check if the current segment exceeds a threshold. If so, a new
-  // segment is started.
   // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
   // of the heap dump.
-  HeapObjectDumper obj_dumper(this, writer());
-  Universe::heap()->safe_object_iterate(&obj_dumper);
+  dump_heap_objects();
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
-  check_segment_length();
 
   // HPROF_GC_ROOT_MONITOR_USED
   MonitorUsedDumper mon_dumper(writer());
   ObjectSynchronizer::oops_do(&mon_dumper);
-  check_segment_length();
 
   // HPROF_GC_ROOT_JNI_GLOBAL
   JNIGlobalsDumper jni_dumper(writer());
   JNIHandles::oops_do(&jni_dumper);
   Universe::oops_do(&jni_dumper);  // technically not jni roots, but global roots
                                    // for things like preallocated throwable backtraces
-  check_segment_length();
 
   // HPROF_GC_ROOT_STICKY_CLASS
   StickyClassDumper class_dumper(writer());
   SystemDictionary::always_strong_classes_do(&class_dumper);
 
-  // fixes up the length of the dump record and writes the HPROF_HEAP_DUMP_END record.
+  // finishes the last dump segment and writes the HPROF_HEAP_DUMP_END record.
   DumperSupport::end_of_dump(writer());
 
   // Now we clear the global variables, so that a future dumper might run.
@@ -1867,6 +2041,35 @@ void VM_HeapDumper::doit() {
   clear_global_writer();
 }
 
+void VM_HeapDumper::dump_heap_objects() {
+#if INCLUDE_ALL_GCS
+  if (HeapDumpParallel && UseG1GC && G1CollectedHeap::use_parallel_gc_threads()) {
+    G1CollectedHeap* g1h = G1CollectedHeap::heap();
+    uint n_workers = g1h->workers()->active_workers();
+    if (n_workers > 1) {
+      // The workers write their segments directly to the dump file, so
+      // all records written so far have to be in the file.
+      writer()->finish_dump_segment();
+      writer()->flush();
+
+      assert(g1h->check_heap_region_claim_values(HeapRegion::InitialClaimValue),
+             "sanity check");
+      G1HeapDumpTask task(writer(), n_workers);
+      g1h->set_par_threads(n_workers);
+      g1h->workers()->run_task(&task);
+      g1h->set_par_threads(0);
+      assert(g1h->check_heap_region_claim_values(HeapRegion::HeapDumpClaimValue),
+             "sanity check");
+      g1h->reset_heap_region_claim_values();
+      return;
+    }
+  }
+#endif // INCLUDE_ALL_GCS
+
+  HeapObjectDumper obj_dumper(writer());
+  Universe::heap()->safe_object_iterate(&obj_dumper);
+}
+
 void VM_HeapDumper::dump_stack_traces() {
   // write a HPROF_TRACE record without any frames to be referenced as object alloc sites
   DumperSupport::write_header(writer(), HPROF_TRACE, 3*sizeof(u4));
@@ -1932,8 +2135,17 @@ int HeapDumper::dump(const char* path) {
     timer()->start();
   }
 
+  // HeapDumpGzipLevel is manageable, so it is only range checked
+  // at startup.
+  uintx gzip_level = HeapDumpGzipLevel;
+  if (gzip_level > 9) {
+    warning("HeapDumpGzipLevel (" UINTX_FORMAT ") must be between 0 and 9, "
+            "using 9", gzip_level);
+    gzip_level = 9;
+  }
+
   // create the dump writer. If the file can be opened then bail
-  DumpWriter writer(path);
+  DumpWriter writer(path, (uint)gzip_level);
   if (!writer.is_open()) {
     set_error(writer.error());
     if (print_to_tty()) {
@@ -2025,7 +2237,7 @@ void HeapDumper::dump_heap(bool oome) {
   const int max_digit_chars = 20;
 
   const char* dump_file_name = "java_pid";
-  const char* dump_file_ext  = ".hprof";
+  const char* dump_file_ext  = (HeapDumpGzipLevel > 0) ? ".hprof.gz" : ".hprof";
 
   // The dump file defaults to java_pid<pid>.hprof in the current working
   // directory. HeapDumpPath=<file> can be used to specify an alternative
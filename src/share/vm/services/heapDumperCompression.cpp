@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoader.hpp"
+#include "services/heapDumperCompression.hpp"
+
+// Base values and number of extra bits of the length codes 257..285
+static const u2 length_base[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const u1 length_extra[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+// Base values and number of extra bits of the distance codes 0..29
+static const u2 dist_base[30] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const u1 dist_extra[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// Huffman codes are sent starting with their most significant bit, while
+// everything else in a deflate stream is sent least significant bit first.
+static u2 reverse_bits(u2 code, int bits) {
+  u2 result = 0;
+  for (int i = 0; i < bits; i++) {
+    result = (result << 1) | (code & 1);
+    code >>= 1;
+  }
+  return result;
+}
+
+GZipCompressor::GZipCompressor(int level) {
+  assert(level >= 1 && level <= 9, "invalid compression level");
+  static const int chain_lengths[10] = { 0, 4, 8, 16, 32, 64, 128, 256, 1024, 4096 };
+  _level = level;
+  _max_chain = chain_lengths[level];
+
+  _head = NEW_C_HEAP_ARRAY_RETURN_NULL(int, hash_size, mtInternal);
+  _prev = NEW_C_HEAP_ARRAY_RETURN_NULL(int, window_size, mtInternal);
+
+  // The fixed literal/length code (RFC 1951, 3.2.6)
+  for (int i = 0; i < 288; i++) {
+    u2 code;
+    int bits;
+    if (i < 144) {
+      code = 0x30 + i;          bits = 8;
+    } else if (i < 256) {
+      code = 0x190 + (i - 144); bits = 9;
+    } else if (i < 280) {
+      code = i - 256;           bits = 7;
+    } else {
+      code = 0xc0 + (i - 280);  bits = 8;
+    }
+    _lit_huff[i] = reverse_bits(code, bits);
+    _lit_bits[i] = (u1)bits;
+  }
+  // The fixed distance code uses five bits for every symbol
+  for (int i = 0; i < 30; i++) {
+    _dist_huff[i] = (u1)reverse_bits((u2)i, 5);
+  }
+
+  for (int code = 0; code < 29; code++) {
+    int end = (code == 28) ? max_match + 1 : length_base[code + 1];
+    for (int len = length_base[code]; len < end; len++) {
+      _length_code[len] = (u1)code;
+    }
+  }
+  // Distances up to 256 are looked up directly, larger ones by their
+  // upper bits; the codes above 15 all cover a multiple of 128.
+  for (int code = 0; code < 30; code++) {
+    int end = dist_base[code] + (1 << dist_extra[code]);
+    for (int dist = dist_base[code]; dist < end; dist++) {
+      if (dist <= 256) {
+        _dist_code[dist - 1] = (u1)code;
+      } else {
+        _dist_code[256 + ((dist - 1) >> 7)] = (u1)code;
+      }
+    }
+  }
+
+  _out = NULL;
+  _out_pos = 0;
+  _out_limit = 0;
+  _bit_buf = 0;
+  _bit_count = 0;
+  _overflow = false;
+}
+
+GZipCompressor::~GZipCompressor() {
+  if (_head != NULL) FREE_C_HEAP_ARRAY(int, _head, mtInternal);
+  if (_prev != NULL) FREE_C_HEAP_ARRAY(int, _prev, mtInternal);
+}
+
+inline void GZipCompressor::put_bits(juint value, int count) {
+  _bit_buf |= (julong)value << _bit_count;
+  _bit_count += count;
+  while (_bit_count >= 8) {
+    if (_out_pos == _out_limit) {
+      _overflow = true;
+      _bit_count = 0;
+      return;
+    }
+    _out[_out_pos++] = (u1)_bit_buf;
+    _bit_buf >>= 8;
+    _bit_count -= 8;
+  }
+}
+
+inline void GZipCompressor::flush_bits() {
+  if (_bit_count > 0) {
+    put_bits(0, 8 - _bit_count);
+  }
+}
+
+inline void GZipCompressor::put_literal(u1 c) {
+  put_bits(_lit_huff[c], _lit_bits[c]);
+}
+
+inline int GZipCompressor::dist_code(int distance) const {
+  return (distance <= 256) ? _dist_code[distance - 1] : _dist_code[256 + ((distance - 1) >> 7)];
+}
+
+inline void GZipCompressor::put_match(int length, int distance) {
+  int lcode = _length_code[length];
+  put_bits(_lit_huff[257 + lcode], _lit_bits[257 + lcode]);
+  if (length_extra[lcode] > 0) {
+    put_bits(length - length_base[lcode], length_extra[lcode]);
+  }
+  int dcode = dist_code(distance);
+  put_bits(_dist_huff[dcode], 5);
+  if (dist_extra[dcode] > 0) {
+    put_bits(distance - dist_base[dcode], dist_extra[dcode]);
+  }
+}
+
+inline juint GZipCompressor::hash(const u1* p) {
+  juint v = (juint)p[0] | ((juint)p[1] << 8) | ((juint)p[2] << 16);
+  return (v * 2654435761U) >> (32 - hash_bits);
+}
+
+size_t GZipCompressor::stored_size(size_t len) {
+  size_t blocks = MAX2((len + max_stored_block - 1) / max_stored_block, (size_t)1);
+  return len + blocks * 5;
+}
+
+size_t GZipCompressor::compressed_size_bound(size_t len) {
+  return header_size + stored_size(len) + trailer_size;
+}
+
+size_t GZipCompressor::deflate_fixed(const u1* in, size_t len, u1* out) {
+  _out = out;
+  _out_pos = 0;
+  _out_limit = stored_size(len);
+  _bit_buf = 0;
+  _bit_count = 0;
+  _overflow = false;
+
+  memset(_head, 0, hash_size * sizeof(int));
+
+  // BFINAL = 1, BTYPE = 01 (fixed Huffman codes)
+  put_bits(1, 1);
+  put_bits(1, 2);
+
+  size_t pos = 0;
+  while (pos < len && !_overflow) {
+    size_t best_len = 0;
+    size_t best_dist = 0;
+
+    if (pos + min_match <= len) {
+      juint h = hash(in + pos);
+      int candidate = _head[h] - 1;
+      _prev[pos & window_mask] = _head[h];
+      _head[h] = (int)pos + 1;
+
+      size_t max_len = MIN2(len - pos, (size_t)max_match);
+      int chain = _max_chain;
+      while (candidate >= 0 && pos - candidate <= window_size && chain-- > 0) {
+        const u1* p = in + candidate;
+        if (p[best_len] == in[pos + best_len]) {
+          size_t l = 0;
+          while (l < max_len && p[l] == in[pos + l]) {
+            l++;
+          }
+          if (l > best_len) {
+            best_len = l;
+            best_dist = pos - candidate;
+            if (l == max_len) {
+              break;
+            }
+          }
+        }
+        int next = _prev[candidate & window_mask] - 1;
+        if (next >= candidate) {
+          // The slot has been reused by a position outside of the window.
+          break;
+        }
+        candidate = next;
+      }
+    }
+
+    if (best_len >= min_match) {
+      put_match((int)best_len, (int)best_dist);
+      // Record the positions inside of the match so that later strings
+      // can refer to them. The fastest levels skip this.
+      if (_level >= 4) {
+        for (size_t i = pos + 1; i < pos + best_len && i + min_match <= len; i++) {
+          juint h = hash(in + i);
+          _prev[i & window_mask] = _head[h];
+          _head[h] = (int)i + 1;
+        }
+      }
+      pos += best_len;
+    } else {
+      put_literal(in[pos]);
+      pos++;
+    }
+  }
+
+  // end of block
+  put_bits(_lit_huff[256], _lit_bits[256]);
+  flush_bits();
+
+  return _overflow ? 0 : _out_pos;
+}
+
+size_t GZipCompressor::deflate_stored(const u1* in, size_t len, u1* out) {
+  size_t pos = 0;
+  u1* dst = out;
+  do {
+    size_t n = MIN2(len - pos, (size_t)max_stored_block);
+    bool last = (pos + n == len);
+    // BFINAL, BTYPE = 00 and the padding to the byte boundary
+    *dst++ = last ? 1 : 0;
+    *dst++ = (u1)(n & 0xff);
+    *dst++ = (u1)(n >> 8);
+    *dst++ = (u1)(~n & 0xff);
+    *dst++ = (u1)((~n >> 8) & 0xff);
+    memcpy(dst, in + pos, n);
+    dst += n;
+    pos += n;
+  } while (pos < len);
+  return dst - out;
+}
+
+size_t GZipCompressor::compress(const char* in, size_t len, char* out, size_t out_len) {
+  assert(is_initialized(), "compressor not initialized");
+  assert(out_len >= compressed_size_bound(len), "output buffer too small");
+  assert(len <= (size_t)max_jint, "input too large");
+
+  u1* dst = (u1*)out;
+
+  // ID1, ID2, CM = deflate, FLG, MTIME, XFL, OS = unknown
+  static const u1 header[header_size] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+  memcpy(dst, header, header_size);
+  size_t pos = header_size;
+
+  size_t n = deflate_fixed((const u1*)in, len, dst + pos);
+  if (n == 0) {
+    n = deflate_stored((const u1*)in, len, dst + pos);
+  }
+  pos += n;
+
+  // CRC32 and ISIZE, both little endian
+  juint crc = (juint)ClassLoader::crc32(0, in, (int)len);
+  juint isize = (juint)len;
+  for (int i = 0; i < 4; i++) {
+    dst[pos + i] = (u1)(crc >> (8 * i));
+    dst[pos + 4 + i] = (u1)(isize >> (8 * i));
+  }
+  pos += trailer_size;
+
+  assert(pos <= out_len, "buffer overflow");
+  return pos;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_SERVICES_HEAPDUMPERCOMPRESSION_HPP
+#define SHARE_VM_SERVICES_HEAPDUMPERCOMPRESSION_HPP
+
+#include "memory/allocation.hpp"
+
+// GZipCompressor turns a block of bytes into a complete gzip member
+// (RFC 1952). Since a sequence of gzip members is itself a valid gzip
+// file, the heap dumper can compress every buffer it writes on its own,
+// and the buffers of several dumper threads can be appended to the same
+// file in any order.
+//
+// The data is encoded with the fixed Huffman codes of the deflate format
+// (RFC 1951) using a greedy LZ77 matcher. The compression level selects
+// how many earlier occurrences of a string are examined when looking for
+// a match. Blocks which do not compress are emitted as stored blocks, so
+// the output never exceeds compressed_size_bound() of the input.
+//
+// A compressor holds its own match tables and may be used by one thread
+// at a time only.
+
+class GZipCompressor : public CHeapObj<mtInternal> {
+ private:
+  enum {
+    window_size      = 32*K,          // maximum distance of a match
+    window_mask      = window_size - 1,
+    hash_bits        = 15,
+    hash_size        = 1 << hash_bits,
+    min_match        = 3,
+    max_match        = 258,
+    max_stored_block = 65535,         // maximum length of a stored block
+    header_size      = 10,            // size of the gzip member header
+    trailer_size     = 8              // size of the gzip member trailer
+  };
+
+  int _level;
+  int _max_chain;   // number of earlier positions examined per match
+
+  // _head[h] is one more than the last position whose three bytes hash
+  // to h, _prev[p & window_mask] is the same for the position before p.
+  // Zero marks the end of a chain.
+  int* _head;
+  int* _prev;
+
+  // Bit-reversed fixed Huffman codes of the literal/length and the
+  // distance alphabets.
+  u2 _lit_huff[288];
+  u1 _lit_bits[288];
+  u1 _dist_huff[30];
+
+  // Map a match length to its length code (minus 257), and a match
+  // distance to its distance code, see dist_code().
+  u1 _length_code[max_match + 1];
+  u1 _dist_code[512];
+
+  // The output of the current deflate block.
+  u1*    _out;
+  size_t _out_pos;
+  size_t _out_limit;
+  julong _bit_buf;
+  int    _bit_count;
+  bool   _overflow;
+
+  inline void put_bits(juint value, int count);
+  inline void flush_bits();
+  inline void put_literal(u1 c);
+  inline void put_match(int length, int distance);
+  inline int  dist_code(int distance) const;
+
+  static inline juint hash(const u1* p);
+
+  // Returns the size of the input once wrapped into stored blocks.
+  static size_t stored_size(size_t len);
+
+  // Writes the input as a single fixed Huffman block. Returns 0 if the
+  // block would be larger than the stored representation.
+  size_t deflate_fixed(const u1* in, size_t len, u1* out);
+  // Writes the input as a sequence of stored blocks.
+  size_t deflate_stored(const u1* in, size_t len, u1* out);
+
+ public:
+  GZipCompressor(int level);
+  ~GZipCompressor();
+
+  // Whether the match tables could be allocated.
+  bool is_initialized() const { return _head != NULL && _prev != NULL; }
+
+  // The maximum size of the gzip member for an input of the given size.
+  static size_t compressed_size_bound(size_t len);
+
+  // Compresses len bytes into a gzip member at out, which must have room
+  // for compressed_size_bound(len) bytes. Returns the size of the member.
+  size_t compress(const char* in, size_t len, char* out, size_t out_len);
+};
+
+#endif // SHARE_VM_SERVICES_HEAPDUMPERCOMPRESSION_HPP
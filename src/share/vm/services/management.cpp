@@ -34,6 +34,7 @@
 #include "runtime/arguments.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.hpp"
@@ -1134,6 +1135,57 @@ static void do_thread_dump(ThreadDumpResult* dump_result,
   VMThread::execute(&op);
 }
 
+// Takes the snapshot and walks the stack of a thread stopped by a
+// handshake
+class ThreadStackDumpClosure : public HandshakeClosure {
+  ThreadSnapshot* _snapshot;
+  Handle          _thread_obj;
+  int             _max_depth;
+
+ public:
+  ThreadStackDumpClosure(ThreadSnapshot* snapshot, Handle thread_obj, int max_depth) :
+    HandshakeClosure("ThreadStackDump"), _snapshot(snapshot), _thread_obj(thread_obj),
+    _max_depth(max_depth) {}
+
+  void do_thread(Thread* thread) {
+    JavaThread* jt = (JavaThread*)thread;
+    // The thread may have exited before the handshake
+    if (jt->threadObj() != _thread_obj() || jt->is_exiting()) {
+      return;
+    }
+    _snapshot->initialize(jt);
+    _snapshot->dump_stack_at_safepoint(_max_depth, false /* no locked monitors */);
+  }
+};
+
+// Helper function to do a thread dump of a single thread. Only the
+// thread itself is stopped while its stack trace is taken.
+static void do_thread_dump_with_handshake(ThreadDumpResult* dump_result,
+                                          jlong tid,
+                                          int max_depth,
+                                          TRAPS) {
+  // The snapshot is added to the dump result before it is filled in,
+  // so that GC visits its oops once it holds any. If the thread does
+  // not exist or terminates before the handshake it stays a dummy.
+  ThreadSnapshot* ts = new ThreadSnapshot();
+  dump_result->add_thread_snapshot(ts);
+
+  JavaThread* jt = NULL;
+  Handle thread_obj;
+  {
+    MutexLockerEx ml(Threads_lock);
+    jt = Threads::find_java_thread_from_java_tid(tid);
+    if (jt != NULL && !jt->is_exiting() && !jt->is_hidden_from_external_view()) {
+      thread_obj = Handle(THREAD, jt->threadObj());
+    }
+  }
+
+  if (thread_obj.not_null()) {
+    ThreadStackDumpClosure cl(ts, thread_obj, max_depth);
+    Handshake::execute(&cl, jt);
+  }
+}
+
 // Gets an array of ThreadInfo objects. Each element is the ThreadInfo
 // for the thread ID specified in the corresponding entry in
 // the given array of thread IDs; or NULL if the thread does not exist
@@ -1208,6 +1260,12 @@ JVM_ENTRY(jint, jmm_GetThreadInfo(JNIEnv *env, jlongArray ids, jint maxDepth, jo
         dump_result.add_thread_snapshot(ts);
       }
     }
+  } else if (ThreadLocalHandshakes && num_threads == 1) {
+    // obtain the stack trace of a single thread without stopping the world
+    do_thread_dump_with_handshake(&dump_result,
+                                  ids_ah->long_at(0),
+                                  maxDepth,
+                                  CHECK_0);
   } else {
     // obtain thread dump with the specific list of threads with stack trace
     do_thread_dump(&dump_result,
@@ -555,7 +555,10 @@ ThreadStackTrace::~ThreadStackTrace() {
 }
 
 void ThreadStackTrace::dump_stack_at_safepoint(int maxDepth) {
-  assert(SafepointSynchronize::is_at_safepoint(), "all threads are stopped");
+  assert(SafepointSynchronize::is_at_safepoint() ||
+         _thread->is_handshake_safe_for(Thread::current()), "thread must be stopped");
+  assert(!_with_locked_monitors || SafepointSynchronize::is_at_safepoint(),
+         "monitors are iterated at a safepoint");
 
   if (_thread->has_last_Java_frame()) {
     RegisterMap reg_map(_thread);
@@ -769,6 +772,10 @@ ThreadStatistics::ThreadStatistics() {
 }
 
 ThreadSnapshot::ThreadSnapshot(JavaThread* thread) {
+  initialize(thread);
+}
+
+void ThreadSnapshot::initialize(JavaThread* thread) {
   _thread = thread;
   _threadObj = thread->threadObj();
   _stack_trace = NULL;
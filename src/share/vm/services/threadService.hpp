@@ -216,6 +216,10 @@ public:
   ThreadSnapshot(JavaThread* thread);
   ~ThreadSnapshot();
 
+  // Fills in a dummy snapshot. The caller must make sure that the
+  // thread is stopped and that the snapshot's oops are visited by GC.
+  void        initialize(JavaThread* thread);
+
   java_lang_Thread::ThreadStatus thread_status() { return _thread_status; }
 
   oop         threadObj() const           { return _threadObj; }
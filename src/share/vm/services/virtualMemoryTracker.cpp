@@ -347,6 +347,13 @@ bool VirtualMemoryTracker::add_reserved_region(address base_addr, size_t size,
         return true;
       }
 
+      // Archived Java heap objects of the CDS archive.
+      // They are mapped into committed regions of the Java heap, which NMT reports as a whole.
+      if (reserved_rgn->flag() == mtJavaHeap) {
+        assert(reserved_rgn->contain_region(base_addr, size), "Reserved heap should contain this mapping region");
+        return true;
+      }
+
       ShouldNotReachHere();
       return false;
     }
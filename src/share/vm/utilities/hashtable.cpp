@@ -31,6 +31,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/safepoint.hpp"
 #include "utilities/dtrace.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/hashtable.hpp"
 #include "utilities/hashtable.inline.hpp"
 #include "utilities/numberSeq.hpp"
@@ -109,7 +110,7 @@ template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::move_to(Rehashabl
   int saved_entry_count = this->number_of_entries();
 
   // Iterate through the table and create a new entry for the new table
-  for (int i = 0; i < new_table->table_size(); ++i) {
+  for (int i = 0; i < this->table_size(); ++i) {
     for (HashtableEntry<T, F>* p = this->bucket(i); p != NULL; ) {
       HashtableEntry<T, F>* next = p->next();
       T string = p->literal();
@@ -142,6 +143,157 @@ template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::move_to(Rehashabl
   BasicHashtable<F>::free_buckets();
 }
 
+template <class T, MEMFLAGS F> ConcurrentHashtable<T, F>::~ConcurrentHashtable() {
+  if (_retired_entries != NULL) {
+    delete _retired_entries;
+  }
+}
+
+template <class T, MEMFLAGS F> HashtableEntry<T, F>** ConcurrentHashtable<T, F>::live_bucket_addr(int i) {
+  assert(0 <= i && i < live_bucket_count(),
+         err_msg("bucket index %d out of bounds", i));
+  if (i < _copied_limit || i >= this->table_size()) {
+    return _new_table->bucket_addr(i);
+  }
+  return this->bucket_addr(i);
+}
+
+template <class T, MEMFLAGS F> bool ConcurrentHashtable<T, F>::is_live_bucket_for(int i, unsigned int hash) {
+  int index;
+  ConcurrentHashtable<T, F>* table = table_for(hash, &index);
+  return table->bucket_addr(index) == live_bucket_addr(i);
+}
+
+template <class T, MEMFLAGS F> bool ConcurrentHashtable<T, F>::should_grow() {
+  return !is_growing() && _retired_table == NULL &&
+         this->table_size() <= max_table_size / 2 &&
+         this->number_of_entries() > this->table_size() * max_load_factor;
+}
+
+template <class T, MEMFLAGS F> void ConcurrentHashtable<T, F>::start_growing(ConcurrentHashtable<T, F>* new_table) {
+  assert(!is_growing() && _retired_table == NULL, "already growing");
+  assert(new_table->table_size() == 2 * this->table_size(), "the table doubles");
+  _copied_limit = 0;
+  _copied_entries = 0;
+  // Not used by readers before the first bucket has been copied.
+  _new_table = new_table;
+}
+
+template <class T, MEMFLAGS F> bool ConcurrentHashtable<T, F>::copy_next_buckets(int count) {
+  assert(is_growing(), "not growing");
+  const int n = this->table_size();
+  const int end = MIN2(_copied_limit + count, n);
+  for (int i = _copied_limit; i < end; i++) {
+    HashtableEntry<T, F>* heads[2] = { NULL, NULL };
+    HashtableEntry<T, F>* tails[2] = { NULL, NULL };
+    int copied = 0;
+    // Keep the order of the entries, so that shared entries stay at the end.
+    for (HashtableEntry<T, F>* e = this->bucket(i); e != NULL; e = e->next()) {
+      HashtableEntry<T, F>* copy = _new_table->new_entry(e->hash(), e->literal());
+      copy->set_next(NULL);
+      int half = (_new_table->hash_to_index(e->hash()) == i) ? 0 : 1;
+      assert(_new_table->hash_to_index(e->hash()) == i + half * n, "entry goes to one of two buckets");
+      if (tails[half] == NULL) {
+        heads[half] = copy;
+      } else {
+        tails[half]->set_next(copy);
+      }
+      tails[half] = copy;
+      copied++;
+    }
+    _new_table->set_entry(i, heads[0]);
+    _new_table->set_entry(i + n, heads[1]);
+    _new_table->adjust_number_of_entries(copied);
+    _copied_entries += copied;
+    // The copied chains must be visible before readers are sent to them.
+    OrderAccess::release_store(&_copied_limit, i + 1);
+  }
+  return end < n;
+}
+
+template <class T, MEMFLAGS F> ConcurrentHashtable<T, F>* ConcurrentHashtable<T, F>::finish_growing() {
+  assert(is_growing() && _copied_limit == this->table_size(), "all buckets must have been copied");
+  ConcurrentHashtable<T, F>* new_table = _new_table;
+  // The copied entries are counted by both tables, and the entries removed
+  // while growing only by this one.
+  new_table->adjust_number_of_entries(this->number_of_entries() - _copied_entries);
+  new_table->_retired_table = this;
+  return new_table;
+}
+
+template <class T, MEMFLAGS F> void ConcurrentHashtable<T, F>::retire_entry(HashtableEntry<T, F>** p,
+                                                                            HashtableEntry<T, F>* entry) {
+  assert(!entry->is_shared(), "shared entries are never removed");
+  // The entry keeps its link, a reader standing on it continues with the
+  // rest of the chain. If p is the link of a shared entry, it keeps the
+  // shared bit.
+  intptr_t shared_bit = (intptr_t)*p & 1;
+  OrderAccess::release_store_ptr(p, (void*)((intptr_t)entry->next() | shared_bit));
+  if (_retired_entries == NULL) {
+    _retired_entries = new (ResourceObj::C_HEAP, F) GrowableArray<HashtableEntry<T, F>*>(64, true, F);
+  }
+  _retired_entries->append(entry);
+  this->adjust_number_of_entries(-1);
+}
+
+template <class T, MEMFLAGS F> bool ConcurrentHashtable<T, F>::has_retired() const {
+  return _retired_table != NULL ||
+         (_retired_entries != NULL && _retired_entries->length() > 0);
+}
+
+template <class T, MEMFLAGS F> void ConcurrentHashtable<T, F>::purge_retired(void free_literal(T)) {
+  assert(SafepointSynchronize::is_at_safepoint(), "lock-free readers may see retired entries");
+  if (_retired_entries != NULL) {
+    for (int i = 0; i < _retired_entries->length(); i++) {
+      HashtableEntry<T, F>* entry = _retired_entries->at(i);
+      if (free_literal != NULL) {
+        free_literal(entry->literal());
+      }
+      this->add_to_free_list(entry);
+    }
+    _retired_entries->clear();
+  }
+
+  ConcurrentHashtable<T, F>* old_table = _retired_table;
+  if (old_table != NULL) {
+    _retired_table = NULL;
+    old_table->purge_retired(free_literal);
+    // All entries of the old table have been copied to this one. Entries
+    // in the shared archive are not allocated by the table.
+    for (int i = 0; i < old_table->table_size(); i++) {
+      HashtableEntry<T, F>* e = old_table->bucket(i);
+      while (e != NULL) {
+        HashtableEntry<T, F>* next = e->next();
+        if (!UseSharedSpaces ||
+            !FileMapInfo::current_info()->is_in_shared_space(e)) {
+          this->add_to_free_list(e);
+        }
+        e = next;
+      }
+    }
+    BasicHashtableEntry<F>* e;
+    while ((e = old_table->new_entry_free_list()) != NULL) {
+      this->add_to_free_list(e);
+    }
+    old_table->free_buckets();
+    delete old_table;
+  }
+}
+
+template <class T, MEMFLAGS F> void ConcurrentHashtable<T, F>::dump_table(outputStream* st, const char *table_name) {
+  NumberSeq summary;
+  int literal_bytes = 0;
+  for (int i = 0; i < live_bucket_count(); ++i) {
+    int count = 0;
+    for (HashtableEntry<T, F>* e = live_bucket(i); e != NULL; e = e->next()) {
+      count++;
+      literal_bytes += RehashableHashtable<T, F>::literal_size(e->literal());
+    }
+    summary.add((double)count);
+  }
+  this->print_table_statistics(st, table_name, &summary, literal_bytes);
+}
+
 template <MEMFLAGS F> void BasicHashtable<F>::free_buckets() {
   if (NULL != _buckets) {
     // Don't delete the buckets in the shared space.  They aren't
@@ -297,8 +449,13 @@ template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::dump_table(output
     }
     summary.add((double)count);
   }
-  double num_buckets = summary.num();
-  double num_entries = summary.sum();
+  print_table_statistics(st, table_name, &summary, literal_bytes);
+}
+
+template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::print_table_statistics(outputStream* st, const char *table_name,
+                                                                                     NumberSeq* summary, int literal_bytes) {
+  double num_buckets = summary->num();
+  double num_entries = summary->sum();
 
   int bucket_bytes = (int)num_buckets * sizeof(HashtableBucket<F>);
   int entry_bytes  = (int)num_entries * sizeof(HashtableEntry<T, F>);
@@ -313,10 +470,10 @@ template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::dump_table(output
   st->print_cr("Number of entries       : %9d = %9d bytes, avg %7.3f", (int)num_entries, entry_bytes,   entry_avg);
   st->print_cr("Number of literals      : %9d = %9d bytes, avg %7.3f", (int)num_entries, literal_bytes, literal_avg);
   st->print_cr("Total footprint         : %9s = %9d bytes", "", total_bytes);
-  st->print_cr("Average bucket size     : %9.3f", summary.avg());
-  st->print_cr("Variance of bucket size : %9.3f", summary.variance());
-  st->print_cr("Std. dev. of bucket size: %9.3f", summary.sd());
-  st->print_cr("Maximum bucket size     : %9d", (int)summary.maximum());
+  st->print_cr("Average bucket size     : %9.3f", summary->avg());
+  st->print_cr("Variance of bucket size : %9.3f", summary->variance());
+  st->print_cr("Std. dev. of bucket size: %9.3f", summary->sd());
+  st->print_cr("Maximum bucket size     : %9d", (int)summary->maximum());
 }
 
 
@@ -390,12 +547,15 @@ template class BasicHashtable<mtGC>;
 template class Hashtable<ConstantPool*, mtClass>;
 template class RehashableHashtable<Symbol*, mtSymbol>;
 template class RehashableHashtable<oopDesc*, mtSymbol>;
+template class ConcurrentHashtable<Symbol*, mtSymbol>;
+template class ConcurrentHashtable<oopDesc*, mtSymbol>;
 template class Hashtable<Symbol*, mtSymbol>;
 template class Hashtable<Klass*, mtClass>;
 template class Hashtable<oop, mtClass>;
 #if defined(SOLARIS) || defined(CHECK_UNHANDLED_OOPS)
 template class Hashtable<oop, mtSymbol>;
 template class RehashableHashtable<oop, mtSymbol>;
+template class ConcurrentHashtable<oop, mtSymbol>;
 #endif // SOLARIS || CHECK_UNHANDLED_OOPS
 template class Hashtable<oopDesc*, mtSymbol>;
 template class Hashtable<Symbol*, mtClass>;
@@ -30,6 +30,10 @@
 #include "oops/oop.hpp"
 #include "oops/symbol.hpp"
 #include "runtime/handles.hpp"
+#include "runtime/orderAccess.inline.hpp"
+
+template <class E> class GrowableArray;
+class NumberSeq;
 
 // This is a generic hashtable, designed to be used for the symbol
 // and string tables.
@@ -215,6 +219,13 @@ protected:
   // Free the buckets in this hashtable
   void free_buckets();
 
+  // Used when the entries of another table are taken over
+  void add_to_free_list(BasicHashtableEntry<F>* entry) {
+    entry->set_next(_free_list);
+    _free_list = entry;
+  }
+  void adjust_number_of_entries(int delta) { _number_of_entries += delta; }
+
   // Helper data structure containing context for the bucket entry unlink process,
   // storing the unlinked buckets in a linked list.
   // Also avoids the need to pass around these four members as parameters everywhere.
@@ -329,11 +340,113 @@ template <class T, MEMFLAGS F> class RehashableHashtable : public Hashtable<T, F
 
   void dump_table(outputStream* st, const char *table_name);
 
+ protected:
+  // Prints the statistics gathered by dump_table().
+  void print_table_statistics(outputStream* st, const char *table_name,
+                              NumberSeq* summary, int literal_bytes);
+
  private:
   static juint _seed;
 };
 
 
+// A hashtable which is read without locking, and which grows and removes
+// entries without a safepoint. Writers serialize on a lock owned by the
+// subclass.
+//
+// The table grows by copying its entries into a table twice the size, one
+// bucket at a time. The entries of a bucket below _copied_limit have been
+// copied, and readers and writers use the new table for them. Since h % 2n
+// is either h % n or h % n + n, the entries of a bucket go to two buckets of
+// the new table, which are only used once the bucket has been copied. The
+// chains of this table are not changed by copying, so a reader always sees
+// a complete chain.
+//
+// Entries unlinked while lock-free readers may still traverse them, and the
+// table replaced by a grown table, are kept intact until the next safepoint.
+// Lock-free readers must therefore be JavaThreads which do not block while
+// holding an entry.
+
+template <class T, MEMFLAGS F> class ConcurrentHashtable : public RehashableHashtable<T, F> {
+ private:
+  // The table the entries are copied to, NULL unless growing.
+  ConcurrentHashtable<T, F>* _new_table;
+  // The number of buckets whose entries have been copied to _new_table.
+  volatile int               _copied_limit;
+  int                        _copied_entries;
+
+  // Entries unlinked from this table, and the table this one replaced.
+  // Both are freed at the next safepoint.
+  GrowableArray<HashtableEntry<T, F>*>* _retired_entries;
+  ConcurrentHashtable<T, F>*           _retired_table;
+
+ public:
+  enum {
+    max_load_factor = 2,        // average chain length at which the table grows
+    max_table_size  = 1 << 24
+  };
+
+  ConcurrentHashtable(int table_size, int entry_size)
+    : RehashableHashtable<T, F>(table_size, entry_size),
+      _new_table(NULL), _copied_limit(0), _copied_entries(0),
+      _retired_entries(NULL), _retired_table(NULL) { }
+
+  ConcurrentHashtable(int table_size, int entry_size,
+                      HashtableBucket<F>* buckets, int number_of_entries)
+    : RehashableHashtable<T, F>(table_size, entry_size, buckets, number_of_entries),
+      _new_table(NULL), _copied_limit(0), _copied_entries(0),
+      _retired_entries(NULL), _retired_table(NULL) { }
+
+  ~ConcurrentHashtable();
+
+  // Returns the table holding the entries with the given hash, and the
+  // index of their bucket in it. MT-safe.
+  ConcurrentHashtable<T, F>* table_for(unsigned int hash, int* index) {
+    int i = this->hash_to_index(hash);
+    // Pairs with the release in copy_next_buckets(), which publishes the
+    // copied chains before raising the limit.
+    if (i < (int)OrderAccess::load_acquire(&_copied_limit)) {
+      *index = _new_table->hash_to_index(hash);
+      return _new_table;
+    }
+    *index = i;
+    return this;
+  }
+
+  // The chains of a possibly partly grown table: the buckets of this table
+  // which have not been copied yet, and those of the new table which have
+  // been filled. Only stable at a safepoint or with the lock held.
+  int live_bucket_count() { return _copied_limit + this->table_size(); }
+  HashtableEntry<T, F>** live_bucket_addr(int i);
+  HashtableEntry<T, F>* live_bucket(int i) { return *live_bucket_addr(i); }
+  // Whether entries with the given hash belong to the live bucket i.
+  bool is_live_bucket_for(int i, unsigned int hash);
+
+  // Growing, with the lock held.
+  bool is_growing() const                { return _new_table != NULL; }
+  bool should_grow();
+  void start_growing(ConcurrentHashtable<T, F>* new_table);
+  // Copies the next buckets to the new table. Returns false once all
+  // buckets have been copied.
+  bool copy_next_buckets(int count);
+  // Hands the entries over to the new table and returns it. This table is
+  // freed at the next safepoint after the new one has been published.
+  ConcurrentHashtable<T, F>* finish_growing();
+
+  // Unlinks the entry at *p with the lock held. The entry is kept intact
+  // for lock-free readers until the next safepoint.
+  void retire_entry(HashtableEntry<T, F>** p, HashtableEntry<T, F>* entry);
+
+  bool has_retired() const;
+
+  // Like RehashableHashtable::dump_table(), for the live buckets.
+  void dump_table(outputStream* st, const char *table_name);
+  // Frees the retired entries and tables at a safepoint. The literals of
+  // the retired entries are passed to free_literal if it is not NULL.
+  void purge_retired(void free_literal(T));
+};
+
+
 //  Verions of hashtable where two handles are used to compute the index.
 
 template <class T, MEMFLAGS F> class TwoOopHashtable : public Hashtable<T, F> {
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/thread.inline.hpp"
 #include "utilities/debug.hpp"
@@ -129,11 +130,53 @@ int TaskQueueSetSuper::randomParkAndMiller(int *seed0) {
   return seed;
 }
 
+Monitor* ParallelTaskTerminator::create_blocker(bool can_block) {
+  if (!can_block || !UseOWSTTaskTerminator) {
+    return NULL;
+  }
+  return new Monitor(Mutex::leaf, "ParallelTaskTerminator", true);
+}
+
 ParallelTaskTerminator::
 ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set) :
   _n_threads(n_threads),
   _queue_set(queue_set),
-  _offered_termination(0) {}
+  _offered_termination(0),
+  _blocker(create_blocker(true)),
+  _spin_master(NULL) {}
+
+ParallelTaskTerminator::
+ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set,
+                       bool can_block) :
+  _n_threads(n_threads),
+  _queue_set(queue_set),
+  _offered_termination(0),
+  _blocker(create_blocker(can_block)),
+  _spin_master(NULL) {}
+
+ParallelTaskTerminator::
+ParallelTaskTerminator(const ParallelTaskTerminator& other) :
+  _n_threads(other._n_threads),
+  _queue_set(other._queue_set),
+  _offered_termination(other._offered_termination),
+  _blocker(create_blocker(other._blocker != NULL)),
+  _spin_master(NULL) {}
+
+ParallelTaskTerminator::~ParallelTaskTerminator() {
+  assert(_spin_master == NULL, "Terminator may still be in use");
+  if (_blocker != NULL) {
+    delete _blocker;
+  }
+}
+
+ParallelTaskTerminator&
+ParallelTaskTerminator::operator=(const ParallelTaskTerminator& other) {
+  assert(_spin_master == NULL, "Terminator may still be in use");
+  _n_threads = other._n_threads;
+  _queue_set = other._queue_set;
+  _offered_termination = other._offered_termination;
+  return *this;
+}
 
 bool ParallelTaskTerminator::peek_in_queue_set() {
   return _queue_set->peek();
@@ -153,6 +196,9 @@ bool
 ParallelTaskTerminator::offer_termination(TerminatorTerminator* terminator) {
   assert(_n_threads > 0, "Initialization is incorrect");
   assert(_offered_termination < _n_threads, "Invariant");
+  if (_blocker != NULL) {
+    return offer_termination_blocking(terminator);
+  }
   Atomic::inc(&_offered_termination);
 
   uint yield_count = 0;
@@ -239,6 +285,146 @@ ParallelTaskTerminator::offer_termination(TerminatorTerminator* terminator) {
   }
 }
 
+bool ParallelTaskTerminator::exit_termination(size_t tasks,
+                                              TerminatorTerminator* terminator) {
+  return tasks > 0 ||
+         (terminator != NULL && terminator->should_exit_termination());
+}
+
+bool
+ParallelTaskTerminator::offer_termination_blocking(TerminatorTerminator* terminator) {
+  // A single thread is done.
+  if (_n_threads == 1) {
+    _offered_termination = 1;
+    return true;
+  }
+
+  _blocker->lock_without_safepoint_check();
+  _offered_termination++;
+  // All threads have arrived.
+  if (_offered_termination == _n_threads) {
+    _blocker->notify_all();
+    _blocker->unlock();
+    return true;
+  }
+
+  Thread* the_thread = Thread::current();
+  while (true) {
+    if (_spin_master == NULL) {
+      _spin_master = the_thread;
+      _blocker->unlock();
+
+      if (do_spin_master_work(terminator)) {
+        assert(_offered_termination == _n_threads, "termination condition");
+        return true;
+      }
+      _blocker->lock_without_safepoint_check();
+      // All threads may have offered termination after the spin master
+      // dropped the lock.
+      if (_offered_termination == _n_threads) {
+        _blocker->unlock();
+        return true;
+      }
+    } else {
+      // Wake up periodically to check the TerminatorTerminator.
+      _blocker->wait(Mutex::_no_safepoint_check_flag, WorkStealingSleepMillis);
+
+      if (_offered_termination == _n_threads) {
+        _blocker->unlock();
+        return true;
+      }
+    }
+
+#ifdef TRACESPINNING
+    _total_peeks++;
+#endif
+    if (exit_termination(_queue_set->tasks(), terminator)) {
+      _offered_termination--;
+      assert(_offered_termination < _n_threads, "Invariant");
+      _blocker->unlock();
+      return false;
+    }
+  }
+}
+
+bool
+ParallelTaskTerminator::do_spin_master_work(TerminatorTerminator* terminator) {
+  uint yield_count = 0;
+  // Number of hard spin loops done since last yield
+  uint hard_spin_count = 0;
+  // Number of iterations in the hard spin loop.
+  uint hard_spin_limit = WorkStealingHardSpins;
+
+  // See offer_termination().
+  if (WorkStealingSpinToYieldRatio > 0) {
+    hard_spin_limit = WorkStealingHardSpins >> WorkStealingSpinToYieldRatio;
+    hard_spin_limit = MAX2(hard_spin_limit, 1U);
+  }
+  // Remember the initial spin limit.
+  uint hard_spin_start = hard_spin_limit;
+
+  while (true) {
+    // Look for more work.
+    if (yield_count <= WorkStealingYieldsBeforeSleep) {
+      yield_count++;
+      if (hard_spin_count > WorkStealingSpinToYieldRatio) {
+        yield();
+        hard_spin_count = 0;
+        hard_spin_limit = hard_spin_start;
+#ifdef TRACESPINNING
+        _total_yields++;
+#endif
+      } else {
+        hard_spin_limit = MIN2(2*hard_spin_limit,
+                               (uint) WorkStealingHardSpins);
+        for (uint j = 0; j < hard_spin_limit; j++) {
+          SpinPause();
+        }
+        hard_spin_count++;
+#ifdef TRACESPINNING
+        _total_spins++;
+#endif
+      }
+    } else {
+      yield_count = 0;
+      // Instead of sleeping, wait on the monitor with the others and
+      // give up the spin master role for a while.
+      MonitorLockerEx locker(_blocker, Mutex::_no_safepoint_check_flag);
+      _spin_master = NULL;
+      locker.wait(Mutex::_no_safepoint_check_flag, WorkStealingSleepMillis);
+      if (_spin_master == NULL) {
+        _spin_master = Thread::current();
+      } else {
+        return false;
+      }
+    }
+
+#ifdef TRACESPINNING
+    _total_peeks++;
+#endif
+    size_t tasks = _queue_set->tasks();
+    bool exit = exit_termination(tasks, terminator);
+    {
+      MonitorLockerEx locker(_blocker, Mutex::_no_safepoint_check_flag);
+      if (_offered_termination == _n_threads) {
+        _spin_master = NULL;
+        return true;
+      } else if (exit) {
+        // Wake up as many threads as there are tasks, besides this one.
+        if (tasks >= (size_t) _offered_termination - 1) {
+          locker.notify_all();
+        } else {
+          for (; tasks > 1; tasks--) {
+            locker.notify();
+          }
+        }
+        _spin_master = NULL;
+        return false;
+      }
+    }
+  }
+}
+
 #ifdef TRACESPINNING
 void ParallelTaskTerminator::print_termination_counts() {
   gclog_or_tty->print_cr("ParallelTaskTerminator Total yields: " UINT32_FORMAT
@@ -250,6 +436,7 @@ void ParallelTaskTerminator::print_termination_counts() {
 #endif
 
 void ParallelTaskTerminator::reset_for_reuse() {
+  assert(_spin_master == NULL, "Terminator may still be in use");
   if (_offered_termination != 0) {
     assert(_offered_termination == _n_threads,
            "Terminator may still be in use");
@@ -500,6 +500,8 @@ protected:
 public:
   // Returns "true" if some TaskQueue in the set contains a task.
   virtual bool peek() = 0;
+  // Returns the approximate number of tasks in the TaskQueues of the set.
+  virtual size_t tasks() = 0;
 };
 
 template <MEMFLAGS F> class TaskQueueSetSuperImpl: public CHeapObj<F>, public TaskQueueSetSuper {
@@ -536,6 +538,7 @@ public:
   bool steal(uint queue_num, int* seed, E& t);
 
   bool peek();
+  size_t tasks();
 };
 
 template<class T, MEMFLAGS F> void
@@ -593,6 +596,15 @@ bool GenericTaskQueueSet<T, F>::peek() {
   return false;
 }
 
+template<class T, MEMFLAGS F>
+size_t GenericTaskQueueSet<T, F>::tasks() {
+  size_t n = 0;
+  for (uint j = 0; j < _n; j++) {
+    n += _queues[j]->size();
+  }
+  return n;
+}
+
 // When to terminate from the termination protocol.
 class TerminatorTerminator: public CHeapObj<mtInternal> {
 public:
@@ -601,6 +613,13 @@ public:
 
 // A class to aid in the termination of a set of parallel tasks using
 // TaskQueueSet's for work stealing.
+//
+// With UseOWSTTaskTerminator only one of the threads offering termination,
+// the spin master, spins and polls the queues for work. The others wait
+// on a monitor until the spin master finds tasks and wakes up as many of
+// them as there are tasks, or until all threads have offered termination.
+// Without it, or for terminators that cannot block, every thread offering
+// termination spins, yields and sleeps, and polls the queues on its own.
 
 #undef TRACESPINNING
 
@@ -612,6 +631,11 @@ private:
   int _offered_termination;
   char _pad_after[DEFAULT_CACHE_LINE_SIZE];
 
+  // The waiting threads block on _blocker, which also protects
+  // _offered_termination and _spin_master. NULL if the threads spin.
+  Monitor* _blocker;
+  Thread*  _spin_master;
+
 #ifdef TRACESPINNING
   static uint _total_yields;
   static uint _total_spins;
@@ -619,15 +643,37 @@ private:
 #endif
 
   bool peek_in_queue_set();
+
+  static Monitor* create_blocker(bool can_block);
+
+  // Whether a thread should stop offering termination.
+  bool exit_termination(size_t tasks, TerminatorTerminator* terminator);
+  // Offer termination with a spin master, see above.
+  bool offer_termination_blocking(TerminatorTerminator* terminator);
+  // Spin, yield and poll as the spin master. Returns true if all threads
+  // have offered termination, and false if this thread should stop
+  // offering termination, or another thread has become the spin master.
+  bool do_spin_master_work(TerminatorTerminator* terminator);
 protected:
   virtual void yield();
   void sleep(uint millis);
 
+  // Terminators whose threads must keep calling yield(), e.g. to yield to
+  // a foreground collection, pass false for can_block.
+  ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set,
+                         bool can_block);
+
 public:
 
   // "n_threads" is the number of threads to be terminated.  "queue_set" is a
   // queue sets of work queues of other threads.
   ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set);
+  ParallelTaskTerminator(const ParallelTaskTerminator& other);
+  ~ParallelTaskTerminator();
+
+  // Assigns the number of threads and the queue set; the monitor of
+  // this terminator is kept.
+  ParallelTaskTerminator& operator=(const ParallelTaskTerminator& other);
 
   // The current thread has no work, and is ready to terminate if everyone
   // else is.  If returns "true", all threads are terminated.  If returns
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Arrays.equals of primitive arrays computed by the vectorizedMismatch stub
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-TieredCompilation TestArraysEquals
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-TieredCompilation -XX:UseAVX=0 TestArraysEquals
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-TieredCompilation -XX:-UseVectorizedMismatchIntrinsic TestArraysEquals
+ */
+
+import java.util.Arrays;
+
+public class TestArraysEquals {
+
+    static boolean equals(byte[] a, byte[] b)       { return Arrays.equals(a, b); }
+    static boolean equals(boolean[] a, boolean[] b) { return Arrays.equals(a, b); }
+    static boolean equals(short[] a, short[] b)     { return Arrays.equals(a, b); }
+    static boolean equals(int[] a, int[] b)         { return Arrays.equals(a, b); }
+    static boolean equals(long[] a, long[] b)       { return Arrays.equals(a, b); }
+    static boolean equals(float[] a, float[] b)     { return Arrays.equals(a, b); }
+    static boolean equals(double[] a, double[] b)   { return Arrays.equals(a, b); }
+
+    static void check(boolean result, boolean expected, String what) {
+        if (result != expected) {
+            throw new RuntimeException(what + ": expected " + expected + " but got " + result);
+        }
+    }
+
+    static void test(int len) {
+        byte[] b1 = new byte[len], b2 = new byte[len];
+        boolean[] z1 = new boolean[len], z2 = new boolean[len];
+        short[] s1 = new short[len], s2 = new short[len];
+        int[] i1 = new int[len], i2 = new int[len];
+        long[] l1 = new long[len], l2 = new long[len];
+        float[] f1 = new float[len], f2 = new float[len];
+        double[] d1 = new double[len], d2 = new double[len];
+        for (int i = 0; i < len; i++) {
+            b1[i] = b2[i] = (byte)i;
+            z1[i] = z2[i] = (i & 1) != 0;
+            s1[i] = s2[i] = (short)(i * 1000);
+            i1[i] = i2[i] = i * 100000;
+            l1[i] = l2[i] = i * 10000000000L;
+            f1[i] = f2[i] = i * 0.5f;
+            d1[i] = d2[i] = i * 0.25;
+        }
+        check(equals(b1, b2), true, "byte[" + len + "]");
+        check(equals(z1, z2), true, "boolean[" + len + "]");
+        check(equals(s1, s2), true, "short[" + len + "]");
+        check(equals(i1, i2), true, "int[" + len + "]");
+        check(equals(l1, l2), true, "long[" + len + "]");
+        check(equals(f1, f2), true, "float[" + len + "]");
+        check(equals(d1, d2), true, "double[" + len + "]");
+
+        for (int i = 0; i < len; i++) {
+            b2[i]++;
+            check(equals(b1, b2), false, "byte[" + len + "] at " + i);
+            b2[i]--;
+            z2[i] = !z2[i];
+            check(equals(z1, z2), false, "boolean[" + len + "] at " + i);
+            z2[i] = !z2[i];
+            s2[i] ^= 0x100;
+            check(equals(s1, s2), false, "short[" + len + "] at " + i);
+            s2[i] ^= 0x100;
+            i2[i] ^= 0x1000000;
+            check(equals(i1, i2), false, "int[" + len + "] at " + i);
+            i2[i] ^= 0x1000000;
+            l2[i] ^= 0x100000000000000L;
+            check(equals(l1, l2), false, "long[" + len + "] at " + i);
+            l2[i] ^= 0x100000000000000L;
+            f2[i] += 1.0f;
+            check(equals(f1, f2), false, "float[" + len + "] at " + i);
+            f2[i] = f1[i];
+            d2[i] += 1.0;
+            check(equals(d1, d2), false, "double[" + len + "] at " + i);
+            d2[i] = d1[i];
+        }
+
+        check(equals(b1, new byte[len + 1]), false, "byte[] length");
+        check(equals(l1, new long[len + 1]), false, "long[] length");
+        check(equals(b1, b1), true, "same byte[]");
+        check(equals(b1, null), false, "null byte[]");
+        check(equals((byte[])null, null), true, "null byte[]s");
+        check(equals(d1, null), false, "null double[]");
+
+        if (len > 0) {
+            // All NaNs are equal, but 0.0 and -0.0 are not
+            int last = len - 1;
+            f1[last] = Float.intBitsToFloat(0x7fc00000);
+            f2[last] = Float.intBitsToFloat(0x7fc00001);
+            d1[last] = Double.longBitsToDouble(0x7ff8000000000000L);
+            d2[last] = Double.longBitsToDouble(0xfff8000000000001L);
+            check(equals(f1, f2), true, "float[" + len + "] NaN");
+            check(equals(d1, d2), true, "double[" + len + "] NaN");
+            f1[last] = 0.0f;
+            f2[last] = -0.0f;
+            d1[last] = 0.0;
+            d2[last] = -0.0;
+            check(equals(f1, f2), false, "float[" + len + "] -0.0");
+            check(equals(d1, d2), false, "double[" + len + "] -0.0");
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int iter = 0; iter < 200; iter++) {
+            for (int len = 0; len < 80; len++) {
+                test(len);
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary String.hashCode, equals and compareTo computed by the String stubs
+ * @run main/othervm -XX:-BackgroundCompilation -XX:TieredStopAtLevel=1 TestStringIntrinsicStubs
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-TieredCompilation TestStringIntrinsicStubs
+ * @run main/othervm -XX:-BackgroundCompilation -XX:UseAVX=0 -XX:+UseStringIntrinsicStubs TestStringIntrinsicStubs
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseStringIntrinsicStubs TestStringIntrinsicStubs
+ */
+
+import java.util.Random;
+
+public class TestStringIntrinsicStubs {
+
+    static int hash(char[] value) {
+        int h = 0;
+        for (int i = 0; i < value.length; i++) {
+            h = 31 * h + value[i];
+        }
+        return h;
+    }
+
+    static int compare(char[] a, char[] b) {
+        int n = Math.min(a.length, b.length);
+        for (int i = 0; i < n; i++) {
+            if (a[i] != b[i]) {
+                return a[i] - b[i];
+            }
+        }
+        return a.length - b.length;
+    }
+
+    static int hashCode(String s) {
+        return s.hashCode();
+    }
+
+    static boolean equals(String s, Object o) {
+        return s.equals(o);
+    }
+
+    static int compareTo(String s, String t) {
+        return s.compareTo(t);
+    }
+
+    static void check(boolean ok, String what, char[] value) {
+        if (!ok) {
+            throw new RuntimeException(what + " failed for length " + value.length);
+        }
+    }
+
+    public static void main(String[] args) {
+        Random random = new Random(42);
+        for (int iter = 0; iter < 200; iter++) {
+            for (int len = 0; len < 100; len++) {
+                char[] value = new char[len];
+                for (int i = 0; i < len; i++) {
+                    // chars above 0x7fff must not be sign extended
+                    value[i] = (char) random.nextInt(iter % 2 == 0 ? 128 : 65536);
+                }
+                String s = new String(value);
+                check(hashCode(s) == hash(value), "hashCode", value);
+                // cached
+                check(hashCode(s) == hash(value), "hashCode", value);
+
+                String t = new String(value);
+                check(equals(s, t), "equals", value);
+                check(equals(s, s), "equals", value);
+                check(!equals(s, null), "equals", value);
+                check(!equals(s, value), "equals", value);
+                check(compareTo(s, t) == 0, "compareTo", value);
+
+                if (len > 0) {
+                    char[] other = value.clone();
+                    other[random.nextInt(len)] ^= 1 + random.nextInt(0xfffe);
+                    String u = new String(other);
+                    check(!equals(s, u), "equals", value);
+                    check(compareTo(s, u) == compare(value, other), "compareTo", value);
+                    String v = new String(value, 0, len - 1);
+                    check(!equals(s, v), "equals", value);
+                    check(compareTo(s, v) > 0 && compareTo(v, s) < 0, "compareTo", value);
+                }
+            }
+        }
+        try {
+            compareTo("a", null);
+            throw new RuntimeException("compareTo(null) did not throw");
+        } catch (NullPointerException e) {
+            // expected
+        }
+    }
+}
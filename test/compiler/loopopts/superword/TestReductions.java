@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Check that vectorized add and multiply reductions match the scalar loops
+ * @run main/othervm -Xbatch -XX:CompileCommand=exclude,compiler.loopopts.superword.TestReductions::gold*
+ *      compiler.loopopts.superword.TestReductions
+ * @run main/othervm -Xbatch -XX:-SuperWordReductions
+ *      -XX:CompileCommand=exclude,compiler.loopopts.superword.TestReductions::gold*
+ *      compiler.loopopts.superword.TestReductions
+ * @run main/othervm -Xbatch -XX:MaxVectorSize=16
+ *      -XX:CompileCommand=exclude,compiler.loopopts.superword.TestReductions::gold*
+ *      compiler.loopopts.superword.TestReductions
+ * @run main/othervm -Xbatch -XX:UseAVX=3 -XX:MaxVectorSize=64
+ *      -XX:CompileCommand=exclude,compiler.loopopts.superword.TestReductions::gold*
+ *      compiler.loopopts.superword.TestReductions
+ */
+
+package compiler.loopopts.superword;
+
+public class TestReductions {
+    private static final int LENGTH = 1021;
+    private static final int ITERATIONS = 20000;
+
+    private static int[] ia = new int[LENGTH];
+    private static int[] ib = new int[LENGTH];
+    private static long[] la = new long[LENGTH];
+    private static long[] lb = new long[LENGTH];
+    private static float[] fa = new float[LENGTH];
+    private static float[] fb = new float[LENGTH];
+    private static double[] da = new double[LENGTH];
+    private static double[] db = new double[LENGTH];
+
+    public static void main(String[] args) {
+        for (int i = 0; i < LENGTH; i++) {
+            ia[i] = i * 7 - 300;
+            ib[i] = (i % 5) - 2;
+            la[i] = i * 1000003L;
+            lb[i] = (i % 3) + 1;
+            fa[i] = i * 0.37f - 11.0f;
+            fb[i] = 1.0f + (i % 7) * 0.001f;
+            da[i] = i * 0.71 - 5.0;
+            db[i] = 1.0 + (i % 9) * 0.0001;
+        }
+
+        for (int n = 0; n < ITERATIONS; n++) {
+            check("int dot", dotInt(ia, ib), goldDotInt(ia, ib));
+            check("int mul", mulInt(ia, ib), goldMulInt(ia, ib));
+            check("long dot", dotLong(la, lb), goldDotLong(la, lb));
+            check("long mul", mulLong(la, lb), goldMulLong(la, lb));
+            check("float dot", dotFloat(fa, fb), goldDotFloat(fa, fb));
+            check("float mul", mulFloat(fb, fb), goldMulFloat(fb, fb));
+            check("double dot", dotDouble(da, db), goldDotDouble(da, db));
+            check("double mul", mulDouble(db, db), goldMulDouble(db, db));
+        }
+    }
+
+    private static void check(String what, long actual, long expected) {
+        if (actual != expected) {
+            throw new RuntimeException(what + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    private static void check(String what, double actual, double expected) {
+        // Floating point reductions are done in order and must be exact.
+        if (Double.doubleToLongBits(actual) != Double.doubleToLongBits(expected)) {
+            throw new RuntimeException(what + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    static int dotInt(int[] a, int[] b) {
+        int sum = 1;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    static int mulInt(int[] a, int[] b) {
+        int prod = 1;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i] + b[i];
+        }
+        return prod;
+    }
+
+    static long dotLong(long[] a, long[] b) {
+        long sum = 1;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] & b[i];
+        }
+        return sum;
+    }
+
+    static long mulLong(long[] a, long[] b) {
+        long prod = 1;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i] + b[i];
+        }
+        return prod;
+    }
+
+    static float dotFloat(float[] a, float[] b) {
+        float sum = 1.0f;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    static float mulFloat(float[] a, float[] b) {
+        float prod = 1.0f;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i] * b[i];
+        }
+        return prod;
+    }
+
+    static double dotDouble(double[] a, double[] b) {
+        double sum = 1.0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    static double mulDouble(double[] a, double[] b) {
+        double prod = 1.0;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i] * b[i];
+        }
+        return prod;
+    }
+
+    // The gold* methods are excluded from compilation.
+
+    static int goldDotInt(int[] a, int[] b) {
+        int sum = 1;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    static int goldMulInt(int[] a, int[] b) {
+        int prod = 1;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i] + b[i];
+        }
+        return prod;
+    }
+
+    static long goldDotLong(long[] a, long[] b) {
+        long sum = 1;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] & b[i];
+        }
+        return sum;
+    }
+
+    static long goldMulLong(long[] a, long[] b) {
+        long prod = 1;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i] + b[i];
+        }
+        return prod;
+    }
+
+    static float goldDotFloat(float[] a, float[] b) {
+        float sum = 1.0f;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    static float goldMulFloat(float[] a, float[] b) {
+        float prod = 1.0f;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i] * b[i];
+        }
+        return prod;
+    }
+
+    static double goldDotDouble(double[] a, double[] b) {
+        double sum = 1.0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    static double goldMulDouble(double[] a, double[] b) {
+        double prod = 1.0;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i] * b[i];
+        }
+        return prod;
+    }
+}
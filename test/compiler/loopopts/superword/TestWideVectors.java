@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Check vectorized arithmetic, shifts, copies and fills with 512bit vectors
+ * @run main/othervm -Xbatch -XX:UseAVX=3 -XX:MaxVectorSize=64
+ *      -XX:CompileCommand=exclude,compiler.loopopts.superword.TestWideVectors::gold*
+ *      compiler.loopopts.superword.TestWideVectors
+ * @run main/othervm -Xbatch -XX:UseAVX=3 -XX:MaxVectorSize=32
+ *      -XX:CompileCommand=exclude,compiler.loopopts.superword.TestWideVectors::gold*
+ *      compiler.loopopts.superword.TestWideVectors
+ */
+
+package compiler.loopopts.superword;
+
+import java.util.Arrays;
+
+public class TestWideVectors {
+    private static final int LENGTH = 1027;
+    private static final int ITERATIONS = 20000;
+
+    private static int[] ia = new int[LENGTH];
+    private static int[] ib = new int[LENGTH];
+    private static long[] la = new long[LENGTH];
+    private static long[] lb = new long[LENGTH];
+    private static float[] fa = new float[LENGTH];
+    private static float[] fb = new float[LENGTH];
+    private static double[] da = new double[LENGTH];
+    private static double[] db = new double[LENGTH];
+
+    public static void main(String[] args) {
+        for (int i = 0; i < LENGTH; i++) {
+            ia[i] = i * 7 - 300;
+            ib[i] = (i % 5) - 2;
+            la[i] = i * 1000003L - 17;
+            lb[i] = (i % 3) + 1;
+            fa[i] = i * 0.37f - 11.0f;
+            fb[i] = 1.0f + (i % 7) * 0.25f;
+            da[i] = i * 0.71 - 5.0;
+            db[i] = 1.0 + (i % 9) * 0.5;
+        }
+
+        int[] ir = new int[LENGTH];
+        int[] ig = new int[LENGTH];
+        long[] lr = new long[LENGTH];
+        long[] lg = new long[LENGTH];
+        float[] fr = new float[LENGTH];
+        float[] fg = new float[LENGTH];
+        double[] dr = new double[LENGTH];
+        double[] dg = new double[LENGTH];
+
+        for (int n = 0; n < ITERATIONS; n++) {
+            opsInt(ia, ib, ir, 42);
+            goldOpsInt(ia, ib, ig, 42);
+            check("int ops", Arrays.equals(ir, ig));
+            opsLong(la, lb, lr, 42L);
+            goldOpsLong(la, lb, lg, 42L);
+            check("long ops", Arrays.equals(lr, lg));
+            opsFloat(fa, fb, fr, 3.0f);
+            goldOpsFloat(fa, fb, fg, 3.0f);
+            check("float ops", Arrays.equals(fr, fg));
+            opsDouble(da, db, dr, 3.0);
+            goldOpsDouble(da, db, dg, 3.0);
+            check("double ops", Arrays.equals(dr, dg));
+
+            // Array copy and fill stubs
+            int off = n % 13;
+            System.arraycopy(ia, off, ir, 0, LENGTH - off);
+            System.arraycopy(ia, 0, ir, LENGTH - off, off);
+            check("arraycopy", ir[0] == ia[off] && ir[LENGTH - 1 - off] == ia[LENGTH - 1]);
+            System.arraycopy(ir, 0, ir, 1, LENGTH - 1);
+            check("overlapping arraycopy", ir[1] == ia[off] && ir[LENGTH - 1] == ia[LENGTH - 2]);
+            fill(ir, n);
+            for (int i = 0; i < LENGTH; i++) {
+                check("fill", ir[i] == n);
+            }
+        }
+    }
+
+    private static void check(String what, boolean ok) {
+        if (!ok) {
+            throw new RuntimeException(what + ": vectorized result differs");
+        }
+    }
+
+    private static void fill(int[] a, int v) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = v;
+        }
+    }
+
+    private static void opsInt(int[] a, int[] b, int[] r, int c) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = ((a[i] + b[i]) * (a[i] - c) ^ (a[i] << 3)) + ((a[i] >> 2) | (b[i] >>> 1)) + (a[i] & c);
+        }
+    }
+
+    private static void goldOpsInt(int[] a, int[] b, int[] r, int c) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = ((a[i] + b[i]) * (a[i] - c) ^ (a[i] << 3)) + ((a[i] >> 2) | (b[i] >>> 1)) + (a[i] & c);
+        }
+    }
+
+    private static void opsLong(long[] a, long[] b, long[] r, long c) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = ((a[i] + b[i]) ^ (a[i] << 5)) - ((a[i] >>> 3) | c) + (b[i] & c);
+        }
+    }
+
+    private static void goldOpsLong(long[] a, long[] b, long[] r, long c) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = ((a[i] + b[i]) ^ (a[i] << 5)) - ((a[i] >>> 3) | c) + (b[i] & c);
+        }
+    }
+
+    private static void opsFloat(float[] a, float[] b, float[] r, float c) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = (a[i] + b[i]) * c - a[i] / b[i];
+        }
+    }
+
+    private static void goldOpsFloat(float[] a, float[] b, float[] r, float c) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = (a[i] + b[i]) * c - a[i] / b[i];
+        }
+    }
+
+    private static void opsDouble(double[] a, double[] b, double[] r, double c) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = (a[i] + b[i]) * c - a[i] / b[i];
+        }
+    }
+
+    private static void goldOpsDouble(double[] a, double[] b, double[] r, double c) {
+        for (int i = 0; i < a.length; i++) {
+            r[i] = (a[i] + b[i]) * c - a[i] / b[i];
+        }
+    }
+}
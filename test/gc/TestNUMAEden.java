@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestNUMAEden
+ * @key gc
+ * @requires vm.gc=="null"
+ * @summary Check that ParNew and DefNew allocate, collect and walk a NUMA eden correctly.
+ * The runs with NUMAEdenChunks split the eden on a single node machine as well, the others
+ * only use a NUMA eden on a machine with several nodes.
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+UseNUMA -XX:ParallelGCThreads=4 -Xmx128m -Xmn32m -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC TestNUMAEden
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+UseNUMA -XX:ParallelGCThreads=4 -Xmx128m -Xmn32m -XX:+ExplicitGCInvokesConcurrent TestNUMAEden
+ * @run main/othervm -XX:+UseSerialGC -XX:+UseNUMA -Xmx128m -Xmn32m -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC TestNUMAEden
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+UseNUMA -XX:+ForceNUMA -XX:ParallelGCThreads=4 -Xmx128m -Xmn32m -XX:+UnlockDiagnosticVMOptions -XX:NUMAEdenChunks=4 -XX:+VerifyBeforeGC -XX:+VerifyAfterGC TestNUMAEden
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+UseNUMA -XX:+ForceNUMA -XX:ParallelGCThreads=4 -Xmx128m -Xmn32m -XX:+UnlockDiagnosticVMOptions -XX:NUMAEdenChunks=4 -XX:+ExplicitGCInvokesConcurrent TestNUMAEden
+ * @run main/othervm -XX:+UseSerialGC -XX:+UseNUMA -XX:+ForceNUMA -Xmx128m -Xmn32m -XX:+UnlockDiagnosticVMOptions -XX:NUMAEdenChunks=4 -XX:+VerifyBeforeGC -XX:+VerifyAfterGC TestNUMAEden
+ */
+
+public class TestNUMAEden {
+    static class Node {
+        final int value;
+        Node next;
+
+        Node(int value, Node next) {
+            this.value = value;
+            this.next = next;
+        }
+    }
+
+    private static final int THREADS = 4;
+    private static final int NODES = 50000;
+
+    public static void main(String[] args) throws Exception {
+        final Node[] heads = new Node[THREADS];
+        Thread[] threads = new Thread[THREADS];
+        for (int t = 0; t < THREADS; t++) {
+            final int index = t;
+            threads[t] = new Thread() {
+                public void run() {
+                    Node head = null;
+                    for (int i = 0; i < NODES; i++) {
+                        head = new Node(i, head);
+                        // Dead objects to trigger young collections.
+                        Object[] garbage = new Object[64];
+                    }
+                    heads[index] = head;
+                }
+            };
+            threads[t].start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+
+        System.gc();
+
+        for (int t = 0; t < THREADS; t++) {
+            int expected = NODES - 1;
+            for (Node n = heads[t]; n != null; n = n.next) {
+                if (n.value != expected) {
+                    throw new RuntimeException("Expected " + expected + " but found " + n.value);
+                }
+                expected--;
+            }
+            if (expected != -1) {
+                throw new RuntimeException("List truncated at " + expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestOWSTTaskTerminator
+ * @key gc
+ * @requires vm.gc=="null"
+ * @summary Run young and full collections with and without the spin master termination protocol.
+ * @run main/othervm -XX:+UseParallelGC -XX:ParallelGCThreads=8 -XX:+UseOWSTTaskTerminator -XX:+PrintGCDetails -XX:+ParallelGCVerbose TestOWSTTaskTerminator
+ * @run main/othervm -XX:+UseParallelGC -XX:ParallelGCThreads=8 -XX:-UseOWSTTaskTerminator TestOWSTTaskTerminator
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=8 -XX:+UseOWSTTaskTerminator TestOWSTTaskTerminator
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=8 -XX:+UseOWSTTaskTerminator -XX:+ExplicitGCInvokesConcurrent TestOWSTTaskTerminator
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=8 -XX:-UseOWSTTaskTerminator TestOWSTTaskTerminator
+ */
+
+public class TestOWSTTaskTerminator {
+  static class Node {
+    Node next;
+    Object[] payload = new Object[4];
+  }
+
+  public static void main(String args[]) throws Exception {
+    Node head = null;
+    for (int round = 0; round < 5; round++) {
+      for (int i = 0; i < 200000; i++) {
+        Node n = new Node();
+        n.next = head;
+        head = (i % 4 == 0) ? n : head;
+      }
+      System.gc();
+    }
+    if (head == null) {
+      throw new RuntimeException("Lost the list");
+    }
+  }
+}
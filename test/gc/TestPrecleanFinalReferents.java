@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestPrecleanFinalReferents
+ * @key gc
+ * @requires vm.gc=="null"
+ * @summary Finalizable objects must find what they refer to intact when traced before remark.
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+ExplicitGCInvokesConcurrent -XX:+PrintGCDetails -XX:+PrintReferenceGC TestPrecleanFinalReferents
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+ExplicitGCInvokesConcurrent -XX:-PrecleanFinalReferents TestPrecleanFinalReferents
+ * @run main/othervm -XX:+UseG1GC -XX:+ExplicitGCInvokesConcurrent -XX:+PrintGCDetails -XX:+PrintReferenceGC TestPrecleanFinalReferents
+ * @run main/othervm -XX:+UseG1GC -XX:+ExplicitGCInvokesConcurrent -XX:-PrecleanFinalReferents TestPrecleanFinalReferents
+ */
+
+import java.util.concurrent.atomic.AtomicInteger;
+
+public class TestPrecleanFinalReferents {
+  static final int COUNT = 20000;
+  static final int CHAIN = 8;
+  static final AtomicInteger finalized = new AtomicInteger();
+  static final AtomicInteger broken = new AtomicInteger();
+
+  static class Node {
+    final int value;
+    final Node next;
+
+    Node(int value, Node next) {
+      this.value = value;
+      this.next = next;
+    }
+  }
+
+  static class Finalizable {
+    final Node chain;
+
+    Finalizable(int id) {
+      Node n = null;
+      for (int i = CHAIN - 1; i >= 0; i--) {
+        n = new Node(id + i, n);
+      }
+      chain = n;
+    }
+
+    @Override
+    protected void finalize() {
+      int expected = chain.value;
+      for (Node n = chain; n != null; n = n.next) {
+        if (n.value != expected++) {
+          broken.incrementAndGet();
+        }
+      }
+      if (expected != chain.value + CHAIN) {
+        broken.incrementAndGet();
+      }
+      finalized.incrementAndGet();
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    // Let the finalizable objects reach the old generation before they die.
+    Finalizable[] live = new Finalizable[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+      live[i] = new Finalizable(i);
+    }
+    System.gc();
+    Thread.sleep(100);
+    live = null;
+
+    long deadline = System.currentTimeMillis() + 120000;
+    while (finalized.get() < COUNT) {
+      if (System.currentTimeMillis() > deadline) {
+        throw new RuntimeException("Only " + finalized.get() + " of " + COUNT + " objects finalized");
+      }
+      // Keep some allocation going while the cycles run.
+      byte[][] garbage = new byte[64][];
+      for (int i = 0; i < garbage.length; i++) {
+        garbage[i] = new byte[1024];
+      }
+      System.gc();
+      System.runFinalization();
+      Thread.sleep(50);
+    }
+    if (broken.get() != 0) {
+      throw new RuntimeException(broken.get() + " finalizers found a broken chain");
+    }
+  }
+}
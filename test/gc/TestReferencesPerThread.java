@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestReferencesPerThread
+ * @key gc
+ * @requires vm.gc=="null"
+ * @summary Process bursts of references with a number of workers chosen from their count.
+ * @run main/othervm -XX:+UseParallelGC -XX:ParallelGCThreads=8 -XX:+PrintGCDetails -XX:+PrintReferenceGC TestReferencesPerThread
+ * @run main/othervm -XX:+UseParallelGC -XX:ParallelGCThreads=8 -XX:ReferencesPerThread=0 TestReferencesPerThread
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=8 -XX:ReferencesPerThread=10 TestReferencesPerThread
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=8 -XX:ReferencesPerThread=100000 TestReferencesPerThread
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=8 -XX:-ParallelRefProcEnabled TestReferencesPerThread
+ */
+
+import java.lang.ref.WeakReference;
+import java.util.concurrent.atomic.AtomicInteger;
+
+public class TestReferencesPerThread {
+  static final AtomicInteger finalized = new AtomicInteger();
+
+  static class Finalizable {
+    @Override
+    protected void finalize() {
+      finalized.incrementAndGet();
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    int[] counts = { 10, 5000, 200000 };
+    for (int count : counts) {
+      WeakReference<?>[] refs = new WeakReference<?>[count];
+      for (int i = 0; i < count; i++) {
+        refs[i] = new WeakReference<Object>(new Object());
+        new Finalizable();
+      }
+      System.gc();
+      for (int i = 0; i < count; i++) {
+        if (refs[i].get() != null) {
+          throw new RuntimeException("WeakReference " + i + " of " + count + " not cleared");
+        }
+      }
+    }
+
+    int expected = 10 + 5000 + 200000;
+    long deadline = System.currentTimeMillis() + 60000;
+    while (finalized.get() < expected) {
+      if (System.currentTimeMillis() > deadline) {
+        throw new RuntimeException("Only " + finalized.get() + " of " + expected + " objects finalized");
+      }
+      System.gc();
+      System.runFinalization();
+      Thread.sleep(10);
+    }
+  }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestCMSParPromoteSharedBatches
+ * @key gc
+ * @requires vm.gc=="ConcMarkSweep" | vm.gc=="null"
+ * @summary Promote into CMS with many workers, with and without shared LAB refill batches
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=8 -XX:+PrintOldPLAB -Xmn8m -Xmx128m -XX:OldPLABSize=1k TestCMSParPromoteSharedBatches
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=8 -XX:CMSParPromoteSharedBatches=0 -Xmn8m -Xmx128m TestCMSParPromoteSharedBatches
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=8 -XX:CMSParPromoteSharedBatches=16 -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC -Xmn8m -Xmx64m TestCMSParPromoteSharedBatches
+ */
+
+public class TestCMSParPromoteSharedBatches {
+    static class Node {
+        final int id;
+        final Node next;
+        final byte[] payload;
+
+        Node(int id, Node next) {
+            this.id = id;
+            this.next = next;
+            this.payload = new byte[id % 64];
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Objects of many sizes survive long enough to be promoted.
+        Node[] lists = new Node[64];
+        for (int round = 0; round < 200; round++) {
+            int slot = round % lists.length;
+            Node head = null;
+            for (int i = 0; i < 2_000; i++) {
+                head = new Node(i, head);
+            }
+            lists[slot] = head;
+        }
+        for (Node head : lists) {
+            int expected = 1_999;
+            for (Node n = head; n != null; n = n.next) {
+                if (n.id != expected || n.payload.length != expected % 64) {
+                    throw new RuntimeException("Corrupted node " + n.id + ", expected " + expected);
+                }
+                expected--;
+            }
+            if (expected != -1) {
+                throw new RuntimeException("List cut short at " + expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestCMSParallelSweep
+ * @key gc
+ * @requires vm.gc=="ConcMarkSweep" | vm.gc=="null"
+ * @summary Run concurrent CMS cycles with the sweep split across the concurrent GC threads
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+ExplicitGCInvokesConcurrent -XX:ConcGCThreads=4 -XX:+CMSParallelSweepEnabled -Xmn8m -Xmx128m TestCMSParallelSweep
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+ExplicitGCInvokesConcurrent -XX:ConcGCThreads=4 -XX:+CMSParallelSweepEnabled -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC -Xmn8m -Xmx64m TestCMSParallelSweep
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+ExplicitGCInvokesConcurrent -XX:ConcGCThreads=4 -XX:-CMSParallelSweepEnabled -Xmn8m -Xmx128m TestCMSParallelSweep
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:-UseParNewGC -XX:+ExplicitGCInvokesConcurrent -XX:ConcGCThreads=4 -XX:+CMSParallelSweepEnabled -Xmn8m -Xmx128m TestCMSParallelSweep
+ */
+
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+
+public class TestCMSParallelSweep {
+    static class Node {
+        final int id;
+        final byte[] payload;
+
+        Node(int id) {
+            this.id = id;
+            this.payload = new byte[(id * 7) % 300];
+        }
+    }
+
+    private static final int SLOTS = 100_000;
+
+    public static void main(String[] args) throws Exception {
+        // Old objects of many sizes, with every other one dropped
+        // in each round so that the sweep has runs of garbage to
+        // coalesce between the live ones.
+        Node[] nodes = new Node[SLOTS];
+        for (int round = 0; round < 6; round++) {
+            for (int i = round % 2; i < SLOTS; i += 2) {
+                nodes[i] = new Node(i);
+            }
+            long before = cmsCycles();
+            System.gc();
+            waitForCycle(before);
+        }
+        for (int i = 0; i < SLOTS; i++) {
+            Node n = nodes[i];
+            if (n == null || n.id != i || n.payload.length != (i * 7) % 300) {
+                throw new RuntimeException("Corrupted node at " + i);
+            }
+        }
+    }
+
+    private static long cmsCycles() {
+        for (GarbageCollectorMXBean gc : ManagementFactory.getGarbageCollectorMXBeans()) {
+            if (gc.getName().equals("ConcurrentMarkSweep")) {
+                return gc.getCollectionCount();
+            }
+        }
+        throw new RuntimeException("No ConcurrentMarkSweep collector");
+    }
+
+    private static void waitForCycle(long before) throws InterruptedException {
+        // The count is updated at the end of the sweep.
+        for (int i = 0; i < 600 && cmsCycles() == before; i++) {
+            Thread.sleep(50);
+        }
+    }
+}
@@ -36,25 +36,29 @@ import com.oracle.java.testlibrary.OutputAnalyzer;
 public class TestDynamicNumberOfGCThreads {
   public static void main(String[] args) throws Exception {
 
-    testDynamicNumberOfGCThreads("UseConcMarkSweepGC");
+    testDynamicNumberOfGCThreads("UseConcMarkSweepGC", false);
 
-    testDynamicNumberOfGCThreads("UseG1GC");
+    testDynamicNumberOfGCThreads("UseG1GC", true);
 
-    testDynamicNumberOfGCThreads("UseParallelGC");
+    testDynamicNumberOfGCThreads("UseParallelGC", true);
   }
 
-  private static void verifyDynamicNumberOfGCThreads(OutputAnalyzer output) {
+  private static void verifyDynamicNumberOfGCThreads(OutputAnalyzer output, boolean byWork) {
     output.shouldHaveExitValue(0); // test should run succesfully
     output.shouldContain("new_active_workers");
+    if (byWork) {
+      // The young collections choose their workers from their work
+      output.shouldContain("GCWorkerEstimator::workers_for()");
+    }
   }
 
-  private static void testDynamicNumberOfGCThreads(String gcFlag) throws Exception {
+  private static void testDynamicNumberOfGCThreads(String gcFlag, boolean byWork) throws Exception {
     // UseDynamicNumberOfGCThreads and TraceDynamicGCThreads enabled
     String[] baseArgs = {"-XX:+" + gcFlag, "-Xmx10M", "-XX:+PrintGCDetails",  "-XX:+UseDynamicNumberOfGCThreads", "-XX:+TraceDynamicGCThreads", GCTest.class.getName()};
 
     // Base test with gc and +UseDynamicNumberOfGCThreads:
     ProcessBuilder pb_enabled = ProcessTools.createJavaProcessBuilder(baseArgs);
-    verifyDynamicNumberOfGCThreads(new OutputAnalyzer(pb_enabled.start()));
+    verifyDynamicNumberOfGCThreads(new OutputAnalyzer(pb_enabled.start()), byWork);
 
     // Ensure it also works on uniprocessors or if user specifies -XX:ParallelGCThreads=1:
     String[] extraArgs = {"-XX:+UnlockDiagnosticVMOptions", "-XX:+ForceDynamicNumberOfGCThreads", "-XX:ParallelGCThreads=1"};
@@ -62,7 +66,7 @@ public class TestDynamicNumberOfGCThreads {
     System.arraycopy(extraArgs, 0, finalArgs, 0,                extraArgs.length);
     System.arraycopy(baseArgs,  0, finalArgs, extraArgs.length, baseArgs.length);
     pb_enabled = ProcessTools.createJavaProcessBuilder(finalArgs);
-    verifyDynamicNumberOfGCThreads(new OutputAnalyzer(pb_enabled.start()));
+    verifyDynamicNumberOfGCThreads(new OutputAnalyzer(pb_enabled.start()), byWork);
   }
 
   static class GCTest {
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestNUMAAllocation
+ * @key gc
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Check that G1 allocates and evacuates correctly with NUMA aware alloc regions
+ * and that the per node heap sizes are consistent
+ * @library /testlibrary
+ * @run main/othervm TestNUMAAllocation
+ */
+
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+import com.oracle.java.testlibrary.Asserts;
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+class NUMAAllocationWorkload {
+    static class Node {
+        final int value;
+        Node next;
+
+        Node(int value, Node next) {
+            this.value = value;
+            this.next = next;
+        }
+    }
+
+    private static final int THREADS = 4;
+    private static final int NODES = 50000;
+
+    public static void main(String[] args) throws Exception {
+        final Node[] heads = new Node[THREADS];
+        Thread[] threads = new Thread[THREADS];
+        for (int t = 0; t < THREADS; t++) {
+            final int index = t;
+            threads[t] = new Thread() {
+                public void run() {
+                    Node head = null;
+                    for (int i = 0; i < NODES; i++) {
+                        head = new Node(i, head);
+                        // Dead objects to trigger young collections.
+                        Object[] garbage = new Object[64];
+                    }
+                    heads[index] = head;
+                }
+            };
+            threads[t].start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+
+        System.gc();
+
+        for (int t = 0; t < THREADS; t++) {
+            int expected = NODES - 1;
+            for (Node n = heads[t]; n != null; n = n.next) {
+                if (n.value != expected) {
+                    throw new RuntimeException("Expected " + expected + " but found " + n.value);
+                }
+                expected--;
+            }
+            if (expected != -1) {
+                throw new RuntimeException("List truncated at " + expected);
+            }
+        }
+    }
+}
+
+public class TestNUMAAllocation {
+    private static final long REGION_SIZE_K = 1024;
+
+    public static void main(String[] args) throws Exception {
+        runTest("-XX:+UnlockDiagnosticVMOptions", "-XX:+VerifyBeforeGC", "-XX:+VerifyAfterGC");
+        runTest("-XX:+UseLargePages");
+    }
+
+    private static void runTest(String... extraArgs) throws Exception {
+        String[] baseArgs = {
+            "-XX:+UseG1GC",
+            "-XX:+UseNUMA",
+            "-Xmx128m",
+            "-XX:G1HeapRegionSize=1m",
+            // Prints the heap, including the per node sizes, at exit.
+            "-XX:+PrintGCDetails"
+        };
+        String[] vmArgs = new String[baseArgs.length + extraArgs.length + 1];
+        System.arraycopy(baseArgs, 0, vmArgs, 0, baseArgs.length);
+        System.arraycopy(extraArgs, 0, vmArgs, baseArgs.length, extraArgs.length);
+        vmArgs[vmArgs.length - 1] = NUMAAllocationWorkload.class.getName();
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(vmArgs);
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+
+        checkNodeSizes(output.getStdout());
+    }
+
+    private static void checkNodeSizes(String stdout) {
+        Matcher heap = Pattern.compile("garbage-first heap\\s+total (\\d+)K").matcher(stdout);
+        Asserts.assertTrue(heap.find(), "Heap was not printed at exit");
+        long totalK = Long.parseLong(heap.group(1));
+
+        Matcher m = Pattern.compile("numa node (\\d+): committed (\\d+)K, used (\\d+)K").matcher(stdout);
+        int nodes = 0;
+        long committedSumK = 0;
+        long usedSumK = 0;
+        while (m.find()) {
+            long committedK = Long.parseLong(m.group(2));
+            long usedK = Long.parseLong(m.group(3));
+            Asserts.assertEQ(committedK % REGION_SIZE_K, 0L,
+                             "Node " + m.group(1) + " committed " + committedK + "K is not a multiple of the region size");
+            Asserts.assertLTE(usedK, committedK,
+                              "Node " + m.group(1) + " uses more than it has committed");
+            committedSumK += committedK;
+            usedSumK += usedK;
+            nodes++;
+        }
+
+        if (nodes == 0) {
+            System.out.println("Single NUMA node, no per node sizes printed");
+            return;
+        }
+        Asserts.assertGTE(nodes, 2, "Per node sizes are only printed with several NUMA nodes");
+        // The per node sizes are recalculated at every collection and the
+        // heap does not shrink outside of one, so they never exceed the total.
+        Asserts.assertLTE(committedSumK, totalK, "Per node committed sizes exceed the heap capacity");
+        Asserts.assertGT(usedSumK, 0L, "No per node used bytes recorded");
+    }
+}
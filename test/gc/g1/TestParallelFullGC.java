@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestParallelFullGC
+ * @key gc
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Check that the parallel G1 full gc keeps the object graph intact
+ * @run main/othervm -XX:+UseG1GC -XX:+G1ParallelFullGC -XX:ParallelGCThreads=4 -Xmx128m -XX:G1HeapRegionSize=1m -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC TestParallelFullGC
+ * @run main/othervm -XX:+UseG1GC -XX:+G1ParallelFullGC -XX:ParallelGCThreads=4 -XX:+ParallelRefProcEnabled -Xmx128m -XX:G1HeapRegionSize=1m TestParallelFullGC
+ * @run main/othervm -XX:+UseG1GC -XX:+G1ParallelFullGC -XX:ParallelGCThreads=1 -Xmx128m TestParallelFullGC
+ */
+
+import java.lang.ref.WeakReference;
+import java.util.ArrayList;
+
+public class TestParallelFullGC {
+    static class Node {
+        final int value;
+        Node next;
+        Object[] payload;
+
+        Node(int value, Node next) {
+            this.value = value;
+            this.next = next;
+        }
+    }
+
+    private static final int NODES = 100000;
+    private static final int ITERATIONS = 5;
+
+    public static void main(String[] args) throws Exception {
+        Node head = null;
+        ArrayList<Object> garbage = new ArrayList<>();
+        for (int i = 0; i < NODES; i++) {
+            head = new Node(i, head);
+            if (i % 1000 == 0) {
+                // Large arrays are scanned in chunks by the marking threads.
+                head.payload = new Object[50000];
+                head.payload[49999] = Integer.valueOf(i);
+            }
+            // Interleave dead objects so that compaction moves the live ones.
+            garbage.add(new int[16]);
+            if (garbage.size() > 1000) {
+                garbage.clear();
+            }
+        }
+
+        // Live and dead humongous objects.
+        byte[] humongous = new byte[2 * 1024 * 1024];
+        humongous[humongous.length - 1] = 42;
+        new byte[2 * 1024 * 1024][0] = 1;
+
+        WeakReference<Object> weak = new WeakReference<Object>(new Object());
+        Object strong = new Object();
+        WeakReference<Object> weakReachable = new WeakReference<Object>(strong);
+
+        for (int i = 0; i < ITERATIONS; i++) {
+            System.gc();
+            check(head, humongous);
+        }
+
+        if (weak.get() != null) {
+            throw new RuntimeException("Weakly reachable object not cleared");
+        }
+        if (weakReachable.get() != strong) {
+            throw new RuntimeException("Strongly reachable referent cleared");
+        }
+    }
+
+    private static void check(Node head, byte[] humongous) {
+        int expected = NODES - 1;
+        for (Node n = head; n != null; n = n.next) {
+            if (n.value != expected) {
+                throw new RuntimeException("Expected " + expected + " but found " + n.value);
+            }
+            if (n.value % 1000 == 0 && !Integer.valueOf(n.value).equals(n.payload[49999])) {
+                throw new RuntimeException("Payload of node " + n.value + " corrupted");
+            }
+            expected--;
+        }
+        if (expected != -1) {
+            throw new RuntimeException("List truncated at " + expected);
+        }
+        if (humongous[humongous.length - 1] != 42) {
+            throw new RuntimeException("Humongous object corrupted");
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestPeriodicCollection
+ * @key gc
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Check that an idle G1 heap is shrunk by periodic collections
+ * @run main/othervm -XX:+UseG1GC -Xms8m -Xmx128m -XX:G1HeapRegionSize=1m -XX:MinHeapFreeRatio=10 -XX:MaxHeapFreeRatio=30 -XX:G1PeriodicGCInterval=3000 -XX:+PrintGC TestPeriodicCollection
+ * @run main/othervm -XX:+UseG1GC -Xms8m -Xmx128m -XX:G1HeapRegionSize=1m -XX:MinHeapFreeRatio=10 -XX:MaxHeapFreeRatio=30 -XX:G1PeriodicGCInterval=3000 -XX:-G1PeriodicGCInvokesConcurrent -XX:+PrintGC TestPeriodicCollection
+ */
+
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryUsage;
+import java.util.ArrayList;
+
+public class TestPeriodicCollection {
+    private static final long TIMEOUT_MILLIS = 60 * 1000;
+
+    private static long committed() {
+        MemoryUsage usage = ManagementFactory.getMemoryMXBean().getHeapMemoryUsage();
+        return usage.getCommitted();
+    }
+
+    public static void main(String[] args) throws Exception {
+        ArrayList<byte[]> live = new ArrayList<>();
+        for (int i = 0; i < 80; i++) {
+            live.add(new byte[512 * 1024]);
+        }
+        long committedAfterBurst = committed();
+        System.out.println("Committed after burst: " + committedAfterBurst);
+        live = null;
+
+        // Stay idle until the heap has shrunk.
+        long start = System.currentTimeMillis();
+        while (System.currentTimeMillis() - start < TIMEOUT_MILLIS) {
+            Thread.sleep(500);
+            long committed = committed();
+            if (committed < committedAfterBurst / 2) {
+                System.out.println("Committed after idle period: " + committed);
+                return;
+            }
+        }
+        throw new RuntimeException("Heap not shrunk after " + TIMEOUT_MILLIS +
+                                   " ms, committed: " + committed());
+    }
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestGCTaskStealing
+ * @key gc
+ * @requires vm.gc=="Parallel" | vm.gc=="null"
+ * @summary Run young and full collections with the lock free GCTask queues
+ * @run main/othervm -XX:+UseParallelGC -XX:+UseGCTaskStealing -XX:ParallelGCThreads=4 -Xmn8m -Xmx64m TestGCTaskStealing
+ * @run main/othervm -XX:+UseParallelGC -XX:-UseParallelOldGC -XX:+UseGCTaskStealing -XX:ParallelGCThreads=4 -Xmn8m -Xmx64m TestGCTaskStealing
+ * @run main/othervm -XX:+UseParallelGC -XX:+UseGCTaskStealing -XX:+UseGCTaskAffinity -XX:ParallelGCThreads=4 -Xmn8m -Xmx64m TestGCTaskStealing
+ * @run main/othervm -XX:+UseParallelGC -XX:+UseGCTaskStealing -XX:+UseDynamicNumberOfGCThreads -XX:ParallelGCThreads=4 -Xmn8m -Xmx64m TestGCTaskStealing
+ */
+
+public class TestGCTaskStealing {
+  static Object[] live = new Object[1024];
+
+  public static void main(String args[]) throws Exception {
+    for (int i = 0; i < 200000; i++) {
+      // Keep some of the objects alive so that they are copied and promoted.
+      Object o = new int[i % 64];
+      if (i % 16 == 0) {
+        live[(i / 16) % live.length] = o;
+      }
+    }
+    System.gc();
+    for (Object o : live) {
+      if (o == null) {
+        throw new RuntimeException("Lost an object");
+      }
+    }
+  }
+}
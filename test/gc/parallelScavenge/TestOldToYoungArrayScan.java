@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestOldToYoungArrayScan
+ * @key gc
+ * @requires vm.gc=="Parallel" | vm.gc=="null"
+ * @summary Check that young collections find the young objects referenced from sparse
+ * elements of large old object arrays spanning several card stripes
+ * @run main/othervm -XX:+UseParallelGC -XX:ParallelGCThreads=4 -Xmn8m -Xmx128m -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC TestOldToYoungArrayScan
+ * @run main/othervm -XX:+UseParallelGC -XX:ParallelGCThreads=4 -Xmn8m -Xmx128m -XX:+PrintGCDetails TestOldToYoungArrayScan
+ * @run main/othervm -XX:+UseParallelGC -XX:-UseParallelOldGC -XX:ParallelGCThreads=2 -Xmn8m -Xmx128m TestOldToYoungArrayScan
+ */
+
+import java.util.BitSet;
+
+public class TestOldToYoungArrayScan {
+  static class Value {
+    final int value;
+
+    Value(int value) {
+      this.value = value;
+    }
+  }
+
+  // A card stripe covers 64k, so each array spans several dozen stripes.
+  static final int ARRAYS = 4;
+  static final int LENGTH = 1024 * 1024;
+  static final int ROUNDS = 20;
+
+  static Object[][] arrays = new Object[ARRAYS][];
+  static BitSet[] set = new BitSet[ARRAYS];
+
+  // The elements set in a round; a prime stride spreads them over the
+  // cards of the arrays, leaving most cards clean.
+  static int index(int round, int i) {
+    return (int)(((long)i * 7919 + round * 131) % LENGTH);
+  }
+
+  static int expected(int a, int index) {
+    return a * LENGTH + index;
+  }
+
+  public static void main(String args[]) throws Exception {
+    for (int a = 0; a < ARRAYS; a++) {
+      arrays[a] = new Object[LENGTH];
+      set[a] = new BitSet(LENGTH);
+    }
+    // Promote the arrays to the old generation.
+    System.gc();
+
+    for (int round = 0; round < ROUNDS; round++) {
+      for (int a = 0; a < ARRAYS; a++) {
+        for (int i = 0; i < 64; i++) {
+          int index = index(round, i);
+          arrays[a][index] = new Value(expected(a, index));
+          set[a].set(index);
+        }
+      }
+      // Garbage to trigger young collections while the elements set
+      // above are the only references to their young referents.
+      for (int i = 0; i < 100000; i++) {
+        Object[] garbage = new Object[16];
+      }
+      check();
+    }
+  }
+
+  static void check() {
+    for (int a = 0; a < ARRAYS; a++) {
+      Object[] array = arrays[a];
+      for (int index = 0; index < LENGTH; index++) {
+        Object o = array[index];
+        if (o == null) {
+          if (set[a].get(index)) {
+            throw new RuntimeException("Array " + a + " element " + index + " was cleared");
+          }
+          continue;
+        }
+        int value = ((Value)o).value;
+        if (value != expected(a, index)) {
+          throw new RuntimeException("Array " + a + " element " + index +
+                                     " refers to " + value + " instead of " + expected(a, index));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestThreadLocalHandshakes
+ * @summary Revoke biases and take stack traces of single threads with thread-local handshakes
+ * @run main/othervm -XX:+UseBiasedLocking -XX:BiasedLockingStartupDelay=0 -XX:+ThreadLocalHandshakes TestThreadLocalHandshakes
+ * @run main/othervm -XX:+UseBiasedLocking -XX:BiasedLockingStartupDelay=0 -XX:-ThreadLocalHandshakes TestThreadLocalHandshakes
+ */
+
+import java.lang.management.ManagementFactory;
+import java.lang.management.ThreadInfo;
+import java.lang.management.ThreadMXBean;
+
+public class TestThreadLocalHandshakes {
+    private static final int WORKERS = 4;
+    private static final int ITERATIONS = 2000;
+
+    private static volatile boolean done;
+    private static final Object[] locks = new Object[WORKERS];
+
+    static class Worker extends Thread {
+        private final int index;
+        long count;
+
+        Worker(int index) {
+            this.index = index;
+            setDaemon(true);
+        }
+
+        public void run() {
+            while (!done) {
+                synchronized (locks[index]) {
+                    count++;
+                    spin(10);
+                }
+            }
+        }
+    }
+
+    static int sink;
+
+    static void spin(int n) {
+        for (int i = 0; i < n; i++) {
+            sink += i;
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        Worker[] workers = new Worker[WORKERS];
+        for (int i = 0; i < WORKERS; i++) {
+            locks[i] = new Object();
+            workers[i] = new Worker(i);
+            workers[i].start();
+        }
+
+        ThreadMXBean bean = ManagementFactory.getThreadMXBean();
+        for (int i = 0; i < ITERATIONS; i++) {
+            Worker w = workers[i % WORKERS];
+            // Revokes the bias of the lock towards the worker.
+            synchronized (locks[i % WORKERS]) {
+                spin(10);
+            }
+            ThreadInfo info = bean.getThreadInfo(w.getId(), Integer.MAX_VALUE);
+            if (info == null || info.getThreadState() == Thread.State.TERMINATED) {
+                throw new RuntimeException("Worker " + w.getName() + " not alive");
+            }
+            for (StackTraceElement e : info.getStackTrace()) {
+                if (e.getClassName() == null || e.getMethodName() == null) {
+                    throw new RuntimeException("Broken stack trace of " + w.getName());
+                }
+            }
+        }
+        ThreadInfo self = bean.getThreadInfo(Thread.currentThread().getId(), Integer.MAX_VALUE);
+        if (self.getStackTrace().length == 0) {
+            throw new RuntimeException("Empty stack trace of the current thread");
+        }
+
+        done = true;
+        for (Worker w : workers) {
+            w.join();
+            if (w.count == 0) {
+                throw new RuntimeException("Worker " + w.getName() + " made no progress");
+            }
+        }
+    }
+}
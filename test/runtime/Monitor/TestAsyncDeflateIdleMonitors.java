@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestAsyncDeflateIdleMonitors
+ * @summary Check locking and identity hashes while the service thread deflates idle monitors
+ * @run main/othervm -XX:+AsyncDeflateIdleMonitors -XX:AsyncDeflationInterval=1 TestAsyncDeflateIdleMonitors
+ * @run main/othervm -XX:+AsyncDeflateIdleMonitors -XX:AsyncDeflationInterval=1 -XX:-UseBiasedLocking -XX:MonitorBound=100 TestAsyncDeflateIdleMonitors
+ * @run main/othervm -XX:+AsyncDeflateIdleMonitors -XX:+UseG1GC -XX:ParallelGCThreads=4 -XX:+ParallelSafepointCleanup TestAsyncDeflateIdleMonitors
+ */
+
+public class TestAsyncDeflateIdleMonitors {
+    private static final int THREADS = 16;
+    private static final int LOCKS = 1000;
+    private static final int ITERATIONS = 200;
+
+    private static final Object[] locks = new Object[LOCKS];
+    private static final int[] hashes = new int[LOCKS];
+    private static final long[] counters = new long[LOCKS];
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < LOCKS; i++) {
+            locks[i] = new Object();
+        }
+
+        Thread[] threads = new Thread[THREADS];
+        for (int t = 0; t < THREADS; t++) {
+            final int offset = t * 7;
+            threads[t] = new Thread() {
+                public void run() {
+                    for (int n = 0; n < ITERATIONS; n++) {
+                        for (int i = 0; i < LOCKS; i++) {
+                            int index = (i + offset) % LOCKS;
+                            Object lock = locks[index];
+                            synchronized (lock) {
+                                counters[index]++;
+                                if (n % 50 == 0) {
+                                    // Inflates the monitor.
+                                    try {
+                                        lock.wait(0, 1);
+                                    } catch (InterruptedException e) {
+                                        throw new RuntimeException(e);
+                                    }
+                                }
+                            }
+                            // The identity hash may be installed while the
+                            // monitor is being deflated.
+                            int hash = System.identityHashCode(lock);
+                            synchronized (hashes) {
+                                if (hashes[index] == 0) {
+                                    hashes[index] = hash;
+                                } else if (hashes[index] != hash) {
+                                    throw new RuntimeException("Identity hash of lock " + index + " changed");
+                                }
+                            }
+                        }
+                    }
+                }
+            };
+            threads[t].start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+
+        for (int i = 0; i < LOCKS; i++) {
+            if (counters[i] != (long) THREADS * ITERATIONS) {
+                throw new RuntimeException("Lost update on lock " + i + ": " + counters[i]);
+            }
+            if (System.identityHashCode(locks[i]) != hashes[i]) {
+                throw new RuntimeException("Identity hash of lock " + i + " changed");
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestParallelSafepointCleanup
+ * @summary Check that monitors stay usable when the GC workers deflate them at safepoints
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 -XX:+ParallelSafepointCleanup -XX:+PrintSafepointStatistics -XX:PrintSafepointStatisticsCount=1 TestParallelSafepointCleanup
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 -XX:+ParallelSafepointCleanup -XX:+MonitorInUseLists -XX:+TraceSafepointCleanupTime TestParallelSafepointCleanup
+ * @run main/othervm -XX:+UseParNewGC -XX:ParallelGCThreads=4 -XX:+ParallelSafepointCleanup -XX:+MonitorInUseLists TestParallelSafepointCleanup
+ * @run main/othervm -XX:+UseSerialGC -XX:+ParallelSafepointCleanup TestParallelSafepointCleanup
+ */
+
+public class TestParallelSafepointCleanup {
+    private static final int THREADS = 32;
+    private static final int LOCKS = 2000;
+    private static final int ROUNDS = 20;
+
+    private static final Object[] locks = new Object[LOCKS];
+    private static final long[] counters = new long[LOCKS];
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < LOCKS; i++) {
+            locks[i] = new Object();
+        }
+
+        for (int round = 0; round < ROUNDS; round++) {
+            Thread[] threads = new Thread[THREADS];
+            for (int t = 0; t < THREADS; t++) {
+                final int offset = t;
+                threads[t] = new Thread() {
+                    public void run() {
+                        for (int i = 0; i < LOCKS; i++) {
+                            Object lock = locks[(i + offset) % LOCKS];
+                            synchronized (lock) {
+                                // Inflates the monitor.
+                                lock.hashCode();
+                                try {
+                                    lock.wait(0, 1);
+                                } catch (InterruptedException e) {
+                                    throw new RuntimeException(e);
+                                }
+                                counters[(i + offset) % LOCKS]++;
+                            }
+                        }
+                    }
+                };
+                threads[t].start();
+            }
+            // The idle monitors are deflated at the safepoints of the collections.
+            System.gc();
+            for (Thread t : threads) {
+                t.join();
+            }
+            System.gc();
+        }
+
+        for (int i = 0; i < LOCKS; i++) {
+            if (counters[i] != (long) THREADS * ROUNDS) {
+                throw new RuntimeException("Lost update on lock " + i + ": " + counters[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test AppClassesInArchive
+ * @summary Classes of the application class path are archived with
+ *          -XX:+UseAppCDS and loaded from the archive by the AppClassLoader
+ * @library /testlibrary
+ * @build AppClassesInArchive
+ * @run main AppClassesInArchive
+ */
+
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.FileWriter;
+import java.util.jar.JarEntry;
+import java.util.jar.JarOutputStream;
+
+import com.oracle.java.testlibrary.*;
+
+public class AppClassesInArchive {
+  public static class Hello {
+    public static void main(String[] args) {
+      System.out.println("Hello from " + Hello.class.getClassLoader());
+    }
+  }
+
+  private static final String HELLO = "AppClassesInArchive$Hello";
+
+  public static void main(String[] args) throws Exception {
+    String jar = buildJar();
+
+    FileWriter classlist = new FileWriter("appcds.classlist");
+    classlist.write(HELLO.replace('.', '/') + "\n");
+    classlist.close();
+
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:+UseAppCDS", "-cp", jar,
+        "-XX:ExtraSharedClassListFile=appcds.classlist",
+        "-XX:SharedArchiveFile=./appcds.jsa", "-Xshare:dump");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldContain("Loading classes to share");
+    output.shouldHaveExitValue(0);
+
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:+UseAppCDS", "-cp", jar,
+        "-XX:SharedArchiveFile=./appcds.jsa", "-Xshare:on",
+        "-XX:+TraceClassLoading", HELLO);
+    output = new OutputAnalyzer(pb.start());
+    output.shouldContain("[Loaded " + HELLO + " from shared objects file");
+    output.shouldContain("Hello from sun.misc.Launcher$AppClassLoader");
+    output.shouldHaveExitValue(0);
+
+    // A different class path does not match the archive.
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:+UseAppCDS", "-cp", System.getProperty("test.classes"),
+        "-XX:SharedArchiveFile=./appcds.jsa", "-Xshare:on", HELLO);
+    output = new OutputAnalyzer(pb.start());
+    output.shouldContain("shared class paths mismatch");
+    output.shouldHaveExitValue(1);
+  }
+
+  private static String buildJar() throws Exception {
+    File jar = new File("appcds.jar");
+    String entry = HELLO + ".class";
+    File classFile = new File(System.getProperty("test.classes"), entry);
+    JarOutputStream out = new JarOutputStream(new FileOutputStream(jar));
+    try {
+      out.putNextEntry(new JarEntry(entry));
+      FileInputStream in = new FileInputStream(classFile);
+      try {
+        byte[] buf = new byte[4096];
+        int n;
+        while ((n = in.read(buf)) > 0) {
+          out.write(buf, 0, n);
+        }
+      } finally {
+        in.close();
+      }
+      out.closeEntry();
+    } finally {
+      out.close();
+    }
+    return jar.getPath();
+  }
+}
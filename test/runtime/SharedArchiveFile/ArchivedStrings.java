@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test ArchivedStrings
+ * @summary Interned strings archived in a G1 heap region are shared and survive collections
+ * @library /testlibrary
+ * @run main ArchivedStrings
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class ArchivedStrings {
+  public static void main(String[] args) throws Exception {
+    if (args.length > 0) {
+      runWithArchive();
+      return;
+    }
+
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:+UseG1GC", "-Xmx128m", "-XX:+UnlockDiagnosticVMOptions",
+        "-XX:SharedArchiveFile=./ArchivedStrings.jsa", "-Xshare:dump");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldContain("hp space:");
+    output.shouldHaveExitValue(0);
+
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:+UseG1GC", "-Xmx128m", "-XX:+UnlockDiagnosticVMOptions",
+        "-XX:SharedArchiveFile=./ArchivedStrings.jsa", "-Xshare:on",
+        "-XX:+PrintSharedSpaces", "-XX:+VerifyBeforeGC", "-XX:+VerifyAfterGC",
+        "-cp", System.getProperty("test.class.path"), "ArchivedStrings", "run");
+    output = new OutputAnalyzer(pb.start());
+    output.shouldNotContain("Archived heap objects are not used");
+    output.shouldHaveExitValue(0);
+  }
+
+  private static void runWithArchive() {
+    String name = new StringBuilder("java.lang.").append("Object").toString();
+    String interned = name.intern();
+    if (interned != Object.class.getName().intern()) {
+      throw new RuntimeException("Interned strings are not unique");
+    }
+    System.gc();
+    if (interned != name.intern() || !interned.equals("java.lang.Object")) {
+      throw new RuntimeException("Interned string changed after a full collection");
+    }
+  }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestConcurrentTableGrowth
+ * @summary Check that interned strings and symbols stay unique while the service thread grows the tables
+ * @run main/othervm -XX:StringTableSize=1009 -XX:+UnlockExperimentalVMOptions -XX:SymbolTableSize=1009 TestConcurrentTableGrowth
+ * @run main/othervm -XX:StringTableSize=1009 -XX:+UnlockExperimentalVMOptions -XX:SymbolTableSize=1009 -XX:+UseG1GC TestConcurrentTableGrowth
+ * @run main/othervm -XX:StringTableSize=1009 -XX:-ConcurrentStringSymbolTableWork TestConcurrentTableGrowth
+ */
+
+import java.util.ArrayList;
+import java.util.concurrent.CyclicBarrier;
+
+public class TestConcurrentTableGrowth {
+    private static final int THREADS = 4;
+    private static final int STRINGS = 100000;
+    // Coprime to STRINGS, so that every thread visits every string.
+    private static final int[] STRIDES = { 1, 3, 7, 9 };
+
+    private static final String[] canonical = new String[STRINGS];
+    private static volatile Throwable failure;
+
+    public static void main(String[] args) throws Exception {
+        final CyclicBarrier barrier = new CyclicBarrier(THREADS);
+        ArrayList<Thread> threads = new ArrayList<>();
+        for (int t = 0; t < THREADS; t++) {
+            final int id = t;
+            Thread thread = new Thread() {
+                public void run() {
+                    try {
+                        barrier.await();
+                        intern(id);
+                        loadMissingClasses(id);
+                    } catch (Throwable e) {
+                        failure = e;
+                    }
+                }
+            };
+            threads.add(thread);
+            thread.start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+        if (failure != null) {
+            throw new RuntimeException("Worker failed", failure);
+        }
+
+        // The strings interned by the workers must still be found.
+        for (int i = 0; i < STRINGS; i++) {
+            String s = new String("string-" + i);
+            if (s.intern() != canonical[i]) {
+                throw new RuntimeException("String " + s + " interned twice");
+            }
+        }
+    }
+
+    // All threads intern the same strings in a different order, while the
+    // table grows underneath them.
+    private static void intern(int id) {
+        for (int n = 0; n < STRINGS; n++) {
+            int i = (n * STRIDES[id]) % STRINGS;
+            String s = new String("string-" + i).intern();
+            synchronized (canonical) {
+                if (canonical[i] == null) {
+                    canonical[i] = s;
+                } else if (canonical[i] != s) {
+                    throw new RuntimeException("String " + s + " interned twice");
+                }
+            }
+            if (n % 20000 == 0 && id == 0) {
+                System.gc();
+            }
+        }
+    }
+
+    // Every lookup of a missing class creates symbols which are no longer
+    // referenced afterwards.
+    private static void loadMissingClasses(int id) {
+        for (int i = 0; i < 20000; i++) {
+            try {
+                Class.forName("Missing" + id + "_" + i);
+                throw new RuntimeException("Class Missing" + id + "_" + i + " found");
+            } catch (ClassNotFoundException e) {
+                // expected
+            }
+        }
+    }
+}
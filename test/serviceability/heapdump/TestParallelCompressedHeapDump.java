@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestParallelCompressedHeapDump
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Check that parallel and gzip compressed heap dumps are well formed
+ * @run main/othervm -XX:+UseG1GC -XX:+HeapDumpParallel -XX:ParallelGCThreads=4 -Xmx128m -XX:G1HeapRegionSize=1m TestParallelCompressedHeapDump
+ * @run main/othervm -XX:+UseG1GC -XX:+HeapDumpParallel -XX:ParallelGCThreads=4 -XX:HeapDumpGzipLevel=1 -Xmx128m -XX:G1HeapRegionSize=1m TestParallelCompressedHeapDump
+ * @run main/othervm -XX:+UseG1GC -XX:HeapDumpGzipLevel=9 -Xmx128m TestParallelCompressedHeapDump
+ */
+
+import java.io.BufferedInputStream;
+import java.io.DataInputStream;
+import java.io.EOFException;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.lang.management.ManagementFactory;
+import java.util.HashMap;
+import java.util.zip.GZIPInputStream;
+
+import com.sun.management.HotSpotDiagnosticMXBean;
+
+public class TestParallelCompressedHeapDump {
+    static class Marker {
+        final int id;
+        Marker next;
+
+        Marker(int id, Marker next) {
+            this.id = id;
+            this.next = next;
+        }
+    }
+
+    private static final int MARKERS = 20000;
+    // Larger than the buffer of a dumper thread, so it is written as a
+    // segment of its own.
+    private static final int HUGE_LENGTH = 3 * 1024 * 1024;
+
+    private static final int HPROF_UTF8 = 0x01;
+    private static final int HPROF_LOAD_CLASS = 0x02;
+    private static final int HPROF_HEAP_DUMP_SEGMENT = 0x1C;
+    private static final int HPROF_HEAP_DUMP_END = 0x2C;
+
+    private static int idSize;
+    private static HashMap<Long, String> names = new HashMap<>();
+    private static HashMap<Long, String> classNames = new HashMap<>();
+    private static int markers;
+    private static int hugeArrays;
+
+    public static void main(String[] args) throws Exception {
+        Marker head = null;
+        for (int i = 0; i < MARKERS; i++) {
+            head = new Marker(i, head);
+        }
+        byte[] huge = new byte[HUGE_LENGTH];
+
+        File dump = new File("heapdump-" + pid() + ".hprof");
+        dump.delete();
+        HotSpotDiagnosticMXBean bean =
+            ManagementFactory.getPlatformMXBean(HotSpotDiagnosticMXBean.class);
+        bean.dumpHeap(dump.getPath(), true);
+
+        try {
+            parse(dump);
+        } finally {
+            dump.delete();
+        }
+
+        if (markers != MARKERS) {
+            throw new RuntimeException("Expected " + MARKERS + " markers but found " + markers);
+        }
+        if (hugeArrays < 1) {
+            throw new RuntimeException("Huge array not found");
+        }
+        // keep the objects alive until the dump has been written
+        if (head.id != MARKERS - 1 || huge.length != HUGE_LENGTH) {
+            throw new RuntimeException("Unexpected objects");
+        }
+    }
+
+    private static String pid() {
+        String name = ManagementFactory.getRuntimeMXBean().getName();
+        return name.substring(0, name.indexOf('@'));
+    }
+
+    private static void parse(File dump) throws IOException {
+        InputStream in = new BufferedInputStream(new FileInputStream(dump));
+        in.mark(2);
+        boolean gzip = in.read() == 0x1f && in.read() == 0x8b;
+        in.reset();
+        DataInputStream data = new DataInputStream(
+            new BufferedInputStream(gzip ? new GZIPInputStream(in, 64 * 1024) : in));
+        try {
+            parseHprof(data);
+        } finally {
+            data.close();
+        }
+    }
+
+    private static void parseHprof(DataInputStream in) throws IOException {
+        StringBuilder header = new StringBuilder();
+        for (int c = in.readUnsignedByte(); c != 0; c = in.readUnsignedByte()) {
+            header.append((char) c);
+        }
+        if (!header.toString().equals("JAVA PROFILE 1.0.2")) {
+            throw new RuntimeException("Unexpected header " + header);
+        }
+        idSize = in.readInt();
+        in.readLong(); // time stamp
+
+        while (true) {
+            int tag = in.readUnsignedByte();
+            in.readInt(); // ticks
+            long length = in.readInt() & 0xffffffffL;
+            switch (tag) {
+                case HPROF_UTF8: {
+                    long id = readId(in);
+                    byte[] bytes = new byte[(int) length - idSize];
+                    in.readFully(bytes);
+                    names.put(id, new String(bytes, "UTF-8"));
+                    break;
+                }
+                case HPROF_LOAD_CLASS: {
+                    in.readInt(); // serial number
+                    long classId = readId(in);
+                    in.readInt(); // stack trace
+                    long nameId = readId(in);
+                    classNames.put(classId, names.get(nameId));
+                    break;
+                }
+                case HPROF_HEAP_DUMP_SEGMENT:
+                    parseSegment(in, length);
+                    break;
+                case HPROF_HEAP_DUMP_END:
+                    if (in.read() != -1) {
+                        throw new RuntimeException("Data after HPROF_HEAP_DUMP_END");
+                    }
+                    return;
+                default:
+                    skip(in, length);
+            }
+        }
+    }
+
+    private static void parseSegment(DataInputStream in, long length) throws IOException {
+        long left = length;
+        while (left > 0) {
+            int tag = in.readUnsignedByte();
+            long size = 1;
+            switch (tag) {
+                case 0xFF: // ROOT UNKNOWN
+                case 0x05: // ROOT STICKY CLASS
+                case 0x07: // ROOT MONITOR USED
+                    size += skip(in, idSize);
+                    break;
+                case 0x01: // ROOT JNI GLOBAL
+                    size += skip(in, 2 * idSize);
+                    break;
+                case 0x02: // ROOT JNI LOCAL
+                case 0x03: // ROOT JAVA FRAME
+                case 0x08: // ROOT THREAD OBJECT
+                    size += skip(in, idSize + 8);
+                    break;
+                case 0x04: // ROOT NATIVE STACK
+                case 0x06: // ROOT THREAD BLOCK
+                    size += skip(in, idSize + 4);
+                    break;
+                case 0x20: // CLASS DUMP
+                    size += parseClassDump(in);
+                    break;
+                case 0x21: { // INSTANCE DUMP
+                    readId(in);
+                    in.readInt();
+                    long classId = readId(in);
+                    int bytes = in.readInt();
+                    size += 2 * idSize + 8 + skip(in, bytes);
+                    if ("TestParallelCompressedHeapDump$Marker".equals(classNames.get(classId))) {
+                        markers++;
+                    }
+                    break;
+                }
+                case 0x22: { // OBJECT ARRAY DUMP
+                    size += skip(in, idSize + 4);
+                    int elements = in.readInt();
+                    size += 4 + skip(in, idSize + (long) elements * idSize);
+                    break;
+                }
+                case 0x23: { // PRIMITIVE ARRAY DUMP
+                    size += skip(in, idSize + 4);
+                    int elements = in.readInt();
+                    int type = in.readUnsignedByte();
+                    size += 5 + skip(in, (long) elements * typeSize(type));
+                    if (type == 8 /* byte */ && elements == HUGE_LENGTH) {
+                        hugeArrays++;
+                    }
+                    break;
+                }
+                default:
+                    throw new RuntimeException("Unknown sub-record tag " + tag);
+            }
+            left -= size;
+        }
+        if (left != 0) {
+            throw new RuntimeException("Sub-record crosses the end of the dump segment");
+        }
+    }
+
+    private static long parseClassDump(DataInputStream in) throws IOException {
+        long size = skip(in, 7 * idSize + 8);
+        int constants = in.readUnsignedShort();
+        size += 2;
+        for (int i = 0; i < constants; i++) {
+            in.readUnsignedShort();
+            int type = in.readUnsignedByte();
+            size += 3 + skip(in, typeSize(type));
+        }
+        int statics = in.readUnsignedShort();
+        size += 2;
+        for (int i = 0; i < statics; i++) {
+            readId(in);
+            int type = in.readUnsignedByte();
+            size += idSize + 1 + skip(in, typeSize(type));
+        }
+        int fields = in.readUnsignedShort();
+        size += 2 + skip(in, (long) fields * (idSize + 1));
+        return size;
+    }
+
+    private static int typeSize(int type) {
+        switch (type) {
+            case 2:  return idSize; // object
+            case 4:                 // boolean
+            case 8:  return 1;      // byte
+            case 5:                 // char
+            case 9:  return 2;      // short
+            case 6:                 // float
+            case 10: return 4;      // int
+            case 7:                 // double
+            case 11: return 8;      // long
+            default: throw new RuntimeException("Unknown type " + type);
+        }
+    }
+
+    private static long readId(DataInputStream in) throws IOException {
+        return idSize == 8 ? in.readLong() : (in.readInt() & 0xffffffffL);
+    }
+
+    private static long skip(DataInputStream in, long n) throws IOException {
+        long left = n;
+        while (left > 0) {
+            long skipped = in.skip(left);
+            if (skipped <= 0) {
+                if (in.read() == -1) {
+                    throw new EOFException();
+                }
+                skipped = 1;
+            }
+            left -= skipped;
+        }
+        return n;
+    }
+}